@@ -34,6 +34,34 @@ typedef int8_t (*ads7828_read_fptr_t)(void* intf_hdl, uint16_t slv_addr, uint8_t
  */
 typedef int8_t (*ads7828_write_fptr_t)(void* intf_hdl, uint16_t slv_addr, uint8_t *data, uint16_t len);
 
+/**
+ * @brief  transfer API function pointer, sends count command bytes, each one
+ * followed by a 2 byte read of its conversion result, as one batched bus transaction
+ */
+typedef int8_t (*ads7828_xfer_fptr_t)(void* intf_hdl, uint16_t slv_addr, const uint8_t *cmd, uint8_t *data, uint8_t count);
+
+/**
+ * @brief  tick API function pointer, returns a free running time stamp
+ */
+typedef uint32_t (*ads7828_tick_fptr_t)(void);
+
+/**
+ * @brief Number of single ended channels covered by a scan
+ */
+#define ADS7828_SCAN_CHNL_MAX           8
+
+/**
+ * @brief Maximum number of conversions batched in one bus transaction
+ */
+#ifndef ADS7828_SCAN_BATCH
+#define ADS7828_SCAN_BATCH              ADS7828_SCAN_CHNL_MAX
+#endif
+
+/**
+ * @brief ADS7828 conversion result mask, the 4 MSBs of the result are zero
+ */
+#define ADS7828_DATA_MASK               0x0FFFU
+
 /**
  * @brief ADS7828 error status enumeration
  */
@@ -102,6 +130,8 @@ typedef struct
     uint16_t slv_addr;					/*!< slave address  	        	*/
     ads7828_read_fptr_t read;           /*!< Read API function pointer      */
     ads7828_write_fptr_t write;       	/*!< Write API function pointer     */
+    ads7828_xfer_fptr_t xfer;           /*!< Batched transfer API function pointer, optional */
+    ads7828_tick_fptr_t get_tick;       /*!< Time stamp API function pointer, optional */
 }s_ads7828;
 
 /**
@@ -117,6 +147,16 @@ typedef enum
 
 }e_ads7828_pd_sel;
 
+/**
+ * @brief ADS7828 scan sample structure definition
+ */
+typedef struct
+{
+    e_ads7828_chnl chnl;                /*!< converted channel                                          */
+    uint16_t data;                      /*!< 12 bit conversion result                                   */
+    uint32_t tick;                      /*!< time stamp taken when the transaction of the sample ended  */
+}s_ads7828_sample;
+
 /**
  * @brief get ads7828 data
  * @param[in]  ads7828_hdl - instance pointer of ads7828
@@ -127,6 +167,19 @@ typedef enum
  */
 e_ads7828_err ads7828_get_data(s_ads7828* ads7828_hdl,e_ads7828_chnl chnl,e_ads7828_pd_sel pd_opt,uint16_t* data);
 
+/**
+ * @brief scan the single ended channels of ads7828, the conversions are batched
+ * ADS7828_SCAN_BATCH per bus transaction and the internal reference is kept
+ * powered between them, pd_opt applies after the last conversion
+ * @param[in]  ads7828_hdl - instance pointer of ads7828
+ * @param[in]  chnl_mask - bit n selects single ended channel n
+ * @param[in]  pd_opt -  power down option after the scan, INT_REF_OFF_ADC_ON selects the external reference for the whole scan
+ * @param[out]  samples - array of ADS7828_SCAN_CHNL_MAX samples, filled in channel order
+ * @param[out]  count - number of samples
+ * @retval e_ads7828_err - returns the success or error code
+ */
+e_ads7828_err ads7828_scan(s_ads7828* ads7828_hdl,uint8_t chnl_mask,e_ads7828_pd_sel pd_opt,s_ads7828_sample* samples,uint8_t* count);
+
 
 
 
@@ -38,6 +38,52 @@ static e_ads7828_err ads7828_null_ptr_check(const s_ads7828* dev)
     return ret;
 }
 
+/*!
+ * @brief Single ended channels in scan order
+ */
+static const e_ads7828_chnl ads7828_se_chnl[ADS7828_SCAN_CHNL_MAX] =
+{
+    ADS7828_SE_CH0, ADS7828_SE_CH1, ADS7828_SE_CH2, ADS7828_SE_CH3,
+    ADS7828_SE_CH4, ADS7828_SE_CH5, ADS7828_SE_CH6, ADS7828_SE_CH7
+};
+
+/*!
+ * @brief This API is used to build the command byte of a conversion
+ */
+static uint8_t ads7828_cmd(e_ads7828_chnl chnl,e_ads7828_pd_sel pd_opt)
+{
+    return ((uint8_t)chnl<<4) | ((uint8_t)pd_opt<<2);
+}
+
+/*!
+ * @brief This API is used to run count conversions, batched when the transfer hook is available
+ */
+static e_ads7828_err ads7828_convert(s_ads7828* ads7828_hdl,const uint8_t* cmd,uint8_t* response,uint8_t count)
+{
+    e_ads7828_err ret = ADS7828_SCS;
+    uint8_t idx;
+
+    if(ads7828_hdl->xfer != NULL)
+    {
+        if(ads7828_hdl->xfer(ads7828_hdl->intf_hdl,ads7828_hdl->slv_addr,cmd,response,count) != ADS7828_SCS)
+        {
+            ret = ADS7828_COM_ERR;
+        }
+    }
+    else
+    {
+        for(idx = 0; (idx < count) && (ret == ADS7828_SCS); idx++)
+        {
+            if((ads7828_hdl->write(ads7828_hdl->intf_hdl,ads7828_hdl->slv_addr,(uint8_t*)&cmd[idx],1) != ADS7828_SCS) ||
+               (ads7828_hdl->read(ads7828_hdl->intf_hdl,ads7828_hdl->slv_addr,&response[2*idx],2) != ADS7828_SCS))
+            {
+                ret = ADS7828_COM_ERR;
+            }
+        }
+    }
+    return ret;
+}
+
 /*!
  * @brief This API is used to get the data from specified channel number
  */
@@ -50,18 +96,11 @@ e_ads7828_err ads7828_get_data(s_ads7828* ads7828_hdl,e_ads7828_chnl chnl,e_ads7
         uint8_t response[2]={0};
         if(chnl<ADS7828_CH_MAX)
         {
-            cmd=((uint8_t)chnl<<4) | ((uint8_t)pd_opt<<2);
-            if(ads7828_hdl->write(ads7828_hdl->intf_hdl,ads7828_hdl->slv_addr,&cmd,1) == ADS7828_SCS)
-            {
-                if(ads7828_hdl->read(ads7828_hdl->intf_hdl,ads7828_hdl->slv_addr,response,2) == ADS7828_SCS)
-                {
-                    *data = response[1]|response[0];
-                }
-            }
-            else
+            cmd=ads7828_cmd(chnl,pd_opt);
+            ret = ads7828_convert(ads7828_hdl,&cmd,response,1);
+            if(ret == ADS7828_SCS)
             {
-
-                ret =ADS7828_COM_ERR;
+                *data = (((uint16_t)response[0]<<8) | response[1]) & ADS7828_DATA_MASK;
             }
         }
         else
@@ -78,3 +117,60 @@ e_ads7828_err ads7828_get_data(s_ads7828* ads7828_hdl,e_ads7828_chnl chnl,e_ads7
 
 }
 
+/*!
+ * @brief This API is used to scan the selected single ended channels
+ */
+e_ads7828_err ads7828_scan(s_ads7828* ads7828_hdl,uint8_t chnl_mask,e_ads7828_pd_sel pd_opt,s_ads7828_sample* samples,uint8_t* count)
+{
+    e_ads7828_err ret = ADS7828_SCS;
+    e_ads7828_pd_sel run_pd;
+    uint8_t cmd[ADS7828_SCAN_BATCH];
+    uint8_t response[2*ADS7828_SCAN_BATCH];
+    uint8_t total = 0;
+    uint8_t done = 0;
+    uint8_t batch;
+    uint8_t idx;
+    uint32_t tick;
+
+    if(ads7828_null_ptr_check(ads7828_hdl) == ADS7828_NULL_PTR)
+    {
+        ret = ADS7828_NULL_PTR;
+    }
+    else if((samples == NULL) || (count == NULL) || (pd_opt >= PD_SEL_MAX))
+    {
+        ret = ADS7828_INVLD_ARG;
+    }
+    else
+    {
+        /* Only the last conversion may power down, the others keep the reference settled */
+        run_pd = (pd_opt == INT_REF_OFF_ADC_ON) ? INT_REF_OFF_ADC_ON : INT_REF_ON_ADC_ON;
+        for(idx = 0; idx < ADS7828_SCAN_CHNL_MAX; idx++)
+        {
+            if(chnl_mask & (1U << idx))
+            {
+                samples[total++].chnl = ads7828_se_chnl[idx];
+            }
+        }
+        while((done < total) && (ret == ADS7828_SCS))
+        {
+            batch = ((total - done) > ADS7828_SCAN_BATCH) ? ADS7828_SCAN_BATCH : (total - done);
+            for(idx = 0; idx < batch; idx++)
+            {
+                cmd[idx] = ads7828_cmd(samples[done + idx].chnl,((done + idx + 1) == total) ? pd_opt : run_pd);
+            }
+            ret = ads7828_convert(ads7828_hdl,cmd,response,batch);
+            tick = (ads7828_hdl->get_tick != NULL) ? ads7828_hdl->get_tick() : 0;
+            for(idx = 0; (idx < batch) && (ret == ADS7828_SCS); idx++)
+            {
+                samples[done + idx].data = (((uint16_t)response[2*idx]<<8) | response[2*idx + 1]) & ADS7828_DATA_MASK;
+                samples[done + idx].tick = tick;
+            }
+            if(ret == ADS7828_SCS)
+            {
+                done += batch;
+            }
+        }
+        *count = done;
+    }
+    return ret;
+}
@@ -33,6 +33,8 @@
 #define MAX_COUNT 4           ///< Maximum count
 #define MAX_TEMP_VAL 125      ///< Maximum temperature value
 #define MIN_TEMP_VAL -55      ///< Minimum temperature value
+#define MAX_TEMP_MDEG 125000  ///< Maximum temperature value in milli degree celsius
+#define MIN_TEMP_MDEG -55000  ///< Minimum temperature value in milli degree celsius
 
 #define TEMP_TL_LSB_REG   0xA3   ///< Low temperature threshold LSB register Address
 #define TEMP_TL_MSB_REG   0xA2   ///< Low temperature threshold MSB register Address
@@ -43,6 +45,8 @@
 #define CONFIG_MSB_REG    0xAC   ///< configuration MSB register Address
 #define CONFIG_LSB_REG    0xAD   ///< configuration LSB register Address
 
+#define CONFIG_THF_TLF    0x30   ///< THF and TLF alert flags of the configuration MSB register
+
 #define DS620_I2C_ADDR0   0x90   ///< I2C slave address 0
 #define DS620_I2C_ADDR1   0x91   ///< I2C slave address 1
 #define DS620_I2C_ADDR2   0x92   ///< I2C slave address 2
@@ -145,6 +149,11 @@ typedef struct
     ds620_read_fptr_t read;         /*!< Read API function pointer            */
     ds620_write_fptr_t write;       /*!< Write API function pointer           */
     ds620_delay_ms_fptr delay_ms;
+    int32_t temp_mdeg;              /*!< Last temperature read in alert mode, milli degree celsius */
+    uint32_t alert_hb_ms;           /*!< Alert mode heartbeat period in mS, 0 reads on alert only */
+    uint32_t alert_rd_ms;           /*!< Time of the last temperature read in alert mode */
+    uint8_t alert_en;               /*!< Alert mode enabled by ds620_alert_mode_cfg() */
+    volatile uint8_t alert_pend;    /*!< Alert reported by ds620_alert_notify(), not read yet */
 
 }s_ds620_drv_cb;
 
@@ -306,4 +315,56 @@ e_ds620_err ds620_reset_alert_flag(s_ds620_drv_cb_ptr ds620_hdl);
  */
 e_ds620_err ds620_get_po_lvl_alert_sts (s_ds620_drv_cb_ptr ds620_hdl, e_ds620_po_lvl* alert_sts);
 
+/**
+ * @brief Temperature read in milli degree celsius, integer conversion of the
+ * temperature register without floating point
+ * @param[in]  ds620_hdl - instance pointer of DS620
+ * @param[out] temp_mdeg - temperature in milli degree celsius
+ * @retval e_ds620_err - returns the success or error code
+ */
+e_ds620_err ds620_get_temperature_mdeg (s_ds620_drv_cb_ptr ds620_hdl, int32_t* temp_mdeg);
+
+/**
+ * @brief DS620 low and high temperature thresholds are set in milli degree celsius
+ * @param[in]  ds620_hdl - instance pointer of DS620
+ * @param[in]  low_mdeg - low temperature threshold in milli degree celsius
+ * @param[in]  high_mdeg - high temperature threshold in milli degree celsius
+ * @retval e_ds620_err - returns the success or error code
+ */
+e_ds620_err ds620_set_thrshd_mdeg (s_ds620_drv_cb_ptr ds620_hdl, int32_t low_mdeg, int32_t high_mdeg);
+
+/**
+ * @brief Alert driven sampling is configured in this function. The thresholds
+ * are programmed once, the alert flags are cleared and continuous conversion is
+ * started, the PO pin then reports threshold crossings as configured by
+ * po_level_type. ds620_alert_poll() reads the part only after an alert or
+ * once per heartbeat period.
+ * @param[in]  ds620_hdl - instance pointer of DS620
+ * @param[in]  low_mdeg - low temperature threshold in milli degree celsius
+ * @param[in]  high_mdeg - high temperature threshold in milli degree celsius
+ * @param[in]  hb_ms - heartbeat period in mS, 0 reads on alert only
+ * @retval e_ds620_err - returns the success or error code
+ */
+e_ds620_err ds620_alert_mode_cfg (s_ds620_drv_cb_ptr ds620_hdl, int32_t low_mdeg, int32_t high_mdeg, uint32_t hb_ms);
+
+/**
+ * @brief Reports a PO pin alert, no bus access so it can be called from the
+ * interrupt callback of the PO pin
+ * @param[in]  ds620_hdl - instance pointer of DS620
+ */
+void ds620_alert_notify (s_ds620_drv_cb_ptr ds620_hdl);
+
+/**
+ * @brief Temperature poll in alert mode. After an alert the temperature and the
+ * THF/TLF flags are read in one transfer and the flags are cleared, when the
+ * heartbeat expires only the temperature is read, otherwise the last
+ * temperature is returned without bus access.
+ * @param[in]  ds620_hdl - instance pointer of DS620
+ * @param[in]  now_ms - current time in mS
+ * @param[out] temp_mdeg - temperature in milli degree celsius
+ * @param[out] alert_sts - THF (bit 1) and TLF (bit 0) flags read by this poll, 0 when there was no alert
+ * @retval e_ds620_err - returns the success or error code
+ */
+e_ds620_err ds620_alert_poll (s_ds620_drv_cb_ptr ds620_hdl, uint32_t now_ms, int32_t* temp_mdeg, uint8_t* alert_sts);
+
 #endif /* DS620_H */
@@ -20,10 +20,11 @@
 #include "ds620.h"
 
 
-static float arr[4]={0.0625,0.125,0.25,0.5};
 static uint8_t cont_conv_sts=0;
 static double conv_temp_get(s_ds620_drv_cb_ptr ds620_hdl, int16_t data);
 static int16_t conv_temp_set(s_ds620_drv_cb_ptr ds620_hdl, double temperature);
+static int32_t conv_temp_get_mdeg(s_ds620_drv_cb_ptr ds620_hdl, int16_t data);
+static int16_t conv_temp_set_mdeg(int32_t temp_mdeg);
 
 /*!
  *  @brief This API checks the NULL pointer
@@ -72,7 +73,6 @@ static e_ds620_err ds620_write16(s_ds620_drv_cb_ptr ds620_hdl, uint8_t reg, int1
 static e_ds620_err ds620_read16(s_ds620_drv_cb_ptr ds620_hdl, uint8_t reg, int16_t* data)
 {
     e_ds620_err sts=DS620_ERR;
-    uint8_t lsb,msb;
     sts=null_ptr_check(ds620_hdl);
     if(sts!=DS620_SCS)
     {
@@ -80,49 +80,48 @@ static e_ds620_err ds620_read16(s_ds620_drv_cb_ptr ds620_hdl, uint8_t reg, int16
     }
     else
     {
-        sts=ds620_hdl->read(ds620_hdl->intf_hdl,ds620_hdl->slv_addr,reg,&msb,1);
-        reg++;
-        sts=ds620_hdl->read(ds620_hdl->intf_hdl,ds620_hdl->slv_addr,reg,&lsb,1);
-        *data=lsb|msb<<8;
+        uint8_t array[2];
+        sts=ds620_hdl->read(ds620_hdl->intf_hdl,ds620_hdl->slv_addr,reg,array,2);
+        *data=array[1]|array[0]<<8;
     }
     return(sts);
 }
 
+/*!
+ *  @brief This API returns the mask of the register bits valid at the configured resolution,
+ *  the 13 bit result is left justified and the LSB is 1/128 degree celsius
+ */
+static int16_t conv_res_mask(s_ds620_drv_cb_ptr ds620_hdl)
+{
+    return (int16_t)(0xFFFF << (6 - ((ds620_hdl->resolution & 0x0C) >> 2)));
+}
+
 /*!
  *  @brief This API converts the register data into temperature in celsius
  */
 static double conv_temp_get(s_ds620_drv_cb_ptr ds620_hdl, int16_t data)
 {
-    uint8_t temp_lsb;
-    int16_t temp_data;
-    double sum=0;
-    temp_data=(data>>7);
-    temp_lsb=data;
-    temp_lsb=temp_lsb & 0x7F;
-    switch(ds620_hdl->resolution)
-    {
-        case BIT_13:
-            temp_lsb=temp_lsb >> 3;
-            break;
-        case BIT_12:
-            temp_lsb=temp_lsb >> 4;
-            break;
-        case BIT_11:
-            temp_lsb=temp_lsb >> 5;
-            break;
-        case BIT_10:
-            temp_lsb=temp_lsb >> 6;
-            break;
-        default:
-            break;
-    }
-    for(int i=0;i<4;i++)
-    {
-        sum=sum+((double)(temp_lsb & 0x01)*arr[i]);
-        temp_lsb=temp_lsb>>1;
-    }
-    sum=sum+(double)temp_data;
-    return(sum);
+    return ((double)(data & conv_res_mask(ds620_hdl)) / 128.0);
+}
+
+/*!
+ *  @brief This API converts the register data into temperature in milli degree celsius
+ */
+static int32_t conv_temp_get_mdeg(s_ds620_drv_cb_ptr ds620_hdl, int16_t data)
+{
+    /* 1000/128 = 125/16 */
+    return (((int32_t)(data & conv_res_mask(ds620_hdl)) * 125) / 16);
+}
+
+/*!
+ *  @brief This API converts the temperature in milli degree celsius into the register format,
+ *  rounded to the nearest 1/16 degree celsius
+ */
+static int16_t conv_temp_set_mdeg(int32_t temp_mdeg)
+{
+    int32_t val = temp_mdeg * 16;
+    val = (val < 0) ? ((val - 500) / 1000) : ((val + 500) / 1000);
+    return (int16_t)((uint16_t)val << 3);
 }
 
 /*!
@@ -165,6 +164,19 @@ static int16_t conv_temp_set(s_ds620_drv_cb_ptr ds620_hdl, double temperature)
     return retval;
 }
 
+/*!
+ *  @brief This API reads the temperature register, in oneshot mode a conversion is started first
+ */
+static e_ds620_err ds620_read_temp(s_ds620_drv_cb_ptr ds620_hdl, int16_t* data)
+{
+    if(cont_conv_sts==0)
+    {
+        ds620_start_conversion(ds620_hdl);
+        ds620_hdl->delay_ms(DS620_DELAY);
+    }
+    return ds620_read16(ds620_hdl,TEMP_MSB_REG,data);
+}
+
 /*!
  *  @brief This API initalizes the DS620 and allocates the memory
  */
@@ -174,6 +186,8 @@ e_ds620_err ds620_init (s_ds620_drv_cb_ptr ds620_hdl)
     sts = null_ptr_check(ds620_hdl);
     if(sts==DS620_SCS)
     {
+        ds620_hdl->alert_en=0;
+        ds620_hdl->alert_pend=0;
         ds620_reset(ds620_hdl);
         sts = ds620_config(ds620_hdl);
         ds620_start_conversion(ds620_hdl);
@@ -305,12 +319,7 @@ e_ds620_err ds620_get_temperature (s_ds620_drv_cb_ptr ds620_hdl, double* tempera
     }
     else
     {
-        if(cont_conv_sts==0)
-        {
-            ds620_start_conversion(ds620_hdl);
-            ds620_hdl->delay_ms(DS620_DELAY);
-        }
-        sts = ds620_read16(ds620_hdl,TEMP_MSB_REG,&temp_val);
+        sts = ds620_read_temp(ds620_hdl,&temp_val);
         *temperature = conv_temp_get(ds620_hdl,temp_val);
     }
     return(sts);
@@ -597,3 +606,155 @@ e_ds620_err ds620_reset_alert_flag(s_ds620_drv_cb_ptr ds620_hdl)
     }
     return(sts);
 }
+
+/*!
+ *  @brief This API reads temperature in milli degree celsius
+ */
+e_ds620_err ds620_get_temperature_mdeg (s_ds620_drv_cb_ptr ds620_hdl, int32_t* temp_mdeg)
+{
+    e_ds620_err sts= DS620_ERR;
+    int16_t temp_val=0;
+    sts=null_ptr_check(ds620_hdl);
+    if(sts!=DS620_SCS)
+    {
+        sts=NULL_PTR_ERR;
+    }
+    else
+    {
+        sts = ds620_read_temp(ds620_hdl,&temp_val);
+        if(sts==DS620_SCS)
+        {
+            *temp_mdeg = conv_temp_get_mdeg(ds620_hdl,temp_val);
+        }
+    }
+    return(sts);
+}
+
+/*!
+ *  @brief This API sets the low and high temperature thresholds in milli degree celsius
+ */
+e_ds620_err ds620_set_thrshd_mdeg (s_ds620_drv_cb_ptr ds620_hdl, int32_t low_mdeg, int32_t high_mdeg)
+{
+    e_ds620_err sts= DS620_ERR;
+    sts=null_ptr_check(ds620_hdl);
+    if(sts!=DS620_SCS)
+    {
+        sts=NULL_PTR_ERR;
+    }
+    else if(low_mdeg < MIN_TEMP_MDEG || high_mdeg > MAX_TEMP_MDEG || low_mdeg > high_mdeg)
+    {
+        sts = DS620_INVLD_ARG;
+    }
+    else
+    {
+        sts = ds620_write16(ds620_hdl, TEMP_TH_MSB_REG, conv_temp_set_mdeg(high_mdeg));
+        if(sts==DS620_SCS)
+        {
+            sts = ds620_write16(ds620_hdl, TEMP_TL_MSB_REG, conv_temp_set_mdeg(low_mdeg));
+        }
+    }
+    return(sts);
+}
+
+/*!
+ *  @brief This API configures the alert driven sampling
+ */
+e_ds620_err ds620_alert_mode_cfg (s_ds620_drv_cb_ptr ds620_hdl, int32_t low_mdeg, int32_t high_mdeg, uint32_t hb_ms)
+{
+    e_ds620_err sts= DS620_ERR;
+    sts=ds620_set_thrshd_mdeg(ds620_hdl,low_mdeg,high_mdeg);
+    if(sts==DS620_SCS)
+    {
+        sts=ds620_reset_alert_flag(ds620_hdl);
+    }
+    if(sts==DS620_SCS)
+    {
+        /* the thermostat only follows the temperature while converting */
+        ds620_hdl->mode=CONTINOUS_CONV;
+        sts=ds620_set_conv_mode(ds620_hdl,CONTINOUS_CONV);
+    }
+    if(sts==DS620_SCS)
+    {
+        sts=ds620_start_conversion(ds620_hdl);
+    }
+    if(sts==DS620_SCS)
+    {
+        ds620_hdl->alert_hb_ms=hb_ms;
+        ds620_hdl->temp_mdeg=0;
+        /* the first poll reads the temperature and the flags */
+        ds620_hdl->alert_pend=1;
+        ds620_hdl->alert_en=1;
+    }
+    return(sts);
+}
+
+/*!
+ *  @brief This API reports a PO pin alert
+ */
+void ds620_alert_notify (s_ds620_drv_cb_ptr ds620_hdl)
+{
+    if(ds620_hdl != NULL)
+    {
+        ds620_hdl->alert_pend=1;
+    }
+}
+
+/*!
+ *  @brief This API returns the temperature in alert mode, the part is only read after an alert or at the heartbeat
+ */
+e_ds620_err ds620_alert_poll (s_ds620_drv_cb_ptr ds620_hdl, uint32_t now_ms, int32_t* temp_mdeg, uint8_t* alert_sts)
+{
+    e_ds620_err sts= DS620_ERR;
+    uint8_t data[3];
+    int16_t temp_val;
+    sts=null_ptr_check(ds620_hdl);
+    if(sts!=DS620_SCS)
+    {
+        sts=NULL_PTR_ERR;
+    }
+    else if(ds620_hdl->alert_en==0)
+    {
+        sts=DS620_ERR;
+    }
+    else
+    {
+        *alert_sts=0;
+        if(ds620_hdl->alert_pend!=0)
+        {
+            /* cleared before the read so that an alert raised meanwhile is not lost */
+            ds620_hdl->alert_pend=0;
+            sts=ds620_hdl->read(ds620_hdl->intf_hdl,ds620_hdl->slv_addr,TEMP_MSB_REG,data,3);
+            if(sts==DS620_SCS)
+            {
+                temp_val=data[1]|data[0]<<8;
+                ds620_hdl->temp_mdeg=conv_temp_get_mdeg(ds620_hdl,temp_val);
+                ds620_hdl->alert_rd_ms=now_ms;
+                *alert_sts=(data[2] & CONFIG_THF_TLF)>>4;
+                if(*alert_sts!=0)
+                {
+                    data[2]=data[2] & (~CONFIG_THF_TLF);
+                    sts=ds620_hdl->write(ds620_hdl->intf_hdl,ds620_hdl->slv_addr,CONFIG_MSB_REG,&data[2],1);
+                }
+            }
+            else
+            {
+                ds620_hdl->alert_pend=1;
+            }
+        }
+        else if(ds620_hdl->alert_hb_ms!=0 && (uint32_t)(now_ms-ds620_hdl->alert_rd_ms)>=ds620_hdl->alert_hb_ms)
+        {
+            sts=ds620_read16(ds620_hdl,TEMP_MSB_REG,&temp_val);
+            if(sts==DS620_SCS)
+            {
+                ds620_hdl->temp_mdeg=conv_temp_get_mdeg(ds620_hdl,temp_val);
+                ds620_hdl->alert_rd_ms=now_ms;
+            }
+        }
+        else
+        {
+
+        }
+        *temp_mdeg=ds620_hdl->temp_mdeg;
+    }
+    return(sts);
+}
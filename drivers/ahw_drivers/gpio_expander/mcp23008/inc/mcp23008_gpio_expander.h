@@ -38,6 +38,7 @@
 #define INTCAP   	0x08      ///< INTERRUPT CAPTURE (INTCAP) REGISTER
 #define GPIO_PORT  	0x09      ///< PORT (GPIO) REGISTER
 #define OLAT     	0x0A      ///< OUTPUT LATCH REGISTER (OLAT)
+#define MCP23008_REG_CNT	0x0B      ///< number of registers, IODIR to OLAT
 
 
 /**
@@ -91,6 +92,7 @@ typedef struct
     mcp23008_read_fptr_t read;      /*!< Read API function pointer          */
     mcp23008_write_fptr_t write;    /*!< Write API function pointer         */
     s_mcp23008_intr_info callback_func_info[8];/*!< Interrupt callback function pointer array  */
+    uint8_t shdw[MCP23008_REG_CNT];	/*!< register shadow indexed by register address, loaded by mcp23008_init */
 }s_mcp23008;
 
 
@@ -189,6 +191,15 @@ typedef enum
     MCP23008_GPIO_INTR_MAX
 }e_gpio_intr_typ;
 
+/**
+ * @brief This function loads the register shadow with one sequential read of
+ * IODIR to OLAT. It must be called before any other API, configuration
+ * registers are then written through the shadow and only when they change
+ * @param[in] mcp23008_hdl - instance pointer of mcp23008
+ * @retval e_mcp23008_err - returns the success or error code
+ */
+e_mcp23008_err mcp23008_init(s_mcp23008* mcp23008_hdl);
+
 /**
  * @brief This function is used to check the interrupt status
  * @param[in] mcp23008_hdl - instance pointer of mcp23008
@@ -240,7 +251,9 @@ e_mcp23008_err mcp23008_set_direction (s_mcp23008* mcp23008_hdl, uint8_t gpio_pi
 e_mcp23008_err mcp23008_write_pin(s_mcp23008* mcp23008_hdl, uint8_t gpio_pin, e_gpio_pin_ste gpio_ste);
 
 /**
- * @brief This function is used to read the GPIO
+ * @brief This function is used to read the GPIO. Pins with interrupt-on-change
+ * enabled are served from the input shadow refreshed by mcp23008_intr_refresh,
+ * other pins are read from the port
  * @param[in] mcp23008_hdl - instance pointer of mcp23008
  * @param[in] gpio_pin - gpio pin number
  * @retval e_mcp23008_err - returns the success or error code
@@ -284,4 +297,33 @@ e_mcp23008_err mcp23008_int_pin_polarity_cfg(s_mcp23008* mcp23008_hdl,e_int_pin_
  */
 e_mcp23008_err mcp23008_clear_interrupt(s_mcp23008* mcp23008_hdl);
 
+/**
+ * @brief This function updates the output latch of the port in one write,
+ * the new latch is ((OLAT | set_msk) & ~clr_msk) ^ tgl_msk
+ * @param[in] mcp23008_hdl - instance pointer of mcp23008
+ * @param[in] set_msk - pins to be driven high
+ * @param[in] clr_msk - pins to be driven low
+ * @param[in] tgl_msk - pins to be toggled
+ * @retval e_mcp23008_err - returns the success or error code
+ */
+e_mcp23008_err mcp23008_port_update(s_mcp23008* mcp23008_hdl, uint8_t set_msk, uint8_t clr_msk, uint8_t tgl_msk);
+
+/**
+ * @brief This function reads the port and refreshes the input shadow
+ * @param[in] mcp23008_hdl - instance pointer of mcp23008
+ * @param[out] port_ste - state of all the pins
+ * @retval e_mcp23008_err - returns the success or error code
+ */
+e_mcp23008_err mcp23008_read_port(s_mcp23008* mcp23008_hdl, uint8_t* port_ste);
+
+/**
+ * @brief This function services the interrupt, INTF, INTCAP and GPIO are read
+ * in one sequential read which also clears the interrupt and refreshes the
+ * input shadow
+ * @param[in] mcp23008_hdl - instance pointer of mcp23008
+ * @param[out] intr_flg - pins that caused the interrupt
+ * @retval e_mcp23008_err - returns the success or error code
+ */
+e_mcp23008_err mcp23008_intr_refresh(s_mcp23008* mcp23008_hdl, uint8_t* intr_flg);
+
 #endif /* DRIVERS_AHW_DRIVERS_GPIO_EXPANDER_MCP23008_INC_MCP23008_GPIO_EXPANDER_H_ */
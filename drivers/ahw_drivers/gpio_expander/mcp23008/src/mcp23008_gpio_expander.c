@@ -38,6 +38,51 @@ static e_mcp23008_err mcp23008_null_ptr_check(const s_mcp23008* dev)
     return ret;
 }
 
+/*!
+ * @brief This API writes a register through the shadow, nothing is sent when the value is unchanged
+ */
+static e_mcp23008_err mcp23008_reg_write(s_mcp23008* mcp23008_hdl, uint8_t reg_addr, uint8_t data)
+{
+    e_mcp23008_err ret = MCP23008_SCS;
+    if(data != mcp23008_hdl->shdw[reg_addr])
+    {
+        if(mcp23008_hdl->write(mcp23008_hdl->intf_hdl, mcp23008_hdl->slv_addr,reg_addr,&data,1) == MCP23008_SCS)
+        {
+            mcp23008_hdl->shdw[reg_addr] = data;
+        }
+        else
+        {
+            ret = MCP23008_COM_ERR;
+        }
+    }
+    return ret;
+}
+
+/*!
+ * @brief This function loads the register shadow
+ */
+e_mcp23008_err mcp23008_init(s_mcp23008* mcp23008_hdl)
+{
+    e_mcp23008_err ret= MCP23008_ERR;
+    if(mcp23008_null_ptr_check(mcp23008_hdl)==MCP23008_SCS)
+    {
+        /* IOCON.SEQOP resets to 0, the address pointer increments over the register file */
+        if(mcp23008_hdl->read(mcp23008_hdl->intf_hdl, mcp23008_hdl->slv_addr,IODIR,mcp23008_hdl->shdw,MCP23008_REG_CNT) == MCP23008_SCS)
+        {
+            ret = MCP23008_SCS;
+        }
+        else
+        {
+            ret = MCP23008_COM_ERR;
+        }
+    }
+    else
+    {
+        ret = MCP23008_NULL_PTR;
+    }
+    return ret;
+}
+
 /*!
  * @brief This function is used to set the GPIO direction
  */
@@ -49,23 +94,15 @@ e_mcp23008_err mcp23008_set_direction(s_mcp23008* mcp23008_hdl, uint8_t gpio_pin
     {
         if(gpio_pin <= MCP23008_GPIO_MAX && gpio_dir < MCP23008_GPIO_DIR_MAX)
         {
-            if(mcp23008_hdl->read(mcp23008_hdl->intf_hdl, mcp23008_hdl->slv_addr,IODIR,&data,1)==MCP23008_SCS)
+            if(gpio_dir==MCP23008_GPIO_INPUT)
             {
-                if(gpio_dir==MCP23008_GPIO_INPUT)
-                {
-
-                    data = data | gpio_pin;
-                }
-                else
-                {
-                    data= data & (~gpio_pin);
-                }
-                ret= mcp23008_hdl->write(mcp23008_hdl->intf_hdl, mcp23008_hdl->slv_addr,IODIR,&data,1);
+                data = mcp23008_hdl->shdw[IODIR] | gpio_pin;
             }
             else
             {
-                ret = MCP23008_COM_ERR;
+                data = mcp23008_hdl->shdw[IODIR] & (~gpio_pin);
             }
+            ret = mcp23008_reg_write(mcp23008_hdl,IODIR,data);
         }
         else
         {
@@ -88,8 +125,16 @@ e_gpio_pin_ste mcp23008_read_pin(s_mcp23008* mcp23008_hdl, e_gpio_num gpio_pin)
     uint8_t data;
     if(mcp23008_null_ptr_check(mcp23008_hdl)==MCP23008_SCS)
     {
-        if(mcp23008_hdl->read(mcp23008_hdl->intf_hdl, mcp23008_hdl->slv_addr,GPIO_PORT,&data,1) == MCP23008_SCS)
+        if((gpio_pin & mcp23008_hdl->shdw[GPINTEN] & (~mcp23008_hdl->shdw[INTCON])) == gpio_pin)
         {
+            /* Any change of these pins raises an interrupt which refreshes the shadow,
+             * pins compared against DEFVAL only interrupt on one edge and are read */
+            data = mcp23008_hdl->shdw[GPIO_PORT] & gpio_pin;
+            gpio_ste = (data>0) ? MCP23008_GPIO_HIGH : MCP23008_GPIO_LOW;
+        }
+        else if(mcp23008_hdl->read(mcp23008_hdl->intf_hdl, mcp23008_hdl->slv_addr,GPIO_PORT,&data,1) == MCP23008_SCS)
+        {
+            mcp23008_hdl->shdw[GPIO_PORT] = data;
             data = (data & gpio_pin);
 
             if(data>0)
@@ -138,26 +183,17 @@ e_mcp23008_err mcp23008_self_test(s_mcp23008* mcp23008_hdl)
 e_mcp23008_err mcp23008_write_pin(s_mcp23008* mcp23008_hdl, uint8_t gpio_pin, e_gpio_pin_ste gpio_ste)
 {
     e_mcp23008_err ret= MCP23008_ERR;
-    uint8_t data;
     if(mcp23008_null_ptr_check(mcp23008_hdl)==MCP23008_SCS)
     {
         if(gpio_pin <= MCP23008_GPIO_MAX && gpio_ste < MCP23008_GPIO_STE_MAX)
         {
-            if(mcp23008_hdl->read(mcp23008_hdl->intf_hdl, mcp23008_hdl->slv_addr,GPIO_PORT,&data,1)==MCP23008_SCS)
+            if(gpio_ste==MCP23008_GPIO_HIGH)
             {
-                if(gpio_ste==MCP23008_GPIO_HIGH)
-                {
-                    data = data | gpio_pin;
-                }
-                else
-                {
-                    data= data & (~gpio_pin);
-                }
-                ret= mcp23008_hdl->write(mcp23008_hdl->intf_hdl, mcp23008_hdl->slv_addr,GPIO_PORT,&data,1);
+                ret = mcp23008_port_update(mcp23008_hdl,gpio_pin,0,0);
             }
             else
             {
-                ret = MCP23008_COM_ERR;
+                ret = mcp23008_port_update(mcp23008_hdl,0,gpio_pin,0);
             }
         }
         else
@@ -178,35 +214,11 @@ e_mcp23008_err mcp23008_write_pin(s_mcp23008* mcp23008_hdl, uint8_t gpio_pin, e_
 e_mcp23008_err mcp23008_toggle_pin(s_mcp23008* mcp23008_hdl, uint8_t gpio_pin)
 {
     e_mcp23008_err ret= MCP23008_ERR;
-    uint8_t data;
-    uint8_t mask=0x01;
     if(mcp23008_null_ptr_check(mcp23008_hdl)==MCP23008_SCS)
     {
         if(gpio_pin <= MCP23008_GPIO_MAX)
         {
-            if(mcp23008_hdl->read(mcp23008_hdl->intf_hdl, mcp23008_hdl->slv_addr,GPIO_PORT,&data,1) == MCP23008_SCS)
-            {
-                data = data >> gpio_pin;
-                data = data & 0x01;
-                data = !data;
-
-                if(data==MCP23008_GPIO_HIGH)
-                {
-                    mask = mask << gpio_pin;
-                    data = data | mask;
-                }
-                else
-                {
-                    mask = mask << gpio_pin;
-                    mask = ~mask;
-                    data= data & mask;
-                }
-                ret= mcp23008_hdl->write(mcp23008_hdl->intf_hdl, mcp23008_hdl->slv_addr,GPIO_PORT,&data,1);
-            }
-            else
-            {
-                ret=MCP23008_COM_ERR ;
-            }
+            ret = mcp23008_port_update(mcp23008_hdl,0,0,gpio_pin);
         }
         else
         {
@@ -301,20 +313,11 @@ e_mcp23008_err mcp23008_config_pin(s_mcp23008* mcp23008_hdl, s_gpio_config* gpio
 e_mcp23008_err mcp23008_pullup_enable(s_mcp23008* mcp23008_hdl, uint8_t gpio_pin)
 {
     e_mcp23008_err ret= MCP23008_ERR;
-    uint8_t data;
     if(mcp23008_null_ptr_check(mcp23008_hdl)==MCP23008_SCS)
     {
-        if(gpio_pin <= MCP23008_GPIO_MAX )
+        if(gpio_pin <= MCP23008_GPIO_MAX)
         {
-            if(mcp23008_hdl->read(mcp23008_hdl->intf_hdl, mcp23008_hdl->slv_addr,GPPU,&data,1) == MCP23008_SCS)
-            {
-                data = data | gpio_pin;
-            }
-            else
-            {
-                ret=MCP23008_COM_ERR;
-            }
-            ret=mcp23008_hdl->write(mcp23008_hdl->intf_hdl, mcp23008_hdl->slv_addr,GPPU,&data,1);
+            ret=mcp23008_reg_write(mcp23008_hdl,GPPU,mcp23008_hdl->shdw[GPPU] | gpio_pin);
         }
         else
         {
@@ -334,20 +337,11 @@ e_mcp23008_err mcp23008_pullup_enable(s_mcp23008* mcp23008_hdl, uint8_t gpio_pin
 e_mcp23008_err mcp23008_pullup_disable(s_mcp23008* mcp23008_hdl, uint8_t gpio_pin)
 {
     e_mcp23008_err ret= MCP23008_ERR;
-    uint8_t data;
     if(mcp23008_null_ptr_check(mcp23008_hdl)==MCP23008_SCS)
     {
         if(gpio_pin <= MCP23008_GPIO_MAX)
         {
-            if(mcp23008_hdl->read(mcp23008_hdl->intf_hdl, mcp23008_hdl->slv_addr,GPPU,&data,1) == MCP23008_SCS)
-            {
-                data= data & (~gpio_pin);
-            }
-            else
-            {
-                ret=MCP23008_COM_ERR;
-            }
-            ret=mcp23008_hdl->write(mcp23008_hdl->intf_hdl, mcp23008_hdl->slv_addr,GPPU,&data,1);
+            ret=mcp23008_reg_write(mcp23008_hdl,GPPU,mcp23008_hdl->shdw[GPPU] & (~gpio_pin));
         }
         else
         {
@@ -367,79 +361,57 @@ e_mcp23008_err mcp23008_pullup_disable(s_mcp23008* mcp23008_hdl, uint8_t gpio_pi
 e_mcp23008_err mcp23008_interrupt_cfg(s_mcp23008* mcp23008_hdl, uint8_t gpio_pin, e_gpio_intr_typ intr_typ)
 {
     e_mcp23008_err ret= MCP23008_COM_ERR;
-    uint8_t data;
     if(mcp23008_null_ptr_check(mcp23008_hdl)==MCP23008_SCS)
     {
         if(gpio_pin <= MCP23008_GPIO_MAX && intr_typ < MCP23008_GPIO_INTR_MAX)
         {
-            if(mcp23008_hdl->read(mcp23008_hdl->intf_hdl, mcp23008_hdl->slv_addr,GPINTEN,&data,1) == MCP23008_SCS)
+            /* The compare source is set up before the pins are enabled */
+            switch(intr_typ)
             {
-                switch(intr_typ)
-                {
-                    case MCP23008_GPIO_INTR_DISABLE:
-                        data= data & (~gpio_pin);
-                        ret=mcp23008_hdl->write(mcp23008_hdl->intf_hdl, mcp23008_hdl->slv_addr,GPINTEN,&data,1);
-                        break;
+                case MCP23008_GPIO_INTR_DISABLE:
+                    ret=mcp23008_reg_write(mcp23008_hdl,GPINTEN,mcp23008_hdl->shdw[GPINTEN] & (~gpio_pin));
+                    break;
 
-                    case MCP23008_GPIO_INTR_RISING_FALLING:
-                        data = data | gpio_pin;
-                        if(mcp23008_hdl->write(mcp23008_hdl->intf_hdl, mcp23008_hdl->slv_addr,GPINTEN,&data,1) == MCP23008_SCS)
-                        {
-                            if(mcp23008_hdl->read(mcp23008_hdl->intf_hdl, mcp23008_hdl->slv_addr,INTCON,&data,1) == MCP23008_SCS)
-                            {
-                                data= data & (~gpio_pin);
-                                ret=mcp23008_hdl->write(mcp23008_hdl->intf_hdl, mcp23008_hdl->slv_addr,INTCON,&data,1);
-                            }
-                        }
-                        break;
+                case MCP23008_GPIO_INTR_RISING_FALLING:
+                    ret=mcp23008_reg_write(mcp23008_hdl,INTCON,mcp23008_hdl->shdw[INTCON] & (~gpio_pin));
+                    break;
 
-                    case MCP23008_GPIO_INTR_RISING:
-                        data = data | gpio_pin;
-                        if(mcp23008_hdl->write(mcp23008_hdl->intf_hdl, mcp23008_hdl->slv_addr,GPINTEN,&data,1) == MCP23008_SCS)
-                        {
-                            if(mcp23008_hdl->read(mcp23008_hdl->intf_hdl, mcp23008_hdl->slv_addr,INTCON,&data,1) == MCP23008_SCS)
-                            {
-                                data = data | gpio_pin;
-                                if(mcp23008_hdl->write(mcp23008_hdl->intf_hdl, mcp23008_hdl->slv_addr,INTCON,&data,1) == MCP23008_SCS)
-                                {
-                                    if(mcp23008_hdl->read(mcp23008_hdl->intf_hdl, mcp23008_hdl->slv_addr,DEFVAL,&data,1) == MCP23008_SCS)
-                                    {
-                                        data = data & (~gpio_pin);
-                                        ret=mcp23008_hdl->write(mcp23008_hdl->intf_hdl, mcp23008_hdl->slv_addr,DEFVAL,&data,1);
-                                    }
-                                }
-                            }
-                        }
-                        break;
+                case MCP23008_GPIO_INTR_RISING:
+                    ret=mcp23008_reg_write(mcp23008_hdl,DEFVAL,mcp23008_hdl->shdw[DEFVAL] & (~gpio_pin));
+                    if(ret == MCP23008_SCS)
+                    {
+                        ret=mcp23008_reg_write(mcp23008_hdl,INTCON,mcp23008_hdl->shdw[INTCON] | gpio_pin);
+                    }
+                    break;
 
-                    case MCP23008_GPIO_INTR_FALLING:
-                        data = data | gpio_pin;
-                        if(mcp23008_hdl->write(mcp23008_hdl->intf_hdl, mcp23008_hdl->slv_addr,GPINTEN,&data,1) == MCP23008_SCS)
-                        {
-                            if(mcp23008_hdl->read(mcp23008_hdl->intf_hdl, mcp23008_hdl->slv_addr,INTCON,&data,1) == MCP23008_SCS)
-                            {
-                                data = data | gpio_pin;
-                                if(mcp23008_hdl->write(mcp23008_hdl->intf_hdl, mcp23008_hdl->slv_addr,INTCON,&data,1) == MCP23008_SCS)
-                                {
-                                    if(mcp23008_hdl->read(mcp23008_hdl->intf_hdl, mcp23008_hdl->slv_addr,DEFVAL,&data,1) == MCP23008_SCS)
-                                    {
-                                        data = data | gpio_pin;
-                                        ret=mcp23008_hdl->write(mcp23008_hdl->intf_hdl, mcp23008_hdl->slv_addr,DEFVAL,&data,1);
-                                    }
-                                }
-                            }
-                        }
-                        break;
+                case MCP23008_GPIO_INTR_FALLING:
+                    ret=mcp23008_reg_write(mcp23008_hdl,DEFVAL,mcp23008_hdl->shdw[DEFVAL] | gpio_pin);
+                    if(ret == MCP23008_SCS)
+                    {
+                        ret=mcp23008_reg_write(mcp23008_hdl,INTCON,mcp23008_hdl->shdw[INTCON] | gpio_pin);
+                    }
+                    break;
 
-                    default:
-                        break;
-                }
+                default:
+                    break;
             }
-            else
+            if(ret == MCP23008_SCS && intr_typ != MCP23008_GPIO_INTR_DISABLE)
+            {
+                ret=mcp23008_reg_write(mcp23008_hdl,GPINTEN,mcp23008_hdl->shdw[GPINTEN] | gpio_pin);
+            }
+            if(ret == MCP23008_SCS && intr_typ != MCP23008_GPIO_INTR_DISABLE)
             {
-                ret=MCP23008_INVLD_ARG;
+                /* Load the input shadow, from here on changes are picked up by mcp23008_intr_refresh */
+                if(mcp23008_hdl->read(mcp23008_hdl->intf_hdl, mcp23008_hdl->slv_addr,GPIO_PORT,&mcp23008_hdl->shdw[GPIO_PORT],1) != MCP23008_SCS)
+                {
+                    ret=MCP23008_COM_ERR;
+                }
             }
         }
+        else
+        {
+            ret=MCP23008_INVLD_ARG;
+        }
     }
     else
     {
@@ -510,22 +482,20 @@ e_mcp23008_err mcp23008_int_pin_polarity_cfg(s_mcp23008* mcp23008_hdl,e_int_pin_
     {
         if(polarity<MCP23008_INT_PLRTY_MAX)
         {
-            if(mcp23008_hdl->read(mcp23008_hdl->intf_hdl, mcp23008_hdl->slv_addr,IOCON,&data,1) == MCP23008_SCS)
+            data = mcp23008_hdl->shdw[IOCON];
+            if(polarity == MCP23008_INT_HIGH_IMPEDANCE)
             {
-                if(polarity == MCP23008_INT_HIGH_IMPEDANCE)
-                {
-                    data = (data & 0xFB) | 0x04 ;
-                }
-                else if (polarity == MCP23008_INT_ACT_HIGH)
-                {
-                    data = (data & 0xF9) | 0x02 ;
-                }
-                else
-                {
-                    data = (data & 0xF9);
-                }
-                ret= mcp23008_hdl->write(mcp23008_hdl->intf_hdl, mcp23008_hdl->slv_addr,IOCON,&data,1);
+                data = (data & 0xFB) | 0x04 ;
             }
+            else if (polarity == MCP23008_INT_ACT_HIGH)
+            {
+                data = (data & 0xF9) | 0x02 ;
+            }
+            else
+            {
+                data = (data & 0xF9);
+            }
+            ret= mcp23008_reg_write(mcp23008_hdl,IOCON,data);
         }
         else
         {
@@ -539,4 +509,74 @@ e_mcp23008_err mcp23008_int_pin_polarity_cfg(s_mcp23008* mcp23008_hdl,e_int_pin_
     return ret;
 }
 
+/*!
+ * @brief This function updates the output latch of the port in one write
+ */
+e_mcp23008_err mcp23008_port_update(s_mcp23008* mcp23008_hdl, uint8_t set_msk, uint8_t clr_msk, uint8_t tgl_msk)
+{
+    e_mcp23008_err ret= MCP23008_ERR;
+    uint8_t data;
+    if(mcp23008_null_ptr_check(mcp23008_hdl)==MCP23008_SCS)
+    {
+        data = ((mcp23008_hdl->shdw[OLAT] | set_msk) & (~clr_msk)) ^ tgl_msk;
+        ret = mcp23008_reg_write(mcp23008_hdl,OLAT,data);
+    }
+    else
+    {
+        ret=MCP23008_NULL_PTR;
+    }
+    return ret;
+}
+
+/*!
+ * @brief This function reads the port and refreshes the input shadow
+ */
+e_mcp23008_err mcp23008_read_port(s_mcp23008* mcp23008_hdl, uint8_t* port_ste)
+{
+    e_mcp23008_err ret= MCP23008_ERR;
+    if(mcp23008_null_ptr_check(mcp23008_hdl)==MCP23008_SCS && port_ste != NULL)
+    {
+        if(mcp23008_hdl->read(mcp23008_hdl->intf_hdl, mcp23008_hdl->slv_addr,GPIO_PORT,&mcp23008_hdl->shdw[GPIO_PORT],1) == MCP23008_SCS)
+        {
+            *port_ste = mcp23008_hdl->shdw[GPIO_PORT];
+            ret = MCP23008_SCS;
+        }
+        else
+        {
+            ret = MCP23008_COM_ERR;
+        }
+    }
+    else
+    {
+        ret=MCP23008_NULL_PTR;
+    }
+    return ret;
+}
+
+/*!
+ * @brief This function services the interrupt and refreshes the input shadow
+ */
+e_mcp23008_err mcp23008_intr_refresh(s_mcp23008* mcp23008_hdl, uint8_t* intr_flg)
+{
+    e_mcp23008_err ret= MCP23008_ERR;
+    if(mcp23008_null_ptr_check(mcp23008_hdl)==MCP23008_SCS && intr_flg != NULL)
+    {
+        /* INTF, INTCAP and GPIO are adjacent, reading INTCAP or GPIO clears the interrupt */
+        if(mcp23008_hdl->read(mcp23008_hdl->intf_hdl, mcp23008_hdl->slv_addr,INTF,&mcp23008_hdl->shdw[INTF],3) == MCP23008_SCS)
+        {
+            *intr_flg = mcp23008_hdl->shdw[INTF];
+            ret = MCP23008_SCS;
+        }
+        else
+        {
+            ret = MCP23008_COM_ERR;
+        }
+    }
+    else
+    {
+        ret=MCP23008_NULL_PTR;
+    }
+    return ret;
+}
+
 
@@ -217,6 +217,23 @@ typedef struct
     void* cb_func_args;                 /*!< Interrupt callback function argument*/
 }pcal6408a_intr_info;
 
+/**
+ * @brief pcal6408a register shadow, configuration registers are written
+ * through it and input holds the last value read from the input port
+ */
+typedef struct
+{
+    uint8_t input;                     /*!< Input port, refreshed on port reads and interrupts */
+    uint8_t output;                    /*!< Output port register            */
+    uint8_t pol_inv;                   /*!< Polarity inversion register     */
+    uint8_t config;                    /*!< Configuration register          */
+    uint8_t in_latch;                  /*!< Input latch register            */
+    uint8_t pull_en;                   /*!< Pull-up/pull-down enable register */
+    uint8_t pull_sel;                  /*!< Pull-up/pull-down selection register */
+    uint8_t int_mask;                  /*!< Interrupt mask register         */
+    uint8_t out_cfg;                   /*!< Output port configuration register */
+}pcal6408a_shdw;
+
 /**
  * @brief pcal6408a expander device structure definition
  *
@@ -228,6 +245,7 @@ typedef struct _pcal6408a_dev
     pcal6408a_read_fptr_t  read;       /*!< Read function pointer 			*/
     pcal6408a_write_fptr_t write;      /*!< Write function pointer 			*/
     pcal6408a_intr_info intr_info[8];  /*!< Interrupt information structure array  	*/
+    pcal6408a_shdw shdw;               /*!< Register shadow, loaded by pcal6408a_gpio_init */
 } pcal6408a_dev;
 
 /**
@@ -246,10 +264,10 @@ typedef struct __pcal6408a_gpio_cfg
 }pcal6408a_gpio_cfg;
 
 /**
- * @brief This API initializes the gpio pin as per the gpio_config. This api
- * needs to be called for all the gpio expander pins.
+ * @brief This API initializes the device handle and loads the register
+ * shadow. It must be called before any other API, configuration registers
+ * are then written through the shadow and only when they change.
  * @param[in] hdev        : Structure instance of pcal6408a_dev.
- * @param[in] gpio_config : configuration of the gpio pin
  * @return Result of API execution status
  * @retval zero -> Success / -ve value -> Error.
  */
@@ -286,7 +304,9 @@ int8_t pcal6408a_read(pcal6408a_dev *hdev, uint8_t reg, uint8_t *data, uint16_t
 int8_t pcal6408a_write(pcal6408a_dev *hdev, uint8_t reg, uint8_t *data, uint16_t len);
 
 /**
- * @brief This API is used to read the state of the gpio pin
+ * @brief This API is used to read the state of the gpio pin. Pins with the
+ * interrupt unmasked are served from the input shadow refreshed by
+ * pcal6408a_intr_refresh, other pins are read from the input port
  * @param[in] hdev    : Structure instance of pcal6408a_dev.
  * @param[in] pin     : pin whose state needs to be read
  * @param[out] state  : state of the gpio pin
@@ -452,4 +472,35 @@ pcal6408a_pin_lat pcal6408a_get_input_latch(pcal6408a_dev *hdev, pcal6408a_gpio_
  */
 int8_t pcal6408a_gpio_pin_cfg(pcal6408a_dev *hdev, pcal6408a_gpio_cfg *gpio_config);
 
+/**
+ * @brief This API updates the output port in one write, the new output is
+ * ((output | set_msk) & ~clr_msk) ^ tgl_msk
+ * @param[in] hdev    : Structure instance of pcal6408a_dev.
+ * @param[in] set_msk : pins to be driven high
+ * @param[in] clr_msk : pins to be driven low
+ * @param[in] tgl_msk : pins to be toggled
+ * @return Result of API execution status
+ * @retval zero -> Success / -ve value -> Error.
+ */
+int8_t pcal6408a_port_update(pcal6408a_dev *hdev, uint8_t set_msk, uint8_t clr_msk, uint8_t tgl_msk);
+
+/**
+ * @brief This API reads the input port and refreshes the input shadow
+ * @param[in] hdev      : Structure instance of pcal6408a_dev.
+ * @param[out] port_ste : state of all the pins
+ * @return Result of API execution status
+ * @retval zero -> Success / -ve value -> Error.
+ */
+int8_t pcal6408a_read_port(pcal6408a_dev *hdev, uint8_t *port_ste);
+
+/**
+ * @brief This API services the interrupt, the interrupt status and the input
+ * port are read, which clears the interrupt and refreshes the input shadow
+ * @param[in] hdev      : Structure instance of pcal6408a_dev.
+ * @param[out] intr_flg : pins that caused the interrupt
+ * @return Result of API execution status
+ * @retval zero -> Success / -ve value -> Error.
+ */
+int8_t pcal6408a_intr_refresh(pcal6408a_dev *hdev, uint8_t *intr_flg);
+
 #endif /*GPIO_EXP_PCAL6408A_H_ */
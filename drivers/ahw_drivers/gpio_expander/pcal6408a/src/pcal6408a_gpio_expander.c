@@ -41,11 +41,22 @@ static uint8_t bit_write (uint8_t data, pcal6408a_gpio_pin pin, uint8_t flag);
  */
 static int8_t is_gpio_valid (pcal6408a_gpio_pin pin);
 
+/*!
+ * @brief This utility API writes a register through its shadow, nothing is
+ * sent when the value is unchanged
+ * @param[in] hdev  : Structure instance of pcal6408a_dev.
+ * @param[in] reg   : Address of the register
+ * @param[in] shdw  : shadow of the register
+ * @param[in] data  : new register value
+ * @return Result of API execution status
+ * @retval zero -> Success / -ve value -> Error.
+ */
+static int8_t shdw_write (pcal6408a_dev *hdev, uint8_t reg, uint8_t *shdw, uint8_t data);
+
 /*********************** User function definitions ****************************/
 
 /**
- * @brief This API initializes the gpio pin as per the gpio_config. This api
- * needs to be called for all the gpio expander pins.
+ * @brief This API initializes the device handle and loads the register shadow
  */
 int8_t pcal6408a_gpio_init(pcal6408a_dev *hdev)
 {
@@ -57,7 +68,19 @@ int8_t pcal6408a_gpio_init(pcal6408a_dev *hdev)
     }
     else
     {
-        rslt=PCAL6408A_OK;
+        /* The command byte does not auto increment, each register is read on its own */
+        const uint8_t reg[] = {PCAL6408_REG_INPUT, PCAL6408_REG_OUTPUT, PCAL6408_REG_POLARITY_INVERSION,
+                               PCAL6408_REG_CONFIG, PCAL6408_REG_INPUT_LATCH, PCAL6408_REG_PULL_ENABLE,
+                               PCAL6408_REG_PULL_UP_DOWN, PCAL6408_REG_INT_MASK, PCAL6408_REG_OUT_CONFIG};
+        uint8_t *shdw[] = {&hdev->shdw.input, &hdev->shdw.output, &hdev->shdw.pol_inv,
+                           &hdev->shdw.config, &hdev->shdw.in_latch, &hdev->shdw.pull_en,
+                           &hdev->shdw.pull_sel, &hdev->shdw.int_mask, &hdev->shdw.out_cfg};
+        uint8_t i;
+        rslt = PCAL6408A_OK;
+        for(i = 0; (i < sizeof(reg)) && (PCAL6408A_OK == rslt); i++)
+        {
+            rslt = pcal6408a_read(hdev, reg[i], shdw[i], 1);
+        }
     }
     return rslt;
 }
@@ -70,7 +93,7 @@ int8_t pcal6408a_self_test(pcal6408a_dev *hdev)
     uint8_t data;
     uint8_t write_data =0x41;
     uint8_t read_data =0;
-    sts = pcal6408a_read(hdev,PCAL6408_REG_INPUT_LATCH, &data,2);
+    sts = pcal6408a_read(hdev,PCAL6408_REG_INPUT_LATCH, &data,1);
     if(sts ==PCAL6408A_OK)
     {
         pcal6408a_write(hdev,PCAL6408_REG_INPUT_LATCH ,&write_data, 1);
@@ -147,14 +170,27 @@ int8_t pcal6408a_readpin(pcal6408a_dev *hdev, pcal6408a_gpio_pin pin, pcal6408a_
     {
         status = PCAL6408A_E_OUT_OF_RANGE;
     }
+    else if ((NULL == hdev) || (NULL == state))
+    {
+        status = PCAL6408A_E_NULL_PTR;
+    }
     else
     {
-        if(pcal6408a_get_input_latch(hdev, pin)== LATCH)
+        if((pin & hdev->shdw.int_mask) == 0)
+        {
+            /* Any change of these pins raises an interrupt which refreshes the shadow */
+            data = hdev->shdw.input;
+        }
+        else if((pin & hdev->shdw.in_latch) != 0)
         {
             pcal6408a_set_input_latch(hdev, pin, NO_LATCH);
-            status = pcal6408a_read(hdev, PCAL6408_REG_INPUT, &data, 1);
+            status = pcal6408a_read_port(hdev, &data);
             pcal6408a_set_input_latch(hdev, pin, LATCH);
         }
+        else
+        {
+            status = pcal6408a_read_port(hdev, &data);
+        }
         if (PCAL6408A_OK == status)
         {
             data = (data & pin);
@@ -181,25 +217,19 @@ int8_t pcal6408a_readpin(pcal6408a_dev *hdev, pcal6408a_gpio_pin pin, pcal6408a_
  */
 int8_t pcal6408a_writepin(pcal6408a_dev *hdev, pcal6408a_gpio_pin pin, pcal6408a_gpio_pinstate state)
 {
-    uint8_t data;
     int8_t status;
     status = is_gpio_valid(pin);
     if (PCAL6408A_OK != status)
     {
         status = PCAL6408A_E_OUT_OF_RANGE;
     }
+    else if (state)
+    {
+        status = pcal6408a_port_update(hdev, pin, 0, 0);
+    }
     else
     {
-        status = pcal6408a_read(hdev, PCAL6408_REG_OUTPUT, &data, 1);
-        if (PCAL6408A_OK == status)
-        {
-            data = bit_write(data, pin, state);
-            status = pcal6408a_write(hdev, PCAL6408_REG_OUTPUT, &data, 1);
-        }
-        else
-        {
-
-        }
+        status = pcal6408a_port_update(hdev, 0, pin, 0);
     }
     return status;
 }
@@ -209,7 +239,6 @@ int8_t pcal6408a_writepin(pcal6408a_dev *hdev, pcal6408a_gpio_pin pin, pcal6408a
  */
 int8_t pcal6408a_togglepin(pcal6408a_dev *hdev, pcal6408a_gpio_pin pin)
 {
-    uint8_t data;
     int8_t status;
     status = is_gpio_valid(pin);
     if (PCAL6408A_OK != status)
@@ -218,16 +247,7 @@ int8_t pcal6408a_togglepin(pcal6408a_dev *hdev, pcal6408a_gpio_pin pin)
     }
     else
     {
-        status = pcal6408a_read(hdev, PCAL6408_REG_OUTPUT, &data, 1);
-        if (PCAL6408A_OK == status)
-        {
-            data = (data ^ (1 << pin));
-            status = pcal6408a_write(hdev, PCAL6408_REG_OUTPUT, &data, 1);
-        }
-        else
-        {
-
-        }
+        status = pcal6408a_port_update(hdev, 0, 0, pin);
     }
     return status;
 }
@@ -238,25 +258,19 @@ int8_t pcal6408a_togglepin(pcal6408a_dev *hdev, pcal6408a_gpio_pin pin)
  */
 int8_t pcal6408a_set_dir(pcal6408a_dev *hdev, pcal6408a_gpio_pin pin, pcal6408a_pin_dir dir)
 {
-    uint8_t data;
     int8_t status;
     status = is_gpio_valid(pin);
     if (PCAL6408A_OK != status)
     {
         status = PCAL6408A_E_OUT_OF_RANGE;
     }
+    else if (NULL == hdev)
+    {
+        status = PCAL6408A_E_NULL_PTR;
+    }
     else
     {
-        status = pcal6408a_read(hdev, PCAL6408_REG_CONFIG, &data, 1);
-        if (PCAL6408A_OK == status)
-        {
-            data = bit_write(data, pin, dir);
-            status = pcal6408a_write(hdev, PCAL6408_REG_CONFIG, &data, 1);
-        }
-        else
-        {
-
-        }
+        status = shdw_write(hdev, PCAL6408_REG_CONFIG, &hdev->shdw.config, bit_write(hdev->shdw.config, pin, dir));
     }
 
     return status;
@@ -316,26 +330,19 @@ int8_t pcal6408a_set_strength(pcal6408a_dev *hdev, pcal6408a_gpio_pin pin, pcal6
  */
 int8_t pcal6408a_set_pol_inv(pcal6408a_dev *hdev, pcal6408a_gpio_pin pin, pcal6408a_pin_pol polarity)
 {
-    uint8_t data;
     int8_t status;
     status = is_gpio_valid(pin);
     if (PCAL6408A_OK != status)
     {
         status = PCAL6408A_E_OUT_OF_RANGE;
     }
-    else
-    {
-        status = pcal6408a_read(hdev, PCAL6408_REG_POLARITY_INVERSION, &data, 1);
-    }
-
-    if (PCAL6408A_OK == status)
+    else if (NULL == hdev)
     {
-        data = bit_write(data, pin, polarity);
-        status = pcal6408a_write(hdev, PCAL6408_REG_POLARITY_INVERSION, &data, 1);
+        status = PCAL6408A_E_NULL_PTR;
     }
     else
     {
-
+        status = shdw_write(hdev, PCAL6408_REG_POLARITY_INVERSION, &hdev->shdw.pol_inv, bit_write(hdev->shdw.pol_inv, pin, polarity));
     }
 
     return status;
@@ -347,26 +354,19 @@ int8_t pcal6408a_set_pol_inv(pcal6408a_dev *hdev, pcal6408a_gpio_pin pin, pcal64
  */
 int8_t pcal6408a_set_input_latch(pcal6408a_dev *hdev, pcal6408a_gpio_pin pin, pcal6408a_pin_lat latch)
 {
-    uint8_t data;
     int8_t status;
     status = is_gpio_valid(pin);
     if (PCAL6408A_OK != status)
     {
         status = PCAL6408A_E_OUT_OF_RANGE;
     }
-    else
+    else if (NULL == hdev)
     {
-        status = pcal6408a_read(hdev, PCAL6408_REG_INPUT_LATCH, &data, 1);
-    }
-
-    if (PCAL6408A_OK == status)
-    {
-        data = bit_write(data, pin, latch);
-        status = pcal6408a_write(hdev, PCAL6408_REG_INPUT_LATCH, &data, 1);
+        status = PCAL6408A_E_NULL_PTR;
     }
     else
     {
-
+        status = shdw_write(hdev, PCAL6408_REG_INPUT_LATCH, &hdev->shdw.in_latch, bit_write(hdev->shdw.in_latch, pin, latch));
     }
 
     return status;
@@ -378,25 +378,19 @@ int8_t pcal6408a_set_input_latch(pcal6408a_dev *hdev, pcal6408a_gpio_pin pin, pc
  */
 pcal6408a_pin_lat pcal6408a_get_input_latch(pcal6408a_dev *hdev, pcal6408a_gpio_pin pin)
 {
-    uint8_t data = 0;
     uint8_t status;
     status = is_gpio_valid(pin);
     if (PCAL6408A_OK != status)
     {
         status = PCAL6408A_E_OUT_OF_RANGE;
     }
+    else if((hdev != NULL) && ((pin & hdev->shdw.in_latch) > 0))
+    {
+        status = LATCH;
+    }
     else
     {
-        status = pcal6408a_read(hdev,PCAL6408_REG_INPUT_LATCH,&data,1);
-        data = pin & data;
-        if(data>0)
-        {
-            status = LATCH;
-        }
-        else
-        {
-            status = NO_LATCH;
-        }
+        status = NO_LATCH;
     }
 
     return status;
@@ -408,25 +402,19 @@ pcal6408a_pin_lat pcal6408a_get_input_latch(pcal6408a_dev *hdev, pcal6408a_gpio_
  */
 int8_t pcal6408a_enable_pull(pcal6408a_dev *hdev, pcal6408a_gpio_pin pin, pcal6408a_pin_pull flag)
 {
-    uint8_t data;
     int8_t status;
     status = is_gpio_valid(pin);
     if (PCAL6408A_OK != status)
     {
         status = PCAL6408A_E_OUT_OF_RANGE;
     }
+    else if (NULL == hdev)
+    {
+        status = PCAL6408A_E_NULL_PTR;
+    }
     else
     {
-        status = pcal6408a_read(hdev, PCAL6408_REG_PULL_ENABLE, &data, 1);
-        if (PCAL6408A_OK == status)
-        {
-            data = bit_write(data, pin, flag);
-            status = pcal6408a_write(hdev, PCAL6408_REG_PULL_ENABLE, &data, 1);
-        }
-        else
-        {
-
-        }
+        status = shdw_write(hdev, PCAL6408_REG_PULL_ENABLE, &hdev->shdw.pull_en, bit_write(hdev->shdw.pull_en, pin, flag));
     }
 
     return status;
@@ -438,31 +426,29 @@ int8_t pcal6408a_enable_pull(pcal6408a_dev *hdev, pcal6408a_gpio_pin pin, pcal64
  */
 int8_t pcal6408a_set_pull_up_dwn(pcal6408a_dev *hdev, pcal6408a_gpio_pin pin, pcal6408a_pin_up_dwn flag)
 {
-    uint8_t data;
     int8_t status;
     status = is_gpio_valid(pin);
     if (PCAL6408A_OK != status)
     {
         status = PCAL6408A_E_OUT_OF_RANGE;
     }
+    else if (NULL == hdev)
+    {
+        status = PCAL6408A_E_NULL_PTR;
+    }
     else
     {
         if(flag==NO_PULL)
         {
-            pcal6408a_enable_pull(hdev,pin,PULL_DISABLED);
+            status = pcal6408a_enable_pull(hdev,pin,PULL_DISABLED);
         }
         else
         {
-            pcal6408a_enable_pull(hdev,pin,PULL_ENABLED);
-            status = pcal6408a_read(hdev, PCAL6408_REG_PULL_UP_DOWN, &data, 1);
+            /* Select the direction first so the resistor never connects the wrong way */
+            status = shdw_write(hdev, PCAL6408_REG_PULL_UP_DOWN, &hdev->shdw.pull_sel, bit_write(hdev->shdw.pull_sel, pin, flag));
             if (PCAL6408A_OK == status)
             {
-                data = bit_write(data, pin, flag);
-                status = pcal6408a_write(hdev, PCAL6408_REG_PULL_UP_DOWN, &data, 1);
-            }
-            else
-            {
-
+                status = pcal6408a_enable_pull(hdev,pin,PULL_ENABLED);
             }
         }
     }
@@ -475,22 +461,23 @@ int8_t pcal6408a_set_pull_up_dwn(pcal6408a_dev *hdev, pcal6408a_gpio_pin pin, pc
  */
 int8_t pcal6408a_intr_config(pcal6408a_dev *hdev, pcal6408a_gpio_pin pin, pcal6408a_intr_mode intr_mode)
 {
-    uint8_t data;
     int8_t status;
     status = is_gpio_valid(pin);
     if (PCAL6408A_OK != status)
     {
         status = PCAL6408A_E_OUT_OF_RANGE;
     }
+    else if (NULL == hdev)
+    {
+        status = PCAL6408A_E_NULL_PTR;
+    }
     else
     {
         if(intr_mode<INTRUPT_DISABLE)
         {
-            status = pcal6408a_read(hdev, PCAL6408_REG_INT_MASK, &data, 1);
+            status = shdw_write(hdev, PCAL6408_REG_INT_MASK, &hdev->shdw.int_mask, bit_write(hdev->shdw.int_mask, pin, 0));
             if (PCAL6408A_OK == status)
             {
-                data = bit_write(data,pin,0);
-                status = pcal6408a_write(hdev, PCAL6408_REG_INT_MASK, &data, 1);
                 pcal6408a_set_input_latch(hdev, pin, LATCH);
             }
         }
@@ -508,30 +495,78 @@ int8_t pcal6408a_read_intr_sts(pcal6408a_dev *hdev,uint8_t* intr_flg)
     return status;
 }
 
+/**
+ * @brief This API updates the output port in one write
+ */
+int8_t pcal6408a_port_update(pcal6408a_dev *hdev, uint8_t set_msk, uint8_t clr_msk, uint8_t tgl_msk)
+{
+    int8_t status;
+    if (NULL == hdev)
+    {
+        status = PCAL6408A_E_NULL_PTR;
+    }
+    else
+    {
+        status = shdw_write(hdev, PCAL6408_REG_OUTPUT, &hdev->shdw.output, ((hdev->shdw.output | set_msk) & ~clr_msk) ^ tgl_msk);
+    }
+    return status;
+}
+
+/**
+ * @brief This API reads the input port and refreshes the input shadow
+ */
+int8_t pcal6408a_read_port(pcal6408a_dev *hdev, uint8_t *port_ste)
+{
+    int8_t status;
+    if ((NULL == hdev) || (NULL == port_ste))
+    {
+        status = PCAL6408A_E_NULL_PTR;
+    }
+    else
+    {
+        status = pcal6408a_read(hdev, PCAL6408_REG_INPUT, &hdev->shdw.input, 1);
+        if (PCAL6408A_OK == status)
+        {
+            *port_ste = hdev->shdw.input;
+        }
+    }
+    return status;
+}
+
+/**
+ * @brief This API services the interrupt and refreshes the input shadow
+ */
+int8_t pcal6408a_intr_refresh(pcal6408a_dev *hdev, uint8_t *intr_flg)
+{
+    int8_t status;
+    uint8_t data;
+    status = pcal6408a_read_intr_sts(hdev, intr_flg);
+    if (PCAL6408A_OK == status)
+    {
+        /* Reading the input port clears the interrupt */
+        status = pcal6408a_read_port(hdev, &data);
+    }
+    return status;
+}
+
 /**
  * @brief This API configures the output port as push-pull or open-drain.
  */
 int8_t pcal6408a_set_port_cfg(pcal6408a_dev *hdev, pcal6408a_gpio_pin pin, pcal6408a_port_cfg flag)
 {
-    uint8_t data;
     int8_t status;
     status = is_gpio_valid(pin);
     if (PCAL6408A_OK != status)
     {
         status = PCAL6408A_E_OUT_OF_RANGE;
     }
+    else if (NULL == hdev)
+    {
+        status = PCAL6408A_E_NULL_PTR;
+    }
     else
     {
-        status = pcal6408a_read(hdev, PCAL6408_REG_OUT_CONFIG, &data, 1);
-        if (PCAL6408A_OK == status)
-        {
-            data = bit_write(data, pin, flag);
-            status = pcal6408a_write(hdev, PCAL6408_REG_OUT_CONFIG, &data, 1);
-        }
-        else
-        {
-
-        }
+        status = shdw_write(hdev, PCAL6408_REG_OUT_CONFIG, &hdev->shdw.out_cfg, bit_write(hdev->shdw.out_cfg, pin, flag));
     }
 
     return status;
@@ -618,6 +653,25 @@ static uint8_t bit_write(uint8_t data, pcal6408a_gpio_pin pin, uint8_t flag)
     return data;
 }
 
+/**
+ * @brief This utility API writes a register through its shadow
+ */
+static int8_t shdw_write(pcal6408a_dev *hdev, uint8_t reg, uint8_t *shdw, uint8_t data)
+{
+    int8_t rslt = PCAL6408A_OK;
+
+    if(data != *shdw)
+    {
+        rslt = pcal6408a_write(hdev, reg, &data, 1);
+        if(PCAL6408A_OK == rslt)
+        {
+            *shdw = data;
+        }
+    }
+
+    return rslt;
+}
+
 /**
  * @brief This utility API is used to check the validity of the gpio pin number
  */
@@ -209,7 +209,7 @@ e_adm1176_err adm1176_get_sts(s_adm1176_drv_cb_ptr adm1176_hdl,uint8_t *sts)
     e_adm1176_err err_sts;
     uint8_t cmd =0x40;
     err_sts=null_ptr_check(adm1176_hdl);
-    if(sts!=ADM1176_SCS || sts==NULL)
+    if(err_sts!=ADM1176_SCS || sts==NULL)
     {
         err_sts=NULL_PTR_ER;
     }
@@ -1626,8 +1626,13 @@ int8_t bmi160_soft_reset(struct bmi160_dev *dev)
     }
     else
     {
-        rslt = set_mag_soft_reset(dev);
-        dev->delay_ms(BMI160_SOFT_RESET_DELAY_MS);
+        /* The magnetometer is only reachable once the aux interface is set up,
+         * before that the command register reset below covers it */
+        if (dev->aux_cfg.aux_sensor_enable == BMI160_ENABLE)
+        {
+            rslt = set_mag_soft_reset(dev);
+            dev->delay_ms(BMI160_SOFT_RESET_DELAY_MS);
+        }
         if (BMI160_OK == rslt)
         {
 
@@ -26,6 +26,16 @@
 
 #define DEF_CALIB 0x0A00  ///< calibration
 
+#define INA230_READ_REGS_MAX 8  ///< maximum number of registers of one read_regs call
+
+/**
+ * @brief Number of times a snapshot is read again when a conversion completes
+ *        while it is being read
+ */
+#ifndef INA230_SNAPSHOT_RETRY
+#define INA230_SNAPSHOT_RETRY 2
+#endif
+
 /**
  * @brief read function pointer
  */
@@ -36,6 +46,12 @@ typedef uint8_t (*psm_ina230_read_fptr_t)(void* intf_hdl,uint16_t slave_address,
  */
 typedef uint8_t (*psm_ina230_write_fptr_t)(void* intf_hdl,uint16_t slave_address, uint8_t reg_addr, uint8_t *read_data, uint16_t len);
 
+/**
+ * @brief read function pointer for several registers in one bus access, each
+ *        register is read with its own repeated start and takes 2 bytes of data
+ */
+typedef uint8_t (*psm_ina230_read_regs_fptr_t)(void* intf_hdl,uint16_t slave_address, const uint8_t *reg_addr, uint8_t *data, uint16_t count);
+
 
 /** @brief  Power Monitor Alert Latch Enable enumeration
  *
@@ -178,6 +194,7 @@ typedef struct
     ina230_inputsignal_t inputsignal;       /*!< input signal enumeration       */
     ina230_operatingmode_t mode;            /*!< Operating mode enumeration     */
     ina230_flag_t flag;             /*!< INA230 flag enumeration        */
+    psm_ina230_read_regs_fptr_t read_regs;  /*!< multi register read function pointer, optional */
 } psm_ina230_dev_t;
 
 /**
@@ -199,6 +216,23 @@ typedef struct
  */
 typedef ina230_alertpinconfig_t *ina230_alert_pinconfig_ptr_t;
 
+/**
+ * @brief power Monitor measurement snapshot structure, all values come from
+ *        the same conversion cycle
+ */
+typedef struct
+{
+    uint16_t mask_enable;       /*!< Mask/Enable register, flags at read time */
+    uint16_t vshunt_raw;        /*!< Shunt voltage register                   */
+    uint16_t vbus_raw;          /*!< Bus voltage register                     */
+    uint16_t power_raw;         /*!< Power register                           */
+    uint16_t current_raw;       /*!< Current register                         */
+    float vshunt;               /*!< shunt voltage                            */
+    float vbus;                 /*!< bus voltage (in V)                       */
+    uint32_t power;             /*!< power (in mW)                            */
+    float current;              /*!< current (in A)                           */
+} ina230_snapshot_t;
+
 /**
  * @brief Write access to INA230 register
  * @param[in] ina230_hdl : structure handle of power sense monitor of ina230`
@@ -430,6 +464,17 @@ uint32_t ina230_get_power(ina230_dev_ptr_t ina230_hdl);
  */
 float ina230_get_current(ina230_dev_ptr_t ina230_hdl);
 
+/**
+ * @brief get shunt voltage, bus voltage, power and current of one conversion.
+ *        The conversion ready flag and the measurement registers are read in a
+ *        single bus access when read_regs is provided, the flag is cleared by the read.
+ * @param[in] ina230_hdl    : structure handle of power sense monitor of ina230.
+ * @param[out] snapshot     : measured values
+ * @retval e_ina230_sts - INA230_SCS, INA230_E_NOT_READY when no conversion completed
+ *         since the last read of the flags, or the error code
+ */
+e_ina230_sts ina230_get_snapshot(ina230_dev_ptr_t ina230_hdl, ina230_snapshot_t *snapshot);
+
 /**
  * @brief  Read the designed flag value
  * @param  Flag specifies the flag to check.
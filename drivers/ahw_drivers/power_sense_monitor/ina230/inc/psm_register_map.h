@@ -177,6 +177,7 @@
 #define INA230_E_COM_FAIL			(-2)			/**< INA230 communication fail   */
 #define INA230_DEV_NOT_FOUND		(-4)			/**< INA230 DEVICE NOT FOUND */
 #define INA230_E_READ_FAIL			(-5)			/**< INA230 READ FAIL*/
+#define INA230_E_NOT_READY			(-6)			/**< INA230 CONVERSION NOT READY */
 
 /**
  * @brief INA230_FLAG INA230 flags
@@ -801,6 +801,121 @@ float ina230_get_current(ina230_dev_ptr_t ina230_hdl)
     return current;
 }
 
+/**
+ * @brief Registers of a snapshot. The Mask/Enable register is read before the
+ * measurements to check and clear the conversion ready flag and again after
+ * them to find out whether a new conversion completed in between.
+ */
+#define SNAPSHOT_FLAGS          0
+#define SNAPSHOT_VSHUNT         1
+#define SNAPSHOT_VBUS           2
+#define SNAPSHOT_PWR            3
+#define SNAPSHOT_CURRENT        4
+#define SNAPSHOT_FLAGS_END      5
+#define SNAPSHOT_REGS           6
+
+static const uint8_t snapshot_regs[SNAPSHOT_REGS] =
+{
+    INA230_REG_MASK_ENABLE,
+    INA230_REG_VSHUNT,
+    INA230_REG_VBUS,
+    INA230_REG_PWR,
+    INA230_REG_CURRENT,
+    INA230_REG_MASK_ENABLE
+};
+
+/**
+ * @brief  Read several registers, in one bus access when read_regs is provided
+ */
+static e_ina230_sts ina230_read_regs(ina230_dev_ptr_t ina230_hdl, const uint8_t *reg, uint16_t *data, uint16_t count)
+{
+    e_ina230_sts rslt = INA230_SCS;
+    uint8_t dt[2 * INA230_READ_REGS_MAX];
+    uint16_t i;
+
+    if (ina230_hdl->read_regs != NULL)
+    {
+        if (ina230_hdl->read_regs(ina230_hdl->io_intf_hdle, ina230_hdl->slave_address, reg, dt, count) != INA230_SCS)
+        {
+            rslt = INA230_E_READ_FAIL;
+        }
+    }
+    else
+    {
+        for (i = 0; (i < count) && (rslt == INA230_SCS); i++)
+        {
+            if (ina230_hdl->read(ina230_hdl->io_intf_hdle, ina230_hdl->slave_address, reg[i], &dt[2 * i], 2) != INA230_SCS)
+            {
+                rslt = INA230_E_READ_FAIL;
+            }
+        }
+    }
+    if (rslt == INA230_SCS)
+    {
+        for (i = 0; i < count; i++)
+        {
+            data[i] = (uint16_t)((dt[2 * i] << 8) | dt[(2 * i) + 1]);
+        }
+    }
+    return rslt;
+}
+
+/**
+ * @brief  Read the measurement registers of one conversion
+ */
+e_ina230_sts ina230_get_snapshot(ina230_dev_ptr_t ina230_hdl, ina230_snapshot_t *snapshot)
+{
+    e_ina230_sts rslt;
+    uint16_t val[SNAPSHOT_REGS];
+    uint8_t ready = 0;
+    uint8_t done = 0;
+    uint8_t retry = 0;
+
+    rslt = null_ptr_check_ina230(ina230_hdl);
+    if ((rslt != INA230_OK) || (snapshot == NULL))
+    {
+        rslt = INA230_E_NULL_PTR;
+    }
+    else
+    {
+        do
+        {
+            rslt = ina230_read_regs(ina230_hdl, snapshot_regs, val, SNAPSHOT_REGS);
+            if (rslt == INA230_SCS)
+            {
+                /* A retry follows a read that found and cleared the flag */
+                if ((val[SNAPSHOT_FLAGS] & INA230_REG_MASK_ENABLE_CVRF) == INA230_REG_MASK_ENABLE_CVRF)
+                {
+                    ready = 1;
+                }
+                if (((val[SNAPSHOT_FLAGS_END] & INA230_REG_MASK_ENABLE_CVRF) == 0) || (retry >= INA230_SNAPSHOT_RETRY))
+                {
+                    done = 1;
+                }
+                retry++;
+            }
+        } while ((rslt == INA230_SCS) && (ready == 1) && (done == 0));
+
+        if ((rslt == INA230_SCS) && (ready == 0))
+        {
+            rslt = INA230_E_NOT_READY;
+        }
+        else if (rslt == INA230_SCS)
+        {
+            snapshot->mask_enable = val[SNAPSHOT_FLAGS];
+            snapshot->vshunt_raw = val[SNAPSHOT_VSHUNT];
+            snapshot->vbus_raw = val[SNAPSHOT_VBUS];
+            snapshot->power_raw = val[SNAPSHOT_PWR];
+            snapshot->current_raw = val[SNAPSHOT_CURRENT];
+            snapshot->vshunt = val[SNAPSHOT_VSHUNT] * VSHUNT_DIV;
+            snapshot->vbus = val[SNAPSHOT_VBUS] * BUS_VOLTAGE_LSB;
+            snapshot->power = val[SNAPSHOT_PWR] * POWER_LSB;
+            snapshot->current = ((val[SNAPSHOT_CURRENT] * CURR_MULTIPLIER) / 1000);
+        }
+    }
+    return rslt;
+}
+
 static const uint16_t aMode[INA230_OPERATING_MODE_MAX][INA230_VOLTAGE_INPUT_MAX] = {
     {
         INA230_MODE_TRIGGERED_VSHUNT,
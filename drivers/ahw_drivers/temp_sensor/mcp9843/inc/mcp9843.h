@@ -88,6 +88,16 @@
 
 #define MSB_MASK                           		  (0xFF00)	///< Masking access to only the MSB values returned by the ambient temperature register
 
+#define MCP9843_TEMP_MASK                         (0x1FFF)	///< Two's complement temperature bits, LSB is 1/16 degree celsius
+#define MCP9843_TEMP_SIGN                         (0x1000)	///< Sign bit of the temperature
+#define MCP9843_LIMIT_MASK                        (0x1FFC)	///< Two's complement limit bits, LSB is 1/4 degree celsius
+#define MCP9843_ALERT_FLG_POS                     (13U)		///< TA vs TCRIT, TUPPER and TLOWER flags position in the temperature register
+
+/***********Event output bits of the configuration register LSB***********/
+#define MCP9843_EVENT_MODE_BIT_0                  (1<<0)	///< Event output mode, 0 comparator / 1 interrupt
+#define MCP9843_EVENT_SEL_BIT_2                   (1<<2)	///< Event output select, 0 all limits / 1 TCRIT only
+#define MCP9843_EVENT_CTRL_BIT_3                  (1<<3)	///< Event output enable
+
 /**
  * @brief read function pointer
  */
@@ -209,6 +219,11 @@ typedef struct
     mcp9843_res_t resolution;					/*!<resolution enumeration			*/
     mcp9843_read_fptr_t read;					/*!<read function pointer			*/
     mcp9843_write_fptr_t write;				/*!<write function pointer			*/
+    int32_t temp_mdeg;						/*!<last temperature read in alert mode, milli degree celsius */
+    uint32_t alert_hb_ms;						/*!<alert mode heartbeat period in mS, 0 reads on alert only */
+    uint32_t alert_rd_ms;						/*!<time of the last temperature read in alert mode */
+    uint8_t alert_en;						/*!<alert mode enabled by mcp9843_alert_mode_cfg() */
+    volatile uint8_t alert_pend;				/*!<alert reported by mcp9843_alert_notify(), not read yet */
 
 } mcp9843_dev_t;
 
@@ -433,4 +448,47 @@ e_temp_sensor_sts mcp9843_get_fahrenheit(mcp9843_dev_ptr_t mcp9843_hdl,float *te
  */
 e_temp_sensor_sts  mcp9843_get_celsius(mcp9843_dev_ptr_t mcp9843_hdl,float *temp_value);
 
+/**
+ * @brief Get the current Temperature in milli degree celsius, integer conversion
+ * of the temperature register without floating point
+ * @param[in] mcp9843_hdl 	: structure handle of temperature sensor MCP9843.
+ * @param[out] temp_mdeg 	: temperature value in milli degree celsius.
+ * @retval e_temp_sensor_sts	:returns the success or error code
+ */
+e_temp_sensor_sts mcp9843_get_temperature_mdeg(mcp9843_dev_ptr_t mcp9843_hdl,int32_t *temp_mdeg);
+
+/**
+ * @brief Configure alert driven sampling. TLOWER, TUPPER and TCRIT are
+ * programmed once and the EVENT pin is enabled in comparator mode for all the
+ * limits with the configured polarity. mcp9843_alert_poll() reads the sensor
+ * only after an alert or once per heartbeat period.
+ * @param[in] mcp9843_hdl 	: structure handle of temperature sensor MCP9843.
+ * @param[in] low_mdeg 		: TLOWER in milli degree celsius
+ * @param[in] high_mdeg 		: TUPPER in milli degree celsius
+ * @param[in] crit_mdeg 		: TCRIT in milli degree celsius
+ * @param[in] hb_ms 		: heartbeat period in mS, 0 reads on alert only
+ * @retval e_temp_sensor_sts	:returns the success or error code
+ */
+e_temp_sensor_sts mcp9843_alert_mode_cfg(mcp9843_dev_ptr_t mcp9843_hdl,int32_t low_mdeg,int32_t high_mdeg,int32_t crit_mdeg,uint32_t hb_ms);
+
+/**
+ * @brief Report an EVENT pin alert, no bus access so it can be called from the
+ * interrupt callback of the EVENT pin
+ * @param[in] mcp9843_hdl 	: structure handle of temperature sensor MCP9843.
+ */
+void mcp9843_alert_notify(mcp9843_dev_ptr_t mcp9843_hdl);
+
+/**
+ * @brief Temperature poll in alert mode. After an alert or when the heartbeat
+ * expires the temperature register is read, it also carries the limit flags.
+ * Otherwise the last temperature is returned without bus access.
+ * @param[in] mcp9843_hdl 	: structure handle of temperature sensor MCP9843.
+ * @param[in] now_ms 		: current time in mS
+ * @param[out] temp_mdeg 	: temperature value in milli degree celsius.
+ * @param[out] alert_sts 	: TA >= TCRIT (bit 2), TA > TUPPER (bit 1) and TA < TLOWER (bit 0)
+ *                          flags read by this poll, 0 when the sensor was not read
+ * @retval e_temp_sensor_sts	:returns the success or error code
+ */
+e_temp_sensor_sts mcp9843_alert_poll(mcp9843_dev_ptr_t mcp9843_hdl,uint32_t now_ms,int32_t *temp_mdeg,uint8_t *alert_sts);
+
 #endif /* INC_MCP9843_H_ */
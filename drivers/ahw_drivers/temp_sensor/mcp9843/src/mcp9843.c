@@ -44,7 +44,8 @@ static e_temp_sensor_sts mcp9843_temperature_calculation(mcp9843_dev_ptr_t mcp98
 
 static int16_t conv_temp_set(double temperature);
 static float conv_temp_get(int16_t data);
-static float arr[4]={0.0625,0.125,0.25,0.5};
+static int32_t conv_temp_get_mdeg(int16_t data);
+static int16_t conv_temp_set_mdeg(int32_t temp_mdeg);
 
 /**
  * @brief  Write access to MCP9843 register
@@ -100,25 +101,40 @@ static int16_t conv_temp_set(double temperature)
     return retval;
 }
 
+/*!
+ *  @brief This API sign extends the 13 bit temperature, the result is in 1/16 degree celsius
+ */
+static int16_t conv_temp_raw(int16_t data)
+{
+    return (int16_t)(((data & MCP9843_TEMP_MASK) ^ MCP9843_TEMP_SIGN) - MCP9843_TEMP_SIGN);
+}
+
 /*!
  *  @brief This API converts the register data into temperature in celsius
  */
 static float conv_temp_get(int16_t data)
 {
-    uint8_t temp_lsb;
-    int16_t temp_data;
-    float sum=0;
-    temp_data = data & 0x1FFF;
-    temp_data=(temp_data>>4);
-    temp_lsb=data;
-    temp_lsb=temp_lsb & 0x0F;
-    for(int i=0;i<4;i++)
-    {
-        sum=sum+((float)(temp_lsb & 0x01)*arr[i]);
-        temp_lsb=temp_lsb>>1;
-    }
-    sum=sum + (float)temp_data;
-    return(sum);
+    return ((float)conv_temp_raw(data) * 0.0625f);
+}
+
+/*!
+ *  @brief This API converts the register data into temperature in milli degree celsius
+ */
+static int32_t conv_temp_get_mdeg(int16_t data)
+{
+    /* 1000/16 = 125/2 */
+    return (((int32_t)conv_temp_raw(data) * 125) / 2);
+}
+
+/*!
+ *  @brief This API converts the temperature in milli degree celsius into the limit register format,
+ *  rounded to the nearest 1/4 degree celsius
+ */
+static int16_t conv_temp_set_mdeg(int32_t temp_mdeg)
+{
+    int32_t val = temp_mdeg * 4;
+    val = (val < 0) ? ((val - 500) / 1000) : ((val + 500) / 1000);
+    return (int16_t)(((uint16_t)val << 2) & MCP9843_LIMIT_MASK);
 }
 
 /**
@@ -151,6 +167,8 @@ e_temp_sensor_sts mcp9843_init(mcp9843_dev_ptr_t mcp9843_hdl)
     sts = null_ptr_check(mcp9843_hdl);
     if(sts==MCP9843_OK)
     {
+        mcp9843_hdl->alert_en=0;
+        mcp9843_hdl->alert_pend=0;
         sts=mcp9843_readreg(mcp9843_hdl, MCP9843_DVE_ID_REG_ADRR,&temp);
         if(sts==MCP9843_SCS)
         {
@@ -479,12 +497,12 @@ static e_temp_sensor_sts mcp9843_temperature_calculation(mcp9843_dev_ptr_t mcp98
     }
     else
     {
-        uint8_t temp_data[2];
         int16_t temp_data16;
-        mcp9843_hdl->read(mcp9843_hdl->io_intf_hdle,mcp9843_hdl->slave_address,MCP9843_TEMP_REG,(uint8_t*)&temp_data,2);
-        temp_data16 = temp_data[1] | temp_data[0]<<8;
-        *temperature=conv_temp_get(temp_data16);
-        cal =  MCP9843_OK;
+        cal=mcp9843_readreg(mcp9843_hdl,MCP9843_TEMP_REG,&temp_data16);
+        if(cal==MCP9843_OK)
+        {
+            *temperature=conv_temp_get(temp_data16);
+        }
 
     }
     return (cal);
@@ -680,3 +698,124 @@ uint16_t mcp9843_read_manufacture_id(mcp9843_dev_ptr_t mcp9843_hdl,int16_t* temp
     uint8_t temp=mcp9843_hdl->read(mcp9843_hdl->io_intf_hdle,mcp9843_hdl->slave_address,MCP9843_MANUFACTURE_ID_REG,&temp,2);
     return (temp);
 }
+
+/**
+ * @brief  Read MCP9843 temperature in milli degree celsius.
+ */
+e_temp_sensor_sts mcp9843_get_temperature_mdeg(mcp9843_dev_ptr_t mcp9843_hdl,int32_t *temp_mdeg)
+{
+    e_temp_sensor_sts sts;
+    int16_t temp_data16;
+    sts=mcp9843_readreg(mcp9843_hdl,MCP9843_TEMP_REG,&temp_data16);
+    if(sts==MCP9843_OK)
+    {
+        *temp_mdeg=conv_temp_get_mdeg(temp_data16);
+    }
+    return sts;
+}
+
+/**
+ * @brief  Configure MCP9843 alert driven sampling.
+ */
+e_temp_sensor_sts mcp9843_alert_mode_cfg(mcp9843_dev_ptr_t mcp9843_hdl,int32_t low_mdeg,int32_t high_mdeg,int32_t crit_mdeg,uint32_t hb_ms)
+{
+    e_temp_sensor_sts sts;
+    int16_t conf;
+    sts=null_ptr_check(mcp9843_hdl);
+    if (sts != MCP9843_OK)
+    {
+        sts =MCP9843_E_NULL_PTR;
+    }
+    else if(low_mdeg > high_mdeg || high_mdeg > crit_mdeg)
+    {
+        sts =MCP9843_ERR;
+    }
+    else
+    {
+        sts=mcp9843_writereg(mcp9843_hdl,MCP9843_T_LOWER,conv_temp_set_mdeg(low_mdeg));
+        if(sts==MCP9843_OK)
+        {
+            sts=mcp9843_writereg(mcp9843_hdl,MCP9843_T_UPPER,conv_temp_set_mdeg(high_mdeg));
+        }
+        if(sts==MCP9843_OK)
+        {
+            sts=mcp9843_writereg(mcp9843_hdl,MCP9843_T_CRITICAL,conv_temp_set_mdeg(crit_mdeg));
+        }
+        if(sts==MCP9843_OK)
+        {
+            sts=mcp9843_readreg(mcp9843_hdl,MCP9843_CONF_REG,&conf);
+        }
+        if(sts==MCP9843_OK)
+        {
+            /* comparator mode on all the limits, the pin follows the temperature */
+            conf=conf & ~(MCP9843_EVENT_MODE_BIT_0 | MCP9843_EVENT_SEL_BIT_2 | MCP9843_INT_CLEAR_BIT_05);
+            conf=conf | MCP9843_EVENT_CTRL_BIT_3;
+            sts=mcp9843_writereg(mcp9843_hdl,MCP9843_CONF_REG,conf);
+        }
+        if(sts==MCP9843_OK)
+        {
+            mcp9843_hdl->high_temp_threshold=(float)high_mdeg/1000.0f;
+            mcp9843_hdl->low_temp_threshold=(float)low_mdeg/1000.0f;
+            mcp9843_hdl->critical_temp_threshold=(float)crit_mdeg/1000.0f;
+            mcp9843_hdl->alert_hb_ms=hb_ms;
+            mcp9843_hdl->temp_mdeg=0;
+            /* the first poll reads the temperature and the flags */
+            mcp9843_hdl->alert_pend=1;
+            mcp9843_hdl->alert_en=1;
+        }
+    }
+    return sts;
+}
+
+/**
+ * @brief  Report a MCP9843 EVENT pin alert.
+ */
+void mcp9843_alert_notify(mcp9843_dev_ptr_t mcp9843_hdl)
+{
+    if(mcp9843_hdl != NULL)
+    {
+        mcp9843_hdl->alert_pend=1;
+    }
+}
+
+/**
+ * @brief  Read MCP9843 temperature in alert mode, the sensor is only read after an alert or at the heartbeat.
+ */
+e_temp_sensor_sts mcp9843_alert_poll(mcp9843_dev_ptr_t mcp9843_hdl,uint32_t now_ms,int32_t *temp_mdeg,uint8_t *alert_sts)
+{
+    e_temp_sensor_sts sts;
+    int16_t temp_data16;
+    uint8_t pend;
+    sts=null_ptr_check(mcp9843_hdl);
+    if (sts != MCP9843_OK)
+    {
+        sts =MCP9843_E_NULL_PTR;
+    }
+    else if(mcp9843_hdl->alert_en==0)
+    {
+        sts =MCP9843_ERR;
+    }
+    else
+    {
+        *alert_sts=0;
+        /* cleared before the read so that an alert raised meanwhile is not lost */
+        pend=mcp9843_hdl->alert_pend;
+        mcp9843_hdl->alert_pend=0;
+        if(pend!=0 || (mcp9843_hdl->alert_hb_ms!=0 && (uint32_t)(now_ms-mcp9843_hdl->alert_rd_ms)>=mcp9843_hdl->alert_hb_ms))
+        {
+            sts=mcp9843_readreg(mcp9843_hdl,MCP9843_TEMP_REG,&temp_data16);
+            if(sts==MCP9843_OK)
+            {
+                mcp9843_hdl->temp_mdeg=conv_temp_get_mdeg(temp_data16);
+                mcp9843_hdl->alert_rd_ms=now_ms;
+                *alert_sts=((uint16_t)temp_data16 >> MCP9843_ALERT_FLG_POS) & 0x07;
+            }
+            else
+            {
+                mcp9843_hdl->alert_pend=pend;
+            }
+        }
+        *temp_mdeg=mcp9843_hdl->temp_mdeg;
+    }
+    return sts;
+}
@@ -61,6 +61,10 @@
 #define MAX_DLY_TIME             2048	    	    			///< maximum delay time
 #define UCD9081_VREF_INTNL       2.5					///< ucd9081 internal voltage reference
 #define UCD9081_VREF_EXTNL       3.3				    	///< ucd9081 external voltage reference
+#define UCD9081_RAIL_CNT         8					///< number of monitored rails
+#define UCD9081_ADC_FS           1024					///< ucd9081 ADC full scale count
+#define UCD9081_RAIL_MASK        0x03FF					///< ucd9081 rail voltage 10 bit mask
+#define UCD9081_CFG_EXT_VREF     0x20					///< external reference bit in the high byte of the configuration word
 
 
 /**
@@ -148,6 +152,8 @@ typedef struct
     uint8_t flash_lock_sts:1;           /*!< flash lock status		 		*/
     ucd9081_read_fptr_t read;           /*!< Read API function pointer      */
     ucd9081_write_fptr_t write;         /*!< Write API function pointer     */
+    float rail_div[UCD9081_RAIL_CNT];   /*!< rail divider ratio, 1 when the rail has no external divider */
+    float rail_scale[UCD9081_RAIL_CNT]; /*!< volts per ADC count of each rail, from rail_div and the reference */
 }s_ucd9081;
 
 /**
@@ -177,6 +183,15 @@ typedef struct
 
 }s_ucd9081_rail_cfg;
 
+/**
+ * @brief  UCD9081 all rails snapshot structure definition
+ */
+typedef struct
+{
+    uint16_t raw[UCD9081_RAIL_CNT];			/*!< ucd9081 rail ADC counts		*/
+    float voltage[UCD9081_RAIL_CNT];			/*!< ucd9081 rail voltages		*/
+}s_ucd9081_rail_snapshot;
+
 /**
  * @brief  UCD9081 rail error status enumeration
  */
@@ -334,6 +349,15 @@ e_ucd9081_err ucd9081_get_err_sts(s_ucd9081* ucd9081_hdl);
  */
 e_ucd9081_err ucd9081_get_voltage(s_ucd9081* ucd9081_hdl, s_ucd9081_rail_cfg* rail, float* voltage);
 
+/**
+ * @brief get the voltage of all rails, the rail registers are read in one
+ * auto incremented burst and converted with the per rail scale factors
+ * @param[in]  ucd9081_hdl - instance pointer of UCD9081
+ * @param[out]  snapshot - ADC counts and voltages of the rails
+ * @retval e_UCD9081_err - returns the success or error code
+ */
+e_ucd9081_err ucd9081_get_all_voltages(s_ucd9081* ucd9081_hdl, s_ucd9081_rail_snapshot* snapshot);
+
 /**
  * @brief This function configure the rail specified in the parameter
  * @param[in]  ucd9081_hdl - instance pointer of UCD9081
@@ -136,6 +136,28 @@ static e_ucd9081_err ucd9081_flash_unlock(s_ucd9081* ucd9081_hdl)
     return ret;
 }
 
+/*!
+ * @brief This API computes the scale factor of a rail from its divider and the reference
+ */
+static void ucd9081_update_scale(s_ucd9081* ucd9081_hdl, uint8_t rail_no)
+{
+    float vref = (ucd9081_hdl->v_ref_typ==UCD9081_VREF_INT) ? UCD9081_VREF_INTNL : UCD9081_VREF_EXTNL;
+    ucd9081_hdl->rail_scale[rail_no] = (vref * ucd9081_hdl->rail_div[rail_no]) / UCD9081_ADC_FS;
+}
+
+/*!
+ * @brief This API returns the divider ratio of a rail
+ */
+static float ucd9081_rail_div(const s_ucd9081_rail_cfg* rail)
+{
+    float div = 1.0f;
+    if((rail->ext_vd_en!=0) && (rail->r_pull_down>0.0f))
+    {
+        div = (rail->r_pull_up + rail->r_pull_down) / rail->r_pull_down;
+    }
+    return div;
+}
+
 /*!
  * @brief UCD9081 initialization is set in this function
  */
@@ -152,6 +174,13 @@ e_ucd9081_err ucd9081_init(s_ucd9081* ucd9081_hdl)
             {
                 if(data[0]==0xF2)
                 {
+                    uint8_t rail_no;
+                    ucd9081_hdl->v_ref_typ=((data[1] & UCD9081_CFG_EXT_VREF)!=0) ? UCD9081_VREF_EXT : UCD9081_VREF_INT;
+                    for(rail_no=0; rail_no<UCD9081_RAIL_CNT; rail_no++)
+                    {
+                        ucd9081_hdl->rail_div[rail_no]=1.0f;
+                        ucd9081_update_scale(ucd9081_hdl, rail_no);
+                    }
                     ret=UCD9081_SCS;
                     ret= ucd9081_restart(ucd9081_hdl);
                 }
@@ -192,6 +221,11 @@ e_ucd9081_err ucd9081_rail_config(s_ucd9081* ucd9081_hdl,s_ucd9081_rail_cfg* rai
         ret = ucd9081_set_seq_type(ucd9081_hdl, rail, rail->seq_type);
         ret = ucd9081_set_seq_prnt_rail(ucd9081_hdl, rail, rail->prnt_rail);
         ret = ucd9081_set_rail_alrm_typ(ucd9081_hdl, rail, rail->alrm_typ);
+        if(rail->rail_nu < UCD9081_RAIL_CNT)
+        {
+            ucd9081_hdl->rail_div[rail->rail_nu] = ucd9081_rail_div(rail);
+            ucd9081_update_scale(ucd9081_hdl, rail->rail_nu);
+        }
     }
     else
     {
@@ -511,7 +545,12 @@ e_ucd9081_err ucd9081_vref_cfg(s_ucd9081* ucd9081_hdl,uint8_t v_ref)
                 ret=ucd9081_config_data_write(ucd9081_hdl, addr, data, 2);
                 if(ret==UCD9081_SCS)
                 {
+                    uint8_t rail_no;
                     ucd9081_hdl->v_ref_typ=v_ref;
+                    for(rail_no=0; rail_no<UCD9081_RAIL_CNT; rail_no++)
+                    {
+                        ucd9081_update_scale(ucd9081_hdl, rail_no);
+                    }
                 }
                 ucd9081_flash_lock(ucd9081_hdl);
             }
@@ -619,17 +658,18 @@ e_ucd9081_err ucd9081_get_fw_version(s_ucd9081* ucd9081_hdl,uint8_t *version)
 /*!
  * @brief This API is used to read the voltage of ucd9081
  */
-static float ucd9081_read_voltage(s_ucd9081* ucd9081_hdl,uint8_t addr_h, uint8_t addr_l,s_ucd9081_rail_cfg* rail, float vref)
+static e_ucd9081_err ucd9081_read_voltage(s_ucd9081* ucd9081_hdl, e_ucd9081_rail_no rail_no, float scale, float* voltage)
 {
-    uint8_t rail_vn_l;
-    uint8_t rail_vn_h;
-    float voltage;
+    e_ucd9081_err ret;
+    uint8_t rail_vn[2];
     uint16_t v_raw;
-    ucd9081_hdl->read(ucd9081_hdl->intf_hdl, ucd9081_hdl->slv_addr,addr_h,&rail_vn_l,1);
-    ucd9081_hdl->read(ucd9081_hdl->intf_hdl, ucd9081_hdl->slv_addr,addr_l,&rail_vn_h,1);
-    v_raw=rail_vn_l|(rail_vn_h<<8);
-    voltage=(rail->ext_vd_en==0)?(v_raw/1024)*vref:(v_raw/1024)*vref + ((rail->r_pull_down+rail->r_pull_up)/rail->r_pull_down);
-    return voltage;
+    ret = ucd9081_hdl->read(ucd9081_hdl->intf_hdl, ucd9081_hdl->slv_addr, UCD9081_RAIL1H + (2 * rail_no), rail_vn, 2);
+    if(ret==UCD9081_SCS)
+    {
+        v_raw=((rail_vn[0]<<8) | rail_vn[1]) & UCD9081_RAIL_MASK;
+        *voltage=v_raw*scale;
+    }
+    return ret;
 }
 
 /*!
@@ -649,35 +689,45 @@ e_ucd9081_err ucd9081_get_voltage(s_ucd9081* ucd9081_hdl, s_ucd9081_rail_cfg* ra
         {
             vref=UCD9081_VREF_EXTNL;
         }
-        switch(rail->rail_nu)
-        {
-            case UCD9081_RAIL1:
-                *voltage = ucd9081_read_voltage(ucd9081_hdl, UCD9081_RAIL1H, UCD9081_RAIL1L, rail, vref);
-                break;
-            case UCD9081_RAIL2:
-                *voltage = ucd9081_read_voltage(ucd9081_hdl, UCD9081_RAIL2H, UCD9081_RAIL2L, rail, vref);
-                break;
-            case UCD9081_RAIL3:
-                *voltage = ucd9081_read_voltage(ucd9081_hdl, UCD9081_RAIL3H, UCD9081_RAIL3L, rail, vref);
-                break;
-            case UCD9081_RAIL4:
-                *voltage = ucd9081_read_voltage(ucd9081_hdl, UCD9081_RAIL4H, UCD9081_RAIL4L, rail, vref);
-                break;
-            case UCD9081_RAIL5:
-                *voltage = ucd9081_read_voltage(ucd9081_hdl, UCD9081_RAIL5H, UCD9081_RAIL5L, rail, vref);
-                break;
-            case UCD9081_RAIL6:
-                *voltage = ucd9081_read_voltage(ucd9081_hdl, UCD9081_RAIL6H, UCD9081_RAIL6L, rail, vref);
-                break;
-            case UCD9081_RAIL7:
-                *voltage = ucd9081_read_voltage(ucd9081_hdl, UCD9081_RAIL7H, UCD9081_RAIL7L, rail, vref);
-                break;
-            case UCD9081_RAIL8:
-                *voltage = ucd9081_read_voltage(ucd9081_hdl, UCD9081_RAIL8H, UCD9081_RAIL8L, rail, vref);
-                break;
-            default:
-                ret=UCD9081_INVLD_ARG;
-                break;
+        if(rail->rail_nu < UCD9081_RAIL_CNT)
+        {
+            ret = ucd9081_read_voltage(ucd9081_hdl, rail->rail_nu, (vref * ucd9081_rail_div(rail)) / UCD9081_ADC_FS, voltage);
+        }
+        else
+        {
+            ret=UCD9081_INVLD_ARG;
+        }
+    }
+    else
+    {
+        ret =UCD9081_NULL_PTR;
+    }
+    return ret;
+}
+
+/*!
+ * @brief get the voltage of all rails
+ */
+e_ucd9081_err ucd9081_get_all_voltages(s_ucd9081* ucd9081_hdl, s_ucd9081_rail_snapshot* snapshot)
+{
+    e_ucd9081_err ret =UCD9081_ERR;
+    if(ucd9081_null_ptr_check(ucd9081_hdl)==UCD9081_SCS && snapshot !=NULL)
+    {
+        uint8_t rail_vn[2 * UCD9081_RAIL_CNT];
+        uint8_t rail_no;
+        /* RAIL1H..RAIL8L are contiguous, one burst captures every rail at the same instant */
+        ret = ucd9081_hdl->read(ucd9081_hdl->intf_hdl, ucd9081_hdl->slv_addr, UCD9081_RAIL1H, rail_vn, sizeof(rail_vn));
+        if(ret==UCD9081_SCS)
+        {
+            for(rail_no=0; rail_no<UCD9081_RAIL_CNT; rail_no++)
+            {
+                snapshot->raw[rail_no]=((rail_vn[2 * rail_no]<<8) | rail_vn[(2 * rail_no) + 1]) & UCD9081_RAIL_MASK;
+                snapshot->voltage[rail_no]=snapshot->raw[rail_no] * ucd9081_hdl->rail_scale[rail_no];
+            }
+        }
+        else
+        {
+            ret=UCD9081_COM_ERR;
         }
     }
     else
@@ -19,6 +19,9 @@
  */
 
 #include "exo_hal_io_al_common.h"
+#ifdef LINUX_AHW_SIM
+#include "exo_io_al_linux_i2c_sim.h"
+#endif
 
 ahw_io_map imu_bmx160_obc_1; ///< IMU BMX160 for OBC 1
 ahw_io_map imu_bmx160_obc_2;  ///< IMU BMX160 for OBC 2
@@ -57,6 +60,54 @@ ahw_io_map uart_expander_max14830_obc;
 ahw_io_map *ahw_io_lookup_tble[MAX_AH_INST_ID];
 void *intf_inst_hdle_ptr[MAX_IO_INST_ID];
 
+#ifdef LINUX_AHW_SIM
+/**
+ * @brief Attach the I2C AHW instances of the lookup table to the simulated
+ *        bus, each one with the register map model of its part
+ */
+static void ahw_io_sim_attach(void)
+{
+    static const struct
+    {
+        ahw_inst_id_t ahw_id;
+        lnx_i2c_sim_model model;
+    } sim_map[] =
+    {
+        { IMU_BMX160_OBC_1, LNX_I2C_SIM_BMX160 },
+        { IMU_BMX160_OBC_2, LNX_I2C_SIM_BMX160 },
+        { TEMP_SENSOR_MCP9843_OBC, LNX_I2C_SIM_MCP9843 },
+        { TEMP_SENSOR_MCP9843_PS, LNX_I2C_SIM_MCP9843 },
+        { TEMP_SENSOR_MCP9843_EDGE, LNX_I2C_SIM_MCP9843 },
+        { TEMP_SENSOR_MCP9843_GPS, LNX_I2C_SIM_MCP9843 },
+        { PSM_INA230_OBC, LNX_I2C_SIM_INA230 },
+        { PSM_INA230_PS, LNX_I2C_SIM_INA230 },
+        { GPIO_EXPANDER_PCAL6408A_PS, LNX_I2C_SIM_PCAL6408A },
+        { GPIO_EXPANDER_MCP23008_EDGE_1, LNX_I2C_SIM_MCP23008 },
+        { GPIO_EXPANDER_MCP23008_EDGE_2, LNX_I2C_SIM_MCP23008 },
+        { GPIO_EXPANDER_MCP23008_GPS, LNX_I2C_SIM_MCP23008 },
+        { DIGITAL_THERMOSTAT_DS620_PS, LNX_I2C_SIM_DS620 },
+        { DIGITAL_THERMOSTAT_DS620_EDGE, LNX_I2C_SIM_DS620 },
+        { DIGITAL_THERMOSTAT_DS620_SPE01, LNX_I2C_SIM_DS620 },
+        { DIGITAL_THERMOSTAT_DS620_SPE02, LNX_I2C_SIM_DS620 },
+        { DIGITAL_THERMOSTAT_DS620_SPW01, LNX_I2C_SIM_DS620 },
+        { DIGITAL_THERMOSTAT_DS620_SPW02, LNX_I2C_SIM_DS620 },
+        { DIGITAL_THERMOSTAT_DS620_SPB01, LNX_I2C_SIM_DS620 },
+        { HSC_ADM1176_EDGE, LNX_I2C_SIM_ADM1176 },
+        { HSC_ADM1176_PS_1, LNX_I2C_SIM_ADM1176 },
+        { HSC_ADM1176_PS_2, LNX_I2C_SIM_ADM1176 },
+        { VOLTAGE_SEQUENCER_UCD9801_OBC, LNX_I2C_SIM_UCD9081 },
+        { DATA_LOGGER_ADS7828_PS, LNX_I2C_SIM_ADS7828 },
+    };
+
+    for (uint32 i = 0; i < sizeof(sim_map) / sizeof(sim_map[0]); i++)
+    {
+        ahw_io_map *map = ahw_io_lookup_tble[sim_map[i].ahw_id];
+        // Already attached when the table is updated again
+        io_hal_linux_i2c_sim_attach(map->io_instance_id, sim_map[i].model, map->slv_addr);
+    }
+}
+#endif
+
 /**
  * @brief This API is AHW IO lookup table
  */
@@ -243,4 +294,7 @@ void ahw_io_lookup_table_updt(void)
     uart_expander_max14830_obc.io_instance_id = IOAL_INST_SPI2;
     //uart_expander_max14830_obc.slv_addr = 0x00;
 
+#ifdef LINUX_AHW_SIM
+    ahw_io_sim_attach();
+#endif
 }
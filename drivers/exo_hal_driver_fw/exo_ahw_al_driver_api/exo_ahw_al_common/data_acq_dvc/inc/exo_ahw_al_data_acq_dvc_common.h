@@ -27,12 +27,23 @@
 #include "exo_hal_common.h"
 #include "exo_ahw_al_common.h"
 
+/**
+ * @brief Number of single ended channels covered by a scan
+ */
+#define AL_ADS7828_SCAN_CHNL_MAX            8
+
+/**
+ * @brief AHW ADS7828 time stamp function pointer
+ */
+typedef uint32_t (*ahw_al_ads7828_tick_fptr)(void);
+
 /**
  * @brief AHW ADS7828 control block structure definition
  */
 typedef struct
 {
     ahw_al_gen_info ahw_gen_info;       /*!< AHW general information */
+    ahw_al_ads7828_tick_fptr get_tick;  /*!< time stamp source of the scan samples, NULL for none */
 
 }ahw_al_ads7828_hdle;
 
@@ -74,6 +85,24 @@ typedef enum
 
 }ahw_al_ads7828_pd_sel;
 
+/**
+ * @brief AHW ADS7828 scan sample structure definition
+ */
+typedef struct
+{
+    ahw_al_ads7828_chnl chnl;           /*!< converted channel */
+    uint16_t data;                      /*!< 12 bit conversion result */
+    uint32_t tick;                      /*!< get_tick() value when the transaction of the sample ended, 0 without get_tick */
+}ahw_al_ads7828_sample;
+
+/**
+ * @brief API to initialize the ads7828 instance
+ * @param[in]  h_dl - instance pointer of ads7828
+ * @param[in]  ahw_id - AHW instance ID
+ * @retval hal_ret_sts - returns the success or error code
+ */
+hal_ret_sts ahw_al_ads7828_init(ahw_al_ads7828_hdle *h_dl, ahw_inst_id_t ahw_id);
+
 /**
  * @brief API to get the data from the specified channel number
  * @param[in]  h_dl - instance pointer of ads7828
@@ -84,4 +113,16 @@ typedef enum
  */
 hal_ret_sts ahw_al_ads7828_get_data(ahw_al_ads7828_hdle *h_dl,ahw_al_ads7828_chnl chnl,ahw_al_ads7828_pd_sel pd_opt,uint16_t* data);
 
+/**
+ * @brief API to scan the single ended channels, the conversions are batched in
+ * bus transactions and the internal reference stays powered between them
+ * @param[in]  h_dl - instance pointer of ads7828
+ * @param[in]  chnl_mask - bit n selects single ended channel n
+ * @param[in]  pd_opt -  power down option after the scan
+ * @param[out]  samples - array of AL_ADS7828_SCAN_CHNL_MAX samples, filled in channel order
+ * @param[out]  count - number of samples
+ * @retval hal_ret_sts - returns the success or error code
+ */
+hal_ret_sts ahw_al_ads7828_scan(ahw_al_ads7828_hdle *h_dl,uint8_t chnl_mask,ahw_al_ads7828_pd_sel pd_opt,ahw_al_ads7828_sample* samples,uint8_t* count);
+
 #endif /* DRIVERS_EXO_HAL_DRIVER_FW_EXO_AHW_AL_DRIVER_API_EXO_AHW_AL_COMMON_DL_ADS7828_INC_EXO_AHW_AL_DL_ADS7828_COMMON_H_ */
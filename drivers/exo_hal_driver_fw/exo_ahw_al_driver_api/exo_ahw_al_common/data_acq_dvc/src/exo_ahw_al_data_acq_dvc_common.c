@@ -24,7 +24,40 @@
 #include "exo_ah_iob_csn.h"
 #include "exo_ahdlsd.h"
 
-#ifndef LINUX_TEMP_PORT
+extern void* ahw_inst_hdle_ptr[MAX_AH_INST_ID];
+
+#if !defined(LINUX_TEMP_PORT) || defined(LINUX_AHW_SIM)
+/*!
+ *  @brief API to initialize the ads7828 instance
+ */
+hal_ret_sts ahw_al_ads7828_init(ahw_al_ads7828_hdle *h_dl, ahw_inst_id_t ahw_id)
+{
+    hal_ret_sts sts;
+    h_dl->ahw_gen_info.ahw_inst_id = ahw_id;
+    if(HAL_SCS == ahw_al_common_ads7828_init(h_dl))
+    {
+        ahw_inst_hdle_ptr[ahw_id] = h_dl;
+        sts = HAL_SCS;
+        if(HAL_SCS != ahdlsd_updt_ah_state(ahw_id, AH_ACTIVATED))
+        {
+            sts = HAL_AHDLSD_FW_ERR;
+        }
+        if(HAL_SCS != ahiobcsn_updt_ahste(&h_dl->ahw_gen_info, AH_FREE_STATE))
+        {
+            sts = HAL_AHIOBCSN_FW_ERR;
+        }
+    }
+    else
+    {
+        sts = HAL_AH_INIT_ERR;
+        if(HAL_SCS != ahdlsd_updt_ah_state(ahw_id, AH_ERROR))
+        {
+            sts = HAL_AHDLSD_FW_ERR;
+        }
+    }
+    return sts;
+}
+
 /*!
  *  @brief API to get the data from the specified channel number
  */
@@ -51,4 +84,24 @@ hal_ret_sts ahw_al_ads7828_get_data(ahw_al_ads7828_hdle *h_dl,ahw_al_ads7828_chn
     }
     return sts;
 }
+
+/*!
+ *  @brief API to scan the single ended channels
+ */
+hal_ret_sts ahw_al_ads7828_scan(ahw_al_ads7828_hdle *h_dl,uint8_t chnl_mask,ahw_al_ads7828_pd_sel pd_opt,ahw_al_ads7828_sample* samples,uint8_t* count)
+{
+    hal_ret_sts sts;
+    sts = ahiobcsn_check_ste(&h_dl->ahw_gen_info);
+    if(HAL_SCS == sts)
+    {
+        ahiobcsn_updt_ahste(&h_dl->ahw_gen_info, AH_BUSY_STATE);
+        sts = ahw_al_common_ads7828_scan(h_dl,chnl_mask,pd_opt,samples,count);
+        ahiobcsn_updt_ahste(&h_dl->ahw_gen_info, AH_FREE_STATE);
+    }
+    else
+    {
+
+    }
+    return sts;
+}
 #endif
@@ -62,6 +62,11 @@ typedef enum
 
 }digital_thermos_mode;
 
+/**
+ * @brief Digital thermostat time stamp function pointer, returns the time in mS
+ */
+typedef uint32_t (*ahw_al_dt_tick_fptr)(void);
+
 /**
  * @brief Digital thermostat control block memory structure definition
  */
@@ -74,6 +79,7 @@ typedef struct _ahw_al_dt_hdle
     uint8_t resolution;                 /*!< ADC resolution                       */
     uint8_t thermostat_mode;            /*!< DS620 operating mode                 */
     uint8_t thermostat_event_sts;       /*!< DS620 event status                   */
+    ahw_al_dt_tick_fptr get_tick;       /*!< mS time source of the alert mode heartbeat, NULL reads on alert only */
 
 }ahw_al_dt_hdle;
 
@@ -227,6 +233,45 @@ hal_ret_sts ahw_al_dt_get_temperature_high_thrshd(ahw_al_dt_hdle *hdt,double *hi
  * @retval hal_ret_sts - returns the success or error code
  */
 hal_ret_sts ahw_al_dt_reset_alert_flag(ahw_al_dt_hdle *hdt);
+/**
+ * @brief This API get the temperature in milli degree celsius, the conversion
+ * is done in integer arithmetic
+ * @param[in]  hdt - instance pointer of DS620
+ * @param[out] temp_mdeg - temperature in milli degree celsius
+ * @retval hal_ret_sts - returns the success or error code
+ */
+hal_ret_sts ahw_al_dt_get_temperature_mdeg(ahw_al_dt_hdle *hdt, int32_t *temp_mdeg);
 
+/**
+ * @brief This API configures the alert driven sampling. The thresholds are
+ * programmed once and continuous conversion is started. The application calls
+ * ahw_al_dt_alert_notify() from the PO pin interrupt, ahw_al_dt_alert_poll()
+ * then reads the part after an alert or when the heartbeat expires.
+ * @param[in]  hdt - instance pointer of DS620
+ * @param[in]  low_mdeg - low temperature threshold in milli degree celsius
+ * @param[in]  high_mdeg - high temperature threshold in milli degree celsius
+ * @param[in]  hb_ms - heartbeat period in mS, it needs get_tick, 0 reads on alert only
+ * @retval hal_ret_sts - returns the success or error code
+ */
+hal_ret_sts ahw_al_dt_alert_cfg(ahw_al_dt_hdle *hdt, int32_t low_mdeg, int32_t high_mdeg, uint32_t hb_ms);
+
+/**
+ * @brief This API reports a PO pin alert. It does not access the bus nor the
+ * instance state, so it can be called from interrupt context.
+ * @param[in]  hdt - instance pointer of DS620
+ * @retval hal_ret_sts - returns the success or error code
+ */
+hal_ret_sts ahw_al_dt_alert_notify(ahw_al_dt_hdle *hdt);
+
+/**
+ * @brief This API gets the temperature in alert mode, the last temperature is
+ * returned without bus access unless an alert is pending or the heartbeat expired
+ * @param[in]  hdt - instance pointer of DS620
+ * @param[out] temp_mdeg - temperature in milli degree celsius
+ * @param[out] alert_sts - THF (bit 1) and TLF (bit 0) flags read by this poll,
+ *             also kept in thermostat_event_sts
+ * @retval hal_ret_sts - returns the success or error code
+ */
+hal_ret_sts ahw_al_dt_alert_poll(ahw_al_dt_hdle *hdt, int32_t *temp_mdeg, uint8_t *alert_sts);
 
 #endif
@@ -64,7 +64,7 @@ hal_ret_sts ahw_al_dt_init(ahw_al_dt_hdle* hdt_arg, ahw_inst_id_t ahw_id)
     return sts;
 }
 
-#ifndef LINUX_TEMP_PORT
+#if !defined(LINUX_TEMP_PORT) || defined(LINUX_AHW_SIM)
 /*!
  *  @brief This API release the control block memory of ds620 instance
  */
@@ -557,5 +557,97 @@ hal_ret_sts ahw_al_dt_reset_alert_flag(ahw_al_dt_hdle *hdt)
     return sts;
 }
 
+/**
+ * @brief This API get the temperature in milli degree celsius
+ */
+hal_ret_sts ahw_al_dt_get_temperature_mdeg(ahw_al_dt_hdle *hdt, int32_t *temp_mdeg)
+{
+    hal_ret_sts sts;
+    sts = ahiobcsn_check_ste(&hdt->ahw_gen_info);
+    if(HAL_SCS == sts)
+    {
+        ahiobcsn_updt_ahste(&hdt->ahw_gen_info, AH_BUSY_STATE);
+        if(HAL_SCS == ahw_al_dt_common_get_temperature_mdeg(hdt,temp_mdeg))
+        {
+            ahiobcsn_updt_ahste(&hdt->ahw_gen_info, AH_FREE_STATE);
+            sts = HAL_SCS;
+        }
+        else
+        {
+            ahiobcsn_updt_ahste(&hdt->ahw_gen_info, AH_FREE_STATE);
+            sts = HAL_AH_DRIVER_ERR;
+        }
+    }
+    else
+    {
+
+    }
+    return sts;
+}
+
+/**
+ * @brief This API configures the alert driven sampling
+ */
+hal_ret_sts ahw_al_dt_alert_cfg(ahw_al_dt_hdle *hdt, int32_t low_mdeg, int32_t high_mdeg, uint32_t hb_ms)
+{
+    hal_ret_sts sts;
+    sts = ahiobcsn_check_ste(&hdt->ahw_gen_info);
+    if(HAL_SCS == sts)
+    {
+        ahiobcsn_updt_ahste(&hdt->ahw_gen_info, AH_BUSY_STATE);
+        if(HAL_SCS == ahw_al_dt_common_alert_cfg(hdt,low_mdeg,high_mdeg,(NULL != hdt->get_tick) ? hb_ms : 0))
+        {
+            ahiobcsn_updt_ahste(&hdt->ahw_gen_info, AH_FREE_STATE);
+            sts = HAL_SCS;
+        }
+        else
+        {
+            ahiobcsn_updt_ahste(&hdt->ahw_gen_info, AH_FREE_STATE);
+            sts = HAL_AH_DRIVER_ERR;
+        }
+    }
+    else
+    {
+
+    }
+    return sts;
+}
+
+/**
+ * @brief This API reports a PO pin alert
+ */
+hal_ret_sts ahw_al_dt_alert_notify(ahw_al_dt_hdle *hdt)
+{
+    return ahw_al_dt_common_alert_notify(hdt);
+}
+
+/**
+ * @brief This API gets the temperature in alert mode
+ */
+hal_ret_sts ahw_al_dt_alert_poll(ahw_al_dt_hdle *hdt, int32_t *temp_mdeg, uint8_t *alert_sts)
+{
+    hal_ret_sts sts;
+    uint32_t now_ms = (NULL != hdt->get_tick) ? hdt->get_tick() : 0;
+    sts = ahiobcsn_check_ste(&hdt->ahw_gen_info);
+    if(HAL_SCS == sts)
+    {
+        ahiobcsn_updt_ahste(&hdt->ahw_gen_info, AH_BUSY_STATE);
+        if(HAL_SCS == ahw_al_dt_common_alert_poll(hdt,now_ms,temp_mdeg,alert_sts))
+        {
+            ahiobcsn_updt_ahste(&hdt->ahw_gen_info, AH_FREE_STATE);
+            sts = HAL_SCS;
+        }
+        else
+        {
+            ahiobcsn_updt_ahste(&hdt->ahw_gen_info, AH_FREE_STATE);
+            sts = HAL_AH_DRIVER_ERR;
+        }
+    }
+    else
+    {
+
+    }
+    return sts;
+}
 
 #endif
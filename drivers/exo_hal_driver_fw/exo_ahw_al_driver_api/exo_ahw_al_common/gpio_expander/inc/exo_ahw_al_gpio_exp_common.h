@@ -317,4 +317,26 @@ hal_ret_sts ahw_al_gpio_exp_read_intr_sts(uint32_t ahw_id, gpio_exp_gpio_pin pin
 hal_ret_sts ahw_al_gpio_exp_set_port_cfg(uint32_t ahw_id, gpio_exp_gpio_pin pin, gpio_exp_port_cfg flag);
 
 hal_ret_sts ahw_al_gpio_exp_isr_hdlr(uint32_t ahw_id);
+
+/**
+ * @brief This API updates the output state of several pins in one write, the
+ * new output is ((output | set_msk) & ~clr_msk) ^ tgl_msk. All the pins change
+ * at the same time.
+ * @param[in] ahw_id  : application hardware instance ID
+ * @param[in] set_msk : pins to be driven high, gpio_exp_gpio_pin values OR'ed
+ * @param[in] clr_msk : pins to be driven low
+ * @param[in] tgl_msk : pins to be toggled
+ * @return Result of API execution status
+ * @retval zero -> Success / -ve value -> Error.
+ */
+hal_ret_sts ahw_al_gpio_exp_port_update(uint32_t ahw_id, uint8_t set_msk, uint8_t clr_msk, uint8_t tgl_msk);
+
+/**
+ * @brief This API is used to read the state of all the pins
+ * @param[in] ahw_id    : application hardware instance ID
+ * @param[out] port_ste : state of the pins, bit n is gpio pin n
+ * @return Result of API execution status
+ * @retval zero -> Success / -ve value -> Error.
+ */
+hal_ret_sts ahw_al_gpio_exp_readport(uint32_t ahw_id, uint8_t *port_ste);
 #endif /* EXO_HAL_DRIVER_FW_EXO_AHW_AL_DRIVER_API_EXO_AHW_AL_COMMON_GPIO_EXPANDER_INC_EXO_AHW_AL_GPIO_EXP_COMMON_H_ */
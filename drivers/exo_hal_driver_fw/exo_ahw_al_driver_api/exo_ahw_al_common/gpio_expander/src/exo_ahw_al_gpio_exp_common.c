@@ -377,3 +377,60 @@ hal_ret_sts ahw_al_gpio_exp_isr_hdlr(uint32_t ahw_id)
     return sts;
 }
 
+/**
+ * @brief This API updates the output state of several pins in one write
+ */
+hal_ret_sts ahw_al_gpio_exp_port_update(uint32_t ahw_id, uint8_t set_msk, uint8_t clr_msk, uint8_t tgl_msk)
+{
+    hal_ret_sts sts;
+    ahw_al_gpio_exp_hdle *hgpio_exp = ahal_get_hdle(ahw_id);
+    sts = ahiobcsn_check_ste(&hgpio_exp->ahw_gen_info);
+    if(HAL_SCS == sts)
+    {
+        ahiobcsn_updt_ahste(&hgpio_exp->ahw_gen_info, AH_BUSY_STATE);
+        if(HAL_SCS == ahw_al_gpio_exp_common_port_update(hgpio_exp,set_msk,clr_msk,tgl_msk))
+        {
+            ahiobcsn_updt_ahste(&hgpio_exp->ahw_gen_info, AH_FREE_STATE);
+            sts = HAL_SCS;
+        }
+        else
+        {
+            ahiobcsn_updt_ahste(&hgpio_exp->ahw_gen_info, AH_FREE_STATE);
+            sts = HAL_AH_DRIVER_ERR;
+        }
+    }
+    else
+    {
+
+    }
+    return sts;
+}
+
+/**
+ * @brief This API is used to read the state of all the pins
+ */
+hal_ret_sts ahw_al_gpio_exp_readport(uint32_t ahw_id, uint8_t *port_ste)
+{
+    hal_ret_sts sts;
+    ahw_al_gpio_exp_hdle *hgpio_exp = ahal_get_hdle(ahw_id);
+    sts = ahiobcsn_check_ste(&hgpio_exp->ahw_gen_info);
+    if(HAL_SCS == sts)
+    {
+        ahiobcsn_updt_ahste(&hgpio_exp->ahw_gen_info, AH_BUSY_STATE);
+        if(HAL_SCS == ahw_al_gpio_exp_common_readport(hgpio_exp,port_ste))
+        {
+            ahiobcsn_updt_ahste(&hgpio_exp->ahw_gen_info, AH_FREE_STATE);
+            sts = HAL_SCS;
+        }
+        else
+        {
+            ahiobcsn_updt_ahste(&hgpio_exp->ahw_gen_info, AH_FREE_STATE);
+            sts = HAL_AH_DRIVER_ERR;
+        }
+    }
+    else
+    {
+
+    }
+    return sts;
+}
@@ -63,7 +63,7 @@ hal_ret_sts ahw_al_hsc_init(ahw_al_hsc_hdl* hsc_arg, ahw_inst_id_t ahw_id)
     return sts;
 }
 
-#ifndef LINUX_TEMP_PORT
+#if !defined(LINUX_TEMP_PORT) || defined(LINUX_AHW_SIM)
 /*!
  *  @brief This API deinitializes the control block memory
  */
@@ -235,6 +235,37 @@ typedef struct _imu_int_settg
 
 }imu_int_settg;
 
+/**
+ * @brief Maximum number of samples per sensor in a FIFO batch, enough for a full
+ * 1024 byte FIFO holding header mode accelerometer only frames
+ */
+#ifndef IMU_FIFO_FRAMES_MAX
+#define IMU_FIFO_FRAMES_MAX         146
+#endif
+
+/*!
+ * @brief IMU sensor FIFO streaming configuration structure
+ */
+typedef struct _imu_fifo_stream_cfg
+{
+    imu_select_sensor sensor;               /*!< IMU_ACCEL_ONLY, IMU_GYRO_ONLY or IMU_BOTH_ACCEL_AND_GYRO       */
+    uint8 watermark;                        /*!< number of frames in the FIFO that raise the watermark interrupt */
+}imu_fifo_stream_cfg;
+
+/*!
+ * @brief IMU sensor FIFO batch structure, samples are oldest first and their
+ * sensortime is derived from the sensor time read with the batch, 0 if none was read
+ */
+typedef struct _imu_fifo_batch
+{
+    imu_sensor_data accel[IMU_FIFO_FRAMES_MAX];     /*!< accelerometer samples                      */
+    imu_sensor_data gyro[IMU_FIFO_FRAMES_MAX];      /*!< gyroscope samples                          */
+    uint8 accel_len;                                /*!< number of accelerometer samples            */
+    uint8 gyro_len;                                 /*!< number of gyroscope samples                */
+    uint8 skipped_frames;                           /*!< frames dropped by a FIFO overflow          */
+    uint32 sensortime;                              /*!< sensor time of the newest frame            */
+}imu_fifo_batch;
+
 /*!
  * @brief IMU sensor control block structure
  */
@@ -354,4 +385,28 @@ hal_ret_sts ahw_al_imu_freefall_detect_ste_cfg(imu_int_type_cfg *int_config, ahw
  */
 hal_ret_sts ahw_al_imu_shock_detect_ste_cfg(imu_int_type_cfg *int_config, ahw_al_imu_hdle *himu);
 
+/**
+ * @brief This API starts FIFO streaming, the FIFO is flushed and the watermark
+ * interrupt is routed to the interrupt pin
+ * @param[in] himu - AHAL instance pointer of IMU sensor.
+ * @param[in] stream_cfg - pointer to a imu_fifo_stream_cfg structure
+ * @retval hal_ret_sts - returns the success or error code
+ */
+hal_ret_sts ahw_al_imu_fifo_stream_start(imu_fifo_stream_cfg *stream_cfg, ahw_al_imu_hdle *himu);
+
+/**
+ * @brief This API reads the FIFO in one burst, to be called on the watermark interrupt
+ * @param[in] himu - AHAL instance pointer of IMU sensor.
+ * @param[out] batch - pointer to a imu_fifo_batch structure
+ * @retval hal_ret_sts - returns the success or error code
+ */
+hal_ret_sts ahw_al_imu_fifo_stream_read(imu_fifo_batch *batch, ahw_al_imu_hdle *himu);
+
+/**
+ * @brief This API stops FIFO streaming and disables the watermark interrupt
+ * @param[in] himu - AHAL instance pointer of IMU sensor.
+ * @retval hal_ret_sts - returns the success or error code
+ */
+hal_ret_sts ahw_al_imu_fifo_stream_stop(ahw_al_imu_hdle *himu);
+
 #endif /* _AHW_AL_IMU_COMMON_H_ */
@@ -88,7 +88,7 @@ hal_ret_sts ahw_al_imu_init(void)
     return sts;
 }
 
-#ifndef LINUX_TEMP_PORT
+#if !defined(LINUX_TEMP_PORT) || defined(LINUX_AHW_SIM)
 /**
  * @brief This API reset and restart the device.
  */
@@ -434,5 +434,61 @@ hal_ret_sts ahw_al_imu_shock_detect_ste_cfg(imu_int_type_cfg *int_config, ahw_al
     return sts;
 }
 
+/**
+ * @brief This API starts the FIFO streaming
+ */
+hal_ret_sts ahw_al_imu_fifo_stream_start(imu_fifo_stream_cfg *stream_cfg, ahw_al_imu_hdle *himu)
+{
+    hal_ret_sts sts;
+    sts = ahiobcsn_check_ste(&himu->ahw_gen_info);
+    if(HAL_SCS == sts)
+    {
+        ahiobcsn_updt_ahste(&himu->ahw_gen_info, AH_BUSY_STATE);
+        sts = ahw_al_imu_common_fifo_stream_start(stream_cfg, himu);
+        ahiobcsn_updt_ahste(&himu->ahw_gen_info, AH_FREE_STATE);
+    }
+    else
+    {
+    }
+    return sts;
+}
+
+/**
+ * @brief This API reads a batch of samples from the FIFO
+ */
+hal_ret_sts ahw_al_imu_fifo_stream_read(imu_fifo_batch *batch, ahw_al_imu_hdle *himu)
+{
+    hal_ret_sts sts;
+    sts = ahiobcsn_check_ste(&himu->ahw_gen_info);
+    if(HAL_SCS == sts)
+    {
+        ahiobcsn_updt_ahste(&himu->ahw_gen_info, AH_BUSY_STATE);
+        sts = ahw_al_imu_common_fifo_stream_read(batch, himu);
+        ahiobcsn_updt_ahste(&himu->ahw_gen_info, AH_FREE_STATE);
+    }
+    else
+    {
+    }
+    return sts;
+}
+
+/**
+ * @brief This API stops the FIFO streaming
+ */
+hal_ret_sts ahw_al_imu_fifo_stream_stop(ahw_al_imu_hdle *himu)
+{
+    hal_ret_sts sts;
+    sts = ahiobcsn_check_ste(&himu->ahw_gen_info);
+    if(HAL_SCS == sts)
+    {
+        ahiobcsn_updt_ahste(&himu->ahw_gen_info, AH_BUSY_STATE);
+        sts = ahw_al_imu_common_fifo_stream_stop(himu);
+        ahiobcsn_updt_ahste(&himu->ahw_gen_info, AH_FREE_STATE);
+    }
+    else
+    {
+    }
+    return sts;
+}
 
 #endif
@@ -174,6 +174,17 @@ typedef struct _ahw_al_psm_hdle
  */
 typedef ahw_al_psm_hdle ahw_al_psm_hdl_ptr;
 
+/**
+ * @brief power sense monitor measurement snapshot, all values come from the same conversion
+ */
+typedef struct
+{
+    float vshunt;                                   /*!< shunt voltage                                              */
+    float vbus;                                     /*!< bus voltage (in V)                                         */
+    uint32_t power;                                 /*!< power (in mW)                                              */
+    float current;                                  /*!< current (in A)                                             */
+}ahw_al_psm_snapshot_t;
+
 /**
  * @brief API to initialize the PSM and do the basic configurations
  * @param[in]hpsm_arg : structure handle of power sense monitor.
@@ -390,6 +401,14 @@ uint32_t ahw_al_psm_get_power(ahw_al_psm_hdle *hpsm);
  */
 float ahw_al_psm_get_current(ahw_al_psm_hdle *hpsm);
 
+/**
+ * @brief API to get shunt voltage, bus voltage, power and current of one conversion.
+ * @param[in] hpsm  : structure handle of power sense monitor.
+ * @param[out] snapshot : measured values
+ * @retval  hal_ret_sts - HAL_AH_NOT_READY when no conversion completed since the last read
+ */
+hal_ret_sts ahw_al_psm_get_snapshot(ahw_al_psm_hdle *hpsm, ahw_al_psm_snapshot_t *snapshot);
+
 /**
  * @brief  API to read the designed flag value
  * @param  flag : specifies the flag to check.
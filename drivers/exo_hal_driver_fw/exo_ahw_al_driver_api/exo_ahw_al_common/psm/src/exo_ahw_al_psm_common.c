@@ -99,7 +99,7 @@ hal_ret_sts ahw_al_psm_deinit(ahw_al_psm_hdle* hpsm_arg, ahw_inst_id_t ahw_id)
     return sts;
 }
 
-#ifndef LINUX_TEMP_PORT
+#if !defined(LINUX_TEMP_PORT) || defined(LINUX_AHW_SIM)
 /**
  * @brief API to read the power sense monitor die identifier
  */
@@ -714,6 +714,25 @@ float ahw_al_psm_get_current(ahw_al_psm_hdle *hpsm)
     return res;
 }
 
+/**
+ * @brief  API to read the measurement snapshot
+ */
+hal_ret_sts ahw_al_psm_get_snapshot(ahw_al_psm_hdle *hpsm, ahw_al_psm_snapshot_t *snapshot)
+{
+    hal_ret_sts sts;
+    sts = ahiobcsn_check_ste(&hpsm->ahw_gen_info);
+    if(HAL_SCS == sts)
+    {
+        ahiobcsn_updt_ahste(&hpsm->ahw_gen_info, AH_BUSY_STATE);
+        sts = ahw_al_psm_common_get_snapshot(hpsm, snapshot);
+        ahiobcsn_updt_ahste(&hpsm->ahw_gen_info, AH_FREE_STATE);
+    }
+    else
+    {
+    }
+    return sts;
+}
+
 /**
  * @brief  API to read the designed flag value
  */
@@ -104,6 +104,11 @@ typedef enum
     TEMP_SENSE_TEMP_BOUNDARY_LIMIT_ALARM=1          /*!< temperature boundary limit alarm */
 }temp_sensor_alarm_alert_t;
 
+/**
+ * @brief temperature sensor time stamp function pointer, returns the time in mS
+ */
+typedef uint32_t (*ahw_al_temp_sensor_tick_fptr)(void);
+
 /**
  * @brief temperature sensor device structure.
  */
@@ -125,6 +130,7 @@ typedef struct
     temp_sensor_hyst_t hysteresis;          /*!< hysteresis enumeration         */
     temp_sensor_alarm_alert_t alarm_alert;      /*!< alarm_alert enumeration        */
     temp_sensor_res_t resolution;           /*!< resolution enumeration         */
+    ahw_al_temp_sensor_tick_fptr get_tick;  /*!< mS time source of the alert mode heartbeat, NULL reads on alert only */
 }ahw_al_temp_sensor_hdl;
 
 /**
@@ -298,5 +304,46 @@ hal_ret_sts ahw_al_temp_sensor_get_celsius(ahw_al_temp_sensor_hdl *ahw_al_hts,fl
  * @retval hal_ret_sts      :returns the success or error code
  */
 hal_ret_sts  ahw_al_temp_sensor_read_manufacture_id(ahw_al_temp_sensor_hdl *ahw_al_hts,int16_t* temperature);
+/**
+ * @brief API to get the current temperature in milli degree celsius, the
+ * conversion is done in integer arithmetic
+ * @param[in] ahw_al_hts        : structure handle of Ahw Al temperature sensor handle.
+ * @param[out] temp_mdeg    : temperature value in milli degree celsius
+ * @retval hal_ret_sts      :returns the success or error code
+ */
+hal_ret_sts ahw_al_temp_sensor_get_temperature_mdeg(ahw_al_temp_sensor_hdl *ahw_al_hts,int32_t *temp_mdeg);
+
+/**
+ * @brief API to configure the alert driven sampling. The limits are programmed
+ * once and the event pin is enabled in comparator mode. The application calls
+ * ahw_al_temp_sensor_alert_notify() from the event pin interrupt,
+ * ahw_al_temp_sensor_alert_poll() then reads the sensor after an alert or
+ * when the heartbeat expires.
+ * @param[in] ahw_al_hts        : structure handle of Ahw Al temperature sensor handle.
+ * @param[in] low_mdeg      : low limit in milli degree celsius
+ * @param[in] high_mdeg     : high limit in milli degree celsius
+ * @param[in] crit_mdeg     : critical limit in milli degree celsius
+ * @param[in] hb_ms         : heartbeat period in mS, it needs get_tick, 0 reads on alert only
+ * @retval hal_ret_sts      :returns the success or error code
+ */
+hal_ret_sts ahw_al_temp_sensor_alert_cfg(ahw_al_temp_sensor_hdl *ahw_al_hts,int32_t low_mdeg,int32_t high_mdeg,int32_t crit_mdeg,uint32_t hb_ms);
+
+/**
+ * @brief API to report an event pin alert. It does not access the bus nor the
+ * instance state, so it can be called from interrupt context.
+ * @param[in] ahw_al_hts        : structure handle of Ahw Al temperature sensor handle.
+ * @retval hal_ret_sts      :returns the success or error code
+ */
+hal_ret_sts ahw_al_temp_sensor_alert_notify(ahw_al_temp_sensor_hdl *ahw_al_hts);
+
+/**
+ * @brief API to get the temperature in alert mode, the last temperature is
+ * returned without bus access unless an alert is pending or the heartbeat expired
+ * @param[in] ahw_al_hts        : structure handle of Ahw Al temperature sensor handle.
+ * @param[out] temp_mdeg    : temperature value in milli degree celsius
+ * @param[out] alert_sts    : critical (bit 2), high (bit 1) and low (bit 0) limit flags read by this poll
+ * @retval hal_ret_sts      :returns the success or error code
+ */
+hal_ret_sts ahw_al_temp_sensor_alert_poll(ahw_al_temp_sensor_hdl *ahw_al_hts,int32_t *temp_mdeg,uint8_t *alert_sts);
 
 #endif /* HAL_DRIVER_FW_AHW_AL_DRIVER_API_AHW_AL_INC_AHW_AL_TEMP_H_ */
@@ -98,7 +98,7 @@ hal_ret_sts  ahw_al_temp_sensor_deinit(ahw_al_temp_sensor_hdl* ht_arg, ahw_inst_
     return sts;
 }
 
-#ifndef LINUX_TEMP_PORT
+#if !defined(LINUX_TEMP_PORT) || defined(LINUX_AHW_SIM)
 /**
  * @brief  API to get the event status of the temperature sensor
  */
@@ -586,4 +586,97 @@ hal_ret_sts ahw_al_temp_sensor_read_manufacture_id(ahw_al_temp_sensor_hdl *ahw_a
     return sts;
 }
 
+/**
+ * @brief API to get the current temperature in milli degree celsius
+ */
+hal_ret_sts ahw_al_temp_sensor_get_temperature_mdeg(ahw_al_temp_sensor_hdl *ahw_al_hts,int32_t *temp_mdeg)
+{
+    hal_ret_sts sts;
+    sts = ahiobcsn_check_ste(&ahw_al_hts->ahw_gen_info);
+    if(HAL_SCS == sts)
+    {
+        ahiobcsn_updt_ahste(&ahw_al_hts->ahw_gen_info, AH_BUSY_STATE);
+        if(HAL_SCS == ahw_al_ts_common_get_temperature_mdeg(ahw_al_hts,temp_mdeg))
+        {
+            ahiobcsn_updt_ahste(&ahw_al_hts->ahw_gen_info, AH_FREE_STATE);
+            sts = HAL_SCS;
+        }
+        else
+        {
+            ahiobcsn_updt_ahste(&ahw_al_hts->ahw_gen_info, AH_FREE_STATE);
+            sts = HAL_AH_DRIVER_ERR;
+        }
+    }
+    else
+    {
+
+    }
+    return sts;
+}
+
+/**
+ * @brief API to configure the alert driven sampling
+ */
+hal_ret_sts ahw_al_temp_sensor_alert_cfg(ahw_al_temp_sensor_hdl *ahw_al_hts,int32_t low_mdeg,int32_t high_mdeg,int32_t crit_mdeg,uint32_t hb_ms)
+{
+    hal_ret_sts sts;
+    sts = ahiobcsn_check_ste(&ahw_al_hts->ahw_gen_info);
+    if(HAL_SCS == sts)
+    {
+        ahiobcsn_updt_ahste(&ahw_al_hts->ahw_gen_info, AH_BUSY_STATE);
+        if(HAL_SCS == ahw_al_ts_common_alert_cfg(ahw_al_hts,low_mdeg,high_mdeg,crit_mdeg,(NULL != ahw_al_hts->get_tick) ? hb_ms : 0))
+        {
+            ahiobcsn_updt_ahste(&ahw_al_hts->ahw_gen_info, AH_FREE_STATE);
+            sts = HAL_SCS;
+        }
+        else
+        {
+            ahiobcsn_updt_ahste(&ahw_al_hts->ahw_gen_info, AH_FREE_STATE);
+            sts = HAL_AH_DRIVER_ERR;
+        }
+    }
+    else
+    {
+
+    }
+    return sts;
+}
+
+/**
+ * @brief API to report an event pin alert
+ */
+hal_ret_sts ahw_al_temp_sensor_alert_notify(ahw_al_temp_sensor_hdl *ahw_al_hts)
+{
+    return ahw_al_ts_common_alert_notify(ahw_al_hts);
+}
+
+/**
+ * @brief API to get the temperature in alert mode
+ */
+hal_ret_sts ahw_al_temp_sensor_alert_poll(ahw_al_temp_sensor_hdl *ahw_al_hts,int32_t *temp_mdeg,uint8_t *alert_sts)
+{
+    hal_ret_sts sts;
+    uint32_t now_ms = (NULL != ahw_al_hts->get_tick) ? ahw_al_hts->get_tick() : 0;
+    sts = ahiobcsn_check_ste(&ahw_al_hts->ahw_gen_info);
+    if(HAL_SCS == sts)
+    {
+        ahiobcsn_updt_ahste(&ahw_al_hts->ahw_gen_info, AH_BUSY_STATE);
+        if(HAL_SCS == ahw_al_ts_common_alert_poll(ahw_al_hts,now_ms,temp_mdeg,alert_sts))
+        {
+            ahiobcsn_updt_ahste(&ahw_al_hts->ahw_gen_info, AH_FREE_STATE);
+            sts = HAL_SCS;
+        }
+        else
+        {
+            ahiobcsn_updt_ahste(&ahw_al_hts->ahw_gen_info, AH_FREE_STATE);
+            sts = HAL_AH_DRIVER_ERR;
+        }
+    }
+    else
+    {
+
+    }
+    return sts;
+}
+
 #endif
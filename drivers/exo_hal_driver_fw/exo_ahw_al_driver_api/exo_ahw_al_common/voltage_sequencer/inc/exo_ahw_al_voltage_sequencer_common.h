@@ -57,6 +57,8 @@ typedef enum
 
 }vltg_seq_rail_num;
 
+#define VOLTAGE_SEQ_RAIL_CNT        8       ///< number of monitored rails, VOLTAGE_SEQ_RAIL1 to VOLTAGE_SEQ_RAIL8
+
 /**
  * @brief voltage sequencer control block structure definition
  */
@@ -103,6 +105,15 @@ typedef struct
 
 }vltg_seq_rail_cfg;
 
+/**
+ * @brief voltage sequencer all rails snapshot structure definition
+ */
+typedef struct
+{
+    uint16_t raw[VOLTAGE_SEQ_RAIL_CNT];     /*!< ADC counts, indexed by vltg_seq_rail_num   */
+    float voltage[VOLTAGE_SEQ_RAIL_CNT];    /*!< rail voltages, indexed by vltg_seq_rail_num */
+}vltg_seq_rail_snapshot;
+
 /**
  * @brief API to initialization is set in this function
  * @retval hal_ret_sts - returns the success or error code
@@ -202,6 +213,16 @@ hal_ret_sts ahw_al_vsm_get_fw_version(ahw_al_vsm_hdle *al_vsm, uint8_t* version)
  */
 hal_ret_sts ahw_al_vsm_get_voltage(ahw_al_vsm_hdle *al_vsm, vltg_seq_rail_cfg* rail_info, float *voltage);
 
+/**
+ * @brief API to get voltage of all rails captured at the same instant. The rail
+ * registers are read in one transaction and scaled with the divider given to
+ * ahw_al_vsm_rail_config for each rail
+ * @param[in]  al_vsm - AHAL instance pointer of UCD9081
+ * @param[out]  snapshot - ADC counts and voltages of all rails
+ * @retval hal_ret_sts - returns the success or error code
+ */
+hal_ret_sts ahw_al_vsm_get_all_voltages(ahw_al_vsm_hdle *al_vsm, vltg_seq_rail_snapshot* snapshot);
+
 /**
  * @brief API to get alarm pending status
  * @param[in]  al_vsm - AHAL instance pointer of UCD9081
@@ -66,7 +66,7 @@ hal_ret_sts ahw_al_vsm_init()
 #endif
     return sts;
 }
-#ifndef LINUX_TEMP_PORT
+#if !defined(LINUX_TEMP_PORT) || defined(LINUX_AHW_SIM)
 
 /*!
  *  @brief This API configure the rail  and voltage sequencer instance
@@ -354,6 +354,32 @@ hal_ret_sts ahw_al_vsm_get_voltage(ahw_al_vsm_hdle *al_vsm, vltg_seq_rail_cfg* r
     return sts;
 }
 
+/*!
+ *  @brief This API get voltage of all rails
+ */
+hal_ret_sts ahw_al_vsm_get_all_voltages(ahw_al_vsm_hdle *al_vsm, vltg_seq_rail_snapshot* snapshot)
+{
+    hal_ret_sts sts;
+    sts = ahiobcsn_check_ste(&al_vsm->ahw_gen_info);
+    if(HAL_SCS == sts)
+    {
+        ahiobcsn_updt_ahste(&al_vsm->ahw_gen_info, AH_BUSY_STATE);
+        if(HAL_SCS == ahw_al_vsm_common_get_all_voltages(al_vsm,snapshot))
+        {
+            ahiobcsn_updt_ahste(&al_vsm->ahw_gen_info, AH_FREE_STATE);
+            sts = HAL_SCS;
+        }
+        else
+        {
+            sts = HAL_AH_DRIVER_ERR;
+        }
+    }
+    else
+    {
+    }
+    return sts;
+}
+
 /*!
  *  @brief This API get alarm pending status
  */
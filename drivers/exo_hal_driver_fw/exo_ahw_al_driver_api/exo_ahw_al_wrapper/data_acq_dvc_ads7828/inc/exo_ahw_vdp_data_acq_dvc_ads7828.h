@@ -24,6 +24,13 @@
 #ifndef DRIVERS_EXO_HAL_DRIVER_FW_EXO_AHW_AL_DRIVER_API_EXO_AHW_AL_WRAPPER_DL_ADS7828_INC_EXO_AHW_VDP_DL_ADS7828_H_
 #define DRIVERS_EXO_HAL_DRIVER_FW_EXO_AHW_AL_DRIVER_API_EXO_AHW_AL_WRAPPER_DL_ADS7828_INC_EXO_AHW_VDP_DL_ADS7828_H_
 
+/**
+ * @brief This function is used to initialize the ads7828 instance
+ * @param[in] al_ads7828 - instance pointer of ads7828
+ * @retval hal_ret_sts - returns the success or error code
+ */
+hal_ret_sts ahw_vdp_ads7828_init(ahw_al_ads7828_hdle *al_ads7828);
+
 /**
  * @brief This function is used to get the data from the specified channel number
  * @param[in] al_ads7828 - instance pointer of ads7828
@@ -34,5 +41,16 @@
  */
 hal_ret_sts ahw_vdp_ads7828_get_data(ahw_al_ads7828_hdle *al_ads7828,ahw_al_ads7828_chnl chnl,ahw_al_ads7828_pd_sel pd_opt,uint16_t* data);
 
+/**
+ * @brief This function is used to scan the single ended channels
+ * @param[in] al_ads7828 - instance pointer of ads7828
+ * @param[in] chnl_mask - bit n selects single ended channel n
+ * @param[in] pd_opt - power down option after the scan
+ * @param[out] samples - pointer to the samples
+ * @param[out] count - number of samples
+ * @retval hal_ret_sts - returns the success or error code
+ */
+hal_ret_sts ahw_vdp_ads7828_scan(ahw_al_ads7828_hdle *al_ads7828,uint8_t chnl_mask,ahw_al_ads7828_pd_sel pd_opt,ahw_al_ads7828_sample* samples,uint8_t* count);
+
 
 #endif /* DRIVERS_EXO_HAL_DRIVER_FW_EXO_AHW_AL_DRIVER_API_EXO_AHW_AL_WRAPPER_DL_ADS7828_INC_EXO_AHW_VDP_DL_ADS7828_H_ */
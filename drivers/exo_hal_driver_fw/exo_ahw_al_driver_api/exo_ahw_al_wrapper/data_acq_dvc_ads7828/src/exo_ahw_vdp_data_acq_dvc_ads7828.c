@@ -20,8 +20,71 @@
 
 #include "exo_ahw_vdp_data_acq_dvc_ads7828.h"
 #include "ads7828.h"
+#include "exo_io_al_i2c_common.h"
+
+#if !defined(LINUX_TEMP_PORT) || defined(LINUX_AHW_SIM)
+extern ahw_io_map *ahw_io_lookup_tble[MAX_AH_INST_ID];   ///< Hardware IO lookup table
+extern void *intf_inst_hdle_ptr[MAX_IO_INST_ID];         ///< Interface instance handle pointer
+static s_ads7828 vdh_ads7828;                            ///< ADS7828 driver instance
+
+/*!
+ *  @brief I2C read hook function for ADS7828 module
+ */
+static int8_t ads7828_i2c_read(void* intf_hdl, uint16_t slv_addr, uint8_t *data, uint16_t len)
+{
+    return (HAL_SCS == io_hal_i2c_receive((ioal_i2c_hdle*)intf_hdl, (uint16)slv_addr, data, len, 500)) ? ADS7828_SCS : ADS7828_COM_ERR;
+}
+
+/*!
+ *  @brief I2C write hook function for ADS7828 module
+ */
+static int8_t ads7828_i2c_write(void* intf_hdl, uint16_t slv_addr, uint8_t *data, uint16_t len)
+{
+    return (HAL_SCS == io_hal_i2c_transmit((ioal_i2c_hdle*)intf_hdl, (uint16)slv_addr, data, len, 500)) ? ADS7828_SCS : ADS7828_COM_ERR;
+}
+
+/*!
+ *  @brief I2C batched transfer hook function for ADS7828 module, each command
+ *  byte and the read of its result are joined by a repeated start
+ */
+static int8_t ads7828_i2c_xfer(void* intf_hdl, uint16_t slv_addr, const uint8_t *cmd, uint8_t *data, uint8_t count)
+{
+    iohal_i2c_xfer xfer[ADS7828_SCAN_BATCH];
+    uint8_t idx;
+
+    if(count > ADS7828_SCAN_BATCH)
+    {
+        return ADS7828_INVLD_ARG;
+    }
+    for(idx = 0; idx < count; idx++)
+    {
+        xfer[idx].addr = (uint16)slv_addr;
+        xfer[idx].wr_data = (uint8*)&cmd[idx];
+        xfer[idx].wr_size = 1;
+        xfer[idx].rd_data = &data[2 * idx];
+        xfer[idx].rd_size = 2;
+    }
+    return (HAL_SCS == io_hal_i2c_transfer((ioal_i2c_hdle*)intf_hdl, xfer, count, 500)) ? ADS7828_SCS : ADS7828_COM_ERR;
+}
+
+/*!
+ *  @brief This API is used to initialize the ads7828 instance
+ */
+hal_ret_sts ahw_vdp_ads7828_init(ahw_al_ads7828_hdle *al_ads7828)
+{
+    vdh_ads7828.read = ads7828_i2c_read;
+    vdh_ads7828.write = ads7828_i2c_write;
+    vdh_ads7828.xfer = ads7828_i2c_xfer;
+    vdh_ads7828.get_tick = al_ads7828->get_tick;
+    vdh_ads7828.intf_hdl = intf_inst_hdle_ptr[ahw_io_lookup_tble[al_ads7828->ahw_gen_info.ahw_inst_id]->io_instance_id];
+    vdh_ads7828.slv_addr = ahw_io_lookup_tble[al_ads7828->ahw_gen_info.ahw_inst_id]->slv_addr;
+
+    al_ads7828->ahw_gen_info.vdp_inst_hdle = (void*)&vdh_ads7828;
+    al_ads7828->ahw_gen_info.slave_address = vdh_ads7828.slv_addr;
+    al_ads7828->ahw_gen_info.io_intf_hdle = vdh_ads7828.intf_hdl;
+    return HAL_SCS;
+}
 
-#ifndef LINUX_TEMP_PORT
 
 /*!
  *  @brief This API is used to get the data from specified channel number
@@ -41,6 +104,33 @@ hal_ret_sts ahw_vdp_ads7828_get_data(ahw_al_ads7828_hdle *al_ads7828,ahw_al_ads7
     }
     return sts;
 }
-#endif
 
+/*!
+ *  @brief This API is used to scan the single ended channels
+ */
+hal_ret_sts ahw_vdp_ads7828_scan(ahw_al_ads7828_hdle *al_ads7828,uint8_t chnl_mask,ahw_al_ads7828_pd_sel pd_opt,ahw_al_ads7828_sample* samples,uint8_t* count)
+{
+    hal_ret_sts sts;
+    s_ads7828 *ads7828_hdl_vdp;
+    s_ads7828_sample vdp_samples[ADS7828_SCAN_CHNL_MAX];
+    uint8_t idx;
 
+    ads7828_hdl_vdp = al_ads7828->ahw_gen_info.vdp_inst_hdle;
+    *count = 0;
+    if(ADS7828_SCS == ads7828_scan(ads7828_hdl_vdp,chnl_mask,(e_ads7828_pd_sel)pd_opt,vdp_samples,count))
+    {
+        for(idx = 0; idx < *count; idx++)
+        {
+            samples[idx].chnl = (ahw_al_ads7828_chnl)vdp_samples[idx].chnl;
+            samples[idx].data = vdp_samples[idx].data;
+            samples[idx].tick = vdp_samples[idx].tick;
+        }
+        sts=HAL_SCS;
+    }
+    else
+    {
+        sts=HAL_AH_DRIVER_ERR;
+    }
+    return sts;
+}
+#endif
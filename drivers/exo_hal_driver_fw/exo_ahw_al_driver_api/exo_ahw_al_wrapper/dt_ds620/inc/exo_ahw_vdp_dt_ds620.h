@@ -178,6 +178,39 @@ hal_ret_sts ahw_vdp_dt_ds620_get_temperature_high_thrshd(ahw_al_dt_hdle *al_dt,
  * @retval hal_ret_sts - returns the success or error code
  */
 hal_ret_sts ahw_vdp_dt_ds620_reset_alert_flag(ahw_al_dt_hdle *al_dt);
+/**
+ * @brief API to read the temperature in milli degree celsius
+ * @param[in]  al_dt - instance pointer of DS620
+ * @param[out] temp_mdeg - temperature in milli degree celsius
+ * @retval hal_ret_sts - returns the success or error code
+ */
+hal_ret_sts ahw_vdp_dt_ds620_get_temperature_mdeg (ahw_al_dt_hdle *al_dt, int32_t* temp_mdeg);
+
+/**
+ * @brief API to configure the alert driven sampling
+ * @param[in]  al_dt - instance pointer of DS620
+ * @param[in]  low_mdeg - low temperature threshold in milli degree celsius
+ * @param[in]  high_mdeg - high temperature threshold in milli degree celsius
+ * @param[in]  hb_ms - heartbeat period in mS, 0 reads on alert only
+ * @retval hal_ret_sts - returns the success or error code
+ */
+hal_ret_sts ahw_vdp_dt_ds620_alert_cfg (ahw_al_dt_hdle *al_dt, int32_t low_mdeg, int32_t high_mdeg, uint32_t hb_ms);
 
+/**
+ * @brief API to report a PO pin alert
+ * @param[in]  al_dt - instance pointer of DS620
+ * @retval hal_ret_sts - returns the success or error code
+ */
+hal_ret_sts ahw_vdp_dt_ds620_alert_notify (ahw_al_dt_hdle *al_dt);
+
+/**
+ * @brief API to get the temperature in alert mode
+ * @param[in]  al_dt - instance pointer of DS620
+ * @param[in]  now_ms - current time in mS
+ * @param[out] temp_mdeg - temperature in milli degree celsius
+ * @param[out] alert_sts - THF (bit 1) and TLF (bit 0) flags read by this poll
+ * @retval hal_ret_sts - returns the success or error code
+ */
+hal_ret_sts ahw_vdp_dt_ds620_alert_poll (ahw_al_dt_hdle *al_dt, uint32_t now_ms, int32_t* temp_mdeg, uint8_t* alert_sts);
 
 #endif /* _AHW_AL_IMU_BMX160_H_ */
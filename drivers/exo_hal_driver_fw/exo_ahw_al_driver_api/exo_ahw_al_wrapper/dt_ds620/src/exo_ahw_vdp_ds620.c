@@ -29,7 +29,7 @@
 extern ahw_io_map *ahw_io_lookup_tble[MAX_AH_INST_ID];
 extern void *intf_inst_hdle_ptr[MAX_IO_INST_ID];
 
-#ifndef LINUX_TEMP_PORT
+#if !defined(LINUX_TEMP_PORT) || defined(LINUX_AHW_SIM)
 
 /*!
  *  @brief I2C read hook function for DS620 module
@@ -64,16 +64,16 @@ int8_t ds620_i2c_write(void* intf_hdl, uint16_t slv_addr, uint8_t reg_addr, uint
     ioal_i2c_hdle *hi2c = (ioal_i2c_hdle*)intf_hdl;
     int8_t rslt;
     uint8_t data_send[3];
-    data_send[0]=reg_addr;
-    data_send[1]=data[0];
-    if(len>1)
-        data_send[2]=data[1];
-    len++;
     if(data==NULL)
     {
         rslt = io_hal_i2c_transmit(hi2c, (uint16)(slv_addr),&reg_addr, 1, 500);
         return rslt;
     }
+    data_send[0]=reg_addr;
+    data_send[1]=data[0];
+    if(len>1)
+        data_send[2]=data[1];
+    len++;
     if(HAL_SCS == io_hal_i2c_transmit(hi2c, (uint16)(slv_addr), data_send,len , 500))
     {
         rslt = DS620_SCS;
@@ -93,7 +93,7 @@ hal_ret_sts ahw_vdp_dt_ds620_init(ahw_al_dt_hdle *ahw_al_hdt)
 {
 
     hal_ret_sts sts = HAL_MAX_ERR;
-#ifdef LINUX_TEMP_PORT
+#if defined(LINUX_TEMP_PORT) && !defined(LINUX_AHW_SIM)
     printf("\n EXO DS620 Digital thermostat - AH-Vendor driver porting layer Initialise");
     printf("\n EXO DS620 Digital thermostat - AH-Vendor driver Initialise");
     printf("\n EXO DS620 Digital thermostat - AH-Vendor driver Initialisation completed successfully ");
@@ -130,7 +130,7 @@ hal_ret_sts ahw_vdp_dt_ds620_init(ahw_al_dt_hdle *ahw_al_hdt)
     return sts;
 }
 
-#ifndef LINUX_TEMP_PORT
+#if !defined(LINUX_TEMP_PORT) || defined(LINUX_AHW_SIM)
 /*!
  *  @brief This API release the control block memory of ds620 instance
  */
@@ -416,9 +416,11 @@ hal_ret_sts ahw_vdp_dt_ds620_get_po_lvl(ahw_al_dt_hdle *al_dt,uint8_t *lvl)
 {
     e_ds620_err sts;
     s_ds620_drv_cb_ptr ds620_hdl_vdp;
+    e_ds620_po_lvl val;
     ds620_hdl_vdp = (s_ds620_drv_cb_ptr) al_dt->ahw_gen_info.vdp_inst_hdle;
-    if(HAL_SCS == (hal_ret_sts)ds620_get_po_lvl(ds620_hdl_vdp,lvl))
+    if(HAL_SCS == (hal_ret_sts)ds620_get_po_lvl(ds620_hdl_vdp,&val))
     {
+        *lvl = (uint8_t)val;
         sts=HAL_SCS;
     }
     else
@@ -435,9 +437,11 @@ hal_ret_sts ahw_vdp_dt_ds620_get_po_lvl_alert_sts(ahw_al_dt_hdle *al_dt, uint8_t
 {
     e_ds620_err sts;
     s_ds620_drv_cb_ptr ds620_hdl_vdp;
+    e_ds620_po_lvl val;
     ds620_hdl_vdp = (s_ds620_drv_cb_ptr) al_dt->ahw_gen_info.vdp_inst_hdle;
-    if(HAL_SCS == (hal_ret_sts)ds620_get_po_lvl_alert_sts(ds620_hdl_vdp,(e_ds620_po_lvl*)alert_sts))
+    if(HAL_SCS == (hal_ret_sts)ds620_get_po_lvl_alert_sts(ds620_hdl_vdp,&val))
     {
+        *alert_sts = (uint8_t)val;
         sts=HAL_SCS;
     }
     else
@@ -454,9 +458,11 @@ hal_ret_sts ahw_vdp_dt_ds620_get_mode(ahw_al_dt_hdle *al_dt,uint8_t *mode)
 {
     e_ds620_err sts;
     s_ds620_drv_cb_ptr ds620_hdl_vdp;
+    e_ds620_mode val;
     ds620_hdl_vdp = (s_ds620_drv_cb_ptr) al_dt->ahw_gen_info.vdp_inst_hdle;
-    if(HAL_SCS == (hal_ret_sts)ds620_get_mode(ds620_hdl_vdp,mode))
+    if(HAL_SCS == (hal_ret_sts)ds620_get_mode(ds620_hdl_vdp,&val))
     {
+        *mode = (uint8_t)val;
         sts=HAL_SCS;
     }
     else
@@ -523,5 +529,70 @@ hal_ret_sts ahw_vdp_dt_ds620_reset_alert_flag(ahw_al_dt_hdle *al_dt)
     return sts;
 }
 
+/*!
+ *  @brief This API reads temperature in milli degree celsius
+ */
+hal_ret_sts ahw_vdp_dt_ds620_get_temperature_mdeg (ahw_al_dt_hdle *al_dt, int32_t* temp_mdeg)
+{
+    hal_ret_sts sts;
+    s_ds620_drv_cb_ptr ds620_hdl_vdp = (s_ds620_drv_cb_ptr) al_dt->ahw_gen_info.vdp_inst_hdle;
+    if(HAL_SCS == (hal_ret_sts)ds620_get_temperature_mdeg(ds620_hdl_vdp,temp_mdeg))
+    {
+        sts = HAL_SCS;
+    }
+    else
+    {
+        sts = HAL_AH_DRIVER_ERR;
+    }
+    return sts;
+}
+
+/*!
+ *  @brief This API programs the thresholds and enables the alert driven sampling
+ */
+hal_ret_sts ahw_vdp_dt_ds620_alert_cfg (ahw_al_dt_hdle *al_dt, int32_t low_mdeg, int32_t high_mdeg, uint32_t hb_ms)
+{
+    hal_ret_sts sts;
+    s_ds620_drv_cb_ptr ds620_hdl_vdp = (s_ds620_drv_cb_ptr) al_dt->ahw_gen_info.vdp_inst_hdle;
+    if(HAL_SCS == (hal_ret_sts)ds620_alert_mode_cfg(ds620_hdl_vdp,low_mdeg,high_mdeg,hb_ms))
+    {
+        al_dt->low_temp_thrsld=(double)low_mdeg/1000.0;
+        al_dt->high_temp_thrsld=(double)high_mdeg/1000.0;
+        sts = HAL_SCS;
+    }
+    else
+    {
+        sts = HAL_AH_DRIVER_ERR;
+    }
+    return sts;
+}
+
+/*!
+ *  @brief This API reports a PO pin alert
+ */
+hal_ret_sts ahw_vdp_dt_ds620_alert_notify (ahw_al_dt_hdle *al_dt)
+{
+    ds620_alert_notify((s_ds620_drv_cb_ptr) al_dt->ahw_gen_info.vdp_inst_hdle);
+    return HAL_SCS;
+}
+
+/*!
+ *  @brief This API returns the temperature in alert mode
+ */
+hal_ret_sts ahw_vdp_dt_ds620_alert_poll (ahw_al_dt_hdle *al_dt, uint32_t now_ms, int32_t* temp_mdeg, uint8_t* alert_sts)
+{
+    hal_ret_sts sts;
+    s_ds620_drv_cb_ptr ds620_hdl_vdp = (s_ds620_drv_cb_ptr) al_dt->ahw_gen_info.vdp_inst_hdle;
+    if(HAL_SCS == (hal_ret_sts)ds620_alert_poll(ds620_hdl_vdp,now_ms,temp_mdeg,alert_sts))
+    {
+        al_dt->thermostat_event_sts=*alert_sts;
+        sts = HAL_SCS;
+    }
+    else
+    {
+        sts = HAL_AH_DRIVER_ERR;
+    }
+    return sts;
+}
 
 #endif
@@ -139,4 +139,22 @@ hal_ret_sts ahw_vdp_mcp23008_int_pin_polarity_cfg(ahw_al_gpio_exp_hdle* hgpio_ex
  */
 hal_ret_sts ahw_vdp_mcp23008_interrupt_cb(ahw_al_gpio_exp_hdle* hgpio_exp);
 
+/**
+ * @brief  API to update the output state of the port in one write
+ * @param[in]  hgpio_exp - AHAL instance pointer of gpio expander
+ * @param[in]  set_msk - pins to be driven high
+ * @param[in]  clr_msk - pins to be driven low
+ * @param[in]  tgl_msk - pins to be toggled
+ * @retval hal_ret_sts - returns the success or error code
+ */
+hal_ret_sts ahw_vdp_mcp23008_port_update(ahw_al_gpio_exp_hdle* hgpio_exp, uint8_t set_msk, uint8_t clr_msk, uint8_t tgl_msk);
+
+/**
+ * @brief  API to read the state of the port
+ * @param[in]  hgpio_exp - AHAL instance pointer of gpio expander
+ * @param[out]  port_ste - state of all the pins
+ * @retval hal_ret_sts - returns the success or error code
+ */
+hal_ret_sts ahw_vdp_mcp23008_read_port(ahw_al_gpio_exp_hdle* hgpio_exp, uint8_t* port_ste);
+
 #endif /* DRIVERS_EXO_HAL_DRIVER_FW_EXO_AHW_AL_DRIVER_API_EXO_AHW_AL_WRAPPER_GPIO_MCP23008_INC_EXO_AHW_VDP_GPIO_EXP_MCP23008_H_ */
@@ -49,7 +49,7 @@ extern void *intf_inst_hdle_ptr[MAX_IO_INST_ID];
 int8_t mcp23008_i2c_read(void* intf_hdl, uint16_t slv_addr, uint8_t reg_addr, uint8_t *data, uint16_t len);
 int8_t mcp23008_i2c_write(void* intf_hdl, uint16_t slv_addr, uint8_t reg_addr, uint8_t *data, uint16_t len);
 
-#ifndef LINUX_TEMP_PORT
+#if !defined(LINUX_TEMP_PORT) || defined(LINUX_AHW_SIM)
 /*!
  *  @brief I2C read hook function for MCP23008 module
  */
@@ -57,16 +57,10 @@ int8_t mcp23008_i2c_read(void* intf_hdl, uint16_t slv_addr, uint8_t reg_addr, ui
 {
     ioal_i2c_hdle *hi2c = (ioal_i2c_hdle*)intf_hdl;
     int8_t rslt;
-    if(HAL_SCS == io_hal_i2c_transmit(hi2c, (uint16)(slv_addr), &reg_addr, 1, 500))
+    /* Repeated start read, sequential registers are read in the same transfer */
+    if(HAL_SCS == io_hal_i2c_write_read(hi2c, (uint16)(slv_addr), &reg_addr, 1, data, len, 500))
     {
-        if(HAL_SCS == io_hal_i2c_receive(hi2c, (uint16)(slv_addr), data, len, 500))
-        {
-            rslt = MCP23008_SCS;
-        }
-        else
-        {
-            rslt = MCP23008_COM_ERR;
-        }
+        rslt = MCP23008_SCS;
     }
     else
     {
@@ -89,6 +83,10 @@ int8_t mcp23008_i2c_write(void* intf_hdl, uint16_t slv_addr, uint8_t reg_addr, u
     {
         rslt=HAL_SCS;
     }
+    else
+    {
+        rslt=MCP23008_COM_ERR;
+    }
 
     return rslt;
 }
@@ -100,7 +98,7 @@ int8_t mcp23008_i2c_write(void* intf_hdl, uint16_t slv_addr, uint8_t reg_addr, u
 hal_ret_sts ahw_vdp_gpio_exp_mcp23008_init(ahw_al_gpio_exp_hdle *hgpio_exp)
 {
     hal_ret_sts sts = HAL_MAX_ERR;
-#ifdef LINUX_TEMP_PORT
+#if defined(LINUX_TEMP_PORT) && !defined(LINUX_AHW_SIM)
     printf("\n EXO GPIO EXPANDER - AH-Vendor driver porting layer Initialize");
     printf("\n EXO GPIO EXPANDER - AH-Vendor driver Initialize");
     printf("\n EXO GPIO EXPANDER - AH-Vendor driver Initialization completed successfully ");
@@ -113,11 +111,17 @@ hal_ret_sts ahw_vdp_gpio_exp_mcp23008_init(ahw_al_gpio_exp_hdle *hgpio_exp)
     hge->read =  mcp23008_i2c_read;
     hge->intf_hdl = intf_inst_hdle_ptr[ahw_io_lookup_tble[hgpio_exp->ahw_gen_info.ahw_inst_id]->io_instance_id];
     hge->slv_addr=ahw_io_lookup_tble[hgpio_exp->ahw_gen_info.ahw_inst_id]->slv_addr;
-
-    hgpio_exp->ahw_gen_info.vdp_inst_hdle =(void*)hge;
-    hgpio_exp->ahw_gen_info.io_intf_hdle=hge->intf_hdl;
-    hgpio_exp->ahw_gen_info.slave_address=hge->slv_addr;
-    sts = HAL_SCS;
+    if(HAL_SCS == (hal_ret_sts)mcp23008_init(hge))
+    {
+        hgpio_exp->ahw_gen_info.vdp_inst_hdle =(void*)hge;
+        hgpio_exp->ahw_gen_info.io_intf_hdle=hge->intf_hdl;
+        hgpio_exp->ahw_gen_info.slave_address=hge->slv_addr;
+        sts = HAL_SCS;
+    }
+    else
+    {
+        sts = HAL_AH_DRIVER_ERR;
+    }
 #endif
     return sts;
 }
@@ -367,7 +371,7 @@ hal_ret_sts ahw_vdp_mcp23008_interrupt_cb(ahw_al_gpio_exp_hdle* hgpio_exp)
     uint8_t intr_flg,pin=0;
     s_mcp23008 *gpio_hdl_vdp;
     gpio_hdl_vdp = hgpio_exp->ahw_gen_info.vdp_inst_hdle;
-    if(HAL_SCS == (hal_ret_sts)mcp23008_check_intr_sts(gpio_hdl_vdp,&intr_flg))
+    if(HAL_SCS == (hal_ret_sts)mcp23008_intr_refresh(gpio_hdl_vdp,&intr_flg))
     {
         while(intr_flg)
         {
@@ -386,7 +390,44 @@ hal_ret_sts ahw_vdp_mcp23008_interrupt_cb(ahw_al_gpio_exp_hdle* hgpio_exp)
            intr_flg=intr_flg>>1;
            pin++;
         }
-    	mcp23008_clear_interrupt(gpio_hdl_vdp);
+    }
+    else
+    {
+        sts=HAL_AH_DRIVER_ERR;
+    }
+    return sts;
+}
+
+/*!
+ *  @brief This API updates the output state of the port
+ */
+hal_ret_sts ahw_vdp_mcp23008_port_update(ahw_al_gpio_exp_hdle* hgpio_exp, uint8_t set_msk, uint8_t clr_msk, uint8_t tgl_msk)
+{
+    hal_ret_sts sts;
+    s_mcp23008 *gpio_hdl_vdp;
+    gpio_hdl_vdp = hgpio_exp->ahw_gen_info.vdp_inst_hdle;
+    if(HAL_SCS == (hal_ret_sts)mcp23008_port_update(gpio_hdl_vdp,set_msk,clr_msk,tgl_msk))
+    {
+        sts=HAL_SCS;
+    }
+    else
+    {
+        sts=HAL_AH_DRIVER_ERR;
+    }
+    return sts;
+}
+
+/*!
+ *  @brief This API read the state of the port
+ */
+hal_ret_sts ahw_vdp_mcp23008_read_port(ahw_al_gpio_exp_hdle* hgpio_exp, uint8_t* port_ste)
+{
+    hal_ret_sts sts;
+    s_mcp23008 *gpio_hdl_vdp;
+    gpio_hdl_vdp = hgpio_exp->ahw_gen_info.vdp_inst_hdle;
+    if(HAL_SCS == (hal_ret_sts)mcp23008_read_port(gpio_hdl_vdp,port_ste))
+    {
+        sts=HAL_SCS;
     }
     else
     {
@@ -161,4 +161,24 @@ hal_ret_sts ahw_vdp_gpio_exp_pcal6408a_isr_hdlr(ahw_al_gpio_exp_hdle *hgpio_exp)
  */
 hal_ret_sts ahw_vdp_gpio_exp_pcal6408a_gpio_pin_cfg(ahw_al_gpio_exp_hdle* hgpio_exp, ahw_al_gpio_exp_gpio_cfg* gpio_pin);
 
+/**
+ * @brief This API updates the output state of the port in one write
+ * @param[in] hgpio_exp : Structure instance of gpio_exp_hdl.
+ * @param[in] set_msk : pins to be driven high
+ * @param[in] clr_msk : pins to be driven low
+ * @param[in] tgl_msk : pins to be toggled
+ * @return Result of API execution status
+ * @retval zero -> Success / -ve value -> Error.
+ */
+hal_ret_sts ahw_vdp_gpio_exp_pcal6408a_port_update(ahw_al_gpio_exp_hdle *hgpio_exp, uint8_t set_msk, uint8_t clr_msk, uint8_t tgl_msk);
+
+/**
+ * @brief This API is used to read the state of the port
+ * @param[in] hgpio_exp : Structure instance of gpio_exp_hdl.
+ * @param[out] port_ste : state of all the pins
+ * @return Result of API execution status
+ * @retval zero -> Success / -ve value -> Error.
+ */
+hal_ret_sts ahw_vdp_gpio_exp_pcal6408a_readport(ahw_al_gpio_exp_hdle *hgpio_exp, uint8_t *port_ste);
+
 #endif /* EXO_HAL_DRIVER_FW_EXO_AHW_AL_DRIVER_API_EXO_AHW_AL_WRAPPER_GPIO_PCAL_6408_INC_EXO_AHW_VDP_GPIO_EXP_PCAL6408A_H_ */
@@ -74,6 +74,10 @@ uint8_t pcal6408a_i2c_write(void* intf_hdl, uint16_t slv_addr, uint8_t reg_addr,
     {
         rslt=PCAL6408A_OK;
     }
+    else
+    {
+        rslt=PCAL6408A_E_COM_FAIL;
+    }
     return rslt;
 }
 
@@ -84,16 +88,9 @@ uint8_t pcal6408a_i2c_read(void* intf_hdl, uint16_t slv_addr, uint8_t reg_addr,
 {
     ioal_i2c_hdle *hi2c = (ioal_i2c_hdle*)intf_hdl;
     int8_t rslt;
-    if(HAL_SCS == io_hal_i2c_transmit(hi2c, (uint16)slv_addr, &reg_addr, 1, 500))
+    if(HAL_SCS == io_hal_i2c_write_read(hi2c, (uint16)slv_addr, &reg_addr, 1, data, len, 500))
     {
-        if(HAL_SCS == io_hal_i2c_receive(hi2c, (uint16)slv_addr, data, len, 500))
-        {
-            rslt =PCAL6408A_OK;
-        }
-        else
-        {
-            rslt =PCAL6408A_E_COM_FAIL;
-        }
+        rslt =PCAL6408A_OK;
     }
     else
     {
@@ -108,7 +105,7 @@ uint8_t pcal6408a_i2c_read(void* intf_hdl, uint16_t slv_addr, uint8_t reg_addr,
 hal_ret_sts ahw_vdp_gpio_exp_pcal6408a_init(ahw_al_gpio_exp_hdle *hgpio_exp)
 {
     hal_ret_sts sts = HAL_MAX_ERR;
-#ifdef LINUX_TEMP_PORT
+#if defined(LINUX_TEMP_PORT) && !defined(LINUX_AHW_SIM)
     printf("\n EXO GPIO EXPANDER - AH-Vendor driver porting layer Initialize");
     printf("\n EXO GPIO EXPANDER - AH-Vendor driver Initialize");
     printf("\n EXO GPIO EXPANDER - AH-Vendor driver Initialization completed successfully ");
@@ -220,7 +217,8 @@ hal_ret_sts ahw_vdp_gpio_exp_pcal6408a_set_dir(ahw_al_gpio_exp_hdle *hgpio_exp,
     hal_ret_sts sts;
     pcal6408a_dev *vdh_gex;
     vdh_gex = (pcal6408a_dev*) hgpio_exp->ahw_gen_info.vdp_inst_hdle;
-    if(HAL_SCS == pcal6408a_set_dir(vdh_gex,pin,pin_dir))
+    /* A set configuration bit makes the pin an input, the driver enumeration follows the device */
+    if(HAL_SCS == pcal6408a_set_dir(vdh_gex,pin,(pin_dir == GPIO_EXP_OUTPUT) ? OUTPUT : INPUT))
     {
         sts = HAL_SCS;
     }
@@ -365,9 +363,9 @@ hal_ret_sts ahw_vdp_gpio_exp_pcal6408a_isr_hdlr(ahw_al_gpio_exp_hdle *hgpio_exp)
     uint8_t intr_flg,data,pin=0;
     pcal6408a_dev *gpio_hdl_vdp;
     gpio_hdl_vdp = hgpio_exp->ahw_gen_info.vdp_inst_hdle;
-    if(HAL_SCS == (hal_ret_sts)pcal6408a_read_intr_sts(gpio_hdl_vdp,&intr_flg))
+    if(HAL_SCS == (hal_ret_sts)pcal6408a_intr_refresh(gpio_hdl_vdp,&intr_flg))
     {
-        pcal6408a_read(gpio_hdl_vdp, PCAL6408_REG_INPUT,&data, 1);
+        data = gpio_hdl_vdp->shdw.input;
         while(intr_flg)
         {
             if((intr_flg & 0x01) == 0x01)
@@ -391,3 +389,41 @@ hal_ret_sts ahw_vdp_gpio_exp_pcal6408a_isr_hdlr(ahw_al_gpio_exp_hdle *hgpio_exp)
     }
     return sts;
 }
+
+/**
+ * @brief This API updates the output state of the port
+ */
+hal_ret_sts ahw_vdp_gpio_exp_pcal6408a_port_update(ahw_al_gpio_exp_hdle *hgpio_exp, uint8_t set_msk, uint8_t clr_msk, uint8_t tgl_msk)
+{
+    hal_ret_sts sts;
+    pcal6408a_dev *vdh_gex;
+    vdh_gex = (pcal6408a_dev*) hgpio_exp->ahw_gen_info.vdp_inst_hdle;
+    if(HAL_SCS == pcal6408a_port_update(vdh_gex,set_msk,clr_msk,tgl_msk))
+    {
+        sts = HAL_SCS;
+    }
+    else
+    {
+        sts = HAL_AH_DRIVER_ERR;
+    }
+    return sts;
+}
+
+/**
+ * @brief This API is used to read the state of the port
+ */
+hal_ret_sts ahw_vdp_gpio_exp_pcal6408a_readport(ahw_al_gpio_exp_hdle *hgpio_exp, uint8_t *port_ste)
+{
+    hal_ret_sts sts;
+    pcal6408a_dev *vdh_gex;
+    vdh_gex = (pcal6408a_dev*) hgpio_exp->ahw_gen_info.vdp_inst_hdle;
+    if(HAL_SCS == pcal6408a_read_port(vdh_gex,port_ste))
+    {
+        sts = HAL_SCS;
+    }
+    else
+    {
+        sts = HAL_AH_DRIVER_ERR;
+    }
+    return sts;
+}
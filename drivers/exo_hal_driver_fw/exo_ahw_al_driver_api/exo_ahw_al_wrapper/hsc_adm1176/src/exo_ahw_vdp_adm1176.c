@@ -28,7 +28,7 @@
 extern ahw_io_map *ahw_io_lookup_tble[MAX_AH_INST_ID];
 extern void *intf_inst_hdle_ptr[MAX_IO_INST_ID];
 
-#ifndef LINUX_TEMP_PORT
+#if !defined(LINUX_TEMP_PORT) || defined(LINUX_AHW_SIM)
 /*!
  *  @brief I2C read hook function for ADM1176 module
  */
@@ -73,7 +73,7 @@ int8_t adm1176_i2c_write(void* intf_hdl, uint16_t slv_addr, uint8_t *data, uint1
 hal_ret_sts ahw_vdp_hsc_adm1176_init(ahw_al_hsc_hdl *ahw_al_hsc)
 {
     hal_ret_sts sts = HAL_MAX_ERR;
-#ifdef LINUX_TEMP_PORT
+#if defined(LINUX_TEMP_PORT) && !defined(LINUX_AHW_SIM)
     printf("\n EXO Hot swap controller - AH-Vendor driver porting layer Initialise");
     printf("\n EXO Hot swap controller - AH-Vendor driver Initialise");
     printf("\n EXO Hot swap controller - AH-Vendor driver Initialisation completed successfully ");
@@ -103,7 +103,7 @@ hal_ret_sts ahw_vdp_hsc_adm1176_init(ahw_al_hsc_hdl *ahw_al_hsc)
     return sts;
 }
 
-#ifndef LINUX_TEMP_PORT
+#if !defined(LINUX_TEMP_PORT) || defined(LINUX_AHW_SIM)
 /*!
  *  @brief This API deinitializes the control block memory.
  */
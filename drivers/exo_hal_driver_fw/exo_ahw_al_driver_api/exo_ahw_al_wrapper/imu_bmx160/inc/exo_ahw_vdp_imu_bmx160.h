@@ -25,6 +25,11 @@
 #include "exo_hal_common.h"
 #include "exo_ahw_al_imu_common.h"
 #include "exo_io_al_i2c_common.h"
+
+#define BMX160_FIFO_SIZE                1024        ///< FIFO size in bytes
+#define BMX160_SENSORTIME_ODR_MAX       16          ///< ODR code at which a sample lasts one sensor time tick
+#define BMX160_SENSORTIME_MASK          0xFFFFFFU   ///< Sensor time is a 24 bit counter
+
 /**
  * @brief This API initializes the control block memory of IMU sensor
  * @param[in] ahw_al_himu - instance pointer of IMU sensor.
@@ -152,6 +157,30 @@ int8_t bmi160_i2c_read(ioal_i2c_hdle *hi2c, uint8_t dev_addr, uint8_t reg_addr,
  */
 int8_t bmi160_i2c_write(ioal_i2c_hdle *hi2c, uint8_t dev_addr, uint8_t reg_addr, uint8_t *data, uint16_t len);
 
+/**
+ * @brief This API starts the FIFO streaming in header mode with sensor time,
+ * the FIFO watermark interrupt is mapped to the INT1 pin
+ * @param[in] stream_cfg - pointer to a imu_fifo_stream_cfg structure
+ * @param[in] al_himu - instance pointer of IMU sensor.
+ * @retval hal_ret_sts - returns the success or error code
+ */
+hal_ret_sts ahw_vdp_imu_bmx160_fifo_stream_start(imu_fifo_stream_cfg *stream_cfg, ahw_al_imu_hdle *al_himu);
+
+/**
+ * @brief This API reads the FIFO content in a burst and extracts the samples
+ * @param[out] batch - pointer to a imu_fifo_batch structure
+ * @param[in] al_himu - instance pointer of IMU sensor.
+ * @retval hal_ret_sts - returns the success or error code, HAL_AH_NOT_READY when the streaming is not started
+ */
+hal_ret_sts ahw_vdp_imu_bmx160_fifo_stream_read(imu_fifo_batch *batch, ahw_al_imu_hdle *al_himu);
+
+/**
+ * @brief This API stops the FIFO streaming
+ * @param[in] al_himu - instance pointer of IMU sensor.
+ * @retval hal_ret_sts - returns the success or error code
+ */
+hal_ret_sts ahw_vdp_imu_bmx160_fifo_stream_stop(ahw_al_imu_hdle *al_himu);
+
 
 
 #endif /* _AHW_AL_IMU_BMX160_H_ */
@@ -19,15 +19,29 @@
  */
 
 #include <stdio.h>
+#include <string.h>
 #include <unistd.h>
 #include "exo_ahw_vdp_imu_bmx160.h"
 #include "bmx160.h"
 #include "exo_osal.h"
+#include "exo_osal_mem_management.h"
 
-struct bmi160_dev himu; ///< BMI 160 dev
 extern ahw_io_map *ahw_io_lookup_tble[MAX_AH_INST_ID]; ///< Hardware IO lookup table
 extern void *intf_inst_hdle_ptr[MAX_IO_INST_ID];   ///< Interface instance handle pointer
 struct bmi160_int_settg vdp_int_config; ///< BMI160 VDP interface configuration
+#if !defined(LINUX_TEMP_PORT) || defined(LINUX_AHW_SIM)
+#define VDP_IMU_FIFO_BUFF_SIZE (BMX160_FIFO_SIZE + BMI160_FIFO_BYTES_OVERREAD) ///< FIFO burst read buffer size
+
+/**
+ * @brief Vendor driver instance, the device comes first so the instance handle is also a bmi160_dev pointer
+ */
+typedef struct
+{
+    struct bmi160_dev dev; ///< BMI160 device
+    struct bmi160_fifo_frame fifo_frame; ///< BMI160 FIFO frame used in streaming mode
+    uint8_t fifo_buff[VDP_IMU_FIFO_BUFF_SIZE]; ///< FIFO burst read buffer
+}vdp_imu_bmx160_inst;
+#endif
 
 
 /**
@@ -43,7 +57,7 @@ void bmi160_interface_cfg(struct bmi160_dev *dev);
  */
 void delay(uint32_t period)
 {
-#ifndef LINUX_TEMP_PORT
+#if !defined(LINUX_TEMP_PORT) || defined(LINUX_AHW_SIM)
     os_delay(period);
 #endif
 }
@@ -64,16 +78,10 @@ void bmi160_interface_cfg(struct bmi160_dev *dev)
 int8_t bmi160_i2c_read(ioal_i2c_hdle *hi2c, uint8_t dev_addr, uint8_t reg_addr, uint8_t *data, uint16_t len)
 {
     int8_t rslt;
-    if(BMI160_OK == io_hal_i2c_transmit(hi2c, (uint16)dev_addr, &reg_addr, 1, 500))
+    /* Register address and data in one transfer with a repeated start */
+    if(HAL_SCS == io_hal_i2c_write_read(hi2c, (uint16)dev_addr, &reg_addr, 1, data, len, 500))
     {
-        if(BMI160_OK == io_hal_i2c_receive(hi2c, (uint16)dev_addr, data, len, 500))
-        {
-            rslt = BMI160_OK;
-        }
-        else
-        {
-            rslt = BMI160_E_COM_FAIL;
-        }
+        rslt = BMI160_OK;
     }
     else
     {
@@ -88,16 +96,17 @@ int8_t bmi160_i2c_read(ioal_i2c_hdle *hi2c, uint8_t dev_addr, uint8_t reg_addr,
 int8_t bmi160_i2c_write(ioal_i2c_hdle *hi2c, uint8_t dev_addr, uint8_t reg_addr, uint8_t *data, uint16_t len)
 {
     int8_t rslt;
-    if(BMI160_OK == io_hal_i2c_transmit(hi2c, (uint16)dev_addr, &reg_addr, 1, 500))
+    uint8_t data_send[16];
+    if(len > sizeof(data_send) - 1)
     {
-        if(BMI160_OK == io_hal_i2c_transmit(hi2c, (uint16)dev_addr, data, len, 500))
-        {
-            rslt = BMI160_OK;
-        }
-        else
-        {
-            rslt = BMI160_E_COM_FAIL;
-        }
+        return BMI160_E_READ_WRITE_LENGTH_INVALID;
+    }
+    /* The BMX160 takes the first byte after each start as the register address */
+    data_send[0] = reg_addr;
+    memcpy(&data_send[1], data, len);
+    if(HAL_SCS == io_hal_i2c_transmit(hi2c, (uint16)dev_addr, data_send, (uint16)(len + 1), 500))
+    {
+        rslt = BMI160_OK;
     }
     else
     {
@@ -112,7 +121,7 @@ int8_t bmi160_i2c_write(ioal_i2c_hdle *hi2c, uint8_t dev_addr, uint8_t reg_addr,
 hal_ret_sts ahw_vdp_imu_bmx160_init(ahw_al_imu_hdle *ahw_al_himu)
 {
     hal_ret_sts sts = HAL_MAX_ERR;
-#ifdef LINUX_TEMP_PORT
+#if defined(LINUX_TEMP_PORT) && !defined(LINUX_AHW_SIM)
     printf("\n EXO IMU - AH-Vendor driver porting layer Initialise");
     printf("\n EXO IMU - AH-Vendor driver Initialise");
     printf("\n EXO IMU - AH-Vendor driver Initialisation completed successfully ");
@@ -121,14 +130,17 @@ hal_ret_sts ahw_vdp_imu_bmx160_init(ahw_al_imu_hdle *ahw_al_himu)
 
 #else
 
-    himu.intf = BMI160_I2C_INTF;
-    himu.io_intf_hdle = intf_inst_hdle_ptr[ahw_io_lookup_tble[ahw_al_himu->ahw_gen_info.ahw_inst_id]->io_instance_id];
-    himu.id=ahw_io_lookup_tble[ahw_al_himu->ahw_gen_info.ahw_inst_id]->slv_addr;
-    bmi160_interface_cfg(&himu);
-    if(HAL_SCS == bmi160_init(&himu))
-    {
-        ahw_al_himu->ahw_gen_info.vdp_inst_hdle = (void*)&himu;
-        ahw_al_himu->ahw_gen_info.io_intf_hdle=himu.io_intf_hdle;
+    vdp_imu_bmx160_inst* inst=(vdp_imu_bmx160_inst*)os_malloc(sizeof(vdp_imu_bmx160_inst));
+    struct bmi160_dev* himu=&inst->dev;
+    memset(inst, 0, sizeof(vdp_imu_bmx160_inst));
+    himu->intf = BMI160_I2C_INTF;
+    himu->io_intf_hdle = intf_inst_hdle_ptr[ahw_io_lookup_tble[ahw_al_himu->ahw_gen_info.ahw_inst_id]->io_instance_id];
+    himu->id=ahw_io_lookup_tble[ahw_al_himu->ahw_gen_info.ahw_inst_id]->slv_addr;
+    bmi160_interface_cfg(himu);
+    if(HAL_SCS == bmi160_init(himu))
+    {
+        ahw_al_himu->ahw_gen_info.vdp_inst_hdle = (void*)himu;
+        ahw_al_himu->ahw_gen_info.io_intf_hdle=himu->io_intf_hdle;
         sts = HAL_SCS;
     }
     else
@@ -139,7 +151,7 @@ hal_ret_sts ahw_vdp_imu_bmx160_init(ahw_al_imu_hdle *ahw_al_himu)
     return sts;
 }
 
-#ifndef LINUX_TEMP_PORT
+#if !defined(LINUX_TEMP_PORT) || defined(LINUX_AHW_SIM)
 /**
  * @brief API to reset and restart the IMU sensor
  */
@@ -507,4 +519,157 @@ hal_ret_sts ahw_vdp_imu_bmx160_shock_detect_ste_cfg(imu_int_type_cfg *int_config
     }
     return sts;
 }
+
+/**
+ * @brief API to copy the samples of a FIFO batch and derive their sensor time
+ * from the sensor time of the newest frame, one sample period apart
+ */
+static void ahw_vdp_imu_bmx160_fifo_timestamp(imu_sensor_data *data, uint8 len, uint8 odr, uint32 sensortime)
+{
+    uint32 period;
+    uint8 idx;
+
+    /* Sensor time LSB is 39.0625 us, 256 ticks per sample at 100 Hz (odr 8) */
+    period = (odr <= BMX160_SENSORTIME_ODR_MAX) ? ((uint32)1 << (BMX160_SENSORTIME_ODR_MAX - odr)) : 1;
+    for(idx = 0; idx < len; idx++)
+    {
+        if(0 != sensortime)
+        {
+            data[idx].sensortime = (sensortime - ((uint32)(len - 1 - idx) * period)) & BMX160_SENSORTIME_MASK;
+        }
+        else
+        {
+            data[idx].sensortime = 0;
+        }
+    }
+}
+
+/**
+ * @brief API to start the FIFO streaming
+ */
+hal_ret_sts ahw_vdp_imu_bmx160_fifo_stream_start(imu_fifo_stream_cfg *stream_cfg, ahw_al_imu_hdle *al_himu)
+{
+    hal_ret_sts sts = HAL_AH_DRIVER_ERR;
+    struct bmi160_dev *vdh_imu;
+    vdp_imu_bmx160_inst *inst;
+    uint8_t fifo_cfg = BMI160_FIFO_HEADER | BMI160_FIFO_TIME;
+    uint16 frame_bytes = 1;
+    uint16 wm;
+
+    vdh_imu = (struct bmi160_dev*) al_himu->ahw_gen_info.vdp_inst_hdle;
+
+    if((IMU_ACCEL_ONLY == stream_cfg->sensor) || (IMU_BOTH_ACCEL_AND_GYRO == stream_cfg->sensor))
+    {
+        fifo_cfg |= BMI160_FIFO_ACCEL;
+        frame_bytes += BMI160_FIFO_A_LENGTH;
+    }
+    if((IMU_GYRO_ONLY == stream_cfg->sensor) || (IMU_BOTH_ACCEL_AND_GYRO == stream_cfg->sensor))
+    {
+        fifo_cfg |= BMI160_FIFO_GYRO;
+        frame_bytes += BMI160_FIFO_G_LENGTH;
+    }
+
+    /* Watermark level is in units of 4 bytes */
+    wm = (uint16)(((stream_cfg->watermark * frame_bytes) + 3) / 4);
+    if(wm > UINT8_MAX)
+    {
+        wm = UINT8_MAX;
+    }
+
+    inst = (vdp_imu_bmx160_inst*)vdh_imu;
+    inst->fifo_frame.data = inst->fifo_buff;
+    inst->fifo_frame.length = VDP_IMU_FIFO_BUFF_SIZE;
+    vdh_imu->fifo = &inst->fifo_frame;
+
+    ahw_vdp_imu_bmx160_default_intr_config();
+    vdp_int_config.int_type = BMI160_ACC_GYRO_FIFO_WATERMARK_INT;
+    vdp_int_config.fifo_wtm_int_en = BMI160_ENABLE;
+
+    if((1 != frame_bytes) &&
+       (BMI160_OK == bmi160_set_fifo_config(BMI160_FIFO_CONFIG_1_MASK, BMI160_DISABLE, vdh_imu)) &&
+       (BMI160_OK == bmi160_set_fifo_config(fifo_cfg, BMI160_ENABLE, vdh_imu)) &&
+       (BMI160_OK == bmi160_set_fifo_wm((uint8_t)wm, vdh_imu)) &&
+       (BMI160_OK == bmi160_set_fifo_flush(vdh_imu)) &&
+       (BMI160_OK == bmi160_set_int_config(&vdp_int_config, vdh_imu)))
+    {
+        sts = HAL_SCS;
+    }
+    return sts;
+}
+
+/**
+ * @brief API to read a batch of samples from the FIFO
+ */
+hal_ret_sts ahw_vdp_imu_bmx160_fifo_stream_read(imu_fifo_batch *batch, ahw_al_imu_hdle *al_himu)
+{
+    hal_ret_sts sts = HAL_AH_DRIVER_ERR;
+    struct bmi160_dev *vdh_imu;
+
+    vdh_imu = (struct bmi160_dev*) al_himu->ahw_gen_info.vdp_inst_hdle;
+    batch->accel_len = 0;
+    batch->gyro_len = 0;
+    batch->skipped_frames = 0;
+    batch->sensortime = 0;
+
+    if(NULL == vdh_imu->fifo)
+    {
+        sts = HAL_AH_NOT_READY;
+    }
+    else
+    {
+        /* Byte counter and the whole FIFO content in two register reads */
+        vdh_imu->fifo->length = VDP_IMU_FIFO_BUFF_SIZE;
+        if(BMI160_OK == bmi160_get_fifo_data(vdh_imu))
+        {
+            batch->accel_len = IMU_FIFO_FRAMES_MAX;
+            batch->gyro_len = IMU_FIFO_FRAMES_MAX;
+            if(vdh_imu->fifo->fifo_data_enable & BMI160_FIFO_A_ENABLE)
+            {
+                bmi160_extract_accel((struct bmi160_sensor_data*)batch->accel, &batch->accel_len, vdh_imu);
+            }
+            else
+            {
+                batch->accel_len = 0;
+            }
+            if(vdh_imu->fifo->fifo_data_enable & BMI160_FIFO_G_ENABLE)
+            {
+                bmi160_extract_gyro((struct bmi160_sensor_data*)batch->gyro, &batch->gyro_len, vdh_imu);
+            }
+            else
+            {
+                batch->gyro_len = 0;
+            }
+            batch->sensortime = vdh_imu->fifo->sensor_time;
+            batch->skipped_frames = vdh_imu->fifo->skipped_frame_count;
+
+            ahw_vdp_imu_bmx160_fifo_timestamp(batch->accel, batch->accel_len, vdh_imu->accel_cfg.odr, batch->sensortime);
+            ahw_vdp_imu_bmx160_fifo_timestamp(batch->gyro, batch->gyro_len, vdh_imu->gyro_cfg.odr, batch->sensortime);
+            sts = HAL_SCS;
+        }
+    }
+    return sts;
+}
+
+/**
+ * @brief API to stop the FIFO streaming
+ */
+hal_ret_sts ahw_vdp_imu_bmx160_fifo_stream_stop(ahw_al_imu_hdle *al_himu)
+{
+    hal_ret_sts sts = HAL_AH_DRIVER_ERR;
+    struct bmi160_dev *vdh_imu;
+
+    vdh_imu = (struct bmi160_dev*) al_himu->ahw_gen_info.vdp_inst_hdle;
+    ahw_vdp_imu_bmx160_default_intr_config();
+    vdp_int_config.int_type = BMI160_ACC_GYRO_FIFO_WATERMARK_INT;
+    vdp_int_config.fifo_wtm_int_en = BMI160_DISABLE;
+
+    if((BMI160_OK == bmi160_set_int_config(&vdp_int_config, vdh_imu)) &&
+       (BMI160_OK == bmi160_set_fifo_config(BMI160_FIFO_CONFIG_1_MASK, BMI160_DISABLE, vdh_imu)) &&
+       (BMI160_OK == bmi160_set_fifo_flush(vdh_imu)))
+    {
+        sts = HAL_SCS;
+    }
+    vdh_imu->fifo = NULL;
+    return sts;
+}
 #endif
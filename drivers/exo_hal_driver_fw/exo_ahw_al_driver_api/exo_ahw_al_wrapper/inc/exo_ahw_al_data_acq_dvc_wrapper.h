@@ -23,6 +23,13 @@
 
 #include "exo_ahw_vdp_data_acq_dvc_ads7828.h"
 
+/**
+ * @brief Mapping function to initialize the data acquisition device
+ * @param[in] al_ads7828 - instance pointer of data acquisition device
+ * @retval hal_ret_sts - returns the success or error code
+ */
+hal_ret_sts ahw_al_common_ads7828_init(ahw_al_ads7828_hdle *al_ads7828);
+
 /**
  * @brief Mapping function to get the data from the specified channel number
  * @param[in] al_ads7828 - instance pointer of data acquisition device
@@ -33,5 +40,16 @@
  */
 hal_ret_sts ahw_al_common_ads7828_get_data(ahw_al_ads7828_hdle *al_ads7828,ahw_al_ads7828_chnl chnl,ahw_al_ads7828_pd_sel pd_opt,uint16_t* data);
 
+/**
+ * @brief Mapping function to scan the single ended channels
+ * @param[in] al_ads7828 - instance pointer of data acquisition device
+ * @param[in] chnl_mask - bit n selects single ended channel n
+ * @param[in] pd_opt - power down option after the scan
+ * @param[out] samples - pointer to the samples
+ * @param[out] count - number of samples
+ * @retval hal_ret_sts - returns the success or error code
+ */
+hal_ret_sts ahw_al_common_ads7828_scan(ahw_al_ads7828_hdle *al_ads7828,uint8_t chnl_mask,ahw_al_ads7828_pd_sel pd_opt,ahw_al_ads7828_sample* samples,uint8_t* count);
+
 
 #endif
@@ -172,6 +172,40 @@ hal_ret_sts ahw_al_dt_common_get_temperature_high_thrshd(ahw_al_dt_hdle *al_dt,d
  */
 hal_ret_sts ahw_al_dt_common_reset_alert_flag(ahw_al_dt_hdle *al_dt);
 
+/**
+ * @brief Mapping API to read the temperature in milli degree celsius
+ * @param[in]  al_dt - instance pointer of digital thermostat
+ * @param[out] temp_mdeg - temperature in milli degree celsius
+ * @retval hal_ret_sts - returns the success or error code
+ */
+hal_ret_sts ahw_al_dt_common_get_temperature_mdeg (ahw_al_dt_hdle *al_dt, int32_t* temp_mdeg);
+
+/**
+ * @brief Mapping API to configure the alert driven sampling
+ * @param[in]  al_dt - instance pointer of digital thermostat
+ * @param[in]  low_mdeg - low temperature threshold in milli degree celsius
+ * @param[in]  high_mdeg - high temperature threshold in milli degree celsius
+ * @param[in]  hb_ms - heartbeat period in mS, 0 reads on alert only
+ * @retval hal_ret_sts - returns the success or error code
+ */
+hal_ret_sts ahw_al_dt_common_alert_cfg (ahw_al_dt_hdle *al_dt, int32_t low_mdeg, int32_t high_mdeg, uint32_t hb_ms);
+
+/**
+ * @brief Mapping API to report an alert
+ * @param[in]  al_dt - instance pointer of digital thermostat
+ * @retval hal_ret_sts - returns the success or error code
+ */
+hal_ret_sts ahw_al_dt_common_alert_notify (ahw_al_dt_hdle *al_dt);
+
+/**
+ * @brief Mapping API to get the temperature in alert mode
+ * @param[in]  al_dt - instance pointer of digital thermostat
+ * @param[in]  now_ms - current time in mS
+ * @param[out] temp_mdeg - temperature in milli degree celsius
+ * @param[out] alert_sts - alert flags read by this poll
+ * @retval hal_ret_sts - returns the success or error code
+ */
+hal_ret_sts ahw_al_dt_common_alert_poll (ahw_al_dt_hdle *al_dt, uint32_t now_ms, int32_t* temp_mdeg, uint8_t* alert_sts);
 
 
 
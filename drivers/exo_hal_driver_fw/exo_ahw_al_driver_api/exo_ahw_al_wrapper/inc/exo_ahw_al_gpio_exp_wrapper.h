@@ -147,4 +147,22 @@ hal_ret_sts ahw_al_gpio_exp_common_set_port_cfg(ahw_al_gpio_exp_hdle *hgpio_exp,
  * @retval zero -> Success / -ve value -> Error.
  */
 hal_ret_sts ahw_al_gpio_exp_common_isr_hdlr(ahw_al_gpio_exp_hdle *hgpio_exp);
+
+/**
+ * @brief Mapping API to update the output state of the port in one write
+ * @param[in] hgpio_exp : Structure instance of gpio_exp_hdl.
+ * @param[in] set_msk : pins to be driven high
+ * @param[in] clr_msk : pins to be driven low
+ * @param[in] tgl_msk : pins to be toggled
+ * @retval zero -> Success / -ve value -> Error.
+ */
+hal_ret_sts ahw_al_gpio_exp_common_port_update(ahw_al_gpio_exp_hdle *hgpio_exp, uint8_t set_msk, uint8_t clr_msk, uint8_t tgl_msk);
+
+/**
+ * @brief Mapping API to read the state of the port
+ * @param[in] hgpio_exp : Structure instance of gpio_exp_hdl.
+ * @param[out] port_ste : state of all the pins
+ * @retval zero -> Success / -ve value -> Error.
+ */
+hal_ret_sts ahw_al_gpio_exp_common_readport(ahw_al_gpio_exp_hdle *hgpio_exp, uint8_t *port_ste);
 #endif /* _AHW_AL_WRAPPER_H_ */
@@ -241,6 +241,14 @@ uint32_t ahw_al_psm_common_get_power(ahw_al_psm_hdle *hpsm);
  */
 float ahw_al_psm_common_get_current(ahw_al_psm_hdle *hpsm);
 
+/**
+ * @brief Mapping function to get the measurement snapshot.
+ * @param[in] hpsm 	: structure handle of power sense monitor.
+ * @param[out] snapshot : measured values
+ * @retval	hal_ret_sts - returns the success or error code
+ */
+hal_ret_sts ahw_al_psm_common_get_snapshot(ahw_al_psm_hdle *hpsm, ahw_al_psm_snapshot_t *snapshot);
+
 /**
  * @brief  Mapping function to read the designed flag value
  * @param  Slave_Address on communication Bus from power Monitor Device structure.
@@ -201,4 +201,40 @@ hal_ret_sts ahw_al_ts_common_get_celsius(ahw_al_temp_sensor_hdl *al_ts_h,float*
  * @retval hal_ret_sts		:returns the success or error code
  */
 hal_ret_sts ahw_al_ts_common_read_manufacture_id(ahw_al_temp_sensor_hdl *al_ts_h,int16_t* temperature);
+/**
+ * @brief Mapping API to get the Temperature value in milli degree celsius.
+ * @param[in] al_ts_h 		: structure handle of Ahw Al temperature sensor handle.
+ * @param[out]temp_mdeg 	: temperature value in milli degree celsius.
+ * @retval hal_ret_sts		:returns the success or error code
+ */
+hal_ret_sts ahw_al_ts_common_get_temperature_mdeg(ahw_al_temp_sensor_hdl *al_ts_h,int32_t *temp_mdeg);
+
+/**
+ * @brief Mapping API to configure the alert driven sampling.
+ * @param[in] al_ts_h 		: structure handle of Ahw Al temperature sensor handle.
+ * @param[in] low_mdeg 		: low limit in milli degree celsius.
+ * @param[in] high_mdeg 		: high limit in milli degree celsius.
+ * @param[in] crit_mdeg 		: critical limit in milli degree celsius.
+ * @param[in] hb_ms 		: heartbeat period in mS, 0 reads on alert only.
+ * @retval hal_ret_sts		:returns the success or error code
+ */
+hal_ret_sts ahw_al_ts_common_alert_cfg(ahw_al_temp_sensor_hdl *al_ts_h,int32_t low_mdeg,int32_t high_mdeg,int32_t crit_mdeg,uint32_t hb_ms);
+
+/**
+ * @brief Mapping API to report an alert.
+ * @param[in] al_ts_h 		: structure handle of Ahw Al temperature sensor handle.
+ * @retval hal_ret_sts		:returns the success or error code
+ */
+hal_ret_sts ahw_al_ts_common_alert_notify(ahw_al_temp_sensor_hdl *al_ts_h);
+
+/**
+ * @brief Mapping API to get the temperature in alert mode.
+ * @param[in] al_ts_h 		: structure handle of Ahw Al temperature sensor handle.
+ * @param[in] now_ms 		: current time in mS.
+ * @param[out]temp_mdeg 	: temperature value in milli degree celsius.
+ * @param[out]alert_sts 	: alert flags read by this poll.
+ * @retval hal_ret_sts		:returns the success or error code
+ */
+hal_ret_sts ahw_al_ts_common_alert_poll(ahw_al_temp_sensor_hdl *al_ts_h,uint32_t now_ms,int32_t *temp_mdeg,uint8_t *alert_sts);
+
 #endif /* _AHW_AL_WRAPPER_H_ */
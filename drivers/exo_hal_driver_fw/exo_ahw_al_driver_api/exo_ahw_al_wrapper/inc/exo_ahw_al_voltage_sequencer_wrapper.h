@@ -124,6 +124,14 @@ hal_ret_sts ahw_al_vsm_common_get_fw_version(ahw_al_vsm_hdle *al_vsm, uint8_t* v
  */
 hal_ret_sts ahw_al_vsm_common_get_voltage(ahw_al_vsm_hdle *al_vsm, vltg_seq_rail_cfg* rail_info, float *voltage);
 
+/**
+ * @brief Mapping API to get voltage of all rails
+ * @param[in]  al_vsm - AHAL instance pointer of voltage sequencer
+ * @param[out]  snapshot - ADC counts and voltages of all rails
+ * @retval hal_ret_sts - returns the success or error code
+ */
+hal_ret_sts ahw_al_vsm_common_get_all_voltages(ahw_al_vsm_hdle *al_vsm, vltg_seq_rail_snapshot* snapshot);
+
 /**
  * @brief Mapping API to get alarm pending status
  * @param[in]  al_vsm - AHAL instance pointer of voltage sequencer
@@ -132,4 +132,27 @@ hal_ret_sts ahw_al_imu_common_freefall_detect_ste_cfg(imu_int_type_cfg *int_conf
  */
 hal_ret_sts ahw_al_imu_common_shock_detect_ste_cfg(imu_int_type_cfg *int_config, ahw_al_imu_hdle *himu);
 
+/**
+ * @brief Mapping API to start the FIFO streaming
+ * @param[in] himu - AHAL instance pointer of IMU sensor.
+ * @param[in] stream_cfg - pointer to a imu_fifo_stream_cfg structure
+ * @retval hal_ret_sts - returns the success or error code
+ */
+hal_ret_sts ahw_al_imu_common_fifo_stream_start(imu_fifo_stream_cfg *stream_cfg, ahw_al_imu_hdle *himu);
+
+/**
+ * @brief Mapping API to read a batch of samples from the FIFO
+ * @param[in] himu - AHAL instance pointer of IMU sensor.
+ * @param[out] batch - pointer to a imu_fifo_batch structure
+ * @retval hal_ret_sts - returns the success or error code
+ */
+hal_ret_sts ahw_al_imu_common_fifo_stream_read(imu_fifo_batch *batch, ahw_al_imu_hdle *himu);
+
+/**
+ * @brief Mapping API to stop the FIFO streaming
+ * @param[in] himu - AHAL instance pointer of IMU sensor.
+ * @retval hal_ret_sts - returns the success or error code
+ */
+hal_ret_sts ahw_al_imu_common_fifo_stream_stop(ahw_al_imu_hdle *himu);
+
 #endif /* _AHW_AL_WRAPPER_H_ */
@@ -239,6 +239,14 @@ uint32_t ahw_vdp_psm_ina230_get_power(ahw_al_psm_hdle *hpsm);
  */
 float ahw_vdp_psm_ina230_get_current(ahw_al_psm_hdle *hpsm);
 
+/**
+ * @brief API to get the measurement snapshot.
+ * @param[in] hpsm 	: structure handle of power sense monitor.
+ * @param[out] snapshot : measured values
+ * @retval	hal_ret_sts - HAL_AH_NOT_READY when no conversion completed since the last read
+ */
+hal_ret_sts ahw_vdp_psm_ina230_get_snapshot(ahw_al_psm_hdle *hpsm, ahw_al_psm_snapshot_t *snapshot);
+
 /**
  * @brief  API to read the designed flag value
  * @param  Slave_Address on communication Bus from power Monitor Device structure.
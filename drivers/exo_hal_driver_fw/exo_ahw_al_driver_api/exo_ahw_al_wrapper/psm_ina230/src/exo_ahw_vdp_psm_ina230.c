@@ -51,7 +51,7 @@ ina230_convert_time_config_t vdh_tc_cfg;
  */
 ina230_alertpinconfig_t vdh_alert_pin_cfg;
 
-#ifndef LINUX_TEMP_PORT
+#if !defined(LINUX_TEMP_PORT) || defined(LINUX_AHW_SIM)
 /**
  * @brief This API is used for i2c read.
  */
@@ -103,6 +103,39 @@ uint8_t ina230_i2c_write(void* intf_hdl, uint16_t slv_addr, uint8_t reg_addr, ui
     }
     return rslt;
 }
+
+/**
+ * @brief This API is used for reading several registers in one i2c transfer.
+ */
+uint8_t ina230_i2c_read_regs(void* intf_hdl, uint16_t slv_addr, const uint8_t *reg_addr, uint8_t *data, uint16_t count)
+{
+    ioal_i2c_hdle *hi2c = (ioal_i2c_hdle*)intf_hdl;
+    iohal_i2c_xfer xfer[INA230_READ_REGS_MAX];
+    int8_t rslt;
+    uint16_t i;
+
+    if(count > INA230_READ_REGS_MAX)
+    {
+        return INA230_E_COM_FAIL;
+    }
+    for(i = 0; i < count; i++)
+    {
+        xfer[i].addr = (uint16)slv_addr;
+        xfer[i].wr_data = (uint8*)&reg_addr[i];
+        xfer[i].wr_size = 1;
+        xfer[i].rd_data = &data[2 * i];
+        xfer[i].rd_size = 2;
+    }
+    if(HAL_SCS == io_hal_i2c_transfer(hi2c, xfer, count, 500))
+    {
+        rslt = INA230_SCS;
+    }
+    else
+    {
+        rslt =INA230_E_COM_FAIL;
+    }
+    return rslt;
+}
 #endif
 
 /**
@@ -112,7 +145,7 @@ uint8_t ina230_i2c_write(void* intf_hdl, uint16_t slv_addr, uint8_t reg_addr, ui
 hal_ret_sts   ahw_vdp_psm_ina230_init(ahw_al_psm_hdle *hpsm,ahw_al_psm_tc_config_t *hpsm_tc_cfg)
 {
     hal_ret_sts sts = HAL_MAX_ERR;
-#ifdef LINUX_TEMP_PORT
+#if defined(LINUX_TEMP_PORT) && !defined(LINUX_AHW_SIM)
     printf("\n EXO PSM - AH-Vendor driver porting layer Initialize");
     printf("\n EXO PSM - AH-Vendor driver Initialize");
     printf("\n EXO PSM - AH-Vendor driver Initialization completed successfully ");
@@ -123,6 +156,7 @@ hal_ret_sts   ahw_vdp_psm_ina230_init(ahw_al_psm_hdle *hpsm,ahw_al_psm_tc_config
     psm_ina230_dev_t* vdh_psm=(psm_ina230_dev_t*)os_malloc(sizeof(psm_ina230_dev_t));
     vdh_psm->write = ina230_i2c_write;
     vdh_psm->read = ina230_i2c_read;
+    vdh_psm->read_regs = ina230_i2c_read_regs;
     vdh_psm->io_intf_hdle = intf_inst_hdle_ptr[ahw_io_lookup_tble[hpsm->ahw_gen_info.ahw_inst_id]->io_instance_id];
     vdh_psm->slave_address=ahw_io_lookup_tble[hpsm->ahw_gen_info.ahw_inst_id]->slv_addr;
     vdh_psm->current_threshold=hpsm->current_threshold;
@@ -151,7 +185,7 @@ hal_ret_sts   ahw_vdp_psm_ina230_init(ahw_al_psm_hdle *hpsm,ahw_al_psm_tc_config
 hal_ret_sts    ahw_vdp_psm_ina230_deinit(ahw_al_psm_hdle *hpsm)
 {
     hal_ret_sts sts = HAL_MAX_ERR;
-#ifdef LINUX_TEMP_PORT
+#if defined(LINUX_TEMP_PORT) && !defined(LINUX_AHW_SIM)
     printf("\n EXO PSM - AH-Vendor driver porting layer de-Initialize");
     printf("\n EXO PSM - AH-Vendor driver de-Initialize");
     printf("\n EXO PSM - AH-Vendor driver de-Initialization completed successfully ");
@@ -176,7 +210,7 @@ hal_ret_sts    ahw_vdp_psm_ina230_deinit(ahw_al_psm_hdle *hpsm)
     return sts;
 }
 
-#ifndef LINUX_TEMP_PORT
+#if !defined(LINUX_TEMP_PORT) || defined(LINUX_AHW_SIM)
 /**
  * @brief API to read the INA230 die identifier
  *
@@ -631,6 +665,37 @@ float ahw_vdp_psm_ina230_get_current(ahw_al_psm_hdle *hpsm)
     return sts;
 }
 
+/**
+ * @brief API to read the measurement snapshot
+ *
+ */
+hal_ret_sts ahw_vdp_psm_ina230_get_snapshot(ahw_al_psm_hdle *hpsm, ahw_al_psm_snapshot_t *snapshot)
+{
+    hal_ret_sts sts;
+    e_ina230_sts rslt;
+    ina230_snapshot_t vdh_snapshot;
+    psm_ina230_dev_t *vdh_psm;
+    vdh_psm = (psm_ina230_dev_t*) hpsm->ahw_gen_info.vdp_inst_hdle;
+    rslt = ina230_get_snapshot(vdh_psm, &vdh_snapshot);
+    if(INA230_SCS == rslt)
+    {
+        snapshot->vshunt = vdh_snapshot.vshunt;
+        snapshot->vbus = vdh_snapshot.vbus;
+        snapshot->power = vdh_snapshot.power;
+        snapshot->current = vdh_snapshot.current;
+        sts = HAL_SCS;
+    }
+    else if(INA230_E_NOT_READY == rslt)
+    {
+        sts = HAL_AH_NOT_READY;
+    }
+    else
+    {
+        sts = HAL_AH_DRIVER_ERR;
+    }
+    return sts;
+}
+
 /**
  * @brief API to read the designed flag value
  *
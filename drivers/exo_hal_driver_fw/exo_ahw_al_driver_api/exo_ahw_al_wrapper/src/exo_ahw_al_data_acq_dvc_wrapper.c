@@ -22,7 +22,24 @@
 #include "exo_ahw_vdp_data_acq_dvc_ads7828.h"
 #include "exo_ahw_al_data_acq_dvc_wrapper.h"
 
-#ifndef LINUX_TEMP_PORT
+#if !defined(LINUX_TEMP_PORT) || defined(LINUX_AHW_SIM)
+/*!
+ *  @brief Mapping API to initialize the data acquisition device
+ */
+hal_ret_sts ahw_al_common_ads7828_init(ahw_al_ads7828_hdle *al_ads7828)
+{
+    hal_ret_sts sts;
+    switch(al_ads7828->ahw_gen_info.ahw_inst_id)
+    {
+        case DATA_LOGGER_ADS7828_PS:
+            sts = ahw_vdp_ads7828_init(al_ads7828);
+            break;
+        default:
+            sts = HAL_AH_INVLD_INST_ID;
+    }
+    return sts;
+}
+
 /*!
  *  @brief Mapping API to get the data from specified channel
  */
@@ -39,4 +56,21 @@ hal_ret_sts ahw_al_common_ads7828_get_data(ahw_al_ads7828_hdle *al_ads7828,ahw_a
     }
     return sts;
 }
+
+/*!
+ *  @brief Mapping API to scan the single ended channels
+ */
+hal_ret_sts ahw_al_common_ads7828_scan(ahw_al_ads7828_hdle *al_ads7828,uint8_t chnl_mask,ahw_al_ads7828_pd_sel pd_opt,ahw_al_ads7828_sample* samples,uint8_t* count)
+{
+    hal_ret_sts sts;
+    switch(al_ads7828->ahw_gen_info.ahw_inst_id)
+    {
+        case DATA_LOGGER_ADS7828_PS:
+            sts = ahw_vdp_ads7828_scan(al_ads7828,chnl_mask,pd_opt,samples,count);
+            break;
+        default:
+            sts = HAL_AH_INVLD_INST_ID;
+    }
+    return sts;
+}
 #endif
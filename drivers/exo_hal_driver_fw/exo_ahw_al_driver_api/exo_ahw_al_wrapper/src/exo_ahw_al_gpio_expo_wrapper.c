@@ -361,3 +361,51 @@ hal_ret_sts ahw_al_gpio_exp_common_isr_hdlr(ahw_al_gpio_exp_hdle *hgpio_exp)
     }
     return sts;
 }
+
+/**
+ * @brief Mapping API to update the output state of the port
+ */
+hal_ret_sts ahw_al_gpio_exp_common_port_update(ahw_al_gpio_exp_hdle *hgpio_exp, uint8_t set_msk, uint8_t clr_msk, uint8_t tgl_msk)
+{
+    hal_ret_sts sts;
+    switch(hgpio_exp->ahw_gen_info.ahw_inst_id)
+    {
+        case  GPIO_EXPANDER_PCAL6408A_PS:
+            sts = ahw_vdp_gpio_exp_pcal6408a_port_update(hgpio_exp,set_msk,clr_msk,tgl_msk);
+            break;
+        case GPIO_EXPANDER_MCP23008_EDGE_1:
+        case GPIO_EXPANDER_MCP23008_EDGE_2:
+        case GPIO_EXPANDER_MCP23008_GPS:
+        case GPIO_EXPANDER_MCP23008_OBC_1:
+        case GPIO_EXPANDER_MCP23008_OBC_2:
+            sts = ahw_vdp_mcp23008_port_update(hgpio_exp,set_msk,clr_msk,tgl_msk);
+            break;
+        default:
+            sts = HAL_AH_INVLD_INST_ID;
+    }
+    return sts;
+}
+
+/**
+ * @brief Mapping API is used to read the state of the port
+ */
+hal_ret_sts ahw_al_gpio_exp_common_readport(ahw_al_gpio_exp_hdle *hgpio_exp, uint8_t *port_ste)
+{
+    hal_ret_sts sts;
+    switch(hgpio_exp->ahw_gen_info.ahw_inst_id)
+    {
+        case  GPIO_EXPANDER_PCAL6408A_PS:
+            sts = ahw_vdp_gpio_exp_pcal6408a_readport(hgpio_exp,port_ste);
+            break;
+        case GPIO_EXPANDER_MCP23008_EDGE_1:
+        case GPIO_EXPANDER_MCP23008_EDGE_2:
+        case GPIO_EXPANDER_MCP23008_GPS:
+        case GPIO_EXPANDER_MCP23008_OBC_1:
+        case GPIO_EXPANDER_MCP23008_OBC_2:
+            sts = ahw_vdp_mcp23008_read_port(hgpio_exp,port_ste);
+            break;
+        default:
+            sts = HAL_AH_INVLD_INST_ID;
+    }
+    return sts;
+}
@@ -42,7 +42,7 @@ hal_ret_sts ahw_al_hsc_common_init(ahw_al_hsc_hdl *ahw_al_hsc)
     return sts;
 }
 
-#ifndef LINUX_TEMP_PORT
+#if !defined(LINUX_TEMP_PORT) || defined(LINUX_AHW_SIM)
 /*!
  *  @brief Mapping API to deinitializes the control block memory
  *
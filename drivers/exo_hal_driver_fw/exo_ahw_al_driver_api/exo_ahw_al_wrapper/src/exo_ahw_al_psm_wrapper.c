@@ -61,7 +61,7 @@ hal_ret_sts  ahw_al_psm_common_deinit(ahw_al_psm_hdle *hpsm)
     return sts;
 }
 
-#ifndef LINUX_TEMP_PORT
+#if !defined(LINUX_TEMP_PORT) || defined(LINUX_AHW_SIM)
 /**
  * @brief Mapping API  read the power sense monitor die identifier
  *
@@ -520,6 +520,26 @@ float ahw_al_psm_common_get_current(ahw_al_psm_hdle *hpsm)
     return sts;
 }
 
+/**
+ * @brief Mapping API read the measurement snapshot
+ *
+ */
+hal_ret_sts ahw_al_psm_common_get_snapshot(ahw_al_psm_hdle *hpsm, ahw_al_psm_snapshot_t *snapshot)
+{
+    hal_ret_sts sts;
+    switch(hpsm->ahw_gen_info.ahw_inst_id)
+    {
+        case  PSM_INA230_PS:
+        case PSM_INA230_OBC:
+            sts = ahw_vdp_psm_ina230_get_snapshot(hpsm, snapshot);
+            break;
+        default:
+            sts = HAL_AH_INVLD_INST_ID;
+            break;
+    }
+    return sts;
+}
+
 /**
  * @brief Mapping API read the designed flag value
  *
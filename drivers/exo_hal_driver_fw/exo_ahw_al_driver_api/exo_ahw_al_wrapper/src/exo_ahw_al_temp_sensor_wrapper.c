@@ -65,7 +65,7 @@ hal_ret_sts ahw_al_ts_common_deinit(ahw_al_temp_sensor_hdl *al_ts_h)
     return sts;
 }
 
-#ifndef LINUX_TEMP_PORT
+#if !defined(LINUX_TEMP_PORT) || defined(LINUX_AHW_SIM)
 /**
  * @brief Mapping API configure Temperature Sensor
  *
@@ -464,4 +464,85 @@ hal_ret_sts ahw_al_ts_common_read_manufacture_id(ahw_al_temp_sensor_hdl *al_ts_h
     }
     return sts;
 }
+
+/*!
+ *  @brief Mapping API to get the temperature in milli degree celsius
+ */
+hal_ret_sts ahw_al_ts_common_get_temperature_mdeg(ahw_al_temp_sensor_hdl *al_ts_h,int32_t *temp_mdeg)
+{
+    hal_ret_sts sts;
+    switch(al_ts_h->ahw_gen_info.ahw_inst_id)
+    {
+        case TEMP_SENSOR_MCP9843_PS:
+        case TEMP_SENSOR_MCP9843_OBC:
+        case TEMP_SENSOR_MCP9843_EDGE:
+        case TEMP_SENSOR_MCP9843_GPS:
+            sts = ahw_vdp_ts_mcp9843_get_temperature_mdeg(al_ts_h,temp_mdeg);
+            break;
+        default:
+            sts = HAL_AH_INVLD_INST_ID;
+    }
+    return sts;
+}
+
+/*!
+ *  @brief Mapping API to configure the alert driven sampling
+ */
+hal_ret_sts ahw_al_ts_common_alert_cfg(ahw_al_temp_sensor_hdl *al_ts_h,int32_t low_mdeg,int32_t high_mdeg,int32_t crit_mdeg,uint32_t hb_ms)
+{
+    hal_ret_sts sts;
+    switch(al_ts_h->ahw_gen_info.ahw_inst_id)
+    {
+        case TEMP_SENSOR_MCP9843_PS:
+        case TEMP_SENSOR_MCP9843_OBC:
+        case TEMP_SENSOR_MCP9843_EDGE:
+        case TEMP_SENSOR_MCP9843_GPS:
+            sts = ahw_vdp_ts_mcp9843_alert_cfg(al_ts_h,low_mdeg,high_mdeg,crit_mdeg,hb_ms);
+            break;
+        default:
+            sts = HAL_AH_INVLD_INST_ID;
+    }
+    return sts;
+}
+
+/*!
+ *  @brief Mapping API to report an alert of temperature sensor
+ */
+hal_ret_sts ahw_al_ts_common_alert_notify(ahw_al_temp_sensor_hdl *al_ts_h)
+{
+    hal_ret_sts sts;
+    switch(al_ts_h->ahw_gen_info.ahw_inst_id)
+    {
+        case TEMP_SENSOR_MCP9843_PS:
+        case TEMP_SENSOR_MCP9843_OBC:
+        case TEMP_SENSOR_MCP9843_EDGE:
+        case TEMP_SENSOR_MCP9843_GPS:
+            sts = ahw_vdp_ts_mcp9843_alert_notify(al_ts_h);
+            break;
+        default:
+            sts = HAL_AH_INVLD_INST_ID;
+    }
+    return sts;
+}
+
+/*!
+ *  @brief Mapping API to get the temperature in alert mode
+ */
+hal_ret_sts ahw_al_ts_common_alert_poll(ahw_al_temp_sensor_hdl *al_ts_h,uint32_t now_ms,int32_t *temp_mdeg,uint8_t *alert_sts)
+{
+    hal_ret_sts sts;
+    switch(al_ts_h->ahw_gen_info.ahw_inst_id)
+    {
+        case TEMP_SENSOR_MCP9843_PS:
+        case TEMP_SENSOR_MCP9843_OBC:
+        case TEMP_SENSOR_MCP9843_EDGE:
+        case TEMP_SENSOR_MCP9843_GPS:
+            sts = ahw_vdp_ts_mcp9843_alert_poll(al_ts_h,now_ms,temp_mdeg,alert_sts);
+            break;
+        default:
+            sts = HAL_AH_INVLD_INST_ID;
+    }
+    return sts;
+}
+
 #endif
@@ -39,7 +39,7 @@ hal_ret_sts ahw_al_vsm_common_init(ahw_al_vsm_hdle *hvsm)
     return sts;
 }
 
-#ifndef LINUX_TEMP_PORT
+#if !defined(LINUX_TEMP_PORT) || defined(LINUX_AHW_SIM)
 /*!
  *  @brief Mapping API to configure the rail of voltage sequencer
  */
@@ -228,6 +228,23 @@ hal_ret_sts ahw_al_vsm_common_get_voltage(ahw_al_vsm_hdle *hvsm, vltg_seq_rail_c
     return sts;
 }
 
+/*!
+ *  @brief Mapping API to get voltage of all rails
+ */
+hal_ret_sts ahw_al_vsm_common_get_all_voltages(ahw_al_vsm_hdle *hvsm, vltg_seq_rail_snapshot* snapshot)
+{
+    hal_ret_sts sts;
+    switch(hvsm->ahw_gen_info.ahw_inst_id)
+    {
+        case VOLTAGE_SEQUENCER_UCD9801_OBC:
+            sts = ahw_vdp_vsm_ucd9081_get_all_voltages(hvsm,snapshot);
+            break;
+        default:
+            sts = HAL_AH_INVLD_INST_ID;
+    }
+    return sts;
+}
+
 /*!
  *  @brief Mapping API to get alarm pending status
  */
@@ -41,7 +41,7 @@ hal_ret_sts ahw_al_dt_common_init(ahw_al_dt_hdle *al_dt)
     return sts;
 }
 
-#ifndef LINUX_TEMP_PORT
+#if !defined(LINUX_TEMP_PORT) || defined(LINUX_AHW_SIM)
 /*!
  *  @brief Mapping API to deinitializes the control block memory
  */
@@ -367,4 +367,76 @@ hal_ret_sts ahw_al_dt_common_reset_alert_flag(ahw_al_dt_hdle *al_dt)
     return sts;
 }
 
+/*!
+ *  @brief Mapping API to read the temperature in milli degree celsius
+ */
+hal_ret_sts ahw_al_dt_common_get_temperature_mdeg (ahw_al_dt_hdle *al_dt, int32_t* temp_mdeg)
+{
+    hal_ret_sts sts;
+    switch(al_dt->ahw_gen_info.ahw_inst_id)
+    {
+        case DIGITAL_THERMOSTAT_DS620_EDGE:
+        case DIGITAL_THERMOSTAT_DS620_PS:
+            sts = ahw_vdp_dt_ds620_get_temperature_mdeg(al_dt,temp_mdeg);
+            break;
+        default:
+            sts = HAL_AH_INVLD_INST_ID;
+    }
+    return sts;
+}
+
+/*!
+ *  @brief Mapping API to configure the alert driven sampling
+ */
+hal_ret_sts ahw_al_dt_common_alert_cfg (ahw_al_dt_hdle *al_dt, int32_t low_mdeg, int32_t high_mdeg, uint32_t hb_ms)
+{
+    hal_ret_sts sts;
+    switch(al_dt->ahw_gen_info.ahw_inst_id)
+    {
+        case DIGITAL_THERMOSTAT_DS620_EDGE:
+        case DIGITAL_THERMOSTAT_DS620_PS:
+            sts = ahw_vdp_dt_ds620_alert_cfg(al_dt,low_mdeg,high_mdeg,hb_ms);
+            break;
+        default:
+            sts = HAL_AH_INVLD_INST_ID;
+    }
+    return sts;
+}
+
+/*!
+ *  @brief Mapping API to report an alert of digital thermostat
+ */
+hal_ret_sts ahw_al_dt_common_alert_notify (ahw_al_dt_hdle *al_dt)
+{
+    hal_ret_sts sts;
+    switch(al_dt->ahw_gen_info.ahw_inst_id)
+    {
+        case DIGITAL_THERMOSTAT_DS620_EDGE:
+        case DIGITAL_THERMOSTAT_DS620_PS:
+            sts = ahw_vdp_dt_ds620_alert_notify(al_dt);
+            break;
+        default:
+            sts = HAL_AH_INVLD_INST_ID;
+    }
+    return sts;
+}
+
+/*!
+ *  @brief Mapping API to get the temperature in alert mode
+ */
+hal_ret_sts ahw_al_dt_common_alert_poll (ahw_al_dt_hdle *al_dt, uint32_t now_ms, int32_t* temp_mdeg, uint8_t* alert_sts)
+{
+    hal_ret_sts sts;
+    switch(al_dt->ahw_gen_info.ahw_inst_id)
+    {
+        case DIGITAL_THERMOSTAT_DS620_EDGE:
+        case DIGITAL_THERMOSTAT_DS620_PS:
+            sts = ahw_vdp_dt_ds620_alert_poll(al_dt,now_ms,temp_mdeg,alert_sts);
+            break;
+        default:
+            sts = HAL_AH_INVLD_INST_ID;
+    }
+    return sts;
+}
+
 #endif
@@ -39,7 +39,7 @@ hal_ret_sts ahw_al_imu_common_init(ahw_al_imu_hdle *ahw_al_himu)
     return sts;
 }
 
-#ifndef LINUX_TEMP_PORT
+#if !defined(LINUX_TEMP_PORT) || defined(LINUX_AHW_SIM)
 /**
  * @brief Mapping API to reset and restart the device
  */
@@ -273,4 +273,58 @@ hal_ret_sts ahw_al_imu_common_shock_detect_ste_cfg(imu_int_type_cfg *int_config,
     }
     return sts;
 }
+
+/**
+ * @brief Mapping API to start the FIFO streaming
+ */
+hal_ret_sts ahw_al_imu_common_fifo_stream_start(imu_fifo_stream_cfg *stream_cfg, ahw_al_imu_hdle *himu)
+{
+    hal_ret_sts sts;
+    switch(himu->ahw_gen_info.ahw_inst_id)
+    {
+        case IMU_BMX160_OBC_1:
+        case IMU_BMX160_OBC_2:
+            sts = ahw_vdp_imu_bmx160_fifo_stream_start(stream_cfg, himu);
+            break;
+        default:
+            sts = HAL_AH_INVLD_INST_ID;
+    }
+    return sts;
+}
+
+/**
+ * @brief Mapping API to read a batch of samples from the FIFO
+ */
+hal_ret_sts ahw_al_imu_common_fifo_stream_read(imu_fifo_batch *batch, ahw_al_imu_hdle *himu)
+{
+    hal_ret_sts sts;
+    switch(himu->ahw_gen_info.ahw_inst_id)
+    {
+        case IMU_BMX160_OBC_1:
+        case IMU_BMX160_OBC_2:
+            sts = ahw_vdp_imu_bmx160_fifo_stream_read(batch, himu);
+            break;
+        default:
+            sts = HAL_AH_INVLD_INST_ID;
+    }
+    return sts;
+}
+
+/**
+ * @brief Mapping API to stop the FIFO streaming
+ */
+hal_ret_sts ahw_al_imu_common_fifo_stream_stop(ahw_al_imu_hdle *himu)
+{
+    hal_ret_sts sts;
+    switch(himu->ahw_gen_info.ahw_inst_id)
+    {
+        case IMU_BMX160_OBC_1:
+        case IMU_BMX160_OBC_2:
+            sts = ahw_vdp_imu_bmx160_fifo_stream_stop(himu);
+            break;
+        default:
+            sts = HAL_AH_INVLD_INST_ID;
+    }
+    return sts;
+}
 #endif
@@ -101,7 +101,7 @@ uint16_t mcp9843_i2c_write(void* intf_hdl, uint16_t slv_addr, uint8_t reg_addr,
 hal_ret_sts ahw_vdp_ts_mcp9843_init(ahw_al_temp_sensor_hdl *al_ts_h)
 {
     hal_ret_sts sts = HAL_SCS;
-#ifdef LINUX_TEMP_PORT
+#if defined(LINUX_TEMP_PORT) && !defined(LINUX_AHW_SIM)
     printf("\n EXO TEMPERATURE SENSOR - AH-Vendor driver porting layer initialize");
     printf("\n EXO TEMPERATURE SENSOR - AH-Vendor driver initialize");
     printf("\n EXO TEMPERATURE SENSOR - AH-Vendor driver initialization completed successfully ");
@@ -142,7 +142,7 @@ hal_ret_sts ahw_vdp_ts_mcp9843_init(ahw_al_temp_sensor_hdl *al_ts_h)
 hal_ret_sts ahw_vdp_ts_mcp9843_deinit(ahw_al_temp_sensor_hdl *al_ts_h)
 {
     hal_ret_sts sts=HAL_SCS;
-#ifdef LINUX_TEMP_PORT
+#if defined(LINUX_TEMP_PORT) && !defined(LINUX_AHW_SIM)
     printf("\n EXO TEMPERATURE SENSOR - AH-Vendor driver porting layer de-initialize");
     printf("\n EXO TEMPERATURE SENSOR - AH-Vendor driver de-initialize");
     printf("\n EXO TEMPERATURE SENSOR - AH-Vendor driver de-initialization completed successfully ");
@@ -165,7 +165,7 @@ hal_ret_sts ahw_vdp_ts_mcp9843_deinit(ahw_al_temp_sensor_hdl *al_ts_h)
     return sts;
 }
 
-#ifndef LINUX_TEMP_PORT
+#if !defined(LINUX_TEMP_PORT) || defined(LINUX_AHW_SIM)
 /**
  * @brief API to get the event status of temperature Sensor
  *
@@ -559,5 +559,71 @@ hal_ret_sts ahw_vdp_ts_mcp9843_read_manufacture_id(ahw_al_temp_sensor_hdl *al_ts
     return sts;
 }
 
+/*!
+ *  @brief API to get the temperature in milli degree celsius
+ */
+hal_ret_sts ahw_vdp_ts_mcp9843_get_temperature_mdeg(ahw_al_temp_sensor_hdl *al_ts_h,int32_t *temp_mdeg)
+{
+    hal_ret_sts sts;
+    mcp9843_dev_t *vdh_ts = (mcp9843_dev_t*) al_ts_h->ahw_gen_info.vdp_inst_hdle;
+    if(HAL_SCS == (hal_ret_sts)mcp9843_get_temperature_mdeg(vdh_ts,temp_mdeg))
+    {
+        sts = HAL_SCS;
+    }
+    else
+    {
+        sts = HAL_AH_DRIVER_ERR;
+    }
+    return sts;
+}
+
+/*!
+ *  @brief API to program the limits and enable the alert driven sampling
+ */
+hal_ret_sts ahw_vdp_ts_mcp9843_alert_cfg(ahw_al_temp_sensor_hdl *al_ts_h,int32_t low_mdeg,int32_t high_mdeg,int32_t crit_mdeg,uint32_t hb_ms)
+{
+    hal_ret_sts sts;
+    mcp9843_dev_t *vdh_ts = (mcp9843_dev_t*) al_ts_h->ahw_gen_info.vdp_inst_hdle;
+    if(HAL_SCS == (hal_ret_sts)mcp9843_alert_mode_cfg(vdh_ts,low_mdeg,high_mdeg,crit_mdeg,hb_ms))
+    {
+        al_ts_h->low_temp_threshold=vdh_ts->low_temp_threshold;
+        al_ts_h->high_temp_threshold=vdh_ts->high_temp_threshold;
+        al_ts_h->critical_temp_threshold=vdh_ts->critical_temp_threshold;
+        sts = HAL_SCS;
+    }
+    else
+    {
+        sts = HAL_AH_DRIVER_ERR;
+    }
+    return sts;
+}
+
+/*!
+ *  @brief API to report an EVENT pin alert
+ */
+hal_ret_sts ahw_vdp_ts_mcp9843_alert_notify(ahw_al_temp_sensor_hdl *al_ts_h)
+{
+    mcp9843_alert_notify((mcp9843_dev_t*) al_ts_h->ahw_gen_info.vdp_inst_hdle);
+    return HAL_SCS;
+}
+
+/*!
+ *  @brief API to get the temperature in alert mode
+ */
+hal_ret_sts ahw_vdp_ts_mcp9843_alert_poll(ahw_al_temp_sensor_hdl *al_ts_h,uint32_t now_ms,int32_t *temp_mdeg,uint8_t *alert_sts)
+{
+    hal_ret_sts sts;
+    mcp9843_dev_t *vdh_ts = (mcp9843_dev_t*) al_ts_h->ahw_gen_info.vdp_inst_hdle;
+    if(HAL_SCS == (hal_ret_sts)mcp9843_alert_poll(vdh_ts,now_ms,temp_mdeg,alert_sts))
+    {
+        sts = HAL_SCS;
+    }
+    else
+    {
+        sts = HAL_AH_DRIVER_ERR;
+    }
+    return sts;
+}
+
 #endif
 
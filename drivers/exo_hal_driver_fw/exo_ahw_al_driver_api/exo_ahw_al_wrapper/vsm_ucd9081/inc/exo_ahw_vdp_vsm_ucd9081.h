@@ -125,6 +125,14 @@ hal_ret_sts ahw_vdp_vsm_ucd9081_get_fw_version(ahw_al_vsm_hdle *al_vsm, uint8_t*
  */
 hal_ret_sts ahw_vdp_vsm_ucd9081_get_voltage(ahw_al_vsm_hdle *al_vsm, vltg_seq_rail_cfg* rail_info, float *voltage);
 
+/**
+ * @brief API to get voltage of all rails in one burst read
+ * @param[in]  al_vsm - AHAL instance pointer of UCD9081
+ * @param[out]  snapshot - ADC counts and voltages of all rails
+ * @retval hal_ret_sts - returns the success or error code
+ */
+hal_ret_sts ahw_vdp_vsm_ucd9081_get_all_voltages(ahw_al_vsm_hdle *al_vsm, vltg_seq_rail_snapshot* snapshot);
+
 /**
  * @brief API to get alarm pending status
  * @param[in]  al_vsm - AHAL instance pointer of UCD9081
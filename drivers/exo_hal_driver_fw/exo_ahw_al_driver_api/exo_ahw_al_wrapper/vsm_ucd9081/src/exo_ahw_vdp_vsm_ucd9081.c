@@ -19,6 +19,7 @@
  */
 
 #include <stdio.h>
+#include <string.h>
 #include <unistd.h>
 #include "exo_ahw_vdp_vsm_ucd9081.h"
 #include "exo_osal_mem_management.h"
@@ -28,7 +29,7 @@
 extern ahw_io_map *ahw_io_lookup_tble[MAX_AH_INST_ID];
 extern void *intf_inst_hdle_ptr[MAX_IO_INST_ID];
 
-#ifndef LINUX_TEMP_PORT
+#if !defined(LINUX_TEMP_PORT) || defined(LINUX_AHW_SIM)
 
 /*!
  *  @brief I2C read hook function for UCD9081 module
@@ -37,16 +38,10 @@ int8_t ucd9081_i2c_read(void* intf_hdl, uint16_t slv_addr, uint8_t reg_addr, uin
 {
     ioal_i2c_hdle *hi2c = (ioal_i2c_hdle*)intf_hdl;
     int8_t rslt;
-    if(HAL_SCS == io_hal_i2c_transmit(hi2c, (uint16)(slv_addr<<1), &reg_addr, 1, 500))
+    /* Repeated start read, the register pointer auto increments over len bytes */
+    if(HAL_SCS == io_hal_i2c_write_read(hi2c, (uint16)(slv_addr), &reg_addr, 1, data, len, 500))
     {
-        if(HAL_SCS == io_hal_i2c_receive(hi2c, (uint16)(slv_addr<<1), data, len, 500))
-        {
-            rslt = UCD9081_SCS;
-        }
-        else
-        {
-            rslt = UCD9081_COM_ERR;
-        }
+        rslt = UCD9081_SCS;
     }
     else
     {
@@ -62,22 +57,24 @@ int8_t ucd9081_i2c_write(void* intf_hdl, uint16_t slv_addr, uint8_t reg_addr, ui
 {
     ioal_i2c_hdle *hi2c = (ioal_i2c_hdle*)intf_hdl;
     int8_t rslt;
+    uint8_t data_send[3];
 
     if(data==NULL)
     {
-        rslt = io_hal_i2c_transmit(hi2c, (uint16)(slv_addr<<1),&reg_addr, 1, 500);
+        rslt = io_hal_i2c_transmit(hi2c, (uint16)(slv_addr),&reg_addr, 1, 500);
         return rslt;
     }
-    if(HAL_SCS == io_hal_i2c_transmit(hi2c, (uint16)(slv_addr<<1), &reg_addr, 1, 500))
+    if(len > sizeof(data_send) - 1)
     {
-        if(HAL_SCS == io_hal_i2c_transmit(hi2c, (uint16)(slv_addr<<1), data, len, 500))
-        {
-            rslt = UCD9081_SCS;
-        }
-        else
-        {
-            rslt = UCD9081_COM_ERR;
-        }
+        return UCD9081_COM_ERR;
+    }
+    /* Register address and data in one transaction, a second start would
+       make the device take the first data byte as the register address */
+    data_send[0]=reg_addr;
+    memcpy(&data_send[1], data, len);
+    if(HAL_SCS == io_hal_i2c_transmit(hi2c, (uint16)(slv_addr), data_send, (uint16)(len + 1), 500))
+    {
+        rslt = UCD9081_SCS;
     }
     else
     {
@@ -94,7 +91,7 @@ hal_ret_sts ahw_vdp_vsm_ucd9081_init(ahw_al_vsm_hdle *ahw_al_hvsm)
 {
 
     hal_ret_sts sts = HAL_MAX_ERR;
-#ifdef LINUX_TEMP_PORT
+#if defined(LINUX_TEMP_PORT) && !defined(LINUX_AHW_SIM)
     printf("\n EXO UCD9081 Digital thermostat - AH-Vendor driver porting layer Initialise");
     printf("\n EXO UCD9081 Digital thermostat - AH-Vendor driver Initialise");
     printf("\n EXO UCD9081 Digital thermostat - AH-Vendor driver Initialisation completed successfully ");
@@ -104,6 +101,7 @@ hal_ret_sts ahw_vdp_vsm_ucd9081_init(ahw_al_vsm_hdle *ahw_al_hvsm)
 #else
 
     s_ucd9081* hvsm=(s_ucd9081*)os_malloc(sizeof(s_ucd9081));
+    memset(hvsm, 0, sizeof(s_ucd9081));
     hvsm->write = ucd9081_i2c_write;
     hvsm->read = ucd9081_i2c_read;
     hvsm->intf_hdl = intf_inst_hdle_ptr[ahw_io_lookup_tble[ahw_al_hvsm->ahw_gen_info.ahw_inst_id]->io_instance_id];
@@ -123,7 +121,7 @@ hal_ret_sts ahw_vdp_vsm_ucd9081_init(ahw_al_vsm_hdle *ahw_al_hvsm)
     return sts;
 }
 
-#ifndef LINUX_TEMP_PORT
+#if !defined(LINUX_TEMP_PORT) || defined(LINUX_AHW_SIM)
 /*!
  *  @brief This API configure the rail
  */
@@ -381,6 +379,32 @@ hal_ret_sts ahw_vdp_vsm_ucd9081_get_voltage(ahw_al_vsm_hdle *al_vsm, vltg_seq_ra
     return sts;
 }
 
+/*!
+ *  @brief This API get voltage of all rails
+ */
+hal_ret_sts ahw_vdp_vsm_ucd9081_get_all_voltages(ahw_al_vsm_hdle *al_vsm, vltg_seq_rail_snapshot* snapshot)
+{
+    hal_ret_sts sts;
+    s_ucd9081* ucd9081_hdl_vdp;
+    s_ucd9081_rail_snapshot vd_snapshot;
+    uint8_t rail_no;
+    ucd9081_hdl_vdp = (s_ucd9081*) al_vsm->ahw_gen_info.vdp_inst_hdle;
+    if(HAL_SCS == (hal_ret_sts) ucd9081_get_all_voltages(ucd9081_hdl_vdp,&vd_snapshot))
+    {
+        for(rail_no=0; rail_no<VOLTAGE_SEQ_RAIL_CNT; rail_no++)
+        {
+            snapshot->raw[rail_no] = vd_snapshot.raw[rail_no];
+            snapshot->voltage[rail_no] = vd_snapshot.voltage[rail_no];
+        }
+        sts=HAL_SCS;
+    }
+    else
+    {
+        sts=HAL_AH_DRIVER_ERR;
+    }
+    return sts;
+}
+
 /*!
  *  @brief This API get alarm pending status
  */
@@ -45,6 +45,7 @@ typedef enum
     HAL_IO_INTF_BUSY,                       /*!< IO in busy state */
     HAL_AHW_CONTENTION_STE,                 /*!< AHW contention state */
     HAL_AH_DRIVER_ERR,                      /*!< AH driver error */
+    HAL_AH_NOT_READY,                       /*!< AH has no new data available */
     HAL_AHIOBCSN_FW_ERR = 200,              /*!< AHIOBCSN firmware error */
     HAL_AHDLSD_FW_ERR,                      /*!< AHDLSD firmware error */
     HAL_MEM_ALLOC_ERR,                      /*!< Memory allocation error */
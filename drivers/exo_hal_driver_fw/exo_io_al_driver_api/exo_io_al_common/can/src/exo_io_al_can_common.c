@@ -136,7 +136,7 @@ hal_ret_sts io_hal_can_init(void)
     printf("\n EXO CAN IO AL Framework Initialise");
     usleep(100000);
 #endif
-    hal_ret_sts sts;
+    hal_ret_sts sts = HAL_SCS;
 
     os_sem_create_bin(&can_tx);
     os_sem_give(can_tx);
@@ -299,7 +299,7 @@ hal_ret_sts io_hal_can_start(ioal_can_hdle *hcan)
 hal_ret_sts io_hal_can_stop(ioal_can_hdle *hcan)
 {
     hal_ret_sts ret_sts = HAL_MAX_ERR;
-    if(HAL_SCS == io_hal_common_can_start(hcan))
+    if(HAL_SCS == io_hal_common_can_stop(hcan))
     {
         ret_sts = HAL_SCS;
 
@@ -357,6 +357,7 @@ uint32_t io_hal_can_is_sleep_active(ioal_can_hdle *hcan)
 
     return ret_sts;
 }
+#endif
 
 /**
  * @brief  This API add a message to the first free Tx mailbox and activate the
@@ -378,6 +379,7 @@ hal_ret_sts io_hal_can_add_tx_message(ioal_can_hdle *hcan,iohal_can_tx_header *p
     return ret_sts;
 }
 
+#ifndef LINUX_TEMP_PORT
 /**
  * @brief  This API abort transmission requests
  */
@@ -424,6 +426,7 @@ uint32_t io_hal_can_get_tx_time_stamp(ioal_can_hdle *hcan, uint32_t txmailbox)
     ret_sts=io_hal_common_get_tx_time_stamp(hcan,txmailbox);
     return ret_sts;
 }
+#endif
 
 /**
  * @brief This API get an CAN frame from the Rx FIFO
@@ -442,6 +445,7 @@ hal_ret_sts io_hal_can_get_rx_message(ioal_can_hdle *hcan, uint32_t rxfifo,iohal
     return ret_sts;
 }
 
+#ifndef LINUX_TEMP_PORT
 /**
  * @brief  This API return Rx FIFO fill level.
  */
@@ -451,6 +455,7 @@ uint32_t io_hal_can_get_rx_fifo_fill_level(ioal_can_hdle *hcan, uint32_t rxfifo)
     ret_sts= io_hal_common_get_rx_fifo_fill_level (hcan,rxfifo);
     return ret_sts;
 }
+#endif
 
 /**
  * @brief  This API configures the CAN reception filter
@@ -469,6 +474,7 @@ hal_ret_sts io_hal_can_configfilter(ioal_can_hdle *hcan, iohal_can_filter *sfilt
     return ret_sts;
 }
 
+#ifndef LINUX_TEMP_PORT
 /**
  * @brief  This API activate notifications
  */
@@ -502,6 +508,7 @@ hal_ret_sts io_hal_can_deactivate_notification(ioal_can_hdle *hcan, uint32_t ina
     }
     return ret_sts;
 }
+#endif
 
 /**
  *@brief  This API get the CAN state.
@@ -511,6 +518,8 @@ iohal_can_state io_hal_can_get_state(ioal_can_hdle *hcan)
     return ((iohal_can_state)io_hal_common_can_get_state(hcan));
 }
 
+#ifndef LINUX_TEMP_PORT
+
 /**
  *@brief  This API get the CAN error code.
  */
@@ -362,6 +362,23 @@ ioal_gpio_pinstate io_hal_gpio_readpin(uint32_t pin_number);
  */
 void io_hal_gpio_togglepin(uint32_t pin_number);
 
+/**
+ * @brief This function reads several MCU pins of one port with a single access.
+ * @param[in] port_name : Port index, MCU pin number divided by the pins per port.
+ * @param[in] mask : Pins of the port to read, bit n selects pin n.
+ *
+ * @return The state of the selected pins, bit n holds pin n.
+ */
+uint16_t io_hal_gpio_readport(uint16_t port_name, uint16_t mask);
+
+/**
+ * @brief This function drives several MCU output pins of one port with a single access.
+ * @param[in] port_name : Port index, MCU pin number divided by the pins per port.
+ * @param[in] mask : Pins of the port to drive, bit n selects pin n.
+ * @param[in] value : Logic level of the selected pins, bit n drives pin n.
+ */
+void io_hal_gpio_writeport(uint16_t port_name, uint16_t mask, uint16_t value);
+
 /**
  * @brief Initializes the GPIO pointer table.
  */
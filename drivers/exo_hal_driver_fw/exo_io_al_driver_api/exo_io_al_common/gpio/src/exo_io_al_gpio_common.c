@@ -32,8 +32,6 @@
 #endif
 
 
-#ifndef LINUX_TEMP_PORT
-
 static ioal_gpio_gen_info *ioal_gpio_inst_hdle_ptr[MC_AVAILABLE_GPIO_PINS]; ///< IOAL GPIO instance handle pointer
 
 /*!
@@ -251,7 +249,6 @@ static gpio_ret_sts gpio_interrupt_config(ioal_gpio_config* gpio_input_config_da
     }
     return ret;
 }
-#endif
 
 /*!
  *  @brief This API receives user input and determine the user option to configure
@@ -259,7 +256,6 @@ static gpio_ret_sts gpio_interrupt_config(ioal_gpio_config* gpio_input_config_da
  */
 void io_hal_gpio_init(ioal_gpio_config* gpio_cfg)
 {
-#ifndef LINUX_TEMP_PORT    
     uint8_t hw_id=gpio_cfg->pin_number & 0x000000FF;
     ahw_al_gpio_exp_gpio_cfg pin_cfg;
     gpio_cfg->pin_number = gpio_cfg->pin_number>>8;
@@ -292,7 +288,6 @@ void io_hal_gpio_init(ioal_gpio_config* gpio_cfg)
         pin_cfg.mode=gpio_cfg->mode;
         ahw_al_gpio_exp_pin_init(hw_id,&pin_cfg);
     }
-#endif
 }
 
 
@@ -301,7 +296,6 @@ void io_hal_gpio_init(ioal_gpio_config* gpio_cfg)
  */
 void io_hal_gpio_writepin(uint32_t pin_number,uint32_t drive_logic)
 {
-#ifndef LINUX_TEMP_PORT    
     uint8_t hw_id=pin_number & 0x000000FF;
     pin_number = pin_number>>8;
     if(hw_id == MCU_ID)
@@ -319,7 +313,6 @@ void io_hal_gpio_writepin(uint32_t pin_number,uint32_t drive_logic)
     {
         ahw_al_gpio_exp_writepin(hw_id,pin_number,drive_logic);
     }
-#endif
 }
 
 /*!
@@ -328,7 +321,6 @@ void io_hal_gpio_writepin(uint32_t pin_number,uint32_t drive_logic)
 ioal_gpio_pinstate io_hal_gpio_readpin(uint32_t pin_number)
 {
     ioal_gpio_pinstate pin_state = IOAL_INVLD_GPIO_PIN_STE;
-#ifndef LINUX_TEMP_PORT
     uint8_t hw_id=pin_number & 0x000000FF;
     pin_number = pin_number>>8;
     if(hw_id == MCU_ID)
@@ -347,7 +339,6 @@ ioal_gpio_pinstate io_hal_gpio_readpin(uint32_t pin_number)
         ahw_al_gpio_exp_readpin(hw_id,pin_number,(gpio_exp_gpio_pinstate*)&pin_state);
     }
 
-#endif
     return pin_state;
 }
 
@@ -356,7 +347,6 @@ ioal_gpio_pinstate io_hal_gpio_readpin(uint32_t pin_number)
  */
 void io_hal_gpio_togglepin(uint32_t pin_number)
 {
-#ifndef LINUX_TEMP_PORT    
     uint8_t hw_id=pin_number & 0x000000FF;
     pin_number = pin_number>>8;
     if(hw_id == MCU_ID)
@@ -374,7 +364,6 @@ void io_hal_gpio_togglepin(uint32_t pin_number)
     {
         ahw_al_gpio_exp_togglepin(hw_id,pin_number);
     }
-#endif
 }
 
 /*!
@@ -382,7 +371,6 @@ void io_hal_gpio_togglepin(uint32_t pin_number)
  */
 void io_hal_gpio_deinit(uint32_t pin_number)
 {
-#ifndef LINUX_TEMP_PORT    
     uint16_t temp;
     if(ioal_gpio_inst_hdle_ptr[pin_number] != NULL)
     {
@@ -399,5 +387,28 @@ void io_hal_gpio_deinit(uint32_t pin_number)
     {
         //do nothing
     }
-#endif
+}
+
+/*!
+ *  @brief This API reads the pins of an MCU port selected by mask
+ */
+uint16_t io_hal_gpio_readport(uint16_t port_name, uint16_t mask)
+{
+    uint16_t value = 0;
+    if(port_name <= (MC_AVAILABLE_GPIO_PINS / MC_PORT_REGISTER_PIN_COUNT))
+    {
+        value = io_hal_common_gpio_read_port(port_name, mask);
+    }
+    return value;
+}
+
+/*!
+ *  @brief This API drives the pins of an MCU port selected by mask
+ */
+void io_hal_gpio_writeport(uint16_t port_name, uint16_t mask, uint16_t value)
+{
+    if(port_name <= (MC_AVAILABLE_GPIO_PINS / MC_PORT_REGISTER_PIN_COUNT))
+    {
+        io_hal_common_gpio_write_port(port_name, mask, value);
+    }
 }
@@ -44,6 +44,18 @@ typedef struct _ioal_i2c_hdle
     i2c_cb_lst app_callbacks;            ///< App registered callbacks list 
 }ioal_i2c_hdle;
 
+/**
+ * @brief IO-HAl I2C transaction, a write followed by a read with a repeated start in between
+ */
+typedef struct
+{
+    uint16 addr;                         ///< Slave address, same format as for io_hal_i2c_transmit()
+    uint8 *wr_data;                      ///< Bytes written first, e.g. the register address
+    uint16 wr_size;                      ///< Number of bytes to write, 0 for a read only transaction
+    uint8 *rd_data;                      ///< Buffer for the bytes read
+    uint16 rd_size;                      ///< Number of bytes to read, 0 for a write only transaction
+}iohal_i2c_xfer;
+
 /**
  * @brief  This function initializes the control block memory
  * and do the basic configurations for I2C
@@ -101,6 +113,32 @@ hal_ret_sts io_hal_i2c_transmit(ioal_i2c_hdle *hi2c, uint16 addr, uint8 *pdata,
  * @retval HAL status
  */
 hal_ret_sts io_hal_i2c_receive(ioal_i2c_hdle *hi2c, uint16 addr, uint8 *pdata, uint16 size, uint32 timeout);
+/**
+ * @brief  This function writes data and then reads data in master mode, with a repeated
+ *         start instead of a stop in between, e.g. a register read.
+ * @param[in]  hi2c - hi2c pointer to a ioal_i2c_hdle structure that contains
+ *          the configuration information for I2C module
+ * @param[in]  addr - Slave address
+ * @param[in]  wr_data - Pointer to data to be written, e.g. the register address
+ * @param[in]  wr_size - size of the data to be written
+ * @param[out] rd_data - Pointer to buffer for the data read
+ * @param[in]  rd_size - size of the data to be read
+ * @param[in]  timeout - Timeout duration
+ * @retval HAL status
+ */
+hal_ret_sts io_hal_i2c_write_read(ioal_i2c_hdle *hi2c, uint16 addr, uint8 *wr_data, uint16 wr_size, uint8 *rd_data, uint16 rd_size, uint32 timeout);
+/**
+ * @brief  This function runs several transactions back to back in master mode.
+ *         On linux they are submitted to the kernel together and are not interleaved
+ *         with transfers of other processes.
+ * @param[in]  hi2c - hi2c pointer to a ioal_i2c_hdle structure that contains
+ *          the configuration information for I2C module
+ * @param[in,out] xfer - array of transactions
+ * @param[in]  count - number of transactions
+ * @param[in]  timeout - Timeout duration
+ * @retval HAL status
+ */
+hal_ret_sts io_hal_i2c_transfer(ioal_i2c_hdle *hi2c, iohal_i2c_xfer *xfer, uint16 count, uint32 timeout);
 /**
  * @brief  This function transmit data in master mode with interrupt
  * @param[in]  hi2c - hi2c pointer to a ioal_i2c_hdle structure that contains
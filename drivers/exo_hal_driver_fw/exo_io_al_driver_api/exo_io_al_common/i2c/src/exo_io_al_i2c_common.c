@@ -102,9 +102,8 @@ hal_ret_sts io_hal_i2c_init(void)
 {
 #ifdef LINUX_TEMP_PORT
     printf("\n EXO IO AL I2C Initialise");
-    usleep(100000);
 #endif
-    hal_ret_sts sts;
+    hal_ret_sts sts = HAL_SCS;
 
     if(HAL_SCS == io_hal_common_i2c1_init(&ioal_hi2c1))
     {
@@ -240,6 +239,44 @@ hal_ret_sts io_hal_i2c_receive(ioal_i2c_hdle *hi2c, uint16 addr, uint8 *pdata, u
     return ret_sts;
 }
 
+/**
+ * @brief This API writes and then reads data in master mode, with a repeated start.
+ */
+hal_ret_sts io_hal_i2c_write_read(ioal_i2c_hdle *hi2c, uint16 addr, uint8 *wr_data, uint16 wr_size, uint8 *rd_data, uint16 rd_size, uint32 timeout)
+{
+    hal_ret_sts ret_sts = HAL_MAX_ERR;
+    hi2c->intf_gen_info.state = IO_BUSY_STATE;
+    if(HAL_SCS == io_hal_common_i2c_write_read(hi2c,addr,wr_data,wr_size,rd_data,rd_size,timeout))
+    {
+        ret_sts = HAL_SCS;
+    }
+    else
+    {
+        ret_sts = HAL_IO_RX_ERR;
+    }
+    hi2c->intf_gen_info.state = IO_FREE_STATE;
+    return ret_sts;
+}
+
+/**
+ * @brief This API runs several transactions back to back in master mode.
+ */
+hal_ret_sts io_hal_i2c_transfer(ioal_i2c_hdle *hi2c, iohal_i2c_xfer *xfer, uint16 count, uint32 timeout)
+{
+    hal_ret_sts ret_sts = HAL_MAX_ERR;
+    hi2c->intf_gen_info.state = IO_BUSY_STATE;
+    if(HAL_SCS == io_hal_common_i2c_transfer(hi2c,xfer,count,timeout))
+    {
+        ret_sts = HAL_SCS;
+    }
+    else
+    {
+        ret_sts = HAL_IO_RX_ERR;
+    }
+    hi2c->intf_gen_info.state = IO_FREE_STATE;
+    return ret_sts;
+}
+
 #ifndef LINUX_TEMP_PORT
 /**
  * @brief This API transmit data in master mode with Interrupt
@@ -44,6 +44,17 @@ typedef struct _ioal_spi_hdle
     spi_cb_lst app_callbacks;                               /*!< SPI App callbacks list                                         */
 }ioal_spi_hdle;
 
+/**
+ * @brief IO-HAl SPI transfer descriptor, one segment of a queued transaction
+ */
+typedef struct
+{
+    uint8 *tx_data;                                         /*!< Data to send, NULL clocks out zeros                            */
+    uint8 *rx_data;                                         /*!< Buffer for received data, NULL discards it                     */
+    uint16 size;                                            /*!< Number of bytes clocked                                        */
+    uint8 cs_change;                                        /*!< Release chip select after this segment                         */
+}iohal_spi_xfer;
+
 /**
  * @brief This function initialize the SPI control block memory structure and
  *          do basic configurations of SPI
@@ -88,6 +99,18 @@ hal_ret_sts io_hal_spi_receive(ioal_spi_hdle *hspi, uint8 *pdata, uint16 size, u
  * @retval HAL status
  */
 hal_ret_sts io_hal_spi_transmit_receive(ioal_spi_hdle *hspi, uint8 *ptxdata, uint8 *prxdata, uint16 size, uint32 timeout);
+/**
+ * @brief This function runs a queue of full-duplex transfers. Chip select
+ *        stays asserted across segments unless cs_change is set, and is
+ *        always released after the last one.
+ * @param[in] hspi - hspi pointer to a ioal_spi_hdle structure that contains
+ *             the configuration information for SPI module
+ * @param[in,out] xfer - array of transfer descriptors
+ * @param[in] count - number of transfer descriptors
+ * @param[in] timeout -  timeout duration of each segment
+ * @retval HAL status
+ */
+hal_ret_sts io_hal_spi_transfer(ioal_spi_hdle *hspi, iohal_spi_xfer *xfer, uint16 count, uint32 timeout);
 /**
  * @brief This function transmit the data in SPI interface with interrupt mode
  * @param[in] hspi - hspi pointer to a ioal_spi_hdle structure that contains
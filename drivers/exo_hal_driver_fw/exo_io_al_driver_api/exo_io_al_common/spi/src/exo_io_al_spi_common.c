@@ -53,9 +53,8 @@ hal_ret_sts io_hal_spi_init(void)
 {
 #ifdef LINUX_TEMP_PORT
     printf("\n EXO IO AL SPI Initialise");
-    usleep(100000);
 #endif
-    hal_ret_sts sts;
+    hal_ret_sts sts = HAL_SCS;
     if(HAL_SCS == io_hal_common_spi1_init(&ioal_hspi1))
     {
         intf_inst_hdle_ptr[IOAL_INST_SPI1] = &ioal_hspi1;
@@ -123,7 +122,6 @@ hal_ret_sts io_hal_spi_receive(ioal_spi_hdle *hspi, uint8 *pdata, uint16 size, u
     return ret_sts;
 }
 
-#ifndef LINUX_TEMP_PORT
 /*
  * @brief This API transmit and receive the data
  */
@@ -144,6 +142,27 @@ hal_ret_sts io_hal_spi_transmit_receive(ioal_spi_hdle *hspi, uint8 *ptxdata, uin
     return ret_sts;
 }
 
+/*
+ * @brief This API runs a queue of full-duplex transfers
+ */
+hal_ret_sts io_hal_spi_transfer(ioal_spi_hdle *hspi, iohal_spi_xfer *xfer, uint16 count, uint32 timeout)
+{
+    hal_ret_sts ret_sts = HAL_MAX_ERR;
+    hspi->intf_gen_info.state = IO_BUSY_STATE;
+    if(HAL_SCS == io_hal_common_spi_transfer(hspi,xfer,count,timeout))
+    {
+        ret_sts = HAL_SCS;
+        hspi->intf_gen_info.state = IO_FREE_STATE;
+    }
+    else
+    {
+        ret_sts = HAL_IO_RX_ERR;
+        hspi->intf_gen_info.state = IO_FREE_STATE;
+    }
+    return ret_sts;
+}
+
+#ifndef LINUX_TEMP_PORT
 /*
  * @brief This API transmit the data in SPI interface with interrupt mode
  */
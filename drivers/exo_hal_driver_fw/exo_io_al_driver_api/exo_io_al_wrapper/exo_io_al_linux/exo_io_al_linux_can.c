@@ -18,24 +18,240 @@
  * limitations under the License.
  */
 
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE     // recvmmsg(), sendmmsg()
+#endif
 #include <stdio.h>
+#include <string.h>
 #include <unistd.h>
+#include <errno.h>
+#include <poll.h>
+#include <net/if.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <linux/can.h>
+#include <linux/can/raw.h>
 #include "exo_io_al_linux_can.h"
 #include "exo_io_al_can_common.h"
 #include "exo_hal_io_al_common.h"
 
+/**
+ * @brief SocketCAN instance data, referenced by vdp_intf_inst_hdle
+ */
+typedef struct
+{
+    int fd;                                                     /*!< CAN_RAW socket                         */
+    iohal_can_state state;                                      /*!< Emulated bxCAN state                   */
+    uint8_t filter_cnt[LNX_CAN_FILTER_BANKS];                   /*!< Kernel filters used by each bank       */
+    struct can_filter filter[LNX_CAN_FILTER_BANKS][2];          /*!< Kernel filters decoded from each bank  */
+} lnx_can_inst;
+
+/**
+ * @brief Control buffer for one SO_TIMESTAMP ancillary message
+ */
+typedef union
+{
+    struct cmsghdr align;
+    uint8_t buf[CMSG_SPACE(sizeof(struct timeval))];
+} lnx_can_cmsg;
+
+static lnx_can_inst can1_inst = { .fd = -1 }; ///< CAN1 instance
+static lnx_can_inst can2_inst = { .fd = -1 }; ///< CAN2 instance
+static lnx_can_inst can3_inst = { .fd = -1 }; ///< CAN3 instance
+
+/**
+ * @brief Open a raw CAN socket on a SocketCAN device and attach it to the IO-AL handle
+ */
+static hal_ret_sts io_hal_linux_can_open(ioal_can_hdle *ioal_hcan, lnx_can_inst *inst, const char *dev)
+{
+    hal_ret_sts ret = HAL_IO_INIT_ERR;
+    struct sockaddr_can addr;
+    struct ifreq ifr;
+    int enable = 1;
+
+    printf("\n EXO CAN IO Vendor driver initialise on %s", dev);
+
+    inst->fd = socket(PF_CAN, SOCK_RAW, CAN_RAW);
+    if (inst->fd < 0) {
+        perror("Unable to open CAN socket");
+        return ret;
+    }
+
+    memset(&ifr, 0, sizeof(ifr));
+    strncpy(ifr.ifr_name, dev, sizeof(ifr.ifr_name) - 1);
+    if (ioctl(inst->fd, SIOCGIFINDEX, &ifr) < 0) {
+        perror("Unable to find CAN device");
+    }
+    else
+    {
+        memset(&addr, 0, sizeof(addr));
+        addr.can_family = AF_CAN;
+        addr.can_ifindex = ifr.ifr_ifindex;
+        if (bind(inst->fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+            perror("Unable to bind CAN socket");
+        }
+        else
+        {
+            // Kernel receive time of every frame, returned in the Rx header Timestamp
+            if (setsockopt(inst->fd, SOL_SOCKET, SO_TIMESTAMP, &enable, sizeof(enable)) < 0) {
+                perror("Unable to enable CAN timestamps");
+            }
+            memset(inst->filter_cnt, 0, sizeof(inst->filter_cnt));
+            inst->state = IOHAL_CAN_STATE_READY;
+            ioal_hcan->intf_gen_info.vdp_intf_inst_hdle = (void*)inst;
+            ioal_hcan->intf_gen_info.state = IO_FREE_STATE;
+            ret = HAL_SCS;
+        }
+    }
+
+    if (ret != HAL_SCS)
+    {
+        close(inst->fd);
+        inst->fd = -1;
+    }
+    else
+    {
+        printf("\n EXO CAN IO Vendor driver initialisation completed successfully");
+    }
+    return ret;
+}
+
+/**
+ * @brief Convert an IO-AL Tx header and payload to a SocketCAN frame
+ */
+static void io_hal_linux_can_tx_frame(const iohal_can_tx_header *p_header, const uint8_t adata[], struct can_frame *frame)
+{
+    memset(frame, 0, sizeof(*frame));
+    if (p_header->IDE == CAN_ID_EXT)
+    {
+        frame->can_id = (p_header->ExtId & CAN_EFF_MASK) | CAN_EFF_FLAG;
+    }
+    else
+    {
+        frame->can_id = p_header->StdId & CAN_SFF_MASK;
+    }
+    if (p_header->RTR == CAN_RTR_REMOTE)
+    {
+        frame->can_id |= CAN_RTR_FLAG;
+    }
+    frame->can_dlc = (p_header->DLC > CAN_MAX_DLEN) ? CAN_MAX_DLEN : p_header->DLC;
+    memcpy(frame->data, adata, frame->can_dlc);
+}
+
+/**
+ * @brief Convert a received SocketCAN frame to an IO-AL Rx header and payload
+ */
+static void io_hal_linux_can_rx_frame(const struct can_frame *frame, struct msghdr *msg, iohal_can_rx_header *p_header, uint8_t adata[])
+{
+    struct cmsghdr *cmsg;
+
+    memset(p_header, 0, sizeof(*p_header));
+    if (frame->can_id & CAN_EFF_FLAG)
+    {
+        p_header->IDE = CAN_ID_EXT;
+        p_header->ExtId = frame->can_id & CAN_EFF_MASK;
+    }
+    else
+    {
+        p_header->IDE = CAN_ID_STD;
+        p_header->StdId = frame->can_id & CAN_SFF_MASK;
+    }
+    p_header->RTR = (frame->can_id & CAN_RTR_FLAG) ? CAN_RTR_REMOTE : CAN_RTR_DATA;
+    p_header->DLC = (frame->can_dlc > CAN_MAX_DLEN) ? CAN_MAX_DLEN : frame->can_dlc;
+    memcpy(adata, frame->data, p_header->DLC);
+
+    for (cmsg = CMSG_FIRSTHDR(msg); cmsg != NULL; cmsg = CMSG_NXTHDR(msg, cmsg))
+    {
+        if ((cmsg->cmsg_level == SOL_SOCKET) && (cmsg->cmsg_type == SCM_TIMESTAMP))
+        {
+            struct timeval tv;
+            memcpy(&tv, CMSG_DATA(cmsg), sizeof(tv));
+            p_header->Timestamp = (uint32_t)(((uint64_t)tv.tv_sec * 1000000U) + (uint64_t)tv.tv_usec);
+        }
+    }
+}
+
+/**
+ * @brief Decode one 32-bit STM32 filter register into a SocketCAN identifier
+ */
+static canid_t io_hal_linux_can_filter_id(uint32_t reg)
+{
+    canid_t id;
+
+    if (reg & CAN_ID_EXT)
+    {
+        id = ((reg >> 3) & CAN_EFF_MASK) | CAN_EFF_FLAG;
+    }
+    else
+    {
+        id = (reg >> 21) & CAN_SFF_MASK;
+    }
+    if (reg & CAN_RTR_REMOTE)
+    {
+        id |= CAN_RTR_FLAG;
+    }
+    return id;
+}
+
+/**
+ * @brief Decode a 32-bit STM32 filter mask register, the identifier register
+ *        tells whether the mask covers a standard or an extended identifier
+ */
+static canid_t io_hal_linux_can_filter_mask(uint32_t reg, uint32_t id_reg)
+{
+    canid_t mask;
+
+    if (id_reg & CAN_ID_EXT)
+    {
+        mask = (reg >> 3) & CAN_EFF_MASK;
+    }
+    else
+    {
+        mask = (reg >> 21) & CAN_SFF_MASK;
+    }
+    if (reg & CAN_ID_EXT)
+    {
+        mask |= CAN_EFF_FLAG;
+    }
+    if (reg & CAN_RTR_REMOTE)
+    {
+        mask |= CAN_RTR_FLAG;
+    }
+    return mask;
+}
+
+/**
+ * @brief Program all active filter banks into the kernel
+ */
+static hal_ret_sts io_hal_linux_can_apply_filters(lnx_can_inst *inst)
+{
+    struct can_filter filter[LNX_CAN_FILTER_BANKS * 2];
+    uint32_t cnt = 0;
+    uint32_t bank;
+    uint32_t idx;
+
+    for (bank = 0; bank < LNX_CAN_FILTER_BANKS; bank++)
+    {
+        for (idx = 0; idx < inst->filter_cnt[bank]; idx++)
+        {
+            filter[cnt++] = inst->filter[bank][idx];
+        }
+    }
+    // No active bank receives nothing, as on the bxCAN
+    if (setsockopt(inst->fd, SOL_CAN_RAW, CAN_RAW_FILTER, (cnt > 0) ? filter : NULL, cnt * sizeof(filter[0])) < 0)
+    {
+        return HAL_IO_VDP_ERR;
+    }
+    return HAL_SCS;
+}
 
 /**
  * @brief IO-HAL CAN1 initialization function for linux
  */
 hal_ret_sts io_hal_linux_can1_init(void *ioal_hcan1)
 {
-    printf("\n EXO CAN IO Vendor driver porting layer initialise");
-    printf("\n EXO CAN IO Vendor driver initialise");
-    usleep(100000);
-    printf("\n EXO CAN IO Vendor driver initialisation completed successfully");
-    printf("\n EXO CAN IO Vendor driver porting layer initialisation completed successfully");
-    return 0;
+    return io_hal_linux_can_open(ioal_hcan1, &can1_inst, LNX_CAN1_DEV);
 }
 
 /**
@@ -43,12 +259,7 @@ hal_ret_sts io_hal_linux_can1_init(void *ioal_hcan1)
  */
 hal_ret_sts io_hal_linux_can2_init(void *ioal_hcan2)
 {
-    printf("\n EXO CAN IO Vendor driver porting layer initialise");
-    printf("\n EXO CAN IO Vendor driver initialise");
-    usleep(100000);
-    printf("\n EXO CAN IO Vendor driver initialisation completed successfully");
-    printf("\n EXO CAN IO Vendor driver porting layer initialisation completed successfully");
-    return 0;
+    return io_hal_linux_can_open(ioal_hcan2, &can2_inst, LNX_CAN2_DEV);
 }
 
 /**
@@ -56,12 +267,7 @@ hal_ret_sts io_hal_linux_can2_init(void *ioal_hcan2)
  */
 hal_ret_sts io_hal_linux_can3_init(void *ioal_hcan3)
 {
-    printf("\n EXO CAN IO Vendor driver porting layer initialise");
-    printf("\n EXO CAN IO Vendor driver initialise");
-    usleep(100000);
-    printf("\n EXO CAN IO Vendor driver initialisation completed successfully");
-    printf("\n EXO CAN IO Vendor driver porting layer initialisation completed successfully");
-    return 0;
+    return io_hal_linux_can_open(ioal_hcan3, &can3_inst, LNX_CAN3_DEV);
 }
 
 /**
@@ -69,7 +275,14 @@ hal_ret_sts io_hal_linux_can3_init(void *ioal_hcan3)
  */
 hal_ret_sts io_hal_linux_can_start(void *ioal_hcan)
 {
-    return 0;
+    lnx_can_inst *inst = ((ioal_can_hdle *)ioal_hcan)->intf_gen_info.vdp_intf_inst_hdle;
+
+    if ((inst == NULL) || (inst->fd < 0))
+    {
+        return HAL_IO_VDP_ERR;
+    }
+    inst->state = IOHAL_CAN_STATE_LISTENING;
+    return HAL_SCS;
 }
 
 /**
@@ -77,5 +290,232 @@ hal_ret_sts io_hal_linux_can_start(void *ioal_hcan)
  */
 hal_ret_sts io_hal_linux_can_stop(void *ioal_hcan)
 {
-    return 0;
+    lnx_can_inst *inst = ((ioal_can_hdle *)ioal_hcan)->intf_gen_info.vdp_intf_inst_hdle;
+
+    if ((inst == NULL) || (inst->fd < 0))
+    {
+        return HAL_IO_VDP_ERR;
+    }
+    inst->state = IOHAL_CAN_STATE_READY;
+    return HAL_SCS;
+}
+
+/**
+ * @brief IO-HAL CAN add Tx message function for linux
+ */
+hal_ret_sts io_hal_linux_add_tx_message(ioal_can_hdle *ioal_hcan, iohal_can_tx_header *p_header, uint8_t adata[], uint32_t *ptxmailbox)
+{
+    lnx_can_inst *inst = ioal_hcan->intf_gen_info.vdp_intf_inst_hdle;
+    struct can_frame frame;
+
+    if ((inst == NULL) || (inst->state != IOHAL_CAN_STATE_LISTENING))
+    {
+        return HAL_IO_VDP_ERR;
+    }
+    io_hal_linux_can_tx_frame(p_header, adata, &frame);
+    if (write(inst->fd, &frame, sizeof(frame)) != sizeof(frame))
+    {
+        return HAL_IO_VDP_ERR;
+    }
+    if (ptxmailbox != NULL)
+    {
+        *ptxmailbox = 0;
+    }
+    return HAL_SCS;
+}
+
+/**
+ * @brief IO-HAL CAN get Rx message function for linux
+ */
+hal_ret_sts io_hal_linux_get_rx_message(ioal_can_hdle *ioal_hcan, uint32_t rxfifo, iohal_can_rx_header *p_header, uint8_t adata[])
+{
+    lnx_can_inst *inst = ioal_hcan->intf_gen_info.vdp_intf_inst_hdle;
+    struct can_frame frame;
+    struct iovec iov;
+    struct msghdr msg;
+    lnx_can_cmsg ctrl;
+
+    if ((inst == NULL) || (inst->state != IOHAL_CAN_STATE_LISTENING))
+    {
+        return HAL_IO_VDP_ERR;
+    }
+    iov.iov_base = &frame;
+    iov.iov_len = sizeof(frame);
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = ctrl.buf;
+    msg.msg_controllen = sizeof(ctrl.buf);
+    if (recvmsg(inst->fd, &msg, MSG_DONTWAIT) != sizeof(frame))
+    {
+        return HAL_IO_VDP_ERR;
+    }
+    io_hal_linux_can_rx_frame(&frame, &msg, p_header, adata);
+    return HAL_SCS;
+}
+
+/**
+ * @brief IO-HAL CAN filter configuration function for linux
+ */
+hal_ret_sts io_hal_linux_can_configfilter(ioal_can_hdle *ioal_hcan, iohal_can_filter *sFilterConfig)
+{
+    lnx_can_inst *inst = ioal_hcan->intf_gen_info.vdp_intf_inst_hdle;
+    uint32_t id_reg;
+    uint32_t mask_reg;
+    struct can_filter *filter;
+
+    if ((inst == NULL) || (inst->fd < 0) || (sFilterConfig->FilterBank >= LNX_CAN_FILTER_BANKS) ||
+        (sFilterConfig->FilterScale != CAN_FILTERSCALE_32BIT))
+    {
+        return HAL_IO_VDP_ERR;
+    }
+
+    filter = inst->filter[sFilterConfig->FilterBank];
+    inst->filter_cnt[sFilterConfig->FilterBank] = 0;
+    if (sFilterConfig->FilterActivation == CAN_FILTER_ENABLE)
+    {
+        id_reg = ((sFilterConfig->FilterIdHigh & 0xFFFFU) << 16) | (sFilterConfig->FilterIdLow & 0xFFFFU);
+        mask_reg = ((sFilterConfig->FilterMaskIdHigh & 0xFFFFU) << 16) | (sFilterConfig->FilterMaskIdLow & 0xFFFFU);
+
+        filter[0].can_id = io_hal_linux_can_filter_id(id_reg);
+        if (sFilterConfig->FilterMode == CAN_FILTERMODE_IDMASK)
+        {
+            filter[0].can_mask = io_hal_linux_can_filter_mask(mask_reg, id_reg);
+            inst->filter_cnt[sFilterConfig->FilterBank] = 1;
+        }
+        else
+        {
+            // Identifier list mode, both registers hold an identifier to match exactly
+            filter[1].can_id = io_hal_linux_can_filter_id(mask_reg);
+            filter[0].can_mask = CAN_EFF_FLAG | CAN_RTR_FLAG | ((filter[0].can_id & CAN_EFF_FLAG) ? CAN_EFF_MASK : CAN_SFF_MASK);
+            filter[1].can_mask = CAN_EFF_FLAG | CAN_RTR_FLAG | ((filter[1].can_id & CAN_EFF_FLAG) ? CAN_EFF_MASK : CAN_SFF_MASK);
+            inst->filter_cnt[sFilterConfig->FilterBank] = 2;
+        }
+    }
+    return io_hal_linux_can_apply_filters(inst);
+}
+
+/**
+ * @brief IO-HAL CAN get state function for linux
+ */
+iohal_can_state io_hal_linux_can_get_state(ioal_can_hdle *ioal_hcan)
+{
+    lnx_can_inst *inst = ioal_hcan->intf_gen_info.vdp_intf_inst_hdle;
+
+    if (inst == NULL)
+    {
+        return IOHAL_CAN_STATE_RESET;
+    }
+    return inst->state;
+}
+
+/**
+ * @brief Transmit several frames with a single sendmmsg() call
+ */
+int io_hal_linux_can_send_batch(ioal_can_hdle *ioal_hcan, iohal_can_tx_header p_header[], uint8_t adata[][8], uint32_t count)
+{
+    lnx_can_inst *inst = ioal_hcan->intf_gen_info.vdp_intf_inst_hdle;
+    struct can_frame frame[LNX_CAN_BATCH_MAX];
+    struct iovec iov[LNX_CAN_BATCH_MAX];
+    struct mmsghdr msgs[LNX_CAN_BATCH_MAX];
+    uint32_t idx;
+
+    if ((inst == NULL) || (inst->state != IOHAL_CAN_STATE_LISTENING))
+    {
+        errno = ENODEV;
+        return -1;
+    }
+    if (count > LNX_CAN_BATCH_MAX)
+    {
+        count = LNX_CAN_BATCH_MAX;
+    }
+    memset(msgs, 0, count * sizeof(msgs[0]));
+    for (idx = 0; idx < count; idx++)
+    {
+        io_hal_linux_can_tx_frame(&p_header[idx], adata[idx], &frame[idx]);
+        iov[idx].iov_base = &frame[idx];
+        iov[idx].iov_len = sizeof(frame[idx]);
+        msgs[idx].msg_hdr.msg_iov = &iov[idx];
+        msgs[idx].msg_hdr.msg_iovlen = 1;
+    }
+    return sendmmsg(inst->fd, msgs, count, 0);
+}
+
+/**
+ * @brief Wait until the socket accepts frames again
+ */
+int io_hal_linux_can_wait_tx(ioal_can_hdle *ioal_hcan, int timeout_ms)
+{
+    lnx_can_inst *inst = ioal_hcan->intf_gen_info.vdp_intf_inst_hdle;
+    struct pollfd pfd;
+    int ret;
+
+    if ((inst == NULL) || (inst->state != IOHAL_CAN_STATE_LISTENING))
+    {
+        errno = ENODEV;
+        return -1;
+    }
+    pfd.fd = inst->fd;
+    pfd.events = POLLOUT;
+    ret = poll(&pfd, 1, timeout_ms);
+    if (ret < 0)
+    {
+        return (errno == EINTR) ? 0 : -1;
+    }
+    return ret;
+}
+
+/**
+ * @brief Receive several frames with a single recvmmsg() call
+ */
+int io_hal_linux_can_recv_batch(ioal_can_hdle *ioal_hcan, iohal_can_rx_header p_header[], uint8_t adata[][8], uint32_t count, int timeout_ms)
+{
+    lnx_can_inst *inst = ioal_hcan->intf_gen_info.vdp_intf_inst_hdle;
+    struct can_frame frame[LNX_CAN_BATCH_MAX];
+    struct iovec iov[LNX_CAN_BATCH_MAX];
+    struct mmsghdr msgs[LNX_CAN_BATCH_MAX];
+    lnx_can_cmsg ctrl[LNX_CAN_BATCH_MAX];
+    struct pollfd pfd;
+    uint32_t idx;
+    int ret;
+
+    if ((inst == NULL) || (inst->state != IOHAL_CAN_STATE_LISTENING))
+    {
+        errno = ENODEV;
+        return -1;
+    }
+    if (count > LNX_CAN_BATCH_MAX)
+    {
+        count = LNX_CAN_BATCH_MAX;
+    }
+
+    // Wait for the first frame, then drain whatever has queued up without blocking
+    pfd.fd = inst->fd;
+    pfd.events = POLLIN;
+    ret = poll(&pfd, 1, timeout_ms);
+    if (ret <= 0)
+    {
+        return ((ret < 0) && (errno == EINTR)) ? 0 : ret;
+    }
+
+    memset(msgs, 0, count * sizeof(msgs[0]));
+    for (idx = 0; idx < count; idx++)
+    {
+        iov[idx].iov_base = &frame[idx];
+        iov[idx].iov_len = sizeof(frame[idx]);
+        msgs[idx].msg_hdr.msg_iov = &iov[idx];
+        msgs[idx].msg_hdr.msg_iovlen = 1;
+        msgs[idx].msg_hdr.msg_control = ctrl[idx].buf;
+        msgs[idx].msg_hdr.msg_controllen = sizeof(ctrl[idx].buf);
+    }
+    ret = recvmmsg(inst->fd, msgs, count, MSG_DONTWAIT, NULL);
+    if (ret < 0)
+    {
+        return ((errno == EAGAIN) || (errno == EINTR)) ? 0 : -1;
+    }
+    for (idx = 0; idx < (uint32_t)ret; idx++)
+    {
+        io_hal_linux_can_rx_frame(&frame[idx], &msgs[idx].msg_hdr, &p_header[idx], adata[idx]);
+    }
+    return ret;
 }
@@ -22,6 +22,52 @@
 #define _IO_AL_LINUX_CAN_H_
 
 #include "exo_hal_common.h"
+#include "exo_io_al_can_common.h"
+
+/**
+ * @brief SocketCAN network devices used for the CAN instances (e.g. "can0" or "vcan0")
+ */
+#ifndef LNX_CAN1_DEV
+#define LNX_CAN1_DEV                "vcan0"
+#endif
+#ifndef LNX_CAN2_DEV
+#define LNX_CAN2_DEV                "vcan0"
+#endif
+#ifndef LNX_CAN3_DEV
+#define LNX_CAN3_DEV                "vcan0"
+#endif
+
+#define LNX_CAN_FILTER_BANKS        28U     ///< Number of filter banks, same as the STM32 bxCAN
+#define LNX_CAN_BATCH_MAX           32U     ///< Maximum number of frames moved by one batch call
+
+/**
+ * @brief Frame and filter constants, same values as the STM32 HAL so that
+ *        users of the IO-AL CAN API build unchanged on linux
+ */
+#ifndef CAN_ID_STD
+#define CAN_ID_STD                  (0x00000000U)   ///< Standard identifier
+#define CAN_ID_EXT                  (0x00000004U)   ///< Extended identifier
+#endif
+#ifndef CAN_RTR_DATA
+#define CAN_RTR_DATA                (0x00000000U)   ///< Data frame
+#define CAN_RTR_REMOTE              (0x00000002U)   ///< Remote frame
+#endif
+#ifndef CAN_RX_FIFO0
+#define CAN_RX_FIFO0                (0x00000000U)   ///< CAN receive FIFO 0
+#define CAN_RX_FIFO1                (0x00000001U)   ///< CAN receive FIFO 1
+#endif
+#ifndef CAN_FILTERMODE_IDMASK
+#define CAN_FILTERMODE_IDMASK       (0x00000000U)   ///< Identifier mask mode
+#define CAN_FILTERMODE_IDLIST       (0x00000001U)   ///< Identifier list mode
+#endif
+#ifndef CAN_FILTERSCALE_32BIT
+#define CAN_FILTERSCALE_16BIT       (0x00000000U)   ///< Two 16-bit filters
+#define CAN_FILTERSCALE_32BIT       (0x00000001U)   ///< One 32-bit filter
+#endif
+#ifndef CAN_FILTER_ENABLE
+#define CAN_FILTER_DISABLE          (0x00000000U)   ///< Disable filter
+#define CAN_FILTER_ENABLE           (0x00000001U)   ///< Enable filter
+#endif
 
 /**
  * @brief IO-HAL CAN1 initialization function for linux
@@ -58,11 +104,82 @@ hal_ret_sts io_hal_linux_can_start(void *ioal_hcan);
  */
 hal_ret_sts io_hal_linux_can_stop(void *ioal_hcan);
 
+/**
+ * @brief IO-HAL CAN add Tx message function for linux
+ * @param[in] ioal_hcan - pointer to CAN instance
+ * @param[in] p_header - pointer to Tx header
+ * @param[in] adata - payload of the frame
+ * @param[out] ptxmailbox - always set to 0, SocketCAN has no mailboxes
+ * @retval HAL status
+ */
+hal_ret_sts io_hal_linux_add_tx_message(ioal_can_hdle *ioal_hcan, iohal_can_tx_header *p_header, uint8_t adata[], uint32_t *ptxmailbox);
+
+/**
+ * @brief IO-HAL CAN get Rx message function for linux. Does not block,
+ *        fails when no frame is pending, like an empty STM32 Rx FIFO.
+ * @param[in] ioal_hcan - pointer to CAN instance
+ * @param[in] rxfifo - ignored, SocketCAN has a single receive queue
+ * @param[out] p_header - Rx header, Timestamp holds the kernel receive time in uS
+ * @param[out] adata - payload of the frame
+ * @retval HAL status
+ */
+hal_ret_sts io_hal_linux_get_rx_message(ioal_can_hdle *ioal_hcan, uint32_t rxfifo, iohal_can_rx_header *p_header, uint8_t adata[]);
+
+/**
+ * @brief IO-HAL CAN filter configuration function for linux. The filter bank
+ *        is decoded from the STM32 register layout and programmed into the
+ *        kernel with CAN_RAW_FILTER, only 32-bit scale is supported.
+ * @param[in] ioal_hcan - pointer to CAN instance
+ * @param[in] sFilterConfig - pointer to filter configuration
+ * @retval HAL status
+ */
+hal_ret_sts io_hal_linux_can_configfilter(ioal_can_hdle *ioal_hcan, iohal_can_filter *sFilterConfig);
+
+/**
+ * @brief IO-HAL CAN get state function for linux
+ * @param[in] ioal_hcan - pointer to CAN instance
+ * @retval CAN state
+ */
+iohal_can_state io_hal_linux_can_get_state(ioal_can_hdle *ioal_hcan);
+
+/**
+ * @brief Transmit several frames with a single sendmmsg() call
+ * @param[in] ioal_hcan - pointer to CAN instance
+ * @param[in] p_header - array of count Tx headers
+ * @param[in] adata - array of count payloads
+ * @param[in] count - number of frames, at most LNX_CAN_BATCH_MAX
+ * @retval Number of frames queued to the device, -1 on error (errno is set)
+ */
+int io_hal_linux_can_send_batch(ioal_can_hdle *ioal_hcan, iohal_can_tx_header p_header[], uint8_t adata[][8], uint32_t count);
+
+/**
+ * @brief Wait until the socket can queue frames again, used after a send returned ENOBUFS
+ * @param[in] ioal_hcan - pointer to CAN instance
+ * @param[in] timeout_ms - time to wait, negative waits forever
+ * @retval 1 when writable, 0 on timeout, -1 on error (errno is set)
+ */
+int io_hal_linux_can_wait_tx(ioal_can_hdle *ioal_hcan, int timeout_ms);
+
+/**
+ * @brief Receive several frames with a single recvmmsg() call
+ * @param[in] ioal_hcan - pointer to CAN instance
+ * @param[out] p_header - array of count Rx headers, Timestamp holds the kernel receive time in uS
+ * @param[out] adata - array of count payloads
+ * @param[in] count - size of the arrays, at most LNX_CAN_BATCH_MAX frames are read
+ * @param[in] timeout_ms - time to wait for the first frame, negative waits forever
+ * @retval Number of frames received, 0 on timeout, -1 on error (errno is set)
+ */
+int io_hal_linux_can_recv_batch(ioal_can_hdle *ioal_hcan, iohal_can_rx_header p_header[], uint8_t adata[][8], uint32_t count, int timeout_ms);
+
 /** IOAL CAN function mapping **/
 #define io_hal_common_can1_init             io_hal_linux_can1_init
 #define io_hal_common_can2_init             io_hal_linux_can2_init
 #define io_hal_common_can3_init             io_hal_linux_can3_init
 #define io_hal_common_can_start             io_hal_linux_can_start
 #define io_hal_common_can_stop              io_hal_linux_can_stop
+#define io_hal_common_add_tx_message        io_hal_linux_add_tx_message
+#define io_hal_common_get_rx_message        io_hal_linux_get_rx_message
+#define io_hal_common_can_configfilter      io_hal_linux_can_configfilter
+#define io_hal_common_can_get_state         io_hal_linux_can_get_state
 
 #endif
@@ -19,50 +19,452 @@
  */
 
 #include <stdio.h>
+#include <string.h>
 #include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/ioctl.h>
+#include <linux/gpio.h>
 #include "exo_io_al_linux_gpio.h"
 #include "exo_hal_io_al_common.h"
 #include "exo_common.h"
+#include "exo_osal.h"
 //table to save callback function and io_handle used by application hardware if pin configured as external interrupt
 exti_handler_details_t *ioal_gpio_exti_io_intf_hdle_ptr[MC_AVAILABLE_EXTI_PINS];
 
+/**
+ * @brief Line request of one port, the configured pins of a port share one
+ *        request so that a port is read or driven with a single ioctl
+ */
+typedef struct
+{
+    int fd;                                                     /*!< Line request, -1 when no pin is configured */
+    uint16_t used;                                              /*!< Pins in the request                        */
+    uint16_t edge;                                              /*!< Pins with edge detection                   */
+    uint16_t out_val;                                           /*!< Last value driven on the output pins       */
+    uint8_t idx[MC_PORT_REGISTER_PIN_COUNT];                    /*!< Position of each pin in the request        */
+    uint64_t flags[MC_PORT_REGISTER_PIN_COUNT];                 /*!< Line flags of each pin                     */
+} lnx_gpio_port;
+
+static const char *gpio_chip_dev = LNX_GPIO_CHIP_DEV;           ///< GPIO character device path
+static int gpio_chip_fd = -1;                                   ///< GPIO character device
+static lnx_gpio_port gpio_port[MC_AVAILABLE_GPIO_PORTS];        ///< Line requests of the ports
+static uint8_t gpio_port_init = 0;                              ///< Line requests invalidated at first use
+static uint32_t gpio_port_gen = 0;                              ///< Incremented when a line request is replaced
+static uint8_t gpio_evt_started = 0;                            ///< Event thread created
+static pthread_mutex_t gpio_lock = PTHREAD_MUTEX_INITIALIZER;   ///< Serialise request changes with the event thread
+
 /*!
- *  @brief This API configure pin as output by invoking STM32 HAL API
+ *  @brief Map the IO-AL mode and pull configuration to line flags
  */
-gpio_ret_sts io_hal_linux_gpio_config(gpio_config_info_hdl config_details)
+static uint64_t lnx_gpio_line_flags(uint32_t mode, uint32_t pull_sts)
 {
+    uint64_t flags;
+    switch(mode)
+    {
+        case IOAL_GPIO_MODE_OUTPUT_PP:
+            flags = GPIO_V2_LINE_FLAG_OUTPUT;
+            break;
+        case IOAL_GPIO_MODE_OUTPUT_OD:
+            flags = GPIO_V2_LINE_FLAG_OUTPUT | GPIO_V2_LINE_FLAG_OPEN_DRAIN;
+            break;
+        case IOAL_GPIO_MODE_IT_RISING:
+            flags = GPIO_V2_LINE_FLAG_INPUT | GPIO_V2_LINE_FLAG_EDGE_RISING;
+            break;
+        case IOAL_GPIO_MODE_IT_FALLING:
+            flags = GPIO_V2_LINE_FLAG_INPUT | GPIO_V2_LINE_FLAG_EDGE_FALLING;
+            break;
+        case IOAL_GPIO_MODE_IT_RISING_FALLING:
+            flags = GPIO_V2_LINE_FLAG_INPUT | GPIO_V2_LINE_FLAG_EDGE_RISING | GPIO_V2_LINE_FLAG_EDGE_FALLING;
+            break;
+        default:
+            flags = GPIO_V2_LINE_FLAG_INPUT;
+            break;
+    }
+    switch(pull_sts)
+    {
+        case IOAL_GPIO_PULLUP:
+            flags |= GPIO_V2_LINE_FLAG_BIAS_PULL_UP;
+            break;
+        case IOAL_GPIO_PULLDOWN:
+            flags |= GPIO_V2_LINE_FLAG_BIAS_PULL_DOWN;
+            break;
+        default:
+            break;
+    }
+    return flags;
+}
 
-    return GPIO_OK;
+/*!
+ *  @brief Request the lines of a port with their per-pin flags and output values.
+ *         Pins with the flags of the first pin use the request default, every
+ *         other set of flags takes one attribute.
+ */
+static int lnx_gpio_port_request(uint16_t port_name, lnx_gpio_port *port)
+{
+    struct gpio_v2_line_request req;
+    struct gpio_v2_line_config_attribute *attr;
+    uint16_t done = 0;
+    uint16_t out_mask = 0;
+    uint32_t n = 0;
+    uint32_t pin;
+    uint32_t other;
+
+    memset(&req, 0, sizeof(req));
+    strncpy(req.consumer, "exo_io_al", sizeof(req.consumer) - 1);
+    for(pin = 0; pin < MC_PORT_REGISTER_PIN_COUNT; pin++)
+    {
+        if(port->used & (1u << pin))
+        {
+            port->idx[pin] = n;
+            req.offsets[n++] = port_name * MC_PORT_REGISTER_PIN_COUNT + pin;
+            if(port->flags[pin] & GPIO_V2_LINE_FLAG_OUTPUT)
+            {
+                out_mask |= (1u << pin);
+            }
+        }
+    }
+    req.num_lines = n;
+    for(pin = 0; pin < MC_PORT_REGISTER_PIN_COUNT; pin++)
+    {
+        if(!(port->used & (1u << pin)) || (done & (1u << pin)))
+        {
+            continue;
+        }
+        attr = NULL;
+        if(done == 0)
+        {
+            req.config.flags = port->flags[pin];
+        }
+        else
+        {
+            // One attribute stays free for the output values
+            if(req.config.num_attrs >= GPIO_V2_LINE_NUM_ATTRS_MAX - 1)
+            {
+                return -1;
+            }
+            attr = &req.config.attrs[req.config.num_attrs++];
+            attr->attr.id = GPIO_V2_LINE_ATTR_ID_FLAGS;
+            attr->attr.flags = port->flags[pin];
+        }
+        for(other = pin; other < MC_PORT_REGISTER_PIN_COUNT; other++)
+        {
+            if((port->used & (1u << other)) && port->flags[other] == port->flags[pin])
+            {
+                done |= (1u << other);
+                if(attr != NULL)
+                {
+                    attr->mask |= (1ull << port->idx[other]);
+                }
+            }
+        }
+    }
+    if(out_mask)
+    {
+        attr = &req.config.attrs[req.config.num_attrs++];
+        attr->attr.id = GPIO_V2_LINE_ATTR_ID_OUTPUT_VALUES;
+        for(pin = 0; pin < MC_PORT_REGISTER_PIN_COUNT; pin++)
+        {
+            if(out_mask & (1u << pin))
+            {
+                attr->mask |= (1ull << port->idx[pin]);
+                if(port->out_val & (1u << pin))
+                {
+                    attr->attr.values |= (1ull << port->idx[pin]);
+                }
+            }
+        }
+    }
+    if(ioctl(gpio_chip_fd, GPIO_V2_GET_LINE_IOCTL, &req) < 0)
+    {
+        return -1;
+    }
+    port->fd = req.fd;
+    return 0;
+}
+
+/*!
+ *  @brief Edge event thread, reads the line events of all ports and runs the
+ *         callbacks of the external interrupt table like the STM32 EXTI handler
+ */
+static void lnx_gpio_evt_hdlr(void *args)
+{
+    struct pollfd pfd[MC_AVAILABLE_GPIO_PORTS];
+    uint16_t pfd_port[MC_AVAILABLE_GPIO_PORTS];
+    struct gpio_v2_line_event evt[LNX_GPIO_EVT_BATCH];
+    exti_handler_details_t exti[LNX_GPIO_EVT_BATCH];
+    uint32_t nexti;
+    uint32_t gen;
+    uint32_t nfds;
+    uint32_t i;
+    ssize_t len;
+    int k;
+
+    while(1)
+    {
+        nfds = 0;
+        nexti = 0;
+        pthread_mutex_lock(&gpio_lock);
+        gen = gpio_port_gen;
+        for(i = 0; i < MC_AVAILABLE_GPIO_PORTS; i++)
+        {
+            if(gpio_port[i].fd >= 0 && gpio_port[i].edge)
+            {
+                pfd[nfds].fd = gpio_port[i].fd;
+                pfd[nfds].events = POLLIN;
+                pfd_port[nfds++] = i;
+            }
+        }
+        pthread_mutex_unlock(&gpio_lock);
+
+        if(poll(pfd, nfds, LNX_GPIO_EVT_POLL_MS) <= 0)
+        {
+            continue;
+        }
+        pthread_mutex_lock(&gpio_lock);
+        if(gen != gpio_port_gen)
+        {
+            // A request was replaced while polling, its fd may be stale
+            pthread_mutex_unlock(&gpio_lock);
+            continue;
+        }
+        for(i = 0; i < nfds; i++)
+        {
+            // Events left in the kernel buffer are picked up by the next poll
+            if(!(pfd[i].revents & POLLIN) || nexti == LNX_GPIO_EVT_BATCH)
+            {
+                continue;
+            }
+            len = read(pfd[i].fd, evt, (LNX_GPIO_EVT_BATCH - nexti) * sizeof(evt[0]));
+            for(k = 0; len > 0 && k < (int)(len / sizeof(evt[0])); k++)
+            {
+                uint16_t pin = evt[k].offset % MC_PORT_REGISTER_PIN_COUNT;
+                if((gpio_port[pfd_port[i]].edge & (1u << pin)) && ioal_gpio_exti_io_intf_hdle_ptr[pin] != NULL)
+                {
+                    exti[nexti++] = *ioal_gpio_exti_io_intf_hdle_ptr[pin];
+                }
+            }
+        }
+        pthread_mutex_unlock(&gpio_lock);
+
+        // Callbacks run unlocked, they may access or reconfigure pins
+        for(i = 0; i < nexti; i++)
+        {
+            if(exti[i].isr_handler != NULL)
+            {
+                exti[i].isr_handler(exti[i].isr_args);
+            }
+        }
+    }
+}
+
+/*!
+ *  @brief Add a pin to the line request of its port, the request is replaced
+ *         by one holding the previous pins and the new one
+ */
+static gpio_ret_sts lnx_gpio_line_config(gpio_config_info_hdl config_details)
+{
+    gpio_ret_sts ret = GPIO_OK;
+    uint16_t port_name = config_details->port.port_name;
+    uint16_t pin = config_details->port.port_pin_number;
+    uint16_t bit = (uint16_t)(1u << pin);
+    lnx_gpio_port *port;
+    lnx_gpio_port prev;
+
+    if(gpio_chip_dev == NULL)
+    {
+        return GPIO_OK;
+    }
+    if(port_name >= MC_AVAILABLE_GPIO_PORTS || pin >= MC_PORT_REGISTER_PIN_COUNT)
+    {
+        return GPIO_INVALID;
+    }
+
+    pthread_mutex_lock(&gpio_lock);
+    if(!gpio_port_init)
+    {
+        for(uint32_t i = 0; i < MC_AVAILABLE_GPIO_PORTS; i++)
+        {
+            gpio_port[i].fd = -1;
+        }
+        gpio_port_init = 1;
+    }
+    if(gpio_chip_fd < 0)
+    {
+        gpio_chip_fd = open(gpio_chip_dev, O_RDWR);
+        if(gpio_chip_fd < 0)
+        {
+            perror("Unable to open GPIO chip");
+            pthread_mutex_unlock(&gpio_lock);
+            return GPIO_NOK;
+        }
+    }
+
+    port = &gpio_port[port_name];
+    prev = *port;
+    port->used |= bit;
+    port->flags[pin] = lnx_gpio_line_flags(config_details->mode, config_details->pull_sts);
+    if(port->flags[pin] & (GPIO_V2_LINE_FLAG_EDGE_RISING | GPIO_V2_LINE_FLAG_EDGE_FALLING))
+    {
+        port->edge |= bit;
+    }
+    else
+    {
+        port->edge &= ~bit;
+    }
+
+    // The lines are still held by the previous request
+    if(port->fd >= 0)
+    {
+        close(port->fd);
+        port->fd = -1;
+    }
+    gpio_port_gen++;
+    if(lnx_gpio_port_request(port_name, port) < 0)
+    {
+        perror("Unable to request GPIO lines");
+        *port = prev;
+        port->fd = -1;
+        if(prev.used && lnx_gpio_port_request(port_name, port) < 0)
+        {
+            perror("Unable to restore GPIO lines");
+        }
+        ret = GPIO_NOK;
+    }
+    pthread_mutex_unlock(&gpio_lock);
+
+    if(ret == GPIO_OK && (port->edge & bit) && !gpio_evt_started)
+    {
+        if(os_thread_create(IOAL_GPIO_EVT_HDLR, T_HAL_INTR_SIZE, P_HAL_INTR_HDLR, "ioal_gpio_evt_hdlr", lnx_gpio_evt_hdlr, NULL, NULL, NULL) == os_success)
+        {
+            gpio_evt_started = 1;
+        }
+        else
+        {
+            ret = GPIO_NOK;
+        }
+    }
+    return ret;
 }
 
 /*!
- *  @brief This API configure pin as interrpt by invoking STM32 HAL API
+ *  @brief This API configure pin as input or output through the GPIO character device
+ */
+gpio_ret_sts io_hal_linux_gpio_config(gpio_config_info_hdl config_details)
+{
+    return lnx_gpio_line_config(config_details);
+}
+
+/*!
+ *  @brief This API configure pin as interrpt through the GPIO character device
  */
 gpio_ret_sts io_hal_linux_gpio_interrupt_config(gpio_config_info_hdl config_details)
 {
+    return lnx_gpio_line_config(config_details);
+}
+
+/*!
+ *  @brief This API reads the pins of a port selected by mask with one ioctl
+ */
+uint16_t io_hal_linux_gpio_read_port(uint16_t port_name, uint16_t mask)
+{
+    struct gpio_v2_line_values vals;
+    lnx_gpio_port *port;
+    uint16_t value = 0;
+
+    if(port_name >= MC_AVAILABLE_GPIO_PORTS || !gpio_port_init || gpio_port[port_name].fd < 0)
+    {
+        return mask;
+    }
+    port = &gpio_port[port_name];
+    mask &= port->used;
+    memset(&vals, 0, sizeof(vals));
+    for(uint32_t pin = 0; pin < MC_PORT_REGISTER_PIN_COUNT; pin++)
+    {
+        if(mask & (1u << pin))
+        {
+            vals.mask |= (1ull << port->idx[pin]);
+        }
+    }
+    if(vals.mask == 0 || ioctl(port->fd, GPIO_V2_LINE_GET_VALUES_IOCTL, &vals) < 0)
+    {
+        return 0;
+    }
+    for(uint32_t pin = 0; pin < MC_PORT_REGISTER_PIN_COUNT; pin++)
+    {
+        if((mask & (1u << pin)) && (vals.bits & (1ull << port->idx[pin])))
+        {
+            value |= (1u << pin);
+        }
+    }
+    return value;
+}
+
+/*!
+ *  @brief This API drives the pins of a port selected by mask with one ioctl
+ */
+gpio_ret_sts io_hal_linux_gpio_write_port(uint16_t port_name, uint16_t mask, uint16_t value)
+{
+    struct gpio_v2_line_values vals;
+    lnx_gpio_port *port;
+
+    if(port_name >= MC_AVAILABLE_GPIO_PORTS || !gpio_port_init || gpio_port[port_name].fd < 0)
+    {
+        return GPIO_OK;
+    }
+    port = &gpio_port[port_name];
+    memset(&vals, 0, sizeof(vals));
+    for(uint32_t pin = 0; pin < MC_PORT_REGISTER_PIN_COUNT; pin++)
+    {
+        if((mask & port->used & (1u << pin)) && (port->flags[pin] & GPIO_V2_LINE_FLAG_OUTPUT))
+        {
+            vals.mask |= (1ull << port->idx[pin]);
+            if(value & (1u << pin))
+            {
+                vals.bits |= (1ull << port->idx[pin]);
+            }
+        }
+    }
+    if(vals.mask == 0)
+    {
+        return GPIO_OK;
+    }
+    if(ioctl(port->fd, GPIO_V2_LINE_SET_VALUES_IOCTL, &vals) < 0)
+    {
+        return GPIO_NOK;
+    }
+    port->out_val = (port->out_val & ~mask) | (value & mask);
     return GPIO_OK;
 }
 
 /*!
- *  @brief This API drive pin number as LOW/HIGH by invoking STM32 HAL API
+ *  @brief This API drive pin number as LOW/HIGH through the GPIO character device
  */
 gpio_ret_sts io_hal_linux_gpio_write(gpio_port_details *port, uint32_t drive_logic)
 {
-    return GPIO_OK;
+    uint16_t bit = (uint16_t)(1u << port->port_pin_number);
+    return io_hal_linux_gpio_write_port(port->port_name, bit, (drive_logic == GPIO_DRIVE_LOW) ? 0 : bit);
 }
 
 /*!
- *  @brief This API read pin number state by invoking STM32 HAL API
+ *  @brief This API read pin number state through the GPIO character device
  */
 uint32_t io_hal_linux_gpio_read(gpio_port_details *port)
 {
-    return 1;
+    uint16_t bit = (uint16_t)(1u << port->port_pin_number);
+    return (io_hal_linux_gpio_read_port(port->port_name, bit) & bit) ? 1 : 0;
 }
 
 /*!
- *  @brief This API toggles pin number by invoking STM32 HAL API
+ *  @brief This API toggles pin number through the GPIO character device
  */
 gpio_ret_sts io_hal_linux_gpio_toggle(gpio_port_details *port)
 {
-    return GPIO_OK;
+    uint16_t bit = (uint16_t)(1u << port->port_pin_number);
+    if(port->port_name >= MC_AVAILABLE_GPIO_PORTS || !gpio_port_init)
+    {
+        return GPIO_OK;
+    }
+    return io_hal_linux_gpio_write_port(port->port_name, bit, gpio_port[port->port_name].out_val ^ bit);
 }
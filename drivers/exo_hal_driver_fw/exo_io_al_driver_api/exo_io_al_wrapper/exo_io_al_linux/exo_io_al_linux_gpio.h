@@ -28,29 +28,28 @@
 #define MC_AVAILABLE_GPIO_PINS                        ((uint16_t)114U)
 
 /* Provide total number of  external interrupts available in uc */
-#define MC_AVAILABLE_EXTI_PINS                        ((uint16_t)15U)
+#define MC_AVAILABLE_EXTI_PINS                        ((uint16_t)16U)
 
 /* Provide total number of pins available in a single port (i.e) 16 pins in PORTA*/
 #define MC_PORT_REGISTER_PIN_COUNT                    ((uint16_t)16U)
 
-/* Provide starting base address of gpio peripheral*/
-#define MC_GPIO_BASE_ADDRESS                          AHB1PERIPH_BASE
+/* Provide number of ports, each port is a bank of MC_PORT_REGISTER_PIN_COUNT lines */
+#define MC_AVAILABLE_GPIO_PORTS                       ((MC_AVAILABLE_GPIO_PINS / MC_PORT_REGISTER_PIN_COUNT) + 1U)
 
-/* Provide window size between two ports (i.e) length between PORTA and PORTB is 0x400*/
-#define GPIO_PORT_ADDR_WINDOW_SIZE                    0x400u
+/**
+ * @brief GPIO character device backing the MCU pins (e.g. "/dev/gpiochip0").
+ *        Pin n of port p is line (p * MC_PORT_REGISTER_PIN_COUNT + n) of the
+ *        chip. Without a device the pins keep the stub behaviour.
+ */
+#ifndef LNX_GPIO_CHIP_DEV
+#define LNX_GPIO_CHIP_DEV                             NULL
+#endif
 
-/* Provide model configuration value of uc*/
-#define  IOAL_GPIO_MODE_INPUT          1
-#define  IOAL_GPIO_MODE_OUTPUT_PP      2
-#define  IOAL_GPIO_MODE_OUTPUT_OD      3
-#define  IOAL_GPIO_MODE_IT_RISING      4
-#define  IOAL_GPIO_MODE_IT_FALLING     5
-#define  IOAL_GPIO_MODE_IT_RISING_FALLING 6
+/* Edge events read from a port per read() call */
+#define LNX_GPIO_EVT_BATCH                            16U
 
-/* Provide push/pull configuration value of uc*/
-#define  IOAL_GPIO_NOPULL   0
-#define  IOAL_GPIO_PULLUP   1
-#define  IOAL_GPIO_PULLDOWN 2
+/* Event thread poll interval, bounds the time to pick up a reconfigured port */
+#define LNX_GPIO_EVT_POLL_MS                          100
 
 /**
  * @brief External interrupt pointer table structure.
@@ -79,30 +78,40 @@ typedef struct
 typedef gpio_config_info* gpio_config_info_hdl;
 
 /*!
- *  @brief This API configure pin as output by invoking STM32 HAL API
+ *  @brief This API configure pin as output through the GPIO character device
  */
 gpio_ret_sts io_hal_linux_gpio_config(gpio_config_info_hdl config_details);
 
 /*!
- *  @brief This API configure pin as interrpt by invoking STM32 HAL API
+ *  @brief This API configure pin as interrpt through the GPIO character device
  */
 gpio_ret_sts io_hal_linux_gpio_interrupt_config(gpio_config_info_hdl config_details);
 
 /*!
- *  @brief This API drive pin number as LOW/HIGH by invoking STM32 HAL API
+ *  @brief This API drive pin number as LOW/HIGH through the GPIO character device
  */
 gpio_ret_sts io_hal_linux_gpio_write(gpio_port_details *port, uint32_t drive_logic);
 
 /*!
- *  @brief This API read pin number state by invoking STM32 HAL API
+ *  @brief This API read pin number state through the GPIO character device
  */
 uint32_t io_hal_linux_gpio_read(gpio_port_details *port);
 
 /*!
- *  @brief This API toggles pin number by invoking STM32 HAL API
+ *  @brief This API toggles pin number through the GPIO character device
  */
 gpio_ret_sts io_hal_linux_gpio_toggle(gpio_port_details *port);
 
+/*!
+ *  @brief This API reads the pins of a port selected by mask with one ioctl
+ */
+uint16_t io_hal_linux_gpio_read_port(uint16_t port_name, uint16_t mask);
+
+/*!
+ *  @brief This API drives the pins of a port selected by mask with one ioctl
+ */
+gpio_ret_sts io_hal_linux_gpio_write_port(uint16_t port_name, uint16_t mask, uint16_t value);
+
 /** IOAL GPIO interface handler pointer**/
 extern exti_handler_details_t *ioal_gpio_exti_io_intf_hdle_ptr[MC_AVAILABLE_EXTI_PINS];
 
@@ -112,5 +121,7 @@ extern exti_handler_details_t *ioal_gpio_exti_io_intf_hdle_ptr[MC_AVAILABLE_EXTI
 #define io_hal_common_gpio_toggle io_hal_linux_gpio_toggle
 #define io_hal_common_gpio_interrupt_config io_hal_linux_gpio_interrupt_config
 #define io_hal_common_gpio_config io_hal_linux_gpio_config
+#define io_hal_common_gpio_read_port io_hal_linux_gpio_read_port
+#define io_hal_common_gpio_write_port io_hal_linux_gpio_write_port
 
 #endif /* _IO_AL_LINUX_GPIO_H_ */
@@ -19,10 +19,64 @@
  */
 
 #include <stdio.h>
+#include <string.h>
 #include <unistd.h>
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
 #include "exo_io_al_linux_i2c.h"
 #include "exo_hal_io_al_common.h"
 
+/**
+ * @brief i2c-dev instance data, referenced by vdp_intf_inst_hdle
+ */
+typedef struct
+{
+    int fd;                                 /*!< i2c-dev file descriptor                */
+    uint32 timeout_ms;                      /*!< Adapter timeout last set with ioctl    */
+    uint8 sim;                              /*!< Routed to the simulated bus            */
+} lnx_i2c_inst;
+
+static lnx_i2c_inst i2c1_inst = { .fd = -1 }; ///< I2C1 instance
+static lnx_i2c_inst i2c2_inst = { .fd = -1 }; ///< I2C2 instance
+static lnx_i2c_inst i2c3_inst = { .fd = -1 }; ///< I2C3 instance
+static lnx_i2c_inst i2c4_inst = { .fd = -1 }; ///< I2C4 instance
+
+/**
+ * @brief Open the i2c-dev device of an instance and attach it to the IO-AL handle
+ */
+static hal_ret_sts io_hal_linux_i2c_open(ioal_i2c_hdle *ioal_hi2c, lnx_i2c_inst *inst, const char *dev)
+{
+    ioal_hi2c->intf_gen_info.state = IO_FREE_STATE;
+    if (dev == NULL)
+    {
+        // No bus configured, transfers complete without touching hardware
+        ioal_hi2c->intf_gen_info.vdp_intf_inst_hdle = NULL;
+        return HAL_SCS;
+    }
+    if (strcmp(dev, LNX_I2C_SIM_DEV) == 0)
+    {
+        inst->sim = 1;
+        ioal_hi2c->intf_gen_info.vdp_intf_inst_hdle = (void*)inst;
+        return HAL_SCS;
+    }
+
+    printf("\n EXO I2C IO Vendor driver initialise on %s", dev);
+    if (inst->fd < 0)
+    {
+        inst->fd = open(dev, O_RDWR);
+        if (inst->fd < 0)
+        {
+            perror("Unable to open I2C device");
+            return HAL_IO_INIT_ERR;
+        }
+        inst->timeout_ms = 0;
+    }
+    ioal_hi2c->intf_gen_info.vdp_intf_inst_hdle = (void*)inst;
+    printf("\n EXO I2C IO Vendor driver initialisation completed successfully");
+    return HAL_SCS;
+}
 
 /**
  * @brief IO-HAL I2C1 initialization function for linux
@@ -30,12 +84,7 @@
 hal_ret_sts io_hal_linux_i2c1_init(ioal_i2c_hdle *ioal_hi2c1)
 {
     ioal_hi2c1->intf_gen_info.io_id=IOAL_INST_I2C1;
-    printf("\n EXO I2C1 IO Vendor driver porting layer initialise");
-    printf("\n EXO I2C1 IO Vendor driver initialise");
-    usleep(100000);
-    printf("\n EXO I2C1 IO Vendor driver initialisation completed successfully");
-    printf("\n EXO I2C1 IO Vendor driver porting layer initialisation completed successfully");
-    return HAL_SCS;
+    return io_hal_linux_i2c_open(ioal_hi2c1, &i2c1_inst, LNX_I2C1_DEV);
 }
 
 /**
@@ -44,12 +93,16 @@ hal_ret_sts io_hal_linux_i2c1_init(ioal_i2c_hdle *ioal_hi2c1)
 hal_ret_sts io_hal_linux_i2c2_init(ioal_i2c_hdle *ioal_hi2c2)
 {
     ioal_hi2c2->intf_gen_info.io_id=IOAL_INST_I2C2;
-    printf("\n EXO I2C2 IO Vendor driver porting layer initialise");
-    printf("\n EXO I2C2 IO Vendor driver initialise");
-    usleep(100000);
-    printf("\n EXO I2C2 IO Vendor driver initialisation completed successfully");
-    printf("\n EXO I2C2 IO Vendor driver porting layer initialisation completed successfully");
-    return HAL_SCS;
+    return io_hal_linux_i2c_open(ioal_hi2c2, &i2c2_inst, LNX_I2C2_DEV);
+}
+
+/**
+ * @brief IO-HAL I2C3 initialization function for linux
+ */
+hal_ret_sts io_hal_linux_i2c3_init(ioal_i2c_hdle *ioal_hi2c3)
+{
+    ioal_hi2c3->intf_gen_info.io_id=IOAL_INST_I2C3;
+    return io_hal_linux_i2c_open(ioal_hi2c3, &i2c3_inst, LNX_I2C3_DEV);
 }
 
 /**
@@ -58,26 +111,124 @@ hal_ret_sts io_hal_linux_i2c2_init(ioal_i2c_hdle *ioal_hi2c2)
 hal_ret_sts io_hal_linux_i2c4_init(ioal_i2c_hdle *ioal_hi2c4)
 {
     ioal_hi2c4->intf_gen_info.io_id=IOAL_INST_I2C4;
-    printf("\n EXO I2C4 IO Vendor driver porting layer initialise");
-    printf("\n EXO I2C4 IO Vendor driver initialise");
-    usleep(100000);
-    printf("\n EXO I2C4 IO Vendor driver initialisation completed successfully");
-    printf("\n EXO I2C4 IO Vendor driver porting layer initialisation completed successfully");
-    return HAL_SCS;
+    return io_hal_linux_i2c_open(ioal_hi2c4, &i2c4_inst, LNX_I2C4_DEV);
 }
 
 /**
- * @brief IO-HAL I2C3 initialization function for linux
+ * @brief Issue one I2C_RDWR combined transaction. The adapter timeout, in
+ *        units of 10 mS, is only reprogrammed when it changes.
  */
-hal_ret_sts io_hal_linux_i2c3_init(ioal_i2c_hdle *ioal_hi2c3)
+static hal_ret_sts io_hal_linux_i2c_rdwr(lnx_i2c_inst *inst, struct i2c_msg *msgs, uint32 nmsgs, uint32 timeout)
 {
-    ioal_hi2c3->intf_gen_info.io_id=IOAL_INST_I2C3;
-    printf("\n EXO I2C4 IO Vendor driver porting layer initialise");
-    printf("\n EXO I2C4 IO Vendor driver initialise");
-    usleep(100000);
-    printf("\n EXO I2C4 IO Vendor driver initialisation completed successfully");
-    printf("\n EXO I2C4 IO Vendor driver porting layer initialisation completed successfully");
-    return HAL_SCS;
+    struct i2c_rdwr_ioctl_data rdwr;
+
+    if (inst->timeout_ms != timeout)
+    {
+        if (ioctl(inst->fd, I2C_TIMEOUT, (unsigned long)((timeout + 9) / 10)) < 0)
+        {
+            perror("Unable to set I2C timeout");
+        }
+        inst->timeout_ms = timeout;
+    }
+    rdwr.msgs = msgs;
+    rdwr.nmsgs = nmsgs;
+    return (ioctl(inst->fd, I2C_RDWR, &rdwr) < 0) ? HAL_IO_VDP_ERR : HAL_SCS;
+}
+
+/**
+ * @brief Append the write and read messages of one transaction, the 8-bit
+ *        HAL address is converted to the 7-bit address used by the kernel
+ */
+static uint32 io_hal_linux_i2c_msgs(struct i2c_msg *msgs, uint16 addr, uint8 *wr_data, uint16 wr_size, uint8 *rd_data, uint16 rd_size)
+{
+    uint32 n = 0;
+    if (wr_size > 0 || rd_size == 0)
+    {
+        msgs[n].addr = addr >> 1;
+        msgs[n].flags = 0;
+        msgs[n].len = wr_size;
+        msgs[n].buf = wr_data;
+        n++;
+    }
+    if (rd_size > 0)
+    {
+        msgs[n].addr = addr >> 1;
+        msgs[n].flags = I2C_M_RD;
+        msgs[n].len = rd_size;
+        msgs[n].buf = rd_data;
+        n++;
+    }
+    return n;
+}
+
+/**
+ * @brief IO-HAL I2C write then read function for linux
+ */
+hal_ret_sts io_hal_linux_i2c_write_read(ioal_i2c_hdle *ioal_hi2c, uint16 addr, uint8 *wr_data, uint16 wr_size, uint8 *rd_data, uint16 rd_size, uint32 timeout)
+{
+    lnx_i2c_inst *inst = ioal_hi2c->intf_gen_info.vdp_intf_inst_hdle;
+    struct i2c_msg msgs[2];
+
+    if ((wr_data == NULL && wr_size != 0) || (rd_data == NULL && rd_size != 0))
+    {
+        return HAL_IO_INVLD_ARG;
+    }
+    if (inst == NULL)
+    {
+        return HAL_SCS;
+    }
+    if (inst->sim)
+    {
+        iohal_i2c_xfer xfer = { addr, wr_data, wr_size, rd_data, rd_size };
+        return io_hal_linux_i2c_sim_xfer(ioal_hi2c->intf_gen_info.io_id, &xfer, 1);
+    }
+    return io_hal_linux_i2c_rdwr(inst, msgs, io_hal_linux_i2c_msgs(msgs, addr, wr_data, wr_size, rd_data, rd_size), timeout);
+}
+
+/**
+ * @brief IO-HAL I2C transfer function for linux
+ */
+hal_ret_sts io_hal_linux_i2c_transfer(ioal_i2c_hdle *ioal_hi2c, iohal_i2c_xfer *xfer, uint16 count, uint32 timeout)
+{
+    lnx_i2c_inst *inst = ioal_hi2c->intf_gen_info.vdp_intf_inst_hdle;
+    struct i2c_msg msgs[I2C_RDWR_IOCTL_MAX_MSGS];
+    hal_ret_sts ret = HAL_SCS;
+    uint32 nmsgs = 0;
+
+    if (xfer == NULL && count != 0)
+    {
+        return HAL_IO_INVLD_ARG;
+    }
+    for (uint16 i = 0; i < count; i++)
+    {
+        if ((xfer[i].wr_data == NULL && xfer[i].wr_size != 0) || (xfer[i].rd_data == NULL && xfer[i].rd_size != 0))
+        {
+            return HAL_IO_INVLD_ARG;
+        }
+    }
+    if (inst == NULL)
+    {
+        return HAL_SCS;
+    }
+    if (inst->sim)
+    {
+        return io_hal_linux_i2c_sim_xfer(ioal_hi2c->intf_gen_info.io_id, xfer, count);
+    }
+    for (uint16 i = 0; i < count && ret == HAL_SCS; i++)
+    {
+        // Flush when the next transaction might not fit in the ioctl
+        if (nmsgs + 2 > I2C_RDWR_IOCTL_MAX_MSGS)
+        {
+            ret = io_hal_linux_i2c_rdwr(inst, msgs, nmsgs, timeout);
+            nmsgs = 0;
+        }
+        nmsgs += io_hal_linux_i2c_msgs(&msgs[nmsgs], xfer[i].addr, xfer[i].wr_data, xfer[i].wr_size, xfer[i].rd_data, xfer[i].rd_size);
+    }
+    if (ret == HAL_SCS && nmsgs > 0)
+    {
+        ret = io_hal_linux_i2c_rdwr(inst, msgs, nmsgs, timeout);
+    }
+    return ret;
 }
 
 /**
@@ -85,7 +236,7 @@ hal_ret_sts io_hal_linux_i2c3_init(ioal_i2c_hdle *ioal_hi2c3)
  */
 hal_ret_sts io_hal_linux_i2c_transmit(ioal_i2c_hdle *ioal_hi2c, uint16 addr, uint8 *pdata, uint16 size, uint32 timeout)
 {
-    return HAL_SCS;
+    return io_hal_linux_i2c_write_read(ioal_hi2c, addr, pdata, size, NULL, 0, timeout);
 }
 
 /**
@@ -93,5 +244,5 @@ hal_ret_sts io_hal_linux_i2c_transmit(ioal_i2c_hdle *ioal_hi2c, uint16 addr, uin
  */
 hal_ret_sts io_hal_linux_i2c_receive(ioal_i2c_hdle  *ioal_hi2c, uint16 addr, uint8 *pdata, uint16 size, uint32 timeout)
 {
-    return HAL_SCS;
+    return io_hal_linux_i2c_write_read(ioal_hi2c, addr, NULL, 0, pdata, size, timeout);
 }
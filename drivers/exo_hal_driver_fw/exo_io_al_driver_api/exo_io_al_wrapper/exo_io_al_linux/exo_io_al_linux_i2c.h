@@ -19,11 +19,40 @@
  */
 
 #ifndef _IO_AL_LINUX_I2C_H_
-#define _IO_AL_LINUX_I2_CH_
+#define _IO_AL_LINUX_I2C_H_
 
 #include "exo_hal_common.h"
 #include "exo_io_al_i2c_common.h"
+#include "exo_io_al_linux_i2c_sim.h"
 
+/**
+ * @brief Device of the I2C instances not set below: the simulated bus when
+ *        the AHW drivers run on it, otherwise none
+ */
+#ifdef LINUX_AHW_SIM
+#define LNX_I2C_DEFAULT_DEV         LNX_I2C_SIM_DEV
+#else
+#define LNX_I2C_DEFAULT_DEV         NULL
+#endif
+
+/**
+ * @brief i2c-dev devices used for the I2C instances (e.g. "/dev/i2c-1"), or
+ *        LNX_I2C_SIM_DEV for the simulated bus. An instance without a device
+ *        keeps the stub behaviour and completes every transfer without
+ *        touching a bus.
+ */
+#ifndef LNX_I2C1_DEV
+#define LNX_I2C1_DEV                LNX_I2C_DEFAULT_DEV
+#endif
+#ifndef LNX_I2C2_DEV
+#define LNX_I2C2_DEV                LNX_I2C_DEFAULT_DEV
+#endif
+#ifndef LNX_I2C3_DEV
+#define LNX_I2C3_DEV                LNX_I2C_DEFAULT_DEV
+#endif
+#ifndef LNX_I2C4_DEV
+#define LNX_I2C4_DEV                LNX_I2C_DEFAULT_DEV
+#endif
 
 /**
  * @brief IO-HAL I2C1 initialization function for linux
@@ -75,6 +104,31 @@ hal_ret_sts io_hal_linux_i2c_transmit(ioal_i2c_hdle *ioal_hi2c, uint16 addr, uin
  */
 hal_ret_sts io_hal_linux_i2c_receive(ioal_i2c_hdle *ioal_hi2c, uint16 addr, uint8 *pdata, uint16 size, uint32 timeout);
 
+/**
+ * @brief IO-HAL I2C write then read function for linux, issued as one
+ *        I2C_RDWR combined transaction with a repeated start
+ * @param[in] ioal_hi2c - pointer to I2C instance
+ * @param[in] addr - 8-bit slave address, as used by the STM32 HAL
+ * @param[in] wr_data - pointer to the data to write
+ * @param[in] wr_size - size of the data to write
+ * @param[out] rd_data - pointer to the buffer for the data read
+ * @param[in] rd_size - size of the data to read
+ * @param[in] timeout - timeout duration in mS
+ * @retval HAL status
+ */
+hal_ret_sts io_hal_linux_i2c_write_read(ioal_i2c_hdle *ioal_hi2c, uint16 addr, uint8 *wr_data, uint16 wr_size, uint8 *rd_data, uint16 rd_size, uint32 timeout);
+
+/**
+ * @brief IO-HAL I2C transfer function for linux, the transactions are packed
+ *        into as few I2C_RDWR calls as the kernel allows
+ * @param[in] ioal_hi2c - pointer to I2C instance
+ * @param[in,out] xfer - array of transactions
+ * @param[in] count - number of transactions
+ * @param[in] timeout - timeout duration in mS
+ * @retval HAL status
+ */
+hal_ret_sts io_hal_linux_i2c_transfer(ioal_i2c_hdle *ioal_hi2c, iohal_i2c_xfer *xfer, uint16 count, uint32 timeout);
+
 /** IO HAL common I2C fucntion mapping **/
 #define io_hal_common_i2c1_init 			io_hal_linux_i2c1_init
 #define io_hal_common_i2c2_init 			io_hal_linux_i2c2_init
@@ -82,6 +136,8 @@ hal_ret_sts io_hal_linux_i2c_receive(ioal_i2c_hdle *ioal_hi2c, uint16 addr, uint
 #define io_hal_common_i2c4_init 			io_hal_linux_i2c4_init
 #define io_hal_common_i2c_transmit 			io_hal_linux_i2c_transmit
 #define io_hal_common_i2c_receive 			io_hal_linux_i2c_receive
+#define io_hal_common_i2c_write_read 		io_hal_linux_i2c_write_read
+#define io_hal_common_i2c_transfer 			io_hal_linux_i2c_transfer
 
 
 #endif
@@ -0,0 +1,1221 @@
+/**
+ * @file exo_io_al_linux_i2c_sim.c
+ *
+ * @brief This file contains the register level I2C bus simulator of the linux IO-AL
+ *
+ * @copyright Copyright 2024 Antaris, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Each I2C instance has one simulated bus holding the device models attached
+ * to it. A transaction is routed on its 8-bit address, its write bytes go to
+ * the write handler of the model and its read bytes, after the repeated start,
+ * come from the read handler. The models keep the register pointer between
+ * transactions like the real parts, so the vendor drivers run unchanged.
+ *
+ * Bus time is accounted, not waited for, unless real time is enabled: runs
+ * are deterministic and the counters tell how many transactions and bytes a
+ * driver call costs.
+ */
+
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "exo_io_al_linux_i2c_sim.h"
+#include "exo_hal_io_al_common.h"
+
+#define SIM_AUX_MAX                 256U    ///< BMX160 auxiliary magnetometer register space
+#define SIM_MEM_MAX                 1024U   ///< BMX160 FIFO and UCD9081 configuration memory size
+
+/**
+ * @brief Register map model operations
+ */
+typedef struct
+{
+    uint8 inputs;                                                           /*!< Number of inputs                       */
+    void (*reset)(lnx_i2c_sim_dev *dev);                                    /*!< Set the reset values                   */
+    void (*write)(lnx_i2c_sim_dev *dev, const uint8 *data, uint16 size);    /*!< Bytes of a write transaction           */
+    void (*read)(lnx_i2c_sim_dev *dev, uint8 *data, uint16 size);           /*!< Bytes of a read transaction            */
+    void (*input)(lnx_i2c_sim_dev *dev, uint8 idx, int32 old);              /*!< Input changed, NULL when not needed    */
+    void (*poke)(lnx_i2c_sim_dev *dev, uint8 reg, uint16 val);              /*!< Backdoor write, NULL to store as is    */
+} lnx_i2c_sim_ops;
+
+/**
+ * @brief Simulated device
+ */
+struct _lnx_i2c_sim_dev
+{
+    const lnx_i2c_sim_ops *ops;             /*!< Register map model                     */
+    uint16 addr;                            /*!< 8-bit slave address                    */
+    uint8 ptr;                              /*!< Register pointer or last command       */
+    uint8 run;                              /*!< Model state, conversion running        */
+    uint16 reg[LNX_I2C_SIM_REG_MAX];        /*!< Registers                              */
+    int32 input[LNX_I2C_SIM_INPUT_MAX];     /*!< Analog or pin inputs                   */
+    uint8 aux[SIM_AUX_MAX];                 /*!< BMX160 magnetometer registers          */
+    uint8 mem[SIM_MEM_MAX];                 /*!< BMX160 FIFO, UCD9081 configuration     */
+    uint16 mem_head;                        /*!< BMX160 FIFO read index                 */
+    uint16 mem_level;                       /*!< BMX160 FIFO fill level                 */
+    uint8 mem_overread;                     /*!< BMX160 bytes read past the FIFO data   */
+    lnx_i2c_sim_fault fault;                /*!< Injected fault                         */
+    uint32 fault_skip;                      /*!< Transactions left before the fault     */
+    uint32 fault_count;                     /*!< Faulty transactions left, 0 unlimited  */
+    lnx_i2c_sim_stats stats;                /*!< Device counters                        */
+};
+
+/**
+ * @brief Simulated bus of one I2C instance
+ */
+typedef struct
+{
+    pthread_mutex_t lock;                   /*!< Serialises the transactions            */
+    lnx_i2c_sim_dev dev[LNX_I2C_SIM_DEV_MAX]; /*!< Attached devices                     */
+    uint8 ndev;                             /*!< Number of attached devices             */
+    uint32 xfer_us;                         /*!< Time of start, address and stop        */
+    uint32 byte_us;                         /*!< Time of one data byte                  */
+    uint8 real_time;                        /*!< Sleep for the simulated time           */
+    lnx_i2c_sim_stats stats;                /*!< Bus counters                           */
+} lnx_i2c_sim_bus;
+
+static lnx_i2c_sim_bus sim_bus[LNX_I2C_SIM_BUS_MAX] =
+{
+    [0 ... LNX_I2C_SIM_BUS_MAX - 1] =
+    {
+        .lock = PTHREAD_MUTEX_INITIALIZER,
+        .xfer_us = LNX_I2C_SIM_XFER_US,
+        .byte_us = LNX_I2C_SIM_BYTE_US,
+    }
+}; ///< One simulated bus per I2C instance
+
+/**
+ * @brief Sign extend the 13-bit temperature field of an MCP9843 register
+ */
+static int32 sim_sext13(uint16 val)
+{
+    return (int32)((val & 0x1FFF) ^ 0x1000) - 0x1000;
+}
+
+/**
+ * @brief Temperature in 1/16 degree, rounded down like the converter does
+ */
+static int32 sim_temp16(int32 mdeg)
+{
+    int32 t = mdeg * 16;
+    return (t >= 0) ? t / 1000 : -((-t + 999) / 1000);
+}
+
+/**
+ * @brief Clamp a conversion result to its code range
+ */
+static int32 sim_clamp(int32 val, int32 min, int32 max)
+{
+    return (val < min) ? min : ((val > max) ? max : val);
+}
+
+/**
+ * @brief Read a 16-bit register MSB first, the pointer does not move
+ */
+static void sim_word_read(uint16 val, uint8 *data, uint16 size)
+{
+    for (uint16 i = 0; i < size; i++)
+    {
+        data[i] = (i & 1) ? (uint8)val : (uint8)(val >> 8);
+    }
+}
+
+/******************************************************************************
+ * INA230: pointer byte then 16-bit registers, MSB first
+ *****************************************************************************/
+#define INA230_CONFIG               0x00
+#define INA230_SHUNT                0x01
+#define INA230_BUS                  0x02
+#define INA230_POWER                0x03
+#define INA230_CURRENT              0x04
+#define INA230_CAL                  0x05
+#define INA230_MASK_EN              0x06
+#define INA230_ALERT                0x07
+#define INA230_DIE_ID               0xFF
+
+static void sim_ina230_reset(lnx_i2c_sim_dev *dev)
+{
+    memset(dev->reg, 0, sizeof(dev->reg));
+    dev->reg[INA230_CONFIG] = 0x4127;
+    dev->reg[INA230_DIE_ID] = 0x2260;
+}
+
+/**
+ * @brief New conversion: results from the inputs and the calibration,
+ *        conversion ready flag set
+ */
+static void sim_ina230_convert(lnx_i2c_sim_dev *dev)
+{
+    int32 current;
+    int32 power;
+
+    dev->reg[INA230_SHUNT] = (uint16)sim_clamp(dev->input[0], -32768, 32767);
+    dev->reg[INA230_BUS] = (uint16)sim_clamp(dev->input[1], 0, 0x7FFF);
+    current = (int32)(int16)dev->reg[INA230_SHUNT] * dev->reg[INA230_CAL] / 2048;
+    current = sim_clamp(current, -32768, 32767);
+    power = ((current < 0) ? -current : current) * dev->reg[INA230_BUS] / 20000;
+    dev->reg[INA230_CURRENT] = (uint16)current;
+    dev->reg[INA230_POWER] = (uint16)sim_clamp(power, 0, 0xFFFF);
+    dev->reg[INA230_MASK_EN] |= 0x0008;
+}
+
+static void sim_ina230_write(lnx_i2c_sim_dev *dev, const uint8 *data, uint16 size)
+{
+    uint16 val;
+
+    dev->ptr = data[0];
+    if (size < 3)
+    {
+        return;
+    }
+    val = (uint16)((data[1] << 8) | data[2]);
+    switch (dev->ptr)
+    {
+    case INA230_CONFIG:
+        if (val & 0x8000)
+        {
+            sim_ina230_reset(dev);
+            return;
+        }
+        dev->reg[INA230_CONFIG] = val;
+        sim_ina230_convert(dev);
+        break;
+    case INA230_CAL:
+        dev->reg[INA230_CAL] = val & 0x7FFF;
+        sim_ina230_convert(dev);
+        break;
+    case INA230_MASK_EN:
+        // Alert function bits are writable, the flags are read only
+        dev->reg[INA230_MASK_EN] = (val & 0xFC03) | (dev->reg[INA230_MASK_EN] & 0x001C);
+        break;
+    case INA230_ALERT:
+        dev->reg[INA230_ALERT] = val;
+        break;
+    default:
+        break;
+    }
+}
+
+static void sim_ina230_read(lnx_i2c_sim_dev *dev, uint8 *data, uint16 size)
+{
+    sim_word_read(dev->reg[dev->ptr], data, size);
+    if (dev->ptr == INA230_MASK_EN)
+    {
+        // Reading the mask/enable register clears the flags
+        dev->reg[INA230_MASK_EN] &= ~0x0018;
+    }
+}
+
+static void sim_ina230_input(lnx_i2c_sim_dev *dev, uint8 idx, int32 old)
+{
+    sim_ina230_convert(dev);
+    (void)idx;
+    (void)old;
+}
+
+/******************************************************************************
+ * MCP9843: pointer byte then 16-bit registers, MSB first, resolution is 8-bit
+ *****************************************************************************/
+#define MCP9843_CAPA                0x00
+#define MCP9843_CONF                0x01
+#define MCP9843_TUPPER              0x02
+#define MCP9843_TLOWER              0x03
+#define MCP9843_TCRIT               0x04
+#define MCP9843_TA                  0x05
+#define MCP9843_MANUF_ID            0x06
+#define MCP9843_DEV_ID              0x07
+#define MCP9843_RES                 0x08
+
+static void sim_mcp9843_reset(lnx_i2c_sim_dev *dev)
+{
+    memset(dev->reg, 0, sizeof(dev->reg));
+    dev->reg[MCP9843_CAPA] = 0x006F;
+    dev->reg[MCP9843_MANUF_ID] = 0x0054;
+    dev->reg[MCP9843_DEV_ID] = 0x0000;
+    dev->reg[MCP9843_RES] = 0x03;
+}
+
+/**
+ * @brief Ambient temperature register: 13-bit two's complement in 1/16
+ *        degree truncated to the resolution, with the alarm flags on top
+ */
+static uint16 sim_mcp9843_ta(lnx_i2c_sim_dev *dev)
+{
+    int32 ta = sim_clamp(sim_temp16(dev->input[0]), -4096, 4095);
+    uint16 flags = 0;
+
+    ta &= ~((1 << (3 - (dev->reg[MCP9843_RES] & 0x03))) - 1);
+    if (ta >= sim_sext13(dev->reg[MCP9843_TCRIT]))
+    {
+        flags |= 0x8000;
+    }
+    if (ta > sim_sext13(dev->reg[MCP9843_TUPPER]))
+    {
+        flags |= 0x4000;
+    }
+    if (ta < sim_sext13(dev->reg[MCP9843_TLOWER]))
+    {
+        flags |= 0x2000;
+    }
+    return flags | (uint16)(ta & 0x1FFF);
+}
+
+static void sim_mcp9843_write(lnx_i2c_sim_dev *dev, const uint8 *data, uint16 size)
+{
+    uint16 val;
+
+    dev->ptr = data[0];
+    if (dev->ptr == MCP9843_RES && size >= 2)
+    {
+        dev->reg[MCP9843_RES] = data[1] & 0x03;
+        return;
+    }
+    if (size < 3)
+    {
+        return;
+    }
+    val = (uint16)((data[1] << 8) | data[2]);
+    switch (dev->ptr)
+    {
+    case MCP9843_CONF:
+        // Interrupt clear bit is self clearing
+        dev->reg[MCP9843_CONF] = val & 0x07DF;
+        break;
+    case MCP9843_TUPPER:
+    case MCP9843_TLOWER:
+    case MCP9843_TCRIT:
+        dev->reg[dev->ptr] = val & 0x1FFC;
+        break;
+    default:
+        break;
+    }
+}
+
+static void sim_mcp9843_read(lnx_i2c_sim_dev *dev, uint8 *data, uint16 size)
+{
+    if (dev->ptr == MCP9843_RES)
+    {
+        memset(data, (uint8)dev->reg[MCP9843_RES], size);
+        return;
+    }
+    if (dev->ptr == MCP9843_TA)
+    {
+        dev->reg[MCP9843_TA] = sim_mcp9843_ta(dev);
+    }
+    sim_word_read(dev->reg[dev->ptr], data, size);
+}
+
+/******************************************************************************
+ * DS620: command byte, 8-bit registers 0xA0 to 0xAD with auto increment
+ *****************************************************************************/
+#define DS620_TH_MSB                0xA0
+#define DS620_TL_MSB                0xA2
+#define DS620_TEMP_MSB              0xAA
+#define DS620_TEMP_LSB              0xAB
+#define DS620_CFG_MSB               0xAC
+#define DS620_CFG_LSB               0xAD
+#define DS620_START                 0x51
+#define DS620_STOP                  0x22
+#define DS620_POR                   0x54
+#define DS620_COPY                  0x48
+#define DS620_RECALL                0xB8
+
+static void sim_ds620_reset(lnx_i2c_sim_dev *dev)
+{
+    memset(dev->reg, 0, sizeof(dev->reg));
+    // TH +125 C, TL -55 C, 13-bit resolution
+    dev->reg[DS620_TH_MSB] = 0x3E;
+    dev->reg[DS620_TH_MSB + 1] = 0x80;
+    dev->reg[DS620_TL_MSB] = 0xE4;
+    dev->reg[DS620_TL_MSB + 1] = 0x80;
+    dev->reg[DS620_CFG_MSB] = 0x0C;
+    dev->run = 0;
+}
+
+/**
+ * @brief Conversion: left justified temperature truncated to the resolution,
+ *        done and thermostat flags, one shot mode stops after it
+ */
+static void sim_ds620_convert(lnx_i2c_sim_dev *dev)
+{
+    uint8 res = (dev->reg[DS620_CFG_MSB] >> 2) & 0x03;
+    int32 temp = sim_clamp(sim_temp16(dev->input[0]), -4096, 4095) << 3;
+    int16 th = (int16)((dev->reg[DS620_TH_MSB] << 8) | dev->reg[DS620_TH_MSB + 1]);
+    int16 tl = (int16)((dev->reg[DS620_TL_MSB] << 8) | dev->reg[DS620_TL_MSB + 1]);
+
+    temp &= ~((1 << (6 - res)) - 1);
+    dev->reg[DS620_TEMP_MSB] = (uint8)(temp >> 8);
+    dev->reg[DS620_TEMP_LSB] = (uint8)temp;
+    dev->reg[DS620_CFG_MSB] |= 0x80;
+    if (temp >= th)
+    {
+        dev->reg[DS620_CFG_MSB] |= 0x20;
+    }
+    if (temp <= tl)
+    {
+        dev->reg[DS620_CFG_MSB] |= 0x10;
+    }
+    if (dev->reg[DS620_CFG_MSB] & 0x01)
+    {
+        dev->run = 0;
+    }
+}
+
+static void sim_ds620_write(lnx_i2c_sim_dev *dev, const uint8 *data, uint16 size)
+{
+    switch (data[0])
+    {
+    case DS620_START:
+        dev->run = 1;
+        dev->reg[DS620_CFG_MSB] &= ~0x80;
+        sim_ds620_convert(dev);
+        return;
+    case DS620_STOP:
+        dev->run = 0;
+        return;
+    case DS620_POR:
+        sim_ds620_reset(dev);
+        return;
+    case DS620_COPY:
+    case DS620_RECALL:
+        return;
+    default:
+        break;
+    }
+    dev->ptr = data[0];
+    for (uint16 i = 1; i < size; i++, dev->ptr++)
+    {
+        if (dev->ptr == DS620_CFG_MSB)
+        {
+            // DONE and NVB are read only, THF and TLF can only be cleared
+            dev->reg[DS620_CFG_MSB] = (dev->reg[DS620_CFG_MSB] & 0xC0) |
+                    (dev->reg[DS620_CFG_MSB] & data[i] & 0x30) | (data[i] & 0x0F);
+        }
+        else if (dev->ptr != DS620_TEMP_MSB && dev->ptr != DS620_TEMP_LSB)
+        {
+            dev->reg[dev->ptr] = data[i];
+        }
+    }
+}
+
+static void sim_ds620_read(lnx_i2c_sim_dev *dev, uint8 *data, uint16 size)
+{
+    if (dev->run && dev->ptr == DS620_TEMP_MSB)
+    {
+        // Continuous mode: a fresh conversion is always available
+        sim_ds620_convert(dev);
+    }
+    for (uint16 i = 0; i < size; i++, dev->ptr++)
+    {
+        data[i] = (uint8)dev->reg[dev->ptr];
+    }
+}
+
+/******************************************************************************
+ * ADM1176: command byte, extended registers, 3-byte conversion read, 2-byte
+ * when only the voltage or only the current is converted
+ *****************************************************************************/
+#define ADM1176_V_CONT              0x01
+#define ADM1176_V_ONCE              0x02
+#define ADM1176_I_CONT              0x04
+#define ADM1176_I_ONCE              0x08
+#define ADM1176_STATUS_RD           0x40
+#define ADM1176_ALERT_TH            0x82
+#define ADM1176_CONTROL             0x83
+
+static void sim_adm1176_reset(lnx_i2c_sim_dev *dev)
+{
+    memset(dev->reg, 0, sizeof(dev->reg));
+    dev->ptr = 0;
+}
+
+static void sim_adm1176_write(lnx_i2c_sim_dev *dev, const uint8 *data, uint16 size)
+{
+    if (data[0] & 0x80)
+    {
+        if (size >= 2)
+        {
+            dev->reg[data[0]] = data[1];
+        }
+        return;
+    }
+    dev->ptr = data[0];
+}
+
+static void sim_adm1176_read(lnx_i2c_sim_dev *dev, uint8 *data, uint16 size)
+{
+    uint8 v_en = (dev->ptr & (ADM1176_V_CONT | ADM1176_V_ONCE)) != 0;
+    uint8 i_en = (dev->ptr & (ADM1176_I_CONT | ADM1176_I_ONCE)) != 0;
+    uint16 v = (uint16)sim_clamp(dev->input[0], 0, 0xFFF);
+    uint16 i = (uint16)sim_clamp(dev->input[1], 0, 0xFFF);
+    uint8 conv[3] = { (uint8)(v >> 4), (uint8)(i >> 4), (uint8)(((v & 0x0F) << 4) | (i & 0x0F)) };
+    uint8 len = 3;
+    uint8 status = 0;
+
+    if (dev->ptr & ADM1176_STATUS_RD)
+    {
+        if (dev->reg[ADM1176_ALERT_TH] != 0 && (i >> 4) >= dev->reg[ADM1176_ALERT_TH])
+        {
+            status |= 0x01;
+        }
+        if (dev->reg[ADM1176_CONTROL] & 0x01)
+        {
+            status |= 0x10;
+        }
+        memset(data, status, size);
+        return;
+    }
+    if (v_en != i_en)
+    {
+        // A single measurement reads back as its high byte then its low nibble
+        uint16 x = v_en ? v : i;
+        conv[0] = (uint8)(x >> 4);
+        conv[1] = (uint8)((x & 0x0F) << 4);
+        len = 2;
+    }
+    for (uint16 n = 0; n < size; n++)
+    {
+        data[n] = conv[n % len];
+    }
+}
+
+/******************************************************************************
+ * UCD9081: 8-bit registers with auto increment, configuration memory window
+ *****************************************************************************/
+#define UCD9081_RAIL_LAST           0x0F
+#define UCD9081_VERSION             0x27
+#define UCD9081_WADDR1              0x30
+#define UCD9081_WADDR2              0x31
+#define UCD9081_WDATA1              0x32
+#define UCD9081_WDATA2              0x33
+#define UCD9081_CFG_ADDR            0xE186  ///< Configuration signature checked at init
+#define UCD9081_CFG_SIGN            0xF2
+
+static void sim_ucd9081_rails(lnx_i2c_sim_dev *dev)
+{
+    for (uint8 r = 0; r < 8; r++)
+    {
+        uint16 code = (uint16)sim_clamp(dev->input[r], 0, 0x3FF);
+        dev->reg[2 * r] = code >> 8;
+        dev->reg[2 * r + 1] = code & 0xFF;
+    }
+}
+
+static void sim_ucd9081_reset(lnx_i2c_sim_dev *dev)
+{
+    memset(dev->reg, 0, sizeof(dev->reg));
+    memset(dev->mem, 0, sizeof(dev->mem));
+    dev->reg[UCD9081_VERSION] = 0x10;
+    dev->mem[UCD9081_CFG_ADDR % SIM_MEM_MAX] = UCD9081_CFG_SIGN;
+    sim_ucd9081_rails(dev);
+}
+
+/**
+ * @brief Configuration memory byte behind WDATA1 or WDATA2, the window
+ *        address aliases over the simulated memory
+ */
+static uint8 *sim_ucd9081_mem(lnx_i2c_sim_dev *dev, uint8 reg)
+{
+    uint16 waddr = (uint16)((dev->reg[UCD9081_WADDR2] << 8) | dev->reg[UCD9081_WADDR1]);
+    return &dev->mem[(waddr + reg - UCD9081_WDATA1) % SIM_MEM_MAX];
+}
+
+static void sim_ucd9081_write(lnx_i2c_sim_dev *dev, const uint8 *data, uint16 size)
+{
+    dev->ptr = data[0];
+    for (uint16 i = 1; i < size; i++, dev->ptr++)
+    {
+        if (dev->ptr == UCD9081_WDATA1 || dev->ptr == UCD9081_WDATA2)
+        {
+            *sim_ucd9081_mem(dev, dev->ptr) = data[i];
+        }
+        else if (dev->ptr > UCD9081_RAIL_LAST && dev->ptr != UCD9081_VERSION)
+        {
+            dev->reg[dev->ptr] = data[i];
+        }
+    }
+}
+
+static void sim_ucd9081_read(lnx_i2c_sim_dev *dev, uint8 *data, uint16 size)
+{
+    for (uint16 i = 0; i < size; i++, dev->ptr++)
+    {
+        if (dev->ptr == UCD9081_WDATA1 || dev->ptr == UCD9081_WDATA2)
+        {
+            data[i] = *sim_ucd9081_mem(dev, dev->ptr);
+        }
+        else
+        {
+            data[i] = (uint8)dev->reg[dev->ptr];
+        }
+    }
+}
+
+static void sim_ucd9081_input(lnx_i2c_sim_dev *dev, uint8 idx, int32 old)
+{
+    sim_ucd9081_rails(dev);
+    (void)idx;
+    (void)old;
+}
+
+/******************************************************************************
+ * ADS7828: command byte selects the channel, 12-bit result MSB first
+ *****************************************************************************/
+static void sim_ads7828_reset(lnx_i2c_sim_dev *dev)
+{
+    memset(dev->reg, 0, sizeof(dev->reg));
+    dev->ptr = 0;
+}
+
+static void sim_ads7828_write(lnx_i2c_sim_dev *dev, const uint8 *data, uint16 size)
+{
+    dev->ptr = data[size - 1];
+}
+
+static void sim_ads7828_read(lnx_i2c_sim_dev *dev, uint8 *data, uint16 size)
+{
+    uint8 sel = (dev->ptr >> 4) & 0x07;
+    uint8 pos = (uint8)(((sel & 0x03) << 1) | (sel >> 2));
+    int32 code;
+
+    if (dev->ptr & 0x80)
+    {
+        code = dev->input[pos];
+    }
+    else
+    {
+        // Differential: the odd select bit swaps the inputs of the pair
+        code = dev->input[pos] - dev->input[pos ^ 1];
+    }
+    sim_word_read((uint16)sim_clamp(code, 0, 0xFFF), data, size);
+}
+
+/******************************************************************************
+ * MCP23008: 8-bit registers 0x00 to 0x0A, sequential mode wraps to 0x00
+ *****************************************************************************/
+#define MCP23008_IODIR              0x00
+#define MCP23008_IPOL               0x01
+#define MCP23008_GPINTEN            0x02
+#define MCP23008_DEFVAL             0x03
+#define MCP23008_INTCON             0x04
+#define MCP23008_IOCON              0x05
+#define MCP23008_INTF               0x07
+#define MCP23008_INTCAP             0x08
+#define MCP23008_GPIO               0x09
+#define MCP23008_OLAT               0x0A
+
+static void sim_mcp23008_reset(lnx_i2c_sim_dev *dev)
+{
+    memset(dev->reg, 0, sizeof(dev->reg));
+    dev->reg[MCP23008_IODIR] = 0xFF;
+}
+
+/**
+ * @brief Port value: input pins with their polarity, output latch on outputs
+ */
+static uint8 sim_mcp23008_port(lnx_i2c_sim_dev *dev)
+{
+    uint8 iodir = (uint8)dev->reg[MCP23008_IODIR];
+    uint8 pins = (uint8)dev->input[0] ^ (uint8)dev->reg[MCP23008_IPOL];
+    return (uint8)((pins & iodir) | (dev->reg[MCP23008_OLAT] & ~iodir));
+}
+
+static void sim_mcp23008_next(lnx_i2c_sim_dev *dev)
+{
+    if (dev->reg[MCP23008_IOCON] & 0x20)
+    {
+        return;
+    }
+    dev->ptr = (dev->ptr >= MCP23008_OLAT) ? 0 : dev->ptr + 1;
+}
+
+static void sim_mcp23008_write(lnx_i2c_sim_dev *dev, const uint8 *data, uint16 size)
+{
+    dev->ptr = data[0];
+    for (uint16 i = 1; i < size; i++, sim_mcp23008_next(dev))
+    {
+        if (dev->ptr == MCP23008_GPIO || dev->ptr == MCP23008_OLAT)
+        {
+            dev->reg[MCP23008_OLAT] = data[i];
+        }
+        else if (dev->ptr < MCP23008_INTF)
+        {
+            dev->reg[dev->ptr] = data[i];
+        }
+    }
+}
+
+static void sim_mcp23008_read(lnx_i2c_sim_dev *dev, uint8 *data, uint16 size)
+{
+    for (uint16 i = 0; i < size; i++, sim_mcp23008_next(dev))
+    {
+        if (dev->ptr == MCP23008_GPIO)
+        {
+            data[i] = sim_mcp23008_port(dev);
+        }
+        else
+        {
+            data[i] = (uint8)dev->reg[dev->ptr];
+        }
+        if (dev->ptr == MCP23008_GPIO || dev->ptr == MCP23008_INTCAP)
+        {
+            dev->reg[MCP23008_INTF] = 0;
+        }
+    }
+}
+
+/**
+ * @brief Pin change: interrupt on change from the previous value or from
+ *        DEFVAL, the port is captured when the interrupt is raised
+ */
+static void sim_mcp23008_input(lnx_i2c_sim_dev *dev, uint8 idx, int32 old)
+{
+    uint8 intcon = (uint8)dev->reg[MCP23008_INTCON];
+    uint8 ref = (uint8)((dev->reg[MCP23008_DEFVAL] & intcon) | (old & ~intcon));
+    uint8 chg = (uint8)((dev->input[0] ^ ref) & dev->reg[MCP23008_GPINTEN] & dev->reg[MCP23008_IODIR]);
+
+    if (chg != 0 && dev->reg[MCP23008_INTF] == 0)
+    {
+        dev->reg[MCP23008_INTCAP] = sim_mcp23008_port(dev);
+    }
+    dev->reg[MCP23008_INTF] |= chg;
+    (void)idx;
+}
+
+/******************************************************************************
+ * PCAL6408A: command byte selects one 8-bit register, no auto increment
+ *****************************************************************************/
+#define PCAL6408A_INPUT             0x00
+#define PCAL6408A_OUTPUT            0x01
+#define PCAL6408A_POLARITY          0x02
+#define PCAL6408A_CONFIG            0x03
+#define PCAL6408A_DRIVE0            0x40
+#define PCAL6408A_DRIVE1            0x41
+#define PCAL6408A_PULL_SEL          0x44
+#define PCAL6408A_INT_MASK          0x45
+#define PCAL6408A_INT_STS           0x46
+
+static void sim_pcal6408a_reset(lnx_i2c_sim_dev *dev)
+{
+    memset(dev->reg, 0, sizeof(dev->reg));
+    dev->reg[PCAL6408A_OUTPUT] = 0xFF;
+    dev->reg[PCAL6408A_CONFIG] = 0xFF;
+    dev->reg[PCAL6408A_DRIVE0] = 0xFF;
+    dev->reg[PCAL6408A_DRIVE1] = 0xFF;
+    dev->reg[PCAL6408A_PULL_SEL] = 0xFF;
+    dev->reg[PCAL6408A_INT_MASK] = 0xFF;
+}
+
+static void sim_pcal6408a_write(lnx_i2c_sim_dev *dev, const uint8 *data, uint16 size)
+{
+    dev->ptr = data[0];
+    for (uint16 i = 1; i < size; i++)
+    {
+        if (dev->ptr != PCAL6408A_INPUT && dev->ptr != PCAL6408A_INT_STS)
+        {
+            dev->reg[dev->ptr] = data[i];
+        }
+    }
+}
+
+static void sim_pcal6408a_read(lnx_i2c_sim_dev *dev, uint8 *data, uint16 size)
+{
+    uint8 cfg = (uint8)dev->reg[PCAL6408A_CONFIG];
+    uint8 port = (uint8)(((uint8)dev->input[0] & cfg) | (dev->reg[PCAL6408A_OUTPUT] & ~cfg));
+
+    for (uint16 i = 0; i < size; i++)
+    {
+        data[i] = (dev->ptr == PCAL6408A_INPUT) ? (uint8)(port ^ dev->reg[PCAL6408A_POLARITY]) : (uint8)dev->reg[dev->ptr];
+    }
+    if (dev->ptr == PCAL6408A_INPUT)
+    {
+        dev->reg[PCAL6408A_INT_STS] = 0;
+    }
+}
+
+static void sim_pcal6408a_input(lnx_i2c_sim_dev *dev, uint8 idx, int32 old)
+{
+    uint8 mask = (uint8)(dev->reg[PCAL6408A_CONFIG] & ~dev->reg[PCAL6408A_INT_MASK]);
+    dev->reg[PCAL6408A_INT_STS] |= (uint8)((dev->input[0] ^ old) & mask);
+    (void)idx;
+}
+
+/******************************************************************************
+ * BMX160: 8-bit registers with auto increment, command register, FIFO and
+ * the indirect magnetometer interface
+ *****************************************************************************/
+#define BMX160_CHIP_ID              0x00
+#define BMX160_PMU_STATUS           0x03
+#define BMX160_SENSORTIME           0x18
+#define BMX160_STATUS               0x1B
+#define BMX160_FIFO_LEN0            0x22
+#define BMX160_FIFO_LEN1            0x23
+#define BMX160_FIFO_DATA            0x24
+#define BMX160_FIFO_CONFIG_1        0x47
+#define BMX160_FIFO_TIME_HEADER     0x12
+#define BMX160_MAG_IF1              0x4D
+#define BMX160_MAG_IF2              0x4E
+#define BMX160_MAG_IF3              0x4F
+#define BMX160_CMD                  0x7E
+#define BMX160_DATA_MAG             0x04
+
+static void sim_bmx160_reset(lnx_i2c_sim_dev *dev)
+{
+    memset(dev->reg, 0, sizeof(dev->reg));
+    memset(dev->aux, 0, sizeof(dev->aux));
+    dev->reg[BMX160_CHIP_ID] = 0xD8;
+    dev->reg[BMX160_STATUS] = 0x10;
+    dev->reg[0x40] = 0x28;
+    dev->reg[0x41] = 0x03;
+    dev->reg[0x42] = 0x28;
+    dev->aux[0x40] = 0x32;
+    dev->mem_head = 0;
+    dev->mem_level = 0;
+    dev->mem_overread = 0;
+}
+
+static void sim_bmx160_fifo_level(lnx_i2c_sim_dev *dev)
+{
+    dev->reg[BMX160_FIFO_LEN0] = dev->mem_level & 0xFF;
+    dev->reg[BMX160_FIFO_LEN1] = (dev->mem_level >> 8) & 0x07;
+}
+
+static void sim_bmx160_cmd(lnx_i2c_sim_dev *dev, uint8 cmd)
+{
+    uint16 *pmu = &dev->reg[BMX160_PMU_STATUS];
+
+    switch (cmd)
+    {
+    case 0x10: case 0x11: case 0x12:
+        *pmu = (*pmu & ~0x30) | ((cmd & 0x03) << 4);
+        break;
+    case 0x14: case 0x15: case 0x17:
+        *pmu = (*pmu & ~0x0C) | ((cmd & 0x03) << 2);
+        break;
+    case 0x18: case 0x19: case 0x1A:
+        *pmu = (*pmu & ~0x03) | (cmd & 0x03);
+        break;
+    case 0xB0:
+        dev->mem_head = 0;
+        dev->mem_level = 0;
+        sim_bmx160_fifo_level(dev);
+        break;
+    case 0xB6:
+        sim_bmx160_reset(dev);
+        break;
+    default:
+        break;
+    }
+}
+
+static void sim_bmx160_write(lnx_i2c_sim_dev *dev, const uint8 *data, uint16 size)
+{
+    dev->ptr = data[0];
+    dev->mem_overread = 0;
+    for (uint16 i = 1; i < size; i++, dev->ptr++)
+    {
+        switch (dev->ptr)
+        {
+        case BMX160_CMD:
+            sim_bmx160_cmd(dev, data[i]);
+            break;
+        case BMX160_MAG_IF1:
+            // Indirect read of the magnetometer, the data shows in the data
+            // registers and in MAG_IF3 where the ported driver reads it
+            dev->reg[BMX160_MAG_IF1] = data[i];
+            dev->reg[BMX160_DATA_MAG] = dev->aux[data[i]];
+            dev->reg[BMX160_MAG_IF3] = dev->aux[data[i]];
+            break;
+        case BMX160_MAG_IF2:
+            dev->reg[BMX160_MAG_IF2] = data[i];
+            dev->aux[data[i]] = (uint8)dev->reg[BMX160_MAG_IF3];
+            break;
+        default:
+            if (dev->ptr > BMX160_STATUS || dev->ptr == 0x02)
+            {
+                dev->reg[dev->ptr] = data[i];
+            }
+            break;
+        }
+    }
+}
+
+static void sim_bmx160_read(lnx_i2c_sim_dev *dev, uint8 *data, uint16 size)
+{
+    for (uint16 i = 0; i < size; i++)
+    {
+        if (dev->ptr == BMX160_FIFO_DATA)
+        {
+            // FIFO reads do not increment, reading past the data returns
+            // a sensor time frame in header mode with fifo_time_en, then
+            // the over-read frame header
+            if (dev->mem_level == 0)
+            {
+                if (((dev->reg[BMX160_FIFO_CONFIG_1] & BMX160_FIFO_TIME_HEADER) == BMX160_FIFO_TIME_HEADER) &&
+                    (dev->mem_overread < 4))
+                {
+                    data[i] = (dev->mem_overread == 0) ? 0x44 : (uint8)dev->reg[BMX160_SENSORTIME + dev->mem_overread - 1];
+                    dev->mem_overread++;
+                    continue;
+                }
+                data[i] = 0x80;
+                continue;
+            }
+            data[i] = dev->mem[dev->mem_head];
+            dev->mem_head = (dev->mem_head + 1) % SIM_MEM_MAX;
+            dev->mem_level--;
+            sim_bmx160_fifo_level(dev);
+            continue;
+        }
+        data[i] = (dev->ptr == BMX160_CMD) ? 0 : (uint8)dev->reg[dev->ptr];
+        dev->ptr++;
+    }
+}
+
+/**
+ * @brief Backdoor writes to FIFO_DATA push a byte into the FIFO
+ */
+static void sim_bmx160_poke(lnx_i2c_sim_dev *dev, uint8 reg, uint16 val)
+{
+    if (reg != BMX160_FIFO_DATA)
+    {
+        dev->reg[reg] = val & 0xFF;
+        return;
+    }
+    if (dev->mem_level < SIM_MEM_MAX)
+    {
+        dev->mem[(dev->mem_head + dev->mem_level) % SIM_MEM_MAX] = (uint8)val;
+        dev->mem_level++;
+        sim_bmx160_fifo_level(dev);
+    }
+}
+
+/**
+ * @brief Register map models, indexed by lnx_i2c_sim_model
+ */
+static const lnx_i2c_sim_ops sim_ops[LNX_I2C_SIM_MODEL_MAX] =
+{
+    [LNX_I2C_SIM_INA230]    = { 2, sim_ina230_reset, sim_ina230_write, sim_ina230_read, sim_ina230_input, NULL },
+    [LNX_I2C_SIM_BMX160]    = { 0, sim_bmx160_reset, sim_bmx160_write, sim_bmx160_read, NULL, sim_bmx160_poke },
+    [LNX_I2C_SIM_MCP9843]   = { 1, sim_mcp9843_reset, sim_mcp9843_write, sim_mcp9843_read, NULL, NULL },
+    [LNX_I2C_SIM_DS620]     = { 1, sim_ds620_reset, sim_ds620_write, sim_ds620_read, NULL, NULL },
+    [LNX_I2C_SIM_ADM1176]   = { 2, sim_adm1176_reset, sim_adm1176_write, sim_adm1176_read, NULL, NULL },
+    [LNX_I2C_SIM_UCD9081]   = { 8, sim_ucd9081_reset, sim_ucd9081_write, sim_ucd9081_read, sim_ucd9081_input, NULL },
+    [LNX_I2C_SIM_ADS7828]   = { 8, sim_ads7828_reset, sim_ads7828_write, sim_ads7828_read, NULL, NULL },
+    [LNX_I2C_SIM_MCP23008]  = { 1, sim_mcp23008_reset, sim_mcp23008_write, sim_mcp23008_read, sim_mcp23008_input, NULL },
+    [LNX_I2C_SIM_PCAL6408A] = { 1, sim_pcal6408a_reset, sim_pcal6408a_write, sim_pcal6408a_read, sim_pcal6408a_input, NULL },
+};
+
+/**
+ * @brief Simulated bus of an I2C instance, NULL for other IO instances
+ */
+static lnx_i2c_sim_bus *sim_bus_get(uint32 io_id)
+{
+    if (io_id < IOAL_INST_I2C1 || io_id > IOAL_INST_I2C4)
+    {
+        return NULL;
+    }
+    return &sim_bus[io_id - IOAL_INST_I2C1];
+}
+
+/**
+ * @brief Device answering at an address, the R/W bit is ignored
+ */
+static lnx_i2c_sim_dev *sim_bus_find(lnx_i2c_sim_bus *bus, uint16 addr)
+{
+    for (uint8 i = 0; i < bus->ndev; i++)
+    {
+        if ((bus->dev[i].addr & 0xFE) == (addr & 0xFE))
+        {
+            return &bus->dev[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Bus a device is attached to, its lock guards the device as well
+ */
+static lnx_i2c_sim_bus *sim_dev_bus(const lnx_i2c_sim_dev *dev)
+{
+    for (uint32 i = 0; i < LNX_I2C_SIM_BUS_MAX; i++)
+    {
+        if (dev >= &sim_bus[i].dev[0] && dev < &sim_bus[i].dev[LNX_I2C_SIM_DEV_MAX])
+        {
+            return &sim_bus[i];
+        }
+    }
+    return NULL;
+}
+
+lnx_i2c_sim_dev *io_hal_linux_i2c_sim_attach(uint32 io_id, lnx_i2c_sim_model model, uint16 addr)
+{
+    lnx_i2c_sim_bus *bus = sim_bus_get(io_id);
+    lnx_i2c_sim_dev *dev = NULL;
+
+    if (bus == NULL || model >= LNX_I2C_SIM_MODEL_MAX)
+    {
+        return NULL;
+    }
+    pthread_mutex_lock(&bus->lock);
+    if (bus->ndev < LNX_I2C_SIM_DEV_MAX && sim_bus_find(bus, addr) == NULL)
+    {
+        dev = &bus->dev[bus->ndev++];
+        memset(dev, 0, sizeof(*dev));
+        dev->ops = &sim_ops[model];
+        dev->addr = addr & 0xFE;
+        dev->ops->reset(dev);
+    }
+    pthread_mutex_unlock(&bus->lock);
+    return dev;
+}
+
+lnx_i2c_sim_dev *io_hal_linux_i2c_sim_find(uint32 io_id, uint16 addr)
+{
+    lnx_i2c_sim_bus *bus = sim_bus_get(io_id);
+    lnx_i2c_sim_dev *dev;
+
+    if (bus == NULL)
+    {
+        return NULL;
+    }
+    pthread_mutex_lock(&bus->lock);
+    dev = sim_bus_find(bus, addr);
+    pthread_mutex_unlock(&bus->lock);
+    return dev;
+}
+
+void io_hal_linux_i2c_sim_reset(void)
+{
+    for (uint32 i = 0; i < LNX_I2C_SIM_BUS_MAX; i++)
+    {
+        lnx_i2c_sim_bus *bus = &sim_bus[i];
+
+        pthread_mutex_lock(&bus->lock);
+        bus->ndev = 0;
+        bus->xfer_us = LNX_I2C_SIM_XFER_US;
+        bus->byte_us = LNX_I2C_SIM_BYTE_US;
+        bus->real_time = 0;
+        memset(&bus->stats, 0, sizeof(bus->stats));
+        pthread_mutex_unlock(&bus->lock);
+    }
+}
+
+void io_hal_linux_i2c_sim_set_reg(lnx_i2c_sim_dev *dev, uint8 reg, uint16 val)
+{
+    lnx_i2c_sim_bus *bus = sim_dev_bus(dev);
+
+    pthread_mutex_lock(&bus->lock);
+    if (dev->ops->poke != NULL)
+    {
+        dev->ops->poke(dev, reg, val);
+    }
+    else
+    {
+        dev->reg[reg] = val;
+    }
+    pthread_mutex_unlock(&bus->lock);
+}
+
+uint16 io_hal_linux_i2c_sim_get_reg(lnx_i2c_sim_dev *dev, uint8 reg)
+{
+    lnx_i2c_sim_bus *bus = sim_dev_bus(dev);
+    uint16 val;
+
+    pthread_mutex_lock(&bus->lock);
+    val = dev->reg[reg];
+    pthread_mutex_unlock(&bus->lock);
+    return val;
+}
+
+hal_ret_sts io_hal_linux_i2c_sim_set_input(lnx_i2c_sim_dev *dev, uint8 idx, int32 val)
+{
+    lnx_i2c_sim_bus *bus = sim_dev_bus(dev);
+    int32 old;
+
+    if (idx >= dev->ops->inputs)
+    {
+        return HAL_IO_INVLD_ARG;
+    }
+    pthread_mutex_lock(&bus->lock);
+    old = dev->input[idx];
+    dev->input[idx] = val;
+    if (dev->ops->input != NULL)
+    {
+        dev->ops->input(dev, idx, old);
+    }
+    pthread_mutex_unlock(&bus->lock);
+    return HAL_SCS;
+}
+
+void io_hal_linux_i2c_sim_inject_fault(lnx_i2c_sim_dev *dev, lnx_i2c_sim_fault fault, uint32 skip, uint32 count)
+{
+    lnx_i2c_sim_bus *bus = sim_dev_bus(dev);
+
+    pthread_mutex_lock(&bus->lock);
+    dev->fault = fault;
+    dev->fault_skip = skip;
+    dev->fault_count = count;
+    pthread_mutex_unlock(&bus->lock);
+}
+
+void io_hal_linux_i2c_sim_set_timing(uint32 io_id, uint32 xfer_us, uint32 byte_us, uint8 real_time)
+{
+    lnx_i2c_sim_bus *bus = sim_bus_get(io_id);
+
+    if (bus != NULL)
+    {
+        pthread_mutex_lock(&bus->lock);
+        bus->xfer_us = xfer_us;
+        bus->byte_us = byte_us;
+        bus->real_time = real_time;
+        pthread_mutex_unlock(&bus->lock);
+    }
+}
+
+void io_hal_linux_i2c_sim_get_stats(uint32 io_id, lnx_i2c_sim_stats *stats)
+{
+    lnx_i2c_sim_bus *bus = sim_bus_get(io_id);
+
+    memset(stats, 0, sizeof(*stats));
+    if (bus != NULL)
+    {
+        pthread_mutex_lock(&bus->lock);
+        *stats = bus->stats;
+        pthread_mutex_unlock(&bus->lock);
+    }
+}
+
+void io_hal_linux_i2c_sim_get_dev_stats(lnx_i2c_sim_dev *dev, lnx_i2c_sim_stats *stats)
+{
+    lnx_i2c_sim_bus *bus = sim_dev_bus(dev);
+
+    pthread_mutex_lock(&bus->lock);
+    *stats = dev->stats;
+    pthread_mutex_unlock(&bus->lock);
+}
+
+void io_hal_linux_i2c_sim_clear_stats(uint32 io_id)
+{
+    lnx_i2c_sim_bus *bus = sim_bus_get(io_id);
+
+    if (bus != NULL)
+    {
+        pthread_mutex_lock(&bus->lock);
+        memset(&bus->stats, 0, sizeof(bus->stats));
+        for (uint8 i = 0; i < bus->ndev; i++)
+        {
+            memset(&bus->dev[i].stats, 0, sizeof(bus->dev[i].stats));
+        }
+        pthread_mutex_unlock(&bus->lock);
+    }
+}
+
+/**
+ * @brief Fault applied to the next transaction of a device, the skip and
+ *        count budgets are consumed here
+ */
+static lnx_i2c_sim_fault sim_dev_fault(lnx_i2c_sim_dev *dev)
+{
+    lnx_i2c_sim_fault fault = dev->fault;
+
+    if (fault == LNX_I2C_SIM_FAULT_NONE)
+    {
+        return fault;
+    }
+    if (dev->fault_skip > 0)
+    {
+        dev->fault_skip--;
+        return LNX_I2C_SIM_FAULT_NONE;
+    }
+    if (dev->fault_count > 0 && --dev->fault_count == 0)
+    {
+        dev->fault = LNX_I2C_SIM_FAULT_NONE;
+    }
+    return fault;
+}
+
+/**
+ * @brief Account one transaction on the bus and on the device
+ */
+static uint32 sim_account(lnx_i2c_sim_bus *bus, lnx_i2c_sim_dev *dev, uint16 wr_size, uint16 rd_size, uint8 nack)
+{
+    uint32 time_us = bus->xfer_us + bus->byte_us * ((uint32)wr_size + rd_size);
+    lnx_i2c_sim_stats *st[2] = { &bus->stats, (dev != NULL) ? &dev->stats : NULL };
+
+    for (uint8 i = 0; i < 2 && st[i] != NULL; i++)
+    {
+        st[i]->xfers++;
+        st[i]->wr_bytes += wr_size;
+        st[i]->rd_bytes += rd_size;
+        st[i]->nacks += nack;
+        st[i]->bus_time_us += time_us;
+    }
+    return time_us;
+}
+
+hal_ret_sts io_hal_linux_i2c_sim_xfer(uint32 io_id, iohal_i2c_xfer *xfer, uint16 count)
+{
+    lnx_i2c_sim_bus *bus = sim_bus_get(io_id);
+    hal_ret_sts ret = HAL_SCS;
+    uint32 time_us = 0;
+
+    if (bus == NULL)
+    {
+        return HAL_IO_INVLD_ARG;
+    }
+    pthread_mutex_lock(&bus->lock);
+    bus->stats.calls++;
+    for (uint16 i = 0; i < count && ret == HAL_SCS; i++)
+    {
+        lnx_i2c_sim_dev *dev = sim_bus_find(bus, xfer[i].addr);
+        lnx_i2c_sim_fault fault = (dev != NULL) ? sim_dev_fault(dev) : LNX_I2C_SIM_FAULT_NACK;
+
+        if (fault == LNX_I2C_SIM_FAULT_NACK)
+        {
+            // The address byte is not acknowledged, no data moves
+            time_us += sim_account(bus, dev, 0, 0, 1);
+            ret = HAL_IO_VDP_ERR;
+            break;
+        }
+        if (fault == LNX_I2C_SIM_FAULT_STUCK)
+        {
+            if (xfer[i].rd_size > 0)
+            {
+                memset(xfer[i].rd_data, 0xFF, xfer[i].rd_size);
+            }
+        }
+        else
+        {
+            if (xfer[i].wr_size > 0)
+            {
+                dev->ops->write(dev, xfer[i].wr_data, xfer[i].wr_size);
+            }
+            if (xfer[i].rd_size > 0)
+            {
+                dev->ops->read(dev, xfer[i].rd_data, xfer[i].rd_size);
+            }
+        }
+        time_us += sim_account(bus, dev, xfer[i].wr_size, xfer[i].rd_size, 0);
+    }
+    if (bus->real_time && time_us > 0)
+    {
+        usleep(time_us);
+    }
+    pthread_mutex_unlock(&bus->lock);
+    return ret;
+}
@@ -0,0 +1,204 @@
+/**
+ * @file exo_io_al_linux_i2c_sim.h
+ *
+ * @brief This file contains the register level I2C bus simulator of the linux IO-AL
+ *
+ * @copyright Copyright 2024 Antaris, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _IO_AL_LINUX_I2C_SIM_H_
+#define _IO_AL_LINUX_I2C_SIM_H_
+
+#include <stdint.h>
+#include "exo_hal_common.h"
+#include "exo_io_al_i2c_common.h"
+
+/**
+ * @brief An I2C instance opened on this device name is routed to the
+ *        simulated bus instead of i2c-dev, e.g. -DLNX_I2C4_DEV=LNX_I2C_SIM_DEV
+ */
+#define LNX_I2C_SIM_DEV             "sim"
+
+#define LNX_I2C_SIM_BUS_MAX         4U      ///< Number of simulated buses, one per I2C instance
+#define LNX_I2C_SIM_DEV_MAX         16U     ///< Maximum number of devices on one simulated bus
+#define LNX_I2C_SIM_REG_MAX         256U    ///< Register space of a device model
+#define LNX_I2C_SIM_INPUT_MAX       8U      ///< Number of analog or pin inputs of a device model
+
+#define LNX_I2C_SIM_XFER_US         25U     ///< Default time of start, address and stop, 400 kHz bus
+#define LNX_I2C_SIM_BYTE_US         23U     ///< Default time of one data byte with its ACK, 400 kHz bus
+
+/**
+ * @brief Register map models of the simulated devices. The inputs set with
+ *        io_hal_linux_i2c_sim_set_input() are:
+ *        - INA230    : 0 shunt voltage code, 1 bus voltage code
+ *        - BMX160    : none, data registers are set with io_hal_linux_i2c_sim_set_reg(),
+ *                      a set of FIFO_DATA (0x24) pushes one byte into the FIFO. In
+ *                      header mode with fifo_time_en a read past the FIFO data
+ *                      returns the sensor time frame of SENSORTIME (0x18 to 0x1A)
+ *        - MCP9843   : 0 temperature in milli degree celsius
+ *        - DS620     : 0 temperature in milli degree celsius
+ *        - ADM1176   : 0 voltage code, 1 current code, 12-bit. A read returns
+ *                      3 bytes with both conversions enabled, else 2 bytes
+ *        - UCD9081   : 0 to 7 rail voltage codes, 10-bit
+ *        - ADS7828   : 0 to 7 channel codes, 12-bit
+ *        - MCP23008  : 0 level of the pins configured as inputs
+ *        - PCAL6408A : 0 level of the pins configured as inputs
+ */
+typedef enum
+{
+    LNX_I2C_SIM_INA230,                     ///< INA230 power sense monitor
+    LNX_I2C_SIM_BMX160,                     ///< BMX160 IMU
+    LNX_I2C_SIM_MCP9843,                    ///< MCP9843 temperature sensor
+    LNX_I2C_SIM_DS620,                      ///< DS620 digital thermostat
+    LNX_I2C_SIM_ADM1176,                    ///< ADM1176 hot swap controller
+    LNX_I2C_SIM_UCD9081,                    ///< UCD9081 voltage sequencer
+    LNX_I2C_SIM_ADS7828,                    ///< ADS7828 ADC
+    LNX_I2C_SIM_MCP23008,                   ///< MCP23008 GPIO expander
+    LNX_I2C_SIM_PCAL6408A,                  ///< PCAL6408A GPIO expander
+    LNX_I2C_SIM_MODEL_MAX
+} lnx_i2c_sim_model;
+
+/**
+ * @brief Faults injected on the transactions addressed to a device
+ */
+typedef enum
+{
+    LNX_I2C_SIM_FAULT_NONE,                 ///< No fault
+    LNX_I2C_SIM_FAULT_NACK,                 ///< The device does not acknowledge, the transfer fails
+    LNX_I2C_SIM_FAULT_STUCK,                ///< The transfer completes, the device ignores writes and reads 0xFF
+} lnx_i2c_sim_fault;
+
+/**
+ * @brief Transaction counters of a simulated bus or device
+ */
+typedef struct
+{
+    uint32 calls;                           ///< IO-AL calls, a batched io_hal_i2c_transfer() counts once
+    uint32 xfers;                           ///< Transactions, a write and its repeated start read count once
+    uint32 wr_bytes;                        ///< Data bytes written
+    uint32 rd_bytes;                        ///< Data bytes read
+    uint32 nacks;                           ///< Failed transactions, injected or to an absent address
+    uint64_t bus_time_us;                   ///< Simulated time the bus was busy
+} lnx_i2c_sim_stats;
+
+/**
+ * @brief Simulated device, opaque to the users of the simulator
+ */
+typedef struct _lnx_i2c_sim_dev lnx_i2c_sim_dev;
+
+/**
+ * @brief Attach a device model to the simulated bus of an I2C instance, the
+ *        registers start at their reset values
+ * @param[in] io_id - IOAL_INST_I2C1 to IOAL_INST_I2C4
+ * @param[in] model - register map model of the device
+ * @param[in] addr - 8-bit slave address, as used by the STM32 HAL
+ * @retval Device handle, NULL when the bus is full or the address is in use
+ */
+lnx_i2c_sim_dev *io_hal_linux_i2c_sim_attach(uint32 io_id, lnx_i2c_sim_model model, uint16 addr);
+
+/**
+ * @brief Find the device attached at an address
+ * @param[in] io_id - IOAL_INST_I2C1 to IOAL_INST_I2C4
+ * @param[in] addr - 8-bit slave address
+ * @retval Device handle, NULL when no device answers at the address
+ */
+lnx_i2c_sim_dev *io_hal_linux_i2c_sim_find(uint32 io_id, uint16 addr);
+
+/**
+ * @brief Remove every device and clear the counters and timing of every bus
+ */
+void io_hal_linux_i2c_sim_reset(void);
+
+/**
+ * @brief Write a register of a device model without bus access, 16-bit
+ *        models use the whole value, 8-bit models its low byte
+ * @param[in] dev - device handle
+ * @param[in] reg - register address
+ * @param[in] val - register value
+ */
+void io_hal_linux_i2c_sim_set_reg(lnx_i2c_sim_dev *dev, uint8 reg, uint16 val);
+
+/**
+ * @brief Read a register of a device model without bus access
+ * @param[in] dev - device handle
+ * @param[in] reg - register address
+ * @retval Register value
+ */
+uint16 io_hal_linux_i2c_sim_get_reg(lnx_i2c_sim_dev *dev, uint8 reg);
+
+/**
+ * @brief Set an analog or pin input of a device model, see lnx_i2c_sim_model
+ * @param[in] dev - device handle
+ * @param[in] idx - input index
+ * @param[in] val - input value
+ * @retval HAL status, HAL_IO_INVLD_ARG when the model has no such input
+ */
+hal_ret_sts io_hal_linux_i2c_sim_set_input(lnx_i2c_sim_dev *dev, uint8 idx, int32 val);
+
+/**
+ * @brief Inject a fault: the transactions to the device after the next skip
+ *        ones fail, count of them or all of them when count is 0.
+ *        LNX_I2C_SIM_FAULT_NONE removes the fault.
+ * @param[in] dev - device handle
+ * @param[in] fault - fault type
+ * @param[in] skip - number of transactions completed before the fault
+ * @param[in] count - number of faulty transactions, 0 until removed
+ */
+void io_hal_linux_i2c_sim_inject_fault(lnx_i2c_sim_dev *dev, lnx_i2c_sim_fault fault, uint32 skip, uint32 count);
+
+/**
+ * @brief Set the transaction timing of a simulated bus. The time of a
+ *        transaction is xfer_us plus byte_us per data byte, it is always
+ *        added to bus_time_us and also slept when real_time is set.
+ * @param[in] io_id - IOAL_INST_I2C1 to IOAL_INST_I2C4
+ * @param[in] xfer_us - time of start, address and stop
+ * @param[in] byte_us - time of one data byte
+ * @param[in] real_time - 1 to sleep for the simulated time, 0 for
+ *                        deterministic runs
+ */
+void io_hal_linux_i2c_sim_set_timing(uint32 io_id, uint32 xfer_us, uint32 byte_us, uint8 real_time);
+
+/**
+ * @brief Get the counters of a simulated bus
+ * @param[in] io_id - IOAL_INST_I2C1 to IOAL_INST_I2C4
+ * @param[out] stats - bus counters
+ */
+void io_hal_linux_i2c_sim_get_stats(uint32 io_id, lnx_i2c_sim_stats *stats);
+
+/**
+ * @brief Get the counters of a simulated device, calls is not counted per device
+ * @param[in] dev - device handle
+ * @param[out] stats - device counters
+ */
+void io_hal_linux_i2c_sim_get_dev_stats(lnx_i2c_sim_dev *dev, lnx_i2c_sim_stats *stats);
+
+/**
+ * @brief Clear the counters of a simulated bus and of its devices
+ * @param[in] io_id - IOAL_INST_I2C1 to IOAL_INST_I2C4
+ */
+void io_hal_linux_i2c_sim_clear_stats(uint32 io_id);
+
+/**
+ * @brief Run transactions on a simulated bus, used by the linux I2C IO-AL.
+ *        Each transaction writes wr_size bytes then reads rd_size bytes with
+ *        a repeated start, the transfer stops at the first failure.
+ * @param[in] io_id - IOAL_INST_I2C1 to IOAL_INST_I2C4
+ * @param[in,out] xfer - array of transactions
+ * @param[in] count - number of transactions
+ * @retval HAL status, HAL_IO_VDP_ERR when a transaction is not acknowledged
+ */
+hal_ret_sts io_hal_linux_i2c_sim_xfer(uint32 io_id, iohal_i2c_xfer *xfer, uint16 count);
+
+#endif
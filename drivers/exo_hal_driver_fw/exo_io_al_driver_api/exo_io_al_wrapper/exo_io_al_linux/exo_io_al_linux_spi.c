@@ -19,37 +19,156 @@
  */
 
 #include <stdio.h>
+#include <string.h>
 #include <unistd.h>
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <linux/spi/spidev.h>
 #include "exo_io_al_linux_spi.h"
 #include "exo_io_al_spi_common.h"
 #include "exo_hal_io_al_common.h"
 
+/**
+ * @brief spidev instance data, referenced by vdp_intf_inst_hdle
+ */
+typedef struct
+{
+    int fd;                                 /*!< spidev file descriptor                 */
+    uint32 speed_hz;                        /*!< Clock rate of every transfer           */
+} lnx_spi_inst;
+
+static lnx_spi_inst spi1_inst = { .fd = -1 }; ///< SPI1 instance
 
 /**
- * @brief IO-HAL SPI initialization function for linux
+ * @brief Open the spidev device of an instance, set its mode and attach it to the IO-AL handle
  */
-hal_ret_sts io_hal_linux_spi1_init(void *ioal_hspi1)
+static hal_ret_sts io_hal_linux_spi_open(ioal_spi_hdle *ioal_hspi, lnx_spi_inst *inst, const char *dev, uint8 mode, uint32 speed_hz)
 {
-    printf("\n EXO SPI IO Vendor driver porting layer initialise");
-    printf("\n EXO SPI IO Vendor driver initialise");
-    usleep(100000);
+    uint8 bits = 8;
+
+    ioal_hspi->intf_gen_info.state = IO_FREE_STATE;
+    if (dev == NULL)
+    {
+        // No bus configured, transfers complete without touching hardware
+        ioal_hspi->intf_gen_info.vdp_intf_inst_hdle = NULL;
+        return HAL_SCS;
+    }
+
+    printf("\n EXO SPI IO Vendor driver initialise on %s", dev);
+    if (inst->fd < 0)
+    {
+        inst->fd = open(dev, O_RDWR);
+        if (inst->fd < 0)
+        {
+            perror("Unable to open SPI device");
+            return HAL_IO_INIT_ERR;
+        }
+    }
+    if (ioctl(inst->fd, SPI_IOC_WR_MODE, &mode) < 0 ||
+        ioctl(inst->fd, SPI_IOC_WR_BITS_PER_WORD, &bits) < 0 ||
+        ioctl(inst->fd, SPI_IOC_WR_MAX_SPEED_HZ, &speed_hz) < 0)
+    {
+        perror("Unable to configure SPI device");
+        close(inst->fd);
+        inst->fd = -1;
+        return HAL_IO_INIT_ERR;
+    }
+    inst->speed_hz = speed_hz;
+    ioal_hspi->intf_gen_info.vdp_intf_inst_hdle = (void*)inst;
     printf("\n EXO SPI IO Vendor driver initialisation completed successfully");
-    printf("\n EXO SPI IO Vendor driver porting layer initialisation completed successfully");
-    return 0;
+    return HAL_SCS;
+}
+
+/**
+ * @brief IO-HAL SPI initialization function for linux
+ */
+hal_ret_sts io_hal_linux_spi1_init(ioal_spi_hdle *ioal_hspi1)
+{
+    ioal_hspi1->intf_gen_info.io_id=IOAL_INST_SPI1;
+    return io_hal_linux_spi_open(ioal_hspi1, &spi1_inst, LNX_SPI1_DEV, LNX_SPI1_MODE, LNX_SPI1_SPEED_HZ);
+}
+
+/**
+ * @brief Submit count segments as one SPI_IOC_MESSAGE. Chip select is
+ *        released at the end of the message whatever the last cs_change is.
+ */
+static hal_ret_sts io_hal_linux_spi_message(lnx_spi_inst *inst, iohal_spi_xfer *xfer, uint32 count)
+{
+    struct spi_ioc_transfer tr[LNX_SPI_XFER_MAX];
+
+    memset(tr, 0, count * sizeof(tr[0]));
+    for (uint32 i = 0; i < count; i++)
+    {
+        tr[i].tx_buf = (unsigned long)xfer[i].tx_data;
+        tr[i].rx_buf = (unsigned long)xfer[i].rx_data;
+        tr[i].len = xfer[i].size;
+        tr[i].speed_hz = inst->speed_hz;
+        tr[i].bits_per_word = 8;
+        // On the last segment spidev reads cs_change as "keep selected"
+        tr[i].cs_change = (i + 1 < count) ? (xfer[i].cs_change != 0) : 0;
+    }
+    return (ioctl(inst->fd, SPI_IOC_MESSAGE(count), tr) < 0) ? HAL_IO_VDP_ERR : HAL_SCS;
+}
+
+/**
+ * @brief IO-HAL SPI transfer function for linux
+ */
+hal_ret_sts io_hal_linux_spi_transfer(ioal_spi_hdle *ioal_hspi, iohal_spi_xfer *xfer, uint16 count, uint32 timeout)
+{
+    lnx_spi_inst *inst = ioal_hspi->intf_gen_info.vdp_intf_inst_hdle;
+    hal_ret_sts ret = HAL_SCS;
+    uint32 start = 0;
+    uint32 n;
+
+    if (xfer == NULL && count != 0)
+    {
+        return HAL_IO_INVLD_ARG;
+    }
+    if (inst == NULL)
+    {
+        return HAL_SCS;
+    }
+    while (start < count && ret == HAL_SCS)
+    {
+        n = count - start;
+        if (n > LNX_SPI_XFER_MAX)
+        {
+            // Split after the last segment that releases chip select
+            for (n = LNX_SPI_XFER_MAX; n > 0 && xfer[start + n - 1].cs_change == 0; n--)
+            {
+            }
+            if (n == 0)
+            {
+                return HAL_IO_INVLD_ARG;
+            }
+        }
+        ret = io_hal_linux_spi_message(inst, &xfer[start], n);
+        start += n;
+    }
+    return ret;
+}
+
+/**
+ * @brief IO-HAL SPI transmit and receive function for linux
+ */
+hal_ret_sts io_hal_linux_spi_transmit_receive(ioal_spi_hdle *ioal_hspi, uint8 *ptxdata, uint8 *prxdata, uint16 size, uint32 timeout)
+{
+    iohal_spi_xfer xfer = { .tx_data = ptxdata, .rx_data = prxdata, .size = size, .cs_change = 0 };
+    return io_hal_linux_spi_transfer(ioal_hspi, &xfer, 1, timeout);
 }
 
 /**
  * @brief IO-HAL SPI transmit function for linux
  */
-hal_ret_sts io_hal_linux_spi_transmit(void *ioal_hspi, uint8 *pdata, uint16 size, uint32 timeout)
+hal_ret_sts io_hal_linux_spi_transmit(ioal_spi_hdle *ioal_hspi, uint8 *pdata, uint16 size, uint32 timeout)
 {
-    return 0;
+    return io_hal_linux_spi_transmit_receive(ioal_hspi, pdata, NULL, size, timeout);
 }
 
 /**
  * @brief IO-HAL SPI receive function for linux
  */
-hal_ret_sts io_hal_linux_spi_receive(void *ioal_hspi, uint8 *pdata, uint16 size, uint32 timeout)
+hal_ret_sts io_hal_linux_spi_receive(ioal_spi_hdle *ioal_hspi, uint8 *pdata, uint16 size, uint32 timeout)
 {
-    return 0;
+    return io_hal_linux_spi_transmit_receive(ioal_hspi, NULL, pdata, size, timeout);
 }
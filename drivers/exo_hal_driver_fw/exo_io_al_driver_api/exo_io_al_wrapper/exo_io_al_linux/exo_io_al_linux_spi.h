@@ -22,13 +22,31 @@
 #define _IO_AL_LINUX_SPI_H_
 
 #include "exo_hal_common.h"
+#include "exo_io_al_spi_common.h"
+
+/**
+ * @brief spidev device used for the SPI1 instance (e.g. "/dev/spidev0.0").
+ *        Without a device the instance keeps the stub behaviour and
+ *        completes every transfer without touching a bus.
+ */
+#ifndef LNX_SPI1_DEV
+#define LNX_SPI1_DEV                NULL
+#endif
+#ifndef LNX_SPI1_MODE
+#define LNX_SPI1_MODE               0U          ///< Clock polarity and phase, SPI_MODE_0..3
+#endif
+#ifndef LNX_SPI1_SPEED_HZ
+#define LNX_SPI1_SPEED_HZ           1000000U    ///< Clock rate of every transfer
+#endif
+
+#define LNX_SPI_XFER_MAX            32U         ///< Maximum number of segments in one SPI_IOC_MESSAGE
 
 /**
  * @brief IO-HAL SPI1 initialization function for linux
  * @param[in] ioal_hspi1 - pointer to SPI1 instance
  * @retval HAL status
  */
-hal_ret_sts io_hal_linux_spi1_init(void *ioal_hspi1);
+hal_ret_sts io_hal_linux_spi1_init(ioal_spi_hdle *ioal_hspi1);
 
 /**
  * @brief IO-HAL SPI transmit function for linux
@@ -37,7 +55,7 @@ hal_ret_sts io_hal_linux_spi1_init(void *ioal_hspi1);
  * @param[in] timeout - timeout duration
  * @retval HAL status
  */
-hal_ret_sts io_hal_linux_spi_transmit(void *ioal_hspi, uint8 *pdata, uint16 size, uint32 timeout);
+hal_ret_sts io_hal_linux_spi_transmit(ioal_spi_hdle *ioal_hspi, uint8 *pdata, uint16 size, uint32 timeout);
 
 /**
  * @brief IO-HAL SPI receive function for linux
@@ -46,12 +64,37 @@ hal_ret_sts io_hal_linux_spi_transmit(void *ioal_hspi, uint8 *pdata, uint16 size
  * @param[in] timeout - timeout duration
  * @retval HAL status
  */
-hal_ret_sts io_hal_linux_spi_receive(void *ioal_hspi, uint8 *pdata, uint16 size, uint32 timeout);
+hal_ret_sts io_hal_linux_spi_receive(ioal_spi_hdle *ioal_hspi, uint8 *pdata, uint16 size, uint32 timeout);
+
+/**
+ * @brief IO-HAL SPI transmit and receive function for linux
+ * @param[in] ioal_hspi - pointer to SPI instance
+ * @param[in] ptxdata - pointer to the data to send
+ * @param[out]prxdata - pointer to a buffer for the received data
+ * @param[in] size - size of the data
+ * @param[in] timeout - ignored, spidev transfers do not time out
+ * @retval HAL status
+ */
+hal_ret_sts io_hal_linux_spi_transmit_receive(ioal_spi_hdle *ioal_hspi, uint8 *ptxdata, uint8 *prxdata, uint16 size, uint32 timeout);
+
+/**
+ * @brief IO-HAL SPI transfer function for linux. The queue is submitted as
+ *        one SPI_IOC_MESSAGE ioctl; queues longer than LNX_SPI_XFER_MAX are
+ *        split where chip select is released anyway.
+ * @param[in] ioal_hspi - pointer to SPI instance
+ * @param[in,out] xfer - array of transfer descriptors
+ * @param[in] count - number of transfer descriptors
+ * @param[in] timeout - ignored, spidev transfers do not time out
+ * @retval HAL status
+ */
+hal_ret_sts io_hal_linux_spi_transfer(ioal_spi_hdle *ioal_hspi, iohal_spi_xfer *xfer, uint16 count, uint32 timeout);
 
 /** IO HAL common SPI function mapping **/
 #define io_hal_common_spi1_init 				io_hal_linux_spi1_init
 #define io_hal_common_spi_transmit 				io_hal_linux_spi_transmit
 #define io_hal_common_spi_receive 				io_hal_linux_spi_receive
+#define io_hal_common_spi_transmit_receive 		io_hal_linux_spi_transmit_receive
+#define io_hal_common_spi_transfer 				io_hal_linux_spi_transfer
 
 
 #endif
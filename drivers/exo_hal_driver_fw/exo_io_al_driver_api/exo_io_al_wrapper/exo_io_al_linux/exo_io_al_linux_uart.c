@@ -24,6 +24,7 @@
 #include <fcntl.h>
 #include <errno.h>
 #include <termios.h>
+#include <poll.h>
 #include "exo_io_al_linux_uart.h"
 #include "exo_io_al_uart_common.h"
 #include "exo_hal_io_al_common.h"
@@ -318,6 +319,88 @@ uint32 io_hal_linux_uart_receive(ioal_uart_hdle *ioal_huart, uint8 *pdata, uint1
     return ret_byte_read;
 }
 
+/**
+ * @brief Switch the UART to non-blocking reads
+ */
+hal_ret_sts io_hal_linux_uart_set_nonblocking(ioal_uart_hdle *ioal_huart)
+{
+    hal_ret_sts sts = HAL_IO_INIT_ERR;
+    struct termios tty;
+    int flags;
+    int* u_fd = (int*)ioal_huart->intf_gen_info.vdp_intf_inst_hdle;
+    if(u_fd != NULL && u_fd[0] != -1)
+    {
+        flags = fcntl(*u_fd, F_GETFL, 0);
+        if((flags != -1) && (fcntl(*u_fd, F_SETFL, flags | O_NONBLOCK) == 0) && (tcgetattr(*u_fd, &tty) == 0))
+        {
+            // Return whatever is pending, waiting is done with poll()
+            tty.c_cc[VTIME] = 0;
+            tty.c_cc[VMIN] = 0;
+            if (tcsetattr(*u_fd, TCSANOW, &tty) == 0)
+            {
+                sts = HAL_SCS;
+            }
+        }
+    }
+    return sts;
+}
+
+/**
+ * @brief Wait for received data with poll() and read all pending bytes
+ */
+int io_hal_linux_uart_poll_receive(ioal_uart_hdle *ioal_huart, uint8 *pdata, uint16 size, int timeout_ms)
+{
+    int* u_fd = (int*)ioal_huart->intf_gen_info.vdp_intf_inst_hdle;
+    struct pollfd pfd;
+    int total = 0;
+    int res;
+
+    if(u_fd == NULL || u_fd[0] == -1)
+    {
+        errno = EBADF;
+        return -1;
+    }
+
+    pfd.fd = *u_fd;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    res = poll(&pfd, 1, timeout_ms);
+    if(res <= 0)
+    {
+        return ((res < 0) && (errno != EINTR)) ? -1 : 0;
+    }
+    if(pfd.revents & (POLLERR | POLLNVAL))
+    {
+        errno = EIO;
+        return -1;
+    }
+
+    // Drain the driver buffer, bytes arriving meanwhile are picked up too
+    while(total < size)
+    {
+        res = read(*u_fd, &pdata[total], size - total);
+        if(res <= 0)
+        {
+            break;
+        }
+        total += res;
+    }
+    if(total == 0)
+    {
+        // Hang-up without data, e.g. the USB adapter was removed
+        if(pfd.revents & POLLHUP)
+        {
+            errno = EIO;
+            return -1;
+        }
+        if((res < 0) && (errno != EAGAIN) && (errno != EINTR))
+        {
+            return -1;
+        }
+    }
+    return total;
+}
+
 /**
  * @brief IO-HAL UART get state function for linux
  */
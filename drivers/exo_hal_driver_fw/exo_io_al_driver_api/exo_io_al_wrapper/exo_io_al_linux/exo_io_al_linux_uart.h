@@ -75,6 +75,24 @@ ioal_uart_state io_hal_linux_uart_get_state(ioal_uart_hdle *ioal_huart);
  */
 hal_ret_sts io_hal_linux_uart_transmit_dma(ioal_uart_hdle *ioal_huart, uint8 *pdata, uint16 size);
 
+/**
+ * @brief Switch the UART to non-blocking reads (O_NONBLOCK, VMIN = VTIME = 0),
+ *        io_hal_linux_uart_receive() then returns at once when nothing is pending
+ * @param[in] ioal_huart - pointer to UART instance
+ * @retval HAL status
+ */
+hal_ret_sts io_hal_linux_uart_set_nonblocking(ioal_uart_hdle *ioal_huart);
+
+/**
+ * @brief Wait for received data with poll() and read all pending bytes
+ * @param[in] ioal_huart - pointer to UART instance, set non-blocking first
+ * @param[out] pdata - pointer to a buffer
+ * @param[in] size - size of the buffer
+ * @param[in] timeout_ms - time to wait for the first byte, negative waits forever
+ * @retval Number of bytes received, 0 on timeout, -1 on error (errno is set)
+ */
+int io_hal_linux_uart_poll_receive(ioal_uart_hdle *ioal_huart, uint8 *pdata, uint16 size, int timeout_ms);
+
 /** Functions mapping **/
 #define io_hal_common_uart6_init                io_hal_linux_uart6_init
 #define io_hal_common_uart1_init                io_hal_linux_uart1_init
@@ -119,6 +119,21 @@ GPIO_PinState io_hal_stm32f7xx_gpio_read(gpio_port_details *port);
  */
 gpio_ret_sts io_hal_stm32f7xx_gpio_toggle(gpio_port_details *port);
 
+/*!
+ * @brief this API function Mapping for gpio port read
+ * @param[in] port_name            - gpio port index.
+ * @param[in] mask                 - pins of the port to read.
+ */
+uint16_t io_hal_stm32f7xx_gpio_read_port(uint16_t port_name, uint16_t mask);
+
+/*!
+ * @brief this API function Mapping for gpio port write
+ * @param[in] port_name            - gpio port index.
+ * @param[in] mask                 - pins of the port to drive.
+ * @param[in] value                - logic level of the selected pins.
+ */
+gpio_ret_sts io_hal_stm32f7xx_gpio_write_port(uint16_t port_name, uint16_t mask, uint16_t value);
+
 extern exti_handler_details_t *ioal_gpio_exti_io_intf_hdle_ptr[MC_AVAILABLE_EXTI_PINS];
 
 /** IO HAL common gpio function mapping **/
@@ -127,5 +142,7 @@ extern exti_handler_details_t *ioal_gpio_exti_io_intf_hdle_ptr[MC_AVAILABLE_EXTI
 #define io_hal_common_gpio_toggle io_hal_stm32f7xx_gpio_toggle
 #define io_hal_common_gpio_interrupt_config io_hal_stm32f7xx_gpio_interrupt_config
 #define io_hal_common_gpio_config io_hal_stm32f7xx_gpio_config
+#define io_hal_common_gpio_read_port io_hal_stm32f7xx_gpio_read_port
+#define io_hal_common_gpio_write_port io_hal_stm32f7xx_gpio_write_port
 
 #endif /* IO_AL_STM32F7xx_GPIO_H */
@@ -349,6 +349,30 @@ gpio_ret_sts io_hal_stm32f7xx_gpio_toggle(gpio_port_details *port)
     return GPIO_OK;
 }
 
+/*!
+ *  @brief This API reads the pins of a port selected by mask from the input data register
+ */
+uint16_t io_hal_stm32f7xx_gpio_read_port(uint16_t port_name, uint16_t mask)
+{
+    GPIO_TypeDef *PORT_NAME;
+
+    PORT_NAME = (GPIO_TypeDef *)(MC_GPIO_BASE_ADDRESS + (port_name * GPIO_PORT_ADDR_WINDOW_SIZE));
+    return (uint16_t)(PORT_NAME->IDR & mask);
+}
+
+/*!
+ *  @brief This API drives the pins of a port selected by mask with one bit set/reset register write
+ */
+gpio_ret_sts io_hal_stm32f7xx_gpio_write_port(uint16_t port_name, uint16_t mask, uint16_t value)
+{
+    GPIO_TypeDef *PORT_NAME;
+
+    PORT_NAME = (GPIO_TypeDef *)(MC_GPIO_BASE_ADDRESS + (port_name * GPIO_PORT_ADDR_WINDOW_SIZE));
+    PORT_NAME->BSRR = (uint32_t)(value & mask) | ((uint32_t)(~value & mask) << 16u);
+
+    return GPIO_OK;
+}
+
 /**
  * @brief EXTI  External Interrupt ISR Handler CallBackFun
  * @param None
@@ -102,6 +102,32 @@ uint32 io_hal_stm32f7xx_i2c_get_err(ioal_i2c_hdle *ioal_hi2c);
  * @retval HAL status.
  */
 hal_ret_sts io_hal_stm32f7xx_i2c_transmit(ioal_i2c_hdle *ioal_hi2c, uint16 addr, uint8 *pdata, uint16 size, uint32 timeout);
+
+/**
+ * @brief  This function writes and then reads data in master mode, with a repeated start.
+ *         Writes of 1 or 2 bytes use HAL_I2C_Mem_Read(), longer writes a transmit followed by a receive.
+ * @param[in]  ioal_hi2c -  pointer to a ioal_i2c_hdle structure that contains
+ *                the configuration information for I2C module.
+ * @param[in]  addr - Slave address
+ * @param[in]  wr_data - Pointer to data to be written
+ * @param[in]  wr_size - size of the data to be written
+ * @param[out] rd_data - Pointer to buffer for the data read
+ * @param[in]  rd_size - size of the data to be read
+ * @param[in]  timeout - Timeout duration
+ * @retval HAL status.
+ */
+hal_ret_sts io_hal_stm32f7xx_i2c_write_read(ioal_i2c_hdle *ioal_hi2c, uint16 addr, uint8 *wr_data, uint16 wr_size, uint8 *rd_data, uint16 rd_size, uint32 timeout);
+
+/**
+ * @brief  This function runs several transactions back to back in master mode
+ * @param[in]  ioal_hi2c -  pointer to a ioal_i2c_hdle structure that contains
+ *                the configuration information for I2C module.
+ * @param[in,out] xfer - array of transactions
+ * @param[in]  count - number of transactions
+ * @param[in]  timeout - Timeout duration of each transaction
+ * @retval HAL status.
+ */
+hal_ret_sts io_hal_stm32f7xx_i2c_transfer(ioal_i2c_hdle *ioal_hi2c, iohal_i2c_xfer *xfer, uint16 count, uint32 timeout);
 /**
  * @brief  This function receives data in master mode
  * @param[in]  ioal_hi2c -  pointer to a ioal_i2c_hdle structure that contains
@@ -224,6 +250,8 @@ void MX_I2C4_Init(ioal_i2c_hdle *ioal_hi2c4);
 #define io_hal_common_i2c4_init             io_hal_stm32f7xx_i2c4_init
 #define io_hal_common_i2c_transmit          io_hal_stm32f7xx_i2c_transmit
 #define io_hal_common_i2c_receive           io_hal_stm32f7xx_i2c_receive
+#define io_hal_common_i2c_write_read        io_hal_stm32f7xx_i2c_write_read
+#define io_hal_common_i2c_transfer          io_hal_stm32f7xx_i2c_transfer
 #define io_hal_common_i2c_transmit_it       io_hal_stm32f7xx_i2c_transmit_it
 #define io_hal_common_i2c_receive_it        io_hal_stm32f7xx_i2c_receive_it
 #define io_hal_common_i2c_transmit_dma      io_hal_stm32f7xx_i2c_transmit_dma
@@ -444,6 +444,62 @@ hal_ret_sts io_hal_stm32f7xx_i2c_transmit(ioal_i2c_hdle *ioal_hi2c, uint16 addr,
     return ret_sts;
 }
 
+/**
+ * @brief  This API writes and then reads data in master mode, with a repeated start
+ */
+hal_ret_sts io_hal_stm32f7xx_i2c_write_read(ioal_i2c_hdle *ioal_hi2c, uint16 addr, uint8 *wr_data, uint16 wr_size, uint8 *rd_data, uint16 rd_size, uint32 timeout)
+{
+    hal_ret_sts ret_sts = HAL_MAX_ERR;
+    HAL_StatusTypeDef hal_sts;
+    I2C_HandleTypeDef *hi2c = ioal_hi2c->intf_gen_info.vdp_intf_inst_hdle;
+    if(hi2c != NULL && (wr_data != NULL || wr_size == 0) && (rd_data != NULL || rd_size == 0))
+    {
+        if(rd_size == 0)
+        {
+            hal_sts = HAL_I2C_Master_Transmit(hi2c, addr, wr_data, wr_size, timeout);
+        }
+        else if(wr_size == 0)
+        {
+            hal_sts = HAL_I2C_Master_Receive(hi2c, addr, rd_data, rd_size, timeout);
+        }
+        else if(wr_size == 1)
+        {
+            hal_sts = HAL_I2C_Mem_Read(hi2c, addr, wr_data[0], I2C_MEMADD_SIZE_8BIT, rd_data, rd_size, timeout);
+        }
+        else if(wr_size == 2)
+        {
+            hal_sts = HAL_I2C_Mem_Read(hi2c, addr, (uint16_t)((wr_data[0] << 8) | wr_data[1]), I2C_MEMADD_SIZE_16BIT, rd_data, rd_size, timeout);
+        }
+        else
+        {
+            hal_sts = HAL_I2C_Master_Transmit(hi2c, addr, wr_data, wr_size, timeout);
+            if(hal_sts == HAL_OK)
+            {
+                hal_sts = HAL_I2C_Master_Receive(hi2c, addr, rd_data, rd_size, timeout);
+            }
+        }
+        ret_sts = (hal_sts == HAL_OK) ? HAL_SCS : HAL_IO_VDP_ERR;
+    }
+    else
+    {
+        ret_sts = HAL_IO_INVLD_ARG;
+    }
+    return ret_sts;
+}
+
+/**
+ * @brief  This API runs several transactions back to back in master mode
+ */
+hal_ret_sts io_hal_stm32f7xx_i2c_transfer(ioal_i2c_hdle *ioal_hi2c, iohal_i2c_xfer *xfer, uint16 count, uint32 timeout)
+{
+    hal_ret_sts ret_sts = HAL_SCS;
+    for(uint16 i = 0; (i < count) && (ret_sts == HAL_SCS); i++)
+    {
+        ret_sts = io_hal_stm32f7xx_i2c_write_read(ioal_hi2c, xfer[i].addr, xfer[i].wr_data, xfer[i].wr_size, xfer[i].rd_data, xfer[i].rd_size, timeout);
+    }
+    return ret_sts;
+}
+
 /**
  * @brief  This API receives data in master mode
  */
@@ -86,6 +86,17 @@ hal_ret_sts io_hal_stm32f7xx_spi_receive(ioal_spi_hdle *ioal_hspi, uint8 *pdata,
  * @retval HAL status
  */
 hal_ret_sts io_hal_stm32f7xx_spi_transmit_receive(ioal_spi_hdle *ioal_hspi, uint8 *ptxdata, uint8 *prxdata, uint16 size, uint32 timeout);
+/**
+ * @brief This function runs a queue of transfers in blocking mode. Chip
+ *        select is driven by the SPI peripheral, cs_change is not applied.
+ * @param[in] ioal_spi - ioal_spi pointer to a ioal_spi_hdle structure that
+ *                  contains the configuration information for SPI
+ * @param[in,out] xfer - array of transfer descriptors
+ * @param[in] count - number of transfer descriptors
+ * @param[in] timeout - timeout duration of each segment
+ * @retval HAL status
+ */
+hal_ret_sts io_hal_stm32f7xx_spi_transfer(ioal_spi_hdle *ioal_hspi, iohal_spi_xfer *xfer, uint16 count, uint32 timeout);
 /**
  * @brief This function transmit the data in SPI interface with interrupt mode
  * @param[in] ioal_spi - ioal_spi pointer to a ioal_spi_hdle structure that
@@ -199,6 +210,7 @@ void io_hal_stm32f7xx_spi2_reg_cb();
 #define io_hal_common_spi_transmit              io_hal_stm32f7xx_spi_transmit
 #define io_hal_common_spi_receive               io_hal_stm32f7xx_spi_receive
 #define io_hal_common_spi_transmit_receive      io_hal_stm32f7xx_spi_transmit_receive
+#define io_hal_common_spi_transfer              io_hal_stm32f7xx_spi_transfer
 #define io_hal_common_spi_transmit_it           io_hal_stm32f7xx_spi_transmit_it
 #define io_hal_common_spi_receive_it            io_hal_stm32f7xx_spi_receive_it
 #define io_hal_common_spi_transmit_receive_it   io_hal_stm32f7xx_spi_transmit_receive_it
@@ -285,6 +285,40 @@ hal_ret_sts io_hal_stm32f7xx_spi_transmit_receive(ioal_spi_hdle *ioal_hspi, uint
     return ret_sts;
 }
 
+/**
+ * @brief This API runs a queue of transfers in blocking mode
+ */
+hal_ret_sts io_hal_stm32f7xx_spi_transfer(ioal_spi_hdle *ioal_hspi, iohal_spi_xfer *xfer, uint16 count, uint32 timeout)
+{
+    hal_ret_sts ret_sts = HAL_SCS;
+    HAL_StatusTypeDef hal_sts = HAL_OK;
+    SPI_HandleTypeDef *hspi = ioal_hspi->intf_gen_info.vdp_intf_inst_hdle;
+    if(hspi == NULL || (xfer == NULL && count != 0))
+    {
+        return HAL_IO_INVLD_ARG;
+    }
+    for(uint16 i = 0; (i < count) && (hal_sts == HAL_OK); i++)
+    {
+        if(xfer[i].tx_data != NULL && xfer[i].rx_data != NULL)
+        {
+            hal_sts = HAL_SPI_TransmitReceive(hspi, xfer[i].tx_data, xfer[i].rx_data, xfer[i].size, timeout);
+        }
+        else if(xfer[i].tx_data != NULL)
+        {
+            hal_sts = HAL_SPI_Transmit(hspi, xfer[i].tx_data, xfer[i].size, timeout);
+        }
+        else if(xfer[i].rx_data != NULL)
+        {
+            hal_sts = HAL_SPI_Receive(hspi, xfer[i].rx_data, xfer[i].size, timeout);
+        }
+    }
+    if(hal_sts != HAL_OK)
+    {
+        ret_sts = HAL_IO_VDP_ERR;
+    }
+    return ret_sts;
+}
+
 /**
  * @brief This API transmit the data in interrupt mode
  */
@@ -19,6 +19,8 @@
  */
 
 #include <pthread.h>
+#include <errno.h>
+#include <time.h>
 #include "exo_os_common.h"
 #include "unistd.h"
 /*!
@@ -42,11 +44,21 @@ ral_status_t ral_linux_thread_create(ral_thread_handle_ptr *id,uint32_t stack_si
 }
 
 /*!
- * @brief This API is set to waiting time for thread process
+ * @brief This API is set to waiting time for thread process, the tick is one milli second
  */
 ral_status_t ral_linux_thread_delay(ral_tick_time_t tick_time)
 {
-    sleep(tick_time/1000);
+    struct timespec req;
+    req.tv_sec = (time_t)(tick_time/1000);
+    req.tv_nsec = (long)(tick_time%1000)*1000000L;
+    /* Sleep the rest of the interval again when a signal interrupts it */
+    while(nanosleep(&req,&req)!=0)
+    {
+        if(errno!=EINTR)
+        {
+            return(ral_error);
+        }
+    }
     return(ral_success);
 }
 
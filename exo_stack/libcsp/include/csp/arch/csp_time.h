@@ -55,6 +55,18 @@ uint32_t csp_get_ms(void);
 */
 uint32_t csp_get_ms_isr(void);
 
+/**
+   Return monotonic time in uS, resolution is platform dependent (tick rate on FreeRTOS).
+   @return uS.
+*/
+uint32_t csp_get_us(void);
+
+/**
+   Return monotonic time in uS (from ISR).
+   @return uS.
+*/
+uint32_t csp_get_us_isr(void);
+
 /**
    Return current time in seconds.
    @return seconds.
@@ -26,6 +26,9 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
    HMAC support.
 
    Hash-based Message Authentication Code - based on code from libtom.org.
+
+   Packets with #CSP_FSIPHASH set carry a SipHash-2-4 tag instead of the HMAC-SHA1 tag, same
+   length and position. SipHash is much cheaper for short packets, select it with #CSP_O_SIPHASH.
 */
 
 #include "csp_sha1.h"
@@ -69,13 +72,20 @@ int csp_hmac_verify(csp_packet_t * packet, bool include_header);
 int csp_hmac_memory(const void * key, uint32_t keylen, const void * data, uint32_t datalen, uint8_t * hmac);
 
 /**
- * Save a copy of the key string for use by the append/verify functions
+ * Derive the keys used by the append/verify functions.
+ * The HMAC inner and outer pad hash states are precomputed here, so packets only hash their data.
  * @param key HMAC key
  * @param keylen HMAC key length
  * @return #CSP_ERR_NONE on success, otherwise an error code.
  */
 int csp_hmac_set_key(const void * key, uint32_t keylen);
 
+/**
+ * Use the all zero key, unless csp_hmac_set_key() was already called.
+ * Called once by csp_init(), before the router tasks start.
+ */
+void csp_hmac_set_default_key(void);
+
 #ifdef __cplusplus
 }
 #endif
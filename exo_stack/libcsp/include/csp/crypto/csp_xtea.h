@@ -40,6 +40,12 @@ extern "C" {
 */
 int csp_xtea_set_key(const void * key, uint32_t keylen);
 
+/**
+   Use the all zero key, unless csp_xtea_set_key() was already called.
+   Called once by csp_init(), before the router tasks start.
+*/
+void csp_xtea_set_default_key(void);
+
 /**
    XTEA encrypt byte array
    @param[in] data data to be encrypted.
@@ -61,6 +61,7 @@ typedef struct csp_conf_s {
 	uint16_t buffers;		/**< Number of CSP buffers */
 	uint16_t buffer_data_size;	/**< Data size of a CSP buffer. Total size will be sizeof(#csp_packet_t) + data_size. */
 	uint32_t conn_dfl_so;		/**< Default connection options. Options will always be or'ed onto new connections, see csp_connect() */
+	uint8_t route_workers;		/**< Number of router tasks started by csp_route_start_task(), incoming packets are sharded by connection */
 } csp_conf_t;
 
 /**
@@ -81,6 +82,7 @@ static inline void csp_conf_get_defaults(csp_conf_t * conf) {
 	conf->buffers = 10;
 	conf->buffer_data_size = 213*8;
 	conf->conn_dfl_so = CSP_O_NONE;
+	conf->route_workers = 1;
 }
 
 /**
@@ -316,6 +318,8 @@ int csp_bind(csp_socket_t *socket, uint8_t port);
 /**
    Start the router task.
    The router task calls csp_route_work() to do the actual work.
+   With csp_conf_t.route_workers above 1, that many router tasks are started instead, each routing
+   the connections hashed to it from start to finish, and RDP timeouts are checked by a separate task.
    @param[in] task_stack_size stack size for the task, see csp_thread_create() for details on the stack size parameter.
    @param[in] task_priority priority for the task, see csp_thread_create() for details on the stack size parameter.
    @return #CSP_ERR_NONE on success, otherwise an error code.
@@ -447,7 +451,7 @@ int csp_get_uptime(uint8_t node, uint32_t timeout, uint32_t * uptime);
    The RDP options are used from the connecting/client side. When a RDP connection is established, the client tranmits the options to the server.
    @param[in] window_size window size
    @param[in] conn_timeout_ms connection timeout in mS
-   @param[in] packet_timeout_ms packet timeout in mS.
+   @param[in] packet_timeout_ms initial retransmission timeout in mS, adapted to the measured round-trip time once the connection is open.
    @param[in] delayed_acks enable/disable delayed acknowledgements.
    @param[in] ack_timeout acknowledgement timeout when delayed ACKs is enabled
    @param[in] ack_delay_count send acknowledgement for every ack_delay_count packets.
@@ -470,6 +474,26 @@ void csp_rdp_get_opt(unsigned int *window_size, unsigned int *conn_timeout_ms,
 		unsigned int *packet_timeout_ms, unsigned int *delayed_acks,
 		unsigned int *ack_timeout, unsigned int *ack_delay_count);
 
+/** Size the TX window from the measured bandwidth-delay product, starting at window_size and growing up to #csp_conf_t.rdp_max_window */
+#define CSP_RDP_OPT_AUTO_WINDOW		0x01
+/** Send extended ACKs as a bitmap of the segments received out of order, instead of a list of sequence numbers */
+#define CSP_RDP_OPT_SACK		0x02
+
+/**
+   Set RDP protocol extensions.
+   Like the options set by csp_rdp_set_opt(), the extensions are requested by the connecting/client side. They are
+   only used if the server supports them as well, otherwise the connection falls back to the basic protocol.
+   @param[in] options mask of CSP_RDP_OPT_* flags, 0 disables all extensions (default).
+*/
+void csp_rdp_set_ext_opt(unsigned int options);
+
+/**
+   Get RDP protocol extensions.
+   @see csp_rdp_set_ext_opt()
+   @param[out] options mask of CSP_RDP_OPT_* flags
+*/
+void csp_rdp_get_ext_opt(unsigned int *options);
+
 /**
    Print connection table to stdout.
 */
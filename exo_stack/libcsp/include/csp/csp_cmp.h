@@ -28,6 +28,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 
 #include "csp.h"
 #include "csp_clock.h"
+#include "csp_stats.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -78,6 +79,14 @@ extern "C" {
    Get/set clock.
 */
 #define CSP_CMP_CLOCK 6
+/**
+   Request port statistics, see csp_stats.h.
+*/
+#define CSP_CMP_PORT_STATS 7
+/**
+   Request a router latency histogram, see csp_stats.h.
+*/
+#define CSP_CMP_LATENCY 8
 /**@}*/
 
 /**
@@ -153,6 +162,21 @@ struct csp_cmp_message {
 			char data[CSP_CMP_POKE_MAX_LEN];
 		} poke;
 		csp_timestamp_t clock;
+		struct __attribute__((__packed__)) {
+			uint8_t port;
+			uint32_t rx;
+			uint32_t rxbytes;
+			uint32_t tx;
+			uint32_t txbytes;
+			uint32_t drop;
+		} port_stats;
+		struct __attribute__((__packed__)) {
+			char interface[CSP_CMP_ROUTE_IFACE_LEN]; //!< Empty for the sum over all interfaces
+			uint8_t stage;                            //!< #csp_stats_stage_t
+			uint32_t count;
+			uint32_t max_us;
+			uint32_t bucket[CSP_STATS_HIST_BUCKETS];
+		} latency;
 	};
 } __attribute__ ((packed));
 
@@ -184,6 +208,8 @@ CMP_MESSAGE(CSP_CMP_IDENT, ident)
 CMP_MESSAGE(CSP_CMP_ROUTE_SET, route_set)
 CMP_MESSAGE(CSP_CMP_IF_STATS, if_stats)
 CMP_MESSAGE(CSP_CMP_CLOCK, clock)
+CMP_MESSAGE(CSP_CMP_PORT_STATS, port_stats)
+CMP_MESSAGE(CSP_CMP_LATENCY, latency)
 
 /**
    Peek (read) memory on remote node.
@@ -27,6 +27,8 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
    Error codes.
 */
 
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -54,6 +56,24 @@ extern "C" {
 #define CSP_ERR_SFP		-103		/**< SFP protocol error or inconsistency */
 /**@}*/
 
+/**
+   CSP error counters, incremented where the corresponding error code is raised.
+*/
+typedef struct {
+	uint32_t csp_err_nomem;		/**< #CSP_ERR_NOMEM count */
+	uint32_t csp_err_inval;		/**< #CSP_ERR_INVAL count */
+	uint32_t csp_err_timedout;	/**< #CSP_ERR_TIMEDOUT count */
+	uint32_t csp_err_notsup;	/**< #CSP_ERR_NOTSUP count */
+	uint32_t csp_err_busy;		/**< #CSP_ERR_BUSY count */
+	uint32_t csp_err_already;	/**< #CSP_ERR_ALREADY count */
+	uint32_t csp_err_reset;		/**< #CSP_ERR_RESET count */
+	uint32_t csp_err_nobufs;	/**< #CSP_ERR_NOBUFS count */
+	uint32_t csp_err_driver;	/**< #CSP_ERR_DRIVER count */
+} csp_tm_t;
+
+/** Global CSP error counters */
+extern csp_tm_t csp_tm_global;
+
 #ifdef __cplusplus
 }
 #endif
@@ -45,6 +45,14 @@ extern "C" {
 */
 int csp_iflist_add(csp_iface_t * iface);
 
+/**
+   Remove interface from the list, and the routes through it.
+
+   @param[in] iface interface.
+   @return #CSP_ERR_NONE on success, #CSP_ERR_INVAL if the interface was not in the list.
+*/
+int csp_iflist_remove(csp_iface_t * iface);
+
 /**
    Get interface by name.
 
@@ -27,6 +27,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 */
 
 #include "csp_platform.h"
+#include "csp_stats.h"
 
 //#include "FreeRTOS.h"
 //#define CSP_BASE_TYPE portBASE_TYPE
@@ -70,6 +71,9 @@ struct csp_iface_s {
     uint32_t txbytes;          //!< Transmitted bytes
     uint32_t rxbytes;          //!< Received bytes
     uint32_t irq;              //!< Interrupts
+#if (CSP_USE_STATS)
+    csp_stats_hist_t latency[CSP_STATS_STAGES]; //!< Router latency, see csp_stats.h
+#endif
     struct csp_iface_s *next;  //!< Internal, interfaces are stored in a linked list
 };
 //doc-end:csp_iface_s
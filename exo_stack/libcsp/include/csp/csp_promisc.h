@@ -29,6 +29,10 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
    This function is used to enable promiscuous mode for incoming packets, e.g. router, bridge.
    If enabled, a copy of all incoming packets are cloned (using csp_buffer_clone()) and placed in a
    FIFO queue, that can be read using csp_promisc_read().
+
+   The packet tap is a lighter alternative for monitoring: the header and the first bytes of each
+   (sampled, filtered) packet are copied into a lock-free ring read with csp_promisc_tap_read(),
+   no CSP buffers are used and a full ring drops records instead of blocking the router.
 */
 
 #include "csp_types.h"
@@ -58,6 +62,71 @@ void csp_promisc_disable(void);
 */
 csp_packet_t *csp_promisc_read(uint32_t timeout);
 
+/**
+   Max payload bytes stored per tap record.
+*/
+#ifndef CSP_PROMISC_TAP_SNAP_MAX
+#define CSP_PROMISC_TAP_SNAP_MAX	64
+#endif
+
+/**
+   Packet tap configuration.
+*/
+typedef struct {
+	/** Number of records in the ring, rounded up to a power of two. Only used when the ring is created. */
+	unsigned int ring_size;
+	/** Payload bytes to store per packet, at most #CSP_PROMISC_TAP_SNAP_MAX. */
+	unsigned int snap_len;
+	/** Record 1 in sample_rate matching packets, 0 or 1 records all. */
+	unsigned int sample_rate;
+	/** Ports to record, a packet matches on source or destination port. All zero records all ports. */
+	uint32_t port_mask[(CSP_ID_PORT_MAX / 32) + 1];
+} csp_promisc_tap_conf_t;
+
+/**
+   Packet tap record.
+*/
+typedef struct {
+	/** Packet id, host byte order */
+	csp_id_t id;
+	/** Time of capture, csp_get_ms() */
+	uint32_t timestamp;
+	/** Packet length */
+	uint16_t length;
+	/** Number of valid bytes in data */
+	uint16_t snap_len;
+	/** First bytes of the packet data */
+	uint8_t data[CSP_PROMISC_TAP_SNAP_MAX];
+} csp_promisc_tap_record_t;
+
+/**
+   Enable the packet tap.
+   The ring is created on the first call, later calls only update snap length, sampling and filter.
+   @param[in] conf tap configuration.
+   @return #CSP_ERR_NONE on success, otherwise an error code.
+*/
+int csp_promisc_tap_enable(const csp_promisc_tap_conf_t * conf);
+
+/**
+   Disable the packet tap, records already in the ring can still be read.
+*/
+void csp_promisc_tap_disable(void);
+
+/**
+   Read the oldest record from the packet tap.
+   @param[out] record the record.
+   @param[in] timeout Timeout in ms to wait for a record.
+   @return #CSP_ERR_NONE on success, #CSP_ERR_TIMEDOUT if the ring stayed empty.
+*/
+int csp_promisc_tap_read(csp_promisc_tap_record_t * record, uint32_t timeout);
+
+/**
+   Get packet tap counters.
+   @param[out] captured records written to the ring, may be NULL.
+   @param[out] dropped records lost because the ring was full, may be NULL.
+*/
+void csp_promisc_tap_stats(uint32_t * captured, uint32_t * dropped);
+
 #ifdef __cplusplus
 }
 #endif
@@ -76,6 +76,49 @@ static inline int csp_sfp_send(csp_conn_t * conn, const void * data, unsigned in
     return csp_sfp_send_own_memcpy(conn, data, datasize, mtu, timeout, (csp_memcpy_fnc_t) &memcpy);
 }
     
+/**
+   Send data already stored in CSP buffers over a CSP connection.
+
+   The packets are sent as the fragments of one transfer, in array order, without copying the data. Each packet must
+   have room for the SFP header after its data, i.e. length + 8 bytes must fit into csp_buffer_data_size().
+
+   csp_sfp_recv() or csp_sfp_recv_fp() can be used at the other end to receive data.
+
+   @param[in] conn established connection for sending SFP packets.
+   @param[in] packets fragments to send. All packets are consumed, also on failure.
+   @param[in] count number of packets
+   @param[in] timeout unused as of CSP version 1.6
+   @return #CSP_ERR_NONE on success, otherwise an error.
+*/
+int csp_sfp_send_packets(csp_conn_t * conn, csp_packet_t ** packets, unsigned int count, uint32_t timeout);
+
+/**
+   Fragment callback for csp_sfp_recv_cb().
+   @param[in] context user context passed to csp_sfp_recv_cb()
+   @param[in] offset offset of fragment in the transfer
+   @param[in] data fragment data, only valid during the call
+   @param[in] size size of \a data
+   @param[in] totalsize total size of the transfer
+   @return #CSP_ERR_NONE to continue, otherwise the error is returned by csp_sfp_recv_cb().
+*/
+typedef int (*csp_sfp_recv_fnc_t)(void * context, uint32_t offset, const void * data, unsigned int size, uint32_t totalsize);
+
+/**
+   Receive data over a CSP connection, without reassembling it in memory.
+
+   This is the counterpart to the csp_sfp_send() and csp_sfp_send_own_memcpy(). Each fragment is passed to \a fragfcn
+   as it arrives, so it can be written directly to its destination, e.g. a file. Fragments may arrive out of order,
+   duplicates are dropped.
+
+   @param[in] conn established connection for receiving SFP packets.
+   @param[in] fragfcn called once for every fragment.
+   @param[in] context user context passed to \a fragfcn.
+   @param[in] timeout timeout in ms to wait for csp_read()
+   @param[in] first_packet First packet of a SFP transfer. Use NULL to receive first packet on the connection.
+   @return #CSP_ERR_NONE on success, otherwise an error.
+*/
+int csp_sfp_recv_cb(csp_conn_t * conn, csp_sfp_recv_fnc_t fragfcn, void * context, uint32_t timeout, csp_packet_t * first_packet);
+
 /**
    Receive data over a CSP connection.
 
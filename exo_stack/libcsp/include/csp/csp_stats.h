@@ -0,0 +1,131 @@
+/*
+Cubesat Space Protocol - A small network-layer protocol designed for Cubesats
+Copyright (C) 2012 Gomspace ApS (http://www.gomspace.com)
+Copyright (C) 2012 AAUSAT3 Project (http://aausat3.space.aau.dk) 
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef _CSP_CSP_STATS_H_
+#define _CSP_CSP_STATS_H_
+
+/**
+   @file
+
+   Router statistics.
+
+   Packets are stamped with a monotonic uS time (csp_get_us()) when an interface hands them to
+   the router with csp_qfifo_write(). The router then records three latency stages per interface:
+   the time spent waiting in the router fifo, the time spent routing (dedup, security checks,
+   connection lookup) until the packet is handed to a socket, connection or outgoing interface,
+   and the time the outgoing interface takes to transmit it. Latencies are kept as log2 histograms.
+
+   Besides the interface counters in #csp_iface_t, packets and bytes are counted per port: received
+   and dropped per destination port, transmitted per source port of locally originated packets.
+
+   Statistics are only collected when CSP is compiled with CSP_USE_STATS.
+*/
+
+#include "csp_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+   Number of histogram buckets.
+   Bucket 0 counts latencies below 2 uS, bucket n counts [2^n, 2^(n+1)) uS, the last bucket
+   also counts everything above (from ~8 seconds). Part of the CMP wire format.
+*/
+#define CSP_STATS_HIST_BUCKETS	24
+
+/**
+   Router latency stages.
+*/
+typedef enum {
+	CSP_STATS_QFIFO = 0,	//!< Router fifo wait, from interface Rx to router dequeue (input interface)
+	CSP_STATS_ROUTE = 1,	//!< Routing, from router dequeue to hand-off (input interface)
+	CSP_STATS_TX = 2,	//!< Transmit, time spent in the next hop function (output interface)
+	CSP_STATS_STAGES = 3,	//!< Number of stages
+} csp_stats_stage_t;
+
+/**
+   Latency histogram.
+*/
+typedef struct {
+	/** Number of samples */
+	uint32_t count;
+	/** Largest sample in uS */
+	uint32_t max_us;
+	/** Samples per log2 uS bucket */
+	uint32_t bucket[CSP_STATS_HIST_BUCKETS];
+} csp_stats_hist_t;
+
+/**
+   Per port counters.
+*/
+typedef struct {
+	/** Packets received for the port (destination port) */
+	uint32_t rx;
+	/** Bytes received for the port */
+	uint32_t rxbytes;
+	/** Packets transmitted from the port (source port, local packets only) */
+	uint32_t tx;
+	/** Bytes transmitted from the port */
+	uint32_t txbytes;
+	/** Received packets dropped, e.g. no socket listening or socket queue full */
+	uint32_t drop;
+} csp_stats_port_t;
+
+/**
+   Get the counters of a port.
+   @param[in] port port number, max #CSP_ID_PORT_MAX.
+   @param[out] stats counters.
+   @return #CSP_ERR_NONE on success, otherwise an error code.
+*/
+int csp_stats_get_port(uint8_t port, csp_stats_port_t * stats);
+
+/**
+   Get a latency histogram.
+   @param[in] iface interface, NULL for the sum over all interfaces.
+   @param[in] stage latency stage.
+   @param[out] hist histogram.
+   @return #CSP_ERR_NONE on success, otherwise an error code.
+*/
+int csp_stats_get_latency(const csp_iface_t * iface, csp_stats_stage_t stage, csp_stats_hist_t * hist);
+
+/**
+   Get the upper bound of the histogram bucket holding a percentile of the samples.
+   @param[in] hist histogram.
+   @param[in] percent percentile, 1 - 100.
+   @return latency in uS, 0 if the histogram is empty.
+*/
+uint32_t csp_stats_percentile(const csp_stats_hist_t * hist, unsigned int percent);
+
+/**
+   Clear port counters and latency histograms.
+   Interface counters (#csp_iface_t) are not touched. Samples recorded while clearing may be lost.
+*/
+void csp_stats_reset(void);
+
+/**
+   Print latency statistics for all interfaces and the counters of all active ports.
+*/
+void csp_stats_print(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -39,18 +39,46 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 /* #undef CSP_MACOSX */
 #define CSP_DEBUG 1
 #define CSP_DEBUG_TIMESTAMP 0
+/* The CSP_USE_* switches may be overridden from the build, e.g. for the host tests */
+#ifndef CSP_USE_RDP
 #define CSP_USE_RDP 0
+#endif
+#ifndef CSP_USE_RDP_FAST_CLOSE
 #define CSP_USE_RDP_FAST_CLOSE 0
+#endif
+#ifndef CSP_USE_CRC32
 #define CSP_USE_CRC32 0
+#endif
+#ifndef CSP_USE_HMAC
 #define CSP_USE_HMAC 0
+#endif
+#ifndef CSP_USE_XTEA
 #define CSP_USE_XTEA 0
+#endif
+#ifndef CSP_USE_PROMISC
 #define CSP_USE_PROMISC 0
+#endif
+#ifndef CSP_USE_STATS
+#define CSP_USE_STATS 0
+#endif
+#ifndef CSP_USE_QOS
 #define CSP_USE_QOS 0
+#endif
+#ifndef CSP_USE_DEDUP
 #define CSP_USE_DEDUP 0
+#endif
+#ifndef CSP_USE_EXTERNAL_DEBUG
 #define CSP_USE_EXTERNAL_DEBUG 0
+#endif
+#ifndef CSP_USE_CSPERF
 #define CSP_USE_CSPERF 0
+#endif
+#ifndef CSP_USE_IF_SLGND
 #define CSP_USE_IF_SLGND 0
+#endif
+#ifndef CSP_USE_IF_SLUDP
 #define CSP_USE_IF_SLUDP 0
+#endif
 #define CSP_LOG_LEVEL_DEBUG 1
 #define CSP_LOG_LEVEL_INFO 1
 #define CSP_LOG_LEVEL_WARN 1
@@ -192,7 +220,7 @@ typedef union {
    @defgroup CSP_HEADER_FLAGS CSP header flags.
    @{
 */
-#define CSP_FRES1			0x80 //!< Reserved for future use
+#define CSP_FSIPHASH			0x80 //!< HMAC field holds a SipHash-2-4 tag instead of HMAC-SHA1 (with #CSP_FHMAC)
 #define CSP_FRES2			0x40 //!< Reserved for future use
 #define CSP_FRES3			0x20 //!< Reserved for future use
 #define CSP_FFRAG			0x10 //!< Use fragmentation
@@ -216,6 +244,7 @@ typedef union {
 #define CSP_SO_CRC32REQ			0x0040 //!< Require CRC32
 #define CSP_SO_CRC32PROHIB		0x0080 //!< Prohibit CRC32
 #define CSP_SO_CONN_LESS		0x0100 //!< Enable Connection Less mode
+#define CSP_SO_SIPHASHREQ		0x0200 //!< Require SipHash authentication
 #define CSP_SO_INTERNAL_LISTEN          0x1000 //!< Internal flag: listen called on socket
 /**@}*/
 
@@ -232,6 +261,7 @@ typedef union {
 #define CSP_O_NOXTEA			CSP_SO_XTEAPROHIB  //!< Disable XTEA
 #define CSP_O_CRC32			CSP_SO_CRC32REQ    //!< Enable CRC32
 #define CSP_O_NOCRC32			CSP_SO_CRC32PROHIB //!< Disable CRC32
+#define CSP_O_SIPHASH			CSP_SO_SIPHASHREQ  //!< Enable SipHash authentication, faster than HMAC
 /**@}*/
 
 /**
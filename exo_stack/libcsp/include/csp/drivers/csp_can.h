@@ -23,9 +23,11 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 /**
    @file
 
-   Socket CAN driver (Linux).
+   CAN driver on top of the IO-AL CAN interface.
 
-   This driver requires the libsocketcan library.
+   On target the driver receives from the bxCAN Rx FIFO callback. On linux
+   (LINUX_TEMP_PORT) it uses SocketCAN through the linux IO-AL, e.g. on vcan0,
+   moving frames in batches and filtering on csp_get_address() in the kernel.
 */
 
 #include "csp_if_can.h"
@@ -67,7 +69,8 @@ csp_iface_t * csp_can_init(const char * device,ioal_can_hdle* can_intf_hdl);
 /**
    Stop the Rx thread and free resources (testing).
 
-   @note This will invalidate CSP, because an interface can't be removed. This is primarily for testing.
+   @note The SocketCAN driver removes the interface and its routes first. The STM32 driver cannot, which
+   invalidates CSP. This is primarily for testing.
 
    @param[in] iface interface to stop.
    @return #CSP_ERR_NONE on success, otherwise an error code.
@@ -67,8 +67,12 @@ typedef struct {
 	unsigned int max_rx_length;
 	/** Tx function */
 	csp_kiss_driver_tx_t tx_func;
-	/** Tx lock. Current implementation doesn't transfer data to driver in a single 'write', hence locking is necessary. */
+	/** Tx lock. Frames are encoded into the shared tx_buf, hence locking is necessary. */
 	csp_mutex_t lock;
+	/** Tx buffer, holds one encoded frame which is passed to the driver in a single 'write'. Allocated by csp_kiss_add_interface(). */
+	uint8_t * tx_buf;
+	/** Tx buffer size, fits a frame of max_rx_length bytes with every byte escaped. */
+	unsigned int tx_buf_size;
 	/** Rx mode/state. */
 	csp_kiss_mode_t rx_mode;
 	/** Rx length */
@@ -77,6 +81,8 @@ typedef struct {
 	bool rx_first;
 	/** CSP packet for storing Rx data. */
 	csp_packet_t * rx_packet;
+	/** UHF frame parser, used when the interface carries UHF UART frames (csp_uhf_rx()). */
+	struct csp_uhf_parser * uhf_parser;
 } csp_kiss_interface_data_t;
 
 /**
@@ -23,6 +23,7 @@
 #define CSP_IF_UHF_H_
 
 #include <stdint.h>
+#include <stddef.h>
 #include <errno.h>
 
 #define UHF_START_BYTE_0     0x22           /** First start byte  */
@@ -44,6 +45,53 @@ typedef enum {
     UHF_RECEIVE_DATA
 }e_uhf_uart_state_t;
 
+/**
+ * @brief Called for every complete UHF UART frame
+ *
+ * @param[in] user_data - Reference given to csp_uhf_parser_feed()
+ * @param[in] frame - Length byte followed by the frame body (header and payload),
+ *                    only valid during the call
+ * @param[in] pxTaskWoken - Task woken flag given to csp_uhf_parser_feed()
+ */
+typedef void (*csp_uhf_frame_cb_t)(void * user_data, const uint8_t * frame, void * pxTaskWoken);
+
+/**
+ * @brief UHF UART frame parser state, one per radio
+ *
+ * Frames that arrive within one input chunk are handed out in place, only
+ * frames split over several chunks are collected in frame[].
+ */
+typedef struct csp_uhf_parser {
+    e_uhf_uart_state_t state;                  /*!< Receive state */
+    uint8_t length;                            /*!< Length of the frame being received */
+    uint8_t fill;                              /*!< Body bytes collected in frame[] */
+    uint8_t frame[1 + UHF_MAX_PAYLOAD];        /*!< Length byte and body of a split frame */
+}csp_uhf_parser_t;
+
+/**
+ * @brief Reset a UHF frame parser
+ *
+ * @param[out] parser - Parser to reset
+ */
+void csp_uhf_parser_init(csp_uhf_parser_t * parser);
+
+/**
+ * @brief Parse a chunk of received UHF UART data
+ *
+ * Accepts chunks of any length, the sync words are located with memchr()
+ * and complete frames are passed to frame_cb without copying when possible.
+ *
+ * @param[in,out] parser - Parser state
+ * @param[in] buf - Received data
+ * @param[in] len - Length of received data
+ * @param[in] frame_cb - Called for every complete frame
+ * @param[in] user_data - Forwarded to frame_cb
+ * @param[in] pxTaskWoken - Forwarded to frame_cb
+ * @return Number of frames dropped for an invalid length byte
+ */
+unsigned int csp_uhf_parser_feed(csp_uhf_parser_t * parser, const uint8_t * buf, size_t len,
+                                 csp_uhf_frame_cb_t frame_cb, void * user_data, void * pxTaskWoken);
+
 /**
  * @brief Send packet over UHF interface
  * 
@@ -61,6 +109,8 @@ int csp_uhf_tx(const csp_route_t * ifroute, csp_packet_t * packet);
  * @brief Handle received UHF packet
  *
  * This function handles a packet received on the UHF radio interface.
+ * The parser state is taken from the uhf_parser of the interface data,
+ * so each radio must have its own parser.
  * 
  * @param[in] iface - Pointer to CSP interface 
  * @param[in] buf - Pointer to received packet data
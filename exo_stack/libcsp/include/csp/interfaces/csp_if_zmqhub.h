@@ -54,6 +54,23 @@ extern "C" {
 */
 #define CSP_ZMQHUB_IF_NAME            "ZMQHUB"
 
+/**
+   Flag for the init functions: event driven mode.
+   The Rx thread waits with zmq_poll() and then drains the subscriber without blocking, receiving each
+   message straight into a CSP buffer. Tx hands the CSP buffer to ZMQ with zmq_msg_init_data(), the buffer
+   is freed when ZMQ is done with it. The wire format is unchanged, so both modes can share a hub.
+   Works with any ZMQ transport, e.g. inproc:// or ipc:// for processes on one host.
+*/
+#define CSP_ZMQHUB_FLAG_EVENT         0x0001
+
+/**
+   ZMQ context of the interfaces.
+   All interfaces share one context, created by the first call. A hub in the same process must create its
+   sockets in this context to reach the interfaces over inproc:// endpoints.
+   @return ZMQ context, NULL if it could not be created.
+*/
+void * csp_zmqhub_context(void);
+
 /**
    Format endpoint connection string for ZMQ.
 
@@ -32,6 +32,14 @@ uint32_t csp_get_ms_isr(void) {
 	return (uint32_t)(xTaskGetTickCountFromISR() * (1000/configTICK_RATE_HZ));
 }
 
+uint32_t csp_get_us(void) {
+	return (uint32_t)(xTaskGetTickCount() * (1000000/configTICK_RATE_HZ));
+}
+
+uint32_t csp_get_us_isr(void) {
+	return (uint32_t)(xTaskGetTickCountFromISR() * (1000000/configTICK_RATE_HZ));
+}
+
 uint32_t csp_get_s(void) {
 	return (uint32_t)(xTaskGetTickCount()/configTICK_RATE_HZ);
 }
@@ -40,16 +48,45 @@ uint32_t csp_get_s_isr(void) {
 	return (uint32_t)(xTaskGetTickCountFromISR()/configTICK_RATE_HZ);
 }
 #else
+#ifdef LINUX_TEMP_PORT
+#include <time.h>
+#endif
+
 uint32_t csp_get_ms(void) {
+#ifdef LINUX_TEMP_PORT
+	/* RDP timers and connection timeouts need a running clock */
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint32_t)((ts.tv_sec * 1000) + (ts.tv_nsec / 1000000));
+#else
 	return 0;
+#endif
 }
 uint32_t csp_get_ms_isr(void) {
+	return csp_get_ms();
+}
+uint32_t csp_get_us(void) {
+#ifdef LINUX_TEMP_PORT
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint32_t)((ts.tv_sec * 1000000) + (ts.tv_nsec / 1000));
+#else
 	return 0;
+#endif
+}
+uint32_t csp_get_us_isr(void) {
+	return csp_get_us();
 }
 uint32_t csp_get_s(void) {
+#ifdef LINUX_TEMP_PORT
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint32_t)ts.tv_sec;
+#else
 	return 0;
+#endif
 }
 uint32_t csp_get_s_isr(void) {
-	return 0;
+	return csp_get_s();
 }
 #endif
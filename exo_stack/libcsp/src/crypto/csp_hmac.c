@@ -30,17 +30,20 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 
 #define HMAC_KEY_LENGTH	16
 
-/* HMAC key */
-static uint8_t csp_hmac_key[HMAC_KEY_LENGTH];
-
-/* HMAC state structure */
+/* HMAC state structure, holds the hash states after the inner and outer key pads */
 typedef struct {
 	csp_sha1_state_t md;
-	uint8_t		 key[CSP_SHA1_BLOCKSIZE];
+	csp_sha1_state_t outer;
 } hmac_state;
 
+/* Key schedule for packets, computed once by csp_hmac_set_key() */
+static hmac_state csp_hmac_key_state;
+static uint64_t csp_siphash_key[2];
+static bool csp_hmac_key_valid;
+
 static int csp_hmac_init(hmac_state * hmac, const uint8_t * key, uint32_t keylen) {
 	uint32_t i;
+	uint8_t k[CSP_SHA1_BLOCKSIZE];
 	uint8_t buf[CSP_SHA1_BLOCKSIZE];
 
     /* NULL pointer and key check */
@@ -51,24 +54,31 @@ static int csp_hmac_init(hmac_state * hmac, const uint8_t * key, uint32_t keylen
 
 	/* Make sure we have a large enough key */
 	if(keylen > CSP_SHA1_BLOCKSIZE) {
-		csp_sha1_memory(key, keylen, hmac->key);
+		csp_sha1_memory(key, keylen, k);
 		if(CSP_SHA1_DIGESTSIZE < CSP_SHA1_BLOCKSIZE)
-			memset((hmac->key) + CSP_SHA1_DIGESTSIZE, 0, (CSP_SHA1_BLOCKSIZE - CSP_SHA1_DIGESTSIZE));
+			memset(k + CSP_SHA1_DIGESTSIZE, 0, (CSP_SHA1_BLOCKSIZE - CSP_SHA1_DIGESTSIZE));
 	} else {
-		memcpy(hmac->key, key, keylen);
+		memcpy(k, key, keylen);
 		if(keylen < CSP_SHA1_BLOCKSIZE)
-			memset((hmac->key) + keylen, 0, (CSP_SHA1_BLOCKSIZE - keylen));
+			memset(k + keylen, 0, (CSP_SHA1_BLOCKSIZE - keylen));
 	}
 
 	/* Create the initial vector */
 	for(i = 0; i < CSP_SHA1_BLOCKSIZE; i++) {
-		buf[i] = hmac->key[i] ^ 0x36;
+		buf[i] = k[i] ^ 0x36;
 	}
 
 	/* Prepend to the hash data */
 	csp_sha1_init(&hmac->md);
 	csp_sha1_process(&hmac->md, buf, CSP_SHA1_BLOCKSIZE);
 
+	/* Create the second HMAC vector, prepended to the outer hash */
+	for(i = 0; i < CSP_SHA1_BLOCKSIZE; i++) {
+		buf[i] = k[i] ^ 0x5C;
+	}
+	csp_sha1_init(&hmac->outer);
+	csp_sha1_process(&hmac->outer, buf, CSP_SHA1_BLOCKSIZE);
+
 	return CSP_ERR_NONE;
 }
 
@@ -97,20 +107,9 @@ static int csp_hmac_done(hmac_state * hmac, uint8_t * out) {
 	uint8_t isha[CSP_SHA1_DIGESTSIZE];
 	csp_sha1_done(&hmac->md, isha);
 
-	/* Create the second HMAC vector vector */
-	uint8_t buf[CSP_SHA1_BLOCKSIZE];
-	for(unsigned int i = 0; i < sizeof(buf); i++) {
-		buf[i] = hmac->key[i] ^ 0x5C;
-	}
-
 	/* Now calculate the outer hash */
-	csp_sha1_init(&hmac->md);
-	csp_sha1_process(&hmac->md, buf, sizeof(buf));
-	csp_sha1_process(&hmac->md, isha, sizeof(isha));
-	csp_sha1_done(&hmac->md, buf);
-
-	/* Copy to output  */
-	memcpy(out, buf, CSP_SHA1_DIGESTSIZE);
+	csp_sha1_process(&hmac->outer, isha, sizeof(isha));
+	csp_sha1_done(&hmac->outer, out);
 
 	return CSP_ERR_NONE;
 }
@@ -145,35 +144,132 @@ int csp_hmac_memory(const void * key, uint32_t keylen, const void * data, uint32
 	return CSP_ERR_NONE;
 }
 
+#define SIP_ROTL(x, b) (uint64_t)(((x) << (b)) | ((x) >> (64 - (b))))
+
+#define SIP_ROUND(v0, v1, v2, v3) do { \
+	v0 += v1; v1 = SIP_ROTL(v1, 13); v1 ^= v0; v0 = SIP_ROTL(v0, 32); \
+	v2 += v3; v3 = SIP_ROTL(v3, 16); v3 ^= v2; \
+	v0 += v3; v3 = SIP_ROTL(v3, 21); v3 ^= v0; \
+	v2 += v1; v1 = SIP_ROTL(v1, 17); v1 ^= v2; v2 = SIP_ROTL(v2, 32); \
+} while (0)
+
+static uint64_t csp_siphash_load64(const uint8_t * p) {
+	return ((uint64_t)p[0]) | ((uint64_t)p[1] << 8) | ((uint64_t)p[2] << 16) | ((uint64_t)p[3] << 24) |
+	       ((uint64_t)p[4] << 32) | ((uint64_t)p[5] << 40) | ((uint64_t)p[6] << 48) | ((uint64_t)p[7] << 56);
+}
+
+/* SipHash-2-4 (Aumasson, Bernstein), a keyed hash for short messages */
+static uint64_t csp_siphash(const uint64_t key[2], const uint8_t * in, uint32_t inlen) {
+
+	uint64_t v0 = key[0] ^ 0x736f6d6570736575ULL;
+	uint64_t v1 = key[1] ^ 0x646f72616e646f6dULL;
+	uint64_t v2 = key[0] ^ 0x6c7967656e657261ULL;
+	uint64_t v3 = key[1] ^ 0x7465646279746573ULL;
+	const uint8_t * end = in + (inlen & ~7U);
+	uint64_t m;
+
+	for (; in != end; in += 8) {
+		m = csp_siphash_load64(in);
+		v3 ^= m;
+		SIP_ROUND(v0, v1, v2, v3);
+		SIP_ROUND(v0, v1, v2, v3);
+		v0 ^= m;
+	}
+
+	/* Last block holds the remaining bytes and the length */
+	m = ((uint64_t)inlen) << 56;
+	for (unsigned int i = 0; i < (inlen & 7U); i++) {
+		m |= ((uint64_t)in[i]) << (8 * i);
+	}
+	v3 ^= m;
+	SIP_ROUND(v0, v1, v2, v3);
+	SIP_ROUND(v0, v1, v2, v3);
+	v0 ^= m;
+
+	v2 ^= 0xff;
+	SIP_ROUND(v0, v1, v2, v3);
+	SIP_ROUND(v0, v1, v2, v3);
+	SIP_ROUND(v0, v1, v2, v3);
+	SIP_ROUND(v0, v1, v2, v3);
+
+	return v0 ^ v1 ^ v2 ^ v3;
+}
+
 int csp_hmac_set_key(const void * key, uint32_t keylen) {
 
 	/* Use SHA1 as KDF */
 	uint8_t hash[CSP_SHA1_DIGESTSIZE];
 	csp_sha1_memory(key, keylen, hash);
 
-	/* Copy key */
-	memcpy(csp_hmac_key, hash, sizeof(csp_hmac_key));
+	/* Precompute the key pads, packets only process their data */
+	csp_hmac_init(&csp_hmac_key_state, hash, HMAC_KEY_LENGTH);
+
+	/* Separate SipHash key, derived with HMAC so it differs from the HMAC key */
+	static const char label[] = "csp-siphash";
+	hmac_state state = csp_hmac_key_state;
+	csp_hmac_process(&state, (const uint8_t *) label, sizeof(label) - 1);
+	csp_hmac_done(&state, hash);
+	csp_siphash_key[0] = csp_siphash_load64(&hash[0]);
+	csp_siphash_key[1] = csp_siphash_load64(&hash[8]);
+
+	csp_hmac_key_valid = true;
 
 	return CSP_ERR_NONE;
 
 }
 
+void csp_hmac_set_default_key(void) {
+
+	if (!csp_hmac_key_valid) {
+		/* No key set, use the all zero key */
+		static const uint8_t zero_key[HMAC_KEY_LENGTH];
+		csp_hmac_init(&csp_hmac_key_state, zero_key, sizeof(zero_key));
+		csp_siphash_key[0] = csp_siphash_key[1] = 0;
+		csp_hmac_key_valid = true;
+	}
+
+}
+
+/**
+ * Calculate the authentication tag of a packet
+ * @param packet CSP packet, the flags select HMAC-SHA1 or SipHash
+ * @param include_header use header in calculation
+ * @param length data length
+ * @param[out] tag #CSP_HMAC_LENGTH bytes
+ */
+static void csp_hmac_packet(const csp_packet_t * packet, bool include_header, uint32_t length, uint8_t * tag) {
+
+	const uint8_t * data = packet->data;
+
+	if (include_header) {
+		data = (const uint8_t *) &packet->id;
+		length += sizeof(packet->id);
+	}
+
+	if (packet->id.flags & CSP_FSIPHASH) {
+		const uint64_t mac = csp_siphash(csp_siphash_key, data, length);
+		for (unsigned int i = 0; i < CSP_HMAC_LENGTH; i++) {
+			tag[i] = (uint8_t)(mac >> (8 * i));
+		}
+		return;
+	}
+
+	uint8_t hmac[CSP_SHA1_DIGESTSIZE];
+	hmac_state state = csp_hmac_key_state;
+	csp_hmac_process(&state, data, length);
+	csp_hmac_done(&state, hmac);
+	memcpy(tag, hmac, CSP_HMAC_LENGTH);
+
+}
+
 int csp_hmac_append(csp_packet_t * packet, bool include_header) {
 
     if ((packet->length + (unsigned int)CSP_HMAC_LENGTH) > csp_buffer_data_size()) {
         return CSP_ERR_NOMEM;
     }
 
-	/* Calculate HMAC */
-	uint8_t hmac[CSP_SHA1_DIGESTSIZE];
-	if (include_header) {
-		csp_hmac_memory(csp_hmac_key, sizeof(csp_hmac_key), &packet->id, packet->length + sizeof(packet->id), hmac);
-	} else {
-		csp_hmac_memory(csp_hmac_key, sizeof(csp_hmac_key), packet->data, packet->length, hmac);
-	}
-
-	/* Truncate hash and copy to packet */
-	memcpy(&packet->data[packet->length], hmac, CSP_HMAC_LENGTH);
+	/* Calculate HMAC, truncated hash is copied to packet */
+	csp_hmac_packet(packet, include_header, packet->length, &packet->data[packet->length]);
 	packet->length += CSP_HMAC_LENGTH;
 
 	return CSP_ERR_NONE;
@@ -186,14 +282,10 @@ int csp_hmac_verify(csp_packet_t * packet, bool include_header) {
         return CSP_ERR_HMAC;
     }
 
-	uint8_t hmac[CSP_SHA1_DIGESTSIZE];
+	uint8_t hmac[CSP_HMAC_LENGTH];
 
 	/* Calculate HMAC */
-	if (include_header) {
-		csp_hmac_memory(csp_hmac_key, sizeof(csp_hmac_key), &packet->id, packet->length + sizeof(packet->id) - CSP_HMAC_LENGTH, hmac);
-	} else {
-		csp_hmac_memory(csp_hmac_key, sizeof(csp_hmac_key), packet->data, packet->length - CSP_HMAC_LENGTH, hmac);
-	}
+	csp_hmac_packet(packet, include_header, packet->length - CSP_HMAC_LENGTH, hmac);
 
     /* Compare calculated HMAC with packet header */
     if (memcmp(&packet->data[packet->length] - CSP_HMAC_LENGTH, hmac, CSP_HMAC_LENGTH) != 0) {
@@ -206,4 +298,3 @@ int csp_hmac_verify(csp_packet_t * packet, bool include_header) {
 	return CSP_ERR_NONE;
 
 }
-
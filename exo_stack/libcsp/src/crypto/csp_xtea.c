@@ -34,48 +34,75 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #define XTEA_ROUNDS 	32
 #define XTEA_KEY_LENGTH	16
 
-/* XTEA key */
-static uint32_t csp_xtea_key[XTEA_KEY_LENGTH/sizeof(uint32_t)] __attribute__ ((aligned(sizeof(uint32_t))));
+/** Blocks of keystream generated together, their rounds are interleaved so they pipeline */
+#ifndef XTEA_LANES
+#define XTEA_LANES	4
+#endif
 
-#define STORE32L(x, y) do { (y)[3] = (uint8_t)(((x) >> 24) & 0xff); \
-							(y)[2] = (uint8_t)(((x) >> 16) & 0xff); \
-							(y)[1] = (uint8_t)(((x) >> 8) & 0xff); \
-							(y)[0] = (uint8_t)(((x) >> 0) & 0xff); } while (0)
+/* XTEA round keys, sum + k[] for each half round, computed once by csp_xtea_set_key() */
+static uint32_t csp_xtea_round_key[2 * XTEA_ROUNDS];
+static bool csp_xtea_key_valid;
 
 #define LOAD32L(x, y) do { (x) = ((uint32_t)((y)[3] & 0xff) << 24) | \
 								 ((uint32_t)((y)[2] & 0xff) << 16) | \
 								 ((uint32_t)((y)[1] & 0xff) << 8)  | \
 								 ((uint32_t)((y)[0] & 0xff) << 0); } while (0)
 
-/* This function takes 64 bits of data in block and the 128 bits key in key */
-static inline void csp_xtea_encrypt_block(uint8_t *block, uint8_t const *key) {
+static void csp_xtea_schedule(const uint8_t * key) {
 
-	uint32_t i, v0, v1, delta = 0x9E3779B9, sum = 0, k[4];
+	uint32_t i, delta = 0x9E3779B9, sum = 0, k[4];
 
 	LOAD32L(k[0], &key[0]);
 	LOAD32L(k[1], &key[4]);
 	LOAD32L(k[2], &key[8]);
 	LOAD32L(k[3], &key[12]);
 
-	LOAD32L(v0, &block[0]);
-	LOAD32L(v1, &block[4]);
-
 	for (i = 0; i < XTEA_ROUNDS; i++) {
-		v0 += (((v1 << 4) ^ (v1 >> 5)) + v1) ^ (sum + k[sum & 3]);
+		csp_xtea_round_key[2 * i] = sum + k[sum & 3];
 		sum += delta;
-		v1 += (((v0 << 4) ^ (v0 >> 5)) + v0) ^ (sum + k[(sum >> 11) & 3]);
+		csp_xtea_round_key[(2 * i) + 1] = sum + k[(sum >> 11) & 3];
 	}
 
-	STORE32L(v0, &block[0]);
-	STORE32L(v1, &block[4]);
+	csp_xtea_key_valid = true;
+
+}
+
+/* Encrypt XTEA_LANES blocks, v0/v1 hold the block halves as little endian words */
+static inline void csp_xtea_encrypt_lanes(uint32_t v0[XTEA_LANES], uint32_t v1[XTEA_LANES]) {
+
+	const uint32_t * rk = csp_xtea_round_key;
+	unsigned int i, l;
+
+	for (i = 0; i < XTEA_ROUNDS; i++, rk += 2) {
+		for (l = 0; l < XTEA_LANES; l++) {
+			v0[l] += (((v1[l] << 4) ^ (v1[l] >> 5)) + v1[l]) ^ rk[0];
+		}
+		for (l = 0; l < XTEA_LANES; l++) {
+			v1[l] += (((v0[l] << 4) ^ (v0[l] >> 5)) + v0[l]) ^ rk[1];
+		}
+	}
 
 }
 
-static inline void csp_xtea_xor_byte(uint8_t * dst, uint8_t * src, uint32_t len) {
+/* XOR one block of keystream into data, whole blocks are done as two 32-bit words */
+static inline void csp_xtea_xor_block(uint8_t * data, uint32_t v0, uint32_t v1, uint32_t len) {
+
+	if (len == XTEA_BLOCKSIZE) {
+		uint32_t w[2];
+		memcpy(w, data, sizeof(w));
+#if (CSP_BIG_ENDIAN)
+		v0 = __builtin_bswap32(v0);
+		v1 = __builtin_bswap32(v1);
+#endif
+		w[0] ^= v0;
+		w[1] ^= v1;
+		memcpy(data, w, sizeof(w));
+		return;
+	}
 
-	unsigned int i;
-	for (i = 0; i < len; i++)
-		dst[i] ^= src[i];
+	for (unsigned int i = 0; i < len; i++) {
+		data[i] ^= (uint8_t)(((i < 4) ? v0 : v1) >> (8 * (i & 3)));
+	}
 
 }
 
@@ -85,40 +112,61 @@ int csp_xtea_set_key(const void * key, uint32_t keylen) {
 	uint8_t hash[CSP_SHA1_DIGESTSIZE];
 	csp_sha1_memory(key, keylen, hash);
 
-	/* Copy key */
-	memcpy(csp_xtea_key, hash, XTEA_KEY_LENGTH);
+	/* Expand key */
+	csp_xtea_schedule(hash);
 
 	return CSP_ERR_NONE;
 
 }
 
-int csp_xtea_encrypt(void * plain, const uint32_t len, uint32_t iv[2]) {
-
-	unsigned int i;
-	uint32_t stream[2];
+void csp_xtea_set_default_key(void) {
 
-	uint32_t blocks = (len + XTEA_BLOCKSIZE - 1)/ XTEA_BLOCKSIZE;
-	uint32_t remain;
+	if (!csp_xtea_key_valid) {
+		/* No key set, use the all zero key */
+		static const uint8_t zero_key[XTEA_KEY_LENGTH];
+		csp_xtea_schedule(zero_key);
+	}
 
-	/* Initialize stream */
-	stream[0] = csp_htobe32(iv[0]);
-	stream[1] = csp_htobe32(iv[1]);
+}
 
-	for (i = 0; i < blocks; i++) {
-		/* Create stream */
-		csp_xtea_encrypt_block((uint8_t *)stream, (uint8_t *)csp_xtea_key);
+int csp_xtea_encrypt(void * plain, const uint32_t len, uint32_t iv[2]) {
 
-		/* Calculate remaining bytes */
-		remain = len - i * XTEA_BLOCKSIZE;
+	uint8_t * data = plain;
+	uint32_t v0[XTEA_LANES], v1[XTEA_LANES];
+	uint32_t remain = len;
+	unsigned int l;
+
+	/* The counter blocks are stored big endian and loaded as little endian words.
+	 * The first two blocks both use iv[1], later blocks count up from there. */
+	const uint32_t nonce = __builtin_bswap32(iv[0]);
+	uint32_t counter = iv[1];
+	int first = 1;
+
+	while (remain > 0) {
+		/* Create stream for the next blocks */
+		for (l = 0; l < XTEA_LANES; l++) {
+			v0[l] = nonce;
+			v1[l] = __builtin_bswap32(counter);
+			if (first) {
+				first = 0;
+			} else {
+				counter++;
+			}
+		}
+		csp_xtea_encrypt_lanes(v0, v1);
 
 		/* XOR plain text with stream to generate cipher text */
-		csp_xtea_xor_byte(&((uint8_t*)plain)[len - remain], (uint8_t *)stream, remain < XTEA_BLOCKSIZE ? remain : XTEA_BLOCKSIZE);
-
-		/* Increment counter */
-		stream[0] = csp_htobe32(iv[0]);
-		stream[1] = csp_htobe32(iv[1]++);
+		for (l = 0; (l < XTEA_LANES) && (remain > 0); l++) {
+			const uint32_t n = (remain < XTEA_BLOCKSIZE) ? remain : XTEA_BLOCKSIZE;
+			csp_xtea_xor_block(data, v0[l], v1[l], n);
+			data += n;
+			remain -= n;
+		}
 	}
 
+	/* Advance the counter one per block, like the block at a time implementation did */
+	iv[1] += (len + XTEA_BLOCKSIZE - 1) / XTEA_BLOCKSIZE;
+
 	return CSP_ERR_NONE;
 
 }
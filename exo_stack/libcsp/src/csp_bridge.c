@@ -26,6 +26,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #include "csp_qfifo.h"
 #include "csp_io.h"
 #include "csp_promisc.h"
+#include "exo_osal.h"
 
 typedef struct {
 	csp_iface_t* iface;
@@ -34,14 +35,20 @@ typedef struct {
 static bridge_interface_t bif_a;
 static bridge_interface_t bif_b;
 
+/* One bridge task per router input queue, the router workers shard incoming packets over them */
+static unsigned int bridge_worker_index[CSP_ROUTE_WORKERS_MAX];
+
 static CSP_DEFINE_TASK(csp_bridge) {
 
+	/* The OSAL passes its thread handle, the queue index is the entry argument */
+	const unsigned int worker = *(const unsigned int *)((os_thread_handle_ptr)param)->app_entry_args;
+
 	/* Here there be bridging */
 	while (1) {
 
 		/* Get next packet to route */
 		csp_qfifo_t input;
-		if (csp_qfifo_read(&input) != CSP_ERR_NONE) {
+		if (csp_qfifo_read_worker(worker, &input) != CSP_ERR_NONE) {
 			continue;
 		}
 
@@ -83,13 +90,15 @@ int csp_bridge_start(unsigned int task_stack_size, unsigned int task_priority, c
 	bif_a.iface = if_a;
 	bif_b.iface = if_b;
 
-	static csp_thread_handle_t handle;
-	int ret = csp_thread_create(csp_bridge, "BRIDGE", task_stack_size, NULL, task_priority, &handle);
-
-    if (ret != 0) {
-        csp_log_error("Failed to start task");
-        return CSP_ERR_NOMEM;
-    }
+	static csp_thread_handle_t handle[CSP_ROUTE_WORKERS_MAX];
+	for (unsigned int worker = 0; worker < csp_qfifo_workers(); worker++) {
+		bridge_worker_index[worker] = worker;
+		int ret = csp_thread_create(csp_bridge, "BRIDGE", task_stack_size, &bridge_worker_index[worker], task_priority, &handle[worker]);
+		if (ret != 0) {
+			csp_log_error("Failed to start task");
+			return CSP_ERR_NOMEM;
+		}
+	}
 
 	return CSP_ERR_NONE;
 
@@ -205,7 +205,8 @@ void *csp_buffer_clone(void *buffer) {
 
 	csp_packet_t *clone = csp_buffer_get(packet->length);
 	if (clone) {
-		memcpy(clone, packet, csp_buffer_size());
+		/* Only the header and the used part of the data */
+		memcpy(clone, packet, CSP_BUFFER_PACKET_OVERHEAD + packet->length);
 	}
 
 	return clone;
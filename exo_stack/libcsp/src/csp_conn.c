@@ -45,13 +45,7 @@ static csp_bin_sem_handle_t sport_lock;
 
 void csp_conn_check_timeouts(void) {
 #if (CSP_USE_RDP)
-	for (int i = 0; i < csp_conf.conn_max; i++) {
-		if (arr_conn[i].state == CONN_OPEN) {
-			if (arr_conn[i].idin.flags & CSP_FRDP) {
-				csp_rdp_check_timeouts(&arr_conn[i]);
-			}
-		}
-	}
+	csp_rdp_check_timeouts();
 #endif
 }
 
@@ -372,10 +366,14 @@ csp_conn_t * csp_connect(uint8_t prio, uint8_t dest, uint8_t dport, uint32_t tim
 #endif
 	}
 
-	if (opts & CSP_O_HMAC) {
+	if (opts & (CSP_O_HMAC | CSP_O_SIPHASH)) {
 #if (CSP_USE_HMAC)
 		outgoing_id.flags |= CSP_FHMAC;
 		incoming_id.flags |= CSP_FHMAC;
+		if (opts & CSP_O_SIPHASH) {
+			outgoing_id.flags |= CSP_FSIPHASH;
+			incoming_id.flags |= CSP_FSIPHASH;
+		}
 #else
 		csp_log_error("Attempt to create HMAC authenticated connection, but CSP was compiled without HMAC support");
 		return NULL;
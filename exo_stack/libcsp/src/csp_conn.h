@@ -59,6 +59,26 @@ typedef enum {
 #define CSP_RDP_CLOSED_BY_TIMEOUT    0x04
 #define CSP_RDP_CLOSED_BY_ALL        (CSP_RDP_CLOSED_BY_USERSPACE | CSP_RDP_CLOSED_BY_PROTOCOL | CSP_RDP_CLOSED_BY_TIMEOUT)
 
+/** RDP timer types */
+typedef enum {
+	RDP_TIMER_TX = 0,		/**< Retransmission of an unacknowledged segment */
+	RDP_TIMER_ACK,			/**< Delayed acknowledgement */
+	RDP_TIMER_CONN,			/**< Connection and CLOSE-WAIT timeout */
+} csp_rdp_timer_type_t;
+
+/**
+ * RDP timer wheel entry
+ */
+typedef struct csp_rdp_timer_s {
+	struct csp_rdp_timer_s * next;	/**< Next timer in the same wheel slot */
+	struct csp_rdp_timer_s ** pprev;	/**< Link pointing to this timer, NULL when not armed */
+	csp_conn_t * conn;		/**< Connection owning the timer */
+	uint32_t expires;		/**< Expiry time in mS */
+	uint16_t seq_nr;		/**< Sequence number of the segment (RDP_TIMER_TX only) */
+	uint8_t type;			/**< Timer type, see csp_rdp_timer_type_t */
+	uint8_t retries;		/**< Number of retransmissions of the segment (RDP_TIMER_TX only) */
+} csp_rdp_timer_t;
+
 /**
  * RDP Connection
  */
@@ -78,8 +98,22 @@ typedef struct {
 	uint32_t ack_timeout;
 	uint32_t ack_delay_count;
 	uint32_t ack_timestamp;
+	uint32_t srtt;			/**< Smoothed round-trip time in mS, scaled by 8 */
+	uint32_t rttvar;		/**< Round-trip time variation in mS, scaled by 4 */
+	uint32_t rto;			/**< Current retransmission timeout in mS */
+	uint32_t options;		/**< Negotiated CSP_RDP_OPT_* extensions */
+	uint32_t window_max;		/**< Largest window the peers agreed on, equals window_size unless auto-tuned */
+	uint32_t tx_window;		/**< Current TX window, sized from the bandwidth-delay product with CSP_RDP_OPT_AUTO_WINDOW */
+	uint32_t rtt_min;		/**< Lowest measured round-trip time in mS */
+	uint32_t dlv_count;		/**< Segments delivered since dlv_timestamp */
+	uint32_t dlv_timestamp;		/**< Start of the current delivery rate sample */
+	uint32_t dlv_rate;		/**< Delivery rate in segments per mS, scaled by 256 */
 	csp_bin_sem_handle_t tx_wait;
-	csp_queue_handle_t tx_queue;
+	csp_bin_sem_handle_t lock;	/**< Serialises packet processing and timer expiry of the connection */
+	csp_packet_t ** tx_ring;	/**< Unacknowledged segments, indexed by sequence number */
+	csp_rdp_timer_t * tx_timer;	/**< Retransmission timers, one per tx_ring slot */
+	csp_rdp_timer_t ack_timer;	/**< Delayed ACK timer */
+	csp_rdp_timer_t conn_timer;	/**< Connection and CLOSE-WAIT timer */
 	csp_queue_handle_t rx_queue;
 } csp_rdp_t;
 
@@ -24,6 +24,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 
 #include "csp_time.h"
 #include "csp_crc32.h"
+#include "csp_qfifo.h"
 
 /* Check the last CSP_DEDUP_COUNT packets for duplicates */
 #define CSP_DEDUP_COUNT		16
@@ -31,13 +32,16 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 /* Only consider packet a duplicate if received under CSP_DEDUP_WINDOW_MS ago */
 #define CSP_DEDUP_WINDOW_MS	1000
 
-/* Store packet CRC's in a ringbuffer */
-static uint32_t csp_dedup_array[CSP_DEDUP_COUNT] = {};
-static uint32_t csp_dedup_timestamp[CSP_DEDUP_COUNT] = {};
-static int csp_dedup_in = 0;
+/* Store packet CRC's in a ringbuffer, one per router worker. Duplicates share the
+ * connection tuple and therefore the worker, so each ring has a single writer */
+static uint32_t csp_dedup_array[CSP_ROUTE_WORKERS_MAX][CSP_DEDUP_COUNT] = {};
+static uint32_t csp_dedup_timestamp[CSP_ROUTE_WORKERS_MAX][CSP_DEDUP_COUNT] = {};
+static int csp_dedup_in[CSP_ROUTE_WORKERS_MAX] = {};
 
 bool csp_dedup_is_duplicate(csp_packet_t *packet)
 {
+	const unsigned int shard = csp_qfifo_shard(packet);
+
 	/* Calculate CRC32 for packet */
 	uint32_t crc = csp_crc32_memory((const uint8_t *) &packet->id, packet->length + sizeof(packet->id));
 
@@ -45,18 +49,18 @@ bool csp_dedup_is_duplicate(csp_packet_t *packet)
 	for (int i = 0; i < CSP_DEDUP_COUNT; i++) {
 
 		/* Check for match */
-		if (crc == csp_dedup_array[i]) {
+		if (crc == csp_dedup_array[shard][i]) {
 
 			/* Check the timestamp */
-			if (csp_get_ms() < csp_dedup_timestamp[i] + CSP_DEDUP_WINDOW_MS)
+			if (csp_get_ms() < csp_dedup_timestamp[shard][i] + CSP_DEDUP_WINDOW_MS)
 				return true;
 		}
 	}
 
 	/* If not, insert packet into duplicate list */
-	csp_dedup_array[csp_dedup_in] = crc;
-	csp_dedup_timestamp[csp_dedup_in] = csp_get_ms();
-	csp_dedup_in = (csp_dedup_in + 1) % CSP_DEDUP_COUNT;
+	csp_dedup_array[shard][csp_dedup_in[shard]] = crc;
+	csp_dedup_timestamp[shard][csp_dedup_in[shard]] = csp_get_ms();
+	csp_dedup_in[shard] = (csp_dedup_in[shard] + 1) % CSP_DEDUP_COUNT;
 
 	return false;
 }
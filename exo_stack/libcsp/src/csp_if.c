@@ -55,11 +55,11 @@ int csp_intf_init(io_intf_type intf_type, void* intf_instance_ptr, csp_iface_t**
 
                 break;
             }
-#ifdef CSP_FREERTOS
+#if defined(CSP_FREERTOS) || defined(LINUX_TEMP_PORT)
             case CAN:
             {
                 *iface =csp_can_init("can_intf",intf_instance_ptr);
-                if(iface!=NULL)
+                if(*iface!=NULL)
                 {
                     ret=0;
                 }
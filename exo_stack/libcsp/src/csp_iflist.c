@@ -25,6 +25,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 
 #include "csp_debug.h"
 #include "csp.h"
+#include "csp_rtable_internal.h"
 
 /* Interfaces are stored in a linked list */
 static csp_iface_t * interfaces = NULL;
@@ -64,6 +65,31 @@ int csp_iflist_add(csp_iface_t *ifc) {
 	return CSP_ERR_NONE;
 }
 
+/* Clear a route through the interface being removed */
+static bool csp_iflist_unroute(void * ctx, uint8_t address, uint8_t mask, const csp_route_t * route) {
+
+	if (route->iface == ctx) {
+		csp_rtable_set_internal(address, mask, NULL, CSP_NO_VIA_ADDRESS);
+	}
+	return true;
+}
+
+int csp_iflist_remove(csp_iface_t *ifc) {
+
+	/* Routes first, so no more packets are sent to the interface */
+	csp_rtable_iterate(csp_iflist_unroute, ifc);
+
+	for (csp_iface_t ** link = &interfaces; *link != NULL; link = &(*link)->next) {
+		if (*link == ifc) {
+			*link = ifc->next;
+			ifc->next = NULL;
+			return CSP_ERR_NONE;
+		}
+	}
+
+	return CSP_ERR_INVAL;
+}
+
 csp_iface_t * csp_iflist_get(void)
 {
     return interfaces;
@@ -25,8 +25,15 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #include "csp_conn.h"
 #include "csp_qfifo.h"
 #include "csp_port.h"
+#if (CSP_USE_HMAC)
+#include "csp_hmac.h"
+#endif
+#if (CSP_USE_XTEA)
+#include "csp_xtea.h"
+#endif
 
 csp_conf_t csp_conf;
+csp_tm_t csp_tm_global;
 
 uint8_t csp_get_address(void) {
 
@@ -86,7 +93,12 @@ int csp_init(const csp_conf_t * conf) {
 	csp_route_set(CSP_DEFAULT_ROUTE, &csp_if_lo, CSP_NO_VIA_ADDRESS);
 #endif
 
-
+#if (CSP_USE_HMAC)
+	csp_hmac_set_default_key();
+#endif
+#if (CSP_USE_XTEA)
+	csp_xtea_set_default_key();
+#endif
 
 	return CSP_ERR_NONE;
 
@@ -40,6 +40,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #include "csp_port.h"
 #include "csp_conn.h"
 #include "csp_promisc.h"
+#include "csp_stats.h"
 #include "csp_qfifo.h"
 #include "transport/csp_transport.h"
 
@@ -65,7 +66,7 @@ csp_socket_t * csp_socket(uint32_t opts) {
 #endif
 
 #if (CSP_USE_HMAC == 0)
-	if (opts & CSP_SO_HMACREQ) {
+	if (opts & (CSP_SO_HMACREQ | CSP_SO_SIPHASHREQ)) {
 		csp_log_error("Attempt to create socket that requires HMAC, but CSP was compiled without HMAC support");
 		return NULL;
 	}
@@ -79,7 +80,7 @@ csp_socket_t * csp_socket(uint32_t opts) {
 #endif
 
 	/* Drop packet if reserved flags are set */
-	if (opts & ~(CSP_SO_RDPREQ | CSP_SO_XTEAREQ | CSP_SO_HMACREQ | CSP_SO_CRC32REQ | CSP_SO_CONN_LESS)) {
+	if (opts & ~(CSP_SO_RDPREQ | CSP_SO_XTEAREQ | CSP_SO_HMACREQ | CSP_SO_SIPHASHREQ | CSP_SO_CRC32REQ | CSP_SO_CONN_LESS)) {
 		csp_log_error("Invalid socket option");
 		return NULL;
 	}
@@ -247,11 +248,16 @@ int csp_send_direct(csp_id_t idout, csp_packet_t * packet, const csp_route_t * i
 	if (mtu > 0 && bytes > mtu)
 		goto tx_err;
 
+	const uint32_t tx_start = csp_stats_now();
 	if ((*ifout->nexthop)(ifroute, packet) != CSP_ERR_NONE)
 		goto tx_err;
+	csp_stats_latency(ifout, CSP_STATS_TX, tx_start);
 
 	ifout->tx++;
 	ifout->txbytes += bytes;
+	if (idout.src == csp_conf.address) {
+		csp_stats_port_tx(idout.sport, bytes);
+	}
 	return CSP_ERR_NONE;
 
 tx_err:
@@ -371,9 +377,12 @@ int csp_sendto(uint8_t prio, uint8_t dest, uint8_t dport, uint8_t src_port, uint
 		return CSP_ERR_INVAL;
 	}
 
-	if (opts & CSP_O_HMAC) {
+	if (opts & (CSP_O_HMAC | CSP_O_SIPHASH)) {
 #if (CSP_USE_HMAC)
 		packet->id.flags |= CSP_FHMAC;
+		if (opts & CSP_O_SIPHASH) {
+			packet->id.flags |= CSP_FSIPHASH;
+		}
 #else
 		csp_log_error("Attempt to create HMAC authenticated packet, but CSP was compiled without HMAC support");
 		return CSP_ERR_NOTSUP;
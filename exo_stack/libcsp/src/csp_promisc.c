@@ -20,8 +20,15 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 
 #include "csp_promisc.h"
 
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
 #include "csp.h"
 #include "csp_queue.h"
+#include "csp_malloc.h"
+#include "csp_thread.h"
+#include "csp_time.h"
 
 #if (CSP_USE_PROMISC)
 
@@ -66,8 +73,234 @@ csp_packet_t * csp_promisc_read(uint32_t timeout) {
 
 }
 
+/**
+ * Packet tap.
+ * The ring is a bounded multi-producer queue: every slot carries a sequence
+ * number telling whether it is free for the producer at that position or
+ * filled for the reader, so router threads never block each other.
+ */
+typedef struct {
+	uint32_t seq;
+	csp_promisc_tap_record_t record;
+} csp_promisc_tap_slot_t;
+
+static csp_promisc_tap_slot_t * tap_ring = NULL;
+static csp_queue_handle_t tap_wake = NULL;
+static uint32_t tap_waiters;
+static uint32_t tap_mask;
+static uint32_t tap_head;
+static uint32_t tap_tail;
+static int tap_enabled = 0;
+static uint32_t tap_sample_count;
+static uint32_t tap_captured;
+static uint32_t tap_dropped;
+
+/**
+ * Tap filter, rewritten by csp_promisc_tap_enable() while router threads read it.
+ * tap_conf_seq is odd during an update, a reader retries when it was odd or has
+ * moved meanwhile. tap_conf_busy serialises concurrent updates.
+ */
+static uint32_t tap_conf_seq;
+static uint32_t tap_conf_busy;
+static uint32_t tap_port_mask[(CSP_ID_PORT_MAX / 32) + 1];
+static uint32_t tap_all_ports;
+static uint32_t tap_sample_rate;
+static uint32_t tap_snap_len;
+
+/* Largest ring, the size is rounded up to a power of two in 32 bits */
+#define TAP_RING_MAX	((UINT32_MAX / 2) + 1)
+
+int csp_promisc_tap_enable(const csp_promisc_tap_conf_t * conf) {
+
+	if ((conf == NULL) || (conf->ring_size == 0) || (conf->ring_size > TAP_RING_MAX) ||
+	    (conf->snap_len > CSP_PROMISC_TAP_SNAP_MAX)) {
+		csp_tm_global.csp_err_inval++;
+		return CSP_ERR_INVAL;
+	}
+
+	while (__atomic_exchange_n(&tap_conf_busy, 1, __ATOMIC_ACQUIRE) != 0)
+		csp_sleep_ms(1);
+
+	/* Create ring */
+	if (tap_ring == NULL) {
+		uint32_t size = 1;
+		while (size < conf->ring_size)
+			size <<= 1;
+
+		csp_promisc_tap_slot_t * ring = csp_calloc(size, sizeof(*ring));
+		if (ring == NULL) {
+			__atomic_store_n(&tap_conf_busy, 0, __ATOMIC_RELEASE);
+			csp_tm_global.csp_err_nomem++;
+			return CSP_ERR_NOMEM;
+		}
+		/* One pending wake up is enough, a woken reader drains the ring */
+		tap_wake = csp_queue_create(1, sizeof(uint8_t));
+		if (tap_wake == NULL) {
+			csp_free(ring);
+			__atomic_store_n(&tap_conf_busy, 0, __ATOMIC_RELEASE);
+			csp_tm_global.csp_err_nomem++;
+			return CSP_ERR_NOMEM;
+		}
+		for (uint32_t i = 0; i < size; i++)
+			ring[i].seq = i;
+
+		tap_mask = size - 1;
+		__atomic_store_n(&tap_ring, ring, __ATOMIC_RELEASE);
+	}
+
+	uint32_t all_ports = 1;
+	for (unsigned int i = 0; i < (sizeof(tap_port_mask) / sizeof(tap_port_mask[0])); i++) {
+		if (conf->port_mask[i])
+			all_ports = 0;
+	}
+
+	/* Publish the filter */
+	const uint32_t seq = tap_conf_seq;
+	__atomic_store_n(&tap_conf_seq, seq + 1, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+	for (unsigned int i = 0; i < (sizeof(tap_port_mask) / sizeof(tap_port_mask[0])); i++)
+		__atomic_store_n(&tap_port_mask[i], conf->port_mask[i], __ATOMIC_RELAXED);
+	__atomic_store_n(&tap_all_ports, all_ports, __ATOMIC_RELAXED);
+	__atomic_store_n(&tap_sample_rate, conf->sample_rate, __ATOMIC_RELAXED);
+	__atomic_store_n(&tap_snap_len, conf->snap_len, __ATOMIC_RELAXED);
+	__atomic_store_n(&tap_conf_seq, seq + 2, __ATOMIC_RELEASE);
+
+	__atomic_store_n(&tap_conf_busy, 0, __ATOMIC_RELEASE);
+
+	__atomic_store_n(&tap_enabled, 1, __ATOMIC_RELEASE);
+	return CSP_ERR_NONE;
+
+}
+
+void csp_promisc_tap_disable(void) {
+	__atomic_store_n(&tap_enabled, 0, __ATOMIC_RELEASE);
+}
+
+static inline uint32_t csp_promisc_tap_port(uint8_t port) {
+	return (__atomic_load_n(&tap_port_mask[port / 32], __ATOMIC_RELAXED) >> (port % 32)) & 1;
+}
+
+/* Consistent snapshot of the filter, returns whether the packet matches the port filter */
+static uint32_t csp_promisc_tap_filter(const csp_packet_t * packet, uint32_t * sample_rate, uint32_t * snap_len) {
+
+	uint32_t seq;
+	uint32_t match;
+	do {
+		seq = __atomic_load_n(&tap_conf_seq, __ATOMIC_ACQUIRE);
+		match = __atomic_load_n(&tap_all_ports, __ATOMIC_RELAXED) ||
+			csp_promisc_tap_port(packet->id.dport) || csp_promisc_tap_port(packet->id.sport);
+		*sample_rate = __atomic_load_n(&tap_sample_rate, __ATOMIC_RELAXED);
+		*snap_len = __atomic_load_n(&tap_snap_len, __ATOMIC_RELAXED);
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+	} while ((seq & 1) || (seq != __atomic_load_n(&tap_conf_seq, __ATOMIC_RELAXED)));
+
+	return match;
+
+}
+
+static void csp_promisc_tap(const csp_packet_t * packet) {
+
+	if (__atomic_load_n(&tap_enabled, __ATOMIC_ACQUIRE) == 0)
+		return;
+
+	/* Port filter */
+	uint32_t sample_rate;
+	uint32_t snap_len;
+	if (!csp_promisc_tap_filter(packet, &sample_rate, &snap_len))
+		return;
+
+	/* 1 in N sampling */
+	if ((sample_rate > 1) && ((__atomic_fetch_add(&tap_sample_count, 1, __ATOMIC_RELAXED) % sample_rate) != 0))
+		return;
+
+	/* Claim a slot, the ring drops instead of waiting for the reader */
+	csp_promisc_tap_slot_t * slot;
+	uint32_t pos = __atomic_load_n(&tap_head, __ATOMIC_RELAXED);
+	for (;;) {
+		slot = &tap_ring[pos & tap_mask];
+		int32_t diff = (int32_t) (__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) - pos);
+		if (diff == 0) {
+			if (__atomic_compare_exchange_n(&tap_head, &pos, pos + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+				break;
+		} else if (diff < 0) {
+			__atomic_fetch_add(&tap_dropped, 1, __ATOMIC_RELAXED);
+			return;
+		} else {
+			pos = __atomic_load_n(&tap_head, __ATOMIC_RELAXED);
+		}
+	}
+
+	csp_promisc_tap_record_t * record = &slot->record;
+	record->id = packet->id;
+	record->timestamp = csp_get_ms();
+	record->length = packet->length;
+	record->snap_len = (packet->length < snap_len) ? packet->length : snap_len;
+	memcpy(record->data, packet->data, record->snap_len);
+
+	/* Publish to the reader, ordered before the waiter check below */
+	__atomic_store_n(&slot->seq, pos + 1, __ATOMIC_SEQ_CST);
+	__atomic_fetch_add(&tap_captured, 1, __ATOMIC_RELAXED);
+
+	/* Wake a reader blocked in csp_promisc_tap_read(), a full wake up queue already does */
+	if (__atomic_load_n(&tap_waiters, __ATOMIC_SEQ_CST) != 0) {
+		const uint8_t wake = 1;
+		csp_queue_enqueue(tap_wake, &wake, 0);
+	}
+
+}
+
+int csp_promisc_tap_read(csp_promisc_tap_record_t * record, uint32_t timeout) {
+
+	csp_promisc_tap_slot_t * ring = __atomic_load_n(&tap_ring, __ATOMIC_ACQUIRE);
+	if ((ring == NULL) || (record == NULL))
+		return CSP_ERR_INVAL;
+
+	const uint32_t start = csp_get_ms();
+	for (;;) {
+		uint32_t pos = __atomic_load_n(&tap_tail, __ATOMIC_RELAXED);
+		csp_promisc_tap_slot_t * slot = &ring[pos & tap_mask];
+		int32_t diff = (int32_t) (__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) - (pos + 1));
+		if (diff == 0) {
+			if (__atomic_compare_exchange_n(&tap_tail, &pos, pos + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+				memcpy(record, &slot->record, offsetof(csp_promisc_tap_record_t, data) + slot->record.snap_len);
+				/* Hand the slot back to the producers of the next lap */
+				__atomic_store_n(&slot->seq, pos + tap_mask + 1, __ATOMIC_RELEASE);
+				return CSP_ERR_NONE;
+			}
+		} else if (diff < 0) {
+			/* Empty, block until a producer publishes or the timeout expires */
+			uint32_t wait = CSP_MAX_TIMEOUT;
+			if (timeout != CSP_MAX_TIMEOUT) {
+				const uint32_t elapsed = csp_get_ms() - start;
+				if (elapsed >= timeout)
+					return CSP_ERR_TIMEDOUT;
+				wait = timeout - elapsed;
+			}
+			/* Check the slot again once registered, a record published before would not wake us */
+			__atomic_fetch_add(&tap_waiters, 1, __ATOMIC_SEQ_CST);
+			if ((int32_t) (__atomic_load_n(&slot->seq, __ATOMIC_SEQ_CST) - (pos + 1)) < 0) {
+				uint8_t wake;
+				csp_queue_dequeue(tap_wake, &wake, wait);
+			}
+			__atomic_fetch_sub(&tap_waiters, 1, __ATOMIC_RELAXED);
+		}
+	}
+
+}
+
+void csp_promisc_tap_stats(uint32_t * captured, uint32_t * dropped) {
+
+	if (captured)
+		*captured = __atomic_load_n(&tap_captured, __ATOMIC_RELAXED);
+	if (dropped)
+		*dropped = __atomic_load_n(&tap_dropped, __ATOMIC_RELAXED);
+
+}
+
 void csp_promisc_add(csp_packet_t * packet) {
 
+	csp_promisc_tap(packet);
+
 	if (csp_promisc_enabled == 0)
 		return;
 
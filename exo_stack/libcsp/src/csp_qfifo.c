@@ -23,32 +23,45 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #include "csp_queue.h"
 
 #include "csp_init.h"
+#include "csp_stats.h"
 
-static csp_queue_handle_t qfifo[CSP_ROUTE_FIFOS];
+/* One set of router fifos per worker, packets of a connection always go to the same worker */
+static csp_queue_handle_t qfifo[CSP_ROUTE_WORKERS_MAX][CSP_ROUTE_FIFOS];
 #if (CSP_USE_QOS)
-static csp_queue_handle_t qfifo_events;
+static csp_queue_handle_t qfifo_events[CSP_ROUTE_WORKERS_MAX];
 #endif
+static unsigned int qfifo_workers = 1;
 
 int csp_qfifo_init(void) {
 
-    /* Create router fifos for each priority */
-    for (int prio = 0; prio < CSP_ROUTE_FIFOS; prio++) {
-        if (qfifo[prio] == NULL) {
-            qfifo[prio] = csp_queue_create(csp_conf.fifo_length, sizeof(csp_qfifo_t));
-            if (!qfifo[prio])
-             {
-                return CSP_ERR_NOMEM;
-             }
-        }
+    qfifo_workers = csp_conf.route_workers;
+    if (qfifo_workers < 1) {
+        qfifo_workers = 1;
+    } else if (qfifo_workers > CSP_ROUTE_WORKERS_MAX) {
+        qfifo_workers = CSP_ROUTE_WORKERS_MAX;
     }
 
+    for (unsigned int worker = 0; worker < qfifo_workers; worker++) {
+
+        /* Create router fifos for each priority */
+        for (int prio = 0; prio < CSP_ROUTE_FIFOS; prio++) {
+            if (qfifo[worker][prio] == NULL) {
+                qfifo[worker][prio] = csp_queue_create(csp_conf.fifo_length, sizeof(csp_qfifo_t));
+                if (!qfifo[worker][prio])
+                 {
+                    return CSP_ERR_NOMEM;
+                 }
+            }
+        }
+
 #if (CSP_USE_QOS)
-    /* Create QoS fifo notification queue */
-    qfifo_events = csp_queue_create(csp_conf.fifo_length, sizeof(int));
-    if (!qfifo_events) {
-        return CSP_ERR_NOMEM;
-    }
+        /* Create QoS fifo notification queue */
+        qfifo_events[worker] = csp_queue_create(csp_conf.fifo_length, sizeof(int));
+        if (!qfifo_events[worker]) {
+            return CSP_ERR_NOMEM;
+        }
 #endif
+    }
 
 	return CSP_ERR_NONE;
 
@@ -56,29 +69,56 @@ int csp_qfifo_init(void) {
 
 void csp_qfifo_free_resources(void) {
 
-	for (int prio = 0; prio < CSP_ROUTE_FIFOS; prio++) {
-		if (qfifo[prio]) {
-			csp_queue_remove(qfifo[prio]);
-			qfifo[prio] = NULL;
+	for (unsigned int worker = 0; worker < CSP_ROUTE_WORKERS_MAX; worker++) {
+		for (int prio = 0; prio < CSP_ROUTE_FIFOS; prio++) {
+			if (qfifo[worker][prio]) {
+				csp_queue_remove(qfifo[worker][prio]);
+				qfifo[worker][prio] = NULL;
+			}
 		}
-	}
 
 #if (CSP_USE_QOS)
-	if (qfifo_events) {
-		csp_queue_remove(qfifo_events);
-		qfifo_events = NULL;
-	}
+		if (qfifo_events[worker]) {
+			csp_queue_remove(qfifo_events[worker]);
+			qfifo_events[worker] = NULL;
+		}
 #endif
+	}
+	qfifo_workers = 1;
+
+}
+
+unsigned int csp_qfifo_workers(void) {
+
+	return qfifo_workers;
+
+}
+
+unsigned int csp_qfifo_shard(const csp_packet_t * packet) {
+
+	if (qfifo_workers < 2) {
+		return 0;
+	}
+
+	/* Multiplicative hash of the connection tuple (addresses and ports) */
+	const uint32_t hash = (packet->id.ext & CSP_ID_CONN_MASK) * 2654435761U;
+	return (hash >> 16) % qfifo_workers;
 
 }
 
 int csp_qfifo_read(csp_qfifo_t * input) {
 
+	return csp_qfifo_read_worker(0, input);
+
+}
+
+int csp_qfifo_read_worker(unsigned int worker, csp_qfifo_t * input) {
+
 #if (CSP_USE_QOS)
 	int prio, found, event;
 
     /* Wait for packet in any queue */
-    if (csp_queue_dequeue(qfifo_events, &event, FIFO_TIMEOUT) != CSP_QUEUE_OK)
+    if (csp_queue_dequeue(qfifo_events[worker], &event, FIFO_TIMEOUT) != CSP_QUEUE_OK)
     {
         return CSP_ERR_TIMEDOUT;
     }
@@ -86,7 +126,7 @@ int csp_qfifo_read(csp_qfifo_t * input) {
 	/* Find packet with highest priority */
 	found = 0;
 	for (prio = 0; prio < CSP_ROUTE_FIFOS; prio++) {
-		if (csp_queue_dequeue(qfifo[prio], input, 0) == CSP_QUEUE_OK) {
+		if (csp_queue_dequeue(qfifo[worker][prio], input, 0) == CSP_QUEUE_OK) {
 			found = 1;
 			break;
 		}
@@ -97,7 +137,7 @@ int csp_qfifo_read(csp_qfifo_t * input) {
         return CSP_ERR_TIMEDOUT;
     }
 #else
-    if (csp_queue_dequeue(qfifo[0], input, FIFO_TIMEOUT) != CSP_QUEUE_OK)
+    if (csp_queue_dequeue(qfifo[worker][0], input, FIFO_TIMEOUT) != CSP_QUEUE_OK)
     {
         return CSP_ERR_TIMEDOUT;
     }
@@ -129,6 +169,9 @@ void csp_qfifo_write(csp_packet_t * packet, csp_iface_t * iface, CSP_BASE_TYPE *
 		return;
 	}
 
+	/* Start of the router latency measurement */
+	csp_stats_stamp(packet, (pxTaskWoken != NULL));
+
 	csp_qfifo_t queue_element;
 	queue_element.iface = iface;
 	queue_element.packet = packet;
@@ -138,20 +181,21 @@ void csp_qfifo_write(csp_packet_t * packet, csp_iface_t * iface, CSP_BASE_TYPE *
 #else
 	int fifo = 0;
 #endif
+	const unsigned int worker = csp_qfifo_shard(packet);
 
 	if (pxTaskWoken == NULL)
-		result = csp_queue_enqueue(qfifo[fifo], &queue_element, 0);
+		result = csp_queue_enqueue(qfifo[worker][fifo], &queue_element, 0);
 	else
-		result = csp_queue_enqueue_isr(qfifo[fifo], &queue_element, pxTaskWoken);
+		result = csp_queue_enqueue_isr(qfifo[worker][fifo], &queue_element, pxTaskWoken);
 
 #if (CSP_USE_QOS)
 	static int event = 0;
 
 	if (result == CSP_QUEUE_OK) {
 		if (pxTaskWoken == NULL)
-			csp_queue_enqueue(qfifo_events, &event, 0);
+			csp_queue_enqueue(qfifo_events[worker], &event, 0);
 		else
-			csp_queue_enqueue_isr(qfifo_events, &event, pxTaskWoken);
+			csp_queue_enqueue_isr(qfifo_events[worker], &event, pxTaskWoken);
 	}
 #endif
 
@@ -170,5 +214,7 @@ void csp_qfifo_write(csp_packet_t * packet, csp_iface_t * iface, CSP_BASE_TYPE *
 
 void csp_qfifo_wake_up(void) {
 	const csp_qfifo_t queue_element = {.iface = NULL, .packet = NULL};
-	csp_queue_enqueue(qfifo[0], &queue_element, 0);
+	for (unsigned int worker = 0; worker < qfifo_workers; worker++) {
+		csp_queue_enqueue(qfifo[worker][0], &queue_element, 0);
+	}
 }
@@ -29,6 +29,10 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #define FIFO_TIMEOUT CSP_MAX_TIMEOUT		//! If no RDP, the router can sleep untill data arrives
 #endif
 
+#ifndef CSP_ROUTE_WORKERS_MAX
+#define CSP_ROUTE_WORKERS_MAX 4			//! Upper limit for csp_conf_t.route_workers
+#endif
+
 /**
  * Init FIFO/QOS queues
  * @return CSP_ERR type
@@ -49,6 +53,28 @@ typedef struct {
  */
 int csp_qfifo_read(csp_qfifo_t * input);
 
+/**
+ * Read next packet from the input queue of a router worker
+ * @param worker worker index, below csp_qfifo_workers()
+ * @param input pointer to router queue item element
+ * @return CSP_ERR type
+ */
+int csp_qfifo_read_worker(unsigned int worker, csp_qfifo_t * input);
+
+/**
+ * Number of router workers the input queues were created for
+ * @return worker count, at least 1
+ */
+unsigned int csp_qfifo_workers(void);
+
+/**
+ * Worker handling a packet, derived from the connection tuple so that all
+ * packets of a connection are routed by the same worker and stay in order
+ * @param packet incoming packet
+ * @return worker index, 0 with a single worker
+ */
+unsigned int csp_qfifo_shard(const csp_packet_t * packet);
+
 /**
  * Wake up any task (e.g. router) waiting on messages.
  * For testing.
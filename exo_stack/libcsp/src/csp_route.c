@@ -36,7 +36,15 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #include "csp_promisc.h"
 #include "csp_qfifo.h"
 #include "csp_dedup.h"
+#include "csp_stats.h"
 #include "transport/csp_transport.h"
+#include "exo_osal.h"
+
+/** Worker indexes, passed to the router worker tasks */
+static unsigned int csp_route_worker_index[CSP_ROUTE_WORKERS_MAX];
+
+/** Router task handles, a handle makes the OSAL port assign each task its own task id */
+static csp_thread_handle_t csp_route_handle[CSP_ROUTE_WORKERS_MAX + 1];
 
 /**
  * Check supported packet options
@@ -132,11 +140,16 @@ static int csp_route_security_check(uint32_t security_opts, csp_iface_t * iface,
 			iface->autherr++;
 			return CSP_ERR_HMAC;
 		}
-	} else if (security_opts & CSP_SO_HMACREQ) {
+	} else if (security_opts & (CSP_SO_HMACREQ | CSP_SO_SIPHASHREQ)) {
 		csp_log_warn("Received packet without HMAC. Discarding packet");
 		iface->autherr++;
 		return CSP_ERR_HMAC;
 	}
+	if ((security_opts & CSP_SO_SIPHASHREQ) && !(packet->id.flags & CSP_FSIPHASH)) {
+		csp_log_warn("Received packet without SipHash. Discarding packet");
+		iface->autherr++;
+		return CSP_ERR_HMAC;
+	}
 #endif
 
 #if (CSP_USE_RDP)
@@ -154,20 +167,20 @@ static int csp_route_security_check(uint32_t security_opts, csp_iface_t * iface,
 
 }
 
-int csp_route_work(uint32_t timeout) {
+/**
+ * Route the next packet of a worker's input queue
+ * @param worker worker index
+ * @return #CSP_ERR_NONE on success, #CSP_ERR_TIMEDOUT if no packet arrived
+ */
+static int csp_route_next(unsigned int worker) {
 
 	csp_qfifo_t input;
 	csp_packet_t * packet;
 	csp_conn_t * conn;
 	csp_socket_t * socket;
 
-#if (CSP_USE_RDP)
-	/* Check connection timeouts (currently only for RDP) */
-	csp_conn_check_timeouts();
-#endif
-
 	/* Get next packet to route */
-	if (csp_qfifo_read(&input) != CSP_ERR_NONE) {
+	if (csp_qfifo_read_worker(worker, &input) != CSP_ERR_NONE) {
 		return CSP_ERR_TIMEDOUT;
 	}
 
@@ -176,6 +189,9 @@ int csp_route_work(uint32_t timeout) {
 		return CSP_ERR_TIMEDOUT;
 	}
 
+	const uint32_t route_start = csp_stats_now();
+	csp_stats_latency(input.iface, CSP_STATS_QFIFO, csp_stats_rx_time(packet));
+
 	csp_log_packet("INP: S %u, D %u, Dp %u, Sp %u, Pr %u, Fl 0x%02X, Sz %"PRIu16" VIA: %s",
 			packet->id.src, packet->id.dst, packet->id.dport,
 			packet->id.sport, packet->id.pri, packet->id.flags, packet->length, input.iface->name);
@@ -213,6 +229,7 @@ int csp_route_work(uint32_t timeout) {
 		}
 
 		/* Otherwise, actually send the message */
+		csp_stats_latency(input.iface, CSP_STATS_ROUTE, route_start);
 		if (csp_send_direct(packet->id, packet, ifroute, 0) != CSP_ERR_NONE) {
 			csp_log_warn("Router failed to send");
 			csp_buffer_free(packet);
@@ -230,6 +247,7 @@ int csp_route_work(uint32_t timeout) {
 
 	/* The message is to me, search for incoming socket */
 	socket = csp_port_get_socket(packet->id.dport);
+	csp_stats_port_rx(packet);
 
 	/* If the socket is connection-less, deliver now */
 	if (socket && (socket->opts & CSP_SO_CONN_LESS)) {
@@ -239,9 +257,11 @@ int csp_route_work(uint32_t timeout) {
 		}
 		if (csp_queue_enqueue(socket->socket, &packet, 0) != CSP_QUEUE_OK) {
 			csp_log_error("Conn-less socket queue full");
+			csp_stats_port_drop(packet);
 			csp_buffer_free(packet);
 			return CSP_ERR_NONE;
 		}
+		csp_stats_latency(input.iface, CSP_STATS_ROUTE, route_start);
 		return CSP_ERR_NONE;
 	}
 
@@ -253,6 +273,7 @@ int csp_route_work(uint32_t timeout) {
 
 		/* Reject packet if no matching socket is found */
 		if (!socket) {
+			csp_stats_port_drop(packet);
 			csp_buffer_free(packet);
 			return CSP_ERR_NONE;
 		}
@@ -278,6 +299,7 @@ int csp_route_work(uint32_t timeout) {
 
 		if (!conn) {
 			csp_log_error("No more connections available");
+			csp_stats_port_drop(packet);
 			csp_buffer_free(packet);
 			return CSP_ERR_NONE;
 		}
@@ -297,6 +319,8 @@ int csp_route_work(uint32_t timeout) {
 
 	}
 
+	csp_stats_latency(input.iface, CSP_STATS_ROUTE, route_start);
+
 #if (CSP_USE_RDP)
 	/* Pass packet to RDP module */
 	if (packet->id.flags & CSP_FRDP) {
@@ -313,6 +337,17 @@ int csp_route_work(uint32_t timeout) {
 	return CSP_ERR_NONE;
 }
 
+int csp_route_work(uint32_t timeout) {
+
+#if (CSP_USE_RDP)
+	/* Check connection timeouts (currently only for RDP) */
+	csp_conn_check_timeouts();
+#endif
+
+	return csp_route_next(0);
+
+}
+
 static CSP_DEFINE_TASK(csp_task_router) {
 
 	/* Here there be routing */
@@ -324,13 +359,63 @@ static CSP_DEFINE_TASK(csp_task_router) {
 
 }
 
+static CSP_DEFINE_TASK(csp_task_route_worker) {
+
+	/* The OSAL passes its thread handle, the worker index is the entry argument */
+	const unsigned int worker = *(const unsigned int *)((os_thread_handle_ptr)param)->app_entry_args;
+
+	/* Route the connections hashed to this worker, timeouts are checked by csp_task_route_timer */
+	while (1) {
+		csp_route_next(worker);
+	}
+
+	return CSP_TASK_RETURN;
+
+}
+
+#if (CSP_USE_RDP)
+static CSP_DEFINE_TASK(csp_task_route_timer) {
+
+	while (1) {
+		csp_conn_check_timeouts();
+		csp_sleep_ms(FIFO_TIMEOUT);
+	}
+
+	return CSP_TASK_RETURN;
+
+}
+#endif
+
 int csp_route_start_task(unsigned int task_stack_size, unsigned int task_priority) {
 
-	int ret = csp_thread_create(csp_task_router, "RTE", task_stack_size, NULL, task_priority, NULL);
+	const unsigned int workers = csp_qfifo_workers();
+	int ret;
+
+	if (workers < 2) {
+		ret = csp_thread_create(csp_task_router, "RTE", task_stack_size, NULL, task_priority, &csp_route_handle[0]);
+		if (ret != 0) {
+			csp_log_error("Failed to start router task, error: %d", ret);
+			return ret;
+		}
+		return CSP_ERR_NONE;
+	}
+
+	for (unsigned int worker = 0; worker < workers; worker++) {
+		csp_route_worker_index[worker] = worker;
+		ret = csp_thread_create(csp_task_route_worker, "RTE", task_stack_size, &csp_route_worker_index[worker], task_priority, &csp_route_handle[worker]);
+		if (ret != 0) {
+			csp_log_error("Failed to start router worker %u, error: %d", worker, ret);
+			return ret;
+		}
+	}
+
+#if (CSP_USE_RDP)
+	ret = csp_thread_create(csp_task_route_timer, "RTE_TMR", task_stack_size, NULL, task_priority, &csp_route_handle[CSP_ROUTE_WORKERS_MAX]);
 	if (ret != 0) {
-		csp_log_error("Failed to start router task, error: %d", ret);
+		csp_log_error("Failed to start router timer task, error: %d", ret);
 		return ret;
 	}
+#endif
 
 	return CSP_ERR_NONE;
 
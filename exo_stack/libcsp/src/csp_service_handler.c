@@ -181,6 +181,50 @@ static int do_cmp_poke(struct csp_cmp_message *cmp) {
 
 }
 
+#if (CSP_USE_STATS)
+static int do_cmp_port_stats(struct csp_cmp_message *cmp) {
+
+	csp_stats_port_t stats;
+	if (csp_stats_get_port(cmp->port_stats.port, &stats) != CSP_ERR_NONE) {
+		return CSP_ERR_INVAL;
+	}
+
+	cmp->port_stats.rx =      csp_hton32(stats.rx);
+	cmp->port_stats.rxbytes = csp_hton32(stats.rxbytes);
+	cmp->port_stats.tx =      csp_hton32(stats.tx);
+	cmp->port_stats.txbytes = csp_hton32(stats.txbytes);
+	cmp->port_stats.drop =    csp_hton32(stats.drop);
+
+	return CSP_ERR_NONE;
+}
+
+static int do_cmp_latency(struct csp_cmp_message *cmp) {
+
+	csp_iface_t *ifc = NULL;
+	csp_stats_hist_t hist;
+
+	cmp->latency.interface[CSP_CMP_ROUTE_IFACE_LEN - 1] = '\0';
+	if (cmp->latency.interface[0] != '\0') {
+		ifc = csp_iflist_get_by_name(cmp->latency.interface);
+		if (ifc == NULL) {
+			return CSP_ERR_INVAL;
+		}
+	}
+
+	if (csp_stats_get_latency(ifc, cmp->latency.stage, &hist) != CSP_ERR_NONE) {
+		return CSP_ERR_INVAL;
+	}
+
+	cmp->latency.count =  csp_hton32(hist.count);
+	cmp->latency.max_us = csp_hton32(hist.max_us);
+	for (unsigned int i = 0; i < CSP_STATS_HIST_BUCKETS; i++) {
+		cmp->latency.bucket[i] = csp_hton32(hist.bucket[i]);
+	}
+
+	return CSP_ERR_NONE;
+}
+#endif
+
 static int do_cmp_clock(struct csp_cmp_message *cmp) {
 
 	csp_timestamp_t clock;
@@ -243,6 +287,18 @@ static int csp_cmp_handler(csp_conn_t * conn, csp_packet_t * packet) {
 			ret = do_cmp_clock(cmp);
 			break;
 
+#if (CSP_USE_STATS)
+		case CSP_CMP_PORT_STATS:
+			ret = do_cmp_port_stats(cmp);
+			packet->length = CMP_SIZE(port_stats);
+			break;
+
+		case CSP_CMP_LATENCY:
+			ret = do_cmp_latency(cmp);
+			packet->length = CMP_SIZE(latency);
+			break;
+#endif
+
 		default:
 			ret = CSP_ERR_INVAL;
 			break;
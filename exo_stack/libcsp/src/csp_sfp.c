@@ -20,6 +20,8 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 
 #include "csp_sfp.h"
 
+#include <limits.h>
+
 #include "csp_buffer.h"
 #include "csp_debug.h"
 #include "csp_endian.h"
@@ -66,6 +68,102 @@ static inline sfp_header_t * csp_sfp_header_remove(csp_packet_t * packet) {
 	return header;
 }
 
+/* Max number of separate byte ranges a transfer can be received in, before reordering is considered an error */
+#ifndef CSP_SFP_MAX_RANGES
+#define CSP_SFP_MAX_RANGES	8
+#endif
+
+/**
+ * SFP Reassembly map:
+ * Byte ranges received so far, sorted by offset and merged when they meet, so
+ * fragments can arrive in any order. A transfer received in order uses one range.
+ */
+typedef struct {
+	uint32_t start;
+	uint32_t end;
+} sfp_range_t;
+
+typedef struct {
+	uint32_t totalsize;
+	unsigned int count;
+	sfp_range_t range[CSP_SFP_MAX_RANGES];
+} sfp_map_t;
+
+/* Add range to map, returns 1 if new, 0 if already received and -1 if it does not fit the map */
+static int csp_sfp_map_add(sfp_map_t * map, uint32_t start, uint32_t end) {
+
+	unsigned int i;
+	for (i = 0; i < map->count; i++) {
+		if (start < map->range[i].end) {
+			break;
+		}
+	}
+
+	/* Duplicate */
+	if ((i < map->count) && (start >= map->range[i].start) && (end <= map->range[i].end)) {
+		return 0;
+	}
+
+	/* Partial overlap, fragment boundaries changed during the transfer */
+	if ((i < map->count) && (end > map->range[i].start)) {
+		return -1;
+	}
+
+	const bool join_prev = (i > 0) && (map->range[i - 1].end == start);
+	const bool join_next = (i < map->count) && (map->range[i].start == end);
+
+	if (join_prev && join_next) {
+		map->range[i - 1].end = map->range[i].end;
+		memmove(&map->range[i], &map->range[i + 1], (map->count - i - 1) * sizeof(map->range[0]));
+		map->count--;
+	} else if (join_prev) {
+		map->range[i - 1].end = end;
+	} else if (join_next) {
+		map->range[i].start = start;
+	} else {
+		if (map->count >= CSP_SFP_MAX_RANGES) {
+			return -1;
+		}
+		memmove(&map->range[i + 1], &map->range[i], (map->count - i) * sizeof(map->range[0]));
+		map->range[i].start = start;
+		map->range[i].end = end;
+		map->count++;
+	}
+
+	return 1;
+
+}
+
+static inline bool csp_sfp_map_complete(const sfp_map_t * map) {
+	return (map->count == 1) && (map->range[0].start == 0) && (map->range[0].end == map->totalsize);
+}
+
+/* Add SFP header to a fragment and send it, the packet is consumed in all cases */
+static int csp_sfp_send_fragment(csp_conn_t * conn, csp_packet_t * packet, uint32_t offset, uint32_t totalsize, uint32_t timeout) {
+
+	/* Print debug */
+	csp_log_protocol("%s: %d:%d, sending offset %"PRIu32" size %u",
+				__FUNCTION__, csp_conn_src(conn), csp_conn_sport(conn),
+				offset, packet->length);
+
+	/* Set fragment flag */
+	conn->idout.flags |= CSP_FFRAG;
+
+	/* Add SFP header */
+	sfp_header_t * sfp_header = csp_sfp_header_add(packet); // no check, callers ensure space for the header.
+	sfp_header->totalsize = csp_hton32(totalsize);
+	sfp_header->offset = csp_hton32(offset);
+
+	/* Send data */
+	if (!csp_send(conn, packet, timeout)) {
+		csp_buffer_free(packet);
+		return CSP_ERR_TX;
+	}
+
+	return CSP_ERR_NONE;
+
+}
+
 int csp_sfp_send_own_memcpy(csp_conn_t * conn, const void * data, unsigned int totalsize, unsigned int mtu, uint32_t timeout, csp_memcpy_fnc_t memcpyfcn) {
     if (mtu == 0) {
         return CSP_ERR_INVAL;
@@ -74,10 +172,8 @@ int csp_sfp_send_own_memcpy(csp_conn_t * conn, const void * data, unsigned int t
 	unsigned int count = 0;
 	while(count < totalsize) {
 
-		sfp_header_t * sfp_header;
-
         /* Allocate packet */
-        csp_packet_t * packet = csp_buffer_get(mtu + sizeof(*sfp_header));
+        csp_packet_t * packet = csp_buffer_get(mtu + sizeof(sfp_header_t));
         if (packet == NULL) {
             return CSP_ERR_NOMEM;
         }
@@ -88,28 +184,14 @@ int csp_sfp_send_own_memcpy(csp_conn_t * conn, const void * data, unsigned int t
 			size = mtu;
 		}
 
-		/* Print debug */
-		csp_log_protocol("%s: %d:%d, sending at %p size %u",
-					__FUNCTION__, csp_conn_src(conn), csp_conn_sport(conn),
-					((uint8_t*)data) + count, size);
-
 		/* Copy data */
 		(memcpyfcn)((csp_memptr_t)(uintptr_t)packet->data, (csp_memptr_t)(uintptr_t)(((uint8_t*)data) + count), size);
 		packet->length = size;
 
-		/* Set fragment flag */
-		conn->idout.flags |= CSP_FFRAG;
-
-		/* Add SFP header */
-		sfp_header = csp_sfp_header_add(packet); // no check, because buffer was allocated with extra size.
-		sfp_header->totalsize = csp_hton32(totalsize);
-		sfp_header->offset = csp_hton32(count);
-
-        /* Send data */
-        if (!csp_send(conn, packet, timeout)) {
-            csp_buffer_free(packet);
-            return CSP_ERR_TX;
-        }
+		int error = csp_sfp_send_fragment(conn, packet, count, totalsize, timeout);
+		if (error != CSP_ERR_NONE) {
+			return error;
+		}
 
 		/* Increment count */
 		count += size;
@@ -120,10 +202,36 @@ int csp_sfp_send_own_memcpy(csp_conn_t * conn, const void * data, unsigned int t
 
 }
 
-int csp_sfp_recv_fp(csp_conn_t * conn, void ** return_data, int * return_datasize, uint32_t timeout, csp_packet_t * first_packet) {
+int csp_sfp_send_packets(csp_conn_t * conn, csp_packet_t ** packets, unsigned int count, uint32_t timeout) {
 
-	*return_data = NULL; /* Allow caller to assume csp_free() can always be called when dataout is non-NULL */
-        *return_datasize = 0;
+	/* Check all fragments before sending the first, the receiver cannot handle a changing total size */
+	uint32_t totalsize = 0;
+	unsigned int i;
+	for (i = 0; i < count; i++) {
+		if ((packets[i] == NULL) || (packets[i]->length == 0) ||
+		    ((packets[i]->length + sizeof(sfp_header_t)) > csp_buffer_data_size())) {
+			break;
+		}
+		totalsize += packets[i]->length;
+	}
+
+	uint32_t offset = 0;
+	int error = (i == count) ? CSP_ERR_NONE : CSP_ERR_INVAL;
+	for (i = 0; i < count; i++) {
+		if (error != CSP_ERR_NONE) {
+			csp_buffer_free(packets[i]);
+			continue;
+		}
+		const uint32_t size = packets[i]->length;
+		error = csp_sfp_send_fragment(conn, packets[i], offset, totalsize, timeout);
+		offset += size;
+	}
+
+	return error;
+
+}
+
+int csp_sfp_recv_cb(csp_conn_t * conn, csp_sfp_recv_fnc_t fragfcn, void * context, uint32_t timeout, csp_packet_t * first_packet) {
 
     /* Get first packet from user, or from connection */
     csp_packet_t * packet;
@@ -136,10 +244,9 @@ int csp_sfp_recv_fp(csp_conn_t * conn, void ** return_data, int * return_datasiz
         packet = first_packet;
     }
 
-        uint8_t * data = NULL;
-	uint32_t datasize = 0;
-	uint32_t data_offset = 0;
-        int error = CSP_ERR_TIMEDOUT;
+	sfp_map_t map = {.count = 0};
+	bool first = true;
+	int error = CSP_ERR_TIMEDOUT;
 	do {
 		/* Read SFP header */
 		sfp_header_t * sfp_header = csp_sfp_header_remove(packet);
@@ -157,73 +264,106 @@ int csp_sfp_recv_fp(csp_conn_t * conn, void ** return_data, int * return_datasiz
 					__FUNCTION__, packet->id.src, packet->id.sport,
 					sfp_header->offset + packet->length, sfp_header->totalsize);
 
-		/* Consistency check */
-		if (sfp_header->offset != data_offset) {
-			csp_log_warn("%s: %u:%u, invalid message, offset %"PRIu32" (expected %"PRIu32"), length: %u, totalsize %"PRIu32,
+		if (first) {
+			map.totalsize = sfp_header->totalsize;
+			first = false;
+		}
+
+		/* Consistency check, offset <= totalsize is ensured by csp_sfp_header_remove() so the subtraction cannot wrap */
+		if ((map.totalsize != sfp_header->totalsize) || (packet->length > (map.totalsize - sfp_header->offset)) ||
+		    ((packet->length == 0) && (map.totalsize != 0))) {
+			csp_log_warn("%s: %u:%u, invalid size, sfp.offset: %"PRIu32", length: %u, total: %"PRIu32" / %"PRIu32"",
 					__FUNCTION__, packet->id.src, packet->id.sport,
-					sfp_header->offset, data_offset, packet->length, sfp_header->totalsize);
+					sfp_header->offset, packet->length, map.totalsize, sfp_header->totalsize);
 			csp_buffer_free(packet);
 
 			error = CSP_ERR_SFP;
 			goto error;
 		}
 
-		/* Allocate memory */
-		if (data == NULL) {
-                        datasize = sfp_header->totalsize;
-			data = csp_malloc(datasize);
-			if (data == NULL) {
-				csp_log_warn("%s: %u:%u, csp_malloc(%"PRIu32") failed",
-					__FUNCTION__, packet->id.src, packet->id.sport,
-					datasize);
-				csp_buffer_free(packet);
-
-                error = CSP_ERR_NOMEM;
-                goto error;
-            }
-        }
-
-		/* Consistency check */
-		if (((data_offset + packet->length) > datasize) || (datasize != sfp_header->totalsize)) {
-			csp_log_warn("%s: %u:%u, invalid size, sfp.offset: %"PRIu32", length: %u, total: %"PRIu32" / %"PRIu32"",
+		/* Place fragment in the map, duplicates are dropped */
+		const int added = (packet->length > 0) ? csp_sfp_map_add(&map, sfp_header->offset, sfp_header->offset + packet->length) : 0;
+		if (added < 0) {
+			csp_log_warn("%s: %u:%u, cannot place fragment, sfp.offset: %"PRIu32", length: %u, ranges: %u",
 					__FUNCTION__, packet->id.src, packet->id.sport,
-					sfp_header->offset, packet->length, datasize, sfp_header->totalsize);
+					sfp_header->offset, packet->length, map.count);
 			csp_buffer_free(packet);
 
 			error = CSP_ERR_SFP;
 			goto error;
 		}
 
-		/* Copy data to output */
-		memcpy(data + data_offset, packet->data, packet->length);
-		data_offset += packet->length;
+		/* Hand the fragment to the caller */
+		if (added || (map.totalsize == 0)) {
+			error = (fragfcn)(context, sfp_header->offset, packet->data, packet->length, map.totalsize);
+			if (error != CSP_ERR_NONE) {
+				csp_buffer_free(packet);
+				goto error;
+			}
+		}
 
-		if (data_offset >= datasize) {
-			// transfer complete
-			csp_buffer_free(packet);
+		csp_buffer_free(packet);
 
-                        *return_data = data; // must be freed by csp_free()
-                        *return_datasize = datasize;
+		if ((map.totalsize == 0) || csp_sfp_map_complete(&map)) {
+			// transfer complete
 			return CSP_ERR_NONE;
 		}
 
-		/* Consistency check */
-		if (packet->length == 0) {
-			csp_log_warn("%s: %u:%u, invalid size, sfp.offset: %"PRIu32", length: %u, total: %"PRIu32" / %"PRIu32"",
-					__FUNCTION__, packet->id.src, packet->id.sport,
-					sfp_header->offset, packet->length, datasize, sfp_header->totalsize);
-			csp_buffer_free(packet);
+		error = CSP_ERR_TIMEDOUT;
 
-			error = CSP_ERR_SFP;
-			goto error;
+	} while((packet = csp_read(conn, timeout)) != NULL);
+
+error:
+	return error;
+
+}
+
+typedef struct {
+	uint8_t * data;
+	uint32_t datasize;
+} sfp_recv_buf_t;
+
+static int csp_sfp_recv_copy(void * context, uint32_t offset, const void * data, unsigned int size, uint32_t totalsize) {
+
+	sfp_recv_buf_t * buf = context;
+
+	/* Allocate memory, the size is returned as an int */
+	if (buf->data == NULL) {
+		if (totalsize > INT_MAX) {
+			csp_log_warn("%s: total size %"PRIu32" too large", __FUNCTION__, totalsize);
+			return CSP_ERR_SFP;
+		}
+		buf->datasize = totalsize;
+		buf->data = csp_malloc(totalsize);
+		if (buf->data == NULL) {
+			csp_log_warn("%s: csp_malloc(%"PRIu32") failed", __FUNCTION__, totalsize);
+			return CSP_ERR_NOMEM;
 		}
+	}
 
-		csp_buffer_free(packet);
+	/* Copy data to output */
+	if ((offset > buf->datasize) || (size > (buf->datasize - offset))) {
+		return CSP_ERR_SFP;
+	}
+	memcpy(buf->data + offset, data, size);
+	return CSP_ERR_NONE;
 
-	} while((packet = csp_read(conn, timeout)) != NULL);
+}
 
-error:
-	csp_free(data);
-        return error;
+int csp_sfp_recv_fp(csp_conn_t * conn, void ** return_data, int * return_datasize, uint32_t timeout, csp_packet_t * first_packet) {
+
+	*return_data = NULL; /* Allow caller to assume csp_free() can always be called when dataout is non-NULL */
+        *return_datasize = 0;
+
+	sfp_recv_buf_t buf = {.data = NULL, .datasize = 0};
+	int error = csp_sfp_recv_cb(conn, csp_sfp_recv_copy, &buf, timeout, first_packet);
+	if (error != CSP_ERR_NONE) {
+		csp_free(buf.data);
+		return error;
+	}
+
+        *return_data = buf.data; // must be freed by csp_free()
+        *return_datasize = buf.datasize;
+	return CSP_ERR_NONE;
 
 }
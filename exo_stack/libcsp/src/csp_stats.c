@@ -0,0 +1,172 @@
+/*
+Cubesat Space Protocol - A small network-layer protocol designed for Cubesats
+Copyright (C) 2012 Gomspace ApS (http://www.gomspace.com)
+Copyright (C) 2012 AAUSAT3 Project (http://aausat3.space.aau.dk) 
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "csp_stats.h"
+
+#include <string.h>
+
+#include "csp.h"
+#include "csp_interface.h"
+
+#if (CSP_USE_STATS)
+
+/* Updated concurrently by the router workers and sending tasks, hence the atomics */
+static csp_stats_port_t csp_stats_ports[CSP_ID_PORT_MAX + 1];
+
+static inline void csp_stats_inc(uint32_t * counter, uint32_t value) {
+	__atomic_fetch_add(counter, value, __ATOMIC_RELAXED);
+}
+
+static unsigned int csp_stats_bucket(uint32_t us) {
+
+	/* log2, samples below 2 uS go in bucket 0 */
+	const unsigned int bucket = 31 - __builtin_clz(us | 1);
+	return (bucket < CSP_STATS_HIST_BUCKETS) ? bucket : (CSP_STATS_HIST_BUCKETS - 1);
+
+}
+
+void csp_stats_latency(csp_iface_t * iface, csp_stats_stage_t stage, uint32_t start) {
+
+	const uint32_t us = csp_get_us() - start;
+	csp_stats_hist_t * hist = &iface->latency[stage];
+
+	csp_stats_inc(&hist->bucket[csp_stats_bucket(us)], 1);
+	csp_stats_inc(&hist->count, 1);
+
+	uint32_t max = __atomic_load_n(&hist->max_us, __ATOMIC_RELAXED);
+	while ((us > max) && !__atomic_compare_exchange_n(&hist->max_us, &max, us, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+
+}
+
+void csp_stats_port_rx(const csp_packet_t * packet) {
+
+	csp_stats_port_t * port = &csp_stats_ports[packet->id.dport];
+	csp_stats_inc(&port->rx, 1);
+	csp_stats_inc(&port->rxbytes, packet->length);
+
+}
+
+void csp_stats_port_drop(const csp_packet_t * packet) {
+
+	csp_stats_inc(&csp_stats_ports[packet->id.dport].drop, 1);
+
+}
+
+void csp_stats_port_tx(uint8_t port, uint16_t bytes) {
+
+	csp_stats_inc(&csp_stats_ports[port].tx, 1);
+	csp_stats_inc(&csp_stats_ports[port].txbytes, bytes);
+
+}
+
+int csp_stats_get_port(uint8_t port, csp_stats_port_t * stats) {
+
+	if ((port > CSP_ID_PORT_MAX) || (stats == NULL)) {
+		return CSP_ERR_INVAL;
+	}
+
+	*stats = csp_stats_ports[port];
+	return CSP_ERR_NONE;
+
+}
+
+int csp_stats_get_latency(const csp_iface_t * iface, csp_stats_stage_t stage, csp_stats_hist_t * hist) {
+
+	if ((stage >= CSP_STATS_STAGES) || (hist == NULL)) {
+		return CSP_ERR_INVAL;
+	}
+
+	if (iface) {
+		*hist = iface->latency[stage];
+		return CSP_ERR_NONE;
+	}
+
+	/* Sum over all interfaces */
+	memset(hist, 0, sizeof(*hist));
+	for (const csp_iface_t * i = csp_iflist_get(); i != NULL; i = i->next) {
+		const csp_stats_hist_t * h = &i->latency[stage];
+		hist->count += h->count;
+		if (h->max_us > hist->max_us) {
+			hist->max_us = h->max_us;
+		}
+		for (unsigned int b = 0; b < CSP_STATS_HIST_BUCKETS; b++) {
+			hist->bucket[b] += h->bucket[b];
+		}
+	}
+	return CSP_ERR_NONE;
+
+}
+
+uint32_t csp_stats_percentile(const csp_stats_hist_t * hist, unsigned int percent) {
+
+	if ((hist == NULL) || (hist->count == 0)) {
+		return 0;
+	}
+
+	const uint64_t target = ((uint64_t)hist->count * percent + 99) / 100;
+	uint64_t sum = 0;
+	for (unsigned int b = 0; b < (CSP_STATS_HIST_BUCKETS - 1); b++) {
+		sum += hist->bucket[b];
+		if (sum >= target) {
+			/* Upper bound of the bucket, but never above the largest sample */
+			const uint32_t bound = (2UL << b) - 1;
+			return (bound < hist->max_us) ? bound : hist->max_us;
+		}
+	}
+	return hist->max_us;
+
+}
+
+void csp_stats_reset(void) {
+
+	memset(csp_stats_ports, 0, sizeof(csp_stats_ports));
+	for (csp_iface_t * i = csp_iflist_get(); i != NULL; i = i->next) {
+		memset(i->latency, 0, sizeof(i->latency));
+	}
+
+}
+
+#if (CSP_DEBUG)
+void csp_stats_print(void) {
+
+	static const char * const stage_name[CSP_STATS_STAGES] = {"qfifo", "route", "tx"};
+
+	for (const csp_iface_t * i = csp_iflist_get(); i != NULL; i = i->next) {
+		DEBUG_CPRINT(("%-10s latency uS\r\n", i->name));
+		for (unsigned int stage = 0; stage < CSP_STATS_STAGES; stage++) {
+			const csp_stats_hist_t * h = &i->latency[stage];
+			DEBUG_CPRINT(("           %-5s n: %"PRIu32" p50: %"PRIu32" p99: %"PRIu32" max: %"PRIu32"\r\n",
+			       stage_name[stage], h->count, csp_stats_percentile(h, 50), csp_stats_percentile(h, 99), h->max_us));
+		}
+	}
+
+	for (unsigned int port = 0; port <= CSP_ID_PORT_MAX; port++) {
+		const csp_stats_port_t * p = &csp_stats_ports[port];
+		if ((p->rx == 0) && (p->tx == 0) && (p->drop == 0)) {
+			continue;
+		}
+		DEBUG_CPRINT(("port %-5u rx: %05"PRIu32" rxb: %"PRIu32" tx: %05"PRIu32" txb: %"PRIu32" drop: %05"PRIu32"\r\n",
+		       port, p->rx, p->rxbytes, p->tx, p->txbytes, p->drop));
+	}
+
+}
+#endif
+
+#endif // CSP_USE_STATS
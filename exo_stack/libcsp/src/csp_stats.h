@@ -0,0 +1,114 @@
+/*
+Cubesat Space Protocol - A small network-layer protocol designed for Cubesats
+Copyright (C) 2012 Gomspace ApS (http://www.gomspace.com)
+Copyright (C) 2012 AAUSAT3 Project (http://aausat3.space.aau.dk) 
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef _SRC_CSP_STATS_H_
+#define _SRC_CSP_STATS_H_
+
+#include <string.h>
+
+#include "csp_types.h"
+#include "csp_interface.h"
+#include "csp_time.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Router hooks. Without CSP_USE_STATS they are empty inlines, so call sites need no
+ * conditionals and the compiler removes them.
+ */
+
+#if (CSP_USE_STATS)
+
+/**
+ * Stamp the router input time on a packet.
+ * The time is kept in the packet padding until the packet leaves the router, protocols that
+ * use the padding (RDP, I2C) only write it after that (-> csp_packet_t.padding)
+ * @param packet incoming packet
+ * @param isr non zero if called from ISR
+ */
+static inline void csp_stats_stamp(csp_packet_t * packet, int isr) {
+	const uint32_t now = isr ? csp_get_us_isr() : csp_get_us();
+	memcpy(packet->padding, &now, sizeof(now));
+}
+
+/**
+ * Get the time used for latency samples
+ * @return uS
+ */
+static inline uint32_t csp_stats_now(void) {
+	return csp_get_us();
+}
+
+/**
+ * Get the router input time of a packet
+ * @param packet packet stamped by csp_stats_stamp()
+ * @return uS
+ */
+static inline uint32_t csp_stats_rx_time(const csp_packet_t * packet) {
+	uint32_t stamp;
+	memcpy(&stamp, packet->padding, sizeof(stamp));
+	return stamp;
+}
+
+/**
+ * Add a latency sample
+ * @param iface interface the sample belongs to
+ * @param stage latency stage
+ * @param start start of the stage, csp_stats_now() or csp_stats_rx_time()
+ */
+void csp_stats_latency(csp_iface_t * iface, csp_stats_stage_t stage, uint32_t start);
+
+/**
+ * Count a packet received for a local port
+ * @param packet packet, counted on its destination port
+ */
+void csp_stats_port_rx(const csp_packet_t * packet);
+
+/**
+ * Count a packet dropped for a local port
+ * @param packet packet, counted on its destination port
+ */
+void csp_stats_port_drop(const csp_packet_t * packet);
+
+/**
+ * Count a locally originated packet transmitted
+ * @param port source port
+ * @param bytes packet length
+ */
+void csp_stats_port_tx(uint8_t port, uint16_t bytes);
+
+#else
+
+static inline void csp_stats_stamp(csp_packet_t * packet, int isr) { (void)packet; (void)isr; }
+static inline uint32_t csp_stats_now(void) { return 0; }
+static inline uint32_t csp_stats_rx_time(const csp_packet_t * packet) { (void)packet; return 0; }
+static inline void csp_stats_latency(csp_iface_t * iface, csp_stats_stage_t stage, uint32_t start) { (void)iface; (void)stage; (void)start; }
+static inline void csp_stats_port_rx(const csp_packet_t * packet) { (void)packet; }
+static inline void csp_stats_port_drop(const csp_packet_t * packet) { (void)packet; }
+static inline void csp_stats_port_tx(uint8_t port, uint16_t bytes) { (void)port; (void)bytes; }
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,311 @@
+/*
+   Cubesat Space Protocol - A small network-layer protocol designed for Cubesats
+   Copyright (C) 2012 GomSpace ApS (http://www.gomspace.com)
+   Copyright (C) 2012 AAUSAT3 Project (http://aausat3.space.aau.dk)
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with this library; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+   */
+
+/*
+ * SocketCAN driver for the linux build, works on real CAN devices and on vcan.
+ *
+ * Frames are moved through the linux IO-AL in batches: the Rx thread drains up
+ * to CSP_CAN_BATCH frames per recvmmsg(), and the Tx path collects the frames
+ * of a CFP packet and hands them to sendmmsg() once the last one (remain = 0)
+ * is queued or the batch is full. Unless promiscuous mode is enabled, the
+ * kernel only delivers frames addressed to csp_get_address() or broadcast.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include "csp.h"
+#include "csp_can.h"
+#include "csp_thread.h"
+#include "csp_semaphore.h"
+#include "csp_time.h"
+#include "exo_hal_io_al_common.h"
+#include "exo_io_al_linux_can.h"
+#include "exo_osal.h"
+
+/** Frames moved per recvmmsg()/sendmmsg() call */
+#ifndef CSP_CAN_BATCH
+#define CSP_CAN_BATCH		16
+#endif
+
+/** Rx poll interval, bounds the time csp_can_stop() waits for the Rx thread */
+#ifndef CSP_CAN_RX_POLL_MS
+#define CSP_CAN_RX_POLL_MS	100
+#endif
+
+/** Time a CFP packet may wait for room in the device queue before it is dropped */
+#ifndef CSP_CAN_TX_TIMEOUT_MS
+#define CSP_CAN_TX_TIMEOUT_MS	1000
+#endif
+
+/** Filter banks programmed from the CSP address */
+#define CAN_FILTER_BANK_HOST		0
+#define CAN_FILTER_BANK_BROADCAST	1
+
+// CAN interface data, state, etc.
+typedef struct {
+    char name[CSP_IFLIST_NAME_MAX + 1];
+    csp_iface_t iface;
+    csp_can_interface_data_t ifdata;
+    csp_thread_handle_t rx_thread;
+    ioal_can_hdle* can_hdl;
+    volatile int stop;
+    volatile int rx_done;
+    csp_mutex_t tx_lock;
+    uint32_t tx_count;
+    iohal_can_tx_header tx_header[CSP_CAN_BATCH];
+    uint8_t tx_data[CSP_CAN_BATCH][8];
+    iohal_can_rx_header rx_header[CSP_CAN_BATCH];
+    uint8_t rx_data[CSP_CAN_BATCH][8];
+} can_context_t;
+
+
+static void csp_can_free(can_context_t * ctx) {
+
+    if (ctx)
+    {
+        csp_mutex_remove(&ctx->tx_lock);
+        free(ctx);
+    }
+}
+
+#if (CSP_USE_PROMISC == 0)
+/**
+ * Program one 32-bit mask filter bank matching extended identifiers.
+ * The bank uses the bxCAN register layout, which the linux IO-AL translates
+ * into a CAN_RAW_FILTER entry.
+ */
+static int csp_can_set_filter(can_context_t * ctx, uint32_t bank, uint32_t id, uint32_t mask)
+{
+    iohal_can_filter filter;
+    const uint32_t id_reg = (id << 3) | CAN_ID_EXT;
+    const uint32_t mask_reg = (mask << 3) | CAN_ID_EXT;
+
+    filter.FilterIdHigh = id_reg >> 16;
+    filter.FilterIdLow = id_reg & 0xFFFF;
+    filter.FilterMaskIdHigh = mask_reg >> 16;
+    filter.FilterMaskIdLow = mask_reg & 0xFFFF;
+    filter.FilterFIFOAssignment = CAN_RX_FIFO0;
+    filter.FilterBank = bank;
+    filter.FilterMode = CAN_FILTERMODE_IDMASK;
+    filter.FilterScale = CAN_FILTERSCALE_32BIT;
+    filter.FilterActivation = CAN_FILTER_ENABLE;
+    filter.SlaveStartFilterBank = 0;
+
+    return (io_hal_can_configfilter(ctx->can_hdl, &filter) == HAL_SCS) ? CSP_ERR_NONE : CSP_ERR_DRIVER;
+}
+#endif
+
+static void can_rx_thread(void * arg)
+{
+    can_context_t * ctx = ((os_thread_handle_ptr)arg)->app_entry_args;
+    int count;
+    int i;
+
+    while (!ctx->stop)
+    {
+        count = io_hal_linux_can_recv_batch(ctx->can_hdl, ctx->rx_header, ctx->rx_data, CSP_CAN_BATCH, CSP_CAN_RX_POLL_MS);
+        if (count < 0)
+        {
+            csp_log_error("%s[%s]: recvmmsg() failed, errno %d: %s", __FUNCTION__, ctx->name, errno, strerror(errno));
+            csp_sleep_ms(CSP_CAN_RX_POLL_MS);
+            continue;
+        }
+        for (i = 0; i < count; i++)
+        {
+            /* CFP only uses extended identifiers */
+            if ((ctx->rx_header[i].IDE != CAN_ID_EXT) || (ctx->rx_header[i].RTR != CAN_RTR_DATA))
+            {
+                continue;
+            }
+            csp_can_rx(&ctx->iface, ctx->rx_header[i].ExtId, ctx->rx_data[i], ctx->rx_header[i].DLC, NULL);
+        }
+    }
+    ctx->rx_done = 1;
+}
+
+/**
+ * Send the queued frames, retrying while the device queue is full.
+ * Must be called with tx_lock held.
+ */
+static int csp_can_tx_flush(can_context_t * ctx)
+{
+    const uint32_t deadline = csp_get_ms() + CSP_CAN_TX_TIMEOUT_MS;
+    uint32_t sent = 0;
+    int32_t remain_ms;
+    int res;
+
+    while (sent < ctx->tx_count)
+    {
+        res = io_hal_linux_can_send_batch(ctx->can_hdl, &ctx->tx_header[sent], &ctx->tx_data[sent], ctx->tx_count - sent);
+        if (res > 0)
+        {
+            sent += res;
+            continue;
+        }
+        remain_ms = (int32_t)(deadline - csp_get_ms());
+        if ((errno != ENOBUFS) || (remain_ms <= 0))
+        {
+            csp_log_warn("%s[%s]: sendmmsg() failed, errno %d: %s", __FUNCTION__, ctx->name, errno, strerror(errno));
+            ctx->tx_count = 0;
+            return CSP_ERR_TX;
+        }
+        /* The socket reports POLLOUT from its own buffer while ENOBUFS comes from the
+         * device queue, so a writable socket still waits a tick before the retry */
+        if (io_hal_linux_can_wait_tx(ctx->can_hdl, remain_ms) > 0)
+        {
+            csp_sleep_ms(1);
+        }
+    }
+    ctx->tx_count = 0;
+    return CSP_ERR_NONE;
+}
+
+static int csp_can_tx_frame(void * driver_data, uint32_t id, const uint8_t * data, uint8_t dlc)
+{
+    can_context_t * ctx = driver_data;
+    iohal_can_tx_header * txheader;
+    int res = CSP_ERR_NONE;
+
+    if (dlc > 8)
+    {
+        return CSP_ERR_INVAL;
+    }
+
+    csp_mutex_lock(&ctx->tx_lock, CSP_MAX_DELAY);
+    txheader = &ctx->tx_header[ctx->tx_count];
+    txheader->DLC = dlc;
+    txheader->ExtId = id;
+    txheader->RTR = CAN_RTR_DATA;
+    txheader->StdId = 0;
+    txheader->IDE = CAN_ID_EXT;
+    memcpy(ctx->tx_data[ctx->tx_count], data, dlc);
+    ctx->tx_count++;
+
+    /* The last frame of a packet has no remaining frames */
+    if ((CFP_REMAIN(id) == 0) || (ctx->tx_count == CSP_CAN_BATCH))
+    {
+        res = csp_can_tx_flush(ctx);
+    }
+    csp_mutex_unlock(&ctx->tx_lock);
+    return res;
+}
+
+int csp_can_open_and_add_interface(const char * device, const char * ifname,ioal_can_hdle* can_intf_hdl, csp_iface_t ** return_iface)
+{
+    if (ifname == NULL) {
+        ifname = CSP_IF_CAN_DEFAULT_NAME;
+    }
+
+    csp_log_info("INIT %s: device: [%s]",
+            ifname, device);
+
+    can_context_t * ctx = calloc(1, sizeof(*ctx));
+    if (ctx == NULL) {
+        return CSP_ERR_NOMEM;
+    }
+    if (csp_mutex_create(&ctx->tx_lock) != CSP_MUTEX_OK) {
+        free(ctx);
+        return CSP_ERR_NOMEM;
+    }
+
+    strncpy(ctx->name, ifname, sizeof(ctx->name) - 1);
+    ctx->iface.name = ctx->name;
+    ctx->iface.interface_data = &ctx->ifdata;
+    ctx->iface.driver_data = ctx;
+    ctx->ifdata.tx_func = csp_can_tx_frame;
+    ctx->can_hdl=can_intf_hdl;
+
+    iohal_can_state can_ste;
+    can_ste=io_hal_can_get_state(ctx->can_hdl);
+    if(can_ste ==IOHAL_CAN_STATE_READY )
+    {
+        io_hal_can_start(ctx->can_hdl);
+    }
+    else if(can_ste ==IOHAL_CAN_STATE_LISTENING )
+    {
+        //do nothing
+    }
+    else
+    {
+        csp_can_free(ctx);
+        return CSP_ERR_DRIVER;
+    }
+
+#if (CSP_USE_PROMISC == 0)
+    /* Let the kernel drop frames for other hosts */
+    if ((csp_can_set_filter(ctx, CAN_FILTER_BANK_HOST, CFP_MAKE_DST(csp_get_address()), CFP_MAKE_DST(CSP_ID_HOST_MAX)) != CSP_ERR_NONE) ||
+        (csp_can_set_filter(ctx, CAN_FILTER_BANK_BROADCAST, CFP_MAKE_DST(CSP_BROADCAST_ADDR), CFP_MAKE_DST(CSP_ID_HOST_MAX)) != CSP_ERR_NONE)) {
+        csp_log_error("%s[%s]: failed to set CAN filter", __FUNCTION__, ctx->name);
+        csp_can_free(ctx);
+        return CSP_ERR_DRIVER;
+    }
+#endif
+
+    /* Add interface to CSP */
+    int res = csp_can_add_interface(&ctx->iface);
+    if (res != CSP_ERR_NONE) {
+        csp_log_error("%s[%s]: csp_can_add_interface() failed, error: %d", __FUNCTION__, ctx->name, res);
+        csp_can_free(ctx);
+        return res;
+    }
+    /* Create receive thread */
+    if(csp_thread_create((csp_thread_func_t)can_rx_thread,"can_rx", 2048, ctx, P_CSP_INTF_CAN_RX,&ctx->rx_thread )!=0)
+    {
+        csp_log_error("%s[%s]: can_rx_thread failed, error: %s", __FUNCTION__, ctx->name, strerror(errno));
+        csp_iflist_remove(&ctx->iface);
+        csp_can_free(ctx);
+        return CSP_ERR_NOMEM;
+    }
+    if (return_iface) {
+        *return_iface = &ctx->iface;
+    }
+    return CSP_ERR_NONE;
+}
+
+csp_iface_t * csp_can_init(const char * device,ioal_can_hdle* can_intf_hdl)
+{
+    csp_iface_t * return_iface;
+    int res = csp_can_open_and_add_interface(device, CSP_IF_CAN_DEFAULT_NAME,can_intf_hdl, &return_iface);
+    return (res == CSP_ERR_NONE) ? return_iface : NULL;
+}
+
+int csp_can_stop(csp_iface_t *iface)
+{
+    can_context_t * ctx = iface->driver_data;
+
+    /* The interface lives in the context, unregister it before the context is freed */
+    csp_iflist_remove(iface);
+
+    /* The Rx thread checks the flag at least every CSP_CAN_RX_POLL_MS */
+    ctx->stop = 1;
+    while (!ctx->rx_done)
+    {
+        csp_sleep_ms(CSP_CAN_RX_POLL_MS / 10);
+    }
+    io_hal_can_stop(ctx->can_hdl);
+
+    /* Let a transmission that found the interface before it was removed finish */
+    csp_mutex_lock(&ctx->tx_lock, CSP_MAX_DELAY);
+    iface->driver_data = NULL;
+    csp_mutex_unlock(&ctx->tx_lock);
+    csp_can_free(ctx);
+    return CSP_ERR_NONE;
+}
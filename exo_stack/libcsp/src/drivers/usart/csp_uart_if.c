@@ -30,12 +30,19 @@
 #include "exo_ahw_al_common.h"
 #include "exo_osal.h"
 #include "exo_hal_io_al_intr.h"
+#ifdef LINUX_TEMP_PORT
+#include "exo_io_al_linux_uart.h"
+#endif
 
 #include "csp.h"
 #include "csp_thread.h"
 
 #define CBUF_SIZE  400  ///< Maximum CBUF size
 
+#ifndef CSP_USART_RX_POLL_MS
+#define CSP_USART_RX_POLL_MS    1000    ///< Linux Rx wait per poll(), data is delivered as soon as it arrives
+#endif
+
 extern ioal_uart_hdle ioal_huart6; ///< UART6 handler declaration
 extern ioal_uart_hdle ioal_huart4; ///< UART4 handler declaration
 
@@ -52,6 +59,7 @@ typedef struct {
     void * user_data;
     csp_usart_fd_t fd;
     csp_thread_handle_t rx_thread;
+    ioal_uart_hdle *uart_hdl;
 }usart_context_t;
 
 uint16_t csp_g_tail = 0;
@@ -125,21 +133,29 @@ void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size)
 #ifdef LINUX_TEMP_PORT
 /**
  * @brief This is UART receive callback function
+ *
+ * Sleeps in poll() until bytes arrive and hands everything pending to the
+ * interface at once, the port is switched to non-blocking reads by csp_usart_open().
  */
 void usart_rx_cb(void * arg)
 {
 #ifndef UHF_HW_BYPASS
     //usart_context_t * ctx =arg;
     usart_context_t * ctx = ((os_thread_handle_ptr)arg)->app_entry_args;
-    uint8_t cbuf[CBUF_SIZE];
+    int count;
 
     while(1)
     {
-        length = io_hal_uart_receive(&ioal_huart6, csp_bGet, CBUF_SIZE, 100);
-	printf("RCV length=%d\n",length);
-        os_memcpy(cbuf,csp_bGet,length);
-        if (length > 0)
+        count = io_hal_linux_uart_poll_receive(ctx->uart_hdl, csp_bGet, CBUF_SIZE, CSP_USART_RX_POLL_MS);
+        if (count < 0)
         {
+            csp_log_error("%s: UART read failed, errno: %s", __FUNCTION__, strerror(errno));
+            os_delay(CSP_USART_RX_POLL_MS);
+            continue;
+        }
+        if (count > 0)
+        {
+            length = count;
             os_memcpy(uhf_uart_rsp,csp_bGet,length);
             uhf_uart_rsp_len = length;
             if (ctx->rx_callback)
@@ -148,9 +164,7 @@ void usart_rx_cb(void * arg)
             }
 
             length =0;
-
         }
-        os_delay(10);
     }
 #endif
 }
@@ -222,6 +236,11 @@ int csp_usart_open(ioal_uart_hdle *uart_hdl, csp_usart_callback_t rx_callback, v
     os_sem_create_bin(&csp_uart_sem);
     os_sem_take(csp_uart_sem, 5000);
     io_hal_uart_dma_receive_to_idle(uart_hdl,&csp_uart,csp_bGet, CBUF_SIZE);
+#else
+    if (io_hal_linux_uart_set_nonblocking(uart_hdl) != HAL_SCS) {
+        csp_log_error("%s: failed to set UART non-blocking, errno: %s", __FUNCTION__, strerror(errno));
+        return CSP_ERR_DRIVER;
+    }
 #endif
     //   io_hal_uart_receive_it(uart_hdl,&csp_uart,csp_bGet, CBUF_SIZE);
     usart_context_t * ctx = calloc(1, sizeof(*ctx));
@@ -234,6 +253,7 @@ int csp_usart_open(ioal_uart_hdle *uart_hdl, csp_usart_callback_t rx_callback, v
     ctx->rx_callback = rx_callback;
     ctx->user_data = user_data;
     ctx->fd = 1;
+    ctx->uart_hdl = uart_hdl;
     if (rx_callback) {
         if (csp_thread_create(usart_rx_cb, "usart_cb", (128 * 4), ctx, P_UART_RX, &ctx->rx_thread) != CSP_ERR_NONE) {
             csp_log_error("%s: csp_thread_create() failed to create Rx cb for, errno: %s", __FUNCTION__, strerror(errno));
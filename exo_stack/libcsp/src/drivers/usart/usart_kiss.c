@@ -31,6 +31,7 @@ typedef struct {
 	char name[CSP_IFLIST_NAME_MAX + 1];
 	csp_iface_t iface;
 	csp_kiss_interface_data_t ifdata;
+	csp_uhf_parser_t uhf_parser;
 	csp_usart_fd_t fd;
 	ioal_uart_hdle *uart_hdl;
 } kiss_context_t;
@@ -80,6 +81,8 @@ int csp_usart_open_and_add_kiss_interface(ioal_uart_hdle *uart_hdl, const char *
 	ctx->iface.driver_data = ctx;
 	ctx->iface.interface_data = &ctx->ifdata;
 	ctx->ifdata.tx_func = kiss_driver_tx;
+	csp_uhf_parser_init(&ctx->uhf_parser);
+	ctx->ifdata.uhf_parser = &ctx->uhf_parser;
 	ctx->uart_hdl=uart_hdl;
 #if (CSP_WINDOWS)
 	ctx->fd = NULL;
@@ -58,7 +58,7 @@ int csp_can_rx(csp_iface_t *iface, uint32_t id, const uint8_t *data, uint8_t dlc
 	}
 #endif
 	/* Bind incoming frame to a packet buffer */
-	csp_can_pbuf_element_t * buf = csp_can_pbuf_find(id, CFP_ID_CONN_MASK, task_woken);
+	csp_can_pbuf_element_t * buf = csp_can_pbuf_find(id, task_woken);
 	if (buf == NULL) {
 		if (CFP_TYPE(id) == CFP_BEGIN) {
 			buf = csp_can_pbuf_new(id, task_woken);
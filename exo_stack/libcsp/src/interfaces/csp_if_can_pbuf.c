@@ -23,16 +23,77 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #include <csp/csp_buffer.h>
 #include <csp/csp_error.h>
 #include <csp/arch/csp_time.h>
+#include <csp/interfaces/csp_if_can.h>
 #include "exo_types.h"
 
 /* Number of packet buffer elements */
 #define PBUF_ELEMENTS		256
 
+/* Number of hash buckets, must be a power of two */
+#define PBUF_BUCKETS		64
+
 /* Buffer element timeout in ms */
 #define PBUF_TIMEOUT_MS		1000
 
 static csp_can_pbuf_element_t csp_can_pbuf[PBUF_ELEMENTS] = {};
 
+/* Used elements hashed on CFP connection id */
+static csp_can_pbuf_element_t *csp_can_pbuf_bucket[PBUF_BUCKETS];
+
+/* Free elements */
+static csp_can_pbuf_element_t *csp_can_pbuf_free_list;
+
+/* Used elements ordered by last use, so expired elements are at the head */
+static csp_can_pbuf_element_t *csp_can_pbuf_lru_head;
+static csp_can_pbuf_element_t *csp_can_pbuf_lru_tail;
+
+static bool csp_can_pbuf_initialized;
+
+static inline unsigned int csp_can_pbuf_hash(uint32_t id)
+{
+	/* CFP id changes with every packet, source and destination spread interleaved senders */
+	const uint32_t key = id & CFP_ID_CONN_MASK;
+	return (CFP_ID(key) ^ (CFP_SRC(key) << 3) ^ (CFP_DST(key) << 1)) & (PBUF_BUCKETS - 1);
+}
+
+static void csp_can_pbuf_init(void)
+{
+	csp_can_pbuf_free_list = NULL;
+	for (int i = PBUF_ELEMENTS - 1; i >= 0; i--) {
+		csp_can_pbuf[i].next = csp_can_pbuf_free_list;
+		csp_can_pbuf_free_list = &csp_can_pbuf[i];
+	}
+	csp_can_pbuf_initialized = true;
+}
+
+static void csp_can_pbuf_lru_unlink(csp_can_pbuf_element_t *buf)
+{
+	if (buf->lru_prev) {
+		buf->lru_prev->lru_next = buf->lru_next;
+	} else {
+		csp_can_pbuf_lru_head = buf->lru_next;
+	}
+	if (buf->lru_next) {
+		buf->lru_next->lru_prev = buf->lru_prev;
+	} else {
+		csp_can_pbuf_lru_tail = buf->lru_prev;
+	}
+	buf->lru_prev = NULL;
+	buf->lru_next = NULL;
+}
+
+static void csp_can_pbuf_lru_append(csp_can_pbuf_element_t *buf)
+{
+	buf->lru_next = NULL;
+	buf->lru_prev = csp_can_pbuf_lru_tail;
+	if (csp_can_pbuf_lru_tail) {
+		csp_can_pbuf_lru_tail->lru_next = buf;
+	} else {
+		csp_can_pbuf_lru_head = buf;
+	}
+	csp_can_pbuf_lru_tail = buf;
+}
+
 int csp_can_pbuf_free(csp_can_pbuf_element_t *buf, CSP_BASE_TYPE *task_woken)
 {
 	/* Free CSP packet */
@@ -44,6 +105,22 @@ int csp_can_pbuf_free(csp_can_pbuf_element_t *buf, CSP_BASE_TYPE *task_woken)
 		}
 	}
 
+	/* Remove from hash bucket and expiry list */
+	if (buf->state == BUF_USED) {
+		csp_can_pbuf_element_t **link = &csp_can_pbuf_bucket[csp_can_pbuf_hash(buf->cfpid)];
+		while (*link != NULL) {
+			if (*link == buf) {
+				*link = buf->next;
+				break;
+			}
+			link = &(*link)->next;
+		}
+		csp_can_pbuf_lru_unlink(buf);
+
+		buf->next = csp_can_pbuf_free_list;
+		csp_can_pbuf_free_list = buf;
+	}
+
 	/* Mark buffer element free */
 	buf->packet = NULL;
 	buf->rx_count = 0;
@@ -55,40 +132,55 @@ int csp_can_pbuf_free(csp_can_pbuf_element_t *buf, CSP_BASE_TYPE *task_woken)
 	return CSP_ERR_NONE;
 }
 
-csp_can_pbuf_element_t *csp_can_pbuf_new(uint32_t id, CSP_BASE_TYPE *task_woken)
+void csp_can_pbuf_cleanup(CSP_BASE_TYPE *task_woken)
 {
 	uint32_t now = (task_woken) ? csp_get_ms_isr() : csp_get_ms();
 
-	for (int i = 0; i < PBUF_ELEMENTS; i++) {
+	/* Only the oldest elements can have timed out */
+	while ((csp_can_pbuf_lru_head != NULL) && (now - csp_can_pbuf_lru_head->last_used > PBUF_TIMEOUT_MS)) {
+		csp_can_pbuf_free(csp_can_pbuf_lru_head, task_woken);
+	}
+}
 
-		/* Perform cleanup in used pbufs */
-		if (csp_can_pbuf[i].state == BUF_USED) {
-			if (now - csp_can_pbuf[i].last_used > PBUF_TIMEOUT_MS)
-				csp_can_pbuf_free(&csp_can_pbuf[i], task_woken);
-		}
+csp_can_pbuf_element_t *csp_can_pbuf_new(uint32_t id, CSP_BASE_TYPE *task_woken)
+{
+	if (!csp_can_pbuf_initialized) {
+		csp_can_pbuf_init();
+	}
 
-		if (csp_can_pbuf[i].state == BUF_FREE) {
-			csp_can_pbuf[i].state = BUF_USED;
-			csp_can_pbuf[i].cfpid = id;
-			csp_can_pbuf[i].remain = 0;
-			csp_can_pbuf[i].last_used = now;
-			return &csp_can_pbuf[i];
-		}
+	/* Perform cleanup in used pbufs */
+	csp_can_pbuf_cleanup(task_woken);
 
+	csp_can_pbuf_element_t *buf = csp_can_pbuf_free_list;
+	if (buf == NULL) {
+		return NULL;
 	}
+	csp_can_pbuf_free_list = buf->next;
 
-	return NULL;
+	buf->state = BUF_USED;
+	buf->cfpid = id;
+	buf->remain = 0;
+	buf->last_used = (task_woken) ? csp_get_ms_isr() : csp_get_ms();
+
+	unsigned int hash = csp_can_pbuf_hash(id);
+	buf->next = csp_can_pbuf_bucket[hash];
+	csp_can_pbuf_bucket[hash] = buf;
+	csp_can_pbuf_lru_append(buf);
+
+	return buf;
 
 }
 
-csp_can_pbuf_element_t *csp_can_pbuf_find(uint32_t id, uint32_t mask, CSP_BASE_TYPE *task_woken)
+csp_can_pbuf_element_t *csp_can_pbuf_find(uint32_t id, CSP_BASE_TYPE *task_woken)
 {
-	for (int i = 0; i < PBUF_ELEMENTS; i++) {
-		if ((csp_can_pbuf[i].state == BUF_USED) && ((csp_can_pbuf[i].cfpid & mask) == (id & mask))) {
-			csp_can_pbuf[i].last_used = (task_woken) ? csp_get_ms_isr() : csp_get_ms();
-			return &csp_can_pbuf[i];
+	for (csp_can_pbuf_element_t *buf = csp_can_pbuf_bucket[csp_can_pbuf_hash(id)]; buf != NULL; buf = buf->next) {
+		if ((buf->cfpid & CFP_ID_CONN_MASK) == (id & CFP_ID_CONN_MASK)) {
+			buf->last_used = (task_woken) ? csp_get_ms_isr() : csp_get_ms();
+			/* Most recently used goes last in the expiry list */
+			csp_can_pbuf_lru_unlink(buf);
+			csp_can_pbuf_lru_append(buf);
+			return buf;
 		}
 	}
 	return NULL;
 }
-
@@ -29,18 +29,22 @@ typedef enum {
 	BUF_USED = 1,			/* Buffer element used */
 } csp_can_pbuf_state_t;
 
-typedef struct {
+typedef struct csp_can_pbuf_element_s {
 	uint16_t rx_count;		/* Received bytes */
 	uint32_t remain;		/* Remaining packets */
 	uint32_t cfpid;			/* Connection CFP identification number */
 	csp_packet_t *packet;		/* Pointer to packet buffer */
 	csp_can_pbuf_state_t state;	/* Element state */
 	uint32_t last_used;		/* Timestamp in ms for last use of buffer */
+	struct csp_can_pbuf_element_s *next;		/* Next element in hash bucket or free list */
+	struct csp_can_pbuf_element_s *lru_prev;	/* Previous element in expiry list (older) */
+	struct csp_can_pbuf_element_s *lru_next;	/* Next element in expiry list (newer) */
 } csp_can_pbuf_element_t;
 
 int csp_can_pbuf_free(csp_can_pbuf_element_t *buf, CSP_BASE_TYPE *task_woken);
 csp_can_pbuf_element_t *csp_can_pbuf_new(uint32_t id, CSP_BASE_TYPE *task_woken);
-csp_can_pbuf_element_t *csp_can_pbuf_find(uint32_t id, uint32_t mask, CSP_BASE_TYPE *task_woken);
+/* Find the element of the connection (CFP_ID_CONN_MASK part of id) */
+csp_can_pbuf_element_t *csp_can_pbuf_find(uint32_t id, CSP_BASE_TYPE *task_woken);
 void csp_can_pbuf_cleanup(CSP_BASE_TYPE *task_woken);
 
 #endif
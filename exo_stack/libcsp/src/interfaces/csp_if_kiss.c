@@ -22,9 +22,11 @@
 #include"csp_if_uhf.h"
 
 #include <string.h>
+#include <stdint.h>
 //#include "main.h"
 #include "csp_endian.h"
 #include "csp_crc32.h"
+#include "csp_malloc.h"
 
 #define FEND  		0xC0
 #define FESC  		0xDB
@@ -32,6 +34,67 @@
 #define TFESC 		0xDD
 #define TNC_DATA	0x00
 
+/**
+ * Escape code for each byte value, non-zero for the two bytes that must be
+ * escaped (FEND and FESC). Used by both the encoder and the decoder.
+ */
+static const uint8_t kiss_escape_code[256] = {
+    [FEND] = TFEND,
+    [FESC] = TFESC,
+};
+
+#define KISS_ONES	0x01010101U
+#define KISS_HIGHS	0x80808080U
+
+/** Non-zero if any byte in the word is zero */
+#define KISS_HAS_ZERO(w)	(((w) - KISS_ONES) & ~(w) & KISS_HIGHS)
+
+/**
+ * Find the first FEND or FESC in a buffer.
+ * Four bytes are tested per step, the byte loop only runs on the tail and on
+ * the word holding the match.
+ * @return offset of the first special byte, len if there is none
+ */
+static size_t csp_kiss_scan(const uint8_t * data, size_t len) {
+
+    size_t i = 0;
+    uint32_t w;
+
+    for (; (i + sizeof(w)) <= len; i += sizeof(w)) {
+        memcpy(&w, &data[i], sizeof(w));
+        if (KISS_HAS_ZERO(w ^ (FEND * KISS_ONES)) || KISS_HAS_ZERO(w ^ (FESC * KISS_ONES))) {
+            break;
+        }
+    }
+    for (; i < len; i++) {
+        if (kiss_escape_code[data[i]]) {
+            break;
+        }
+    }
+    return i;
+}
+
+/**
+ * Append the escaped form of data to out, copying unescaped runs in one go.
+ * @return pointer past the last byte written
+ */
+static uint8_t * csp_kiss_escape(uint8_t * out, const uint8_t * data, size_t len) {
+
+    while (len) {
+        size_t run = csp_kiss_scan(data, len);
+        memcpy(out, data, run);
+        out += run;
+        data += run;
+        len -= run;
+        if (len) {
+            *out++ = FESC;
+            *out++ = kiss_escape_code[*data++];
+            len--;
+        }
+    }
+    return out;
+}
+
 int csp_kiss_tx(const csp_route_t * ifroute, csp_packet_t * packet) {
 
     csp_kiss_interface_data_t * ifdata = ifroute->iface->interface_data;
@@ -42,34 +105,29 @@ int csp_kiss_tx(const csp_route_t * ifroute, csp_packet_t * packet) {
     /* Add CRC32 checksum - the MTU setting ensures there are space */
     csp_crc32_append(packet, false);
 
+    if ((sizeof(packet->id.ext) + packet->length) > ifdata->max_rx_length) {
+        return CSP_ERR_TX;
+    }
+
     /* Lock */
     if (csp_mutex_lock(&ifdata->lock, 1000) != CSP_MUTEX_OK) {
         return CSP_ERR_TIMEDOUT;
     }
 
-    /* Save the outgoing id in the buffer */
-    packet->id.ext = csp_hton32(packet->id.ext);
-    packet->length += sizeof(packet->id.ext);
+    /* Encode the whole frame, the outgoing id is sent in network order */
+    const uint32_t id = csp_hton32(packet->id.ext);
+    uint8_t * out = ifdata->tx_buf;
+    *out++ = FEND;
+    *out++ = TNC_DATA;
+    out = csp_kiss_escape(out, (const uint8_t *) &id, sizeof(id));
+    out = csp_kiss_escape(out, packet->data, packet->length);
+    *out++ = FEND;
 
     /* Transmit data */
-    const unsigned char start[] = {FEND, TNC_DATA};
-    const unsigned char esc_end[] = {FESC, TFEND};
-    const unsigned char esc_esc[] = {FESC, TFESC};
-    const unsigned char * data = (unsigned char *) &packet->id.ext;
-    ifdata->tx_func(driver, start, sizeof(start));
-    for (unsigned int i = 0; i < packet->length; i++, ++data) {
-        if (*data == FEND) {
-            ifdata->tx_func(driver, esc_end, sizeof(esc_end));
-            continue;
-        }
-        if (*data == FESC) {
-            ifdata->tx_func(driver, esc_esc, sizeof(esc_esc));
-            continue;
-        }
-        ifdata->tx_func(driver, data, 1);
+    if (ifdata->tx_func(driver, ifdata->tx_buf, out - ifdata->tx_buf) != CSP_ERR_NONE) {
+        csp_mutex_unlock(&ifdata->lock);
+        return CSP_ERR_TX;
     }
-    const unsigned char stop[] = {FEND};
-    ifdata->tx_func(driver, stop, sizeof(stop));
 
     /* Free data */
     csp_buffer_free(packet);
@@ -80,36 +138,54 @@ int csp_kiss_tx(const csp_route_t * ifroute, csp_packet_t * packet) {
     return CSP_ERR_NONE;
 }
 
+/**
+ * Store one decoded byte, drop the frame if it does not fit in the packet.
+ */
+static inline void csp_kiss_rx_put(csp_iface_t * iface, csp_kiss_interface_data_t * ifdata, uint8_t inputbyte) {
+
+    if (ifdata->rx_length >= ifdata->max_rx_length) {
+        //csp_log_warn("KISS RX overflow");
+        iface->rx_error++;
+        ifdata->rx_mode = KISS_MODE_NOT_STARTED;
+        ifdata->rx_length = 0;
+        return;
+    }
+    ((uint8_t *) &ifdata->rx_packet->id.ext)[ifdata->rx_length++] = inputbyte;
+}
+
 /**
  * Decode received data and eventually route the packet.
+ * Data between FEND/FESC is copied in runs, the state machine only runs on
+ * the special bytes and on the first byte of a frame.
  */
 void csp_kiss_rx(csp_iface_t * iface, const uint8_t * buf, size_t len, void * pxTaskWoken) {
 
     csp_kiss_interface_data_t * ifdata = iface->interface_data;
+    const uint8_t * end = buf + len;
 
-    while (len--) {
-
-        /* Input */
 #if TX_PRINT
-        DEBUG_CPRINT((" %x",*buf));
+    for (size_t i = 0; i < len; i++) {
+        DEBUG_CPRINT((" %x",buf[i]));
+    }
 #endif
-        uint8_t inputbyte = *buf++;
 
-
-        /* If packet was too long */
-        if (ifdata->rx_length > ifdata->max_rx_length) {
-            //csp_log_warn("KISS RX overflow");
-            iface->rx_error++;
-            ifdata->rx_mode = KISS_MODE_NOT_STARTED;
-            ifdata->rx_length = 0;
-        }
+    while (buf < end) {
 
         switch (ifdata->rx_mode) {
 
             case KISS_MODE_NOT_STARTED:
+            case KISS_MODE_SKIP_FRAME: {
 
                 /* Skip any characters until End char detected */
-                if (inputbyte != FEND) {
+                const uint8_t * fend = memchr(buf, FEND, end - buf);
+                if (fend == NULL) {
+                    return;
+                }
+                buf = fend + 1;
+
+                /* Skipped frame ends here, the next FEND starts a new one */
+                if (ifdata->rx_mode == KISS_MODE_SKIP_FRAME) {
+                    ifdata->rx_mode = KISS_MODE_NOT_STARTED;
                     break;
                 }
 
@@ -130,91 +206,97 @@ void csp_kiss_rx(csp_iface_t * iface, const uint8_t * buf, size_t len, void * px
                 ifdata->rx_mode = KISS_MODE_STARTED;
                 ifdata->rx_first = true;
                 break;
+            }
 
-            case KISS_MODE_STARTED:
+            case KISS_MODE_STARTED: {
 
-                /* Escape char */
-                if (inputbyte == FESC) {
-                    ifdata->rx_mode = KISS_MODE_ESCAPED;
+                /* Skip the first char after FEND which is TNC_DATA (0x00) */
+                if (ifdata->rx_first && !kiss_escape_code[*buf]) {
+                    ifdata->rx_first = false;
+                    buf++;
                     break;
                 }
 
-                /* End Char */
-                if (inputbyte == FEND) {
-
-                    /* Accept message */
-                    if (ifdata->rx_length > 0) {
-
-                        /* Check for valid length */
-                        if (ifdata->rx_length < CSP_HEADER_LENGTH + sizeof(uint32_t)) {
-                            //csp_log_warn("KISS short frame skipped, len: %u", ifdata->rx_length);
-                            iface->rx_error++;
-                            ifdata->rx_mode = KISS_MODE_NOT_STARTED;
-                            break;
-                        }
-
-                        /* Count received frame */
-                        iface->frame++;
-
-                        /* The CSP packet length is without the header */
-                        ifdata->rx_packet->length = ifdata->rx_length - CSP_HEADER_LENGTH;
-
-                        /* Convert the packet from network to host order */
-                        ifdata->rx_packet->id.ext = csp_ntoh32(ifdata->rx_packet->id.ext);
-
-                        /* Validate CRC */
-                        if (csp_crc32_verify(ifdata->rx_packet, false) != CSP_ERR_NONE) {
-                            //csp_log_warn("KISS invalid crc frame skipped, len: %u", ifdata->rx_packet->length);
-                            iface->rx_error++;
-                            ifdata->rx_mode = KISS_MODE_NOT_STARTED;
-                            //DEBUG_CPRINT(("\n\rCRC ERR\n\r"));
-                            break;
-                        }
-
-                        /* Send back into CSP, notice calling from task so last argument must be NULL! */
-                        csp_qfifo_write(ifdata->rx_packet, iface, pxTaskWoken);
-                        ifdata->rx_packet = NULL;
+                /* Copy the run of plain data up to the next special char */
+                size_t run = csp_kiss_scan(buf, end - buf);
+                if (run) {
+                    if (run > (ifdata->max_rx_length - ifdata->rx_length)) {
+                        //csp_log_warn("KISS RX overflow");
+                        iface->rx_error++;
                         ifdata->rx_mode = KISS_MODE_NOT_STARTED;
+                        ifdata->rx_length = 0;
+                        buf += run;
                         break;
-
                     }
+                    memcpy(&((uint8_t *) &ifdata->rx_packet->id.ext)[ifdata->rx_length], buf, run);
+                    ifdata->rx_length += run;
+                    buf += run;
+                    break;
+                }
+
+                uint8_t inputbyte = *buf++;
 
-                    /* Break after the end char */
+                /* Escape char */
+                if (inputbyte == FESC) {
+                    ifdata->rx_mode = KISS_MODE_ESCAPED;
                     break;
                 }
 
-                /* Skip the first char after FEND which is TNC_DATA (0x00) */
-                if (ifdata->rx_first) {
-                    ifdata->rx_first = false;
+                /* End Char, accept message */
+                if (ifdata->rx_length == 0) {
                     break;
                 }
 
-                /* Valid data char */
-                ((char *) &ifdata->rx_packet->id.ext)[ifdata->rx_length++] = inputbyte;
+                /* Check for valid length */
+                if (ifdata->rx_length < CSP_HEADER_LENGTH + sizeof(uint32_t)) {
+                    //csp_log_warn("KISS short frame skipped, len: %u", ifdata->rx_length);
+                    iface->rx_error++;
+                    ifdata->rx_mode = KISS_MODE_NOT_STARTED;
+                    break;
+                }
 
-                break;
+                /* Count received frame */
+                iface->frame++;
 
-            case KISS_MODE_ESCAPED:
+                /* The CSP packet length is without the header */
+                ifdata->rx_packet->length = ifdata->rx_length - CSP_HEADER_LENGTH;
 
-                /* Escaped escape char */
-                if (inputbyte == TFESC)
-                    ((char *) &ifdata->rx_packet->id.ext)[ifdata->rx_length++] = FESC;
+                /* Convert the packet from network to host order */
+                ifdata->rx_packet->id.ext = csp_ntoh32(ifdata->rx_packet->id.ext);
 
-                /* Escaped fend char */
-                if (inputbyte == TFEND)
-                    ((char *) &ifdata->rx_packet->id.ext)[ifdata->rx_length++] = FEND;
+                /* Validate CRC */
+                if (csp_crc32_verify(ifdata->rx_packet, false) != CSP_ERR_NONE) {
+                    //csp_log_warn("KISS invalid crc frame skipped, len: %u", ifdata->rx_packet->length);
+                    iface->rx_error++;
+                    ifdata->rx_mode = KISS_MODE_NOT_STARTED;
+                    break;
+                }
 
-                /* Go back to started mode */
-                ifdata->rx_mode = KISS_MODE_STARTED;
+                /* Send back into CSP, notice calling from task so last argument must be NULL! */
+                csp_qfifo_write(ifdata->rx_packet, iface, pxTaskWoken);
+                ifdata->rx_packet = NULL;
+                ifdata->rx_mode = KISS_MODE_NOT_STARTED;
                 break;
+            }
 
-            case KISS_MODE_SKIP_FRAME:
+            case KISS_MODE_ESCAPED: {
 
-                /* Just wait for end char */
-                if (inputbyte == FEND)
-                    ifdata->rx_mode = KISS_MODE_NOT_STARTED;
+                uint8_t inputbyte = *buf++;
 
+                /* Go back to started mode */
+                ifdata->rx_mode = KISS_MODE_STARTED;
+
+                /* Escaped escape char */
+                if (inputbyte == TFESC) {
+                    csp_kiss_rx_put(iface, ifdata, FESC);
+                }
+
+                /* Escaped fend char */
+                if (inputbyte == TFEND) {
+                    csp_kiss_rx_put(iface, ifdata, FEND);
+                }
                 break;
+            }
         }
     }
 }
@@ -230,11 +312,21 @@ int csp_kiss_add_interface(csp_iface_t * iface) {
         return CSP_ERR_INVAL;
     }
 
+    ifdata->max_rx_length = CSP_HEADER_LENGTH + csp_buffer_data_size(); // CSP header + CSP data
+
+    /* Worst case every byte is escaped, plus FEND, TNC_DATA and FEND */
+    ifdata->tx_buf_size = (2 * ifdata->max_rx_length) + 3;
+    ifdata->tx_buf = csp_malloc(ifdata->tx_buf_size);
+    if (ifdata->tx_buf == NULL) {
+        return CSP_ERR_NOMEM;
+    }
+
     if (csp_mutex_create(&ifdata->lock) != CSP_MUTEX_OK) {
+        csp_free(ifdata->tx_buf);
+        ifdata->tx_buf = NULL;
         return CSP_ERR_NOMEM;
     }
 
-    ifdata->max_rx_length = CSP_HEADER_LENGTH + csp_buffer_data_size(); // CSP header + CSP data
     ifdata->rx_length = 0;
     ifdata->rx_mode = KISS_MODE_NOT_STARTED;
     ifdata->rx_first = false;
@@ -21,6 +21,9 @@
  */
 /*********************************************************************/
 #ifdef BACKDOOR_SOCK_ENB
+#if defined(LINUX_TEMP_PORT) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE		/* recvmmsg() and sendmmsg() */
+#endif
 #include <csp/interfaces/csp_if_sludp.h>
 
 #include <stdint.h>
@@ -34,6 +37,7 @@
 #ifdef LINUX_TEMP_PORT
 #include <sys/socket.h>
 #include <sys/ioctl.h>
+#include <sys/uio.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
 #include <net/if.h>
@@ -49,11 +53,61 @@
 #include <csp/csp_interface.h>
 #include <csp/arch/csp_malloc.h>
 #include <csp/arch/csp_thread.h>
+#include <csp/arch/csp_semaphore.h>
 #include "exo_osal_thread.h"
 
 /* MTU of the SLUDP interface */
 #define CSP_IF_SLUDP_MTU     1400
 
+/** Datagrams moved per recvmmsg()/sendmmsg() call */
+#ifndef CSP_SLUDP_BATCH
+#define CSP_SLUDP_BATCH      16
+#endif
+
+/** Rx sockets bound to the port with SO_REUSEPORT, each one is served by its own thread */
+#ifndef CSP_SLUDP_RX_SOCKETS
+#define CSP_SLUDP_RX_SOCKETS 1
+#endif
+
+#if (CSP_SLUDP_RX_SOCKETS > 1) && !defined(SO_REUSEPORT)
+#error "CSP_SLUDP_RX_SOCKETS > 1 needs SO_REUSEPORT"
+#endif
+
+#ifdef LINUX_TEMP_PORT
+typedef struct mmsghdr sludp_mmsghdr_t;
+
+#define sludp_recvmmsg(fd, msgvec, vlen, flags)     recvmmsg(fd, msgvec, vlen, flags, NULL)
+#define sludp_sendmmsg(fd, msgvec, vlen, flags)     sendmmsg(fd, msgvec, vlen, flags)
+#else
+/* lwIP has no mmsg calls, the batch helpers move one datagram per call */
+typedef struct {
+    struct msghdr msg_hdr;
+    unsigned int msg_len;
+} sludp_mmsghdr_t;
+
+#ifndef MSG_WAITFORONE
+#define MSG_WAITFORONE       0
+#endif
+
+static int sludp_recvmmsg(int fd, sludp_mmsghdr_t *msgvec, unsigned int vlen, int flags)
+{
+    int res = recvmsg(fd, &msgvec[0].msg_hdr, flags);
+    if (res < 0)
+        return res;
+    msgvec[0].msg_len = res;
+    return 1;
+}
+
+static int sludp_sendmmsg(int fd, sludp_mmsghdr_t *msgvec, unsigned int vlen, int flags)
+{
+    int res = sendmsg(fd, &msgvec[0].msg_hdr, flags);
+    if (res < 0)
+        return res;
+    msgvec[0].msg_len = res;
+    return 1;
+}
+#endif
+
 uint32_t sl_udp_port =0;
 uint32_t sl_udp_addr =0;
 FILE *sl_udp_inf;
@@ -61,6 +115,26 @@ s_obc_sock_info sludp_tctm_soc_inf;
 
 struct csp_sludp_ifdata sludp_data;
 
+/**
+ * Rx state of one socket. The CSP id lands in id[] and the payload directly
+ * in the data of a preallocated CSP buffer.
+ */
+struct csp_sludp_rx_ctx {
+    int socket;
+    uint32_t id[CSP_SLUDP_BATCH];
+    csp_packet_t *packet[CSP_SLUDP_BATCH];
+    struct sockaddr_in src[CSP_SLUDP_BATCH];
+    struct iovec iov[CSP_SLUDP_BATCH][2];
+    sludp_mmsghdr_t msg[CSP_SLUDP_BATCH];
+};
+
+/** Packet waiting in the Tx queue */
+struct csp_sludp_tx_entry {
+    uint32_t id;
+    csp_packet_t *packet;
+    struct sockaddr_in dest;
+};
+
 struct csp_sludp_ifdata {
     char ifname[CSP_IFLIST_NAME_MAX + 1];
     csp_iface_t iface;
@@ -68,6 +142,13 @@ struct csp_sludp_ifdata {
     int dest_socket;
     struct sockaddr_in dest_addr;
     pthread_t rx_thread;
+
+    struct csp_sludp_rx_ctx rx[CSP_SLUDP_RX_SOCKETS];
+
+    csp_mutex_t tx_lock;
+    bool tx_flushing;
+    unsigned int tx_count;
+    struct csp_sludp_tx_entry tx_queue[CSP_SLUDP_BATCH];
 };
 
 struct sockaddr_in si_udp;
@@ -75,79 +156,164 @@ int slen_udp = sizeof(struct sockaddr_in);
 
 static void csp_sludp_rx(void *arg)
 {
-    struct csp_sludp_ifdata *data = &sludp_data;
+    struct csp_sludp_rx_ctx *rx = ((os_thread_handle_ptr)arg)->app_entry_args;
 
-    int nbytes;
-    uint32_t id;
-    uint16_t length;
-    csp_packet_t *packet;
+    const size_t data_size = (csp_buffer_data_size() < CSP_IF_SLUDP_MTU) ? csp_buffer_data_size() : CSP_IF_SLUDP_MTU;
+    unsigned int ready;
+    int count;
+    int i;
 
-    uint8_t frame[sizeof(id) + CSP_IF_SLUDP_MTU];
     while (1) {
-        /* Wait for frames */
-        nbytes = recvfrom(data->dest_socket, frame, sizeof(frame), 0, (struct sockaddr *)&si_udp,(socklen_t*)&slen_udp);
+        /* Refill the slots, they stay in order so the batch is the first 'ready' ones */
+        for (ready = 0; ready < CSP_SLUDP_BATCH; ready++) {
+            if (!rx->packet[ready]) {
+                rx->packet[ready] = csp_buffer_get(data_size);
+                if (!rx->packet[ready])
+                    break;
+            }
+            rx->iov[ready][0].iov_base = &rx->id[ready];
+            rx->iov[ready][0].iov_len = sizeof(rx->id[ready]);
+            rx->iov[ready][1].iov_base = rx->packet[ready]->data;
+            rx->iov[ready][1].iov_len = data_size;
+            memset(&rx->msg[ready], 0, sizeof(rx->msg[ready]));
+            rx->msg[ready].msg_hdr.msg_name = &rx->src[ready];
+            rx->msg[ready].msg_hdr.msg_namelen = sizeof(rx->src[ready]);
+            rx->msg[ready].msg_hdr.msg_iov = rx->iov[ready];
+            rx->msg[ready].msg_hdr.msg_iovlen = 2;
+        }
+
+        /* Out of buffers, let the kernel queue the frames meanwhile */
+        if (ready == 0) {
+            csp_sleep_ms(10);
+            continue;
+        }
 
+        /* Wait for frames, then take whatever else is already queued */
+        count = sludp_recvmmsg(rx->socket, rx->msg, ready, MSG_WAITFORONE);
+        if (count < 0) {
+            if (errno != EINTR)
+                csp_sleep_ms(10);
+            continue;
+        }
+
+        for (i = 0; i < count; i++) {
+            csp_packet_t *packet = rx->packet[i];
+            unsigned int nbytes = rx->msg[i].msg_len;
 
 #if (CSP_DEBUG)
-        DEBUG_CPRINT(("\n\r[SLUDP] Received packet %d from %s:%d\n",nbytes, inet_ntoa(si_udp.sin_addr), ntohs(si_udp.sin_port)));
+            DEBUG_CPRINT(("\n\r[SLUDP] BACKDOOR Received packet %u from %s:%d\n",nbytes, inet_ntoa(rx->src[i].sin_addr), ntohs(rx->src[i].sin_port)));
 #endif
 
-        DEBUG_CPRINT(("\n\r[SLUDP] BACKDOOR Received packet %d from %s:%d\n",nbytes, inet_ntoa(si_udp.sin_addr), ntohs(si_udp.sin_port)));
+            /* Drop runts and frames that did not fit in a CSP buffer */
+            if ((nbytes < sizeof(rx->id[i])) || (rx->msg[i].msg_hdr.msg_flags & MSG_TRUNC))
+                continue;
 
-        if (nbytes < 0 || (unsigned int)nbytes < sizeof(id))
-            continue;
+            /* Replies go to the last peer */
+            si_udp = rx->src[i];
 
-        /* Extract CSP length */
-        length = nbytes - sizeof(id);
+            /* Extract CSP length and set packet ID */
+            packet->length = nbytes - sizeof(rx->id[i]);
+            packet->id.ext = csp_ntoh32(rx->id[i]);
 
-        /* Allocate buffer for frame */
-        packet = csp_buffer_get(length);
-        if (!packet)
-            continue;
-        packet->length = length;
+            /* Pass frame to CSP stack, the slot must be emptied if the packet is handed over */
+            //csp_qfifo_write(packet, &sludp_data.iface, NULL);
+            //rx->packet[i] = NULL;
+            /*Control variable - Increments on every packer received in csp-sludp*/
+            comms_back_door_data_receive(packet->data, packet->length);
+        }
+    }
 
-        /* Set packet ID */
-        memcpy(&id, &frame[0], sizeof(id));
-        packet->id.ext = csp_ntoh32(id);
+}
 
-        /* Copy received data into CSP buffer */
-        memcpy(packet->data, &frame[sizeof(id)], packet->length);
+/**
+ * Send the queued packets and free them, failed datagrams are counted as Tx errors.
+ * Called without tx_lock held, the entries belong to the caller.
+ */
+static void csp_sludp_tx_flush(struct csp_sludp_ifdata *data, struct csp_sludp_tx_entry *entry, unsigned int count)
+{
+    struct iovec iov[CSP_SLUDP_BATCH][2];
+    sludp_mmsghdr_t msg[CSP_SLUDP_BATCH];
+    unsigned int sent = 0;
+    unsigned int i;
+    int res;
+
+    memset(msg, 0, count * sizeof(msg[0]));
+    for (i = 0; i < count; i++) {
+        iov[i][0].iov_base = &entry[i].id;
+        iov[i][0].iov_len = sizeof(entry[i].id);
+        iov[i][1].iov_base = entry[i].packet->data;
+        iov[i][1].iov_len = entry[i].packet->length;
+        msg[i].msg_hdr.msg_name = &entry[i].dest;
+        msg[i].msg_hdr.msg_namelen = sizeof(entry[i].dest);
+        msg[i].msg_hdr.msg_iov = iov[i];
+        msg[i].msg_hdr.msg_iovlen = 2;
+    }
 
-        /* Pass frame to CSP stack */
-        //csp_qfifo_write(packet, &data->iface, NULL);
-        /*Control variable - Increments on every packer received in csp-sludp*/
-        comms_back_door_data_receive(packet->data, packet->length);
-        csp_buffer_free(packet);
+    while (sent < count) {
+        res = sludp_sendmmsg(data->dest_socket, &msg[sent], count - sent, 0);
+        if (res > 0) {
+            sent += res;
+            continue;
+        }
+        if ((res < 0) && (errno == EINTR))
+            continue;
+        break;
     }
 
+    for (i = 0; i < count; i++) {
+        if ((i >= sent) || (msg[i].msg_len != sizeof(entry[i].id) + entry[i].packet->length))
+            data->iface.tx_error++;
+        csp_buffer_free(entry[i].packet);
+    }
 }
 
+/**
+ * Queue the packet for transmission. The first sender finding the queue idle
+ * flushes it, packets queued meanwhile by other threads leave in the same
+ * sendmmsg() call, so a lone sender is not delayed.
+ */
 static int csp_sludp_tx(const csp_route_t *route, csp_packet_t *packet)
 {
     struct csp_sludp_ifdata *data = (struct csp_sludp_ifdata*)route->iface->driver_data;
+    struct csp_sludp_tx_entry batch[CSP_SLUDP_BATCH];
+    unsigned int count;
 
-    int nbytes;
-    uint32_t id;
-    uint16_t size = 0, length = 0;
-    size=size;
-    length=length;
-    struct sockaddr_in dest = si_udp;
+    if (csp_mutex_lock(&data->tx_lock, CSP_MAX_DELAY) != CSP_MUTEX_OK)
+        return CSP_ERR_TIMEDOUT;
 
-    uint8_t frame[sizeof(id) + CSP_IF_SLUDP_MTU];
-    id = csp_hton32(packet->id.ext);
+    /* Queue is full, the flushing thread is behind, send this one on its own */
+    if (data->tx_count == CSP_SLUDP_BATCH) {
+        csp_mutex_unlock(&data->tx_lock);
+        batch[0].id = csp_hton32(packet->id.ext);
+        batch[0].packet = packet;
+        batch[0].dest = si_udp;
+        csp_sludp_tx_flush(data, batch, 1);
+        return CSP_ERR_NONE;
+    }
 
-    memcpy(&frame[length], &id, sizeof(id));
-    length += sizeof(id);
-    memcpy(&frame[length], packet->data, packet->length);
-    length += packet->length;
+    data->tx_queue[data->tx_count].id = csp_hton32(packet->id.ext);
+    data->tx_queue[data->tx_count].packet = packet;
+    data->tx_queue[data->tx_count].dest = si_udp;
+    data->tx_count++;
 
-    /* Send message */
-    nbytes = sendto(data->dest_socket, frame, length, 0,(struct sockaddr *) &dest, sizeof(dest));
+    if (data->tx_flushing) {
+        csp_mutex_unlock(&data->tx_lock);
+        return CSP_ERR_NONE;
+    }
 
-    if (nbytes != (int)length)
-        return CSP_ERR_TIMEDOUT;
+    data->tx_flushing = true;
+    while (data->tx_count) {
+        count = data->tx_count;
+        memcpy(batch, data->tx_queue, count * sizeof(batch[0]));
+        data->tx_count = 0;
+        csp_mutex_unlock(&data->tx_lock);
 
-    csp_buffer_free(packet);
+        csp_sludp_tx_flush(data, batch, count);
+
+        csp_mutex_lock(&data->tx_lock, CSP_MAX_DELAY);
+    }
+    data->tx_flushing = false;
+    csp_mutex_unlock(&data->tx_lock);
 
     return CSP_ERR_NONE;
 }
@@ -155,6 +321,7 @@ static int csp_sludp_tx(const csp_route_t *route, csp_packet_t *packet)
 int csp_sludp_init(const char *device, const char *ifname, csp_iface_t **ifc)
 {
     int ret;
+    int i;
     struct sockaddr_in sa;
 
 #ifndef LINUX_TEMP_PORT
@@ -175,12 +342,8 @@ int csp_sludp_init(const char *device, const char *ifname, csp_iface_t **ifc)
     data->iface.nexthop = csp_sludp_tx;
     data->iface.mtu = CSP_IF_SLUDP_MTU + 20;
 
-    /* Create socket */
-    data->dest_socket = socket(AF_INET, SOCK_DGRAM, 0);
-    if (data->dest_socket < 0) {
-        csp_log_error("failed to allocate UDP socket\n");
-        return CSP_ERR_DRIVER;
-    }
+    if (csp_mutex_create(&data->tx_lock) != CSP_MUTEX_OK)
+        return CSP_ERR_NOMEM;
 
 #ifdef LINUX_TEMP_PORT
 
@@ -219,20 +382,49 @@ int csp_sludp_init(const char *device, const char *ifname, csp_iface_t **ifc)
     sa.sin_addr.s_addr = sl_udp_addr;
     sa.sin_port = htons(sl_udp_port);
 
-    ret = bind(data->dest_socket, (const struct sockaddr *)&sa, sizeof(struct sockaddr_in));
-    if (ret < 0) {
-        csp_log_error("failed to bind receive socket\n");
-        return CSP_ERR_DRIVER;
+    for (i = 0; i < CSP_SLUDP_RX_SOCKETS; i++) {
+        /* Create socket */
+        data->rx[i].socket = socket(AF_INET, SOCK_DGRAM, 0);
+        if (data->rx[i].socket < 0) {
+            csp_log_error("failed to allocate UDP socket\n");
+            return CSP_ERR_DRIVER;
+        }
+
+#if (CSP_SLUDP_RX_SOCKETS > 1)
+        /* The kernel spreads the peers over the sockets sharing the port */
+        int reuse = 1;
+        if (setsockopt(data->rx[i].socket, SOL_SOCKET, SO_REUSEPORT, &reuse, sizeof(reuse)) < 0) {
+            csp_log_error("failed to set SO_REUSEPORT\n");
+            return CSP_ERR_DRIVER;
+        }
+#endif
+
+        ret = bind(data->rx[i].socket, (const struct sockaddr *)&sa, sizeof(struct sockaddr_in));
+        if (ret < 0) {
+            csp_log_error("failed to bind receive socket\n");
+            return CSP_ERR_DRIVER;
+        }
     }
 
-    /* Start receiver thread */
-    ret = os_thread_create(CSP_ETH_RX, T_STACK_5K, P_CSP_INTF_ETH_RX,"CSP Ethernet RX",csp_sludp_rx, data,NULL,NULL);
+    /* Frames are sent from the first socket */
+    data->dest_socket = data->rx[0].socket;
+
+    /* Start receiver threads */
+    ret = os_thread_create(CSP_ETH_RX, T_STACK_5K, P_CSP_INTF_ETH_RX,"CSP Ethernet RX",csp_sludp_rx, &data->rx[0],NULL,NULL);
 
     if (ret < 0) {
         csp_log_error("failed to start receive thread\n");
         return CSP_ERR_DRIVER;
     }
 
+    for (i = 1; i < CSP_SLUDP_RX_SOCKETS; i++) {
+        csp_thread_handle_t handle;
+        if (csp_thread_create((csp_thread_func_t)csp_sludp_rx, "CSP Ethernet RX", T_STACK_5K / 4, &data->rx[i], P_CSP_INTF_ETH_RX, &handle) != CSP_ERR_NONE) {
+            csp_log_error("failed to start receive thread\n");
+            return CSP_ERR_DRIVER;
+        }
+    }
+
     /* Register interface */
     csp_iflist_add(&data->iface);
 
@@ -29,9 +29,7 @@
 #include"comms_uhf_csp.h"
 #include"comms_uhf_rf_cfg.h"
 #include"csp_if_uhf.h"
-
-uint8_t uhf_packet_length = 0;
-extern uint8_t uhf_rx_cmd_buff[UHF_MAX_PAYLOAD+1];
+#include <string.h>
 
 int csp_uhf_tx(const csp_route_t * ifroute, csp_packet_t * packet)
 {
@@ -78,145 +76,164 @@ int csp_uhf_tx(const csp_route_t * ifroute, csp_packet_t * packet)
     return CSP_ERR_NONE;
 }
 
-uint8_t frame[CSP_IF_SLTCP_UHF_MTU] = {0};
-
 /**
- * Decode received data and eventually route the packet.
+ * @brief Reset a UHF frame parser
  */
-void csp_uhf_rx(csp_iface_t * iface, const uint8_t * buf, size_t len, void * pxTaskWoken)
+void csp_uhf_parser_init(csp_uhf_parser_t * parser)
 {
-    csp_kiss_interface_data_t * ifdata = iface->interface_data;
-
-
-    DEBUG_CPRINT(("\n\rUHF RX mode: %d, \n",ifdata->rx_mode));
-
-    while (len--) {
-
-        /* Input */
-        DEBUG_CPRINT((" %x",*buf));
-        //DEBUG_CPRINT(("\n\rUHF RX mode: %d, Data: %x\n",ifdata->rx_mode,*buf));
-        uint8_t inputbyte = *buf++;
-
-        /* If packet was too long */
-        if (ifdata->rx_length > ifdata->max_rx_length) {
-            DEBUG_CPRINT(("UHF UART RX overflow, rx:%d, max_rx:%d",ifdata->rx_length,ifdata->max_rx_length));
-            iface->rx_error++;
-            ifdata->rx_mode = UHF_WAIT_FOR_START0;
-            ifdata->rx_length = 0;
-        }
+    parser->state = UHF_WAIT_FOR_START0;
+    parser->length = 0;
+    parser->fill = 0;
+}
 
-        switch (ifdata->rx_mode) {
+/**
+ * @brief Parse a chunk of received UHF UART data
+ */
+unsigned int csp_uhf_parser_feed(csp_uhf_parser_t * parser, const uint8_t * buf, size_t len,
+                                 csp_uhf_frame_cb_t frame_cb, void * user_data, void * pxTaskWoken)
+{
+    const uint8_t * end = buf + len;
+    const uint8_t * sync;
+    unsigned int errors = 0;
+    size_t count;
 
+    while (buf < end)
+    {
+        switch (parser->state)
+        {
             case UHF_WAIT_FOR_START0:
 
-                /* Skip any characters until End char detected */
-                if (inputbyte == UHF_START_BYTE_0) {
-                    ifdata->rx_mode = UHF_WAIT_FOR_START1;
+                /* Skip any characters until the first sync byte */
+                sync = memchr(buf, UHF_START_BYTE_0, end - buf);
+                if (sync == NULL)
+                {
+                    return errors;
                 }
+                buf = sync + 1;
+                parser->state = UHF_WAIT_FOR_START1;
                 break;
 
             case UHF_WAIT_FOR_START1:
-                {
-                    /* Skip any characters until End char detected */
-                    if (inputbyte == UHF_START_BYTE_1) {
-                        ifdata->rx_mode = UHF_WAIT_FOR_LENGTH;
-                    }
-                    else if(inputbyte == UHF_START_BYTE_0)
-                    {
-                        ifdata->rx_mode = UHF_WAIT_FOR_START1;
-                    }
 
+                if (*buf == UHF_START_BYTE_1)
+                {
+                    parser->state = UHF_WAIT_FOR_LENGTH;
+                }
+                else if (*buf != UHF_START_BYTE_0)
+                {
+                    parser->state = UHF_WAIT_FOR_START0;
                 }
+                buf++;
                 break;
 
             case UHF_WAIT_FOR_LENGTH:
+
+                parser->length = *buf++;
+                if ((parser->length > UHF_MAX_PAYLOAD) || (parser->length < 1))
                 {
-                    if((inputbyte > UHF_MAX_PAYLOAD) || (inputbyte < 1))
-                    {
-                        ifdata->rx_mode = UHF_WAIT_FOR_START1;
-                    }
-                    else
-                    {
-                        /* Try to allocate new buffer */
-                        if (ifdata->rx_packet == NULL) {
-                            ifdata->rx_packet = pxTaskWoken ? csp_buffer_get_isr(0) : csp_buffer_get(0); // CSP only supports one size
-                        }
-
-                        /* If no more memory, skip frame */
-                        if (ifdata->rx_packet == NULL) {
-                            ifdata->rx_mode = UHF_WAIT_FOR_START0;
-                            iface->drop++;
-                            break;
-                        }
-
-                        /* Start transfer */
-                        ifdata->rx_length = 0;
-                        ifdata->rx_mode = UHF_RECEIVE_DATA;
-                        ifdata->rx_first = true;
-                        uhf_packet_length = inputbyte;
-                        DEBUG_CPRINT(("\n\rUHF Packet length: %d",uhf_packet_length));
-
-                    }
+                    errors++;
+                    parser->state = UHF_WAIT_FOR_START0;
+                    break;
                 }
+
+                /* Whole frame in this chunk, hand it out in place */
+                if ((size_t)(end - buf) >= parser->length)
+                {
+                    frame_cb(user_data, buf - 1, pxTaskWoken);
+                    buf += parser->length;
+                    parser->state = UHF_WAIT_FOR_START0;
+                    break;
+                }
+
+                /* Split frame, collect it */
+                parser->frame[0] = parser->length;
+                parser->fill = 0;
+                parser->state = UHF_RECEIVE_DATA;
                 break;
 
             case UHF_RECEIVE_DATA:
 
-                /* Valid data char */
-                //((char *) &ifdata->rx_packet->id.ext)[ifdata->rx_length++] = inputbyte;
-                frame[ifdata->rx_length++] = inputbyte;
-
-                /* Accept message */
-                if ((ifdata->rx_length > 0) && (uhf_packet_length == ifdata->rx_length))
+                count = parser->length - parser->fill;
+                if (count > (size_t)(end - buf))
                 {
-                    /* Count received frame */
-                    iface->frame++;
-
-                    s_comms_uhf_uart_header *uhf_data = (s_comms_uhf_uart_header *)frame;
-
-                    if(((0xFFFF == uhf_data->hwid)||(0x1 == uhf_data->hwid) || (0x0 == uhf_data->hwid)) \
-                            &&(1 == uhf_data->system))
-                    {
-                        os_memcpy(uhf_rx_cmd_buff,&uhf_packet_length,sizeof(uhf_packet_length));
+                    count = end - buf;
+                }
+                memcpy(&parser->frame[1 + parser->fill], buf, count);
+                parser->fill += count;
+                buf += count;
 
-                        os_memcpy(&uhf_rx_cmd_buff[1],frame,uhf_packet_length);
+                if (parser->fill == parser->length)
+                {
+                    frame_cb(user_data, parser->frame, pxTaskWoken);
+                    parser->state = UHF_WAIT_FOR_START0;
+                }
+                break;
+        }
+    }
+    return errors;
+}
 
-                        uhf_packet_length += sizeof(uhf_packet_length);
+/**
+ * @brief Dispatch a complete UHF UART frame
+ *
+ * Command responses go to the UHF controller, everything else is a CSP packet.
+ * The frame starts with its length byte, which is the layout both consumers expect.
+ */
+static void csp_uhf_frame_rx(void * user_data, const uint8_t * frame, void * pxTaskWoken)
+{
+    csp_iface_t * iface = user_data;
+    const uint8_t length = frame[0];
+    s_comms_uhf_uart_header uhf_data;
+    csp_packet_t * packet;
 
-                        uhf_send_rx_uart_cmd(uhf_rx_cmd_buff,uhf_packet_length);
+    if (length < sizeof(uhf_data))
+    {
+        iface->rx_error++;
+        return;
+    }
 
-                        /* Free data */
-                        csp_buffer_free(ifdata->rx_packet);
-                    }
-                    else
-                    {
-                        /* The CSP packet length is without the header */
-                       // ifdata->rx_packet->length = ifdata->rx_length - UHF_HEADER_SIZE - CSP_HEADER_LENGTH;
+    /* Count received frame */
+    iface->frame++;
 
-                        os_memcpy(uhf_rx_cmd_buff,&uhf_packet_length,sizeof(uhf_packet_length));
-                        os_memcpy(&uhf_rx_cmd_buff[1],frame,uhf_packet_length);
-                        uhf_unpack_uart_frame(ifdata->rx_packet, uhf_rx_cmd_buff);
+    memcpy(&uhf_data, &frame[1], sizeof(uhf_data));
+    if(((0xFFFF == uhf_data.hwid)||(0x1 == uhf_data.hwid) || (0x0 == uhf_data.hwid)) \
+            &&(1 == uhf_data.system))
+    {
+        /* The IPC layer copies the frame */
+        uhf_send_rx_uart_cmd((uint8_t *)frame, length + 1);
+        return;
+    }
 
-                        /* Convert the packet from network to host order */
-                        //ifdata->rx_packet->id.ext = csp_ntoh32(ifdata->rx_packet->id.ext);
+    /* Data frames carry at least the CSP header */
+    if (length <= (UHF_HEADER_SIZE + CSP_HEADER_LENGTH))
+    {
+        iface->rx_error++;
+        return;
+    }
 
-                        uhf_packet_length = 0;
+    packet = pxTaskWoken ? csp_buffer_get_isr(0) : csp_buffer_get(0); // CSP only supports one size
+    if (packet == NULL)
+    {
+        iface->drop++;
+        return;
+    }
 
-                        /* Send back into CSP, notice calling from task so last argument must be NULL! */
-                        csp_qfifo_write(ifdata->rx_packet, iface, pxTaskWoken);
-                    }
+    uhf_unpack_uart_frame(packet, (uint8_t *)frame);
 
-                    ifdata->rx_packet = NULL;
-                    ifdata->rx_length = 0;
-                    ifdata->rx_mode = UHF_WAIT_FOR_START0;
-                    os_memset(frame,0,sizeof(frame));
-                    break;
+    /* Send back into CSP, notice calling from task so last argument must be NULL! */
+    csp_qfifo_write(packet, iface, pxTaskWoken);
+}
 
-                }
-                break;
+void csp_uhf_rx(csp_iface_t * iface, const uint8_t * buf, size_t len, void * pxTaskWoken)
+{
+    csp_kiss_interface_data_t * ifdata = iface->interface_data;
 
-        }
+    /* Single radio setups may leave the parser out */
+    static csp_uhf_parser_t uhf_default_parser;
+    csp_uhf_parser_t * parser = ifdata->uhf_parser ? ifdata->uhf_parser : &uhf_default_parser;
 
-    }
+    DEBUG_CPRINT(("\n\rUHF RX state: %d, len: %u\n",parser->state,(unsigned int)len));
 
+    iface->rx_error += csp_uhf_parser_feed(parser, buf, len, csp_uhf_frame_rx, iface, pxTaskWoken);
 }
+
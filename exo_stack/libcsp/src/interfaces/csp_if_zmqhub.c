@@ -24,15 +24,22 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 
 #include <zmq.h>
 #include <assert.h>
+#include <errno.h>
 
 #include <csp/csp.h>
 #include <csp/csp_debug.h>
 #include <csp/arch/csp_thread.h>
 #include <csp/arch/csp_malloc.h>
 #include <csp/arch/csp_semaphore.h>
+#include "exo_osal.h"
 
 #define CSP_ZMQ_MTU   1024   // max payload data, see documentation
 
+/** Messages drained per wakeup in event mode, before polling again */
+#ifndef CSP_ZMQ_RX_BATCH
+#define CSP_ZMQ_RX_BATCH	64
+#endif
+
 /* ZMQ driver & interface */
 typedef struct {
 	csp_thread_handle_t rx_thread;
@@ -42,8 +49,29 @@ typedef struct {
 	csp_bin_sem_handle_t tx_wait;
 	char name[CSP_IFLIST_NAME_MAX + 1];
 	csp_iface_t iface;
+	uint32_t flags;
 } zmq_driver_t;
 
+/* Shared by all interfaces, inproc:// endpoints only connect sockets of the same context */
+static void * csp_zmqhub_ctx;
+
+void * csp_zmqhub_context(void) {
+
+	if (csp_zmqhub_ctx == NULL) {
+		csp_zmqhub_ctx = zmq_ctx_new();
+	}
+	return csp_zmqhub_ctx;
+
+}
+
+/* Called by ZMQ when a zero-copy message has been sent, hint is the CSP packet holding the data */
+static void csp_zmqhub_free(void * data, void * hint) {
+
+	(void)data;
+	csp_buffer_free(hint);
+
+}
+
 /**
  * Interface transmit function
  * @param packet Packet to transmit
@@ -58,6 +86,25 @@ int csp_zmqhub_tx(const csp_route_t * route, csp_packet_t * packet) {
 	uint16_t length = packet->length;
 	uint8_t * destptr = ((uint8_t *) &packet->id) - sizeof(dest);
 	memcpy(destptr, &dest, sizeof(dest));
+
+	if (drv->flags & CSP_ZMQHUB_FLAG_EVENT) {
+		/* Zero-copy, ZMQ owns the packet until csp_zmqhub_free() is called */
+		zmq_msg_t msg;
+		if (zmq_msg_init_data(&msg, destptr, length + sizeof(packet->id) + sizeof(dest), csp_zmqhub_free, packet) != 0) {
+			csp_log_error("ZMQ msg init error: %s\r\n", zmq_strerror(zmq_errno()));
+			csp_buffer_free(packet);
+			return CSP_ERR_NONE;
+		}
+		csp_bin_sem_wait(&drv->tx_wait, 1000); /* Using ZMQ in thread safe manner*/
+		int result = zmq_msg_send(&msg, drv->publisher, ZMQ_DONTWAIT);
+		csp_bin_sem_post(&drv->tx_wait); /* Release tx semaphore */
+		if (result < 0) {
+			csp_log_error("ZMQ send error: %u %s\r\n", result, zmq_strerror(zmq_errno()));
+			zmq_msg_close(&msg);
+		}
+		return CSP_ERR_NONE;
+	}
+
 	csp_bin_sem_wait(&drv->tx_wait, 1000); /* Using ZMQ in thread safe manner*/
 	int result = zmq_send(drv->publisher, destptr, length + sizeof(packet->id) + sizeof(dest), 0);
 	csp_bin_sem_post(&drv->tx_wait); /* Release tx semaphore */
@@ -73,7 +120,8 @@ int csp_zmqhub_tx(const csp_route_t * route, csp_packet_t * packet) {
 
 CSP_DEFINE_TASK(csp_zmqhub_task) {
 
-	zmq_driver_t * drv = param;
+	/* The OSAL passes its thread handle, the driver is the entry argument */
+	zmq_driver_t * drv = ((os_thread_handle_ptr)param)->app_entry_args;
 	csp_packet_t * packet;
 	const uint32_t HEADER_SIZE = (sizeof(packet->id) + sizeof(uint8_t));
 
@@ -125,6 +173,65 @@ CSP_DEFINE_TASK(csp_zmqhub_task) {
 
 }
 
+/* Event mode Rx: wait for the socket to become readable, then drain it without blocking */
+CSP_DEFINE_TASK(csp_zmqhub_event_task) {
+
+	/* The OSAL passes its thread handle, the driver is the entry argument */
+	zmq_driver_t * drv = ((os_thread_handle_ptr)param)->app_entry_args;
+	csp_packet_t * packet = NULL;
+	const int HEADER_SIZE = (sizeof(packet->id) + sizeof(uint8_t));
+	const int max_len = csp_buffer_data_size() + HEADER_SIZE;
+	zmq_pollitem_t item = {.socket = drv->subscriber, .events = ZMQ_POLLIN};
+
+	while(1) {
+		if (zmq_poll(&item, 1, -1) < 0) {
+			if (zmq_errno() != EINTR) {
+				csp_log_error("RX %s: %s", drv->iface.name, zmq_strerror(zmq_errno()));
+			}
+			continue;
+		}
+
+		for (unsigned int i = 0; i < CSP_ZMQ_RX_BATCH; i++) {
+			if (packet == NULL) {
+				packet = csp_buffer_get(csp_buffer_data_size());
+			}
+			if (packet == NULL) {
+				/* Out of buffers, drop the message */
+				zmq_msg_t msg;
+				zmq_msg_init(&msg);
+				const int res = zmq_msg_recv(&msg, drv->subscriber, ZMQ_DONTWAIT);
+				zmq_msg_close(&msg);
+				if (res < 0) {
+					break;
+				}
+				csp_log_warn("RX %s: Failed to get csp_buffer(%u)", drv->iface.name, res);
+				continue;
+			}
+
+			/* Receive straight into the packet, the "via" address lands in the padding before the CSP header */
+			const int datalen = zmq_recv(drv->subscriber, ((uint8_t *) &packet->id) - sizeof(uint8_t), max_len, ZMQ_DONTWAIT);
+			if (datalen < 0) {
+				if (zmq_errno() != EAGAIN) {
+					csp_log_error("RX %s: %s", drv->iface.name, zmq_strerror(zmq_errno()));
+				}
+				break;
+			}
+			if ((datalen < HEADER_SIZE) || (datalen > max_len)) {
+				csp_log_warn("RX %s: Invalid datalen: %d - expected %d - %d bytes", drv->iface.name, datalen, HEADER_SIZE, max_len);
+				continue;
+			}
+
+			// Route packet
+			packet->length = datalen - HEADER_SIZE;
+			csp_qfifo_write(packet, &drv->iface, NULL);
+			packet = NULL;
+		}
+	}
+
+	return CSP_TASK_RETURN;
+
+}
+
 int csp_zmqhub_make_endpoint(const char * host, uint16_t port, char * buf, size_t buf_size) {
     int res = snprintf(buf, buf_size, "tcp://%s:%u", host, port);
     if ((res < 0) || (res >= (int)buf_size)) {
@@ -190,8 +297,9 @@ int csp_zmqhub_init_w_name_endpoints_rxfilter(const char * ifname,
 	drv->iface.driver_data = drv;
 	drv->iface.nexthop = csp_zmqhub_tx;
 	drv->iface.mtu = CSP_ZMQ_MTU; // there is actually no 'max' MTU on ZMQ, but assuming the other end is based on the same code
+	drv->flags = flags;
 
-	drv->context = zmq_ctx_new();
+	drv->context = csp_zmqhub_context();
 	assert(drv->context);
 
 	csp_log_info("INIT %s: pub(tx): [%s], sub(rx): [%s], rx filters: %u",
@@ -223,7 +331,8 @@ int csp_zmqhub_init_w_name_endpoints_rxfilter(const char * ifname,
 	assert(csp_bin_sem_create(&drv->tx_wait) == CSP_SEMAPHORE_OK);
 
 	/* Start RX thread */
-	assert(csp_thread_create(csp_zmqhub_task, drv->iface.name, 20000, drv, 0, &drv->rx_thread) == 0);
+	assert(csp_thread_create((flags & CSP_ZMQHUB_FLAG_EVENT) ? csp_zmqhub_event_task : csp_zmqhub_task,
+				 drv->iface.name, 20000, drv, 0, &drv->rx_thread) == 0);
 
 	/* Register interface */
 	csp_iflist_add(&drv->iface);
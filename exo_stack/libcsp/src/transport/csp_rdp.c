@@ -56,10 +56,53 @@ static uint32_t csp_rdp_packet_timeout = 1000;
 static uint32_t csp_rdp_delayed_acks = 1;
 static uint32_t csp_rdp_ack_timeout = 1000 / 4;
 static uint32_t csp_rdp_ack_delay_count = 4 / 2;
+static uint32_t csp_rdp_ext_opt = 0;
+
+/* Timer wheel resolution in mS, must be a power of two */
+#ifndef CSP_RDP_TIMER_TICK_MS
+#define CSP_RDP_TIMER_TICK_MS	8
+#endif
+
+/* Number of timer wheel slots, must be a power of two */
+#ifndef CSP_RDP_TIMER_SLOTS
+#define CSP_RDP_TIMER_SLOTS	256
+#endif
+
+/* Lower bound for the adaptive retransmission timeout */
+#ifndef CSP_RDP_RTO_MIN_MS
+#define CSP_RDP_RTO_MIN_MS	100
+#endif
+
+/* Lower bound for the auto-tuned window */
+#ifndef CSP_RDP_WINDOW_MIN
+#define CSP_RDP_WINDOW_MIN	2
+#endif
+
+/* Extensions supported by this implementation */
+#define RDP_OPT_SUPPORTED	(CSP_RDP_OPT_AUTO_WINDOW | CSP_RDP_OPT_SACK)
+
+/* Number of 32 bit option words in a SYN, without and with the extension words */
+#define RDP_SYN_OPT_BASIC	6
+#define RDP_SYN_OPT_EXT		8
+
+CSP_STATIC_ASSERT((CSP_RDP_TIMER_TICK_MS & (CSP_RDP_TIMER_TICK_MS - 1)) == 0, rdp_timer_tick_not_power_of_two);
+CSP_STATIC_ASSERT((CSP_RDP_TIMER_SLOTS & (CSP_RDP_TIMER_SLOTS - 1)) == 0, rdp_timer_slots_not_power_of_two);
 
 /* Used for queue calls */
 static CSP_BASE_TYPE pdTrue = 1;
 
+/* Timer wheel shared by all connections, slot lists and cursor are protected by csp_rdp_lock */
+static csp_rdp_timer_t * csp_rdp_wheel[CSP_RDP_TIMER_SLOTS];
+static uint32_t csp_rdp_wheel_time;
+static bool csp_rdp_wheel_started;
+
+/* Lock for the timer wheel and the per connection TX rings */
+static csp_bin_sem_handle_t csp_rdp_lock;
+static bool csp_rdp_lock_created;
+
+/* TX ring size - 1, the ring is rdp_max_window rounded up to a power of two */
+static uint16_t csp_rdp_tx_ring_mask;
+
 /* RDP header - on top of csp_packet_t */
 typedef struct {
 	uint32_t quarantine;	// EACK quarantine period (-> csp_packet_t.padding)
@@ -159,6 +202,319 @@ static inline int csp_rdp_time_after(uint32_t time, uint32_t cmp) {
 	return csp_rdp_time_before(cmp, time);
 }
 
+/**
+ * TIMER WHEEL
+ * Retransmission, delayed ACK and connection timers of all connections are kept
+ * in a hashed timer wheel, so timeout processing only visits timers in the slots
+ * passed since the last call instead of every segment of every connection.
+ * All functions named _locked must be called with csp_rdp_lock held.
+ */
+static inline void csp_rdp_lock_take(void) {
+	csp_bin_sem_wait(&csp_rdp_lock, CSP_MAX_TIMEOUT);
+}
+
+static inline void csp_rdp_lock_give(void) {
+	csp_bin_sem_post(&csp_rdp_lock);
+}
+
+static inline unsigned int csp_rdp_wheel_slot(uint32_t time) {
+	return (time / CSP_RDP_TIMER_TICK_MS) & (CSP_RDP_TIMER_SLOTS - 1);
+}
+
+static void csp_rdp_timer_unlink_locked(csp_rdp_timer_t * timer) {
+
+	if (timer->pprev == NULL) {
+		return;
+	}
+
+	*timer->pprev = timer->next;
+	if (timer->next) {
+		timer->next->pprev = timer->pprev;
+	}
+	timer->next = NULL;
+	timer->pprev = NULL;
+
+}
+
+static void csp_rdp_timer_link_locked(csp_rdp_timer_t ** head, csp_rdp_timer_t * timer) {
+
+	timer->next = *head;
+	if (timer->next) {
+		timer->next->pprev = &timer->next;
+	}
+	timer->pprev = head;
+	*head = timer;
+
+}
+
+static void csp_rdp_timer_arm_locked(csp_rdp_timer_t * timer, uint32_t expires) {
+
+	csp_rdp_timer_unlink_locked(timer);
+
+	if (!csp_rdp_wheel_started) {
+		csp_rdp_wheel_time = csp_get_ms() & ~(uint32_t)(CSP_RDP_TIMER_TICK_MS - 1);
+		csp_rdp_wheel_started = true;
+	}
+
+	/* Timers which are already due go in the slot under the cursor, which is scanned on every pass */
+	uint32_t slot_time = csp_rdp_time_before(expires, csp_rdp_wheel_time) ? csp_rdp_wheel_time : expires;
+
+	timer->expires = expires;
+	csp_rdp_timer_link_locked(&csp_rdp_wheel[csp_rdp_wheel_slot(slot_time)], timer);
+
+}
+
+static void csp_rdp_timer_arm(csp_rdp_timer_t * timer, uint32_t expires) {
+	csp_rdp_lock_take();
+	csp_rdp_timer_arm_locked(timer, expires);
+	csp_rdp_lock_give();
+}
+
+/* Arm timer, unless it is already pending */
+static void csp_rdp_timer_arm_idle(csp_rdp_timer_t * timer, uint32_t expires) {
+	csp_rdp_lock_take();
+	if (timer->pprev == NULL) {
+		csp_rdp_timer_arm_locked(timer, expires);
+	}
+	csp_rdp_lock_give();
+}
+
+static void csp_rdp_timer_cancel(csp_rdp_timer_t * timer) {
+	csp_rdp_lock_take();
+	csp_rdp_timer_unlink_locked(timer);
+	csp_rdp_lock_give();
+}
+
+/**
+ * RETRANSMISSION TIMEOUT
+ * Adaptive RTO from measured round-trip time (RFC 6298). SRTT is kept scaled by 8
+ * and RTTVAR scaled by 4, so the filters can be updated with integer arithmetic.
+ */
+static void csp_rdp_rto_reset(csp_conn_t * conn) {
+	conn->rdp.srtt = 0;
+	conn->rdp.rttvar = 0;
+	conn->rdp.rto = conn->rdp.packet_timeout;
+}
+
+static uint32_t csp_rdp_rto_clamp(csp_conn_t * conn, uint32_t rto) {
+
+	const uint32_t rto_min = (conn->rdp.packet_timeout < CSP_RDP_RTO_MIN_MS) ? conn->rdp.packet_timeout : CSP_RDP_RTO_MIN_MS;
+	const uint32_t rto_max = (conn->rdp.conn_timeout > rto_min) ? conn->rdp.conn_timeout : rto_min;
+
+	if (rto < rto_min) {
+		return rto_min;
+	}
+	if (rto > rto_max) {
+		return rto_max;
+	}
+	return rto;
+
+}
+
+static void csp_rdp_rtt_sample(csp_conn_t * conn, uint32_t rtt) {
+
+	if (rtt == 0) {
+		rtt = 1;
+	}
+
+	if ((conn->rdp.rtt_min == 0) || (rtt < conn->rdp.rtt_min)) {
+		conn->rdp.rtt_min = rtt;
+	}
+
+	if (conn->rdp.srtt == 0) {
+		conn->rdp.srtt = rtt << 3;
+		conn->rdp.rttvar = rtt << 1;
+	} else {
+		int32_t err = (int32_t)rtt - (int32_t)(conn->rdp.srtt >> 3);
+		conn->rdp.srtt += err;
+		if (err < 0) {
+			err = -err;
+		}
+		conn->rdp.rttvar += err - (conn->rdp.rttvar >> 2);
+	}
+
+	const uint32_t var = (conn->rdp.rttvar > CSP_RDP_TIMER_TICK_MS) ? conn->rdp.rttvar : CSP_RDP_TIMER_TICK_MS;
+	uint32_t rto = (conn->rdp.srtt >> 3) + var;
+
+	/* With delayed ACKs the receiver may hold the ACK for ack_timeout after the segment arrived */
+	if (conn->rdp.delayed_acks) {
+		rto += conn->rdp.ack_timeout;
+	}
+	conn->rdp.rto = csp_rdp_rto_clamp(conn, rto);
+
+}
+
+/* Smallest auto-tuned window that still fills the delayed ACK count of the receiver */
+static uint32_t csp_rdp_window_floor(csp_conn_t * conn) {
+
+	uint32_t floor = CSP_RDP_WINDOW_MIN;
+	if (conn->rdp.delayed_acks && (conn->rdp.ack_delay_count >= floor)) {
+		floor = conn->rdp.ack_delay_count + 1;
+	}
+	return (floor < conn->rdp.window_max) ? floor : conn->rdp.window_max;
+
+}
+
+static void csp_rdp_rto_backoff(csp_conn_t * conn) {
+
+	conn->rdp.rto = csp_rdp_rto_clamp(conn, conn->rdp.rto * 2);
+
+	/* A timeout of the oldest segment means the path is congested or down, so
+	 * halve the window and the delivery rate estimate it was sized from */
+	if (conn->rdp.options & CSP_RDP_OPT_AUTO_WINDOW) {
+		conn->rdp.tx_window /= 2;
+		if (conn->rdp.tx_window < csp_rdp_window_floor(conn)) {
+			conn->rdp.tx_window = csp_rdp_window_floor(conn);
+		}
+		conn->rdp.dlv_rate /= 2;
+	}
+
+}
+
+/**
+ * WINDOW AUTO-TUNING
+ * With CSP_RDP_OPT_AUTO_WINDOW the TX window is sized to twice the bandwidth-delay
+ * product, estimated as the highest recent delivery rate times the lowest RTT.
+ * While the window is the bottleneck the delivery rate follows the window, so it
+ * doubles every round trip until the link itself limits the rate. Only a timeout
+ * takes the window below the configured window_size.
+ */
+static void csp_rdp_window_reset(csp_conn_t * conn) {
+
+	conn->rdp.window_max = conn->rdp.window_size;
+	conn->rdp.tx_window = conn->rdp.window_size;
+	conn->rdp.rtt_min = 0;
+	conn->rdp.dlv_count = 0;
+	conn->rdp.dlv_rate = 0;
+	conn->rdp.dlv_timestamp = csp_get_ms();
+
+}
+
+static void csp_rdp_window_update(csp_conn_t * conn, uint32_t delivered, uint32_t time_now) {
+
+	if (!(conn->rdp.options & CSP_RDP_OPT_AUTO_WINDOW) || (delivered == 0)) {
+		return;
+	}
+
+	/* Take one delivery rate sample per round trip */
+	conn->rdp.dlv_count += delivered;
+	const uint32_t elapsed = time_now - conn->rdp.dlv_timestamp;
+	if ((conn->rdp.rtt_min == 0) || (elapsed == 0) || (elapsed < (conn->rdp.srtt >> 3))) {
+		return;
+	}
+
+	/* Max filter with decay, so the estimate follows a drop in link capacity */
+	const uint32_t rate = (conn->rdp.dlv_count << 8) / elapsed;
+	if (rate >= conn->rdp.dlv_rate) {
+		conn->rdp.dlv_rate = rate;
+	} else {
+		conn->rdp.dlv_rate -= conn->rdp.dlv_rate >> 3;
+	}
+	conn->rdp.dlv_count = 0;
+	conn->rdp.dlv_timestamp = time_now;
+
+	uint32_t window = ((conn->rdp.dlv_rate * conn->rdp.rtt_min + 255) >> 8) * 2;
+	if (window < conn->rdp.window_size) {
+		window = conn->rdp.window_size;
+	}
+	if (window > conn->rdp.window_max) {
+		window = conn->rdp.window_max;
+	}
+	if (window != conn->rdp.tx_window) {
+		csp_log_protocol("RDP %p: TX window %"PRIu32" -> %"PRIu32" (rate %"PRIu32"/256 per mS, rtt min %"PRIu32")",
+			conn, conn->rdp.tx_window, window, conn->rdp.dlv_rate, conn->rdp.rtt_min);
+		conn->rdp.tx_window = window;
+	}
+
+}
+
+/**
+ * TX RING
+ * Unacknowledged segments are stored in a ring indexed by sequence number, with
+ * a retransmission timer per slot.
+ */
+static int csp_rdp_tx_add(csp_conn_t * conn, rdp_packet_t * packet, uint16_t seq_nr) {
+
+	const unsigned int slot = seq_nr & csp_rdp_tx_ring_mask;
+	int ret = CSP_ERR_NONE;
+
+	csp_rdp_lock_take();
+	if (conn->rdp.tx_ring[slot] != NULL) {
+		ret = CSP_ERR_NOBUFS;
+	} else {
+		csp_rdp_timer_t * timer = &conn->rdp.tx_timer[slot];
+		conn->rdp.tx_ring[slot] = (csp_packet_t *) packet;
+		timer->seq_nr = seq_nr;
+		timer->retries = 0;
+		csp_rdp_timer_arm_locked(timer, packet->timestamp + conn->rdp.rto);
+	}
+	csp_rdp_lock_give();
+
+	return ret;
+
+}
+
+static rdp_packet_t * csp_rdp_tx_take_locked(csp_conn_t * conn, uint16_t seq_nr) {
+
+	const unsigned int slot = seq_nr & csp_rdp_tx_ring_mask;
+	csp_rdp_timer_t * timer = &conn->rdp.tx_timer[slot];
+	rdp_packet_t * packet = (rdp_packet_t *) conn->rdp.tx_ring[slot];
+
+	if ((packet == NULL) || (timer->seq_nr != seq_nr)) {
+		return NULL;
+	}
+
+	csp_rdp_timer_unlink_locked(timer);
+	conn->rdp.tx_ring[slot] = NULL;
+	return packet;
+
+}
+
+static inline bool csp_rdp_is_conn_ready_for_tx(csp_conn_t * conn);
+
+/**
+ * Cumulative ACK: free all segments up to and including ack_nr, take an RTT sample
+ * from the newest of them (unless it was retransmitted, Karn's algorithm) and wake
+ * the TX task if the window opened up.
+ */
+static void csp_rdp_ack_received(csp_conn_t * conn, uint16_t ack_nr) {
+
+	const uint16_t una = ack_nr + 1;
+	if (!csp_rdp_seq_after(una, conn->rdp.snd_una)) {
+		return;
+	}
+
+	/* Never release beyond what has actually been sent */
+	const uint16_t end = csp_rdp_seq_after(una, conn->rdp.snd_nxt) ? conn->rdp.snd_nxt : una;
+	const uint32_t time_now = csp_get_ms();
+	uint32_t delivered = 0;
+
+	csp_rdp_lock_take();
+	for (uint16_t seq_nr = conn->rdp.snd_una; seq_nr != end; seq_nr++) {
+		const uint8_t retries = conn->rdp.tx_timer[seq_nr & csp_rdp_tx_ring_mask].retries;
+		rdp_packet_t * packet = csp_rdp_tx_take_locked(conn, seq_nr);
+		if (packet == NULL) {
+			continue;
+		}
+		if ((seq_nr == ack_nr) && (retries == 0)) {
+			csp_rdp_rtt_sample(conn, time_now - packet->timestamp);
+		}
+		csp_log_protocol("RDP %p: TX Element Free, time %"PRIu32", seq %u, una %u", conn, packet->timestamp, seq_nr, una);
+		csp_buffer_free(packet);
+		delivered++;
+	}
+	conn->rdp.snd_una = una;
+	csp_rdp_lock_give();
+
+	csp_rdp_window_update(conn, delivered, time_now);
+
+	if ((conn->rdp.state == RDP_OPEN) && csp_rdp_is_conn_ready_for_tx(conn)) {
+		csp_log_protocol("RDP %p: Wake Tx task (ack)", conn);
+		csp_bin_sem_post(&conn->rdp.tx_wait);
+	}
+
+}
+
 /**
  * CONTROL MESSAGES
  * The following function is used to send empty messages,
@@ -169,9 +525,10 @@ static int csp_rdp_send_cmp(csp_conn_t * conn, csp_packet_t * packet, int flags,
     /* Generate message */
     if (!packet) {
         packet = csp_buffer_get(20);
-        if (!packet)
-        csp_tm_global.csp_err_nomem++;
-        return CSP_ERR_NOMEM;
+        if (!packet) {
+            csp_tm_global.csp_err_nomem++;
+            return CSP_ERR_NOMEM;
+        }
         packet->length = 0;
     }
 
@@ -190,16 +547,18 @@ static int csp_rdp_send_cmp(csp_conn_t * conn, csp_packet_t * packet, int flags,
     header->syn = (flags & RDP_SYN) ? 1 : 0;
     header->rst = (flags & RDP_RST) ? 1 : 0;
 
-    /* Send copy to tx_queue, before sending packet to IF */
+    /* Send copy to TX ring, before sending packet to IF */
     if (flags & RDP_SYN) {
         rdp_packet_t * rdp_packet = csp_buffer_clone(packet);
         if (rdp_packet == NULL)
         {
+            csp_buffer_free(packet);
             csp_tm_global.csp_err_nomem++;
             return CSP_ERR_NOMEM;
         }
         rdp_packet->timestamp = csp_get_ms();
-        if (csp_queue_enqueue(conn->rdp.tx_queue, &rdp_packet, 0) != CSP_QUEUE_OK)
+        rdp_packet->quarantine = 0;
+        if (csp_rdp_tx_add(conn, rdp_packet, seq_nr) != CSP_ERR_NONE)
             csp_buffer_free(rdp_packet);
     }
 
@@ -220,10 +579,11 @@ static int csp_rdp_send_cmp(csp_conn_t * conn, csp_packet_t * packet, int flags,
         return CSP_ERR_BUSY;
     }
 
-	/* Update last ACK time stamp */
+	/* Update last ACK time stamp, any pending delayed ACK is covered by this one */
 	if (flags & RDP_ACK) {
 		conn->rdp.rcv_lsa = ack_nr;
 		conn->rdp.ack_timestamp = csp_get_ms();
+		csp_rdp_timer_cancel(&conn->rdp.ack_timer);
 	}
 
 	return CSP_ERR_NONE;
@@ -245,6 +605,13 @@ static int csp_rdp_send_eack(csp_conn_t * conn) {
     }
     packet_eack->length = 0;
 
+	/* With CSP_RDP_OPT_SACK bit n (LSB first) tells segment rcv_cur + 2 + n was received,
+	 * rcv_cur + 1 is always missing when segments are queued out of order */
+	const bool sack = (conn->rdp.options & CSP_RDP_OPT_SACK);
+	if (sack) {
+		memset(packet_eack->data, 0, (conn->rdp.window_max * 2 + 7) / 8);
+	}
+
 	/* Loop through RX queue */
 	int i, count;
 	csp_packet_t * packet;
@@ -258,8 +625,18 @@ static int csp_rdp_send_eack(csp_conn_t * conn) {
 
 		/* Add seq nr to EACK packet */
 		rdp_header_t * header = csp_rdp_header_ref(packet);
-		packet_eack->data16[packet_eack->length/sizeof(uint16_t)] = csp_hton16(header->seq_nr);
-		packet_eack->length += sizeof(uint16_t);
+		if (sack) {
+			const uint16_t bit = header->seq_nr - (uint16_t)(conn->rdp.rcv_cur + 2);
+			if (bit < conn->rdp.window_max * 2) {
+				packet_eack->data[bit / 8] |= 1 << (bit % 8);
+				if (packet_eack->length < (bit / 8) + 1) {
+					packet_eack->length = (bit / 8) + 1;
+				}
+			}
+		} else {
+			packet_eack->data16[packet_eack->length/sizeof(uint16_t)] = csp_hton16(header->seq_nr);
+			packet_eack->length += sizeof(uint16_t);
+		}
 		csp_log_protocol("RDP %p: Added EACK nr %u", conn, header->seq_nr);
 
 		/* Requeue */
@@ -293,12 +670,43 @@ static int csp_rdp_send_syn(csp_conn_t * conn) {
 	packet->data32[3] = csp_hton32(csp_rdp_delayed_acks);
 	packet->data32[4] = csp_hton32(csp_rdp_ack_timeout);
 	packet->data32[5] = csp_hton32(csp_rdp_ack_delay_count);
-	packet->length = 6 * sizeof(uint32_t);
+	packet->length = RDP_SYN_OPT_BASIC * sizeof(uint32_t);
+
+	/* Extensions are appended, so servers without them still read the basic options */
+	if (conn->rdp.options) {
+		packet->data32[6] = csp_hton32(conn->rdp.options);
+		packet->data32[7] = csp_hton32(conn->rdp.window_max);
+		packet->length = RDP_SYN_OPT_EXT * sizeof(uint32_t);
+	}
 
 	return csp_rdp_send_cmp(conn, packet, RDP_SYN, conn->rdp.snd_iss, 0);
 
 }
 
+/**
+ * SYN/ACK Packet
+ * The following function sends a SYN/ACK packet, which echoes the accepted extensions
+ */
+static int csp_rdp_send_synack(csp_conn_t * conn) {
+
+	/* Allocate message */
+	csp_packet_t * packet = csp_buffer_get(20);
+	if (packet == NULL) {
+		csp_tm_global.csp_err_nomem++;
+		return CSP_ERR_NOMEM;
+	}
+	packet->length = 0;
+
+	if (conn->rdp.options) {
+		packet->data32[0] = csp_hton32(conn->rdp.options);
+		packet->data32[1] = csp_hton32(conn->rdp.window_max);
+		packet->length = 2 * sizeof(uint32_t);
+	}
+
+	return csp_rdp_send_cmp(conn, packet, RDP_ACK | RDP_SYN, conn->rdp.snd_iss, conn->rdp.rcv_irs);
+
+}
+
 static inline int csp_rdp_receive_data(csp_conn_t * conn, csp_packet_t * packet) {
 
 	/* Remove RDP header before passing to userspace */
@@ -388,49 +796,64 @@ static inline int csp_rdp_rx_queue_add(csp_conn_t * conn, csp_packet_t * packet,
 
 }
 
-static void csp_rdp_flush_eack(csp_conn_t * conn, csp_packet_t * eack_packet) {
+/* Free a segment the receiver got out of order, returns 1 if it was still in the TX ring */
+static int csp_rdp_eack_segment_locked(csp_conn_t * conn, uint16_t seq_nr, uint16_t * highest) {
 
-	/* Loop through TX queue */
-	int i, j, count;
-	rdp_packet_t * packet;
-	count = csp_queue_size(conn->rdp.tx_queue);
-	for (i = 0; i < count; i++) {
+	if (!csp_rdp_seq_between(seq_nr, conn->rdp.snd_una, conn->rdp.snd_nxt - 1)) {
+		return 0;
+	}
+	if (csp_rdp_seq_after(seq_nr, *highest)) {
+		*highest = seq_nr;
+	}
+	rdp_packet_t * packet = csp_rdp_tx_take_locked(conn, seq_nr);
+	if (packet == NULL) {
+		return 0;
+	}
+	csp_log_protocol("RDP %p: TX Element %u freed", conn, seq_nr);
+	csp_buffer_free(packet);
+	return 1;
 
-		if (csp_queue_dequeue(conn->rdp.tx_queue, &packet, 0) != CSP_QUEUE_OK) {
-			csp_log_error("RDP %p: Cannot dequeue from tx_queue in flush EACK", conn);
-			break;
-		}
+}
 
-		rdp_header_t * header = csp_rdp_header_ref((csp_packet_t *) packet);
-		csp_log_protocol("RDP %p: EACK compare element, time %"PRIu32", seq %u", conn, packet->timestamp, csp_ntoh16(header->seq_nr));
-
-		/* Look for this element in EACKs */
-		int match = 0;
-		for (j = 0; j < (int)((eack_packet->length - sizeof(rdp_header_t)) / sizeof(uint16_t)); j++) {
-			if (csp_ntoh16(eack_packet->data16[j]) == csp_ntoh16(header->seq_nr))
-				match = 1;
-
-			/* Enable this if you want EACK's to trigger retransmission */
-			if (csp_ntoh16(eack_packet->data16[j]) > csp_ntoh16(header->seq_nr)) {
-				uint32_t time_now = csp_get_ms();
-				if (csp_rdp_time_after(time_now, packet->quarantine)) {
-					packet->timestamp = time_now - conn->rdp.packet_timeout - 1;
-					packet->quarantine = time_now +	conn->rdp.packet_timeout / 2;
-				}
+static void csp_rdp_flush_eack(csp_conn_t * conn, csp_packet_t * eack_packet) {
+
+	const uint32_t time_now = csp_get_ms();
+	const int length = eack_packet->length - sizeof(rdp_header_t);
+	uint16_t highest = conn->rdp.snd_una;
+	uint32_t delivered = 0;
+
+	csp_rdp_lock_take();
+
+	/* Free the segments that were received out of order */
+	if (conn->rdp.options & CSP_RDP_OPT_SACK) {
+		/* Bitmap relative to the cumulative ACK carried in the same header */
+		const uint16_t base = csp_rdp_header_ref(eack_packet)->ack_nr + 2;
+		for (int bit = 0; bit < (length * 8); bit++) {
+			if (eack_packet->data[bit / 8] & (1 << (bit % 8))) {
+				delivered += csp_rdp_eack_segment_locked(conn, base + bit, &highest);
 			}
 		}
-
-		if (match == 0) {
-			/* If not found, put back on tx queue */
-			csp_queue_enqueue(conn->rdp.tx_queue, &packet, 0);
-		} else {
-			/* Found, free */
-			csp_log_protocol("RDP %p: TX Element %u freed", conn, csp_ntoh16(header->seq_nr));
-			csp_buffer_free(packet);
+	} else {
+		for (int j = 0; j < (length / (int)sizeof(uint16_t)); j++) {
+			delivered += csp_rdp_eack_segment_locked(conn, csp_ntoh16(eack_packet->data16[j]), &highest);
 		}
+	}
 
+	/* Segments before the highest EACK'ed one are most likely lost, expire their
+	 * timers now unless they were recently retransmitted for the same reason */
+	for (uint16_t seq_nr = conn->rdp.snd_una; seq_nr != highest; seq_nr++) {
+		const unsigned int slot = seq_nr & csp_rdp_tx_ring_mask;
+		rdp_packet_t * packet = (rdp_packet_t *) conn->rdp.tx_ring[slot];
+		if ((packet != NULL) && csp_rdp_time_after(time_now, packet->quarantine)) {
+			packet->quarantine = time_now + conn->rdp.rto / 2;
+			csp_rdp_timer_arm_locked(&conn->rdp.tx_timer[slot], time_now);
+		}
 	}
 
+	csp_rdp_lock_give();
+
+	csp_rdp_window_update(conn, delivered, time_now);
+
 }
 
 static inline bool csp_rdp_should_ack(csp_conn_t * conn) {
@@ -455,20 +878,27 @@ static inline bool csp_rdp_should_ack(csp_conn_t * conn) {
 
 void csp_rdp_flush_all(csp_conn_t * conn) {
 
-	if ((conn == NULL) || conn->rdp.tx_queue == NULL) {
+	if ((conn == NULL) || conn->rdp.tx_ring == NULL) {
 		csp_log_error("RDP %p: Null pointer passed to rdp flush all", conn);
 		return;
 	}
 
 	rdp_packet_t * packet;
 
-	/* Empty TX queue */
-	while (csp_queue_dequeue_isr(conn->rdp.tx_queue, &packet, &pdTrue) == CSP_QUEUE_OK) {
+	/* Empty TX ring and stop all timers */
+	csp_rdp_lock_take();
+	for (unsigned int slot = 0; slot <= csp_rdp_tx_ring_mask; slot++) {
+		csp_rdp_timer_unlink_locked(&conn->rdp.tx_timer[slot]);
+		packet = (rdp_packet_t *) conn->rdp.tx_ring[slot];
 		if (packet != NULL) {
 			csp_log_protocol("RDP %p: Flush TX Element, time %"PRIu32", seq %u", conn, packet->timestamp, csp_ntoh16(csp_rdp_header_ref((csp_packet_t *) packet)->seq_nr));
 			csp_buffer_free(packet);
+			conn->rdp.tx_ring[slot] = NULL;
 		}
 	}
+	csp_rdp_timer_unlink_locked(&conn->rdp.ack_timer);
+	csp_rdp_timer_unlink_locked(&conn->rdp.conn_timer);
+	csp_rdp_lock_give();
 
 	/* Empty RX queue */
 	while (csp_queue_dequeue_isr(conn->rdp.rx_queue, &packet, &pdTrue) == CSP_QUEUE_OK) {
@@ -497,6 +927,16 @@ int csp_rdp_check_ack(csp_conn_t * conn) {
 		csp_rdp_send_cmp(conn, NULL, RDP_ACK, conn->rdp.snd_nxt, conn->rdp.rcv_cur);
 	}
 
+	/* Coalesce unacknowledged segments into one delayed, cumulative ACK */
+	if (conn->rdp.delayed_acks && (conn->rdp.rcv_lsa != conn->rdp.rcv_cur)) {
+		uint32_t expires = conn->rdp.ack_timestamp + conn->rdp.ack_timeout;
+		if (!avail) {
+			/* RX buffer full, poll again for free space */
+			expires = csp_get_ms() + conn->rdp.ack_timeout;
+		}
+		csp_rdp_timer_arm_idle(&conn->rdp.ack_timer, expires);
+	}
+
 	return CSP_ERR_NONE;
 
 }
@@ -504,107 +944,191 @@ int csp_rdp_check_ack(csp_conn_t * conn) {
 static inline bool csp_rdp_is_conn_ready_for_tx(csp_conn_t * conn)
 {
 	// Check Tx window (messages waiting for acks)
-	if (csp_rdp_seq_after(conn->rdp.snd_nxt, conn->rdp.snd_una + conn->rdp.window_size - 1)) {
+	if (csp_rdp_seq_after(conn->rdp.snd_nxt, conn->rdp.snd_una + conn->rdp.tx_window - 1)) {
 		return false;
 	}
 	return true;
 }
 
 /**
- * This function must be called with regular intervals for the
- * RDP protocol to work as expected. This takes care of closing
- * stale connections and retransmitting traffic. A good place to
- * call this function is from the CSP router task.
+ * MESSAGE TIMEOUT:
+ * Retransmit a segment whose timer expired
  */
-void csp_rdp_check_timeouts(csp_conn_t * conn) {
+static void csp_rdp_tx_timer_expired(csp_conn_t * conn, csp_rdp_timer_t * timer) {
 
 	const uint32_t time_now = csp_get_ms();
+	csp_packet_t * new_packet = NULL;
 
-	/**
-	 * CONNECTION TIMEOUT:
-	 * Check that connection has not timed out inside the network stack
-	 */
-	if (conn->socket != NULL) {
-		if (csp_rdp_time_after(time_now, conn->timestamp + conn->rdp.conn_timeout)) {
-			csp_log_warn("RDP %p: Found a lost connection (now: %"PRIu32", ts: %"PRIu32", to: %"PRIu32"), closing",
-				conn, time_now, conn->timestamp, conn->rdp.conn_timeout);
-			csp_conn_close(conn, CSP_RDP_CLOSED_BY_USERSPACE | CSP_RDP_CLOSED_BY_PROTOCOL | CSP_RDP_CLOSED_BY_TIMEOUT);
-			return;
+	csp_rdp_lock_take();
+
+	rdp_packet_t * packet = (rdp_packet_t *) conn->rdp.tx_ring[timer - conn->rdp.tx_timer];
+
+	/* The segment may have been acknowledged or rescheduled since the timer fired */
+	if ((conn->state == CONN_OPEN) && (conn->rdp.state != RDP_CLOSE_WAIT) && (packet != NULL) &&
+	    (timer->pprev == NULL) && !csp_rdp_seq_before(timer->seq_nr, conn->rdp.snd_una)) {
+
+		rdp_header_t * header = csp_rdp_header_ref((csp_packet_t *) packet);
+		csp_log_protocol("RDP %p: TX Element timed out, retransmitting seq %u", conn, timer->seq_nr);
+
+		/* Back off once per timeout of the oldest segment, not on EACK triggered retransmissions */
+		if ((timer->seq_nr == conn->rdp.snd_una) && !csp_rdp_time_before(time_now, packet->timestamp + conn->rdp.rto)) {
+			csp_rdp_rto_backoff(conn);
 		}
-	}
 
-	/**
-	 * CLOSE-WAIT TIMEOUT:
-	 * After waiting a while in CLOSE-WAIT, the connection should be closed.
-	 */
-	if (conn->rdp.state == RDP_CLOSE_WAIT) {
-		if (csp_rdp_time_after(time_now, conn->timestamp + conn->rdp.conn_timeout)) {
-			csp_conn_close(conn, CSP_RDP_CLOSED_BY_PROTOCOL | CSP_RDP_CLOSED_BY_TIMEOUT);
+		/* Update to latest outgoing ACK */
+		header->ack_nr = csp_hton16(conn->rdp.rcv_cur);
+
+		packet->timestamp = time_now;
+		if (timer->retries < UINT8_MAX) {
+			timer->retries++;
 		}
+		csp_rdp_timer_arm_locked(timer, time_now + conn->rdp.rto);
+
+		new_packet = csp_buffer_clone(packet);
+	}
+
+	csp_rdp_lock_give();
+
+	if (new_packet == NULL) {
 		return;
 	}
 
-	/**
-	 * MESSAGE TIMEOUT:
-	 * Check each outgoing message for TX timeout
-	 */
-	int count = csp_queue_size(conn->rdp.tx_queue);
-	for (int i = 0; i < count; i++) {
+	if (csp_send_direct(conn->idout, new_packet, csp_rtable_find_route(conn->idout.dst), 0) != CSP_ERR_NONE) {
+		csp_log_warn("RDP %p: Retransmission failed", conn);
+		csp_buffer_free(new_packet);
+	}
 
-		rdp_packet_t * packet;
-		if ((csp_queue_dequeue_isr(conn->rdp.tx_queue, &packet, &pdTrue) != CSP_QUEUE_OK) || packet == NULL) {
-			csp_log_warn("RDP %p: Cannot dequeue from tx_queue in check timeout", conn);
-			break;
-		}
+}
 
-		/* Get header */
-		rdp_header_t * header = csp_rdp_header_ref((csp_packet_t *) packet);
+/**
+ * DELAYED ACK:
+ * Send the coalesced ACK, csp_rdp_check_ack re-arms the timer if the RX buffer is still full
+ */
+static void csp_rdp_ack_timer_expired(csp_conn_t * conn) {
 
-		/* If acked, do not retransmit */
-		if (csp_rdp_seq_before(csp_ntoh16(header->seq_nr), conn->rdp.snd_una)) {
-			csp_log_protocol("RDP %p: TX Element Free, time %"PRIu32", seq %u, una %u", conn, packet->timestamp, csp_ntoh16(header->seq_nr), conn->rdp.snd_una);
-			csp_buffer_free(packet);
-			continue;
-		}
+	if ((conn->state != CONN_OPEN) || (conn->rdp.state != RDP_OPEN)) {
+		return;
+	}
 
-		/* Check timestamp and retransmit if needed */
-		if (csp_rdp_time_after(time_now, packet->timestamp + conn->rdp.packet_timeout)) {
-			csp_log_protocol("RDP %p: TX Element timed out, retransmitting seq %u", conn, csp_ntoh16(header->seq_nr));
+	csp_rdp_check_ack(conn);
 
-			/* Update to latest outgoing ACK */
-			header->ack_nr = csp_hton16(conn->rdp.rcv_cur);
+}
 
-			/* Send copy to tx_queue */
-			packet->timestamp = csp_get_ms();
-			csp_packet_t * new_packet = csp_buffer_clone(packet);
-			if (csp_send_direct(conn->idout, new_packet, csp_rtable_find_route(conn->idout.dst), 0) != CSP_ERR_NONE) {
-				csp_log_warn("RDP %p: Retransmission failed", conn);
-				csp_buffer_free(new_packet);
-			}
+/**
+ * CONNECTION TIMEOUT:
+ * Close connections which have not been accepted by userspace in time (still
+ * owned by the socket), and connections which have waited long enough in CLOSE-WAIT.
+ */
+static void csp_rdp_conn_timer_expired(csp_conn_t * conn) {
 
-		}
+	if ((conn->state != CONN_OPEN) || ((conn->socket == NULL) && (conn->rdp.state != RDP_CLOSE_WAIT))) {
+		return;
+	}
+
+	const uint32_t time_now = csp_get_ms();
+	const uint32_t deadline = conn->timestamp + conn->rdp.conn_timeout;
 
-		/* Requeue the TX element */
-		csp_queue_enqueue_isr(conn->rdp.tx_queue, &packet, &pdTrue);
+	/* Timestamp moved since the timer was armed */
+	if (!csp_rdp_time_after(time_now, deadline)) {
+		csp_rdp_timer_arm(&conn->rdp.conn_timer, deadline + 1);
+		return;
+	}
+
+	if (conn->socket != NULL) {
+		csp_log_warn("RDP %p: Found a lost connection (now: %"PRIu32", ts: %"PRIu32", to: %"PRIu32"), closing",
+			conn, time_now, conn->timestamp, conn->rdp.conn_timeout);
+		csp_conn_close(conn, CSP_RDP_CLOSED_BY_USERSPACE | CSP_RDP_CLOSED_BY_PROTOCOL | CSP_RDP_CLOSED_BY_TIMEOUT);
+		return;
+	}
+
+	csp_conn_close(conn, CSP_RDP_CLOSED_BY_PROTOCOL | CSP_RDP_CLOSED_BY_TIMEOUT);
+
+}
+
+static void csp_rdp_conn_timer_start(csp_conn_t * conn) {
+	csp_rdp_timer_arm(&conn->rdp.conn_timer, conn->timestamp + conn->rdp.conn_timeout + 1);
+}
+
+/**
+ * This function must be called with regular intervals for the
+ * RDP protocol to work as expected. This takes care of closing
+ * stale connections, retransmitting traffic and sending delayed
+ * ACKs. A good place to call this function is from the CSP router task.
+ * Only the timer wheel slots passed since the previous call are visited.
+ */
+void csp_rdp_check_timeouts(void) {
 
+	if (!csp_rdp_wheel_started) {
+		return;
 	}
 
-	if (conn->rdp.state == RDP_OPEN) {
+	const uint32_t time_now = csp_get_ms();
+	csp_rdp_timer_t * expired = NULL;
+
+	/* Move all due timers to a local list */
+	csp_rdp_lock_take();
+	for (unsigned int i = 0; ; i++) {
+		csp_rdp_timer_t ** link = &csp_rdp_wheel[csp_rdp_wheel_slot(csp_rdp_wheel_time)];
+		while (*link != NULL) {
+			csp_rdp_timer_t * timer = *link;
+			if (csp_rdp_time_after(timer->expires, time_now)) {
+				link = &timer->next;
+				continue;
+			}
+			csp_rdp_timer_unlink_locked(timer);
+			csp_rdp_timer_link_locked(&expired, timer);
+		}
 
-		/* Check if we have unacknowledged segments */
-		if (conn->rdp.delayed_acks) {
-			csp_rdp_check_ack(conn);
+		/* Stop at the slot covering the current time */
+		if (csp_rdp_time_after(csp_rdp_wheel_time + CSP_RDP_TIMER_TICK_MS, time_now)) {
+			break;
 		}
 
-		/* Wake user task if additional Tx can be done */
-		if (csp_rdp_is_conn_ready_for_tx(conn)) {
-			csp_log_protocol("RDP %p: Wake Tx task (check timeouts)", conn);
-			csp_bin_sem_post(&conn->rdp.tx_wait);
+		/* A full revolution has visited every slot */
+		if (i == CSP_RDP_TIMER_SLOTS - 1) {
+			csp_rdp_wheel_time = time_now & ~(uint32_t)(CSP_RDP_TIMER_TICK_MS - 1);
+			break;
 		}
+		csp_rdp_wheel_time += CSP_RDP_TIMER_TICK_MS;
 	}
+	csp_rdp_lock_give();
+
+	/* Handle expired timers without holding the lock, a timer cancelled meanwhile is
+	 * removed from the local list by csp_rdp_timer_cancel() */
+	while (1) {
+		csp_rdp_lock_take();
+		csp_rdp_timer_t * timer = expired;
+		if (timer != NULL) {
+			csp_rdp_timer_unlink_locked(timer);
+		}
+		csp_rdp_lock_give();
+
+		if (timer == NULL) {
+			break;
+		}
+
+		/* A router worker may be processing a packet of the same connection */
+		csp_conn_t * conn = timer->conn;
+		csp_bin_sem_wait(&conn->rdp.lock, CSP_MAX_TIMEOUT);
+		switch (timer->type) {
+			case RDP_TIMER_TX:
+				csp_rdp_tx_timer_expired(timer->conn, timer);
+				break;
+			case RDP_TIMER_ACK:
+				csp_rdp_ack_timer_expired(timer->conn);
+				break;
+			case RDP_TIMER_CONN:
+				csp_rdp_conn_timer_expired(timer->conn);
+				break;
+			default:
+				break;
+		}
+		csp_bin_sem_post(&conn->rdp.lock);
+	}
+
 }
 
-bool csp_rdp_new_packet(csp_conn_t * conn, csp_packet_t * packet) {
+static bool csp_rdp_process_packet(csp_conn_t * conn, csp_packet_t * packet) {
 
 	bool close_connection = false;
 
@@ -626,7 +1150,7 @@ bool csp_rdp_new_packet(csp_conn_t * conn, csp_packet_t * packet) {
 
 		if (rx_header->ack) {
 			/* Store current ack'ed sequence number */
-			conn->rdp.snd_una = rx_header->ack_nr + 1;
+			csp_rdp_ack_received(conn, rx_header->ack_nr);
 		}
 
 		if (conn->rdp.state == RDP_CLOSED) {
@@ -648,6 +1172,7 @@ bool csp_rdp_new_packet(csp_conn_t * conn, csp_packet_t * packet) {
 			csp_log_protocol("RDP %p: Received RST in sequence, no more data incoming, reply with RST", conn);
 			conn->rdp.state = RDP_CLOSE_WAIT;
 			conn->timestamp = csp_get_ms();
+			csp_rdp_conn_timer_start(conn);
 			csp_rdp_send_cmp(conn, NULL, RDP_ACK | RDP_RST, conn->rdp.snd_nxt, conn->rdp.rcv_cur);
                         if (CSP_USE_RDP_FAST_CLOSE) {
                             closed_by |= CSP_RDP_CLOSED_BY_TIMEOUT;
@@ -693,15 +1218,37 @@ bool csp_rdp_new_packet(csp_conn_t * conn, csp_packet_t * packet) {
 		conn->rdp.delayed_acks 		= csp_ntoh32(packet->data32[3]);
 		conn->rdp.ack_timeout 		= csp_ntoh32(packet->data32[4]);
 		conn->rdp.ack_delay_count 	= csp_ntoh32(packet->data32[5]);
-		csp_log_protocol("RDP %p: window size %"PRIu32", conn timeout %"PRIu32", packet timeout %"PRIu32", delayed acks: %"PRIu32", ack timeout %"PRIu32", ack each %"PRIu32" packet",
+		if (conn->rdp.window_size > csp_conf.rdp_max_window) {
+			conn->rdp.window_size = csp_conf.rdp_max_window;
+		}
+		csp_rdp_rto_reset(conn);
+		csp_rdp_window_reset(conn);
+
+		/* Accept the extensions this side supports as well */
+		conn->rdp.options = 0;
+		if (packet->length >= (RDP_SYN_OPT_EXT * sizeof(uint32_t) + sizeof(rdp_header_t))) {
+			conn->rdp.options = csp_ntoh32(packet->data32[6]) & RDP_OPT_SUPPORTED;
+			if (conn->rdp.options & CSP_RDP_OPT_AUTO_WINDOW) {
+				const uint32_t window_max = csp_ntoh32(packet->data32[7]);
+				conn->rdp.window_max = (window_max < csp_conf.rdp_max_window) ? window_max : csp_conf.rdp_max_window;
+				if (conn->rdp.window_max < conn->rdp.window_size) {
+					conn->rdp.window_max = conn->rdp.window_size;
+				}
+			}
+		}
+		csp_log_protocol("RDP %p: window size %"PRIu32", conn timeout %"PRIu32", packet timeout %"PRIu32", delayed acks: %"PRIu32", ack timeout %"PRIu32", ack each %"PRIu32" packet, options 0x%"PRIx32", max window %"PRIu32,
 				conn, conn->rdp.window_size, conn->rdp.conn_timeout, conn->rdp.packet_timeout,
-				conn->rdp.delayed_acks, conn->rdp.ack_timeout, conn->rdp.ack_delay_count);
+				conn->rdp.delayed_acks, conn->rdp.ack_timeout, conn->rdp.ack_delay_count,
+				conn->rdp.options, conn->rdp.window_max);
 
 		/* Connection accepted */
 		conn->rdp.state = RDP_SYN_RCVD;
 
+		/* Close the connection, if userspace does not accept it in time */
+		csp_rdp_conn_timer_start(conn);
+
 		/* Send SYN/ACK */
-		csp_rdp_send_cmp(conn, NULL, RDP_ACK | RDP_SYN, conn->rdp.snd_iss, conn->rdp.rcv_irs);
+		csp_rdp_send_synack(conn);
 
 		goto discard_open;
 
@@ -719,7 +1266,22 @@ bool csp_rdp_new_packet(csp_conn_t * conn, csp_packet_t * packet) {
 			conn->rdp.rcv_cur = rx_header->seq_nr;
 			conn->rdp.rcv_irs = rx_header->seq_nr;
 			conn->rdp.rcv_lsa = rx_header->seq_nr - 1;
-			conn->rdp.snd_una = rx_header->ack_nr + 1;
+
+			/* Keep the extensions the server accepted, none if it did not echo them */
+			uint32_t options = 0;
+			if (packet->length >= (2 * sizeof(uint32_t) + sizeof(rdp_header_t))) {
+				options = csp_ntoh32(packet->data32[0]);
+				const uint32_t window_max = csp_ntoh32(packet->data32[1]);
+				if ((options & CSP_RDP_OPT_AUTO_WINDOW) && (window_max >= conn->rdp.window_size) && (window_max < conn->rdp.window_max)) {
+					conn->rdp.window_max = window_max;
+				}
+			}
+			conn->rdp.options &= options;
+			if (!(conn->rdp.options & CSP_RDP_OPT_AUTO_WINDOW)) {
+				conn->rdp.window_max = conn->rdp.window_size;
+			}
+
+			csp_rdp_ack_received(conn, rx_header->ack_nr);
 			conn->rdp.ack_timestamp = csp_get_ms();
 			conn->rdp.state = RDP_OPEN;
 
@@ -777,12 +1339,12 @@ bool csp_rdp_new_packet(csp_conn_t * conn, csp_packet_t * packet) {
 		}
 
 		/* Check sequence number */
-		if (!csp_rdp_seq_between(rx_header->seq_nr, conn->rdp.rcv_cur + 1, conn->rdp.rcv_cur + (conn->rdp.window_size * 2))) {
+		if (!csp_rdp_seq_between(rx_header->seq_nr, conn->rdp.rcv_cur + 1, conn->rdp.rcv_cur + (conn->rdp.window_max * 2))) {
 			csp_log_protocol("RDP %p: Invalid sequence number! %u not between %u and %"PRIu32,
-				conn, rx_header->seq_nr, conn->rdp.rcv_cur + 1U, conn->rdp.rcv_cur + (conn->rdp.window_size * 2U));
+				conn, rx_header->seq_nr, conn->rdp.rcv_cur + 1U, conn->rdp.rcv_cur + (conn->rdp.window_max * 2U));
 			/* If duplicate SYN received, send another SYN/ACK */
 			if (conn->rdp.state == RDP_SYN_RCVD)
-				csp_rdp_send_cmp(conn, NULL, RDP_ACK | RDP_SYN, conn->rdp.snd_iss, conn->rdp.rcv_irs);
+				csp_rdp_send_synack(conn);
 			/* If duplicate data packet received, send EACK back */
 			if (conn->rdp.state == RDP_OPEN)
 				csp_rdp_send_eack(conn);
@@ -791,9 +1353,9 @@ bool csp_rdp_new_packet(csp_conn_t * conn, csp_packet_t * packet) {
 		}
 
 		/* Check ACK number */
-		if (!csp_rdp_seq_between(rx_header->ack_nr, conn->rdp.snd_una - 1 - (conn->rdp.window_size * 2), conn->rdp.snd_nxt - 1)) {
+		if (!csp_rdp_seq_between(rx_header->ack_nr, conn->rdp.snd_una - 1 - (conn->rdp.window_max * 2), conn->rdp.snd_nxt - 1)) {
 			csp_log_error("RDP %p: Invalid ACK number! %u not between %"PRIu32" and %u",
-				conn, rx_header->ack_nr, conn->rdp.snd_una - 1 - (conn->rdp.window_size * 2), conn->rdp.snd_nxt - 1);
+				conn, rx_header->ack_nr, conn->rdp.snd_una - 1 - (conn->rdp.window_max * 2), conn->rdp.snd_nxt - 1);
 			goto discard_open;
 		}
 
@@ -825,7 +1387,7 @@ bool csp_rdp_new_packet(csp_conn_t * conn, csp_packet_t * packet) {
 		}
 
 		/* Store current ack'ed sequence number */
-		conn->rdp.snd_una = rx_header->ack_nr + 1;
+		csp_rdp_ack_received(conn, rx_header->ack_nr);
 
 		/* We have an EACK */
 		if (rx_header->eak) {
@@ -881,14 +1443,14 @@ bool csp_rdp_new_packet(csp_conn_t * conn, csp_packet_t * packet) {
 		}
 
 		/* Check ACK number */
-		if (!csp_rdp_seq_between(rx_header->ack_nr, conn->rdp.snd_una - 1 - (conn->rdp.window_size * 2), conn->rdp.snd_nxt - 1)) {
+		if (!csp_rdp_seq_between(rx_header->ack_nr, conn->rdp.snd_una - 1 - (conn->rdp.window_max * 2), conn->rdp.snd_nxt - 1)) {
 			csp_log_error("RDP %p: Invalid ACK number! %u not between %"PRIu32" and %u",
-				conn, rx_header->ack_nr, conn->rdp.snd_una - 1 - (conn->rdp.window_size * 2), conn->rdp.snd_nxt - 1);
+				conn, rx_header->ack_nr, conn->rdp.snd_una - 1 - (conn->rdp.window_max * 2), conn->rdp.snd_nxt - 1);
 			goto discard_open;
 		}
 
 		/* Store current ack'ed sequence number */
-		conn->rdp.snd_una = rx_header->ack_nr + 1;
+		csp_rdp_ack_received(conn, rx_header->ack_nr);
 
 		/* Send back a reset */
 		csp_rdp_send_cmp(conn, NULL, RDP_ACK | RDP_RST, conn->rdp.snd_nxt, conn->rdp.rcv_cur);
@@ -918,6 +1480,17 @@ accepted_open:
 
 }
 
+bool csp_rdp_new_packet(csp_conn_t * conn, csp_packet_t * packet) {
+
+	/* With several router workers the timer task can expire timers of this connection meanwhile */
+	csp_bin_sem_wait(&conn->rdp.lock, CSP_MAX_TIMEOUT);
+	const bool close_connection = csp_rdp_process_packet(conn, packet);
+	csp_bin_sem_post(&conn->rdp.lock);
+
+	return close_connection;
+
+}
+
 int csp_rdp_connect(csp_conn_t * conn) {
 
 	int retry = 1;
@@ -929,6 +1502,10 @@ int csp_rdp_connect(csp_conn_t * conn) {
 	conn->rdp.ack_timeout     = csp_rdp_ack_timeout;
 	conn->rdp.ack_delay_count = csp_rdp_ack_delay_count;
 	conn->rdp.ack_timestamp   = csp_get_ms();
+	conn->rdp.options         = csp_rdp_ext_opt & RDP_OPT_SUPPORTED;
+	if (conn->rdp.window_size > csp_conf.rdp_max_window) {
+		conn->rdp.window_size = csp_conf.rdp_max_window;
+	}
 
 retry:
 	csp_log_protocol("RDP %p: Active connect, conn state %u", conn, conn->rdp.state);
@@ -943,6 +1520,11 @@ retry:
 	conn->rdp.snd_iss = (uint16_t)rand();
 	conn->rdp.snd_nxt = conn->rdp.snd_iss + 1;
 	conn->rdp.snd_una = conn->rdp.snd_iss;
+	csp_rdp_rto_reset(conn);
+	csp_rdp_window_reset(conn);
+	if (conn->rdp.options & CSP_RDP_OPT_AUTO_WINDOW) {
+		conn->rdp.window_max = csp_conf.rdp_max_window;
+	}
 
 	csp_log_protocol("RDP %p: AC: Sending SYN", conn);
 
@@ -1017,7 +1599,7 @@ int csp_rdp_send(csp_conn_t * conn, csp_packet_t * packet) {
     tx_header->seq_nr = csp_hton16(conn->rdp.snd_nxt);
     tx_header->ack = 1;
 
-    /* Send copy to tx_queue */
+    /* Send copy to TX ring */
     rdp_packet_t * rdp_packet = csp_buffer_clone(packet);
     if (rdp_packet == NULL) {
         csp_log_error("RDP %p: Failed to allocate packet buffer", conn);
@@ -1027,13 +1609,20 @@ int csp_rdp_send(csp_conn_t * conn, csp_packet_t * packet) {
 
     rdp_packet->timestamp = csp_get_ms();
     rdp_packet->quarantine = 0;
-    if (csp_queue_enqueue(conn->rdp.tx_queue, &rdp_packet, 0) != CSP_QUEUE_OK) {
+    if (csp_rdp_tx_add(conn, rdp_packet, conn->rdp.snd_nxt) != CSP_ERR_NONE) {
         csp_log_error("RDP %p: No more space in RDP retransmit queue", conn);
         csp_buffer_free(rdp_packet);
         csp_tm_global.csp_err_nobufs++;
         return CSP_ERR_NOBUFS;
     }
 
+    /* The segment carries a cumulative ACK, so a pending delayed ACK is not needed */
+    if (conn->rdp.rcv_lsa != conn->rdp.rcv_cur) {
+        conn->rdp.rcv_lsa = conn->rdp.rcv_cur;
+        conn->rdp.ack_timestamp = rdp_packet->timestamp;
+        csp_rdp_timer_cancel(&conn->rdp.ack_timer);
+    }
+
 	csp_log_protocol("RDP %p: Sending  in S %u: syn %u, ack %u, eack %u, "
 				"rst %u, seq_nr %5u, ack_nr %5u, packet_len %u (%u)",
 				conn, conn->rdp.state, tx_header->syn, tx_header->ack, tx_header->eak,
@@ -1053,6 +1642,24 @@ int csp_rdp_init(csp_conn_t * conn) {
 	conn->rdp.state = RDP_CLOSED;
 	conn->rdp.conn_timeout = csp_rdp_conn_timeout;
 	conn->rdp.packet_timeout = csp_rdp_packet_timeout;
+	csp_rdp_rto_reset(conn);
+
+    /* Create the lock shared by all connections on first use */
+    if (!csp_rdp_lock_created) {
+        if (csp_bin_sem_create(&csp_rdp_lock) != CSP_SEMAPHORE_OK) {
+            csp_log_error("RDP %p: Failed to initialize timer lock", conn);
+            csp_tm_global.csp_err_nomem++;
+            return CSP_ERR_NOMEM;
+        }
+        csp_rdp_lock_created = true;
+    }
+
+    /* TX ring must cover the largest window, rounded up to a power of two to map sequence numbers */
+    uint32_t ring_size = 1;
+    while (ring_size < csp_conf.rdp_max_window) {
+        ring_size <<= 1;
+    }
+    csp_rdp_tx_ring_mask = ring_size - 1;
 
     /* Create a binary semaphore to wait on for tasks */
     if (csp_bin_sem_create(&conn->rdp.tx_wait) != CSP_SEMAPHORE_OK) {
@@ -1060,22 +1667,46 @@ int csp_rdp_init(csp_conn_t * conn) {
         csp_tm_global.csp_err_nomem++;
         return CSP_ERR_NOMEM;
     }
+    if (csp_bin_sem_create(&conn->rdp.lock) != CSP_SEMAPHORE_OK) {
+        csp_log_error("RDP %p: Failed to initialize connection lock", conn);
+        csp_bin_sem_remove(&conn->rdp.tx_wait);
+        csp_tm_global.csp_err_nomem++;
+        return CSP_ERR_NOMEM;
+    }
 
-    /* Create TX queue */
-    conn->rdp.tx_queue = csp_queue_create(csp_conf.rdp_max_window, sizeof(csp_packet_t *));
-    if (conn->rdp.tx_queue == NULL) {
-        csp_log_error("RDP %p: Failed to create TX queue for conn", conn);
+    /* Create TX ring and its retransmission timers */
+    conn->rdp.tx_ring = csp_calloc(ring_size, sizeof(*conn->rdp.tx_ring));
+    conn->rdp.tx_timer = csp_calloc(ring_size, sizeof(*conn->rdp.tx_timer));
+    if ((conn->rdp.tx_ring == NULL) || (conn->rdp.tx_timer == NULL)) {
+        csp_log_error("RDP %p: Failed to create TX ring for conn", conn);
         csp_bin_sem_remove(&conn->rdp.tx_wait);
+        csp_bin_sem_remove(&conn->rdp.lock);
+        csp_free(conn->rdp.tx_ring);
+        csp_free(conn->rdp.tx_timer);
+        conn->rdp.tx_ring = NULL;
+        conn->rdp.tx_timer = NULL;
         csp_tm_global.csp_err_nomem++;
         return CSP_ERR_NOMEM;
     }
+    for (uint32_t slot = 0; slot < ring_size; slot++) {
+        conn->rdp.tx_timer[slot].conn = conn;
+        conn->rdp.tx_timer[slot].type = RDP_TIMER_TX;
+    }
+    conn->rdp.ack_timer.conn = conn;
+    conn->rdp.ack_timer.type = RDP_TIMER_ACK;
+    conn->rdp.conn_timer.conn = conn;
+    conn->rdp.conn_timer.type = RDP_TIMER_CONN;
 
     /* Create RX queue */
     conn->rdp.rx_queue = csp_queue_create(csp_conf.rdp_max_window * 2, sizeof(csp_packet_t *));
     if (conn->rdp.rx_queue == NULL) {
         csp_log_error("RDP %p: Failed to create RX queue for conn", conn);
         csp_bin_sem_remove(&conn->rdp.tx_wait);
-        csp_queue_remove(conn->rdp.tx_queue);
+        csp_bin_sem_remove(&conn->rdp.lock);
+        csp_free(conn->rdp.tx_ring);
+        csp_free(conn->rdp.tx_timer);
+        conn->rdp.tx_ring = NULL;
+        conn->rdp.tx_timer = NULL;
         csp_tm_global.csp_err_nomem++;
         return CSP_ERR_NOMEM;
     }
@@ -1086,8 +1717,15 @@ int csp_rdp_init(csp_conn_t * conn) {
 
 void csp_rdp_free_resources(csp_conn_t * conn) {
 
+	if (conn->rdp.tx_ring != NULL) {
+		csp_rdp_flush_all(conn);
+	}
 	csp_bin_sem_remove(&conn->rdp.tx_wait);
-	csp_queue_remove(conn->rdp.tx_queue);
+	csp_bin_sem_remove(&conn->rdp.lock);
+	csp_free(conn->rdp.tx_ring);
+	csp_free(conn->rdp.tx_timer);
+	conn->rdp.tx_ring = NULL;
+	conn->rdp.tx_timer = NULL;
 	csp_queue_remove(conn->rdp.rx_queue);
 }
 
@@ -1111,6 +1749,7 @@ static int csp_rdp_close_internal(csp_conn_t * conn, uint8_t closed_by, bool sen
 	if (conn->rdp.state != RDP_CLOSE_WAIT) {
 		conn->rdp.state = RDP_CLOSE_WAIT;
 		conn->timestamp = csp_get_ms();
+		csp_rdp_conn_timer_start(conn);
 		if (send_rst) {
 			csp_rdp_send_cmp(conn, NULL, RDP_ACK | RDP_RST, conn->rdp.snd_nxt, conn->rdp.rcv_cur);
 		}
@@ -1151,6 +1790,16 @@ void csp_rdp_set_opt(unsigned int window_size, unsigned int conn_timeout_ms,
 	csp_rdp_ack_delay_count = ack_delay_count;
 }
 
+void csp_rdp_set_ext_opt(unsigned int options) {
+	csp_rdp_ext_opt = options;
+}
+
+void csp_rdp_get_ext_opt(unsigned int * options) {
+
+	if (options)
+		*options = csp_rdp_ext_opt;
+}
+
 void csp_rdp_get_opt(unsigned int * window_size, unsigned int * conn_timeout_ms,
 		unsigned int * packet_timeout_ms, unsigned int * delayed_acks,
 		unsigned int * ack_timeout, unsigned int * ack_delay_count) {
@@ -1175,8 +1824,9 @@ void csp_rdp_conn_print(csp_conn_t * conn) {
 	if (conn == NULL)
 		return;
 
-	DEBUG_CPRINT(("\tRDP: S:%d (closed by 0x%x), rcv %u, snd %u, win %"PRIu32"\r\n",
-		conn->rdp.state, conn->rdp.closed_by, conn->rdp.rcv_cur, conn->rdp.snd_una, conn->rdp.window_size));
+	DEBUG_CPRINT(("\tRDP: S:%d (closed by 0x%x), rcv %u, snd %u, win %"PRIu32"/%"PRIu32", srtt %"PRIu32", rto %"PRIu32", opt 0x%"PRIx32"\r\n",
+		conn->rdp.state, conn->rdp.closed_by, conn->rdp.rcv_cur, conn->rdp.snd_una, conn->rdp.tx_window,
+		conn->rdp.window_max, conn->rdp.srtt >> 3, conn->rdp.rto, conn->rdp.options));
 
 }
 #endif // CSP_DEBUG
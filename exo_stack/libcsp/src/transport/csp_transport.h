@@ -38,7 +38,7 @@ int csp_rdp_close(csp_conn_t * conn, uint8_t closed_by);
 void csp_rdp_conn_print(csp_conn_t * conn);
 int csp_rdp_send(csp_conn_t * conn, csp_packet_t * packet);
 int csp_rdp_check_ack(csp_conn_t * conn);
-void csp_rdp_check_timeouts(csp_conn_t * conn);
+void csp_rdp_check_timeouts(void);
 void csp_rdp_flush_all(csp_conn_t * conn);
 void csp_rdp_free_resources(csp_conn_t * conn);
 
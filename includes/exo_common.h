@@ -100,6 +100,10 @@ typedef enum
     CSP_TASK1,           /*!< Task ID for the CSP task 1 */
     CSP_TASK2,           /*!< Task ID for the CSP task 2 */
     CSP_TASK3,           /*!< Task ID for the CSP task 3 */
+    CSP_TASK4,           /*!< Task ID for the CSP task 4 */
+    CSP_TASK5,           /*!< Task ID for the CSP task 5 */
+    CSP_TASK6,           /*!< Task ID for the CSP task 6 */
+    CSP_TASK7,           /*!< Task ID for the CSP task 7 */
     CSP_ETH_RX,          /*!< Task ID for the CSP Ethernet receive task */
     ETHERNET_TASK,       /*!< Task ID for the Ethernet task */
     USB_TASK,            /*!< Task ID for the USB task */
@@ -114,6 +118,7 @@ typedef enum
     OBC_MEM_DEBUG_TC,    /*!< Task ID for the OBC memory debug task */
     OBC_SENSOR_HDLR,     /*!< Task ID for the OBC sensor handler task */
     HAL_INTR_HDLR,       /*!< Task ID for the hardware interrupt handler */
+    IOAL_GPIO_EVT_HDLR,  /*!< Task ID for the linux GPIO edge event handler */
     OS_TASK_MAX          /*!< Maximum number of OS tasks */
 } e_exo_task_id;
 
@@ -0,0 +1,175 @@
+/**
+ * @file test_ahw_sim_adc.c
+ *
+ * @brief ADS7828 channel scan against the single channel reads on the simulated bus
+ *
+ * @copyright Copyright 2024 Antaris, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Every single ended input of the PS ADS7828 gets its own code. All channels
+ * are read once with ahw_al_ads7828_get_data() each and once with one
+ * ahw_al_ads7828_scan(), then a sparse channel mask is scanned. The samples
+ * have to come in channel order with the codes set and ticks that do not go
+ * backwards, and the full scan has to take fewer IO-AL calls.
+ *
+ * Usage: test_ahw_sim_adc
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "exo_hal_common.h"
+#include "exo_hal_io_al_common.h"
+#include "exo_io_al_i2c_common.h"
+#include "exo_ahw_al_data_acq_dvc_common.h"
+#include "exo_io_al_linux_i2c_sim.h"
+
+#define ADC_CHNLS           8       ///< Single ended channels
+#define ADC_SPARSE_MASK     0xA5    ///< Channels 0, 2, 5 and 7
+
+extern ahw_io_map *ahw_io_lookup_tble[MAX_AH_INST_ID];
+
+static const ahw_al_ads7828_chnl adc_se_chnl[ADC_CHNLS] =
+{
+    SE_CH0, SE_CH1, SE_CH2, SE_CH3, SE_CH4, SE_CH5, SE_CH6, SE_CH7
+}; ///< Single ended channel by input number
+
+static uint32_t adc_ticks;
+
+/**
+ * @brief Time stamp source of the scan, counts the calls
+ */
+static uint32_t adc_get_tick(void)
+{
+    return ++adc_ticks;
+}
+
+/**
+ * @brief Code set on an input
+ */
+static uint16_t adc_code(unsigned int idx)
+{
+    return (uint16_t)((idx * 0x1F3U) + 0x10U);
+}
+
+/**
+ * @brief Print the counters of one way of reading the channels
+ */
+static void adc_report(const char *tag, const lnx_i2c_sim_stats *stats)
+{
+    printf("  %-12s: %u IO-AL calls, %u transactions, %u bytes written, %u bytes read, %llu us bus time\n",
+           tag, stats->calls, stats->xfers, stats->wr_bytes, stats->rd_bytes, (unsigned long long)stats->bus_time_us);
+}
+
+/**
+ * @brief Check the samples of a scan against the channel mask and the input codes
+ */
+static int adc_check(uint8_t mask, const ahw_al_ads7828_sample *samples, uint8_t count)
+{
+    uint8_t n = 0;
+    int failed = 0;
+
+    for (unsigned int idx = 0; idx < ADC_CHNLS; idx++)
+    {
+        if ((mask & (1U << idx)) == 0)
+        {
+            continue;
+        }
+        if ((n >= count) || (samples[n].chnl != adc_se_chnl[idx]) || (samples[n].data != adc_code(idx)) ||
+            ((n > 0) && (samples[n].tick < samples[n - 1].tick)))
+        {
+            printf("  mask 0x%02x: sample %u is wrong for channel %u\n", mask, n, idx);
+            failed = 1;
+        }
+        n++;
+    }
+    if (n != count)
+    {
+        printf("  mask 0x%02x: %u samples, expected %u\n", mask, count, n);
+        failed = 1;
+    }
+    return failed;
+}
+
+int main(void)
+{
+    static ahw_al_ads7828_hdle adc;
+    ahw_al_ads7828_sample samples[ADC_CHNLS];
+    lnx_i2c_sim_stats single_stats;
+    lnx_i2c_sim_stats scan_stats;
+    lnx_i2c_sim_dev *dev;
+    uint8_t count = 0;
+    uint16_t data;
+    uint32 io_id;
+    int failed = 0;
+
+    setvbuf(stdout, NULL, _IONBF, 0);
+
+    ahw_io_lookup_table_updt();
+    io_hal_i2c_init();
+    io_id = ahw_io_lookup_tble[DATA_LOGGER_ADS7828_PS]->io_instance_id;
+    dev = io_hal_linux_i2c_sim_find(io_id, ahw_io_lookup_tble[DATA_LOGGER_ADS7828_PS]->slv_addr);
+    if ((dev == NULL) || (ahw_al_ads7828_init(&adc, DATA_LOGGER_ADS7828_PS) != HAL_SCS))
+    {
+        printf("FAIL: ADS7828 not found on the simulated bus\n");
+        return 1;
+    }
+    adc.get_tick = adc_get_tick;
+    for (unsigned int idx = 0; idx < ADC_CHNLS; idx++)
+    {
+        io_hal_linux_i2c_sim_set_input(dev, (uint8)idx, adc_code(idx));
+    }
+
+    io_hal_linux_i2c_sim_clear_stats(io_id);
+    for (unsigned int idx = 0; idx < ADC_CHNLS; idx++)
+    {
+        data = 0;
+        if ((ahw_al_ads7828_get_data(&adc, adc_se_chnl[idx], AL_INT_REF_ON_ADC_ON, &data) != HAL_SCS) ||
+            (data != adc_code(idx)))
+        {
+            printf("  channel %u: read %u, expected %u\n", idx, data, adc_code(idx));
+            failed = 1;
+        }
+    }
+    io_hal_linux_i2c_sim_get_stats(io_id, &single_stats);
+
+    io_hal_linux_i2c_sim_clear_stats(io_id);
+    if (ahw_al_ads7828_scan(&adc, 0xFF, AL_PD_DWN, samples, &count) != HAL_SCS)
+    {
+        printf("  scan of all channels failed\n");
+        failed = 1;
+    }
+    io_hal_linux_i2c_sim_get_stats(io_id, &scan_stats);
+    failed |= adc_check(0xFF, samples, count);
+
+    count = 0;
+    if (ahw_al_ads7828_scan(&adc, ADC_SPARSE_MASK, AL_PD_DWN, samples, &count) != HAL_SCS)
+    {
+        printf("  scan of mask 0x%02x failed\n", ADC_SPARSE_MASK);
+        failed = 1;
+    }
+    failed |= adc_check(ADC_SPARSE_MASK, samples, count);
+
+    printf("\nADS7828: %u channels\n", ADC_CHNLS);
+    adc_report("single reads", &single_stats);
+    adc_report("scan", &scan_stats);
+    if ((scan_stats.nacks != 0) || (scan_stats.calls >= single_stats.calls))
+    {
+        printf("  the scan does not save IO-AL calls\n");
+        failed = 1;
+    }
+    printf("%s\n", failed ? "FAIL" : "PASS");
+    return failed;
+}
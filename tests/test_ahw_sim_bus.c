@@ -0,0 +1,291 @@
+/**
+ * @file test_ahw_sim_bus.c
+ *
+ * @brief Simulated I2C bus under concurrent driver transactions and backdoor accesses
+ *
+ * @copyright Copyright 2024 Antaris, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * The OBC MCP9843 is read through the AHW driver in a loop while a second
+ * task changes its temperature input, removes faults and reads its registers
+ * and counters through the backdoor of the simulated bus. Every reading has
+ * to be one of the two temperatures set and the device counters have to add
+ * up to the transactions of one reading times the readings, so no model
+ * update or counter is torn by the concurrent accesses.
+ *
+ * The same sensor then runs through the faults and timing of the bus model:
+ * - a NACK injected after a number of transactions fails exactly the reading
+ *   it hits with a driver error and counts one nack, the next reading works;
+ * - a stuck bus reads 0xFF, the driver takes it for a valid -1/16 degree
+ *   reading and the writes of an alert configuration do not reach the device;
+ * - with real time timing the measured time of the readings follows the
+ *   latency model, which adds up to the bus time counted by the simulator.
+ *
+ * Usage: test_ahw_sim_bus [readings]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+#include <sched.h>
+#include "exo_hal_common.h"
+#include "exo_hal_io_al_common.h"
+#include "exo_io_al_i2c_common.h"
+#include "exo_ahw_al_temp_sensor_common.h"
+#include "exo_io_al_linux_i2c_sim.h"
+
+#define SIM_READINGS        20000   ///< Default driver readings
+#define SIM_TEMP_A          20000   ///< First temperature input in milli degree celsius
+#define SIM_TEMP_B          -30500  ///< Second temperature input, both are exact in 1/16 degree steps
+#define SIM_YIELD_EVERY     16      ///< Readings between yields, the tasks interleave on a single core too
+#define SIM_NACK_AFTER      10      ///< Readings completed before the injected NACK
+#define SIM_STUCK_MDEG      -62     ///< Reading of a stuck bus, 0xFFFF is -1/16 degree celsius
+#define SIM_TIMED_READINGS  200     ///< Readings with real time bus timing
+#define SIM_TIMED_XFER_US   500     ///< Time of start, address and stop of the timed readings
+#define SIM_TIMED_BYTE_US   20      ///< Time of one data byte of the timed readings
+
+extern ahw_io_map *ahw_io_lookup_tble[MAX_AH_INST_ID];
+
+static uint32_t sim_readings = SIM_READINGS;
+static lnx_i2c_sim_dev *sim_dev;
+static volatile int sim_done;
+static volatile uint32_t sim_pokes;
+
+/**
+ * @brief Monotonic time in micro seconds
+ */
+static uint64_t sim_now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000U) + ((uint64_t)ts.tv_nsec / 1000U);
+}
+
+/**
+ * @brief Backdoor task, toggles the input and reads the model state until the readings are done
+ */
+static void *sim_poker(void *arg)
+{
+    lnx_i2c_sim_stats stats;
+
+    (void)arg;
+    while (!sim_done)
+    {
+        io_hal_linux_i2c_sim_set_input(sim_dev, 0, ((sim_pokes & 1U) != 0U) ? SIM_TEMP_B : SIM_TEMP_A);
+        io_hal_linux_i2c_sim_inject_fault(sim_dev, LNX_I2C_SIM_FAULT_NONE, 0, 0);
+        io_hal_linux_i2c_sim_get_dev_stats(sim_dev, &stats);
+        (void)io_hal_linux_i2c_sim_get_reg(sim_dev, 5);
+        sim_pokes++;
+        sched_yield();
+    }
+    return NULL;
+}
+
+/**
+ * @brief NACK after SIM_NACK_AFTER readings, only the reading hit fails
+ */
+static uint32_t sim_check_nack(ahw_al_temp_sensor_hdl *ts, const lnx_i2c_sim_stats *one)
+{
+    lnx_i2c_sim_stats stats;
+    uint32_t errors = 0;
+    int32_t mdeg = 0;
+
+    io_hal_linux_i2c_sim_set_input(sim_dev, 0, SIM_TEMP_A);
+    io_hal_linux_i2c_sim_clear_stats(ahw_io_lookup_tble[TEMP_SENSOR_MCP9843_OBC]->io_instance_id);
+    io_hal_linux_i2c_sim_inject_fault(sim_dev, LNX_I2C_SIM_FAULT_NACK, SIM_NACK_AFTER * one->xfers, 1);
+    for (uint32_t i = 0; i <= SIM_NACK_AFTER + 1; i++)
+    {
+        const hal_ret_sts sts = ahw_al_temp_sensor_get_temperature_mdeg(ts, &mdeg);
+        if ((i == SIM_NACK_AFTER) ? (sts == HAL_SCS) : ((sts != HAL_SCS) || (mdeg != SIM_TEMP_A)))
+        {
+            printf("  NACK: reading %u returned %d, %d\n", (unsigned int)i, (int)sts, (int)mdeg);
+            errors++;
+        }
+    }
+    io_hal_linux_i2c_sim_get_dev_stats(sim_dev, &stats);
+    printf("NACK after %u readings: %u transactions, %u nacks\n", SIM_NACK_AFTER, stats.xfers, stats.nacks);
+    if ((stats.nacks != 1) || (stats.xfers != (((SIM_NACK_AFTER + 1) * one->xfers) + 1)))
+    {
+        printf("  expected 1 nack in %u transactions\n", (unsigned int)(((SIM_NACK_AFTER + 1) * one->xfers) + 1));
+        errors++;
+    }
+    return errors;
+}
+
+/**
+ * @brief Stuck bus, reads are 0xFF and writes are lost until the fault is removed
+ */
+static uint32_t sim_check_stuck(ahw_al_temp_sensor_hdl *ts)
+{
+    lnx_i2c_sim_stats stats;
+    uint32_t errors = 0;
+    uint16_t tupper = io_hal_linux_i2c_sim_get_reg(sim_dev, 2);     // T_UPPER
+    uint16_t tlower = io_hal_linux_i2c_sim_get_reg(sim_dev, 3);     // T_LOWER
+    int32_t stuck = 0;
+    int32_t mdeg = 0;
+
+    io_hal_linux_i2c_sim_set_input(sim_dev, 0, SIM_TEMP_A);
+    io_hal_linux_i2c_sim_clear_stats(ahw_io_lookup_tble[TEMP_SENSOR_MCP9843_OBC]->io_instance_id);
+    io_hal_linux_i2c_sim_inject_fault(sim_dev, LNX_I2C_SIM_FAULT_STUCK, 0, 0);
+    if ((ahw_al_temp_sensor_get_temperature_mdeg(ts, &stuck) != HAL_SCS) || (stuck != SIM_STUCK_MDEG))
+    {
+        printf("  stuck: reading %d, expected %d\n", (int)stuck, SIM_STUCK_MDEG);
+        errors++;
+    }
+    (void)ahw_al_temp_sensor_alert_cfg(ts, -40000, 80000, 100000, 0);
+    if ((io_hal_linux_i2c_sim_get_reg(sim_dev, 2) != tupper) || (io_hal_linux_i2c_sim_get_reg(sim_dev, 3) != tlower))
+    {
+        printf("  stuck: limit writes reached the device\n");
+        errors++;
+    }
+    io_hal_linux_i2c_sim_get_dev_stats(sim_dev, &stats);
+    io_hal_linux_i2c_sim_inject_fault(sim_dev, LNX_I2C_SIM_FAULT_NONE, 0, 0);
+    if ((ahw_al_temp_sensor_get_temperature_mdeg(ts, &mdeg) != HAL_SCS) || (mdeg != SIM_TEMP_A))
+    {
+        printf("  stuck: reading %d after the fault was removed\n", (int)mdeg);
+        errors++;
+    }
+    printf("stuck bus: reading %d mdeg, %u transactions, %u nacks\n", (int)stuck, stats.xfers, stats.nacks);
+    if (stats.nacks != 0)
+    {
+        errors++;
+    }
+    return errors;
+}
+
+/**
+ * @brief Real time bus timing, the readings take the time of the latency model
+ */
+static uint32_t sim_check_timing(ahw_al_temp_sensor_hdl *ts, const lnx_i2c_sim_stats *one)
+{
+    const uint32 io_id = ahw_io_lookup_tble[TEMP_SENSOR_MCP9843_OBC]->io_instance_id;
+    const uint64_t model = (uint64_t)SIM_TIMED_READINGS *
+                           ((one->xfers * SIM_TIMED_XFER_US) + ((one->wr_bytes + one->rd_bytes) * SIM_TIMED_BYTE_US));
+    lnx_i2c_sim_stats stats;
+    uint32_t errors = 0;
+    uint64_t start;
+    uint64_t elapsed;
+    int32_t mdeg = 0;
+
+    io_hal_linux_i2c_sim_set_timing(io_id, SIM_TIMED_XFER_US, SIM_TIMED_BYTE_US, 1);
+    io_hal_linux_i2c_sim_clear_stats(io_id);
+    start = sim_now_us();
+    for (uint32_t i = 0; i < SIM_TIMED_READINGS; i++)
+    {
+        if (ahw_al_temp_sensor_get_temperature_mdeg(ts, &mdeg) != HAL_SCS)
+        {
+            errors++;
+        }
+    }
+    elapsed = sim_now_us() - start;
+    io_hal_linux_i2c_sim_get_dev_stats(sim_dev, &stats);
+    io_hal_linux_i2c_sim_set_timing(io_id, LNX_I2C_SIM_XFER_US, LNX_I2C_SIM_BYTE_US, 0);
+
+    /* Sleeps only overshoot, allow them to double the time on a loaded host */
+    printf("timed: %u readings in %llu us, model %llu us, bus time %llu us\n", SIM_TIMED_READINGS,
+           (unsigned long long)elapsed, (unsigned long long)model, (unsigned long long)stats.bus_time_us);
+    if ((stats.bus_time_us != model) || (elapsed < model) || (elapsed > (2 * model)))
+    {
+        printf("  measured time does not follow the latency model\n");
+        errors++;
+    }
+    return errors;
+}
+
+int main(int argc, char **argv)
+{
+    static ahw_al_temp_sensor_hdl ts;
+    lnx_i2c_sim_stats one;
+    lnx_i2c_sim_stats total;
+    pthread_t poker;
+    uint32_t errors = 0;
+    uint64_t start;
+    uint64_t elapsed;
+    int32_t mdeg = 0;
+
+    setvbuf(stdout, NULL, _IONBF, 0);
+    if (argc > 1)
+    {
+        sim_readings = (uint32_t)strtoul(argv[1], NULL, 0);
+    }
+
+    ahw_io_lookup_table_updt();
+    io_hal_i2c_init();
+    sim_dev = io_hal_linux_i2c_sim_find(ahw_io_lookup_tble[TEMP_SENSOR_MCP9843_OBC]->io_instance_id,
+                                        ahw_io_lookup_tble[TEMP_SENSOR_MCP9843_OBC]->slv_addr);
+    if ((sim_dev == NULL) || (ahw_al_temp_sensor_init(&ts, TEMP_SENSOR_MCP9843_OBC) != HAL_SCS))
+    {
+        printf("FAIL: MCP9843 not found on the simulated bus\n");
+        return 1;
+    }
+
+    /* Transactions of one reading */
+    io_hal_linux_i2c_sim_set_input(sim_dev, 0, SIM_TEMP_A);
+    io_hal_linux_i2c_sim_clear_stats(ahw_io_lookup_tble[TEMP_SENSOR_MCP9843_OBC]->io_instance_id);
+    if ((ahw_al_temp_sensor_get_temperature_mdeg(&ts, &mdeg) != HAL_SCS) || (mdeg != SIM_TEMP_A))
+    {
+        printf("FAIL: reading %d, expected %d\n", (int)mdeg, SIM_TEMP_A);
+        return 1;
+    }
+    io_hal_linux_i2c_sim_get_dev_stats(sim_dev, &one);
+
+    io_hal_linux_i2c_sim_clear_stats(ahw_io_lookup_tble[TEMP_SENSOR_MCP9843_OBC]->io_instance_id);
+    pthread_create(&poker, NULL, sim_poker, NULL);
+    while (sim_pokes == 0)
+    {
+        sched_yield();
+    }
+    start = sim_now_us();
+    for (uint32_t i = 0; i < sim_readings; i++)
+    {
+        if ((i % SIM_YIELD_EVERY) == 0)
+        {
+            sched_yield();
+        }
+        if ((ahw_al_temp_sensor_get_temperature_mdeg(&ts, &mdeg) != HAL_SCS) ||
+            ((mdeg != SIM_TEMP_A) && (mdeg != SIM_TEMP_B)))
+        {
+            if (errors++ == 0)
+            {
+                printf("  reading %u: %d\n", (unsigned int)i, (int)mdeg);
+            }
+        }
+    }
+    elapsed = sim_now_us() - start;
+    sim_done = 1;
+    pthread_join(poker, NULL);
+    io_hal_linux_i2c_sim_get_dev_stats(sim_dev, &total);
+
+    printf("\nMCP9843: %u readings in %llu us, %u backdoor rounds\n", (unsigned int)sim_readings,
+           (unsigned long long)elapsed, (unsigned int)sim_pokes);
+    printf("  per reading: %u transactions, %u bytes written, %u bytes read, %llu us bus time\n",
+           one.xfers, one.wr_bytes, one.rd_bytes, (unsigned long long)one.bus_time_us);
+    printf("  total      : %u transactions, %u bytes written, %u bytes read, %u nacks, %llu us bus time\n",
+           total.xfers, total.wr_bytes, total.rd_bytes, total.nacks, (unsigned long long)total.bus_time_us);
+    if ((sim_pokes < 2) || (total.xfers != (one.xfers * sim_readings)) || (total.rd_bytes != (one.rd_bytes * sim_readings)) ||
+        (total.bus_time_us != (one.bus_time_us * sim_readings)) || (total.nacks != 0))
+    {
+        printf("  counters do not add up\n");
+        errors++;
+    }
+
+    errors += sim_check_nack(&ts, &one);
+    errors += sim_check_stuck(&ts);
+    errors += sim_check_timing(&ts, &one);
+    printf("%s\n", (errors == 0) ? "PASS" : "FAIL");
+    return (errors == 0) ? 0 : 1;
+}
@@ -0,0 +1,225 @@
+/**
+ * @file test_ahw_sim_imu.c
+ *
+ * @brief BMX160 FIFO streaming against the simulated I2C bus
+ *
+ * @copyright Copyright 2024 Antaris, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * The OBC 1 BMX160 streams accelerometer and gyroscope frames through its
+ * FIFO. For every batch the test pushes a watermark of header mode frames
+ * numbered by their sample through the backdoor of the simulated bus and
+ * sets the sensor time the device appends after the last frame, the sensor
+ * time wraps within the run. Each ahw_al_imu_fifo_stream_read() has to:
+ * - take two bus transactions, the byte counter and the FIFO data, against
+ *   two per sample when the same samples are polled;
+ * - return the samples of the batch oldest first with nothing skipped;
+ * - stamp the newest sample with the sensor time and the older ones one
+ *   sample period apart, modulo the 24-bit sensor time.
+ * Once streaming stops the read reports the FIFO as not ready.
+ *
+ * Usage: test_ahw_sim_imu [batches]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "exo_hal_common.h"
+#include "exo_hal_io_al_common.h"
+#include "exo_io_al_i2c_common.h"
+#include "exo_ahw_al_common.h"
+#include "exo_ahw_al_imu_common.h"
+#include "exo_io_al_linux_i2c_sim.h"
+
+#define IMU_BATCHES         16          ///< Default batches streamed
+#define IMU_WATERMARK       32          ///< Frames per batch
+#define IMU_FRAME_HEAD_G_A  0x8C        ///< Header of a frame with gyroscope then accelerometer data
+#define IMU_FRAME_BYTES     13          ///< Header and both samples
+#define IMU_FIFO_DATA       0x24        ///< FIFO_DATA, a backdoor write pushes one byte
+#define IMU_ACC_CONF        0x40        ///< Accelerometer ODR in the low nibble
+#define IMU_GYR_CONF        0x42        ///< Gyroscope ODR in the low nibble
+#define IMU_FIFO_CONFIG_0   0x46        ///< Watermark in units of 4 bytes
+#define IMU_FIFO_CONFIG_1   0x47        ///< Gyro, accel, header and time enables
+#define IMU_FIFO_CFG_STREAM 0xD2        ///< Gyro, accel, header mode and sensor time
+#define IMU_FIFO_CFG_SENSOR 0xC0        ///< Gyro and accel enables, cleared when streaming stops
+#define IMU_SENSORTIME      0x18        ///< Sensor time, LSB first
+#define IMU_SENSORTIME_MASK 0xFFFFFFU
+#define IMU_TIME_START      (IMU_SENSORTIME_MASK - (3U * IMU_WATERMARK * 256U))    ///< Wraps in the fourth batch
+
+extern ahw_io_map *ahw_io_lookup_tble[MAX_AH_INST_ID];
+
+static lnx_i2c_sim_dev *imu_dev;
+
+/**
+ * @brief Push one little endian axis into the FIFO
+ */
+static void imu_push16(int16 val)
+{
+    io_hal_linux_i2c_sim_set_reg(imu_dev, IMU_FIFO_DATA, (uint16)val & 0xFF);
+    io_hal_linux_i2c_sim_set_reg(imu_dev, IMU_FIFO_DATA, ((uint16)val >> 8) & 0xFF);
+}
+
+/**
+ * @brief Axis values of sample n, gyroscope axes are offset from the accelerometer ones
+ */
+static int16 imu_axis(uint32_t n, uint8 axis, uint8 gyro)
+{
+    return (int16)((int32)(n * 3U + axis) * ((axis == 1) ? -1 : 1) + (gyro ? 10000 : 0));
+}
+
+/**
+ * @brief Check the samples of one sensor against the frames pushed
+ */
+static uint32_t imu_check(const char *tag, const imu_sensor_data *data, uint8 len, uint8 gyro, uint32_t first,
+                          uint32_t time, uint32_t period)
+{
+    uint32_t errors = 0;
+
+    if (len != IMU_WATERMARK)
+    {
+        printf("  %s: %u samples, expected %u\n", tag, (unsigned int)len, IMU_WATERMARK);
+        return 1;
+    }
+    for (uint8 i = 0; i < len; i++)
+    {
+        const uint32_t n = first + i;
+        const uint32_t stamp = (time - ((uint32_t)(len - 1 - i) * period)) & IMU_SENSORTIME_MASK;
+        if ((data[i].x != imu_axis(n, 0, gyro)) || (data[i].y != imu_axis(n, 1, gyro)) ||
+            (data[i].z != imu_axis(n, 2, gyro)) || (data[i].sensortime != stamp))
+        {
+            if (errors++ == 0)
+            {
+                printf("  %s sample %u: %d %d %d at %u, expected sample %u at %u\n", tag, (unsigned int)i, data[i].x,
+                       data[i].y, data[i].z, (unsigned int)data[i].sensortime, (unsigned int)n, (unsigned int)stamp);
+            }
+        }
+    }
+    return errors;
+}
+
+int main(int argc, char **argv)
+{
+    static imu_fifo_batch batch;
+    imu_fifo_stream_cfg cfg = { IMU_BOTH_ACCEL_AND_GYRO, IMU_WATERMARK };
+    lnx_i2c_sim_stats polled;
+    lnx_i2c_sim_stats stats;
+    ahw_al_imu_hdle *himu;
+    uint32_t batches = IMU_BATCHES;
+    uint32_t errors = 0;
+    uint32_t xfers = 0;
+    uint32_t period;
+    uint16 odr;
+    uint32 io_id;
+
+    setvbuf(stdout, NULL, _IONBF, 0);
+    if (argc > 1)
+    {
+        batches = (uint32_t)strtoul(argv[1], NULL, 0);
+    }
+
+    ahw_io_lookup_table_updt();
+    io_hal_i2c_init();
+    io_id = ahw_io_lookup_tble[IMU_BMX160_OBC_1]->io_instance_id;
+    imu_dev = io_hal_linux_i2c_sim_find(io_id, ahw_io_lookup_tble[IMU_BMX160_OBC_1]->slv_addr);
+    (void)ahw_al_imu_init();
+    himu = (ahw_al_imu_hdle *)ahal_get_hdle(IMU_BMX160_OBC_1);
+    if ((imu_dev == NULL) || (himu == NULL))
+    {
+        printf("FAIL: BMX160 not found on the simulated bus\n");
+        return 1;
+    }
+
+    /* Sensor time ticks are 39.0625 us, 256 per sample at 100 Hz (ODR code 8) */
+    odr = io_hal_linux_i2c_sim_get_reg(imu_dev, IMU_ACC_CONF) & 0x0F;
+    if ((odr < 8) || (odr != (io_hal_linux_i2c_sim_get_reg(imu_dev, IMU_GYR_CONF) & 0x0F)))
+    {
+        printf("FAIL: accel and gyro ODR codes 0x%02x and 0x%02x\n", io_hal_linux_i2c_sim_get_reg(imu_dev, IMU_ACC_CONF),
+               io_hal_linux_i2c_sim_get_reg(imu_dev, IMU_GYR_CONF));
+        return 1;
+    }
+    period = 256U >> (odr - 8U);
+
+    /* Polling the same number of samples */
+    io_hal_linux_i2c_sim_clear_stats(io_id);
+    for (uint32_t i = 0; i < IMU_WATERMARK; i++)
+    {
+        (void)ahw_al_imu_get_sensor_data(himu);
+    }
+    io_hal_linux_i2c_sim_get_dev_stats(imu_dev, &polled);
+
+    if ((ahw_al_imu_fifo_stream_start(&cfg, himu) != HAL_SCS) ||
+        (io_hal_linux_i2c_sim_get_reg(imu_dev, IMU_FIFO_CONFIG_1) != IMU_FIFO_CFG_STREAM) ||
+        (io_hal_linux_i2c_sim_get_reg(imu_dev, IMU_FIFO_CONFIG_0) != ((IMU_WATERMARK * IMU_FRAME_BYTES + 3) / 4)))
+    {
+        printf("FAIL: FIFO configuration 0x%02x, watermark %u\n", io_hal_linux_i2c_sim_get_reg(imu_dev, IMU_FIFO_CONFIG_1),
+               io_hal_linux_i2c_sim_get_reg(imu_dev, IMU_FIFO_CONFIG_0));
+        return 1;
+    }
+
+    for (uint32_t b = 0; b < batches; b++)
+    {
+        const uint32_t first = b * IMU_WATERMARK;
+        const uint32_t time = (IMU_TIME_START + ((first + IMU_WATERMARK - 1) * period)) & IMU_SENSORTIME_MASK;
+
+        for (uint32_t n = first; n < (first + IMU_WATERMARK); n++)
+        {
+            io_hal_linux_i2c_sim_set_reg(imu_dev, IMU_FIFO_DATA, IMU_FRAME_HEAD_G_A);
+            for (uint8 axis = 0; axis < 3; axis++)
+            {
+                imu_push16(imu_axis(n, axis, 1));
+            }
+            for (uint8 axis = 0; axis < 3; axis++)
+            {
+                imu_push16(imu_axis(n, axis, 0));
+            }
+        }
+        for (uint8 i = 0; i < 3; i++)
+        {
+            io_hal_linux_i2c_sim_set_reg(imu_dev, IMU_SENSORTIME + i, (time >> (8 * i)) & 0xFF);
+        }
+
+        io_hal_linux_i2c_sim_clear_stats(io_id);
+        if (ahw_al_imu_fifo_stream_read(&batch, himu) != HAL_SCS)
+        {
+            printf("  batch %u: read failed\n", (unsigned int)b);
+            errors++;
+            continue;
+        }
+        io_hal_linux_i2c_sim_get_dev_stats(imu_dev, &stats);
+        xfers += stats.xfers;
+        errors += imu_check("accel", batch.accel, batch.accel_len, 0, first, time, period);
+        errors += imu_check("gyro", batch.gyro, batch.gyro_len, 1, first, time, period);
+        if ((stats.xfers != 2) || (batch.skipped_frames != 0) || (batch.sensortime != time))
+        {
+            printf("  batch %u: %u transactions, %u skipped, sensor time %u, expected %u\n", (unsigned int)b,
+                   stats.xfers, (unsigned int)batch.skipped_frames, (unsigned int)batch.sensortime, (unsigned int)time);
+            errors++;
+        }
+    }
+
+    if ((ahw_al_imu_fifo_stream_stop(himu) != HAL_SCS) || (ahw_al_imu_fifo_stream_read(&batch, himu) != HAL_AH_NOT_READY) ||
+        (io_hal_linux_i2c_sim_get_reg(imu_dev, IMU_FIFO_CONFIG_1) & IMU_FIFO_CFG_SENSOR))
+    {
+        printf("  streaming did not stop\n");
+        errors++;
+    }
+
+    printf("\nBMX160: %u batches of %u accel and gyro samples, %u ticks apart\n", (unsigned int)batches, IMU_WATERMARK,
+           (unsigned int)period);
+    printf("  polled  : %u transactions, %u bytes read for %u samples\n", polled.xfers, polled.rd_bytes, IMU_WATERMARK);
+    printf("  streamed: %u transactions per batch\n", (batches != 0) ? (unsigned int)(xfers / batches) : 0U);
+    printf("%s\n", (errors == 0) ? "PASS" : "FAIL");
+    return (errors == 0) ? 0 : 1;
+}
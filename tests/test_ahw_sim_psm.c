@@ -0,0 +1,115 @@
+/**
+ * @file test_ahw_sim_psm.c
+ *
+ * @brief INA230 measurement snapshot against the single value reads on the simulated bus
+ *
+ * @copyright Copyright 2024 Antaris, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * The OBC INA230 gets fixed shunt and bus voltage inputs, then its shunt
+ * voltage, bus voltage, power and current are read once with a getter each
+ * and once with ahw_al_psm_get_snapshot(). Both have to return the same
+ * values and the snapshot has to take fewer bus transactions.
+ *
+ * Usage: test_ahw_sim_psm
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "exo_hal_common.h"
+#include "exo_hal_io_al_common.h"
+#include "exo_io_al_i2c_common.h"
+#include "exo_ahw_al_psm_common.h"
+#include "exo_io_al_linux_i2c_sim.h"
+
+#define PSM_VSHUNT_CODE     2000    ///< Shunt voltage input, 2.5 uV steps
+#define PSM_VBUS_CODE       4000    ///< Bus voltage input, 1.25 mV steps
+
+extern ahw_io_map *ahw_io_lookup_tble[MAX_AH_INST_ID];
+
+/**
+ * @brief Print the counters of one way of reading the measurements
+ */
+static void psm_report(const char *tag, const lnx_i2c_sim_stats *stats)
+{
+    printf("  %-9s: %u IO-AL calls, %u transactions, %u bytes written, %u bytes read, %llu us bus time\n",
+           tag, stats->calls, stats->xfers, stats->wr_bytes, stats->rd_bytes, (unsigned long long)stats->bus_time_us);
+}
+
+int main(void)
+{
+    static ahw_al_psm_hdle psm;
+    ahw_al_psm_tc_config_t cfg;
+    ahw_al_psm_snapshot_t single;
+    ahw_al_psm_snapshot_t snap;
+    lnx_i2c_sim_stats single_stats;
+    lnx_i2c_sim_stats snap_stats;
+    lnx_i2c_sim_dev *dev;
+    uint32 io_id;
+    int failed = 0;
+
+    setvbuf(stdout, NULL, _IONBF, 0);
+    memset(&cfg, 0, sizeof(cfg));
+    memset(&snap, 0, sizeof(snap));
+
+    ahw_io_lookup_table_updt();
+    io_hal_i2c_init();
+    io_id = ahw_io_lookup_tble[PSM_INA230_OBC]->io_instance_id;
+    dev = io_hal_linux_i2c_sim_find(io_id, ahw_io_lookup_tble[PSM_INA230_OBC]->slv_addr);
+    if ((dev == NULL) || (ahw_al_psm_init(&psm, PSM_INA230_OBC, &cfg) != HAL_SCS))
+    {
+        printf("FAIL: INA230 not found on the simulated bus\n");
+        return 1;
+    }
+    io_hal_linux_i2c_sim_set_input(dev, 0, PSM_VSHUNT_CODE);
+    io_hal_linux_i2c_sim_set_input(dev, 1, PSM_VBUS_CODE);
+
+    /* The bus counters include the calls, the device counters do not */
+    io_hal_linux_i2c_sim_clear_stats(io_id);
+    single.vshunt = ahw_al_psm_get_vshunt(&psm);
+    single.vbus = ahw_al_psm_get_vbus(&psm);
+    single.power = ahw_al_psm_get_power(&psm);
+    single.current = ahw_al_psm_get_current(&psm);
+    io_hal_linux_i2c_sim_get_stats(io_id, &single_stats);
+
+    io_hal_linux_i2c_sim_clear_stats(io_id);
+    if (ahw_al_psm_get_snapshot(&psm, &snap) != HAL_SCS)
+    {
+        printf("  snapshot failed\n");
+        failed = 1;
+    }
+    io_hal_linux_i2c_sim_get_stats(io_id, &snap_stats);
+
+    printf("\nINA230: vshunt %f, vbus %f V, power %u mW, current %f A\n",
+           snap.vshunt, snap.vbus, (unsigned int)snap.power, snap.current);
+    psm_report("getters", &single_stats);
+    psm_report("snapshot", &snap_stats);
+
+    if ((snap.vshunt != single.vshunt) || (snap.vbus != single.vbus) ||
+        (snap.power != single.power) || (snap.current != single.current))
+    {
+        printf("  getters read vshunt %f, vbus %f V, power %u mW, current %f A\n",
+               single.vshunt, single.vbus, (unsigned int)single.power, single.current);
+        failed = 1;
+    }
+    if ((snap_stats.nacks != 0) || (snap_stats.xfers >= single_stats.xfers))
+    {
+        printf("  the snapshot does not save transactions\n");
+        failed = 1;
+    }
+    printf("%s\n", failed ? "FAIL" : "PASS");
+    return failed;
+}
@@ -0,0 +1,243 @@
+/**
+ * @file test_ahw_sim_temp.c
+ *
+ * @brief DS620 and MCP9843 fixed-point temperatures and alert driven sampling on the simulated bus
+ *
+ * @copyright Copyright 2024 Antaris, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Both parts convert in 1/16 degree steps. For a sweep of temperatures the
+ * milli degree API has to return the simulated code times 62.5 and agree
+ * with the floating point API within half a milli degree.
+ *
+ * In alert mode a poll has to return the cached temperature without bus
+ * access until the alert is notified, the poll after it has to read the new
+ * temperature and the high limit flag.
+ *
+ * Usage: test_ahw_sim_temp
+ */
+
+#include <stdio.h>
+#include <math.h>
+#include "exo_hal_common.h"
+#include "exo_hal_io_al_common.h"
+#include "exo_io_al_i2c_common.h"
+#include "exo_ahw_al_temp_sensor_common.h"
+#include "exo_ahw_al_dt_common.h"
+#include "exo_io_al_linux_i2c_sim.h"
+
+#define TEMP_ALERT_LOW      0       ///< Low limit in milli degree celsius
+#define TEMP_ALERT_HIGH     50000   ///< High limit in milli degree celsius
+#define TEMP_ALERT_CRIT     100000  ///< Critical limit of the MCP9843 in milli degree celsius
+#define TEMP_IN_RANGE       25000   ///< Temperature between the limits
+#define TEMP_ABOVE_HIGH     60000   ///< Temperature above the high limit
+#define TEMP_ALERT_HIGH_FLG 0x02    ///< High limit flag of both parts in alert_sts
+
+extern ahw_io_map *ahw_io_lookup_tble[MAX_AH_INST_ID];
+
+/* Temperatures in milli degree celsius, on and between the 1/16 degree steps */
+static const int32_t temp_sweep[] =
+{
+    -55000, -40000, -12563, -1000, -62, -1, 0, 1, 62, 63, 1000, 23456, 41250, 85000, 124937, 125000
+};
+
+/**
+ * @brief Milli degrees the drivers return for an input, the simulated parts round down to 1/16 degree
+ */
+static int32_t temp_expected(int32_t mdeg)
+{
+    int32_t t = mdeg * 16;
+    int32_t code = (t >= 0) ? (t / 1000) : -((-t + 999) / 1000);
+    return (code * 125) / 2;
+}
+
+/**
+ * @brief Simulated device of an AHW instance
+ */
+static lnx_i2c_sim_dev *temp_dev(ahw_inst_id_t id)
+{
+    return io_hal_linux_i2c_sim_find(ahw_io_lookup_tble[id]->io_instance_id, ahw_io_lookup_tble[id]->slv_addr);
+}
+
+/**
+ * @brief Transactions of a device since the counters of its bus were cleared
+ */
+static uint32_t temp_xfers(lnx_i2c_sim_dev *dev)
+{
+    lnx_i2c_sim_stats stats;
+    io_hal_linux_i2c_sim_get_dev_stats(dev, &stats);
+    return stats.xfers;
+}
+
+/**
+ * @brief Checks one conversion result against the input and the floating point result
+ */
+static int temp_check(const char *part, int32_t in, hal_ret_sts sts, int32_t mdeg, double deg)
+{
+    if ((sts != HAL_SCS) || (mdeg != temp_expected(in)) || (fabs((deg * 1000.0) - (double)mdeg) > 0.5))
+    {
+        printf("  %s: input %d, read %d mdeg and %f deg, expected %d mdeg\n", part, (int)in, (int)mdeg, deg,
+               (int)temp_expected(in));
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Alert driven sampling of the MCP9843
+ */
+static int temp_alert_mcp9843(ahw_al_temp_sensor_hdl *ts, lnx_i2c_sim_dev *dev, uint32 io_id)
+{
+    int32_t mdeg = 0;
+    uint8_t alert = 0;
+    uint32_t idle_xfers;
+    uint32_t alert_xfers;
+    int failed = 0;
+
+    io_hal_linux_i2c_sim_set_input(dev, 0, TEMP_IN_RANGE);
+    if ((ahw_al_temp_sensor_alert_cfg(ts, TEMP_ALERT_LOW, TEMP_ALERT_HIGH, TEMP_ALERT_CRIT, 0) != HAL_SCS) ||
+        (ahw_al_temp_sensor_alert_poll(ts, &mdeg, &alert) != HAL_SCS) || (mdeg != TEMP_IN_RANGE) || (alert != 0))
+    {
+        printf("  MCP9843: first alert mode poll read %d mdeg, flags 0x%x\n", (int)mdeg, alert);
+        failed = 1;
+    }
+
+    io_hal_linux_i2c_sim_clear_stats(io_id);
+    io_hal_linux_i2c_sim_set_input(dev, 0, TEMP_ABOVE_HIGH);
+    if ((ahw_al_temp_sensor_alert_poll(ts, &mdeg, &alert) != HAL_SCS) || (mdeg != TEMP_IN_RANGE))
+    {
+        printf("  MCP9843: poll without alert read %d mdeg\n", (int)mdeg);
+        failed = 1;
+    }
+    idle_xfers = temp_xfers(dev);
+
+    ahw_al_temp_sensor_alert_notify(ts);
+    if ((ahw_al_temp_sensor_alert_poll(ts, &mdeg, &alert) != HAL_SCS) || (mdeg != TEMP_ABOVE_HIGH) ||
+        ((alert & TEMP_ALERT_HIGH_FLG) == 0))
+    {
+        printf("  MCP9843: poll after the alert read %d mdeg, flags 0x%x\n", (int)mdeg, alert);
+        failed = 1;
+    }
+    alert_xfers = temp_xfers(dev) - idle_xfers;
+
+    printf("  MCP9843 alert mode: %u transactions without alert, %u after it\n", idle_xfers, alert_xfers);
+    if (idle_xfers != 0)
+    {
+        failed = 1;
+    }
+    return failed;
+}
+
+/**
+ * @brief Alert driven sampling of the DS620
+ */
+static int temp_alert_ds620(ahw_al_dt_hdle *dt, lnx_i2c_sim_dev *dev, uint32 io_id)
+{
+    int32_t mdeg = 0;
+    uint8_t alert = 0;
+    uint32_t idle_xfers;
+    uint32_t alert_xfers;
+    int failed = 0;
+
+    io_hal_linux_i2c_sim_set_input(dev, 0, TEMP_IN_RANGE);
+    if ((ahw_al_dt_alert_cfg(dt, TEMP_ALERT_LOW, TEMP_ALERT_HIGH, 0) != HAL_SCS) ||
+        (ahw_al_dt_alert_poll(dt, &mdeg, &alert) != HAL_SCS) || (mdeg != TEMP_IN_RANGE) || (alert != 0))
+    {
+        printf("  DS620: first alert mode poll read %d mdeg, flags 0x%x\n", (int)mdeg, alert);
+        failed = 1;
+    }
+
+    io_hal_linux_i2c_sim_clear_stats(io_id);
+    io_hal_linux_i2c_sim_set_input(dev, 0, TEMP_ABOVE_HIGH);
+    if ((ahw_al_dt_alert_poll(dt, &mdeg, &alert) != HAL_SCS) || (mdeg != TEMP_IN_RANGE))
+    {
+        printf("  DS620: poll without alert read %d mdeg\n", (int)mdeg);
+        failed = 1;
+    }
+    idle_xfers = temp_xfers(dev);
+
+    ahw_al_dt_alert_notify(dt);
+    if ((ahw_al_dt_alert_poll(dt, &mdeg, &alert) != HAL_SCS) || (mdeg != TEMP_ABOVE_HIGH) ||
+        ((alert & TEMP_ALERT_HIGH_FLG) == 0))
+    {
+        printf("  DS620: poll after the alert read %d mdeg, flags 0x%x\n", (int)mdeg, alert);
+        failed = 1;
+    }
+    alert_xfers = temp_xfers(dev) - idle_xfers;
+
+    printf("  DS620 alert mode  : %u transactions without alert, %u after it\n", idle_xfers, alert_xfers);
+    if (idle_xfers != 0)
+    {
+        failed = 1;
+    }
+    return failed;
+}
+
+int main(void)
+{
+    static ahw_al_temp_sensor_hdl ts;
+    static ahw_al_dt_hdle dt;
+    lnx_i2c_sim_dev *ts_dev;
+    lnx_i2c_sim_dev *dt_dev;
+    int failed = 0;
+
+    setvbuf(stdout, NULL, _IONBF, 0);
+
+    ahw_io_lookup_table_updt();
+    io_hal_i2c_init();
+    ts_dev = temp_dev(TEMP_SENSOR_MCP9843_OBC);
+    dt_dev = temp_dev(DIGITAL_THERMOSTAT_DS620_PS);
+    if ((ts_dev == NULL) || (dt_dev == NULL) ||
+        (ahw_al_temp_sensor_init(&ts, TEMP_SENSOR_MCP9843_OBC) != HAL_SCS) ||
+        (ahw_al_dt_init(&dt, DIGITAL_THERMOSTAT_DS620_PS) != HAL_SCS))
+    {
+        printf("FAIL: temperature sensors not found on the simulated bus\n");
+        return 1;
+    }
+
+    for (unsigned int i = 0; i < (sizeof(temp_sweep) / sizeof(temp_sweep[0])); i++)
+    {
+        int32_t mdeg = 0;
+        float deg_f = 0.0f;
+        double deg = 0.0;
+        hal_ret_sts sts;
+
+        io_hal_linux_i2c_sim_set_input(ts_dev, 0, temp_sweep[i]);
+        sts = ahw_al_temp_sensor_get_temperature_mdeg(&ts, &mdeg);
+        if (sts == HAL_SCS)
+        {
+            sts = ahw_al_temp_sensor_gettemperature(&ts, &deg_f);
+        }
+        failed |= temp_check("MCP9843", temp_sweep[i], sts, mdeg, (double)deg_f);
+
+        io_hal_linux_i2c_sim_set_input(dt_dev, 0, temp_sweep[i]);
+        sts = ahw_al_dt_get_temperature_mdeg(&dt, &mdeg);
+        if (sts == HAL_SCS)
+        {
+            sts = ahw_al_dt_get_temperature(&dt, &deg);
+        }
+        failed |= temp_check("DS620", temp_sweep[i], sts, mdeg, deg);
+    }
+    printf("\nMCP9843 and DS620: %u temperatures from %d to %d mdeg\n",
+           (unsigned int)(sizeof(temp_sweep) / sizeof(temp_sweep[0])), (int)temp_sweep[0],
+           (int)temp_sweep[(sizeof(temp_sweep) / sizeof(temp_sweep[0])) - 1]);
+
+    failed |= temp_alert_mcp9843(&ts, ts_dev, ahw_io_lookup_tble[TEMP_SENSOR_MCP9843_OBC]->io_instance_id);
+    failed |= temp_alert_ds620(&dt, dt_dev, ahw_io_lookup_tble[DIGITAL_THERMOSTAT_DS620_PS]->io_instance_id);
+
+    printf("%s\n", failed ? "FAIL" : "PASS");
+    return failed;
+}
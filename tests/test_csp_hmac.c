@@ -0,0 +1,274 @@
+/**
+ * @file test_csp_hmac.c
+ *
+ * @brief HMAC-SHA1 known answers and packet authentication throughput
+ *
+ * @copyright Copyright 2024 Antaris, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * csp_hmac_memory() has to reproduce the seven HMAC-SHA1 test cases of
+ * RFC 2202. The packet tags of csp_hmac_append() come from the key pads
+ * precomputed by csp_hmac_set_key(), for every test case they have to match
+ * the tag the pads were computed for on each packet before: HMAC-SHA1 with
+ * the first 16 bytes of SHA1(key), over the data or over the header and the
+ * data, truncated to CSP_HMAC_LENGTH bytes. csp_hmac_verify() has to accept
+ * the tags and reject a flipped bit.
+ *
+ * The benchmark then tags packets of several sizes with the pads computed
+ * per packet, with the precomputed pads and with SipHash. The precomputed
+ * pads have to be faster than computing them per packet.
+ *
+ * Usage: test_csp_hmac [packets]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "exo_common.h"
+#include "csp.h"
+#include "csp_hmac.h"
+#include "csp_sha1.h"
+
+#define HMAC_PACKETS        20000   ///< Default packets tagged per size and method
+#define HMAC_KEY_LENGTH     16      ///< Bytes of SHA1(key) used as the packet key
+#define HMAC_ROUNDS         3       ///< Timed rounds, the fastest one counts
+
+/**
+ * @brief RFC 2202 test case
+ */
+typedef struct
+{
+    uint8_t key_byte;               ///< Key filled with this byte, 0 for the key string
+    uint32_t key_len;
+    const char *key;
+    uint8_t data_byte;              ///< Data filled with this byte, 0 for the data string
+    uint32_t data_len;
+    const char *data;
+    const char *digest;             ///< Expected HMAC-SHA1 in hex
+} hmac_kat;
+
+/* Test case 4 uses the key 0x01 to 0x19, flagged by key_byte 0x01 */
+static const hmac_kat hmac_kats[] =
+{
+    {0x0b, 20, NULL, 0, 8, "Hi There", "b617318655057264e28bc0b6fb378c8ef146be00"},
+    {0, 4, "Jefe", 0, 28, "what do ya want for nothing?", "effcdf6ae5eb2fa2d27416d5f184df9c259a7c79"},
+    {0xaa, 20, NULL, 0xdd, 50, NULL, "125d7342b9ac11cd91a39af48aa17b4f63f175d3"},
+    {0x01, 25, NULL, 0xcd, 50, NULL, "4c9007f4026250c6bc8414f9bf50c86c2d7235da"},
+    {0x0c, 20, NULL, 0, 20, "Test With Truncation", "4c1a03424b55e07fe7f27be1d58bb9324a9a5a04"},
+    {0xaa, 80, NULL, 0, 54, "Test Using Larger Than Block-Size Key - Hash Key First",
+     "aa4ae5e15272d00e95705637ce8a3b55ed402112"},
+    {0xaa, 80, NULL, 0, 73, "Test Using Larger Than Block-Size Key and Larger Than One Block-Size Data",
+     "e8e99d0f45237d786d6bbaa7965c7808bbff1a91"},
+};
+
+/**
+ * @brief Ways of tagging a packet in the benchmark
+ */
+typedef enum
+{
+    HMAC_PER_PACKET,                ///< csp_hmac_memory(), key pads hashed for every packet
+    HMAC_PRECOMPUTED,               ///< csp_hmac_append(), key pads from csp_hmac_set_key()
+    HMAC_SIPHASH,                   ///< csp_hmac_append() with CSP_FSIPHASH
+} hmac_method;
+
+static const uint32_t hmac_sizes[] = {16, 64, 200};
+
+/**
+ * @brief Monotonic time in nano seconds
+ */
+static uint64_t hmac_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000U) + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Expand the key and data of a test case
+ */
+static void hmac_kat_expand(const hmac_kat *kat, uint8_t *key, uint8_t *data)
+{
+    for (uint32_t i = 0; i < kat->key_len; i++)
+    {
+        key[i] = (kat->key != NULL) ? (uint8_t)kat->key[i] : ((kat->key_byte == 0x01) ? (uint8_t)(i + 1) : kat->key_byte);
+    }
+    for (uint32_t i = 0; i < kat->data_len; i++)
+    {
+        data[i] = (kat->data != NULL) ? (uint8_t)kat->data[i] : kat->data_byte;
+    }
+}
+
+/**
+ * @brief Tag a packet the way append did before the pads were precomputed
+ */
+static void hmac_reference_tag(const uint8_t *key, const csp_packet_t *packet, bool include_header, uint8_t *tag)
+{
+    uint8_t hmac[CSP_SHA1_DIGESTSIZE];
+
+    if (include_header)
+    {
+        csp_hmac_memory(key, HMAC_KEY_LENGTH, &packet->id, packet->length + sizeof(packet->id), hmac);
+    }
+    else
+    {
+        csp_hmac_memory(key, HMAC_KEY_LENGTH, packet->data, packet->length, hmac);
+    }
+    memcpy(tag, hmac, CSP_HMAC_LENGTH);
+}
+
+/**
+ * @brief Known answers of csp_hmac_memory() and of the packet tags
+ */
+static int hmac_check_kats(csp_packet_t *packet)
+{
+    int failed = 0;
+
+    for (unsigned int k = 0; k < (sizeof(hmac_kats) / sizeof(hmac_kats[0])); k++)
+    {
+        const hmac_kat *kat = &hmac_kats[k];
+        uint8_t key[80];
+        uint8_t data[80];
+        uint8_t digest[CSP_SHA1_DIGESTSIZE];
+        uint8_t packet_key[CSP_SHA1_DIGESTSIZE];
+        char hex[(2 * CSP_SHA1_DIGESTSIZE) + 1];
+
+        hmac_kat_expand(kat, key, data);
+        csp_hmac_memory(key, kat->key_len, data, kat->data_len, digest);
+        for (unsigned int i = 0; i < CSP_SHA1_DIGESTSIZE; i++)
+        {
+            sprintf(&hex[2 * i], "%02x", digest[i]);
+        }
+        printf("  RFC 2202 case %u: %s %s\n", k + 1, hex, (strcmp(hex, kat->digest) == 0) ? "ok" : "MISMATCH");
+        failed |= (strcmp(hex, kat->digest) != 0);
+
+        /* Packet tags with the precomputed pads against the tags of csp_hmac_memory() */
+        csp_sha1_memory(key, kat->key_len, packet_key);
+        csp_hmac_set_key(key, kat->key_len);
+        for (int include_header = 0; include_header <= 1; include_header++)
+        {
+            uint8_t tag[CSP_HMAC_LENGTH];
+
+            memcpy(packet->data, data, kat->data_len);
+            packet->length = kat->data_len;
+            hmac_reference_tag(packet_key, packet, include_header, tag);
+            if ((csp_hmac_append(packet, include_header) != CSP_ERR_NONE) ||
+                (memcmp(&packet->data[kat->data_len], tag, CSP_HMAC_LENGTH) != 0))
+            {
+                printf("  case %u: packet tag differs from the per packet HMAC, header %d\n", k + 1, include_header);
+                failed = 1;
+            }
+            if ((csp_hmac_verify(packet, include_header) != CSP_ERR_NONE) || (packet->length != kat->data_len))
+            {
+                printf("  case %u: tag not verified, header %d\n", k + 1, include_header);
+                failed = 1;
+            }
+            csp_hmac_append(packet, include_header);
+            packet->data[0] ^= 0x01;
+            if (csp_hmac_verify(packet, include_header) != CSP_ERR_HMAC)
+            {
+                printf("  case %u: flipped bit verified, header %d\n", k + 1, include_header);
+                failed = 1;
+            }
+        }
+    }
+    return failed;
+}
+
+/**
+ * @brief Fastest time of tagging packets of one size, in nano seconds per packet
+ */
+static double hmac_time(csp_packet_t *packet, const uint8_t *key, uint32_t size, uint32_t packets, hmac_method method)
+{
+    uint64_t best = UINT64_MAX;
+    uint8_t tag[CSP_SHA1_DIGESTSIZE];
+
+    packet->id.flags = (method == HMAC_SIPHASH) ? CSP_FSIPHASH : 0;
+    for (int round = 0; round < HMAC_ROUNDS; round++)
+    {
+        const uint64_t start = hmac_now_ns();
+        for (uint32_t i = 0; i < packets; i++)
+        {
+            packet->length = size;
+            packet->data[0] = (uint8_t)i;
+            if (method == HMAC_PER_PACKET)
+            {
+                csp_hmac_memory(key, HMAC_KEY_LENGTH, packet->data, packet->length, tag);
+            }
+            else
+            {
+                csp_hmac_append(packet, false);
+            }
+        }
+        const uint64_t elapsed = hmac_now_ns() - start;
+        if (elapsed < best)
+        {
+            best = elapsed;
+        }
+    }
+    packet->id.flags = 0;
+    return (double)best / (double)packets;
+}
+
+int main(int argc, char **argv)
+{
+    static const char bench_key[] = "test_csp_hmac";
+    uint32_t packets = HMAC_PACKETS;
+    uint8_t key[CSP_SHA1_DIGESTSIZE];
+    csp_conf_t conf;
+    csp_packet_t *packet;
+    int failed;
+
+    setvbuf(stdout, NULL, _IONBF, 0);
+    if (argc > 1)
+    {
+        packets = (uint32_t)strtoul(argv[1], NULL, 0);
+    }
+
+    csp_conf_get_defaults(&conf);
+    conf.buffers = 4;
+    conf.buffer_data_size = 256;
+    csp_debug_set_level(CSP_INFO, false);
+    if ((csp_init(&conf) != CSP_ERR_NONE) || ((packet = csp_buffer_get(conf.buffer_data_size)) == NULL))
+    {
+        printf("FAIL: csp_init failed\n");
+        return 1;
+    }
+
+    printf("HMAC-SHA1 known answers:\n");
+    failed = hmac_check_kats(packet);
+
+    csp_sha1_memory(bench_key, sizeof(bench_key) - 1, key);
+    csp_hmac_set_key(bench_key, sizeof(bench_key) - 1);
+    memset(packet->data, 0x5A, conf.buffer_data_size);
+    printf("\nbytes   per packet pads ns   precomputed ns   SipHash ns\n");
+    for (unsigned int s = 0; s < (sizeof(hmac_sizes) / sizeof(hmac_sizes[0])); s++)
+    {
+        const double per_packet = hmac_time(packet, key, hmac_sizes[s], packets, HMAC_PER_PACKET);
+        const double precomputed = hmac_time(packet, key, hmac_sizes[s], packets, HMAC_PRECOMPUTED);
+        const double siphash = hmac_time(packet, key, hmac_sizes[s], packets, HMAC_SIPHASH);
+        printf("%5u %20.0f %16.0f %12.0f\n", (unsigned int)hmac_sizes[s], per_packet, precomputed, siphash);
+        if (precomputed >= per_packet)
+        {
+            printf("FAIL: precomputed pads not faster than per packet pads\n");
+            failed = 1;
+        }
+    }
+
+    csp_buffer_free(packet);
+    printf("%s\n", failed ? "FAIL" : "PASS");
+    return failed;
+}
@@ -0,0 +1,522 @@
+/**
+ * @file test_csp_rdp_loss.c
+ *
+ * @brief RDP goodput over a lossy and delayed loopback link, with and without the RDP extensions
+ *
+ * @copyright Copyright 2024 Antaris, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * The own address is routed over a loopback interface that drops the first
+ * transmission of every n'th packet from the client and can hold every packet
+ * for a fixed one way latency. The server sees the gap, stores the following
+ * segments and sends extended ACKs, the client retransmits the missing
+ * segment from them instead of waiting for its retransmission timer. The last
+ * packet is never dropped, nothing after it would tell the server about it.
+ * The interface counts data segments, retransmissions and extended ACKs, the
+ * server checks that every packet arrives once and in order.
+ *
+ * Every run is a child process, as csp_init() cannot be undone, and reports
+ * its goodput through shared memory:
+ * - a sweep of window sizes and loss rates over a short link whose air time
+ *   is shared by both directions, like a half duplex radio, run with the basic
+ *   extended ACK list and with CSP_RDP_OPT_SACK. With loss, the SACK bitmap
+ *   has to take less air time than the list and its goodput must not fall
+ *   below the one of the list, by more than LOSS_JITTER_PCT in one cell and
+ *   at all over the sweep.
+ * - transfers over a link with LOSS_LATENCY_MS one way latency, with a static
+ *   window and with CSP_RDP_OPT_AUTO_WINDOW starting from the same size. The
+ *   auto-tuned window has to reach at least the goodput of the static one.
+ *
+ * Usage: test_csp_rdp_loss [packets]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include "exo_common.h"
+#include "csp.h"
+#include "csp_interface.h"
+
+#define LOSS_ADDR           1       ///< Own CSP address, routed over the lossy interface
+#define LOSS_PORT           10      ///< Server port
+#define LOSS_PACKETS        2000    ///< Default packets to transfer without latency
+#define LOSS_PAYLOAD        64      ///< Payload bytes per packet
+#define LOSS_TIMEOUT_MS     1000
+#define LOSS_SWEEP_LATENCY_MS 2     ///< One way latency of the sweep, the link and not the CPU paces the transfer
+#define LOSS_SWEEP_BYTE_US  10      ///< Air time per byte of the sweep link, shared by both directions like a radio
+#define LOSS_SWEEP_DIVISOR  4       ///< Fraction of the packets transferred per sweep run
+#define LOSS_LATENCY_MS     10      ///< One way latency of the delayed runs
+#define LOSS_WINDOW_MAX     64      ///< csp_conf_t.rdp_max_window, the limit of the auto-tuned window
+#define LOSS_LINE_LEN       512     ///< Packets the delay line holds, more than the CSP buffers
+
+/* RDP header trailing each RDP packet, flags byte followed by seq_nr and ack_nr */
+#define LOSS_RDP_HDR_LEN    5
+#define LOSS_CSP_HDR_LEN    4       ///< CSP header on the air in front of the data
+#define LOSS_JITTER_PCT     5       ///< Goodput difference of one sweep cell put down to scheduling
+#define LOSS_RDP_EAK        0x02
+#define LOSS_RDP_SYN        0x08
+
+/**
+ * @brief Parameters of one transfer
+ */
+typedef struct
+{
+    uint32_t window;                ///< RDP window size, the initial one with CSP_RDP_OPT_AUTO_WINDOW
+    uint32_t loss_every;            ///< Drop the first transmission of every n'th data segment, 0 for none
+    uint32_t latency_ms;            ///< One way latency of the link
+    uint32_t byte_us;               ///< Air time per byte, packets queue up behind each other in both directions
+    unsigned int options;           ///< CSP_RDP_OPT_* flags
+    uint32_t divisor;               ///< Fraction of the packets transferred, the delayed runs are slower
+} loss_case;
+
+/**
+ * @brief Result of one transfer, written by the child
+ */
+typedef struct
+{
+    int done;
+    uint64_t elapsed_us;
+    uint32_t packets;
+    uint32_t dropped;
+    uint32_t retrans;
+    uint32_t eacks;
+    uint32_t eack_bytes;
+} loss_result;
+
+static const uint32_t loss_windows[] = {8, 16, 32};
+static const uint32_t loss_rates[] = {0, 32, 16, 8};
+static const unsigned int loss_acks[] = {0, CSP_RDP_OPT_SACK};
+
+/* Delayed runs: static window, auto-tuned window, both without and with loss */
+static const loss_case loss_delayed[] =
+{
+    {4, 0, LOSS_LATENCY_MS, 0, 0, 4},
+    {4, 0, LOSS_LATENCY_MS, 0, CSP_RDP_OPT_AUTO_WINDOW, 4},
+    {4, 16, LOSS_LATENCY_MS, 0, CSP_RDP_OPT_SACK, 4},
+    {4, 16, LOSS_LATENCY_MS, 0, CSP_RDP_OPT_SACK | CSP_RDP_OPT_AUTO_WINDOW, 4},
+};
+
+#define LOSS_SWEEP_RUNS     ((sizeof(loss_windows) / sizeof(loss_windows[0])) * (sizeof(loss_rates) / sizeof(loss_rates[0])) * \
+                             (sizeof(loss_acks) / sizeof(loss_acks[0])))
+#define LOSS_DELAYED_RUNS   (sizeof(loss_delayed) / sizeof(loss_delayed[0]))
+
+static uint32_t loss_packets = LOSS_PACKETS;
+static loss_case loss_cfg;
+static uint8_t *loss_seen;          ///< Data segments seen on the link, by sequence number
+static volatile uint32_t loss_rx;
+static volatile uint32_t loss_errors;
+
+/* Link counters, only updated from the transmitting tasks under loss_lock */
+static pthread_mutex_t loss_lock = PTHREAD_MUTEX_INITIALIZER;
+static uint32_t loss_data;
+static uint32_t loss_dropped;
+static uint32_t loss_retrans;
+static uint32_t loss_eacks;
+static uint32_t loss_eack_bytes;
+
+/* Delay line, packets leave in the order they were sent once their latency has passed */
+static pthread_mutex_t loss_line_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t loss_line_cond = PTHREAD_COND_INITIALIZER;
+static struct
+{
+    csp_packet_t *packet;
+    uint64_t due_us;
+} loss_line[LOSS_LINE_LEN];
+static uint32_t loss_line_head;
+static uint32_t loss_line_tail;
+static uint64_t loss_line_free_us;  ///< End of the air time of the last packet put on the line
+
+static csp_iface_t loss_if;
+
+/**
+ * @brief Monotonic time in micro seconds
+ */
+static uint64_t loss_now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000U) + ((uint64_t)ts.tv_nsec / 1000U);
+}
+
+/**
+ * @brief Link task, hands the packets of the delay line back to CSP when they are due
+ */
+static void *loss_link(void *arg)
+{
+    (void)arg;
+    pthread_mutex_lock(&loss_line_lock);
+    while (1)
+    {
+        while (loss_line_head == loss_line_tail)
+        {
+            pthread_cond_wait(&loss_line_cond, &loss_line_lock);
+        }
+        const uint64_t now = loss_now_us();
+        const uint64_t due = loss_line[loss_line_tail % LOSS_LINE_LEN].due_us;
+        if (now < due)
+        {
+            pthread_mutex_unlock(&loss_line_lock);
+            usleep((useconds_t)(due - now));
+            pthread_mutex_lock(&loss_line_lock);
+            continue;
+        }
+        csp_packet_t *packet = loss_line[loss_line_tail % LOSS_LINE_LEN].packet;
+        loss_line_tail++;
+        pthread_mutex_unlock(&loss_line_lock);
+        csp_qfifo_write(packet, &loss_if, NULL);
+        pthread_mutex_lock(&loss_line_lock);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Transmit function of the lossy loopback interface
+ */
+static int loss_tx(const csp_route_t *ifroute, csp_packet_t *packet)
+{
+    (void)ifroute;
+
+    if ((packet->id.flags & CSP_FRDP) && (packet->length >= LOSS_RDP_HDR_LEN))
+    {
+        const uint8_t *hdr = &packet->data[packet->length - LOSS_RDP_HDR_LEN];
+        const uint16_t seq = (uint16_t)((hdr[1] << 8) | hdr[2]);
+        uint32_t index = 0;
+        bool drop = false;
+
+        pthread_mutex_lock(&loss_lock);
+        if (packet->id.dport == LOSS_PORT)
+        {
+            /* Client to server, a data segment carries payload and no SYN */
+            if (!(hdr[0] & LOSS_RDP_SYN) && (packet->length > LOSS_RDP_HDR_LEN))
+            {
+                /* The client numbers its packets in the payload, the RDP sequence starts at random */
+                memcpy(&index, packet->data, sizeof(index));
+                loss_data++;
+                if (loss_seen[seq] != 0)
+                {
+                    loss_retrans++;
+                }
+                else if ((loss_cfg.loss_every != 0) && ((index % loss_cfg.loss_every) == 0) && (index != (loss_packets - 1U)))
+                {
+                    drop = true;
+                    loss_dropped++;
+                }
+                loss_seen[seq] = 1;
+            }
+        }
+        else if (hdr[0] & LOSS_RDP_EAK)
+        {
+            loss_eacks++;
+            loss_eack_bytes += packet->length - LOSS_RDP_HDR_LEN;
+        }
+        pthread_mutex_unlock(&loss_lock);
+
+        if (drop)
+        {
+            csp_buffer_free(packet);
+            return CSP_ERR_NONE;
+        }
+    }
+
+    if ((loss_cfg.latency_ms != 0) || (loss_cfg.byte_us != 0))
+    {
+        bool queued = false;
+        pthread_mutex_lock(&loss_line_lock);
+        if ((loss_line_head - loss_line_tail) < LOSS_LINE_LEN)
+        {
+            const uint64_t now = loss_now_us();
+            if (loss_line_free_us < now)
+            {
+                loss_line_free_us = now;
+            }
+            loss_line_free_us += (uint64_t)(packet->length + LOSS_CSP_HDR_LEN) * loss_cfg.byte_us;
+            loss_line[loss_line_head % LOSS_LINE_LEN].packet = packet;
+            loss_line[loss_line_head % LOSS_LINE_LEN].due_us = loss_line_free_us + (loss_cfg.latency_ms * 1000U);
+            loss_line_head++;
+            queued = true;
+            pthread_cond_signal(&loss_line_cond);
+        }
+        pthread_mutex_unlock(&loss_line_lock);
+        if (!queued)
+        {
+            csp_buffer_free(packet);
+        }
+        return CSP_ERR_NONE;
+    }
+
+    /* Send back into CSP, notice calling from task so last argument must be NULL! */
+    csp_qfifo_write(packet, &loss_if, NULL);
+    return CSP_ERR_NONE;
+}
+
+/**
+ * @brief Server, checks every packet arrives once and in order
+ */
+static void *loss_server(void *arg)
+{
+    csp_socket_t *sock = csp_socket(CSP_SO_RDPREQ);
+    csp_conn_t *conn = NULL;
+
+    (void)arg;
+    if ((sock == NULL) || (csp_bind(sock, LOSS_PORT) != CSP_ERR_NONE) || (csp_listen(sock, 1) != CSP_ERR_NONE))
+    {
+        loss_errors++;
+        return NULL;
+    }
+    while ((conn == NULL) && (loss_errors == 0))
+    {
+        conn = csp_accept(sock, LOSS_TIMEOUT_MS);
+    }
+    if (conn == NULL)
+    {
+        return NULL;
+    }
+    while (loss_rx < loss_packets)
+    {
+        csp_packet_t *packet = csp_read(conn, 10 * LOSS_TIMEOUT_MS);
+        uint32_t seq;
+        if (packet == NULL)
+        {
+            fprintf(stderr, "  server: timeout after %u packets\n", (unsigned int)loss_rx);
+            loss_errors++;
+            break;
+        }
+        memcpy(&seq, packet->data, sizeof(seq));
+        if ((seq != loss_rx) || (packet->length != LOSS_PAYLOAD))
+        {
+            fprintf(stderr, "  server: got seq %u len %u, expected seq %u\n", (unsigned int)seq, packet->length, (unsigned int)loss_rx);
+            loss_errors++;
+        }
+        csp_buffer_free(packet);
+        loss_rx++;
+    }
+    return NULL;
+}
+
+/**
+ * @brief One transfer with the given link and RDP settings, in a child process
+ */
+static int loss_run(const loss_case *cfg, loss_result *res)
+{
+    pthread_t server;
+    pthread_t link;
+    csp_conf_t conf;
+    csp_conn_t *conn;
+    uint64_t start;
+
+    loss_cfg = *cfg;
+    loss_packets /= cfg->divisor;
+    loss_seen = calloc(UINT16_MAX + 1, 1);
+    loss_if.name = "LOSSY";
+    loss_if.nexthop = loss_tx;
+
+    csp_conf_get_defaults(&conf);
+    conf.address = LOSS_ADDR;
+    conf.conn_max = 4;
+    conf.buffers = 400;
+    conf.buffer_data_size = 256;
+    conf.fifo_length = 200;
+    conf.conn_queue_length = 200;
+    conf.rdp_max_window = LOSS_WINDOW_MAX;
+    csp_debug_set_level(CSP_INFO, false);
+    csp_debug_set_level(CSP_BUFFER, false);
+    csp_debug_set_level(CSP_PACKET, false);
+    csp_debug_set_level(CSP_PROTOCOL, false);
+    if ((loss_seen == NULL) || (csp_init(&conf) != CSP_ERR_NONE))
+    {
+        fprintf(stderr, "csp_init failed\n");
+        return 1;
+    }
+    csp_iflist_add(&loss_if);
+    csp_rtable_set(LOSS_ADDR, CSP_ID_HOST_SIZE, &loss_if, CSP_NO_VIA_ADDRESS);
+    if (csp_route_start_task(384, P_CSP_ROUTE) != CSP_ERR_NONE)
+    {
+        fprintf(stderr, "csp_route_start_task failed\n");
+        return 1;
+    }
+    /* Delayed ACKs keep the cumulative ACK behind, the EACKs have to do the work */
+    csp_rdp_set_opt(cfg->window, 10 * LOSS_TIMEOUT_MS, LOSS_TIMEOUT_MS, 1, 100, (cfg->window > 2) ? (cfg->window / 2) : 1);
+    csp_rdp_set_ext_opt(cfg->options);
+
+    pthread_create(&link, NULL, loss_link, NULL);
+    pthread_create(&server, NULL, loss_server, NULL);
+    usleep(10000);
+
+    start = loss_now_us();
+    conn = csp_connect(CSP_PRIO_NORM, LOSS_ADDR, LOSS_PORT, LOSS_TIMEOUT_MS, CSP_O_RDP);
+    if (conn == NULL)
+    {
+        fprintf(stderr, "  client: connect failed\n");
+        loss_errors++;
+    }
+    for (uint32_t seq = 0; (conn != NULL) && (seq < loss_packets); seq++)
+    {
+        csp_packet_t *packet = csp_buffer_get(LOSS_PAYLOAD);
+        while (packet == NULL)
+        {
+            usleep(100);
+            packet = csp_buffer_get(LOSS_PAYLOAD);
+        }
+        memset(packet->data, 0x5A, LOSS_PAYLOAD);
+        memcpy(packet->data, &seq, sizeof(seq));
+        packet->length = LOSS_PAYLOAD;
+        if (csp_send(conn, packet, 10 * LOSS_TIMEOUT_MS) == 0)
+        {
+            fprintf(stderr, "  client: send of seq %u failed\n", (unsigned int)seq);
+            csp_buffer_free(packet);
+            loss_errors++;
+            break;
+        }
+    }
+    pthread_join(server, NULL);
+    res->elapsed_us = loss_now_us() - start;
+    if (conn != NULL)
+    {
+        csp_close(conn);
+    }
+
+    pthread_mutex_lock(&loss_lock);
+    res->packets = loss_rx;
+    res->dropped = loss_dropped;
+    res->retrans = loss_retrans;
+    res->eacks = loss_eacks;
+    res->eack_bytes = loss_eack_bytes;
+    if ((loss_errors == 0) && (loss_dropped != 0) && ((loss_eacks == 0) || (loss_retrans < loss_dropped)))
+    {
+        fprintf(stderr, "  window %u, 1/%u lost: lost segments were not recovered through extended ACKs\n",
+                (unsigned int)cfg->window, (unsigned int)cfg->loss_every);
+        loss_errors++;
+    }
+    pthread_mutex_unlock(&loss_lock);
+    res->done = (loss_errors == 0);
+    return (loss_errors == 0) ? 0 : 1;
+}
+
+/**
+ * @brief Run one transfer in a child process
+ */
+static int loss_fork(const loss_case *cfg, loss_result *res)
+{
+    int status = 0;
+    pid_t pid = fork();
+
+    if (pid == 0)
+    {
+        /* csp_send_direct() prints every outgoing packet, the results go to stderr */
+        if (freopen("/dev/null", "w", stdout) == NULL)
+        {
+            _exit(1);
+        }
+        _exit(loss_run(cfg, res));
+    }
+    if ((pid < 0) || (waitpid(pid, &status, 0) != pid) || !WIFEXITED(status) || (WEXITSTATUS(status) != 0) || !res->done)
+    {
+        printf("FAIL: window %u, 1/%u lost, latency %u ms, RDP options 0x%x\n", (unsigned int)cfg->window,
+               (unsigned int)cfg->loss_every, (unsigned int)cfg->latency_ms, cfg->options);
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Goodput of a transfer in kilo bytes per second
+ */
+static double loss_goodput(const loss_result *res)
+{
+    return (res->elapsed_us == 0) ? 0.0 : ((double)res->packets * LOSS_PAYLOAD * 1000.0 / (double)res->elapsed_us);
+}
+
+int main(int argc, char **argv)
+{
+    loss_result *res;
+    unsigned int run = 0;
+    double basic_sum = 0.0;
+    double sack_sum = 0.0;
+    int failed = 0;
+
+    setvbuf(stdout, NULL, _IONBF, 0);
+    if (argc > 1)
+    {
+        loss_packets = (uint32_t)strtoul(argv[1], NULL, 0);
+    }
+    res = mmap(NULL, (LOSS_SWEEP_RUNS + LOSS_DELAYED_RUNS) * sizeof(*res), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (res == MAP_FAILED)
+    {
+        printf("FAIL: no shared memory\n");
+        return 1;
+    }
+    memset(res, 0, (LOSS_SWEEP_RUNS + LOSS_DELAYED_RUNS) * sizeof(*res));
+
+    /* Window x loss rate sweep, basic extended ACKs against SACK */
+    printf("window  lost   basic kB/s  retrans  EACK bytes   SACK kB/s  retrans  EACK bytes\n");
+    for (unsigned int w = 0; w < (sizeof(loss_windows) / sizeof(loss_windows[0])); w++)
+    {
+        for (unsigned int l = 0; l < (sizeof(loss_rates) / sizeof(loss_rates[0])); l++)
+        {
+            const loss_result *r = &res[run];
+            for (unsigned int a = 0; a < (sizeof(loss_acks) / sizeof(loss_acks[0])); a++)
+            {
+                const loss_case cfg = {loss_windows[w], loss_rates[l], LOSS_SWEEP_LATENCY_MS, LOSS_SWEEP_BYTE_US, loss_acks[a],
+                                       LOSS_SWEEP_DIVISOR};
+                failed |= loss_fork(&cfg, &res[run++]);
+            }
+            printf("%6u  1/%-3u %11.0f %8u %11u %11.0f %8u %11u\n", (unsigned int)loss_windows[w], (unsigned int)loss_rates[l],
+                   loss_goodput(&r[0]), r[0].retrans, r[0].eack_bytes, loss_goodput(&r[1]), r[1].retrans, r[1].eack_bytes);
+            if ((loss_rates[l] != 0) && r[0].done && r[1].done)
+            {
+                basic_sum += loss_goodput(&r[0]);
+                sack_sum += loss_goodput(&r[1]);
+                if ((r[1].eack_bytes >= r[0].eack_bytes) ||
+                    ((loss_goodput(&r[1]) * 100.0) < (loss_goodput(&r[0]) * (100 - LOSS_JITTER_PCT))))
+                {
+                    printf("FAIL: SACK below the basic extended ACKs\n");
+                    failed = 1;
+                }
+            }
+        }
+    }
+
+    if (sack_sum < basic_sum)
+    {
+        printf("FAIL: SACK %.0f kB/s below the basic extended ACKs %.0f kB/s over the sweep\n", sack_sum, basic_sum);
+        failed = 1;
+    }
+
+    /* Delayed link, static against auto-tuned window */
+    printf("latency %u ms, window %u:\n", LOSS_LATENCY_MS, (unsigned int)loss_delayed[0].window);
+    for (unsigned int d = 0; d < LOSS_DELAYED_RUNS; d++)
+    {
+        const loss_result *r = &res[run];
+        failed |= loss_fork(&loss_delayed[d], &res[run++]);
+        printf("  1/%-3u %-6s %-6s %9.0f kB/s, retrans %u, EACKs %u\n", (unsigned int)loss_delayed[d].loss_every,
+               (loss_delayed[d].options & CSP_RDP_OPT_SACK) ? "SACK" : "basic",
+               (loss_delayed[d].options & CSP_RDP_OPT_AUTO_WINDOW) ? "auto" : "static", loss_goodput(r), r->retrans, r->eacks);
+        if ((loss_delayed[d].options & CSP_RDP_OPT_AUTO_WINDOW) && (r - 1)->done && r->done &&
+            (loss_goodput(r) < loss_goodput(r - 1)))
+        {
+            printf("FAIL: auto-tuned window below the static window\n");
+            failed = 1;
+        }
+    }
+
+    printf("%s\n", failed ? "FAIL" : "PASS");
+    return failed;
+}
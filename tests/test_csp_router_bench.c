@@ -0,0 +1,387 @@
+/**
+ * @file test_csp_router_bench.c
+ *
+ * @brief Loopback benchmark of the CSP router with one and with several router workers
+ *
+ * @copyright Copyright 2024 Antaris, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Every run is a child process, as csp_init() cannot be undone. The child
+ * opens one RDP connection per client over the loopback interface, every
+ * client streams sequence numbered packets to its own server port and the
+ * server checks they arrive complete and in order. The connections are hashed
+ * over the router workers, so with several workers the routing and the RDP
+ * processing of the connections run in parallel while the timer task expires
+ * their retransmission timers. After the transfer the process has to stay
+ * idle, the CPU time it uses while no packet is routed shows the router and
+ * timer tasks block instead of polling.
+ *
+ * RDP puts segments a worker routed out of order back in sequence, so the
+ * last run streams the same flows over plain connections with several
+ * workers: the sequence numbers of every flow have to arrive increasing,
+ * packets dropped on a full queue are counted but are not an error. The
+ * parent compares the packet rates of one and of several workers only when
+ * more than one CPU is online, on a single CPU the workers only take turns.
+ *
+ * Usage: test_csp_router_bench [packets per client]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include "exo_common.h"
+#include "csp.h"
+#include "csp_if_lo.h"
+
+#define BENCH_ADDR          1       ///< Own CSP address, routed over the loopback interface
+#define BENCH_CLIENTS       4       ///< Connections, one server port each
+#define BENCH_PORT          10      ///< First server port
+#define BENCH_PACKETS       20000   ///< Default packets per connection
+#define BENCH_PAYLOAD       64      ///< Payload bytes per packet
+#define BENCH_TIMEOUT_MS    1000
+#define BENCH_IDLE_MS       1000    ///< Idle interval measured after the transfer
+#define BENCH_IDLE_CPU_PCT  5       ///< Upper limit of the CPU use while idle, in percent
+
+/**
+ * @brief Router workers and transport of one run
+ */
+typedef struct
+{
+    uint8_t workers;
+    bool rdp;                       ///< RDP connections, plain connections otherwise
+} bench_case;
+
+/**
+ * @brief Result of one run, shared with the parent
+ */
+typedef struct
+{
+    uint64_t elapsed_us;
+    uint32_t received[BENCH_CLIENTS];
+    uint32_t reordered[BENCH_CLIENTS];  ///< Packets with a sequence number below one already received
+    int done;
+} bench_result;
+
+static const bench_case bench_runs[] = {{1, true}, {BENCH_CLIENTS, true}, {BENCH_CLIENTS, false}};
+
+static uint32_t bench_packets = BENCH_PACKETS;
+static bool bench_rdp;
+static bench_result *bench_res;
+static volatile uint32_t bench_rx[BENCH_CLIENTS];
+static volatile int bench_done[BENCH_CLIENTS];
+static volatile uint32_t bench_errors;
+
+/**
+ * @brief Monotonic time in micro seconds
+ */
+static uint64_t bench_now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000U) + ((uint64_t)ts.tv_nsec / 1000U);
+}
+
+/**
+ * @brief CPU time used by all threads of the process in micro seconds
+ */
+static uint64_t bench_cpu_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000U) + ((uint64_t)ts.tv_nsec / 1000U);
+}
+
+/**
+ * @brief Server of one port, checks the sequence numbers of a single connection
+ */
+static void *bench_server(void *arg)
+{
+    const unsigned int idx = (unsigned int)(uintptr_t)arg;
+    csp_socket_t *sock = csp_socket(bench_rdp ? CSP_SO_RDPREQ : CSP_SO_NONE);
+    csp_conn_t *conn = NULL;
+    uint32_t next = 0;
+
+    if ((sock == NULL) || (csp_bind(sock, BENCH_PORT + idx) != CSP_ERR_NONE) || (csp_listen(sock, 1) != CSP_ERR_NONE))
+    {
+        bench_errors++;
+        return NULL;
+    }
+    while ((conn == NULL) && (bench_errors == 0))
+    {
+        conn = csp_accept(sock, BENCH_TIMEOUT_MS);
+    }
+    if (conn == NULL)
+    {
+        bench_done[idx] = 1;
+        return NULL;
+    }
+    while (next < bench_packets)
+    {
+        /* Without RDP the tail of a flow may have been dropped, the flow ends when it stops */
+        csp_packet_t *packet = csp_read(conn, bench_rdp ? (10 * BENCH_TIMEOUT_MS) : BENCH_TIMEOUT_MS);
+        uint32_t seq;
+        if (packet == NULL)
+        {
+            if (bench_rdp || (bench_rx[idx] == 0))
+            {
+                fprintf(stderr, "  server %u: timeout after %u packets\n", idx, (unsigned int)bench_rx[idx]);
+                bench_errors++;
+            }
+            break;
+        }
+        memcpy(&seq, packet->data, sizeof(seq));
+        if (seq < next)
+        {
+            bench_res->reordered[idx]++;
+        }
+        else if ((bench_rdp && (seq != next)) || (packet->length != BENCH_PAYLOAD))
+        {
+            fprintf(stderr, "  server %u: got seq %u len %u, expected seq %u\n", idx, (unsigned int)seq, packet->length, (unsigned int)next);
+            bench_errors++;
+        }
+        if (seq >= next)
+        {
+            next = seq + 1;
+        }
+        csp_buffer_free(packet);
+        bench_rx[idx]++;
+    }
+    bench_res->received[idx] = bench_rx[idx];
+    bench_done[idx] = 1;
+    return NULL;
+}
+
+/**
+ * @brief Client streaming the sequence numbered packets of one connection
+ */
+static void *bench_client(void *arg)
+{
+    const unsigned int idx = (unsigned int)(uintptr_t)arg;
+    csp_conn_t *conn = csp_connect(CSP_PRIO_NORM, BENCH_ADDR, BENCH_PORT + idx, BENCH_TIMEOUT_MS, bench_rdp ? CSP_O_RDP : CSP_O_NONE);
+
+    if (conn == NULL)
+    {
+        fprintf(stderr, "  client %u: connect failed\n", idx);
+        bench_errors++;
+        return NULL;
+    }
+    for (uint32_t seq = 0; seq < bench_packets; seq++)
+    {
+        csp_packet_t *packet = csp_buffer_get(BENCH_PAYLOAD);
+        while (packet == NULL)
+        {
+            usleep(100);
+            packet = csp_buffer_get(BENCH_PAYLOAD);
+        }
+        memset(packet->data, (int)idx, BENCH_PAYLOAD);
+        memcpy(packet->data, &seq, sizeof(seq));
+        packet->length = BENCH_PAYLOAD;
+        if (csp_send(conn, packet, 10 * BENCH_TIMEOUT_MS) == 0)
+        {
+            fprintf(stderr, "  client %u: send of seq %u failed\n", idx, (unsigned int)seq);
+            csp_buffer_free(packet);
+            bench_errors++;
+            break;
+        }
+        if (!bench_rdp)
+        {
+            /* Nothing paces a plain connection, let the router drain the fifo */
+            sched_yield();
+        }
+    }
+    /* Keep the connection until the server has everything, closing drops the unacknowledged packets */
+    while (!bench_done[idx] && (bench_errors == 0))
+    {
+        usleep(1000);
+    }
+    csp_close(conn);
+    return NULL;
+}
+
+/**
+ * @brief One benchmark run with the given number of router workers, in a child process
+ */
+static int bench_run(const bench_case *run, bench_result *res)
+{
+    const uint8_t workers = run->workers;
+    pthread_t server[BENCH_CLIENTS];
+    pthread_t client[BENCH_CLIENTS];
+    csp_conf_t conf;
+    uint64_t start;
+    uint64_t elapsed;
+    uint64_t cpu;
+    uint64_t idle;
+    uint32_t received = 0;
+
+    bench_rdp = run->rdp;
+    bench_res = res;
+    csp_conf_get_defaults(&conf);
+    conf.address = BENCH_ADDR;
+    conf.conn_max = 4 * BENCH_CLIENTS;
+    conf.buffers = 400;
+    conf.buffer_data_size = 256;
+    conf.fifo_length = 100;
+    conf.conn_queue_length = 50;
+    conf.route_workers = workers;
+    csp_debug_set_level(CSP_INFO, false);
+    csp_debug_set_level(CSP_BUFFER, false);
+    csp_debug_set_level(CSP_PACKET, false);
+    csp_debug_set_level(CSP_PROTOCOL, false);
+    if (csp_init(&conf) != CSP_ERR_NONE)
+    {
+        fprintf(stderr, "csp_init failed\n");
+        return 1;
+    }
+    /* csp_init() leaves the loopback interface out in this tree */
+    csp_iflist_add(&csp_if_lo);
+    csp_rtable_set(BENCH_ADDR, CSP_ID_HOST_SIZE, &csp_if_lo, CSP_NO_VIA_ADDRESS);
+    if (csp_route_start_task(384, P_CSP_ROUTE) != CSP_ERR_NONE)
+    {
+        fprintf(stderr, "csp_route_start_task failed\n");
+        return 1;
+    }
+    csp_rdp_set_opt(16, 10 * BENCH_TIMEOUT_MS, BENCH_TIMEOUT_MS, 1, 50, 8);
+
+    for (unsigned int idx = 0; idx < BENCH_CLIENTS; idx++)
+    {
+        pthread_create(&server[idx], NULL, bench_server, (void *)(uintptr_t)idx);
+    }
+    usleep(10000);
+
+    start = bench_now_us();
+    cpu = bench_cpu_us();
+    for (unsigned int idx = 0; idx < BENCH_CLIENTS; idx++)
+    {
+        pthread_create(&client[idx], NULL, bench_client, (void *)(uintptr_t)idx);
+    }
+    for (unsigned int idx = 0; idx < BENCH_CLIENTS; idx++)
+    {
+        pthread_join(server[idx], NULL);
+    }
+    elapsed = bench_now_us() - start;
+    cpu = bench_cpu_us() - cpu;
+    for (unsigned int idx = 0; idx < BENCH_CLIENTS; idx++)
+    {
+        pthread_join(client[idx], NULL);
+    }
+
+    for (unsigned int idx = 0; idx < BENCH_CLIENTS; idx++)
+    {
+        received += bench_rx[idx];
+    }
+
+    /* Nothing is routed any more, only the timer task and the router wake ups remain */
+    idle = bench_cpu_us();
+    usleep(BENCH_IDLE_MS * 1000U);
+    idle = bench_cpu_us() - idle;
+
+    fprintf(stderr, "workers %u, %s: %u connections x %u packets in %llu us, %.0f packets/s, %.0f %% CPU, errors %u\n",
+           (unsigned int)workers, bench_rdp ? "RDP" : "plain", BENCH_CLIENTS, (unsigned int)bench_packets,
+           (unsigned long long)elapsed, (double)received * 1e6 / (double)elapsed, 100.0 * (double)cpu / (double)elapsed,
+           (unsigned int)bench_errors);
+    fprintf(stderr, "workers %u: %llu us CPU in %u ms idle\n", (unsigned int)workers, (unsigned long long)idle,
+           (unsigned int)BENCH_IDLE_MS);
+    if ((idle * 100U) > ((uint64_t)BENCH_IDLE_MS * 1000U * BENCH_IDLE_CPU_PCT))
+    {
+        fprintf(stderr, "  router tasks busy while idle\n");
+        bench_errors++;
+    }
+    res->elapsed_us = elapsed;
+    res->done = 1;
+    return (bench_errors == 0) ? 0 : 1;
+}
+
+int main(int argc, char **argv)
+{
+    const unsigned int runs = sizeof(bench_runs) / sizeof(bench_runs[0]);
+    const long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    double rate[sizeof(bench_runs) / sizeof(bench_runs[0])] = {0};
+    bench_result *res;
+    int failed = 0;
+
+    setvbuf(stdout, NULL, _IONBF, 0);
+    if (argc > 1)
+    {
+        bench_packets = (uint32_t)strtoul(argv[1], NULL, 0);
+    }
+    res = mmap(NULL, runs * sizeof(*res), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (res == MAP_FAILED)
+    {
+        printf("FAIL: mmap failed\n");
+        return 1;
+    }
+    memset(res, 0, runs * sizeof(*res));
+
+    printf("workers  transport  packets/s   received per flow, out of order\n");
+    for (unsigned int run = 0; run < runs; run++)
+    {
+        uint32_t received = 0;
+        int status = 0;
+        pid_t pid = fork();
+        if (pid == 0)
+        {
+            /* csp_send_direct() prints every outgoing packet, the results go to stderr */
+            if (freopen("/dev/null", "w", stdout) == NULL)
+            {
+                _exit(1);
+            }
+            _exit(bench_run(&bench_runs[run], &res[run]));
+        }
+        if ((pid < 0) || (waitpid(pid, &status, 0) != pid) || !WIFEXITED(status) || (WEXITSTATUS(status) != 0) ||
+            !res[run].done)
+        {
+            printf("FAIL: run with %u router workers\n", (unsigned int)bench_runs[run].workers);
+            failed = 1;
+            continue;
+        }
+        for (unsigned int idx = 0; idx < BENCH_CLIENTS; idx++)
+        {
+            received += res[run].received[idx];
+        }
+        rate[run] = (double)received * 1e6 / (double)res[run].elapsed_us;
+        printf("%7u  %-9s  %9.0f ", (unsigned int)bench_runs[run].workers, bench_runs[run].rdp ? "RDP" : "plain", rate[run]);
+        for (unsigned int idx = 0; idx < BENCH_CLIENTS; idx++)
+        {
+            printf("  %u/%u", (unsigned int)res[run].received[idx], (unsigned int)res[run].reordered[idx]);
+            if (res[run].reordered[idx] != 0)
+            {
+                failed = 1;
+            }
+        }
+        printf("\n");
+    }
+
+    if (failed)
+    {
+        printf("FAIL: a run failed or packets of a flow arrived out of order\n");
+    }
+    else if (cpus < 2)
+    {
+        printf("scaling: not measured, %ld CPU online\n", cpus);
+    }
+    else
+    {
+        printf("scaling: %u workers route %.2f times the packets of one on %ld CPUs\n", BENCH_CLIENTS, rate[1] / rate[0], cpus);
+    }
+    printf("%s\n", failed ? "FAIL" : "PASS");
+    return failed;
+}
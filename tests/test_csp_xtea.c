@@ -0,0 +1,289 @@
+/**
+ * @file test_csp_xtea.c
+ *
+ * @brief XTEA CTR keystream against the block at a time implementation, and its throughput
+ *
+ * @copyright Copyright 2024 Antaris, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * csp_xtea_encrypt() generates the keystream for several counter blocks at
+ * once and XORs whole blocks as words. The block at a time implementation
+ * it replaced is kept here as the reference: for every length up to a few
+ * lane groups, for counters that wrap and for several keys both have to
+ * produce the same cipher text and leave the same counter in iv[1].
+ * Encrypting and decrypting a packet has to give back the plain text.
+ *
+ * The benchmark encrypts packets of several sizes with both, the lanes have
+ * to be at least as fast as the reference.
+ *
+ * Usage: test_csp_xtea [packets]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "exo_common.h"
+#include "csp.h"
+#include "csp_endian.h"
+#include "csp_sha1.h"
+#include "csp_xtea.h"
+
+#define XTEA_PACKETS        20000   ///< Default packets encrypted per size and implementation
+#define XTEA_MAX_LEN        260     ///< Longest data compared, more than a lane group of blocks
+#define XTEA_ROUNDS         3       ///< Timed rounds, the fastest one counts
+
+#define REF_BLOCKSIZE       8
+#define REF_ROUNDS          32
+#define REF_KEY_LENGTH      16
+
+static const char *const xtea_keys[] = {"", "test_csp_xtea", "a longer key, longer than one SHA1 block of sixty four bytes......"};
+static const uint32_t xtea_ivs[][2] = {{0, 1}, {0x12345678, 0x9ABCDEF0}, {0xDEADBEEF, 0xFFFFFFFE}};
+static const uint32_t xtea_sizes[] = {16, 64, 200};
+
+static uint8_t ref_key[REF_KEY_LENGTH];
+
+#define LOAD32L(x, y) do { (x) = ((uint32_t)((y)[3] & 0xff) << 24) | \
+                                 ((uint32_t)((y)[2] & 0xff) << 16) | \
+                                 ((uint32_t)((y)[1] & 0xff) << 8)  | \
+                                 ((uint32_t)((y)[0] & 0xff) << 0); } while (0)
+
+#define STORE32L(x, y) do { (y)[3] = (uint8_t)(((x) >> 24) & 0xff); \
+                            (y)[2] = (uint8_t)(((x) >> 16) & 0xff); \
+                            (y)[1] = (uint8_t)(((x) >> 8) & 0xff); \
+                            (y)[0] = (uint8_t)(((x) >> 0) & 0xff); } while (0)
+
+/**
+ * @brief Block at a time XTEA, as csp_xtea.c had it
+ */
+static void ref_encrypt_block(uint8_t *block, const uint8_t *key)
+{
+    uint32_t i, v0, v1, delta = 0x9E3779B9, sum = 0, k[4];
+
+    LOAD32L(k[0], &key[0]);
+    LOAD32L(k[1], &key[4]);
+    LOAD32L(k[2], &key[8]);
+    LOAD32L(k[3], &key[12]);
+
+    LOAD32L(v0, &block[0]);
+    LOAD32L(v1, &block[4]);
+
+    for (i = 0; i < REF_ROUNDS; i++)
+    {
+        v0 += (((v1 << 4) ^ (v1 >> 5)) + v1) ^ (sum + k[sum & 3]);
+        sum += delta;
+        v1 += (((v0 << 4) ^ (v0 >> 5)) + v0) ^ (sum + k[(sum >> 11) & 3]);
+    }
+
+    STORE32L(v0, &block[0]);
+    STORE32L(v1, &block[4]);
+}
+
+/**
+ * @brief Set the key of the reference, SHA1 is the KDF
+ */
+static void ref_set_key(const void *key, uint32_t keylen)
+{
+    uint8_t hash[CSP_SHA1_DIGESTSIZE];
+    csp_sha1_memory(key, keylen, hash);
+    memcpy(ref_key, hash, REF_KEY_LENGTH);
+}
+
+/**
+ * @brief CTR mode of the reference, one block of keystream and one byte at a time
+ */
+static void ref_encrypt(void *plain, const uint32_t len, uint32_t iv[2])
+{
+    uint32_t blocks = (len + REF_BLOCKSIZE - 1) / REF_BLOCKSIZE;
+    uint32_t stream[2];
+    uint32_t remain;
+
+    stream[0] = csp_htobe32(iv[0]);
+    stream[1] = csp_htobe32(iv[1]);
+
+    for (uint32_t i = 0; i < blocks; i++)
+    {
+        ref_encrypt_block((uint8_t *)stream, ref_key);
+        remain = len - i * REF_BLOCKSIZE;
+        for (uint32_t j = 0; j < ((remain < REF_BLOCKSIZE) ? remain : REF_BLOCKSIZE); j++)
+        {
+            ((uint8_t *)plain)[len - remain + j] ^= ((uint8_t *)stream)[j];
+        }
+        stream[0] = csp_htobe32(iv[0]);
+        stream[1] = csp_htobe32(iv[1]++);
+    }
+}
+
+/**
+ * @brief Monotonic time in nano seconds
+ */
+static uint64_t xtea_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000U) + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Cipher text and counter of every length, IV and key against the reference
+ */
+static int xtea_check_keystream(void)
+{
+    static uint8_t plain[XTEA_MAX_LEN];
+    static uint8_t lanes[XTEA_MAX_LEN];
+    static uint8_t ref[XTEA_MAX_LEN];
+    uint32_t compared = 0;
+    int failed = 0;
+
+    for (uint32_t i = 0; i < XTEA_MAX_LEN; i++)
+    {
+        plain[i] = (uint8_t)rand();
+    }
+    for (unsigned int k = 0; k < (sizeof(xtea_keys) / sizeof(xtea_keys[0])); k++)
+    {
+        csp_xtea_set_key(xtea_keys[k], (uint32_t)strlen(xtea_keys[k]));
+        ref_set_key(xtea_keys[k], (uint32_t)strlen(xtea_keys[k]));
+        for (unsigned int v = 0; v < (sizeof(xtea_ivs) / sizeof(xtea_ivs[0])); v++)
+        {
+            for (uint32_t len = 0; len <= XTEA_MAX_LEN; len++)
+            {
+                uint32_t iv_lanes[2] = {xtea_ivs[v][0], xtea_ivs[v][1]};
+                uint32_t iv_ref[2] = {xtea_ivs[v][0], xtea_ivs[v][1]};
+
+                memcpy(lanes, plain, len);
+                memcpy(ref, plain, len);
+                csp_xtea_encrypt(lanes, len, iv_lanes);
+                ref_encrypt(ref, len, iv_ref);
+                compared++;
+                if ((memcmp(lanes, ref, len) != 0) || (iv_lanes[0] != iv_ref[0]) || (iv_lanes[1] != iv_ref[1]))
+                {
+                    if (failed == 0)
+                    {
+                        printf("  key %u, iv %08x %08x, %u bytes: cipher text or counter differs\n", k,
+                               (unsigned int)xtea_ivs[v][0], (unsigned int)xtea_ivs[v][1], (unsigned int)len);
+                    }
+                    failed = 1;
+                }
+            }
+        }
+    }
+    printf("XTEA CTR: %u lengths, IVs and keys compared with the block at a time implementation, %s\n",
+           (unsigned int)compared, failed ? "MISMATCH" : "ok");
+    return failed;
+}
+
+/**
+ * @brief Packet round trip
+ */
+static int xtea_check_packet(csp_packet_t *packet)
+{
+    uint8_t plain[XTEA_MAX_LEN / 2];
+
+    for (uint32_t i = 0; i < sizeof(plain); i++)
+    {
+        plain[i] = (uint8_t)i;
+    }
+    memcpy(packet->data, plain, sizeof(plain));
+    packet->length = sizeof(plain);
+    if ((csp_xtea_encrypt_packet(packet) != CSP_ERR_NONE) || (packet->length != (sizeof(plain) + sizeof(uint32_t))) ||
+        (memcmp(packet->data, plain, sizeof(plain)) == 0) || (csp_xtea_decrypt_packet(packet) != CSP_ERR_NONE) ||
+        (packet->length != sizeof(plain)) || (memcmp(packet->data, plain, sizeof(plain)) != 0))
+    {
+        printf("  packet round trip failed\n");
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Fastest time of encrypting packets of one size, in nano seconds per packet
+ */
+static double xtea_time(uint8_t *data, uint32_t size, uint32_t packets, int reference)
+{
+    uint64_t best = UINT64_MAX;
+
+    for (int round = 0; round < XTEA_ROUNDS; round++)
+    {
+        const uint64_t start = xtea_now_ns();
+        for (uint32_t i = 0; i < packets; i++)
+        {
+            uint32_t iv[2] = {i, 1};
+            if (reference)
+            {
+                ref_encrypt(data, size, iv);
+            }
+            else
+            {
+                csp_xtea_encrypt(data, size, iv);
+            }
+        }
+        const uint64_t elapsed = xtea_now_ns() - start;
+        if (elapsed < best)
+        {
+            best = elapsed;
+        }
+    }
+    return (double)best / (double)packets;
+}
+
+int main(int argc, char **argv)
+{
+    static const char bench_key[] = "test_csp_xtea";
+    static uint8_t data[256];
+    uint32_t packets = XTEA_PACKETS;
+    csp_conf_t conf;
+    csp_packet_t *packet;
+    int failed;
+
+    setvbuf(stdout, NULL, _IONBF, 0);
+    if (argc > 1)
+    {
+        packets = (uint32_t)strtoul(argv[1], NULL, 0);
+    }
+
+    csp_conf_get_defaults(&conf);
+    conf.buffers = 4;
+    conf.buffer_data_size = 256;
+    csp_debug_set_level(CSP_INFO, false);
+    if ((csp_init(&conf) != CSP_ERR_NONE) || ((packet = csp_buffer_get(conf.buffer_data_size)) == NULL))
+    {
+        printf("FAIL: csp_init failed\n");
+        return 1;
+    }
+
+    failed = xtea_check_keystream();
+    failed |= xtea_check_packet(packet);
+
+    csp_xtea_set_key(bench_key, sizeof(bench_key) - 1);
+    ref_set_key(bench_key, sizeof(bench_key) - 1);
+    printf("\nbytes   block at a time ns   lanes ns   MB/s\n");
+    for (unsigned int s = 0; s < (sizeof(xtea_sizes) / sizeof(xtea_sizes[0])); s++)
+    {
+        const double reference = xtea_time(data, xtea_sizes[s], packets, 1);
+        const double lanes = xtea_time(data, xtea_sizes[s], packets, 0);
+        printf("%5u %20.0f %10.0f %6.1f\n", (unsigned int)xtea_sizes[s], reference, lanes,
+               (double)xtea_sizes[s] * 1000.0 / lanes);
+        if (lanes > reference)
+        {
+            printf("FAIL: lanes slower than the block at a time implementation\n");
+            failed = 1;
+        }
+    }
+
+    csp_buffer_free(packet);
+    printf("%s\n", failed ? "FAIL" : "PASS");
+    return failed;
+}
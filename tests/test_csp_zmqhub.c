@@ -0,0 +1,320 @@
+/**
+ * @file test_csp_zmqhub.c
+ *
+ * @brief ZMQ hub interface looped back through an inproc:// hub
+ *
+ * @copyright Copyright 2024 Antaris, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * The test runs the hub itself: a zmq_proxy() between an XSUB and an XPUB
+ * socket bound to inproc:// endpoints in the context of the interfaces. A
+ * peer on the hub subscribes to CSP address 2 and echoes every message back
+ * to address 1 with the source and destination of the header swapped. The
+ * node routes address 2 over the ZMQ hub interface and sends sequence
+ * numbered packets to the peer one at a time, every echo has to come back
+ * with the same length and data. Once the connection is closed all CSP
+ * buffers have to be free again, in event mode the Tx buffers are released
+ * from the ZMQ free callback and the Rx task keeps one buffer for the next
+ * message.
+ *
+ * Both the default and the event driven mode are run, each in a child
+ * process as csp_init() cannot be undone. Without CSP_HAVE_LIBZMQ the
+ * interface is not built and the test is skipped.
+ *
+ * Usage: test_csp_zmqhub [round trips]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "exo_common.h"
+#include "csp.h"
+
+#if (CSP_HAVE_LIBZMQ)
+
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <zmq.h>
+#include "csp_if_zmqhub.h"
+
+#define HUB_ADDR            1       ///< Own CSP address
+#define HUB_PEER            2       ///< Address of the echo peer on the hub
+#define HUB_PORT            10      ///< Port of the peer
+#define HUB_ROUND_TRIPS     2000    ///< Default packets echoed per mode
+#define HUB_PAYLOAD         100     ///< Payload bytes per packet
+#define HUB_TIMEOUT_MS      1000
+#define HUB_WARMUP          50      ///< Attempts while the subscriptions reach the hub
+#define HUB_FREE_MS         100     ///< Time given to ZMQ to release the sent buffers
+#define HUB_XSUB_ENDPOINT   "inproc://csp-hub-sub"  ///< The publishers connect here
+#define HUB_XPUB_ENDPOINT   "inproc://csp-hub-pub"  ///< The subscribers connect here
+
+static uint32_t hub_round_trips = HUB_ROUND_TRIPS;
+static volatile uint32_t hub_echoed;
+
+/**
+ * @brief Monotonic time in micro seconds
+ */
+static uint64_t hub_now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000U) + ((uint64_t)ts.tv_nsec / 1000U);
+}
+
+/**
+ * @brief Hub forwarding every message from the publishers to the subscribers
+ */
+static void *hub_proxy(void *arg)
+{
+    void **sockets = arg;
+
+    zmq_proxy(sockets[0], sockets[1], NULL);
+    return NULL;
+}
+
+/**
+ * @brief Peer on the hub echoing the messages for its address
+ */
+static void *hub_peer(void *arg)
+{
+    void *ctx = arg;
+    void *sub = zmq_socket(ctx, ZMQ_SUB);
+    void *pub = zmq_socket(ctx, ZMQ_PUB);
+    const uint8_t filter = HUB_PEER;
+    uint8_t msg[1 + sizeof(csp_id_t) + 256];
+
+    if ((sub == NULL) || (pub == NULL) || (zmq_setsockopt(sub, ZMQ_SUBSCRIBE, &filter, sizeof(filter)) != 0) ||
+        (zmq_connect(sub, HUB_XPUB_ENDPOINT) != 0) || (zmq_connect(pub, HUB_XSUB_ENDPOINT) != 0))
+    {
+        fprintf(stderr, "  peer: %s\n", zmq_strerror(zmq_errno()));
+        return NULL;
+    }
+    while (1)
+    {
+        const int len = zmq_recv(sub, msg, sizeof(msg), 0);
+        csp_id_t id;
+        uint8_t port;
+
+        if ((len < (int)(1 + sizeof(id))) || (len > (int)sizeof(msg)) || (msg[0] != HUB_PEER))
+        {
+            continue;
+        }
+        /* First byte is the via address, the CSP header follows as sent */
+        memcpy(&id, &msg[1], sizeof(id));
+        id.dst = id.src;
+        id.src = HUB_PEER;
+        port = id.dport;
+        id.dport = id.sport;
+        id.sport = port;
+        msg[0] = HUB_ADDR;
+        memcpy(&msg[1], &id, sizeof(id));
+        if (zmq_send(pub, msg, len, 0) == len)
+        {
+            hub_echoed++;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Send one sequence numbered packet and wait for its echo
+ */
+static int hub_ping(csp_conn_t *conn, uint32_t seq, uint32_t timeout)
+{
+    csp_packet_t *packet = csp_buffer_get(HUB_PAYLOAD);
+    int ok;
+
+    if (packet == NULL)
+    {
+        return 0;
+    }
+    for (uint32_t i = 0; i < HUB_PAYLOAD; i++)
+    {
+        packet->data[i] = (uint8_t)(seq + i);
+    }
+    memcpy(packet->data, &seq, sizeof(seq));
+    packet->length = HUB_PAYLOAD;
+    if (csp_send(conn, packet, timeout) == 0)
+    {
+        csp_buffer_free(packet);
+        return 0;
+    }
+
+    /* Echoes of earlier attempts may still arrive, only the current sequence number counts */
+    while ((packet = csp_read(conn, timeout)) != NULL)
+    {
+        uint32_t got;
+        memcpy(&got, packet->data, sizeof(got));
+        if (got == seq)
+        {
+            break;
+        }
+        csp_buffer_free(packet);
+    }
+    if (packet == NULL)
+    {
+        return 0;
+    }
+    ok = (packet->length == HUB_PAYLOAD);
+    for (uint32_t i = sizeof(seq); ok && (i < HUB_PAYLOAD); i++)
+    {
+        ok = (packet->data[i] == (uint8_t)(seq + i));
+    }
+    csp_buffer_free(packet);
+    return ok;
+}
+
+/**
+ * @brief Echo the packets through the hub with the given interface flags, in a child process
+ */
+static int hub_run(uint32_t flags)
+{
+    static void *sockets[2];
+    const char *mode = (flags & CSP_ZMQHUB_FLAG_EVENT) ? "event" : "default";
+    pthread_t proxy;
+    pthread_t peer;
+    csp_iface_t *iface;
+    csp_conn_t *conn;
+    csp_conf_t conf;
+    uint32_t errors = 0;
+    uint32_t seq = 0;
+    uint64_t elapsed;
+    int initial;
+    int remaining;
+    void *ctx;
+
+    csp_conf_get_defaults(&conf);
+    conf.address = HUB_ADDR;
+    conf.buffers = 100;
+    conf.buffer_data_size = 256;
+    csp_debug_set_level(CSP_INFO, false);
+    csp_debug_set_level(CSP_BUFFER, false);
+    csp_debug_set_level(CSP_PACKET, false);
+    csp_debug_set_level(CSP_PROTOCOL, false);
+    if ((csp_init(&conf) != CSP_ERR_NONE) || (csp_route_start_task(384, P_CSP_ROUTE) != CSP_ERR_NONE))
+    {
+        fprintf(stderr, "csp_init failed\n");
+        return 1;
+    }
+    initial = csp_buffer_remaining();
+
+    /* The hub binds first, inproc:// endpoints only exist within the context of the interfaces */
+    ctx = csp_zmqhub_context();
+    sockets[0] = zmq_socket(ctx, ZMQ_XSUB);
+    sockets[1] = zmq_socket(ctx, ZMQ_XPUB);
+    if ((sockets[0] == NULL) || (sockets[1] == NULL) || (zmq_bind(sockets[0], HUB_XSUB_ENDPOINT) != 0) ||
+        (zmq_bind(sockets[1], HUB_XPUB_ENDPOINT) != 0))
+    {
+        fprintf(stderr, "hub: %s\n", zmq_strerror(zmq_errno()));
+        return 1;
+    }
+    pthread_create(&proxy, NULL, hub_proxy, sockets);
+    pthread_create(&peer, NULL, hub_peer, ctx);
+
+    csp_zmqhub_init_w_endpoints(HUB_ADDR, HUB_XSUB_ENDPOINT, HUB_XPUB_ENDPOINT, flags, &iface);
+    csp_rtable_set(HUB_PEER, CSP_ID_HOST_SIZE, iface, CSP_NO_VIA_ADDRESS);
+    conn = csp_connect(CSP_PRIO_NORM, HUB_PEER, HUB_PORT, HUB_TIMEOUT_MS, CSP_O_NONE);
+    if (conn == NULL)
+    {
+        fprintf(stderr, "%s: connect failed\n", mode);
+        return 1;
+    }
+
+    /* Subscriptions reach the hub asynchronously, messages published before are lost */
+    while ((seq < HUB_WARMUP) && !hub_ping(conn, seq, HUB_TIMEOUT_MS / 10))
+    {
+        seq++;
+    }
+    if (seq == HUB_WARMUP)
+    {
+        fprintf(stderr, "%s: no echo from the peer\n", mode);
+        return 1;
+    }
+
+    elapsed = hub_now_us();
+    for (uint32_t i = 0; i < hub_round_trips; i++)
+    {
+        if (!hub_ping(conn, ++seq, HUB_TIMEOUT_MS))
+        {
+            if (errors++ == 0)
+            {
+                fprintf(stderr, "  %s: echo of seq %u missing or corrupt\n", mode, (unsigned int)seq);
+            }
+        }
+    }
+    elapsed = hub_now_us() - elapsed;
+    csp_close(conn);
+
+    usleep(HUB_FREE_MS * 1000U);
+    remaining = csp_buffer_remaining() + ((flags & CSP_ZMQHUB_FLAG_EVENT) ? 1 : 0);
+    fprintf(stderr, "%-7s mode: %u round trips in %llu us, %.1f us each, %u echoed by the peer, %u errors, %d of %d buffers free\n",
+            mode, (unsigned int)hub_round_trips, (unsigned long long)elapsed,
+            (hub_round_trips != 0) ? ((double)elapsed / (double)hub_round_trips) : 0.0, (unsigned int)hub_echoed,
+            (unsigned int)errors, remaining, initial);
+    if (remaining != initial)
+    {
+        fprintf(stderr, "  %s: CSP buffers leaked\n", mode);
+        errors++;
+    }
+    return (errors == 0) ? 0 : 1;
+}
+
+int main(int argc, char **argv)
+{
+    static const uint32_t runs[] = {0, CSP_ZMQHUB_FLAG_EVENT};
+    int failed = 0;
+
+    setvbuf(stdout, NULL, _IONBF, 0);
+    if (argc > 1)
+    {
+        hub_round_trips = (uint32_t)strtoul(argv[1], NULL, 0);
+    }
+
+    for (unsigned int run = 0; run < (sizeof(runs) / sizeof(runs[0])); run++)
+    {
+        int status = 0;
+        pid_t pid = fork();
+        if (pid == 0)
+        {
+            /* csp_send_direct() prints every outgoing packet, the results go to stderr */
+            if (freopen("/dev/null", "w", stdout) == NULL)
+            {
+                _exit(1);
+            }
+            _exit(hub_run(runs[run]));
+        }
+        if ((pid < 0) || (waitpid(pid, &status, 0) != pid) || !WIFEXITED(status) || (WEXITSTATUS(status) != 0))
+        {
+            printf("FAIL: run with interface flags 0x%04x\n", (unsigned int)runs[run]);
+            failed = 1;
+        }
+    }
+    printf("%s\n", failed ? "FAIL" : "PASS");
+    return failed;
+}
+
+#else
+
+int main(void)
+{
+    printf("ZMQ hub interface not built, run make -C tests CSP_ZMQ=1 with libzmq installed\n");
+    printf("SKIP\n");
+    return 0;
+}
+
+#endif